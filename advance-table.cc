@@ -0,0 +1,134 @@
+#include "advance-table.h"
+#include <string.h>
+
+AdvanceTable::AdvanceTable(){
+	memset(blocks_, 0, sizeof(blocks_));
+	loadedBlocks_ = 0;
+	sourceCalls_ = 0;
+}
+
+AdvanceTable::~AdvanceTable(){
+	int i;
+	for(i=0;i<256;i++){
+		delete [] blocks_[i];
+	}
+}
+
+const int *AdvanceTable::block(uint16_t ch, AdvanceSource *source){
+	int *widths = blocks_[ch >> 8];
+	if( widths ){
+		return widths;
+	}
+	uint16_t first = (uint16_t)(ch & 0xff00);
+	widths = new int[256];
+	sourceCalls_ += 1;
+	if( !source->charWidths(first, (uint16_t)(first + 255), widths) ){
+		delete [] widths;
+		return NULL;
+	}
+	blocks_[ch >> 8] = widths;
+	loadedBlocks_ += 1;
+	return widths;
+}
+
+bool AdvanceTable::measure(const uint16_t *text, uint32_t length, AdvanceSource *source,
+		long *width){
+	const int *widths = NULL;
+	unsigned hi = 0x100;
+	long sum = 0;
+	uint32_t i;
+	for(i=0;i<length;i++){
+		uint16_t ch = text[i];
+		if( ch >= 0xd800 && ch <= 0xdfff ){
+			sourceCalls_ += 1;
+			return source->textWidth(text, length, width);
+		}
+		// consecutive characters are usually from the same block
+		if( (unsigned)(ch >> 8) != hi ){
+			hi = ch >> 8;
+			widths = block(ch, source);
+			if( !widths ){
+				return false;
+			}
+		}
+		sum += widths[ch & 0xff];
+	}
+	*width = sum;
+	return true;
+}
+
+bool AdvanceTable::measureBatch(const uint16_t *text, const uint32_t *lengths, uint32_t count,
+		AdvanceSource *source, int32_t *widths){
+	uint32_t i;
+	long width;
+	for(i=0;i<count;i++){
+		if( !measure(text, lengths[i], source, &width) ){
+			return false;
+		}
+		widths[i] = (int32_t)width;
+		text += lengths[i];
+	}
+	return true;
+}
+
+bool AdvanceTable::advances(const uint16_t *text, uint32_t length, AdvanceSource *source,
+		int *advances){
+	const int *widths = NULL;
+	unsigned hi = 0x100;
+	uint32_t i;
+	long width;
+	for(i=0;i<length;i++){
+		uint16_t ch = text[i];
+		if( ch >= 0xd800 && ch <= 0xdfff ){
+			uint32_t n = ch <= 0xdbff && i + 1 < length &&
+				text[i + 1] >= 0xdc00 && text[i + 1] <= 0xdfff ? 2 : 1;
+			sourceCalls_ += 1;
+			if( !source->textWidth(text + i, n, &width) ){
+				return false;
+			}
+			advances[i] = (int)width;
+			if( n == 2 ){
+				advances[++i] = 0;
+			}
+			continue;
+		}
+		if( (unsigned)(ch >> 8) != hi ){
+			hi = ch >> 8;
+			widths = block(ch, source);
+			if( !widths ){
+				return false;
+			}
+		}
+		advances[i] = widths[ch & 0xff];
+	}
+	return true;
+}
+
+AdvanceTableCache::AdvanceTableCache(size_t capacity){
+	capacity_ = capacity;
+}
+
+AdvanceTableCache::~AdvanceTableCache(){
+	clear();
+}
+
+AdvanceTable *AdvanceTableCache::table(const std::string &key){
+	std::map<std::string, AdvanceTable *>::iterator iter = tables_.find(key);
+	if( iter != tables_.end() ){
+		return iter->second;
+	}
+	if( tables_.size() >= capacity_ ){
+		clear();
+	}
+	AdvanceTable *table = new AdvanceTable();
+	tables_[key] = table;
+	return table;
+}
+
+void AdvanceTableCache::clear(){
+	std::map<std::string, AdvanceTable *>::iterator iter;
+	for(iter=tables_.begin();iter!=tables_.end();++iter){
+		delete iter->second;
+	}
+	tables_.clear();
+}
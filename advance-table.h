@@ -0,0 +1,70 @@
+#ifndef DRAWER_ADVANCE_TABLE_H
+#define DRAWER_ADVANCE_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <string>
+
+// Where an AdvanceTable gets its widths from (GetCharWidth32W and
+// GetTextExtentPoint32W with the font selected, for GDI).
+class AdvanceSource {
+public:
+	virtual ~AdvanceSource(){}
+	// Advance widths of the UTF-16 code units first..last (inclusive).
+	virtual bool charWidths(uint16_t first, uint16_t last, int *widths) = 0;
+	// Width of a text the table cannot sum (one with surrogate pairs).
+	virtual bool textWidth(const uint16_t *text, uint32_t length, long *width) = 0;
+};
+
+// Advance widths of one font on one device, loaded from an AdvanceSource a
+// block of 256 code units at a time on first use. Once a block is loaded,
+// measuring text made of its characters is a table lookup per character.
+class AdvanceTable {
+public:
+	AdvanceTable();
+	~AdvanceTable();
+
+	bool measure(const uint16_t *text, uint32_t length, AdvanceSource *source,
+		long *width);
+	// Measures count texts stored back to back in text, lengths[i] code units
+	// each, into widths[i].
+	bool measureBatch(const uint16_t *text, const uint32_t *lengths, uint32_t count,
+		AdvanceSource *source, int32_t *widths);
+	// Advance of each code unit of text into advances[i]. A surrogate pair is
+	// measured as a whole; its width goes to the first unit and 0 to the
+	// second.
+	bool advances(const uint16_t *text, uint32_t length, AdvanceSource *source,
+		int *advances);
+
+	size_t loadedBlocks() const { return loadedBlocks_; }
+	long sourceCalls() const { return sourceCalls_; }
+
+private:
+	AdvanceTable(const AdvanceTable &);
+	AdvanceTable &operator=(const AdvanceTable &);
+
+	const int *block(uint16_t ch, AdvanceSource *source);
+
+	int *blocks_[256];
+	size_t loadedBlocks_;
+	long sourceCalls_;
+};
+
+// Advance tables by font (see font_cache_key) and device resolution. Tables
+// are dropped all together when there are more than capacity fonts.
+class AdvanceTableCache {
+public:
+	explicit AdvanceTableCache(size_t capacity);
+	~AdvanceTableCache();
+
+	AdvanceTable *table(const std::string &key);
+	void clear();
+	size_t size() const { return tables_.size(); }
+
+private:
+	size_t capacity_;
+	std::map<std::string, AdvanceTable *> tables_;
+};
+
+#endif
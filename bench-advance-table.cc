@@ -0,0 +1,65 @@
+#include "bench-util.h"
+#include "advance-table.h"
+#include <string.h>
+#include <vector>
+
+// Cost of measuring text with a loaded advance table, with synthetic widths.
+
+class SyntheticSource : public AdvanceSource {
+public:
+	bool charWidths(uint16_t first, uint16_t last, int *widths){
+		unsigned ch;
+		for(ch=first;ch<=last;ch++){
+			widths[ch - first] = ch < 0x100 ? 59 + (int)(ch % 5) : 141;
+		}
+		return true;
+	}
+
+	bool textWidth(const uint16_t *text, uint32_t length, long *width){
+		*width = 141 * (long)length;
+		return true;
+	}
+};
+
+// count candidate lines of a menu, length units each, from the given blocks
+static void make_lines(std::vector<uint16_t> &text, std::vector<uint32_t> &lengths,
+		int count, int length, bool japanese){
+	int i, k;
+	unsigned seed = 1;
+	for(i=0;i<count;i++){
+		for(k=0;k<length;k++){
+			seed = seed * 1103515245 + 12345;
+			text.push_back(japanese && (seed >> 16) % 3 != 0 ?
+				(uint16_t)(0x3041 + (seed >> 8) % 0x50) : (uint16_t)(0x20 + (seed >> 8) % 0x5f));
+		}
+		lengths.push_back((uint32_t)length);
+	}
+}
+
+static void bench_batch(const char *name, bool japanese, int iterations){
+	SyntheticSource source;
+	AdvanceTable table;
+	std::vector<uint16_t> text;
+	std::vector<uint32_t> lengths;
+	make_lines(text, lengths, 200, 24, japanese);
+	std::vector<int32_t> widths(lengths.size());
+	long sum = 0;
+	int i;
+	double start = bench_now();
+	for(i=0;i<iterations;i++){
+		table.measureBatch(&text[0], &lengths[0], (uint32_t)lengths.size(), &source, &widths[0]);
+		sum += widths[i % widths.size()];
+	}
+	double elapsed = bench_now() - start;
+	bench_report(name, (double)text.size() * iterations, "chars", elapsed);
+	bench_report(name, (double)lengths.size() * iterations, "strings", elapsed);
+	if( sum == 0 ){
+		printf("unexpected zero width\n");
+	}
+}
+
+int main(){
+	bench_batch("ascii lines (24 chars)", false, 20000);
+	bench_batch("kana/ascii lines (24 chars)", true, 20000);
+	return 0;
+}
@@ -0,0 +1,56 @@
+#include "bench-util.h"
+#include "test-fixtures.h"
+#include "display-list.h"
+#include "page-executor.h"
+#include "recording-device.h"
+
+// Copies of a 40 line receipt job, drawn by running every page again and by
+// replaying each page from the display list recorded for its first copy.
+
+static const int LINES = 40;
+static const int PAGES = 4;
+static const int COPIES = 5;
+
+static void bench_copies(int iterations, bool replay){
+	PageBuilder builders[PAGES];
+	const Page *pages[PAGES];
+	int i;
+	for(i=0;i<PAGES;i++){
+		pages[i] = &fixture_receipt(builders[i], LINES + i);
+	}
+	RecordingDevice device(203, 203);
+	device.setRecording(false);
+	double start = bench_now();
+	for(i=0;i<iterations;i++){
+		PageExecutor executor(&device);
+		executor.setReplay(replay);
+		executor.setCopies(COPIES, true);
+		executor.runJob(pages, PAGES, 0, 0);
+	}
+	double elapsed = bench_now() - start;
+	bench_report(replay ? "receipt copies replayed" : "receipt copies run again",
+		(double)iterations * PAGES * COPIES, "pages", elapsed);
+}
+
+static void bench_hash(int iterations){
+	PageBuilder b;
+	const Page &page = fixture_receipt(b, LINES);
+	uint64_t h = 0;
+	int i;
+	double start = bench_now();
+	for(i=0;i<iterations;i++){
+		h += page_hash(page);
+	}
+	double elapsed = bench_now() - start;
+	bench_report("receipt page hashed", (double)iterations, "pages", elapsed);
+	if( h == 1 ){
+		printf("\n");
+	}
+}
+
+int main(){
+	bench_copies(2000, false);
+	bench_copies(2000, true);
+	bench_hash(50000);
+	return 0;
+}
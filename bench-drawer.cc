@@ -0,0 +1,348 @@
+#include "bench-util.h"
+#include "test-fixtures.h"
+#include "page-executor.h"
+#include "recording-device.h"
+#include "resample.h"
+#include "mono-image.h"
+#include <algorithm>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// Benchmark suite of the drawing pipeline against a non-recording device,
+// for comparing builds before they are deployed:
+//
+//   bench-drawer [--json out.json] [--baseline base.json] [--threshold 10] [--quick]
+//
+// Each case runs until it has both 20 iterations and 0.3 seconds (0.05 with
+// --quick) after one warm-up iteration, and reports work per second, p50
+// and p99 latency per page and heap allocations per page. --json writes the
+// results (one case per line); --baseline reads such a file and fails
+// (exit status 1) when a case is slower by more than --threshold percent or
+// allocates more per page.
+
+static long allocations = 0;
+
+void *operator new(size_t size){
+	allocations += 1;
+	void *p = malloc(size > 0 ? size : 1);
+	if( p == NULL ){
+		throw std::bad_alloc();
+	}
+	return p;
+}
+
+void operator delete(void *p) noexcept {
+	free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+	operator delete(p);
+}
+
+// One measured unit of work. run() does one iteration of pages() pages and
+// returns the work done in unit() (ops, pixels).
+class BenchCase {
+public:
+	virtual ~BenchCase(){}
+	virtual const char *name() const = 0;
+	virtual const char *unit() const = 0;
+	virtual int pages() const { return 1; }
+	virtual long run() = 0;
+};
+
+struct BenchResult {
+	std::string name;
+	std::string unit;
+	double perSec;
+	double p50;
+	double p99;
+	double allocsPerPage;
+	long iterations;
+};
+
+// Runs pages through a PageExecutor; a job of several pages goes through
+// runJob like a print job does.
+class PageCase : public BenchCase {
+public:
+	PageCase(const char *name, const Page &page, int pages)
+		: name_(name), page_(&page), pages_(pages), device_(600, 600), executor_(&device_) {
+		device_.setRecording(false);
+	}
+	const char *name() const { return name_; }
+	const char *unit() const { return "ops"; }
+	int pages() const { return pages_; }
+	long run(){
+		long before = executor_.opCount();
+		if( pages_ == 1 ){
+			executor_.runPage(*page_);
+		} else {
+			std::vector<const Page *> pages(pages_, page_);
+			executor_.runJob(&pages[0], pages.size(), NULL, 0);
+		}
+		return executor_.opCount() - before;
+	}
+
+private:
+	const char *name_;
+	const Page *page_;
+	int pages_;
+	RecordingDevice device_;
+	PageExecutor executor_;
+};
+
+// A 96 dpi logo scaled to a 203 dpi receipt printer and dithered, as the
+// image print path does it.
+class ImageCase : public BenchCase {
+public:
+	ImageCase() : src_(WIDTH * HEIGHT * 3), gray_(DST_WIDTH * DST_HEIGHT),
+			bgr_(DST_WIDTH * DST_HEIGHT * 3), bits_((DST_WIDTH + 7) / 8) {
+		size_t i;
+		for(i=0;i<src_.size();i++){
+			src_[i] = (uint8_t)(i * 7 + i / 13);
+		}
+		opts_.dither = MONO_DITHER_BAYER;
+	}
+	const char *name() const { return "image logo 203dpi"; }
+	const char *unit() const { return "pixels"; }
+	long run(){
+		uint32_t y;
+		resample_image(&src_[0], WIDTH * 3, WIDTH, HEIGHT, &bgr_[0], DST_WIDTH * 3,
+			DST_WIDTH, DST_HEIGHT, 3, RESAMPLE_BILINEAR, 1);
+		MonoConverter converter(opts_, DST_WIDTH);
+		for(y=0;y<DST_HEIGHT;y++){
+			mono_luma(&bgr_[(size_t)y * DST_WIDTH * 3], 3, DST_WIDTH, &gray_[(size_t)y * DST_WIDTH]);
+			converter.convertRow(&gray_[(size_t)y * DST_WIDTH], &bits_[0]);
+		}
+		return (long)DST_WIDTH * DST_HEIGHT;
+	}
+
+private:
+	static const uint32_t WIDTH = 240, HEIGHT = 80;
+	static const uint32_t DST_WIDTH = WIDTH * 203 / 96, DST_HEIGHT = HEIGHT * 203 / 96;
+	std::vector<uint8_t> src_, gray_, bgr_, bits_;
+	MonoOptions opts_;
+};
+
+// 20 lines of 256 characters: the glyph run split and the advances of
+// long strings.
+static Page &fixture_long_lines(PageBuilder &b){
+	char line[257];
+	int i, j;
+	b.clear();
+	b.createFont("body", "MS Gothic", 2.5, 0, 0);
+	b.setFont("body");
+	for(i=0;i<20;i++){
+		for(j=0;j<256;j++){
+			line[j] = (char)(' ' + (i + j) % 95);
+		}
+		line[256] = 0;
+		fixture_text(b, line, 5, 10 + i * 4, 0.75);
+	}
+	return b.finish();
+}
+
+// 24 fonts and 8 pens created on the page and switched between for every
+// short text, the worst case for the object handling.
+static Page &fixture_object_churn(PageBuilder &b){
+	char name[16];
+	int i;
+	b.clear();
+	for(i=0;i<24;i++){
+		snprintf(name, sizeof(name), "f%d", i);
+		b.createFont(name, i % 2 ? "MS Gothic" : "MS Mincho", 2.5 + i * 0.25, i % 3 ? 0 : 1, 0);
+	}
+	for(i=0;i<8;i++){
+		snprintf(name, sizeof(name), "p%d", i);
+		b.createPen(name, 0, 0, i * 30, 0.1 + i * 0.1);
+	}
+	for(i=0;i<96;i++){
+		snprintf(name, sizeof(name), "f%d", (i * 7) % 24);
+		b.setFont(name);
+		fixture_text(b, "Total", 10, 10 + i * 2.5, 2);
+		snprintf(name, sizeof(name), "p%d", i % 8);
+		b.setPen(name);
+		b.moveTo(30, 10 + i * 2.5);
+		b.lineTo(190, 10 + i * 2.5);
+	}
+	return b.finish();
+}
+
+static double percentile(std::vector<double> samples, double p){
+	if( samples.empty() ){
+		return 0;
+	}
+	std::sort(samples.begin(), samples.end());
+	size_t i = (size_t)(p * (samples.size() - 1) + 0.5);
+	return samples[i];
+}
+
+static BenchResult bench_case(BenchCase *c, double minSeconds){
+	std::vector<double> samples;
+	BenchResult result;
+	long work = 0, allocs;
+	double elapsed = 0;
+	c->run();
+	allocs = allocations;
+	while( samples.size() < 20 || elapsed < minSeconds ){
+		double start = bench_now();
+		work += c->run();
+		double seconds = bench_now() - start;
+		elapsed += seconds;
+		samples.push_back(seconds / c->pages());
+	}
+	allocs = allocations - allocs;
+	result.name = c->name();
+	result.unit = c->unit();
+	result.iterations = (long)samples.size();
+	result.perSec = elapsed > 0 ? work / elapsed : 0;
+	result.p50 = percentile(samples, 0.50) * 1e6;
+	result.p99 = percentile(samples, 0.99) * 1e6;
+	result.allocsPerPage = (double)allocs / ((double)samples.size() * c->pages());
+	return result;
+}
+
+static bool write_json(const char *path, const std::vector<BenchResult> &results){
+	FILE *file = fopen(path, "w");
+	size_t i;
+	if( file == NULL ){
+		return false;
+	}
+	fprintf(file, "{\n  \"benchmarks\": [\n");
+	for(i=0;i<results.size();i++){
+		const BenchResult &r = results[i];
+		fprintf(file, "    {\"name\": \"%s\", \"unit\": \"%s\", \"per_sec\": %.1f, "
+			"\"p50_us\": %.2f, \"p99_us\": %.2f, \"allocs_per_page\": %.2f, \"iterations\": %ld}%s\n",
+			r.name.c_str(), r.unit.c_str(), r.perSec, r.p50, r.p99, r.allocsPerPage,
+			r.iterations, i + 1 < results.size() ? "," : "");
+	}
+	fprintf(file, "  ]\n}\n");
+	return fclose(file) == 0;
+}
+
+static bool json_number(const char *line, const char *key, double *value){
+	const char *p = strstr(line, key);
+	if( p == NULL ){
+		return false;
+	}
+	*value = strtod(p + strlen(key), NULL);
+	return true;
+}
+
+// Reads a file written by write_json; only the fields compared are kept.
+static bool read_baseline(const char *path, std::vector<BenchResult> *results){
+	FILE *file = fopen(path, "r");
+	char line[512];
+	if( file == NULL ){
+		return false;
+	}
+	while( fgets(line, sizeof(line), file) ){
+		const char *name = strstr(line, "\"name\": \"");
+		BenchResult r;
+		if( name == NULL ){
+			continue;
+		}
+		name += strlen("\"name\": \"");
+		const char *end = strchr(name, '"');
+		if( end == NULL || !json_number(line, "\"per_sec\": ", &r.perSec) ||
+				!json_number(line, "\"allocs_per_page\": ", &r.allocsPerPage) ){
+			continue;
+		}
+		r.name.assign(name, end);
+		results->push_back(r);
+	}
+	fclose(file);
+	return true;
+}
+
+// Prints each case against the baseline; returns the number of regressions.
+static int compare(const std::vector<BenchResult> &results, const std::vector<BenchResult> &baseline,
+		double threshold){
+	size_t i, j;
+	int regressions = 0;
+	printf("\n%-28s %14s %14s %8s %s\n", "vs baseline", "per sec", "baseline", "change", "");
+	for(i=0;i<results.size();i++){
+		for(j=0;j<baseline.size()&&baseline[j].name!=results[i].name;j++){
+		}
+		if( j == baseline.size() ){
+			printf("%-28s %14.0f %14s\n", results[i].name.c_str(), results[i].perSec, "(new)");
+			continue;
+		}
+		const BenchResult &base = baseline[j];
+		double change = base.perSec > 0 ? (results[i].perSec / base.perSec - 1) * 100 : 0;
+		const char *verdict = "";
+		if( change < -threshold ){
+			verdict = "SLOWER";
+			regressions += 1;
+		} else if( results[i].allocsPerPage > base.allocsPerPage + 0.5 ){
+			verdict = "MORE ALLOCATIONS";
+			regressions += 1;
+		}
+		printf("%-28s %14.0f %14.0f %+7.1f%% %s\n", results[i].name.c_str(),
+			results[i].perSec, base.perSec, change, verdict);
+	}
+	return regressions;
+}
+
+int main(int argc, char **argv){
+	const char *jsonPath = NULL, *baselinePath = NULL;
+	double threshold = 10, minSeconds = 0.3;
+	int i;
+	for(i=1;i<argc;i++){
+		if( strcmp(argv[i], "--json") == 0 && i + 1 < argc ){
+			jsonPath = argv[++i];
+		} else if( strcmp(argv[i], "--baseline") == 0 && i + 1 < argc ){
+			baselinePath = argv[++i];
+		} else if( strcmp(argv[i], "--threshold") == 0 && i + 1 < argc ){
+			threshold = atof(argv[++i]);
+		} else if( strcmp(argv[i], "--quick") == 0 ){
+			minSeconds = 0.05;
+		} else {
+			fprintf(stderr, "usage: %s [--json out.json] [--baseline base.json] [--threshold pct] [--quick]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	PageBuilder receipt, table, lines, churn;
+	fixture_receipt(receipt, 40);
+	fixture_a4_table(table, 40);
+	fixture_long_lines(lines);
+	fixture_object_churn(churn);
+	PageCase receiptCase("dispatch receipt", receipt.page(), 1);
+	PageCase tableCase("dispatch A4 table", table.page(), 1);
+	PageCase linesCase("drawChars 256 chars", lines.page(), 1);
+	PageCase churnCase("font/pen churn", churn.page(), 1);
+	ImageCase imageCase;
+	PageCase receiptJob("job 50 receipts", receipt.page(), 50);
+	PageCase tableJob("job 50 A4 tables", table.page(), 50);
+	BenchCase *cases[] = { &receiptCase, &tableCase, &linesCase, &churnCase, &imageCase,
+		&receiptJob, &tableJob };
+
+	std::vector<BenchResult> results;
+	printf("%-28s %14s %10s %10s %12s\n", "case", "per sec", "p50 us", "p99 us", "allocs/page");
+	for(i=0;i<(int)(sizeof(cases)/sizeof(cases[0]));i++){
+		BenchResult r = bench_case(cases[i], minSeconds);
+		printf("%-28s %14.0f %10.2f %10.2f %12.2f  (%s)\n", r.name.c_str(), r.perSec,
+			r.p50, r.p99, r.allocsPerPage, r.unit.c_str());
+		results.push_back(r);
+	}
+	if( jsonPath && !write_json(jsonPath, results) ){
+		fprintf(stderr, "cannot write %s\n", jsonPath);
+		return 2;
+	}
+	if( baselinePath ){
+		std::vector<BenchResult> baseline;
+		if( !read_baseline(baselinePath, &baseline) ){
+			fprintf(stderr, "cannot read %s\n", baselinePath);
+			return 2;
+		}
+		int regressions = compare(results, baseline, threshold);
+		if( regressions > 0 ){
+			printf("%d regression(s) over %.0f%%\n", regressions, threshold);
+			return 1;
+		}
+	}
+	return 0;
+}
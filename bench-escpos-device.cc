@@ -0,0 +1,33 @@
+#include "bench-util.h"
+#include "test-fixtures.h"
+#include "escpos-device.h"
+
+// Pages per second and bytes per page of the ESC/POS compiler for a 500
+// receipt job, with text in the printer fonts and with everything sent as
+// raster images (what a driver would do).
+
+static void bench_job(const char *name, const Page &page, bool nativeText){
+	std::vector<const Page *> pages(500, &page);
+	std::vector<uint8_t> bytes;
+	EscPosOptions opts;
+	std::string err;
+	char label[64];
+	opts.nativeText = nativeText;
+	double start = bench_now();
+	if( !compile_escpos(&pages[0], pages.size(), opts, &bytes, &err) ){
+		printf("%s\n", err.c_str());
+		return;
+	}
+	double elapsed = bench_now() - start;
+	snprintf(label, sizeof(label), "%s %s", name, nativeText ? "text" : "raster");
+	bench_report(label, (double)pages.size(), "pages", elapsed);
+	printf("%-36s %12.0f bytes per page\n", "", (double)bytes.size() / pages.size());
+}
+
+int main(){
+	PageBuilder receipt;
+	fixture_receipt(receipt, 40);
+	bench_job("receipt", receipt.page(), true);
+	bench_job("receipt", receipt.page(), false);
+	return 0;
+}
@@ -0,0 +1,79 @@
+#include "bench-util.h"
+#include "mono-image.h"
+#include <string.h>
+#include <vector>
+
+// Throughput of the grayscale and packing kernels at each level the CPU
+// supports, and of the whole BMP conversion with each dither.
+
+static const uint32_t WIDTH = 4800, HEIGHT = 64;
+
+static void bench_kernels(int level, uint32_t bytesPerPixel, int iterations){
+	std::vector<uint8_t> bgr(WIDTH * bytesPerPixel), gray(WIDTH), bits(WIDTH / 8);
+	uint8_t thresholds[8];
+	uint32_t i;
+	int k;
+	char name[64];
+	for(i=0;i<bgr.size();i++){
+		bgr[i] = (uint8_t)(i * 7 + i / 13);
+	}
+	mono_bayer_row(0, thresholds);
+	mono_set_kernel_level(level);
+	snprintf(name, sizeof(name), "luma+pack %ubpp (%s)", bytesPerPixel * 8, mono_kernel_name(level));
+	double start = bench_now();
+	for(k=0;k<iterations;k++){
+		mono_luma(&bgr[0], bytesPerPixel, WIDTH, &gray[0]);
+		mono_pack(&gray[0], WIDTH, thresholds, &bits[0]);
+	}
+	bench_report(name, (double)WIDTH * iterations / 1e6, "Mpixels", bench_now() - start);
+}
+
+static std::vector<uint8_t> make_bmp24(){
+	uint32_t stride = WIDTH * 3;
+	std::vector<uint8_t> out(54 + stride * HEIGHT, 0);
+	uint32_t i;
+	out[0] = 'B';
+	out[1] = 'M';
+	out[10] = 54;
+	out[14] = 40;
+	out[18] = WIDTH & 0xff;
+	out[19] = WIDTH >> 8;
+	out[22] = HEIGHT;
+	out[26] = 1;
+	out[28] = 24;
+	for(i=54;i<out.size();i++){
+		out[i] = (uint8_t)(i * 7 + i / 13);
+	}
+	return out;
+}
+
+static void bench_convert(const char *name, int dither, int iterations){
+	std::vector<uint8_t> bmp = make_bmp24(), out;
+	BmpImage image;
+	MonoOptions opts;
+	std::string err;
+	int k;
+	if( !parse_bmp(&bmp[0], bmp.size(), &image, &err) ){
+		printf("%s\n", err.c_str());
+		return;
+	}
+	opts.dither = dither;
+	double start = bench_now();
+	for(k=0;k<iterations;k++){
+		bmp_to_mono(image, opts, &out, &err);
+	}
+	bench_report(name, (double)WIDTH * HEIGHT * iterations / 1e6, "Mpixels", bench_now() - start);
+}
+
+int main(){
+	int best = mono_kernel_level(), level;
+	for(level=MONO_SCALAR;level<=best;level++){
+		bench_kernels(level, 3, 20000);
+		bench_kernels(level, 4, 20000);
+	}
+	mono_set_kernel_level(best);
+	bench_convert("bmp_to_mono 24bpp none", MONO_DITHER_NONE, 200);
+	bench_convert("bmp_to_mono 24bpp bayer", MONO_DITHER_BAYER, 200);
+	bench_convert("bmp_to_mono 24bpp floyd-steinberg", MONO_DITHER_FLOYD_STEINBERG, 200);
+	return 0;
+}
@@ -0,0 +1,27 @@
+#include "bench-util.h"
+#include "test-fixtures.h"
+#include "page-executor.h"
+#include "recording-device.h"
+
+// Throughput of the native op interpreter against a non-recording device.
+
+static void bench_page(const char *name, const Page &page, int iterations){
+	RecordingDevice device(600, 600);
+	device.setRecording(false);
+	PageExecutor executor(&device);
+	double start = bench_now();
+	int i;
+	for(i=0;i<iterations;i++){
+		executor.runPage(page);
+	}
+	double elapsed = bench_now() - start;
+	bench_report(name, (double)executor.opCount(), "ops", elapsed);
+	bench_report(name, (double)device.totalCount(), "device calls", elapsed);
+}
+
+int main(){
+	PageBuilder receipt, table;
+	bench_page("receipt (40 lines)", fixture_receipt(receipt, 40), 20000);
+	bench_page("A4 table (40 rows)", fixture_a4_table(table, 40), 10000);
+	return 0;
+}
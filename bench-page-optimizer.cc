@@ -0,0 +1,42 @@
+#include "bench-util.h"
+#include "test-fixtures.h"
+#include "page-optimizer.h"
+#include "page-executor.h"
+#include "recording-device.h"
+
+// Throughput of PageOptimizer, and the ops and device calls it saves on the
+// fixture pages.
+
+static long device_calls(const Page &page){
+	RecordingDevice device(600, 600);
+	device.setRecording(false);
+	PageExecutor executor(&device);
+	executor.runPage(page);
+	return device.totalCount();
+}
+
+static void bench_page(const char *name, const Page &page, int iterations){
+	PageOptimizer optimizer;
+	PageBuilder out;
+	double start = bench_now();
+	int i;
+	for(i=0;i<iterations;i++){
+		optimizer.optimize(page, &out);
+	}
+	double elapsed = bench_now() - start;
+	bench_report(name, (double)optimizer.stats().opsIn, "ops", elapsed);
+
+	const Page &optimized = optimizer.optimize(page, &out);
+	long before = device_calls(page), after = device_calls(optimized);
+	printf("  ops %lu -> %lu, device calls %ld -> %ld (%.0f%% fewer)\n",
+		(unsigned long)page.ops.size(), (unsigned long)optimized.ops.size(), before, after,
+		before > 0 ? 100.0 * (before - after) / before : 0.0);
+}
+
+int main(){
+	PageBuilder receipt, table, generated;
+	bench_page("receipt (40 lines)", fixture_receipt(receipt, 40), 20000);
+	bench_page("A4 table (40 rows)", fixture_a4_table(table, 40), 10000);
+	bench_page("generated (40 lines)", fixture_generated(generated, 40), 10000);
+	return 0;
+}
@@ -0,0 +1,124 @@
+#include "bench-util.h"
+#include "test-fixtures.h"
+#include "page-template.h"
+#include "page-executor.h"
+#include "recording-device.h"
+
+// Instantiation cost of a compiled 40 line receipt template against
+// building the same page from scratch and running it through PageExecutor,
+// which is what every print costs without templates.
+
+static const int LINES = 40;
+
+static void build_template(PageTemplate &t){
+	PageBuilder &b = t.ops();
+	b.createFont("title", "MS Gothic", 6, 1, 0);
+	b.createFont("body", "MS Gothic", 3.5, 0, 0);
+	b.createPen("rule", 0, 0, 0, 0.2);
+	b.setFont("title");
+	fixture_text(b, "RECEIPT", 25, 5, 4);
+	b.setFont("body");
+	b.setPen("rule");
+	b.moveTo(2, 15);
+	b.lineTo(78, 15);
+	t.beginRepeat("items", 4.5);
+	t.field("name", 3, 17, 1.8, TEMPLATE_ALIGN_LEFT);
+	t.field("price", 62, 17, 1.8, TEMPLATE_ALIGN_LEFT);
+	t.end();
+	b.moveTo(2, 21.5);
+	b.lineTo(78, 21.5);
+	b.setFont("title");
+	b.setTextColor(0, 0, 0);
+	t.field("total", 20, 23.5, 3.5, TEMPLATE_ALIGN_LEFT);
+}
+
+static void set_ascii(TemplateValues &v, uint32_t scope, uint32_t row, uint32_t field, const char *ascii){
+	uint16_t text[64];
+	uint32_t n = 0;
+	while( ascii[n] && n < 64 ){
+		text[n] = (uint16_t)(unsigned char)ascii[n];
+		n++;
+	}
+	v.setText(scope, row, field, text, n);
+}
+
+static void fill_values(TemplateValues &v, PageTemplate &t){
+	char buf[64];
+	int i;
+	v.reset(t);
+	for(i=0;i<LINES;i++){
+		uint32_t row = v.addRow(1);
+		sprintf(buf, "Item %03d  Grilled chicken set", i + 1);
+		set_ascii(v, 1, row, 0, buf);
+		sprintf(buf, "%d.%02d", 10 + i % 50, i % 100);
+		set_ascii(v, 1, row, 1, buf);
+	}
+	set_ascii(v, 0, 0, 0, "TOTAL 1234.50");
+}
+
+static void bench_page(int iterations){
+	RecordingDevice device(203, 203);
+	device.setRecording(false);
+	PageExecutor executor(&device);
+	PageBuilder b;
+	int i;
+	double start = bench_now();
+	for(i=0;i<iterations;i++){
+		executor.runPage(fixture_receipt(b, LINES));
+	}
+	double elapsed = bench_now() - start;
+	bench_report("receipt page built and run", (double)iterations, "pages", elapsed);
+	bench_report("", (double)device.totalCount(), "device calls", elapsed);
+}
+
+static void bench_template(int iterations){
+	PageTemplate t;
+	std::string err;
+	build_template(t);
+	if( !t.compile(&err) ){
+		printf("%s\n", err.c_str());
+		return;
+	}
+	RecordingDevice device(203, 203);
+	device.setRecording(false);
+	TemplateExecutor executor(&device);
+	TemplateValues v;
+	int i;
+	double start = bench_now();
+	for(i=0;i<iterations;i++){
+		fill_values(v, t);
+		executor.runPage(t, v);
+	}
+	double elapsed = bench_now() - start;
+	bench_report("receipt template instantiated", (double)iterations, "pages", elapsed);
+	bench_report("", (double)device.totalCount(), "device calls", elapsed);
+
+	fill_values(v, t);
+	start = bench_now();
+	for(i=0;i<iterations;i++){
+		executor.runPage(t, v);
+	}
+	elapsed = bench_now() - start;
+	bench_report("receipt template, values kept", (double)iterations, "pages", elapsed);
+}
+
+static void bench_compile(int iterations){
+	int i;
+	double start = bench_now();
+	for(i=0;i<iterations;i++){
+		PageTemplate t;
+		std::string err;
+		build_template(t);
+		t.compile(&err);
+		t.resolve(203, 203, 0, 0);
+	}
+	double elapsed = bench_now() - start;
+	bench_report("receipt template compiled", (double)iterations, "templates", elapsed);
+}
+
+int main(){
+	bench_page(20000);
+	bench_template(20000);
+	bench_compile(20000);
+	return 0;
+}
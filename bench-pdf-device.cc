@@ -0,0 +1,47 @@
+#include "bench-util.h"
+#include "test-fixtures.h"
+#include "pdf-device.h"
+
+// Pages per second and bytes per page of the PDF writer for a 2000 page
+// job (an end-of-day report), with and without compressed content streams.
+// The output only counts bytes, so the numbers are those of the writer.
+
+class CountingOutput : public PdfOutput {
+public:
+	CountingOutput() : bytes(0) {}
+	bool write(const void *data, size_t length){
+		bytes += length;
+		return true;
+	}
+	uint64_t bytes;
+};
+
+static void bench_job(const char *name, const Page &page, double height, bool compress){
+	std::vector<const Page *> pages(2000, &page);
+	CountingOutput out;
+	PdfOptions opts;
+	std::string err;
+	char label[64];
+	opts.height = height;
+	opts.compress = compress;
+	double start = bench_now();
+	if( !render_pdf(&pages[0], pages.size(), opts, NULL, 0, &out, &err) ){
+		printf("%s\n", err.c_str());
+		return;
+	}
+	double elapsed = bench_now() - start;
+	snprintf(label, sizeof(label), "%s %s", name, compress ? "flate" : "plain");
+	bench_report(label, (double)pages.size(), "pages", elapsed);
+	printf("%-36s %12.0f bytes per page\n", "", (double)out.bytes / pages.size());
+}
+
+int main(){
+	PageBuilder receipt, table;
+	fixture_receipt(receipt, 40);
+	fixture_a4_table(table, 40);
+	bench_job("receipt", receipt.page(), 0, true);
+	bench_job("receipt", receipt.page(), 0, false);
+	bench_job("A4 table", table.page(), 297, true);
+	bench_job("A4 table", table.page(), 297, false);
+	return 0;
+}
@@ -0,0 +1,60 @@
+#include "bench-util.h"
+#include "test-png-fixtures.h"
+#include "png-image.h"
+#include <vector>
+
+// PNG decode throughput, to BGR rows and through the 1 bpp print path.
+
+class NullTarget : public ImageTarget {
+public:
+	bool drawBand(long destX, long destY, long destWidth, long destHeight,
+			uint32_t srcWidth, uint32_t srcRows, const uint8_t *pixels, const uint8_t *info){
+		return true;
+	}
+};
+
+static void bench_decode(const char *name, const uint8_t *data, size_t length, int iterations){
+	PngImage image;
+	std::string err;
+	int i;
+	uint32_t y;
+	if( !parse_png(data, length, &image, &err) ){
+		printf("%s: %s\n", name, err.c_str());
+		return;
+	}
+	std::vector<uint8_t> row(image.width * 3);
+	double start = bench_now();
+	for(i=0;i<iterations;i++){
+		PngRowReader reader(image);
+		for(y=0;y<image.height;y++){
+			reader.readRow(&row[0], &err);
+		}
+		reader.finish(&err);
+	}
+	double elapsed = bench_now() - start;
+	bench_report(name, (double)image.width * image.height * iterations / 1e6, "Mpixels", elapsed);
+	bench_report(name, (double)length * iterations / 1e3, "KB (PNG)", elapsed);
+}
+
+static void bench_mono(const char *name, const uint8_t *data, size_t length, int iterations){
+	PngImage image;
+	NullTarget target;
+	MonoOptions mono;
+	std::string err;
+	int i;
+	parse_png(data, length, &image, &err);
+	double start = bench_now();
+	for(i=0;i<iterations;i++){
+		draw_png_banded(image, &target, 0, 0, image.width, image.height, 256, &mono, &err);
+	}
+	bench_report(name, (double)image.width * image.height * iterations / 1e6, "Mpixels",
+		bench_now() - start);
+}
+
+int main(){
+	bench_decode("decode code (1 bit gray)", png_bench_code, sizeof(png_bench_code), 2000);
+	bench_decode("decode logo (RGBA, Paeth)", png_bench_logo, sizeof(png_bench_logo), 200);
+	bench_decode("decode palette8", png_palette8, sizeof(png_palette8), 20000);
+	bench_mono("logo to 1 bpp (floyd-steinberg)", png_bench_logo, sizeof(png_bench_logo), 200);
+	return 0;
+}
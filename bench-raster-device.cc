@@ -0,0 +1,48 @@
+#include "bench-util.h"
+#include "test-fixtures.h"
+#include "raster-device.h"
+
+// Pages per second of the software renderer for a 200 page batch: receipts
+// at thermal printer resolution and A4 tables at 300 dpi, in gray and 1 bpp,
+// PNG and PNM, on one and on four threads.
+
+static void bench_batch(const char *name, const Page &page, int dpi, double width,
+		int bits, int format, int threads){
+	std::vector<const Page *> pages(200, &page);
+	std::vector<std::vector<uint8_t> > files;
+	RasterOptions opts;
+	std::string err;
+	char label[64];
+	size_t i, bytes = 0;
+	opts.dpi = dpi;
+	opts.width = width;
+	opts.bits = bits;
+	opts.format = format;
+	opts.threads = threads;
+	double start = bench_now();
+	if( !render_pages(&pages[0], pages.size(), opts, &files, &err) ){
+		printf("%s\n", err.c_str());
+		return;
+	}
+	double elapsed = bench_now() - start;
+	for(i=0;i<files.size();i++){
+		bytes += files[i].size();
+	}
+	snprintf(label, sizeof(label), "%s %ubpp %s x%d", name, bits, format == RASTER_PNG ? "png" : "pnm", threads);
+	bench_report(label, (double)pages.size(), "pages", elapsed);
+	printf("%-36s %12.0f bytes per page\n", "", (double)bytes / files.size());
+}
+
+int main(){
+	PageBuilder receipt, table;
+	fixture_receipt(receipt, 40);
+	fixture_a4_table(table, 40);
+	bench_batch("receipt 203dpi", receipt.page(), 203, 80, 8, RASTER_PNG, 1);
+	bench_batch("receipt 203dpi", receipt.page(), 203, 80, 1, RASTER_PNG, 1);
+	bench_batch("receipt 203dpi", receipt.page(), 203, 80, 1, RASTER_PNM, 1);
+	bench_batch("receipt 203dpi", receipt.page(), 203, 80, 8, RASTER_PNG, 4);
+	bench_batch("A4 table 300dpi", table.page(), 300, 210, 8, RASTER_PNG, 1);
+	bench_batch("A4 table 300dpi", table.page(), 300, 210, 1, RASTER_PNM, 1);
+	bench_batch("A4 table 300dpi", table.page(), 300, 210, 8, RASTER_PNG, 4);
+	return 0;
+}
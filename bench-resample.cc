@@ -0,0 +1,44 @@
+#include "bench-util.h"
+#include "resample.h"
+#include <vector>
+
+// Throughput of the resampler per filter, SIMD against scalar and with
+// more threads, scaling a 96 dpi image to a 600 dpi page (and back down).
+
+static const uint32_t SRC_WIDTH = 800, SRC_HEIGHT = 600;
+
+static void bench_scale(const char *label, uint32_t sw, uint32_t sh, uint32_t dw, uint32_t dh,
+		uint32_t channels, int filter, bool simd, int threads, int iterations){
+	std::vector<uint8_t> src((size_t)sw * sh * channels), dst((size_t)dw * dh * channels);
+	size_t i;
+	int k;
+	char name[64];
+	for(i=0;i<src.size();i++){
+		src[i] = (uint8_t)(i * 7 + i / 13);
+	}
+	resample_use_simd(simd);
+	snprintf(name, sizeof(name), "%s %s %s x%d", label, channels == 1 ? "gray" : "bgr",
+		simd ? "simd" : "scalar", threads);
+	double start = bench_now();
+	for(k=0;k<iterations;k++){
+		resample_image(&src[0], sw * channels, sw, sh, &dst[0], dw * channels, dw, dh,
+			channels, filter, threads);
+	}
+	bench_report(name, (double)dw * dh * iterations / 1e6, "Mpixels", bench_now() - start);
+}
+
+int main(){
+	static const char *names[] = { "box", "bilinear", "lanczos3" };
+	uint32_t dw = SRC_WIDTH * 600 / 96, dh = SRC_HEIGHT * 600 / 96;
+	int filter;
+	for(filter=RESAMPLE_BOX;filter<=RESAMPLE_LANCZOS3;filter++){
+		bench_scale(names[filter], SRC_WIDTH, SRC_HEIGHT, dw, dh, 3, filter, false, 1, 2);
+		bench_scale(names[filter], SRC_WIDTH, SRC_HEIGHT, dw, dh, 3, filter, true, 1, 2);
+		bench_scale(names[filter], SRC_WIDTH, SRC_HEIGHT, dw, dh, 1, filter, true, 1, 4);
+	}
+	bench_scale("lanczos3", SRC_WIDTH, SRC_HEIGHT, dw, dh, 3, RESAMPLE_LANCZOS3, true, 2, 2);
+	bench_scale("lanczos3", SRC_WIDTH, SRC_HEIGHT, dw, dh, 3, RESAMPLE_LANCZOS3, true, 4, 2);
+	bench_scale("lanczos3 down", dw, dh, SRC_WIDTH, SRC_HEIGHT, 3, RESAMPLE_LANCZOS3, false, 1, 4);
+	bench_scale("lanczos3 down", dw, dh, SRC_WIDTH, SRC_HEIGHT, 3, RESAMPLE_LANCZOS3, true, 1, 4);
+	return 0;
+}
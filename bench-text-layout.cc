@@ -0,0 +1,119 @@
+#include "bench-util.h"
+#include "text-layout.h"
+#include <vector>
+
+// Throughput of TextLayout with synthetic widths (about 2.5 mm Latin and
+// 3.5 mm CJK characters at 203 dpi), against measuring every prefix of a
+// line as the JS layouts do with measureText.
+
+class SyntheticSource : public AdvanceSource {
+public:
+	SyntheticSource(){ calls = 0; }
+
+	bool charWidths(uint16_t first, uint16_t last, int *widths){
+		unsigned ch;
+		calls += 1;
+		for(ch=first;ch<=last;ch++){
+			widths[ch - first] = ch == ' ' ? 10 : ch < 0x100 ? 18 + (int)(ch % 5) : 28;
+		}
+		return true;
+	}
+
+	bool textWidth(const uint16_t *text, uint32_t length, long *width){
+		calls += 1;
+		*width = 28 * (long)length;
+		return true;
+	}
+
+	long calls;
+};
+
+// a paragraph of count words, Latin words of 2 to 9 letters or runs of 2 to 6
+// kana and kanji
+static std::vector<uint16_t> make_text(int count, bool japanese){
+	std::vector<uint16_t> text;
+	unsigned seed = 1;
+	int i, k, n;
+	for(i=0;i<count;i++){
+		seed = seed * 1103515245 + 12345;
+		n = 2 + (int)((seed >> 16) % (japanese ? 5 : 8));
+		for(k=0;k<n;k++){
+			seed = seed * 1103515245 + 12345;
+			text.push_back(japanese ? (uint16_t)((seed >> 16) % 4 ? 0x3041 + (seed >> 8) % 0x50 :
+				0x4e00 + (seed >> 8) % 0x1000) : (uint16_t)('a' + (seed >> 8) % 26));
+		}
+		if( !japanese || (seed >> 20) % 8 == 0 ){
+			text.push_back(japanese ? 0x3001 : ' ');
+		}
+	}
+	return text;
+}
+
+static void bench_layout(const char *name, const std::vector<uint16_t> &text, TextLayout &layout,
+		int iterations){
+	SyntheticSource source;
+	AdvanceTable table;
+	layout.layout(&text[0], (uint32_t)text.size(), &table, &source);
+	long warm = source.calls, lines = 0;
+	double start = bench_now();
+	int i;
+	for(i=0;i<iterations;i++){
+		layout.layout(&text[0], (uint32_t)text.size(), &table, &source);
+		lines += (long)layout.lines().size();
+	}
+	double elapsed = bench_now() - start;
+	bench_report(name, (double)text.size() * iterations, "chars", elapsed);
+	bench_report(name, (double)lines, "lines", elapsed);
+	printf("  source calls after the first layout: %ld\n", source.calls - warm);
+}
+
+// x of every character by measuring each prefix, one call per character
+static void bench_prefixes(const char *name, const std::vector<uint16_t> &text, int iterations){
+	SyntheticSource source;
+	AdvanceTable table;
+	std::vector<long> xs(text.size());
+	double start = bench_now();
+	long sum = 0;
+	int i;
+	uint32_t k;
+	for(i=0;i<iterations;i++){
+		for(k=0;k<text.size();k++){
+			table.measure(&text[0], k, &source, &xs[k]);
+		}
+		sum += xs[text.size() - 1];
+	}
+	double elapsed = bench_now() - start;
+	bench_report(name, (double)text.size() * iterations, "chars", elapsed);
+	if( sum == 0 ){
+		printf("unexpected zero width\n");
+	}
+}
+
+int main(){
+	std::vector<uint16_t> latin = make_text(60, false), japanese = make_text(60, true);
+	static const uint16_t row[] = { 'G', 'r', 'i', 'l', 'l', 'e', 'd', ' ', 'c', 'h', 'i', 'c',
+		'k', 'e', 'n', ' ', 's', 'e', 't', '\t', '1', '2', '.', '5', '0', '\n' };
+	std::vector<uint16_t> rows;
+	int i;
+	for(i=0;i<40;i++){
+		rows.insert(rows.end(), row, row + sizeof(row)/sizeof(row[0]));
+	}
+
+	// a 72 mm column at 203 dpi
+	TextLayout layout;
+	layout.setWidth(575);
+	bench_layout("latin paragraph (72 mm)", latin, layout, 20000);
+	bench_layout("japanese paragraph (72 mm)", japanese, layout, 20000);
+	layout.setAlign(ALIGN_CENTER);
+	bench_layout("latin paragraph, centered", latin, layout, 20000);
+	layout.setAlign(ALIGN_LEFT);
+	layout.setMaxLines(2);
+	bench_layout("latin paragraph, 2 lines and ellipsis", latin, layout, 20000);
+	layout.setMaxLines(0);
+	TabStop price = { 575, ALIGN_RIGHT };
+	layout.setTabStops(&price, 1);
+	bench_layout("item/price rows (40)", rows, layout, 20000);
+
+	bench_prefixes("latin paragraph, prefix widths", latin, 200);
+	return 0;
+}
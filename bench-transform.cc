@@ -0,0 +1,92 @@
+#include "bench-util.h"
+#include "transform.h"
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+
+// Throughput of the mm to pixel conversion: the float expression printer.js
+// used, mm_to_pixel per coordinate and transform_points over whole arrays,
+// plain and rotated.
+
+static const size_t POINTS = 4096;
+static const int ROUNDS = 2000;
+
+static long float_mm_to_pixel(int dpi, double mm){
+	double inch = mm/25.4;
+	return (long)floor(dpi * inch);
+}
+
+static long checksum(const std::vector<long> &xs, const std::vector<long> &ys){
+	long sum = 0;
+	size_t i;
+	for(i=0;i<xs.size();i++){
+		sum += xs[i] ^ ys[i];
+	}
+	return sum;
+}
+
+int main(){
+	std::vector<double> xs(POINTS), ys(POINTS);
+	std::vector<long> px(POINTS), py(POINTS);
+	size_t i;
+	int round;
+	long sum = 0;
+	srand(1);
+	for(i=0;i<POINTS;i++){
+		xs[i] = (rand() % 720) / 10.0 + 4;
+		ys[i] = (rand() % 30000) / 10.0;
+	}
+	double total = (double)POINTS * ROUNDS;
+
+	double start = bench_now();
+	for(round=0;round<ROUNDS;round++){
+		for(i=0;i<POINTS;i++){
+			px[i] = float_mm_to_pixel(203, xs[i] + 1.5);
+			py[i] = float_mm_to_pixel(203, ys[i] + 2);
+		}
+		sum += checksum(px, py);
+	}
+	bench_report("float mmToPixel", total, "points", bench_now() - start);
+
+	start = bench_now();
+	for(round=0;round<ROUNDS;round++){
+		for(i=0;i<POINTS;i++){
+			px[i] = mm_to_pixel(203, xs[i] + 1.5);
+			py[i] = mm_to_pixel(203, ys[i] + 2);
+		}
+		sum += checksum(px, py);
+	}
+	bench_report("mm_to_pixel per point", total, "points", bench_now() - start);
+
+	Transform offset = transform_identity();
+	offset.e = mm_to_fixed(1.5);
+	offset.f = mm_to_fixed(2);
+	start = bench_now();
+	for(round=0;round<ROUNDS;round++){
+		transform_points(offset, 203, 203, &xs[0], 1, &ys[0], 1, POINTS, &px[0], &py[0]);
+		sum += checksum(px, py);
+	}
+	bench_report("transform_points (offset)", total, "points", bench_now() - start);
+
+	double y = 30;
+	start = bench_now();
+	for(round=0;round<ROUNDS;round++){
+		transform_points(offset, 203, 203, &xs[0], 1, &y, 0, POINTS, &px[0], &py[0]);
+		sum += checksum(px, py);
+	}
+	bench_report("transform_points (one baseline)", total, "points", bench_now() - start);
+
+	TransformStack stack;
+	stack.translate(50, 10);
+	stack.rotate(30);
+	stack.scale(0.725, 0.725);
+	start = bench_now();
+	for(round=0;round<ROUNDS;round++){
+		transform_points(stack.current(), 203, 203, &xs[0], 1, &ys[0], 1, POINTS, &px[0], &py[0]);
+		sum += checksum(px, py);
+	}
+	bench_report("transform_points (rotated)", total, "points", bench_now() - start);
+
+	printf("checksum %ld\n", sum);
+	return 0;
+}
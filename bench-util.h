@@ -0,0 +1,19 @@
+#ifndef DRAWER_BENCH_UTIL_H
+#define DRAWER_BENCH_UTIL_H
+
+// Helpers for the native benchmark programs (bench-*.cc).
+
+#include <chrono>
+#include <stdio.h>
+
+static inline double bench_now(){
+	return std::chrono::duration<double>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static inline void bench_report(const char *name, double count, const char *unit, double seconds){
+	printf("%-36s %12.0f %s/sec  (%.0f %s in %.3f sec)\n", name,
+		seconds > 0 ? count / seconds : 0, unit, count, unit, seconds);
+}
+
+#endif
@@ -1,9 +1,573 @@
 {
+  "variables": {
+    "drawer_tests%": 0
+  },
   "targets": [
     {
       "target_name": "drawer",
-      "sources": [ "drawer.cc" ],
+      "sources": [
+        "drawer.cc",
+        "page.cc",
+        "page-executor.cc",
+        "transform.cc",
+        "path-builder.cc",
+        "page-optimizer.cc",
+        "display-list.cc",
+        "page-format.cc",
+        "print-job.cc",
+        "spooler.cc",
+        "glyph-run.cc",
+        "object-cache.cc",
+        "advance-table.cc",
+        "text-layout.cc",
+        "dc-pool.cc",
+        "printer-caps.cc",
+        "bmp-image.cc",
+        "mono-image.cc",
+        "inflate.cc",
+        "png-image.cc",
+        "resample.cc",
+        "deflate.cc",
+        "raster-device.cc",
+        "pdf-device.cc",
+        "escpos-device.cc",
+        "job-stats.cc",
+        "page-template.cc",
+        "gdi-device.cc"
+      ],
 	  "include_dirs": ["<!(node -e \"require('nan')\")"]
     }
+  ],
+  "conditions": [
+    # Native tests and benchmarks of the portable core. They do not need GDI
+    # and build on any platform:
+    #   node-gyp configure -- -Ddrawer_tests=1
+    #   make -C build test-page-executor (or msbuild on Windows)
+    ["drawer_tests==1", {
+      "targets": [
+        {
+          "target_name": "test-page-executor",
+          "type": "executable",
+          "sources": [
+            "test-page-executor.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "test-page-format",
+          "type": "executable",
+          "sources": [
+            "test-page-format.cc",
+            "page.cc",
+            "page-format.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "test-print-job",
+          "type": "executable",
+          "sources": [
+            "test-print-job.cc",
+            "page.cc",
+            "page-format.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "print-job.cc",
+            "job-stats.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "test-glyph-run",
+          "type": "executable",
+          "sources": [
+            "test-glyph-run.cc",
+            "glyph-run.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc"
+          ]
+        },
+        {
+          "target_name": "test-object-cache",
+          "type": "executable",
+          "sources": [
+            "test-object-cache.cc",
+            "object-cache.cc"
+          ]
+        },
+        {
+          "target_name": "test-advance-table",
+          "type": "executable",
+          "sources": [
+            "test-advance-table.cc",
+            "advance-table.cc"
+          ]
+        },
+        {
+          "target_name": "test-text-layout",
+          "type": "executable",
+          "sources": [
+            "test-text-layout.cc",
+            "text-layout.cc",
+            "advance-table.cc",
+            "page.cc"
+          ]
+        },
+        {
+          "target_name": "test-spooler",
+          "type": "executable",
+          "sources": [
+            "test-spooler.cc",
+            "spooler.cc",
+            "print-job.cc",
+            "job-stats.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "page-format.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "test-dc-pool",
+          "type": "executable",
+          "sources": [
+            "test-dc-pool.cc",
+            "dc-pool.cc"
+          ]
+        },
+        {
+          "target_name": "test-bmp-image",
+          "type": "executable",
+          "sources": [
+            "test-bmp-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "test-mono-image",
+          "type": "executable",
+          "sources": [
+            "test-mono-image.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "test-png-image",
+          "type": "executable",
+          "sources": [
+            "test-png-image.cc",
+            "png-image.cc",
+            "resample.cc",
+            "inflate.cc",
+            "deflate.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "test-resample",
+          "type": "executable",
+          "sources": [
+            "test-resample.cc",
+            "resample.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "test-raster-device",
+          "type": "executable",
+          "sources": [
+            "test-raster-device.cc",
+            "raster-device.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "png-image.cc",
+            "resample.cc",
+            "inflate.cc",
+            "deflate.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "test-pdf-device",
+          "type": "executable",
+          "sources": [
+            "test-pdf-device.cc",
+            "pdf-device.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "inflate.cc",
+            "deflate.cc"
+          ]
+        },
+        {
+          "target_name": "test-escpos-device",
+          "type": "executable",
+          "sources": [
+            "test-escpos-device.cc",
+            "escpos-device.cc",
+            "raster-device.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "png-image.cc",
+            "resample.cc",
+            "inflate.cc",
+            "deflate.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "test-job-stats",
+          "type": "executable",
+          "sources": [
+            "test-job-stats.cc",
+            "job-stats.cc",
+            "print-job.cc",
+            "page.cc",
+            "page-format.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "test-page-template",
+          "type": "executable",
+          "sources": [
+            "test-page-template.cc",
+            "page-template.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "test-printer-caps",
+          "type": "executable",
+          "sources": [
+            "test-printer-caps.cc",
+            "printer-caps.cc",
+            "dc-pool.cc"
+          ]
+        },
+        {
+          "target_name": "test-display-list",
+          "type": "executable",
+          "sources": [
+            "test-display-list.cc",
+            "display-list.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "test-transform",
+          "type": "executable",
+          "sources": [
+            "test-transform.cc",
+            "transform.cc",
+            "page.cc",
+            "page-executor.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "page-template.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "test-path-builder",
+          "type": "executable",
+          "sources": [
+            "test-path-builder.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "test-page-optimizer",
+          "type": "executable",
+          "sources": [
+            "test-page-optimizer.cc",
+            "page-optimizer.cc",
+            "raster-device.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "recording-device.cc",
+            "png-image.cc",
+            "resample.cc",
+            "inflate.cc",
+            "deflate.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "bench-page-executor",
+          "type": "executable",
+          "sources": [
+            "bench-page-executor.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "bench-advance-table",
+          "type": "executable",
+          "sources": [
+            "bench-advance-table.cc",
+            "advance-table.cc"
+          ]
+        },
+        {
+          "target_name": "bench-text-layout",
+          "type": "executable",
+          "sources": [
+            "bench-text-layout.cc",
+            "text-layout.cc",
+            "advance-table.cc"
+          ]
+        },
+        {
+          "target_name": "bench-mono-image",
+          "type": "executable",
+          "sources": [
+            "bench-mono-image.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "bench-png-image",
+          "type": "executable",
+          "sources": [
+            "bench-png-image.cc",
+            "png-image.cc",
+            "resample.cc",
+            "inflate.cc",
+            "deflate.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "bench-resample",
+          "type": "executable",
+          "sources": [
+            "bench-resample.cc",
+            "resample.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "bench-raster-device",
+          "type": "executable",
+          "sources": [
+            "bench-raster-device.cc",
+            "raster-device.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "png-image.cc",
+            "resample.cc",
+            "inflate.cc",
+            "deflate.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "bench-pdf-device",
+          "type": "executable",
+          "sources": [
+            "bench-pdf-device.cc",
+            "pdf-device.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "deflate.cc"
+          ]
+        },
+        {
+          "target_name": "bench-escpos-device",
+          "type": "executable",
+          "sources": [
+            "bench-escpos-device.cc",
+            "escpos-device.cc",
+            "raster-device.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "png-image.cc",
+            "resample.cc",
+            "inflate.cc",
+            "deflate.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "bench-drawer",
+          "type": "executable",
+          "sources": [
+            "bench-drawer.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "recording-device.cc",
+            "resample.cc",
+            "mono-image.cc",
+            "bmp-image.cc"
+          ]
+        },
+        {
+          "target_name": "bench-page-template",
+          "type": "executable",
+          "sources": [
+            "bench-page-template.cc",
+            "page-template.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "bench-display-list",
+          "type": "executable",
+          "sources": [
+            "bench-display-list.cc",
+            "display-list.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "page-optimizer.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        },
+        {
+          "target_name": "bench-transform",
+          "type": "executable",
+          "sources": [
+            "bench-transform.cc",
+            "transform.cc"
+          ]
+        },
+        {
+          "target_name": "bench-page-optimizer",
+          "type": "executable",
+          "sources": [
+            "bench-page-optimizer.cc",
+            "page-optimizer.cc",
+            "page.cc",
+            "page-executor.cc",
+            "transform.cc",
+            "path-builder.cc",
+            "display-list.cc",
+            "glyph-run.cc",
+            "recording-device.cc"
+          ]
+        }
+      ]
+    }]
   ]
 }
@@ -0,0 +1,225 @@
+#include "bmp-image.h"
+#include <string.h>
+
+static uint32_t read_u16(const uint8_t *p){
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8);
+}
+
+static uint32_t read_u32(const uint8_t *p){
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void write_u32(uint8_t *p, uint32_t value){
+	p[0] = (uint8_t)value;
+	p[1] = (uint8_t)(value >> 8);
+	p[2] = (uint8_t)(value >> 16);
+	p[3] = (uint8_t)(value >> 24);
+}
+
+static bool bmp_error(std::string *err, const char *message){
+	*err = message;
+	return false;
+}
+
+// BITMAPFILEHEADER is 14 bytes, BITMAPINFOHEADER at least 40.
+bool parse_bmp(const uint8_t *data, size_t length, BmpImage *image, std::string *err){
+	if( length < 14 + 40 || data[0] != 'B' || data[1] != 'M' ){
+		return bmp_error(err, "not a BMP file");
+	}
+	uint32_t pixelOffset = read_u32(data + 10);
+	const uint8_t *info = data + 14;
+	uint32_t headerSize = read_u32(info);
+	if( headerSize < 40 || headerSize > length - 14 ){
+		return bmp_error(err, "unsupported BMP header");
+	}
+	int32_t width = (int32_t)read_u32(info + 4);
+	int32_t height = (int32_t)read_u32(info + 8);
+	uint32_t planes = read_u16(info + 12);
+	uint32_t bits = read_u16(info + 14);
+	uint32_t compression = read_u32(info + 16);
+	uint32_t colors = read_u32(info + 32);
+	if( planes != 1 || width <= 0 || height == 0 || height == INT32_MIN ||
+			width > 65535 || height > 1000000 || height < -1000000 ){
+		return bmp_error(err, "invalid BMP size");
+	}
+	if( !(bits == 1 || bits == 4 || bits == 8 || bits == 16 || bits == 24 || bits == 32) ){
+		return bmp_error(err, "unsupported BMP bit depth");
+	}
+	if( !(compression == BMP_RGB || (compression == BMP_BITFIELDS && (bits == 16 || bits == 32))) ){
+		return bmp_error(err, "compressed BMP is not supported");
+	}
+	// the masks follow a 40 byte header, or are part of a V2 header or
+	// larger; bmp_row_bgr reads them at info + 40
+	if( compression == BMP_BITFIELDS && headerSize != 40 && headerSize < 52 ){
+		return bmp_error(err, "unsupported BMP header");
+	}
+	uint32_t masks = (compression == BMP_BITFIELDS && headerSize == 40) ? 12 : 0;
+	if( bits <= 8 ){
+		if( colors == 0 ){
+			colors = 1u << bits;
+		}
+		if( colors > (1u << bits) ){
+			return bmp_error(err, "invalid BMP palette");
+		}
+	} else {
+		colors = 0;
+	}
+	uint64_t infoLength = (uint64_t)headerSize + masks + (uint64_t)colors * 4;
+	if( pixelOffset < 14 + infoLength || pixelOffset > length ){
+		return bmp_error(err, "invalid BMP pixel offset");
+	}
+	uint32_t rows = (uint32_t)(height < 0 ? -height : height);
+	uint64_t stride = (((uint64_t)width * bits + 31) / 32) * 4;
+	if( stride * rows > length - pixelOffset ){
+		return bmp_error(err, "truncated BMP");
+	}
+	image->width = (uint32_t)width;
+	image->height = rows;
+	image->bottomUp = height > 0;
+	image->bitsPerPixel = bits;
+	image->compression = compression;
+	image->stride = (uint32_t)stride;
+	image->info = info;
+	image->infoLength = (uint32_t)infoLength;
+	image->pixels = data + pixelOffset;
+	return true;
+}
+
+static long scaled_row(uint32_t srcY, uint32_t height, long destHeight){
+	return (long)(((int64_t)srcY * destHeight) / (int64_t)height);
+}
+
+void plan_image_bands(const BmpImage &image, uint32_t bandRows, long destY,
+		long destHeight, std::vector<ImageBand> *bands){
+	plan_image_bands(image.height, bandRows, destY, destHeight, bands);
+}
+
+void plan_image_bands(uint32_t height, uint32_t bandRows, long destY,
+		long destHeight, std::vector<ImageBand> *bands){
+	uint32_t srcY;
+	bands->clear();
+	if( bandRows == 0 ){
+		bandRows = height;
+	}
+	for(srcY=0;srcY<height;srcY+=bandRows){
+		ImageBand band;
+		band.srcY = srcY;
+		band.rows = height - srcY < bandRows ? height - srcY : bandRows;
+		long top = scaled_row(srcY, height, destHeight);
+		long bottom = scaled_row(srcY + band.rows, height, destHeight);
+		band.destY = destY + top;
+		band.destHeight = bottom - top;
+		bands->push_back(band);
+	}
+}
+
+const uint8_t *band_pixels(const BmpImage &image, const ImageBand &band){
+	uint32_t firstStored = image.bottomUp ? image.height - band.srcY - band.rows : band.srcY;
+	return image.pixels + (size_t)firstStored * image.stride;
+}
+
+void band_info(const BmpImage &image, const ImageBand &band, std::vector<uint8_t> *info){
+	info->assign(image.info, image.info + image.infoLength);
+	// biHeight, biSizeImage
+	int32_t height = image.bottomUp ? (int32_t)band.rows : -(int32_t)band.rows;
+	write_u32(&(*info)[8], (uint32_t)height);
+	write_u32(&(*info)[20], band.rows * image.stride);
+}
+
+// Channel of a 16 or 32 bpp pixel under a color mask, scaled to 8 bits.
+static uint8_t mask_channel(uint32_t pixel, uint32_t mask){
+	if( mask == 0 ){
+		return 0;
+	}
+	uint32_t shift = 0, max;
+	while( !(mask & (1u << shift)) ){
+		shift += 1;
+	}
+	max = mask >> shift;
+	return (uint8_t)((((pixel & mask) >> shift) * 255 + max / 2) / max);
+}
+
+void bmp_row_bgr(const BmpImage &image, uint32_t y, uint8_t *bgr){
+	uint32_t stored = image.bottomUp ? image.height - 1 - y : y;
+	const uint8_t *row = image.pixels + (size_t)stored * image.stride;
+	uint32_t width = image.width, bpp = image.bitsPerPixel, x;
+	uint32_t headerSize = read_u32(image.info);
+	if( bpp == 24 ){
+		memcpy(bgr, row, (size_t)width * 3);
+	} else if( bpp <= 8 ){
+		const uint8_t *palette = image.info + headerSize;
+		uint32_t colors = (image.infoLength - headerSize) / 4;
+		uint32_t perByte = 8 / bpp, mask = (1u << bpp) - 1;
+		for(x=0;x<width;x++){
+			uint32_t index = (row[x / perByte] >> (8 - bpp * (x % perByte + 1))) & mask;
+			if( index < colors ){
+				memcpy(bgr + 3 * x, palette + 4 * index, 3);
+			} else {
+				memset(bgr + 3 * x, 0, 3);
+			}
+		}
+	} else {
+		// BI_RGB defaults: 5-5-5 and 8-8-8; BI_BITFIELDS masks follow the header
+		uint32_t red = bpp == 16 ? 0x7c00 : 0xff0000;
+		uint32_t green = bpp == 16 ? 0x3e0 : 0xff00;
+		uint32_t blue = bpp == 16 ? 0x1f : 0xff;
+		if( image.compression == BMP_BITFIELDS ){
+			red = read_u32(image.info + 40);
+			green = read_u32(image.info + 44);
+			blue = read_u32(image.info + 48);
+		}
+		if( bpp == 32 && red == 0xff0000 && green == 0xff00 && blue == 0xff ){
+			for(x=0;x<width;x++){
+				memcpy(bgr + 3 * x, row + 4 * x, 3);
+			}
+			return;
+		}
+		for(x=0;x<width;x++){
+			uint32_t pixel = bpp == 16 ? read_u16(row + 2 * x) : read_u32(row + 4 * x);
+			bgr[3 * x] = mask_channel(pixel, blue);
+			bgr[3 * x + 1] = mask_channel(pixel, green);
+			bgr[3 * x + 2] = mask_channel(pixel, red);
+		}
+	}
+}
+
+void make_dib_info(uint32_t width, int32_t height, uint32_t bitsPerPixel,
+		std::vector<uint8_t> *info){
+	uint32_t stride = ((width * bitsPerPixel + 31) / 32) * 4;
+	uint32_t rows = (uint32_t)(height < 0 ? -height : height);
+	info->assign(bitsPerPixel == 1 ? 40 + 8 : 40, 0);
+	uint8_t *p = &(*info)[0];
+	write_u32(p, 40);
+	write_u32(p + 4, width);
+	write_u32(p + 8, (uint32_t)height);
+	// biPlanes, biBitCount
+	p[12] = 1;
+	p[14] = (uint8_t)bitsPerPixel;
+	write_u32(p + 20, stride * rows);
+	if( bitsPerPixel == 1 ){
+		write_u32(p + 32, 2);
+		memset(p + 44, 0xff, 3);
+	}
+}
+
+bool draw_bmp_banded(const BmpImage &image, ImageTarget *target, long destX, long destY,
+		long destWidth, long destHeight, uint32_t bandRows, std::string *err){
+	std::vector<ImageBand> bands;
+	std::vector<uint8_t> info;
+	size_t i;
+	plan_image_bands(image, bandRows, destY, destHeight, &bands);
+	for(i=0;i<bands.size();i++){
+		const ImageBand &band = bands[i];
+		if( band.destHeight == 0 ){
+			// shrunk to less than a device row
+			continue;
+		}
+		band_info(image, band, &info);
+		if( !target->drawBand(destX, band.destY, destWidth, band.destHeight,
+				image.width, band.rows, band_pixels(image, band), &info[0]) ){
+			*err = "StretchDIBits failed";
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,101 @@
+#ifndef DRAWER_BMP_IMAGE_H
+#define DRAWER_BMP_IMAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// BI_RGB, BI_BITFIELDS
+const uint32_t BMP_RGB = 0;
+const uint32_t BMP_BITFIELDS = 3;
+
+// A BMP file that is read in place (a mapped file or a Buffer): the
+// headers are validated once by parse_bmp and the pixels are not copied.
+struct BmpImage {
+	uint32_t width;
+	uint32_t height;
+	// rows are stored bottom row first (positive biHeight)
+	bool bottomUp;
+	uint32_t bitsPerPixel;
+	uint32_t compression;
+	// bytes per stored row, padded to 4 bytes
+	uint32_t stride;
+	// BITMAPINFO: info header followed by masks and palette
+	const uint8_t *info;
+	uint32_t infoLength;
+	const uint8_t *pixels;
+};
+
+bool parse_bmp(const uint8_t *data, size_t length, BmpImage *image, std::string *err);
+
+// Rows [srcY, srcY + rows) of the image, counted from the top, drawn at
+// device rows [destY, destY + destHeight).
+struct ImageBand {
+	uint32_t srcY;
+	uint32_t rows;
+	long destY;
+	long destHeight;
+};
+
+// Splits an image drawn into the destination rectangle (destY, destHeight)
+// into bands of at most bandRows source rows. Destination rows are split at
+// the same positions as the whole image would be scaled, so the bands
+// neither overlap nor leave gaps.
+void plan_image_bands(const BmpImage &image, uint32_t bandRows, long destY,
+	long destHeight, std::vector<ImageBand> *bands);
+void plan_image_bands(uint32_t height, uint32_t bandRows, long destY,
+	long destHeight, std::vector<ImageBand> *bands);
+
+// The stored rows of a band and a BITMAPINFO for them (biHeight and
+// biSizeImage patched), as StretchDIBits takes them.
+const uint8_t *band_pixels(const BmpImage &image, const ImageBand &band);
+void band_info(const BmpImage &image, const ImageBand &band, std::vector<uint8_t> *info);
+
+// BITMAPINFO of an uncompressed DIB (height < 0 for top-down rows); 1 bpp
+// gets a black (0) and white (1) palette.
+void make_dib_info(uint32_t width, int32_t height, uint32_t bitsPerPixel,
+	std::vector<uint8_t> *info);
+
+// Row y (counted from the top) of a BMP as BGR.
+void bmp_row_bgr(const BmpImage &image, uint32_t y, uint8_t *bgr);
+
+// Rows of an image as BGR, top row first, each read once and in order.
+class ImageRows {
+public:
+	virtual ~ImageRows(){}
+	virtual uint32_t width() const = 0;
+	virtual uint32_t height() const = 0;
+	virtual bool readRow(uint8_t *bgr, std::string *err) = 0;
+};
+
+class BmpRows : public ImageRows {
+public:
+	explicit BmpRows(const BmpImage &image) : image_(image), y_(0) {}
+
+	uint32_t width() const { return image_.width; }
+	uint32_t height() const { return image_.height; }
+	bool readRow(uint8_t *bgr, std::string *err){
+		bmp_row_bgr(image_, y_++, bgr);
+		return true;
+	}
+
+private:
+	const BmpImage &image_;
+	uint32_t y_;
+};
+
+// Draws bands of an image (StretchDIBits for GDI).
+class ImageTarget {
+public:
+	virtual ~ImageTarget(){}
+	virtual bool drawBand(long destX, long destY, long destWidth, long destHeight,
+		uint32_t srcWidth, uint32_t srcRows, const uint8_t *pixels, const uint8_t *info) = 0;
+};
+
+// Draws image scaled into (destX, destY, destWidth, destHeight), one band of
+// at most bandRows rows at a time.
+bool draw_bmp_banded(const BmpImage &image, ImageTarget *target, long destX, long destY,
+	long destWidth, long destHeight, uint32_t bandRows, std::string *err);
+
+#endif
@@ -0,0 +1,146 @@
+#include "dc-pool.h"
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+static double steady_seconds(){
+	return std::chrono::duration<double>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+std::string dc_pool_key(const std::string &printer, const char *devmode, size_t devmodeLength){
+	uint64_t hash = 14695981039346656037ULL;
+	size_t i;
+	char buf[32];
+	for(i=0;i<devmodeLength;i++){
+		hash ^= (unsigned char)devmode[i];
+		hash *= 1099511628211ULL;
+	}
+	sprintf(buf, "%016llx ", (unsigned long long)hash);
+	return buf + printer;
+}
+
+DcPool::DcPool(DcFactory *factory, double idleTimeout, size_t maxIdle){
+	factory_ = factory;
+	clock_ = steady_seconds;
+	idleTimeout_ = idleTimeout;
+	maxIdle_ = maxIdle;
+	memset(&stats_, 0, sizeof(stats_));
+}
+
+DcPool::~DcPool(){
+	expire(true);
+}
+
+DeviceHandle DcPool::acquire(const std::string &printer, const char *devmode,
+		size_t devmodeLength, std::string *err){
+	std::string key = dc_pool_key(printer, devmode, devmodeLength);
+	std::unique_lock<std::mutex> lock(mutex_);
+	trim();
+	size_t i = idle_.size();
+	while( i > 0 ){
+		i -= 1;
+		if( idle_[i].key != key ){
+			continue;
+		}
+		DeviceHandle dc = idle_[i].dc;
+		idle_.erase(idle_.begin() + i);
+		if( !factory_->healthy(dc) ){
+			factory_->destroy(dc);
+			stats_.unhealthy += 1;
+			stats_.destroyed += 1;
+			continue;
+		}
+		leased_[dc] = key;
+		stats_.hits += 1;
+		return dc;
+	}
+	stats_.misses += 1;
+	// not holding the lock while the driver is slow
+	lock.unlock();
+	double start = clock_();
+	DeviceHandle dc = factory_->create(printer, devmode, devmodeLength, err);
+	double elapsed = clock_() - start;
+	lock.lock();
+	stats_.createSeconds += elapsed;
+	if( elapsed > stats_.maxCreateSeconds ){
+		stats_.maxCreateSeconds = elapsed;
+	}
+	if( !dc ){
+		stats_.createFailures += 1;
+		return 0;
+	}
+	leased_[dc] = key;
+	return dc;
+}
+
+bool DcPool::release(DeviceHandle dc, bool discard){
+	std::unique_lock<std::mutex> lock(mutex_);
+	std::map<DeviceHandle, std::string>::iterator found = leased_.find(dc);
+	if( found == leased_.end() ){
+		return false;
+	}
+	IdleDc entry;
+	entry.dc = dc;
+	entry.key = found->second;
+	entry.releasedAt = clock_();
+	leased_.erase(found);
+	if( discard || maxIdle_ == 0 || !factory_->reset(dc) ){
+		factory_->destroy(dc);
+		stats_.destroyed += 1;
+	} else {
+		idle_.push_back(entry);
+	}
+	trim();
+	return true;
+}
+
+// Destroys timed out DCs and the oldest ones beyond maxIdle_. Called with
+// mutex_ held.
+void DcPool::trim(){
+	double now = clock_();
+	size_t i, n = 0;
+	for(i=0;i<idle_.size();i++){
+		if( now - idle_[i].releasedAt > idleTimeout_ || idle_.size() - i > maxIdle_ ){
+			factory_->destroy(idle_[i].dc);
+			stats_.destroyed += 1;
+		} else {
+			idle_[n++] = idle_[i];
+		}
+	}
+	idle_.resize(n);
+}
+
+void DcPool::setIdleTimeout(double seconds){
+	std::unique_lock<std::mutex> lock(mutex_);
+	idleTimeout_ = seconds;
+	trim();
+}
+
+void DcPool::setMaxIdle(size_t maxIdle){
+	std::unique_lock<std::mutex> lock(mutex_);
+	maxIdle_ = maxIdle;
+	trim();
+}
+
+void DcPool::expire(bool all){
+	std::unique_lock<std::mutex> lock(mutex_);
+	if( all ){
+		size_t i;
+		for(i=0;i<idle_.size();i++){
+			factory_->destroy(idle_[i].dc);
+			stats_.destroyed += 1;
+		}
+		idle_.clear();
+	} else {
+		trim();
+	}
+}
+
+DcPoolStats DcPool::stats(){
+	std::unique_lock<std::mutex> lock(mutex_);
+	DcPoolStats stats = stats_;
+	stats.idle = (long)idle_.size();
+	stats.leased = (long)leased_.size();
+	return stats;
+}
@@ -0,0 +1,90 @@
+#ifndef DRAWER_DC_POOL_H
+#define DRAWER_DC_POOL_H
+
+#include "device.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Creates, resets and destroys the device contexts of a DcPool (CreateDCW,
+// RestoreDC and DeleteDC for GDI).
+class DcFactory {
+public:
+	virtual ~DcFactory(){}
+	virtual DeviceHandle create(const std::string &printer, const char *devmode,
+		size_t devmodeLength, std::string *err) = 0;
+	// Brings a DC that was used by a job back to its initial state.
+	virtual bool reset(DeviceHandle dc) = 0;
+	// Whether an idle DC can still be used (the printer may be gone).
+	virtual bool healthy(DeviceHandle dc) = 0;
+	virtual void destroy(DeviceHandle dc) = 0;
+};
+
+struct DcPoolStats {
+	long hits;
+	long misses;
+	long createFailures;
+	long destroyed;
+	long unhealthy;
+	long idle;
+	long leased;
+	// time spent creating DCs
+	double createSeconds;
+	double maxCreateSeconds;
+};
+
+// Keeps DCs of finished jobs warm so that the next job for the same printer
+// and DEVMODE does not wait for the driver to create one. DCs are keyed by
+// (printer name, hash of the DEVMODE bytes); acquire() reuses the most
+// recently released healthy DC of the key and release() resets it and puts
+// it back. Idle DCs are destroyed after idleTimeout seconds, and the oldest
+// ones when there are more than maxIdle.
+//
+// All methods may be called from any thread.
+class DcPool {
+public:
+	DcPool(DcFactory *factory, double idleTimeout, size_t maxIdle);
+	~DcPool();
+
+	DeviceHandle acquire(const std::string &printer, const char *devmode,
+		size_t devmodeLength, std::string *err);
+	// discard destroys the DC instead of keeping it (after a failed job).
+	// Returns false if dc did not come from acquire().
+	bool release(DeviceHandle dc, bool discard);
+
+	void setIdleTimeout(double seconds);
+	void setMaxIdle(size_t maxIdle);
+	// Destroys idle DCs that have timed out (all of them if all is true).
+	void expire(bool all);
+	DcPoolStats stats();
+
+	// For tests; defaults to a steady clock in seconds.
+	void setClock(double (*clock)()){ clock_ = clock; }
+
+private:
+	struct IdleDc {
+		DeviceHandle dc;
+		std::string key;
+		double releasedAt;
+	};
+
+	void trim();
+
+	DcFactory *factory_;
+	double (*clock_)();
+	std::mutex mutex_;
+	double idleTimeout_;
+	size_t maxIdle_;
+	// oldest first
+	std::vector<IdleDc> idle_;
+	std::map<DeviceHandle, std::string> leased_;
+	DcPoolStats stats_;
+};
+
+// Printer name and FNV-1a hash of the DEVMODE.
+std::string dc_pool_key(const std::string &printer, const char *devmode, size_t devmodeLength);
+
+#endif
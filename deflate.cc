@@ -0,0 +1,271 @@
+#include "deflate.h"
+#include <string.h>
+
+static const uint32_t WINDOW = 32768;
+static const uint32_t MIN_MATCH = 3;
+static const uint32_t MAX_MATCH = 258;
+static const int MAX_CHAIN = 8;
+// longer matches are not added to the hash chains, as in zlib's fast mode
+static const uint32_t MAX_INSERT = 32;
+// input collected before a block is compressed
+static const size_t BLOCK = 65536;
+
+static const uint16_t lengthBase[29] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t lengthExtra[29] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t distanceBase[30] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t distanceExtra[30] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+// Fixed Huffman codes (RFC 1951 3.2.6), bit reversed for LSB-first output,
+// and the length and distance symbols of each value.
+struct FixedCodes {
+	uint16_t literal[288];
+	uint8_t literalBits[288];
+	uint8_t distance[30];
+	uint8_t lengthSymbol[MAX_MATCH + 1];
+	uint8_t distanceSymbol[512];
+};
+
+static uint32_t reverse_bits(uint32_t code, int n){
+	uint32_t reversed = 0;
+	int k;
+	for(k=0;k<n;k++){
+		reversed |= ((code >> k) & 1) << (n - 1 - k);
+	}
+	return reversed;
+}
+
+static FixedCodes make_fixed_codes(){
+	FixedCodes c;
+	uint32_t i, s;
+	for(i=0;i<288;i++){
+		uint32_t code;
+		int n;
+		if( i < 144 ){
+			code = 0x30 + i;
+			n = 8;
+		} else if( i < 256 ){
+			code = 0x190 + i - 144;
+			n = 9;
+		} else if( i < 280 ){
+			code = i - 256;
+			n = 7;
+		} else {
+			code = 0xc0 + i - 280;
+			n = 8;
+		}
+		c.literal[i] = (uint16_t)reverse_bits(code, n);
+		c.literalBits[i] = (uint8_t)n;
+	}
+	for(i=0;i<30;i++){
+		c.distance[i] = (uint8_t)reverse_bits(i, 5);
+	}
+	for(s=0,i=MIN_MATCH;i<=MAX_MATCH;i++){
+		while( s + 1 < 29 && lengthBase[s + 1] <= i ){
+			s += 1;
+		}
+		c.lengthSymbol[i] = (uint8_t)s;
+	}
+	// distances 1-256 directly, larger ones by (distance - 1) >> 7
+	for(s=0,i=1;i<=256;i++){
+		while( s + 1 < 30 && distanceBase[s + 1] <= i ){
+			s += 1;
+		}
+		c.distanceSymbol[i - 1] = (uint8_t)s;
+	}
+	for(s=0,i=2;i<256;i++){
+		uint32_t d = (i << 7) + 1;
+		while( s + 1 < 30 && distanceBase[s + 1] <= d ){
+			s += 1;
+		}
+		c.distanceSymbol[256 + i] = (uint8_t)s;
+	}
+	return c;
+}
+
+static const FixedCodes &fixed_codes(){
+	static const FixedCodes codes = make_fixed_codes();
+	return codes;
+}
+
+// Length of the common prefix of p and q, at most n.
+static inline uint32_t match_length(const uint8_t *p, const uint8_t *q, uint32_t n){
+	uint32_t i = 0;
+	while( i + 8 <= n ){
+		uint64_t a, b;
+		memcpy(&a, p + i, 8);
+		memcpy(&b, q + i, 8);
+		if( a != b ){
+			break;
+		}
+		i += 8;
+	}
+	while( i < n && p[i] == q[i] ){
+		i += 1;
+	}
+	return i;
+}
+
+static inline uint32_t hash3(const uint8_t *p){
+	uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+	return (v * 2654435761u) >> 17;
+}
+
+Deflater::Deflater(std::vector<uint8_t> *out){
+	out_ = out;
+	bitBuffer_ = 0;
+	bitCount_ = 0;
+	base_ = 0;
+	done_ = 0;
+	head_.assign(WINDOW, 0);
+	prev_.assign(WINDOW, 0);
+	adlerA_ = 1;
+	adlerB_ = 0;
+	// 32 KB window, fastest level
+	out_->push_back(0x78);
+	out_->push_back(0x01);
+}
+
+void Deflater::putBits(uint32_t value, int n){
+	bitBuffer_ |= (uint64_t)value << bitCount_;
+	bitCount_ += n;
+	while( bitCount_ >= 8 ){
+		out_->push_back((uint8_t)bitBuffer_);
+		bitBuffer_ >>= 8;
+		bitCount_ -= 8;
+	}
+}
+
+void Deflater::putLiteral(uint32_t symbol){
+	const FixedCodes &c = fixed_codes();
+	putBits(c.literal[symbol], c.literalBits[symbol]);
+}
+
+void Deflater::putMatch(uint32_t length, uint32_t distance){
+	const FixedCodes &c = fixed_codes();
+	uint32_t s = c.lengthSymbol[length];
+	putLiteral(257 + s);
+	if( lengthExtra[s] ){
+		putBits(length - lengthBase[s], lengthExtra[s]);
+	}
+	s = distance <= 256 ? c.distanceSymbol[distance - 1] : c.distanceSymbol[256 + ((distance - 1) >> 7)];
+	putBits(c.distance[s], 5);
+	if( distanceExtra[s] ){
+		putBits(distance - distanceBase[s], distanceExtra[s]);
+	}
+}
+
+void Deflater::insert(uint64_t pos){
+	uint32_t h = hash3(&buffer_[(size_t)(pos - base_)]);
+	prev_[pos & (WINDOW - 1)] = head_[h];
+	head_[h] = pos + 1;
+}
+
+void Deflater::write(const uint8_t *data, size_t length){
+	uint32_t a = adlerA_, b = adlerB_;
+	size_t left = length;
+	const uint8_t *p = data;
+	while( left > 0 ){
+		// largest run that cannot overflow b
+		size_t n = left < 5552 ? left : 5552, i;
+		for(i=0;i<n;i++){
+			a += p[i];
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+		p += n;
+		left -= n;
+	}
+	adlerA_ = a;
+	adlerB_ = b;
+	buffer_.insert(buffer_.end(), data, data + length);
+	if( base_ + buffer_.size() - done_ >= BLOCK + MAX_MATCH ){
+		compress(false);
+	}
+}
+
+// One fixed Huffman block of the pending input; unless last, the final
+// MAX_MATCH bytes are left for the next block to match against.
+void Deflater::compress(bool last){
+	uint64_t limit = base_ + buffer_.size();
+	uint64_t end = last ? limit : limit - MAX_MATCH;
+	putBits(last ? 1 : 0, 1);
+	putBits(1, 2);
+	while( done_ < end ){
+		uint64_t pos = done_;
+		const uint8_t *p = &buffer_[(size_t)(pos - base_)];
+		uint32_t avail = limit - pos < MAX_MATCH ? (uint32_t)(limit - pos) : MAX_MATCH;
+		uint32_t best = 0, distance = 0;
+		if( avail >= MIN_MATCH ){
+			uint64_t candidate = head_[hash3(p)];
+			int chain = MAX_CHAIN;
+			while( candidate > 0 && chain-- > 0 ){
+				uint64_t c = candidate - 1;
+				if( c < base_ || pos - c > WINDOW ){
+					break;
+				}
+				uint32_t n = match_length(p, &buffer_[(size_t)(c - base_)], avail);
+				if( n > best ){
+					best = n;
+					distance = (uint32_t)(pos - c);
+					if( n == avail ){
+						break;
+					}
+				}
+				uint64_t next = prev_[c & (WINDOW - 1)];
+				// the link was overwritten by a newer position
+				if( next >= candidate ){
+					break;
+				}
+				candidate = next;
+			}
+			insert(pos);
+		}
+		if( best >= MIN_MATCH ){
+			putMatch(best, distance);
+			if( best <= MAX_INSERT ){
+				uint64_t i;
+				for(i=pos+1;i<pos+best&&i+MIN_MATCH<=limit;i++){
+					insert(i);
+				}
+			}
+			done_ += best;
+		} else {
+			putLiteral(*p);
+			done_ += 1;
+		}
+	}
+	putLiteral(256);
+	// keep a window of history
+	if( done_ - base_ > WINDOW ){
+		size_t drop = (size_t)(done_ - base_ - WINDOW);
+		buffer_.erase(buffer_.begin(), buffer_.begin() + drop);
+		base_ += drop;
+	}
+}
+
+void Deflater::finish(){
+	compress(true);
+	if( bitCount_ > 0 ){
+		putBits(0, 8 - bitCount_);
+	}
+	uint32_t adler = (adlerB_ << 16) | adlerA_;
+	out_->push_back((uint8_t)(adler >> 24));
+	out_->push_back((uint8_t)(adler >> 16));
+	out_->push_back((uint8_t)(adler >> 8));
+	out_->push_back((uint8_t)adler);
+}
+
+void deflate_zlib(const uint8_t *data, size_t length, std::vector<uint8_t> *out){
+	Deflater deflater(out);
+	deflater.write(data, length);
+	deflater.finish();
+}
@@ -0,0 +1,47 @@
+#ifndef DRAWER_DEFLATE_H
+#define DRAWER_DEFLATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Compresses a zlib stream (RFC 1950/1951) for the PNG encoder, fed a row
+// at a time. Only fixed Huffman blocks are written, with LZ77 matches found
+// through a hash chain: rendered pages are mostly long runs of one value,
+// which this compresses to a small fraction, at a fraction of the cost of
+// full zlib.
+class Deflater {
+public:
+	// Compressed bytes are appended to out.
+	explicit Deflater(std::vector<uint8_t> *out);
+
+	void write(const uint8_t *data, size_t length);
+	// Ends the stream with the Adler-32 checksum.
+	void finish();
+
+private:
+	void compress(bool last);
+	void putBits(uint32_t value, int n);
+	void putLiteral(uint32_t symbol);
+	void putMatch(uint32_t length, uint32_t distance);
+	void insert(uint64_t pos);
+
+	std::vector<uint8_t> *out_;
+	uint64_t bitBuffer_;
+	int bitCount_;
+	// input from stream offset base_; the first 32 KB are history
+	std::vector<uint8_t> buffer_;
+	uint64_t base_;
+	// stream offset of the next byte to compress
+	uint64_t done_;
+	// hash heads and chain links, as stream offsets + 1 (0: none)
+	std::vector<uint64_t> head_;
+	std::vector<uint64_t> prev_;
+	uint32_t adlerA_;
+	uint32_t adlerB_;
+};
+
+// Whole buffer in one call.
+void deflate_zlib(const uint8_t *data, size_t length, std::vector<uint8_t> *out);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef DRAWER_DEVICE_H
+#define DRAWER_DEVICE_H
+
+#include <stdint.h>
+
+// Handle of a font or pen created by a Device. 0 means failure.
+typedef uintptr_t DeviceHandle;
+
+// FW_BOLD
+const long FONT_WEIGHT_BOLD = 700;
+
+// Drawing target of PageExecutor. Coordinates are in device pixels.
+// GdiDevice forwards to a printer HDC; RecordingDevice keeps a log of the
+// calls so that the interpreter can be tested and measured without GDI.
+class Device {
+public:
+	virtual ~Device(){}
+
+	virtual int dpix() = 0;
+	virtual int dpiy() = 0;
+
+	virtual bool startDoc(const uint16_t *jobName, uint32_t length) = 0;
+	virtual bool endDoc() = 0;
+	virtual bool abortDoc() = 0;
+	virtual bool startPage() = 0;
+	virtual bool endPage() = 0;
+
+	virtual bool moveTo(long x, long y) = 0;
+	virtual bool lineTo(long x, long y) = 0;
+	// Draws polylines polylines with the current pen, counts[i] points each,
+	// from points (x, y pairs one after another), in one call (PolyPolyline).
+	// The current position is undefined afterwards. The default draws them
+	// with moveTo/lineTo.
+	virtual bool polyPolyline(const long *points, const uint32_t *counts, uint32_t polylines){
+		uint32_t i, j;
+		for(i=0;i<polylines;i++){
+			if( counts[i] > 0 && !moveTo(points[0], points[1]) ){
+				return false;
+			}
+			for(j=1;j<counts[i];j++){
+				if( !lineTo(points[j * 2], points[j * 2 + 1]) ){
+					return false;
+				}
+			}
+			points += counts[i] * 2;
+		}
+		return true;
+	}
+	// Fills [left, right) x [top, bottom) with a color, without an outline
+	// (FillRect). The default fails.
+	virtual bool fillRect(long left, long top, long right, long bottom, int r, int g, int b){
+		return false;
+	}
+	virtual bool textOut(long x, long y, const uint16_t *text, uint32_t length) = 0;
+	// Draws text starting at (x, y) with advances[i] pixels from character i
+	// to the next one (ExtTextOutW with lpDx).
+	virtual bool textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances) = 0;
+	virtual bool setTextColor(int r, int g, int b) = 0;
+	virtual bool setBkTransparent() = 0;
+
+	virtual DeviceHandle createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic) = 0;
+	virtual DeviceHandle createPen(long width, int r, int g, int b) = 0;
+	virtual bool selectObject(DeviceHandle handle) = 0;
+	virtual bool deleteObject(DeviceHandle handle) = 0;
+};
+
+#endif
@@ -0,0 +1,318 @@
+#include "display-list.h"
+#include "page-executor.h"
+#include <math.h>
+#include <string.h>
+
+static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME = 1099511628211ULL;
+
+// FNV-1a over 64 bit words rather than bytes: pages hold thousands of
+// coordinates and the byte loop cost more than drawing the page.
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t length){
+	const uint8_t *p = (const uint8_t *)data;
+	uint64_t word;
+	size_t i;
+	for(i=0;i+8<=length;i+=8){
+		memcpy(&word, p + i, 8);
+		h = (h ^ word) * FNV_PRIME;
+		h ^= h >> 29;
+	}
+	for(;i<length;i++){
+		h = (h ^ p[i]) * FNV_PRIME;
+	}
+	return h;
+}
+
+static uint64_t hash_int(uint64_t h, int64_t value){
+	return hash_bytes(h, &value, sizeof(value));
+}
+
+static uint64_t hash_double(uint64_t h, double value){
+	return hash_bytes(h, &value, sizeof(value));
+}
+
+static uint64_t hash_text(uint64_t h, const Page &page, const TextRef &ref){
+	h = hash_int(h, ref.length);
+	return hash_bytes(h, page.textOf(ref), ref.length * sizeof(uint16_t));
+}
+
+static uint64_t hash_coords(uint64_t h, const Page &page, const CoordRef &ref){
+	uint32_t i, n = ref.count == 0 ? 1 : ref.count;
+	h = hash_int(h, ref.count);
+	for(i=0;i<n;i++){
+		h = hash_double(h, page.coordAt(ref, i));
+	}
+	return h;
+}
+
+uint64_t page_hash(const Page &page){
+	uint64_t h = FNV_OFFSET;
+	size_t i;
+	h = hash_int(h, (int64_t)page.ops.size());
+	for(i=0;i<page.ops.size();i++){
+		const PageOp &op = page.ops[i];
+		h = hash_int(h, op.code);
+		h = hash_text(h, page, op.name);
+		h = hash_text(h, page, op.face);
+		h = hash_text(h, page, op.text);
+		h = hash_coords(h, page, op.xs);
+		h = hash_coords(h, page, op.ys);
+		h = hash_coords(h, page, op.counts);
+		h = hash_double(h, op.size);
+		h = hash_double(h, op.width);
+		h = hash_double(h, op.height);
+		h = hash_int(h, op.weight);
+		h = hash_int(h, op.italic);
+		h = hash_int(h, op.r);
+		h = hash_int(h, op.g);
+		h = hash_int(h, op.b);
+	}
+	return h;
+}
+
+static bool texts_equal(const Page &a, const TextRef &ra, const Page &b, const TextRef &rb){
+	return ra.length == rb.length &&
+		memcmp(a.textOf(ra), b.textOf(rb), ra.length * sizeof(uint16_t)) == 0;
+}
+
+static bool coords_equal(const Page &a, const CoordRef &ra, const Page &b, const CoordRef &rb){
+	uint32_t i, n = ra.count == 0 ? 1 : ra.count;
+	if( ra.count != rb.count ){
+		return false;
+	}
+	for(i=0;i<n;i++){
+		if( a.coordAt(ra, i) != b.coordAt(rb, i) ){
+			return false;
+		}
+	}
+	return true;
+}
+
+bool pages_equal(const Page &a, const Page &b){
+	size_t i;
+	if( a.ops.size() != b.ops.size() ){
+		return false;
+	}
+	for(i=0;i<a.ops.size();i++){
+		const PageOp &x = a.ops[i], &y = b.ops[i];
+		if( x.code != y.code || x.size != y.size || x.width != y.width || x.height != y.height ||
+				x.weight != y.weight || x.italic != y.italic || x.r != y.r || x.g != y.g || x.b != y.b ){
+			return false;
+		}
+		if( !texts_equal(a, x.name, b, y.name) || !texts_equal(a, x.face, b, y.face) ||
+				!texts_equal(a, x.text, b, y.text) ){
+			return false;
+		}
+		if( !coords_equal(a, x.xs, b, y.xs) || !coords_equal(a, x.ys, b, y.ys) ||
+				!coords_equal(a, x.counts, b, y.counts) ){
+			return false;
+		}
+	}
+	return true;
+}
+
+static DisplayItem display_item(int kind){
+	DisplayItem item;
+	memset(&item, 0, sizeof(item));
+	item.kind = kind;
+	return item;
+}
+
+DisplayList::DisplayList(){
+	mergePaths_ = true;
+	opCount_ = 0;
+	skippedOps_ = 0;
+}
+
+void DisplayList::clear(){
+	items_.clear();
+	text_.clear();
+	advances_.clear();
+	points_.clear();
+	counts_.clear();
+	names_.clear();
+	path_.reset();
+	opCount_ = 0;
+	skippedOps_ = 0;
+}
+
+uint32_t DisplayList::addName(const Page &page, const TextRef &ref){
+	names_.push_back(text_key(page.textOf(ref), ref.length));
+	return (uint32_t)(names_.size() - 1);
+}
+
+uint32_t DisplayList::addText(const uint16_t *text, uint32_t length){
+	uint32_t offset = (uint32_t)text_.size();
+	text_.insert(text_.end(), text, text + length);
+	return offset;
+}
+
+void DisplayList::addPoint(int kind, long x, long y){
+	DisplayItem item = display_item(kind);
+	item.x = x;
+	item.y = y;
+	items_.push_back(item);
+}
+
+// The polyPolyline PageExecutor::flushPath draws at the same place.
+void DisplayList::flushPath(){
+	if( path_.empty() ){
+		return;
+	}
+	DisplayItem item = display_item(DISPLAY_POLY_POLYLINE);
+	item.points = (uint32_t)points_.size();
+	item.counts = (uint32_t)counts_.size();
+	item.length = (uint32_t)path_.counts().size();
+	points_.insert(points_.end(), path_.points().begin(), path_.points().end());
+	counts_.insert(counts_.end(), path_.counts().begin(), path_.counts().end());
+	items_.push_back(item);
+	path_.clear();
+}
+
+bool DisplayList::record(const Page &page, int dpix, int dpiy, double dx, double dy, std::string *err){
+	size_t i, n = page.ops.size(), xstride, ystride;
+	uint32_t j;
+	TransformStack transforms;
+	clear();
+	long x, y;
+	for(i=0;i<n;i++){
+		const PageOp &op = page.ops[i];
+		opCount_ += 1;
+		if( !keeps_path(op.code) ){
+			flushPath();
+		}
+		switch(op.code){
+			case OP_MOVE_TO: case OP_LINE_TO: {
+				double mmX = page.coordAt(op.xs, 0);
+				double mmY = page.coordAt(op.ys, 0);
+				if( transform_points(offset_transform(transforms.current(), dx, dy), dpix, dpiy,
+						&mmX, 0, &mmY, 0, 1, &x, &y) == 0 ){
+					*err = std::string("invalid number to ") + op_code_name(op.code);
+					return false;
+				}
+				if( op.code == OP_MOVE_TO ){
+					if( mergePaths_ ){
+						path_.moveTo(x, y);
+					} else {
+						addPoint(DISPLAY_MOVE_TO, x, y);
+					}
+				} else if( !mergePaths_ || !path_.lineTo(x, y) ){
+					flushPath();
+					addPoint(DISPLAY_LINE_TO, x, y);
+					path_.setCurrent(x, y);
+				}
+				break;
+			}
+			case OP_POLYLINE: case OP_POLY_POLYLINE: case OP_RECT: case OP_GRID: {
+				if( !add_path_shapes(page, op, offset_transform(transforms.current(), dx, dy), dpix, dpiy,
+						&pathScratch_, &path_, err) ){
+					return false;
+				}
+				if( !mergePaths_ ){
+					flushPath();
+				}
+				break;
+			}
+			case OP_FILL_RECT: {
+				DisplayItem item = display_item(DISPLAY_FILL_RECT);
+				if( !fill_rect_pixels(page, op, offset_transform(transforms.current(), dx, dy), dpix, dpiy,
+						&item.x, &item.y, &item.right, &item.bottom, err) ){
+					return false;
+				}
+				item.r = op.r;
+				item.g = op.g;
+				item.b = op.b;
+				items_.push_back(item);
+				break;
+			}
+			case OP_CREATE_FONT: {
+				DisplayItem item = display_item(DISPLAY_CREATE_FONT);
+				item.size = mm_to_pixel(dpiy, transform_length(transforms.current(), op.size));
+				item.weight = op.weight ? FONT_WEIGHT_BOLD : 0;
+				item.italic = op.italic ? 1 : 0;
+				item.name = addName(page, op.name);
+				item.text = addText(page.textOf(op.face), op.face.length);
+				item.length = op.face.length;
+				items_.push_back(item);
+				break;
+			}
+			case OP_CREATE_PEN: {
+				DisplayItem item = display_item(DISPLAY_CREATE_PEN);
+				item.size = mm_to_pixel(dpiy, transform_length(transforms.current(), op.size));
+				if( item.size < 0 ){
+					item.size = 1;
+				}
+				item.r = op.r;
+				item.g = op.g;
+				item.b = op.b;
+				item.name = addName(page, op.name);
+				items_.push_back(item);
+				break;
+			}
+			case OP_SET_FONT: case OP_SET_PEN: {
+				DisplayItem item = display_item(op.code == OP_SET_FONT ? DISPLAY_SET_FONT : DISPLAY_SET_PEN);
+				item.name = addName(page, op.name);
+				items_.push_back(item);
+				break;
+			}
+			case OP_SET_TEXT_COLOR: {
+				DisplayItem item = display_item(DISPLAY_SET_TEXT_COLOR);
+				item.r = op.r;
+				item.g = op.g;
+				item.b = op.b;
+				items_.push_back(item);
+				break;
+			}
+			case OP_DRAW_CHARS: {
+				uint32_t count = op.text.length;
+				if( (op.xs.count != 0 && op.xs.count < count) || (op.ys.count != 0 && op.ys.count < count) ){
+					*err = "too few coordinates to drawChars";
+					return false;
+				}
+				if( count == 0 ){
+					break;
+				}
+				xs_.resize(count);
+				ys_.resize(count);
+				const double *mmXs = page.coordArray(op.xs, count, &floatXs_, &xstride);
+				const double *mmYs = page.coordArray(op.ys, count, &floatYs_, &ystride);
+				j = (uint32_t)transform_points(offset_transform(transforms.current(), dx, dy), dpix, dpiy,
+					mmXs, xstride, mmYs, ystride, count, &xs_[0], &ys_[0]);
+				if( j < count ){
+					*err = isnan(page.coordAt(op.xs, j)) ? "invalid x to drawChars" : "invalid y to drawChars";
+					return false;
+				}
+				uint32_t text = addText(page.textOf(op.text), count);
+				uint32_t advances = (uint32_t)advances_.size();
+				advances_.resize(advances + count);
+				build_glyph_runs(&xs_[0], &ys_[0], count, &advances_[advances], &runs_);
+				for(j=0;j<runs_.size();j++){
+					const GlyphRun &run = runs_[j];
+					DisplayItem item = display_item(DISPLAY_TEXT_RUN);
+					item.x = run.x;
+					item.y = run.y;
+					item.text = text + run.start;
+					item.length = run.count;
+					item.advances = advances + run.start;
+					items_.push_back(item);
+				}
+				break;
+			}
+			case OP_PUSH: case OP_POP: case OP_TRANSLATE: case OP_SCALE: case OP_ROTATE: {
+				if( !apply_transform_op(page, op, &transforms, err) ){
+					return false;
+				}
+				break;
+			}
+			default: {
+				skippedOps_ += 1;
+				break;
+			}
+		}
+	}
+	flushPath();
+	if( path_.takePendingMove(&x, &y) ){
+		addPoint(DISPLAY_MOVE_TO, x, y);
+	}
+	return true;
+}
@@ -0,0 +1,95 @@
+#ifndef DRAWER_DISPLAY_LIST_H
+#define DRAWER_DISPLAY_LIST_H
+
+#include "page.h"
+#include "glyph-run.h"
+#include "path-builder.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Word-wise FNV-1a hash of everything that decides what a page draws: op codes,
+// names, texts, coordinates (the mm values the executor reads) and sizes.
+uint64_t page_hash(const Page &page);
+// Compares what page_hash hashes, to tell real duplicates from collisions.
+bool pages_equal(const Page &a, const Page &b);
+
+enum DisplayItemKind {
+	DISPLAY_MOVE_TO,
+	DISPLAY_LINE_TO,
+	DISPLAY_CREATE_FONT,
+	DISPLAY_SET_FONT,
+	DISPLAY_SET_TEXT_COLOR,
+	DISPLAY_CREATE_PEN,
+	DISPLAY_SET_PEN,
+	DISPLAY_TEXT_RUN,
+	DISPLAY_POLY_POLYLINE,
+	DISPLAY_FILL_RECT
+};
+
+struct DisplayItem {
+	int kind;
+	long x, y;            // MOVE_TO, LINE_TO, TEXT_RUN (device pixels); FILL_RECT: left, top
+	long right, bottom;   // FILL_RECT
+	long size;            // CREATE_FONT: height, CREATE_PEN: width (pixels)
+	long weight, italic;  // CREATE_FONT
+	int r, g, b;          // SET_TEXT_COLOR, CREATE_PEN, FILL_RECT
+	uint32_t name;        // CREATE_*, SET_FONT, SET_PEN: index in names()
+	uint32_t text;        // TEXT_RUN: characters, CREATE_FONT: face (text pool)
+	uint32_t length;      // TEXT_RUN, CREATE_FONT; POLY_POLYLINE: polylines
+	uint32_t advances;    // TEXT_RUN: index in the advance pool
+	uint32_t points;      // POLY_POLYLINE: index in the point pool (x, y pairs)
+	uint32_t counts;      // POLY_POLYLINE: index in the count pool
+};
+
+// A page converted for one device resolution and offset: coordinates in
+// pixels with the transform ops applied, lines merged into polylines, texts
+// split into runs with their advances, font and pen names as lookup keys.
+// PageExecutor::runList draws it with exactly the calls that runOps makes
+// for the page (with the same setMergePaths), so a page printed several
+// times in a job is converted once.
+class DisplayList {
+public:
+	DisplayList();
+
+	void setMergePaths(bool merge){ mergePaths_ = merge; }
+
+	// Converts page; false with the message runOps would fail with if the
+	// page is invalid.
+	bool record(const Page &page, int dpix, int dpiy, double dx, double dy, std::string *err);
+	void clear();
+
+	const std::vector<DisplayItem> &items() const { return items_; }
+	const uint16_t *textAt(uint32_t offset) const { return text_.empty() ? 0 : &text_[offset]; }
+	const int *advancesAt(uint32_t offset) const { return advances_.empty() ? 0 : &advances_[offset]; }
+	const long *pointsAt(uint32_t offset) const { return points_.empty() ? 0 : &points_[offset]; }
+	const uint32_t *countsAt(uint32_t offset) const { return counts_.empty() ? 0 : &counts_[offset]; }
+	// Names in the form of text_key.
+	const std::string &name(uint32_t index) const { return names_[index]; }
+	// Ops of the page, and those of them that are not drawn.
+	long opCount() const { return opCount_; }
+	long skippedOps() const { return skippedOps_; }
+
+private:
+	uint32_t addName(const Page &page, const TextRef &ref);
+	uint32_t addText(const uint16_t *text, uint32_t length);
+	void addPoint(int kind, long x, long y);
+	void flushPath();
+
+	std::vector<DisplayItem> items_;
+	std::vector<uint16_t> text_;
+	std::vector<int> advances_;
+	std::vector<long> points_;
+	std::vector<uint32_t> counts_;
+	std::vector<std::string> names_;
+	std::vector<long> xs_, ys_;
+	std::vector<double> floatXs_, floatYs_;
+	std::vector<GlyphRun> runs_;
+	PathBuilder path_;
+	PointScratch pathScratch_;
+	bool mergePaths_;
+	long opCount_;
+	long skippedOps_;
+};
+
+#endif
@@ -6,6 +6,28 @@
 #include <fstream>
 #include <string>
 #include <locale.h>
+#include <math.h>
+#include <vector>
+#include <thread>
+#include "page.h"
+#include "page-executor.h"
+#include "page-format.h"
+#include "gdi-device.h"
+#include "print-job.h"
+#include "spooler.h"
+#include "glyph-run.h"
+#include "advance-table.h"
+#include "text-layout.h"
+#include "bmp-image.h"
+#include "mono-image.h"
+#include "png-image.h"
+#include "resample.h"
+#include "raster-device.h"
+#include "pdf-device.h"
+#include "escpos-device.h"
+#include "job-stats.h"
+#include "page-template.h"
+#include <map>
 using namespace v8;
 
 static WCHAR *windowClassName = L"DRAWERWINDOW";
@@ -44,6 +66,71 @@ static void parse_devnames(DEVNAMES *devnames, WCHAR **driver, WCHAR **device, W
 	*output = (WCHAR *)(((WCHAR *)devnames) + devnames->wOutputOffset);
 }
 
+// Job stats (setStatsEnabled, getStats, onJobComplete, statsTrace). A job
+// printed on a DC from JS is followed from acquireDc or createDcWithoutDialog
+// (or beginPrint) until the DC is released; while stats are disabled
+// dcStats stays empty and the bindings only test that.
+static JobStatsRegistry jobStats(64);
+static std::map<HDC, JobStats *> dcStats;
+static int nextJobId = 1;
+
+static void job_stats_complete(const JobStats &stats);
+
+static JobStats *dc_stats(HDC hdc){
+	if( dcStats.empty() ){
+		return NULL;
+	}
+	std::map<HDC, JobStats *>::iterator iter = dcStats.find(hdc);
+	return iter != dcStats.end() ? iter->second : NULL;
+}
+
+// Starts following the job on hdc if stats are enabled; opened is when
+// creating the DC started (0: not timed).
+static JobStats *dc_stats_begin(HDC hdc, const std::string &printer, int64_t opened){
+	if( !jobStats.enabled() ){
+		return NULL;
+	}
+	JobStats *stats = dc_stats(hdc);
+	if( stats ){
+		return stats;
+	}
+	stats = new JobStats();
+	stats->printer = printer;
+	stats->jobId = nextJobId++;
+	stats->begin(opened > 0 ? opened : stats_now());
+	if( opened > 0 ){
+		stats->leave(PHASE_OPEN, opened);
+	}
+	dcStats[hdc] = stats;
+	return stats;
+}
+
+// Ends the job on hdc; started is when releasing the DC started.
+static void dc_stats_end(HDC hdc, JobStats *stats, int64_t started, const char *status){
+	stats->leave(PHASE_CLOSE, started);
+	stats->finish(status);
+	dcStats.erase(hdc);
+	job_stats_complete(*stats);
+	delete stats;
+}
+
+// Caps of hdc from gdi_caps_cache(), probed once per printer and DEVMODE
+// rather than with GetDeviceCaps on every call.
+static PrinterCaps dc_caps(HDC hdc){
+	PrinterCaps caps = PrinterCaps();
+	std::string err;
+	gdi_caps_cache()->getForDc((DeviceHandle)hdc, &caps, &err);
+	return caps;
+}
+
+static void dc_stats_call(HDC hdc, bool text){
+	JobStats *stats = dc_stats(hdc);
+	if( stats ){
+		stats->gdiCalls += 1;
+		stats->textRuns += text;
+	}
+}
+
 void createWindow(const Nan::FunctionCallbackInfo<Value>& args){
 	// createWidnow()
 	HWND hwnd = create_window();
@@ -97,6 +184,7 @@ void releaseDc(const Nan::FunctionCallbackInfo<Value>& args){
 	}
 	HWND hwnd = (HWND)args[0]->Int32Value();
 	HDC hdc = (HDC)args[1]->Int32Value();
+	gdi_caps_cache()->unbindDc((DeviceHandle)hdc);
 	BOOL ok = ReleaseDC(hwnd, hdc);
 	args.GetReturnValue().Set(Nan::New(ok));
 }
@@ -129,6 +217,253 @@ void measureText(const Nan::FunctionCallbackInfo<Value>& args){
 	args.GetReturnValue().Set(obj);
 }
 
+// Widths of the font that is selected into hdc.
+class GdiAdvanceSource : public AdvanceSource {
+public:
+	explicit GdiAdvanceSource(HDC hdc){ hdc_ = hdc; }
+
+	bool charWidths(uint16_t first, uint16_t last, int *widths){
+		return GetCharWidth32W(hdc_, first, last, (LPINT)widths) != FALSE;
+	}
+
+	bool textWidth(const uint16_t *text, uint32_t length, long *width){
+		SIZE mes;
+		if( !GetTextExtentPoint32W(hdc_, (LPCWSTR)text, length, &mes) ){
+			return false;
+		}
+		*width = mes.cx;
+		return true;
+	}
+
+private:
+	HDC hdc_;
+};
+
+static AdvanceTableCache advanceTables(32);
+static double js_option_number(Local<Value> opts, const char *key, double defaultValue);
+
+// The advance table of font on hdc; NULL if font is not a font.
+static AdvanceTable *advance_table_of(HDC hdc, HFONT font){
+	LOGFONTW logfont;
+	if( GetObjectW(font, sizeof(logfont), &logfont) != sizeof(logfont) ){
+		return NULL;
+	}
+	// widths depend on the font and the resolution of the device
+	char buf[64];
+	PrinterCaps caps = dc_caps(hdc);
+	sprintf(buf, " %d %d %d", (int)logfont.lfCharSet, caps.dpix, caps.dpiy);
+	std::string key = font_cache_key((const uint16_t *)logfont.lfFaceName,
+		(uint32_t)wcslen(logfont.lfFaceName), logfont.lfHeight, logfont.lfWeight,
+		logfont.lfItalic) + buf;
+	return advanceTables.table(key);
+}
+
+void measureTextBatch(const Nan::FunctionCallbackInfo<Value>& args){
+	// measureTextBatch(hdc, font, strings) ==> Int32Array of widths
+	if( args.Length() < 3 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsInt32() || !args[1]->IsInt32() || !args[2]->IsArray() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	HDC hdc = (HDC)args[0]->Int32Value();
+	HFONT font = (HFONT)args[1]->Int32Value();
+	Local<Array> strings = Local<Array>::Cast(args[2]);
+	uint32_t i, n = strings->Length();
+	AdvanceTable *table = advance_table_of(hdc, font);
+	if( !table ){
+		Nan::ThrowTypeError("invalid font");
+		return;
+	}
+	std::vector<uint16_t> text;
+	std::vector<uint32_t> lengths(n);
+	for(i=0;i<n;i++){
+		String::Value value(strings->Get(i));
+		lengths[i] = value.length();
+		text.insert(text.end(), *value, *value + value.length());
+	}
+	Local<ArrayBuffer> buffer = ArrayBuffer::New(Isolate::GetCurrent(), n * sizeof(int32_t));
+	Local<Int32Array> widths = Int32Array::New(buffer, 0, n);
+	if( n == 0 ){
+		args.GetReturnValue().Set(widths);
+		return;
+	}
+	HGDIOBJ prev = SelectObject(hdc, font);
+	if( prev == NULL || prev == HGDI_ERROR ){
+		Nan::ThrowTypeError("SelectObject failed");
+		return;
+	}
+	GdiAdvanceSource source(hdc);
+	bool ok = table->measureBatch(text.empty() ? NULL : &text[0],
+		&lengths[0], n, &source, (int32_t *)buffer->GetContents().Data());
+	SelectObject(hdc, prev);
+	if( !ok ){
+		Nan::ThrowTypeError("GetCharWidth32W failed");
+		return;
+	}
+	args.GetReturnValue().Set(widths);
+}
+
+// Widths of font, which is selected into hdc only when the advance table
+// has to load some, and put back afterwards.
+class FontAdvanceSource : public AdvanceSource {
+public:
+	FontAdvanceSource(HDC hdc, HFONT font) : gdi_(hdc) { hdc_ = hdc; font_ = font; prev_ = NULL; }
+	~FontAdvanceSource(){
+		if( prev_ ){
+			SelectObject(hdc_, prev_);
+		}
+	}
+
+	bool charWidths(uint16_t first, uint16_t last, int *widths){
+		return select() && gdi_.charWidths(first, last, widths);
+	}
+
+	bool textWidth(const uint16_t *text, uint32_t length, long *width){
+		return select() && gdi_.textWidth(text, length, width);
+	}
+
+private:
+	bool select(){
+		if( !prev_ ){
+			HGDIOBJ prev = SelectObject(hdc_, font_);
+			if( prev == NULL || prev == HGDI_ERROR ){
+				return false;
+			}
+			prev_ = prev;
+		}
+		return true;
+	}
+
+	GdiAdvanceSource gdi_;
+	HDC hdc_;
+	HFONT font_;
+	HGDIOBJ prev_;
+};
+
+static bool js_align(Local<Value> value, int *align, std::string *err){
+	if( value->IsUndefined() ){
+		return true;
+	}
+	std::string name = *String::Utf8Value(value);
+	if( name == "left" ){
+		*align = ALIGN_LEFT;
+	} else if( name == "center" ){
+		*align = ALIGN_CENTER;
+	} else if( name == "right" ){
+		*align = ALIGN_RIGHT;
+	} else {
+		*err = "unknown align: " + name;
+		return false;
+	}
+	return true;
+}
+
+// Reads { align, maxLines, ellipsis, tabStops: [x | { x, align }], tabWidth }
+// with lengths in mm.
+static bool js_layout_options(Local<Value> opts, int dpi, TextLayout *layout, std::string *err){
+	if( !opts->IsObject() ){
+		return true;
+	}
+	Local<Object> obj = opts->ToObject();
+	int align = ALIGN_LEFT;
+	if( !js_align(obj->Get(Nan::New("align").ToLocalChecked()), &align, err) ){
+		return false;
+	}
+	layout->setAlign(align);
+	layout->setMaxLines((int)js_option_number(opts, "maxLines", 0));
+	double tabWidth = js_option_number(opts, "tabWidth", 0);
+	layout->setTabInterval(tabWidth > 0 ? mm_to_pixel(dpi, tabWidth) : 0);
+	Local<Value> ellipsis = obj->Get(Nan::New("ellipsis").ToLocalChecked());
+	if( !ellipsis->IsUndefined() ){
+		String::Value text(ellipsis);
+		layout->setEllipsis((const uint16_t *)*text, (uint32_t)text.length());
+	}
+	Local<Value> stopsValue = obj->Get(Nan::New("tabStops").ToLocalChecked());
+	if( stopsValue->IsArray() ){
+		Local<Array> stopsArray = Local<Array>::Cast(stopsValue);
+		std::vector<TabStop> stops(stopsArray->Length());
+		uint32_t i;
+		for(i=0;i<stops.size();i++){
+			Local<Value> stop = stopsArray->Get(i);
+			stops[i].align = ALIGN_LEFT;
+			if( stop->IsObject() ){
+				stops[i].x = mm_to_pixel(dpi, js_option_number(stop, "x", 0));
+				if( !js_align(stop->ToObject()->Get(Nan::New("align").ToLocalChecked()), &stops[i].align, err) ){
+					return false;
+				}
+			} else {
+				stops[i].x = mm_to_pixel(dpi, stop->NumberValue());
+			}
+		}
+		layout->setTabStops(stops.empty() ? NULL : &stops[0], stops.size());
+	}
+	return true;
+}
+
+void layoutText(const Nan::FunctionCallbackInfo<Value>& args){
+	// layoutText(hdc, font, string, width, opts?) ==> [{ text, xs, y, width }]
+	if( args.Length() < 4 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsInt32() || !args[1]->IsInt32() || !args[2]->IsString() || !args[3]->IsNumber() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	HDC hdc = (HDC)args[0]->Int32Value();
+	HFONT font = (HFONT)args[1]->Int32Value();
+	String::Value text(args[2]);
+	double width = args[3]->NumberValue();
+	Local<Value> opts = args.Length() >= 5 ? args[4] : Local<Value>(Nan::Undefined());
+	AdvanceTable *table = advance_table_of(hdc, font);
+	if( !table ){
+		Nan::ThrowTypeError("invalid font");
+		return;
+	}
+	int dpi = dc_caps(hdc).dpix;
+	TextLayout layout;
+	std::string err;
+	layout.setWidth(width > 0 ? mm_to_pixel(dpi, width) : 0);
+	if( !js_layout_options(opts, dpi, &layout, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	bool ok;
+	{
+		FontAdvanceSource source(hdc, font);
+		ok = layout.layout((const uint16_t *)*text, (uint32_t)text.length(), table, &source);
+	}
+	if( !ok ){
+		Nan::ThrowTypeError("GetCharWidth32W failed");
+		return;
+	}
+	// glyphs land on the pixels of the layout when the line is drawn at x
+	long x0 = mm_to_pixel(dpi, js_option_number(opts, "x", 0));
+	double y = js_option_number(opts, "y", 0), lineHeight = js_option_number(opts, "lineHeight", 0);
+	const std::vector<LayoutLine> &lines = layout.lines();
+	Local<Array> result = Nan::New<Array>((int)lines.size());
+	size_t i;
+	uint32_t k;
+	for(i=0;i<lines.size();i++){
+		const LayoutLine &line = lines[i];
+		Local<Object> obj = Nan::New<Object>();
+		Local<Array> xs = Nan::New<Array>((int)line.count);
+		for(k=0;k<line.count;k++){
+			xs->Set(k, Nan::New(pixel_to_mm(dpi, x0 + layout.xs()[line.start + k])));
+		}
+		obj->Set(Nan::New("text").ToLocalChecked(), line.count > 0 ?
+			Nan::New(&layout.chars()[line.start], (int)line.count).ToLocalChecked() : Nan::EmptyString());
+		obj->Set(Nan::New("xs").ToLocalChecked(), xs);
+		obj->Set(Nan::New("y").ToLocalChecked(), Nan::New(y + lineHeight * i));
+		obj->Set(Nan::New("width").ToLocalChecked(), Nan::New(line.width * 25.4 / dpi));
+		result->Set((uint32_t)i, obj);
+	}
+	args.GetReturnValue().Set(result);
+}
+
 void createFont(const Nan::FunctionCallbackInfo<Value>& args){
 	// createFont(fontname, size, weight?, italic?) ==> HANDLE
 	if( args.Length() < 2 ){
@@ -155,21 +490,13 @@ void createFont(const Nan::FunctionCallbackInfo<Value>& args){
 	long size = args[1]->Int32Value();
 	long weight = args.Length() >= 3 ? args[2]->Int32Value() : 0;
 	long italic = args.Length() >= 4 ? args[3]->Int32Value() : 0;
-	LOGFONTW logfont;
-	ZeroMemory(&logfont, sizeof(logfont));
-	logfont.lfHeight = size;
-	logfont.lfWeight = weight;
-	logfont.lfItalic = static_cast<BYTE>(italic);
-	logfont.lfCharSet = DEFAULT_CHARSET;
-	logfont.lfOutPrecision = OUT_DEFAULT_PRECIS;
-	logfont.lfClipPrecision = CLIP_DEFAULT_PRECIS;
-	logfont.lfQuality = DEFAULT_QUALITY;
-	logfont.lfPitchAndFamily = DEFAULT_PITCH;
-	if( wcscpy_s(logfont.lfFaceName, LF_FACESIZE, (const wchar_t *)*fontName) != 0 ){
+	if( fontName.length() >= LF_FACESIZE ){
 		Nan::ThrowTypeError("Too long font name");
 		return;
 	}
-	HFONT font = CreateFontIndirectW(&logfont);
+	// shared with other jobs; deleteObject releases it
+	HFONT font = (HFONT)gdi_object_cache()->acquireFont((const uint16_t *)*fontName,
+		fontName.length(), size, weight, italic);
 	args.GetReturnValue().Set(Nan::New((int)(UINT_PTR)font));
 }
 
@@ -184,10 +511,45 @@ void deleteObject(const Nan::FunctionCallbackInfo<Value>& args){
 		return;
 	}
 	HANDLE object = (HANDLE)args[0]->Int32Value();
+	if( gdi_object_cache()->release((DeviceHandle)object) ){
+		args.GetReturnValue().Set(TRUE);
+		return;
+	}
 	BOOL ok = DeleteObject(object);
 	args.GetReturnValue().Set(ok);
 }
 
+void objectCacheStats(const Nan::FunctionCallbackInfo<Value>& args){
+	// objectCacheStats() ==> { hits, misses, evictions, size, inUse, capacity }
+	ObjectCacheStats stats = gdi_object_cache()->stats();
+	Local<Object> obj = Nan::New<Object>();
+	obj->Set(Nan::New("hits").ToLocalChecked(), Nan::New((double)stats.hits));
+	obj->Set(Nan::New("misses").ToLocalChecked(), Nan::New((double)stats.misses));
+	obj->Set(Nan::New("evictions").ToLocalChecked(), Nan::New((double)stats.evictions));
+	obj->Set(Nan::New("size").ToLocalChecked(), Nan::New((double)stats.size));
+	obj->Set(Nan::New("inUse").ToLocalChecked(), Nan::New((double)stats.inUse));
+	obj->Set(Nan::New("capacity").ToLocalChecked(), Nan::New((double)stats.capacity));
+	args.GetReturnValue().Set(obj);
+}
+
+void setObjectCacheCapacity(const Nan::FunctionCallbackInfo<Value>& args){
+	// setObjectCacheCapacity(n)
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsInt32() || args[0]->Int32Value() < 0 ){
+		Nan::ThrowTypeError("wrong argument");
+		return;
+	}
+	gdi_object_cache()->setCapacity((size_t)args[0]->Int32Value());
+}
+
+void purgeObjectCache(const Nan::FunctionCallbackInfo<Value>& args){
+	// purgeObjectCache() ==> deletes cached fonts and pens that are not in use
+	gdi_object_cache()->purge();
+}
+
 void getDpiOfHdc(const Nan::FunctionCallbackInfo<Value>& args){
 	// getDpiOfHdc(hdc)
 	if( args.Length() < 1 ){
@@ -199,11 +561,10 @@ void getDpiOfHdc(const Nan::FunctionCallbackInfo<Value>& args){
 		return;
 	}
 	HDC hdc = (HDC)args[0]->Int32Value();
-	int dpix = GetDeviceCaps(hdc, LOGPIXELSX);
-	int dpiy = GetDeviceCaps(hdc, LOGPIXELSY);
+	PrinterCaps caps = dc_caps(hdc);
 	Local<Object> obj = Nan::New<v8::Object>();
-	obj->Set(Nan::New("dpix").ToLocalChecked(), Nan::New(dpix));
-	obj->Set(Nan::New("dpiy").ToLocalChecked(), Nan::New(dpiy));
+	obj->Set(Nan::New("dpix").ToLocalChecked(), Nan::New(caps.dpix));
+	obj->Set(Nan::New("dpiy").ToLocalChecked(), Nan::New(caps.dpiy));
 	args.GetReturnValue().Set(obj);
 }
 
@@ -334,6 +695,205 @@ void parseDevnames(const Nan::FunctionCallbackInfo<Value>& args){
 	args.GetReturnValue().Set(obj);
 }
 
+void acquireDc(const Nan::FunctionCallbackInfo<Value>& args){
+	// acquireDc(printer, devmode?) ==> hdc (a warm one from the pool if there is one)
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsString() ||
+			(args.Length() >= 2 && !node::Buffer::HasInstance(args[1]) && !args[1]->IsNull() && !args[1]->IsUndefined()) ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	String::Value printer(args[0]);
+	const char *devmode = NULL;
+	size_t devmodeLength = 0;
+	if( args.Length() >= 2 && node::Buffer::HasInstance(args[1]) ){
+		devmode = node::Buffer::Data(args[1]);
+		devmodeLength = node::Buffer::Length(args[1]);
+	}
+	std::string err;
+	std::string name = utf16_to_utf8((const uint16_t *)*printer, printer.length());
+	int64_t opened = jobStats.enabled() ? stats_now() : 0;
+	HDC hdc = (HDC)gdi_dc_pool()->acquire(name, devmode, devmodeLength, &err);
+	if( hdc == NULL ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	gdi_caps_cache()->bindDc((DeviceHandle)hdc, name, devmode, devmodeLength);
+	dc_stats_begin(hdc, name, opened);
+	args.GetReturnValue().Set(Nan::New((int)hdc));
+}
+
+void releasePooledDc(const Nan::FunctionCallbackInfo<Value>& args){
+	// releasePooledDc(hdc, discard?) ==> bool (ok); deletes DCs that are not from acquireDc
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsInt32() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	HDC hdc = (HDC)args[0]->Int32Value();
+	bool discard = args.Length() >= 2 && args[1]->BooleanValue();
+	JobStats *stats = dc_stats(hdc);
+	int64_t t = stats ? stats->enter() : 0;
+	gdi_caps_cache()->unbindDc((DeviceHandle)hdc);
+	bool ok = gdi_dc_pool()->release((DeviceHandle)hdc, discard) || DeleteDC(hdc) != FALSE;
+	if( stats ){
+		// a DC is discarded after a failure
+		dc_stats_end(hdc, stats, t, discard ? "error" : "done");
+	}
+	args.GetReturnValue().Set(ok);
+}
+
+void dcPoolStats(const Nan::FunctionCallbackInfo<Value>& args){
+	// dcPoolStats() ==> { hits, misses, createFailures, destroyed, unhealthy, idle, leased, createSeconds, maxCreateSeconds }
+	DcPoolStats stats = gdi_dc_pool()->stats();
+	Local<Object> obj = Nan::New<Object>();
+	obj->Set(Nan::New("hits").ToLocalChecked(), Nan::New((double)stats.hits));
+	obj->Set(Nan::New("misses").ToLocalChecked(), Nan::New((double)stats.misses));
+	obj->Set(Nan::New("createFailures").ToLocalChecked(), Nan::New((double)stats.createFailures));
+	obj->Set(Nan::New("destroyed").ToLocalChecked(), Nan::New((double)stats.destroyed));
+	obj->Set(Nan::New("unhealthy").ToLocalChecked(), Nan::New((double)stats.unhealthy));
+	obj->Set(Nan::New("idle").ToLocalChecked(), Nan::New((double)stats.idle));
+	obj->Set(Nan::New("leased").ToLocalChecked(), Nan::New((double)stats.leased));
+	obj->Set(Nan::New("createSeconds").ToLocalChecked(), Nan::New(stats.createSeconds));
+	obj->Set(Nan::New("maxCreateSeconds").ToLocalChecked(), Nan::New(stats.maxCreateSeconds));
+	args.GetReturnValue().Set(obj);
+}
+
+// { dpix, dpiy, printableWidth, printableHeight, printableWidthMm,
+//   printableHeightMm, physicalWidth, physicalHeight, offsetX, offsetY,
+//   color, duplex, papers: [{ id, name, width, height }], bins: [{ id, name }] }
+static Local<Object> js_printer_caps(const PrinterCaps &caps){
+	Local<Object> obj = Nan::New<Object>();
+	obj->Set(Nan::New("dpix").ToLocalChecked(), Nan::New(caps.dpix));
+	obj->Set(Nan::New("dpiy").ToLocalChecked(), Nan::New(caps.dpiy));
+	obj->Set(Nan::New("printableWidth").ToLocalChecked(), Nan::New((double)caps.printableWidth));
+	obj->Set(Nan::New("printableHeight").ToLocalChecked(), Nan::New((double)caps.printableHeight));
+	obj->Set(Nan::New("printableWidthMm").ToLocalChecked(), Nan::New((double)caps.printableWidthMm));
+	obj->Set(Nan::New("printableHeightMm").ToLocalChecked(), Nan::New((double)caps.printableHeightMm));
+	obj->Set(Nan::New("physicalWidth").ToLocalChecked(), Nan::New((double)caps.physicalWidth));
+	obj->Set(Nan::New("physicalHeight").ToLocalChecked(), Nan::New((double)caps.physicalHeight));
+	obj->Set(Nan::New("offsetX").ToLocalChecked(), Nan::New((double)caps.offsetX));
+	obj->Set(Nan::New("offsetY").ToLocalChecked(), Nan::New((double)caps.offsetY));
+	obj->Set(Nan::New("color").ToLocalChecked(), Nan::New(caps.color));
+	obj->Set(Nan::New("duplex").ToLocalChecked(), Nan::New(caps.duplex));
+	Local<Array> papers = Nan::New<Array>((int)caps.papers.size());
+	size_t i;
+	for(i=0;i<caps.papers.size();i++){
+		Local<Object> paper = Nan::New<Object>();
+		paper->Set(Nan::New("id").ToLocalChecked(), Nan::New(caps.papers[i].id));
+		paper->Set(Nan::New("name").ToLocalChecked(), Nan::New(caps.papers[i].name.c_str()).ToLocalChecked());
+		paper->Set(Nan::New("width").ToLocalChecked(), Nan::New((double)caps.papers[i].width));
+		paper->Set(Nan::New("height").ToLocalChecked(), Nan::New((double)caps.papers[i].height));
+		papers->Set((uint32_t)i, paper);
+	}
+	obj->Set(Nan::New("papers").ToLocalChecked(), papers);
+	Local<Array> bins = Nan::New<Array>((int)caps.bins.size());
+	for(i=0;i<caps.bins.size();i++){
+		Local<Object> bin = Nan::New<Object>();
+		bin->Set(Nan::New("id").ToLocalChecked(), Nan::New(caps.bins[i].id));
+		bin->Set(Nan::New("name").ToLocalChecked(), Nan::New(caps.bins[i].name.c_str()).ToLocalChecked());
+		bins->Set((uint32_t)i, bin);
+	}
+	obj->Set(Nan::New("bins").ToLocalChecked(), bins);
+	return obj;
+}
+
+void getPrinterCaps(const Nan::FunctionCallbackInfo<Value>& args){
+	// getPrinterCaps(printer, devmode?) ==> caps (probed once per printer and devmode)
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsString() ||
+			(args.Length() >= 2 && !node::Buffer::HasInstance(args[1]) && !args[1]->IsNull() && !args[1]->IsUndefined()) ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	String::Value printer(args[0]);
+	const char *devmode = NULL;
+	size_t devmodeLength = 0;
+	if( args.Length() >= 2 && node::Buffer::HasInstance(args[1]) ){
+		devmode = node::Buffer::Data(args[1]);
+		devmodeLength = node::Buffer::Length(args[1]);
+	}
+	PrinterCaps caps;
+	std::string err;
+	if( !gdi_caps_cache()->get(utf16_to_utf8((const uint16_t *)*printer, printer.length()),
+			devmode, devmodeLength, &caps, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	args.GetReturnValue().Set(js_printer_caps(caps));
+}
+
+void getDcCaps(const Nan::FunctionCallbackInfo<Value>& args){
+	// getDcCaps(hdc) ==> caps (papers and bins only for DCs of acquireDc, createDc, ...)
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsInt32() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	PrinterCaps caps;
+	std::string err;
+	if( !gdi_caps_cache()->getForDc((DeviceHandle)args[0]->Int32Value(), &caps, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	args.GetReturnValue().Set(js_printer_caps(caps));
+}
+
+void invalidatePrinterCaps(const Nan::FunctionCallbackInfo<Value>& args){
+	// invalidatePrinterCaps(printer?): forgets the caps of printer (of all printers without it)
+	std::string printer;
+	if( args.Length() >= 1 && args[0]->IsString() ){
+		String::Value value(args[0]);
+		printer = utf16_to_utf8((const uint16_t *)*value, value.length());
+	}
+	gdi_caps_cache()->invalidate(printer);
+}
+
+void printerCapsStats(const Nan::FunctionCallbackInfo<Value>& args){
+	// printerCapsStats() ==> { hits, misses, failures, entries, boundDcs }
+	PrinterCapsStats stats = gdi_caps_cache()->stats();
+	Local<Object> obj = Nan::New<Object>();
+	obj->Set(Nan::New("hits").ToLocalChecked(), Nan::New((double)stats.hits));
+	obj->Set(Nan::New("misses").ToLocalChecked(), Nan::New((double)stats.misses));
+	obj->Set(Nan::New("failures").ToLocalChecked(), Nan::New((double)stats.failures));
+	obj->Set(Nan::New("entries").ToLocalChecked(), Nan::New((double)stats.entries));
+	obj->Set(Nan::New("boundDcs").ToLocalChecked(), Nan::New((double)stats.boundDcs));
+	args.GetReturnValue().Set(obj);
+}
+
+void setDcPoolOptions(const Nan::FunctionCallbackInfo<Value>& args){
+	// setDcPoolOptions({ idleTimeout (sec), maxIdle })
+	if( args.Length() < 1 || !args[0]->IsObject() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	double idleTimeout = js_option_number(args[0], "idleTimeout", -1);
+	double maxIdle = js_option_number(args[0], "maxIdle", -1);
+	if( idleTimeout >= 0 ){
+		gdi_dc_pool()->setIdleTimeout(idleTimeout);
+	}
+	if( maxIdle >= 0 ){
+		gdi_dc_pool()->setMaxIdle((size_t)maxIdle);
+	}
+}
+
+void purgeDcPool(const Nan::FunctionCallbackInfo<Value>& args){
+	// purgeDcPool(all?): deletes idle DCs that timed out (all idle DCs with all)
+	gdi_dc_pool()->expire(args.Length() >= 1 && args[0]->BooleanValue());
+}
+
 void createDc(const Nan::FunctionCallbackInfo<Value>& args){
 	// createDc(devmode, devnames)
 	if( args.Length() < 2 ){
@@ -353,6 +913,9 @@ void createDc(const Nan::FunctionCallbackInfo<Value>& args){
 		Nan::ThrowTypeError("createDC failed");
 		return;
 	}
+	gdi_caps_cache()->bindDc((DeviceHandle)hdc,
+		utf16_to_utf8((const uint16_t *)device, (uint32_t)wcslen(device)),
+		(const char *)devmodePtr, node::Buffer::Length(args[0]));
 	args.GetReturnValue().Set(Nan::New((int)hdc));
 }
 
@@ -433,6 +996,7 @@ void createDcWithoutDialog(const Nan::FunctionCallbackInfo<Value>& args){
 
     printer = LPCWSTR_to_char(printerName);
 
+	int64_t opened = jobStats.enabled() ? stats_now() : 0;
 	HDC hdc = CreateDCW(NULL, printerName, NULL, NULL);
 	int lastErrorNumber = GetLastError();
 
@@ -455,6 +1019,8 @@ void createDcWithoutDialog(const Nan::FunctionCallbackInfo<Value>& args){
 
     free(printerName);
 
+	gdi_caps_cache()->bindDc((DeviceHandle)hdc, val, NULL, 0);
+	dc_stats_begin(hdc, val, opened);
 	args.GetReturnValue().Set(Nan::New((int)hdc));
 }
 
@@ -471,7 +1037,13 @@ void deleteDc(const Nan::FunctionCallbackInfo<Value>& args){
 		return;
 	}
 	HDC hdc = (HDC)args[0]->Int32Value();
+	JobStats *stats = dc_stats(hdc);
+	int64_t t = stats ? stats->enter() : 0;
+	gdi_caps_cache()->unbindDc((DeviceHandle)hdc);
 	BOOL ok = DeleteDC(hdc);
+	if( stats ){
+		dc_stats_end(hdc, stats, t, "done");
+	}
 	args.GetReturnValue().Set(ok);
 }
 
@@ -492,7 +1064,13 @@ void beginPrint(const Nan::FunctionCallbackInfo<Value>& args){
 	ZeroMemory(&docinfo, sizeof(docinfo));
 	docinfo.cbSize = sizeof(docinfo);
 	docinfo.lpszDocName = jobName;
+	JobStats *stats = dc_stats_begin(hdc, "", 0);
+	int64_t t = stats ? stats->enter() : 0;
 	int ret = StartDocW(hdc, &docinfo);
+	if( stats ){
+		stats->leave(PHASE_START_DOC, t);
+		stats->gdiCalls += 1;
+	}
 	if( ret <= 0 ){
 		Nan::ThrowTypeError("StartDoc failed");
 		return;
@@ -511,7 +1089,13 @@ void endPrint(const Nan::FunctionCallbackInfo<Value>& args){
 		return;
 	}
 	HDC hdc = (HDC)args[0]->Int32Value();
+	JobStats *stats = dc_stats(hdc);
+	int64_t t = stats ? stats->enter() : 0;
 	int ret = EndDoc(hdc);
+	if( stats ){
+		stats->leave(PHASE_END_DOC, t);
+		stats->gdiCalls += 1;
+	}
 	if( ret <= 0 ){
 		Nan::ThrowTypeError("EndDoc failed");
 		return;
@@ -530,7 +1114,13 @@ void abortPrint(const Nan::FunctionCallbackInfo<Value>& args){
 		return;
 	}
 	HDC hdc = (HDC)args[0]->Int32Value();
+	JobStats *stats = dc_stats(hdc);
+	int64_t t = stats ? stats->enter() : 0;
 	int ret = AbortDoc(hdc);
+	if( stats ){
+		stats->leave(PHASE_END_DOC, t);
+		stats->gdiCalls += 1;
+	}
 	if( ret <= 0 ){
 		Nan::ThrowTypeError("AbortDoc failed");
 		return;
@@ -549,6 +1139,7 @@ void startPage(const Nan::FunctionCallbackInfo<Value>& args){
 		return;
 	}
 	HDC hdc = (HDC)args[0]->Int32Value();
+	dc_stats_call(hdc, false);
 	int ret = StartPage(hdc);
 	if( ret <= 0 ){
 		Nan::ThrowTypeError("StartPage failed");
@@ -568,7 +1159,14 @@ void endPage(const Nan::FunctionCallbackInfo<Value>& args){
 		return;
 	}
 	HDC hdc = (HDC)args[0]->Int32Value();
+	JobStats *stats = dc_stats(hdc);
+	int64_t t = stats ? stats->enter() : 0;
 	int ret = EndPage(hdc);
+	if( stats ){
+		stats->leave(PHASE_END_PAGE, t);
+		stats->gdiCalls += 1;
+		stats->pages += 1;
+	}
 	if( ret <= 0 ){
 		Nan::ThrowTypeError("EndPage failed");
 		return;
@@ -589,6 +1187,7 @@ void moveTo(const Nan::FunctionCallbackInfo<Value>& args){
 	HDC hdc = (HDC)args[0]->Int32Value();
 	long x = args[1]->Int32Value();
 	long y = args[2]->Int32Value();
+	dc_stats_call(hdc, false);
 	BOOL ok = MoveToEx(hdc, x, y, NULL);
 	if( !ok ){
 		Nan::ThrowTypeError("MoveToEx failed");
@@ -610,6 +1209,7 @@ void lineTo(const Nan::FunctionCallbackInfo<Value>& args){
 	HDC hdc = (HDC)args[0]->Int32Value();
 	long x = args[1]->Int32Value();
 	long y = args[2]->Int32Value();
+	dc_stats_call(hdc, false);
 	BOOL ok = LineTo(hdc, x, y);
 	if( !ok ){
 		Nan::ThrowTypeError("LineTo failed");
@@ -618,86 +1218,365 @@ void lineTo(const Nan::FunctionCallbackInfo<Value>& args){
 	args.GetReturnValue().Set(ok);
 }
 
-/**
-	Print Image from byte array
-	@author nam.tran
-    @version 20/01/2017
-	
-    @param HDC hdc
-	@param node buffer
-*/
-void printImageFromBytes(const Nan::FunctionCallbackInfo<Value>& args){
-	// Print image
-	if( args.Length() < 2 ){
+void polyPolyline(const Nan::FunctionCallbackInfo<Value>& args){
+	// polyPolyline(hdc, points, counts)
+	if( args.Length() < 3 ){
 		Nan::ThrowTypeError("wrong number of arguments");
 		return;
-	}	
+	}
+	if( !args[0]->IsInt32() || !args[1]->IsArray() || !args[2]->IsArray() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	HDC hdc = (HDC)args[0]->Int32Value();
+	Local<Array> pointArray = Local<Array>::Cast(args[1]);
+	Local<Array> countArray = Local<Array>::Cast(args[2]);
+	uint32_t i, n = countArray->Length(), total = 0;
+	std::vector<DWORD> counts(n);
+	if( n == 0 ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	// as in add_path_shapes: every polyline has two points or more, and the
+	// total is capped so that it can't wrap
+	for(i=0;i<n;i++){
+		counts[i] = countArray->Get(i)->Uint32Value();
+		if( counts[i] < 2 || counts[i] > 0x10000000 - total ){
+			Nan::ThrowTypeError("invalid count to polyPolyline");
+			return;
+		}
+		total += counts[i];
+	}
+	if( total > pointArray->Length() / 2 ){
+		Nan::ThrowTypeError("too few points to polyPolyline");
+		return;
+	}
+	std::vector<POINT> points(total);
+	for(i=0;i<total;i++){
+		points[i].x = pointArray->Get(i * 2)->Int32Value();
+		points[i].y = pointArray->Get(i * 2 + 1)->Int32Value();
+	}
+	dc_stats_call(hdc, false);
+	BOOL ok = PolyPolyline(hdc, &points[0], &counts[0], n);
+	if( !ok ){
+		Nan::ThrowTypeError("PolyPolyline failed");
+		return;
+	}
+	args.GetReturnValue().Set(ok);
+}
+
+void fillRect(const Nan::FunctionCallbackInfo<Value>& args){
+	// fillRect(hdc, left, top, right, bottom, r, g, b)
+	if( args.Length() < 8 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
 	if( !args[0]->IsInt32() ){
 		Nan::ThrowTypeError("wrong arguments");
 		return;
 	}
 	HDC hdc = (HDC)args[0]->Int32Value();
-	int ret = StartPage(hdc);
+	GdiDevice device(hdc);
+	dc_stats_call(hdc, false);
+	if( !device.fillRect(args[1]->Int32Value(), args[2]->Int32Value(), args[3]->Int32Value(),
+			args[4]->Int32Value(), args[5]->Int32Value(), args[6]->Int32Value(), args[7]->Int32Value()) ){
+		Nan::ThrowTypeError("FillRect failed");
+		return;
+	}
+	args.GetReturnValue().Set(true);
+}
 
-	// TODO nam.tran
-	// Create bitmap from byte
-	char* bytes = node::Buffer::Data(args[1]);
+// Draws the bands of an image with StretchDIBits.
+class GdiImageTarget : public ImageTarget {
+public:
+	explicit GdiImageTarget(HDC hdc){ hdc_ = hdc; }
 
-	BITMAPFILEHEADER* bmfh;
-	bmfh = (BITMAPFILEHEADER*)bytes;
+	bool drawBand(long destX, long destY, long destWidth, long destHeight,
+			uint32_t srcWidth, uint32_t srcRows, const uint8_t *pixels, const uint8_t *info){
+		int lines = StretchDIBits(hdc_, destX, destY, destWidth, destHeight,
+			0, 0, srcWidth, srcRows, pixels, (const BITMAPINFO *)info, DIB_RGB_COLORS, SRCCOPY);
+		return lines != 0 && lines != GDI_ERROR;
+	}
 
-	BITMAPINFOHEADER* bmih;
-	bmih = (BITMAPINFOHEADER*)(bytes + sizeof(BITMAPFILEHEADER));
-	BITMAPINFO* bmi;
-	bmi = (BITMAPINFO*)bmih;
+private:
+	HDC hdc_;
+};
 
-	void* bits;
-	bits = (void*)(bytes + bmfh->bfOffBits);
-	HBITMAP g_hbm = CreateDIBitmap(hdc, bmih, CBM_INIT, bits, bmi, DIB_RGB_COLORS) ;
+// Read-only mapping of a whole file, so that a BMP is read in place instead
+// of being loaded into memory.
+class MappedFile {
+public:
+	MappedFile() : file_(INVALID_HANDLE_VALUE), mapping_(NULL), data_(NULL), size_(0) {}
 
-	if(g_hbm == NULL) {
-		Nan::ThrowTypeError("Could not load image....... ");
-		return;	
+	~MappedFile(){
+		if( data_ ){
+			UnmapViewOfFile(data_);
+		}
+		if( mapping_ ){
+			CloseHandle(mapping_);
+		}
+		if( file_ != INVALID_HANDLE_VALUE ){
+			CloseHandle(file_);
+		}
 	}
-	BITMAP bm;
-	PAINTSTRUCT ps;
-	HDC hdcMem = CreateCompatibleDC(hdc);
 
-	SetMapMode(hdc, MM_TEXT);
+	bool open(const wchar_t *path, std::string *err){
+		LARGE_INTEGER size;
+		file_ = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if( file_ == INVALID_HANDLE_VALUE || !GetFileSizeEx(file_, &size) ){
+			*err = "cannot open image file";
+			return false;
+		}
+		if( size.QuadPart == 0 || size.QuadPart > 0x7fffffff ){
+			*err = "invalid image file size";
+			return false;
+		}
+		mapping_ = CreateFileMappingW(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+		data_ = mapping_ ? (const uint8_t *)MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0) : NULL;
+		if( !data_ ){
+			*err = "cannot map image file";
+			return false;
+		}
+		size_ = (size_t)size.QuadPart;
+		return true;
+	}
 
+	const uint8_t *data() const { return data_; }
+	size_t size() const { return size_; }
 
-	HBITMAP hbmOld = (HBITMAP)SelectObject(hdcMem, g_hbm);
-	GetObject(g_hbm, sizeof(bm), &bm);
+private:
+	HANDLE file_;
+	HANDLE mapping_;
+	const uint8_t *data_;
+	size_t size_;
+};
 
-	int xwidth = GetDeviceCaps(hdc, HORZSIZE);
+static uint32_t js_band_rows(Local<Value> opts){
+	double rows = js_option_number(opts, "bandHeight", 256);
+	return rows >= 1 && rows <= 65536 ? (uint32_t)rows : 256;
+}
 
-	if (xwidth > 100) {
-		double scaleX = GetDeviceCaps(hdc, LOGPIXELSX) / 96;
-		double scaleY = GetDeviceCaps(hdc, LOGPIXELSY) / 96;
-		if ( bm.bmWidth * scaleX >= GetDeviceCaps(hdc, HORZRES)) {
-			StretchBlt(hdc, GetDeviceCaps(hdc, HORZRES)/2 - bm.bmWidth/2, 0,  bm.bmWidth, bm.bmHeight * scaleY, hdcMem, 0, 0, bm.bmWidth, bm.bmHeight, SRCCOPY); 
+// Reads { dither, threshold, contrast, brightness }; *present tells whether
+// opts.dither was given.
+static bool js_mono_options(Local<Value> opts, MonoOptions *mono, bool *present, std::string *err){
+	*present = false;
+	if( !opts->IsObject() ){
+		return true;
+	}
+	Local<Value> dither = opts->ToObject()->Get(Nan::New("dither").ToLocalChecked());
+	if( !dither->IsUndefined() ){
+		std::string name = *String::Utf8Value(dither);
+		if( name == "none" ){
+			mono->dither = MONO_DITHER_NONE;
+		} else if( name == "bayer" ){
+			mono->dither = MONO_DITHER_BAYER;
+		} else if( name == "floyd-steinberg" ){
+			mono->dither = MONO_DITHER_FLOYD_STEINBERG;
 		} else {
-			StretchBlt(hdc, GetDeviceCaps(hdc, HORZRES)/2 - bm.bmWidth *  scaleX/2, 0,  bm.bmWidth * scaleX, bm.bmHeight * scaleY, hdcMem, 0, 0, bm.bmWidth, bm.bmHeight, SRCCOPY); 
+			*err = "unknown dither: " + name;
+			return false;
 		}
-	} else {
-		BitBlt(hdc, GetDeviceCaps(hdc, HORZRES)/2 - bm.bmWidth/2, 0, bm.bmWidth, bm.bmHeight, hdcMem, 0, 0, SRCCOPY);
+		*present = true;
 	}
+	mono->threshold = (int)js_option_number(opts, "threshold", 128);
+	mono->contrast = js_option_number(opts, "contrast", 1.0);
+	mono->brightness = (int)js_option_number(opts, "brightness", 0);
+	return true;
+}
 
-	// int cxpage = GetDeviceCaps (hdc, HORZRES);
-	// int cypage = GetDeviceCaps (hdc, VERTRES);
-
-	// SetWindowExtEx(hdc, cxpage,cypage, NULL);
-	// SetViewportExtEx(hdc, cxpage, cypage,NULL);
-
-	// SetViewportOrgEx(hdc, 0, 0, NULL);
-	// StretchBlt(hdc, GetDeviceCaps(hdc, HORZRES)/2 - bm.bmWidth/2, 0,  bm.bmWidth , bm.bmHeight, hdcMem, 0, 0, bm.bmWidth, bm.bmHeight, SRCCOPY); 
+// Replaces image by its 1 bpp conversion (kept in storage) when opts.dither
+// is given, so that the driver gets a fraction of the data.
+static bool js_dither_image(Local<Value> opts, BmpImage *image,
+		std::vector<uint8_t> *storage, std::string *err){
+	MonoOptions mono;
+	bool present;
+	if( !js_mono_options(opts, &mono, &present, err) ){
+		return false;
+	}
+	if( !present ){
+		return true;
+	}
+	return bmp_to_mono(*image, mono, storage, err) &&
+		parse_bmp(&(*storage)[0], storage->size(), image, err);
+}
 
-	
+// Reads { filter: "box" | "bilinear" | "lanczos3" | "gdi", threads }; *filter
+// is -1 for "gdi" (StretchDIBits scales).
+static bool js_resample_options(Local<Value> opts, int defaultFilter, int *filter,
+		int *threads, std::string *err){
+	*filter = defaultFilter;
+	unsigned cores = std::thread::hardware_concurrency();
+	*threads = (int)js_option_number(opts, "threads", cores > 4 ? 4 : cores > 0 ? cores : 1);
+	if( *threads < 1 ){
+		*threads = 1;
+	}
+	if( !opts->IsObject() ){
+		return true;
+	}
+	Local<Value> value = opts->ToObject()->Get(Nan::New("filter").ToLocalChecked());
+	if( value->IsUndefined() ){
+		return true;
+	}
+	std::string name = *String::Utf8Value(value);
+	if( name == "box" ){
+		*filter = RESAMPLE_BOX;
+	} else if( name == "bilinear" ){
+		*filter = RESAMPLE_BILINEAR;
+	} else if( name == "lanczos3" ){
+		*filter = RESAMPLE_LANCZOS3;
+	} else if( name == "gdi" ){
+		*filter = -1;
+	} else {
+		*err = "unknown filter: " + name;
+		return false;
+	}
+	return true;
+}
+
+// A BMP or PNG to print, read in place. With a resampling filter the image is
+// scaled to the device size here and drawn 1:1, dithered at device
+// resolution when opts.dither is given. With "gdi" StretchDIBits scales: a
+// BMP is then converted to 1 bpp up front, a PNG band by band.
+class PrintImage {
+public:
+	bool open(const uint8_t *data, size_t length, Local<Value> opts, int defaultFilter,
+			std::string *err){
+		png_ = is_png(data, length);
+		if( !js_resample_options(opts, defaultFilter, &filter_, &threads_, err) ||
+				!js_mono_options(opts, &mono_, &dither_, err) ){
+			return false;
+		}
+		if( png_ ){
+			return parse_png(data, length, &pngImage_, err);
+		}
+		if( !parse_bmp(data, length, &bmp_, err) ){
+			return false;
+		}
+		return filter_ >= 0 || js_dither_image(opts, &bmp_, &monoBmp_, err);
+	}
+
+	long width() const { return png_ ? pngImage_.width : bmp_.width; }
+	long height() const { return png_ ? pngImage_.height : bmp_.height; }
+	bool resampled() const { return filter_ >= 0; }
+
+	bool draw(ImageTarget *target, long destX, long destY, long destWidth, long destHeight,
+			uint32_t bandRows, std::string *err){
+		if( filter_ >= 0 ){
+			if( png_ ){
+				PngRowReader reader(pngImage_);
+				return draw_resampled(&reader, target, destX, destY, destWidth, destHeight,
+					filter_, bandRows, dither_ ? &mono_ : NULL, threads_, err) && reader.finish(err);
+			}
+			BmpRows rows(bmp_);
+			return draw_resampled(&rows, target, destX, destY, destWidth, destHeight,
+				filter_, bandRows, dither_ ? &mono_ : NULL, threads_, err);
+		}
+		if( png_ ){
+			return draw_png_banded(pngImage_, target, destX, destY, destWidth, destHeight,
+				bandRows, dither_ ? &mono_ : NULL, err);
+		}
+		return draw_bmp_banded(bmp_, target, destX, destY, destWidth, destHeight, bandRows, err);
+	}
+
+private:
+	bool png_;
+	PngImage pngImage_;
+	MonoOptions mono_;
+	bool dither_;
+	int filter_;
+	int threads_;
+	BmpImage bmp_;
+	std::vector<uint8_t> monoBmp_;
+};
+
+/**
+	Converts a BMP to a 1 bpp BMP for monochrome (receipt, label) printers.
+
+	@param node buffer
+	@param opts { dither: "none" | "bayer" | "floyd-steinberg", threshold,
+		contrast, brightness } (optional)
+*/
+void monochromeBmp(const Nan::FunctionCallbackInfo<Value>& args){
+	// monochromeBmp(buffer, opts?) ==> Buffer
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !node::Buffer::HasInstance(args[0]) ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	Local<Value> opts = args.Length() >= 2 ? args[1] : Local<Value>(Nan::Undefined());
+	BmpImage image;
+	MonoOptions mono;
+	bool present;
+	std::vector<uint8_t> out;
+	std::string err;
+	if( !parse_bmp((const uint8_t *)node::Buffer::Data(args[0]), node::Buffer::Length(args[0]), &image, &err) ||
+			!js_mono_options(opts, &mono, &present, &err) ||
+			!bmp_to_mono(image, mono, &out, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	args.GetReturnValue().Set(Nan::CopyBuffer((const char *)&out[0], (uint32_t)out.size()).ToLocalChecked());
+}
 
+void imageKernels(const Nan::FunctionCallbackInfo<Value>& args){
+	// imageKernels() ==> "scalar" | "sse2" | "avx2"
+	args.GetReturnValue().Set(Nan::New(mono_kernel_name(mono_kernel_level())).ToLocalChecked());
+}
+
+/**
+	Print Image from byte array
+	@author nam.tran
+    @version 20/01/2017
+	
+    @param HDC hdc
+	@param node buffer (BMP or PNG)
+	@param opts { bandHeight, dither, threshold, contrast, brightness, filter,
+		threads } (optional; rows per StretchDIBits call, see monochromeBmp;
+		filter "lanczos3" (default), "bilinear", "box" or "gdi" for the
+		StretchDIBits scaling, threads resampling)
+*/
+void printImageFromBytes(const Nan::FunctionCallbackInfo<Value>& args){
+	// printImageFromBytes(hdc, buffer, opts?)
+	if( args.Length() < 2 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}	
+	if( !args[0]->IsInt32() || !node::Buffer::HasInstance(args[1]) ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	HDC hdc = (HDC)args[0]->Int32Value();
+	int ret = StartPage(hdc);
 
-	SelectObject(hdcMem, hbmOld);
-	DeleteDC(hdcMem);
-	// End TODO nam.tran
+	// The image is read in place and drawn in bands, so that peak memory does
+	// not depend on the size of the image.
+	PrintImage image;
+	std::string err;
+	Local<Value> opts = args.Length() >= 3 ? args[2] : Local<Value>(Nan::Undefined());
+	if( !image.open((const uint8_t *)node::Buffer::Data(args[1]), node::Buffer::Length(args[1]),
+			opts, RESAMPLE_LANCZOS3, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	SetMapMode(hdc, MM_TEXT);
+	PrinterCaps caps = dc_caps(hdc);
+	// the resampling filters only change how the image gets to that size
+	ImagePlacement place = image_placement(caps, image.width(), image.height(), image.resampled());
+	GdiImageTarget target(hdc);
+	if( !image.draw(&target, place.x, 0, place.width, place.height, js_band_rows(opts), &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	JobStats *stats = dc_stats(hdc);
+	if( stats ){
+		stats->gdiCalls += 1;
+		stats->imageBytes += node::Buffer::Length(args[1]);
+	}
+	args.GetReturnValue().Set(true);
 }
 
 /**
@@ -706,52 +1585,60 @@ void printImageFromBytes(const Nan::FunctionCallbackInfo<Value>& args){
     @version 19/01/2017
 
     @param HDC hdc
-	@param filePath
+	@param filePath (BMP or PNG)
+	@param opts { bandHeight, dither, threshold, contrast, brightness, filter,
+		threads } (optional; see printImageFromBytes, filter defaults to "gdi")
 */
 void printImage(const Nan::FunctionCallbackInfo<Value>& args){
-	// Print image
+	// printImage(hdc, path, opts?)
 	if( args.Length() < 2 ){
 		Nan::ThrowTypeError("wrong number of arguments");
 		return;
 	}	
-	if( !args[0]->IsInt32() ){
+	if( !args[0]->IsInt32() || !args[1]->IsString() ){
 		Nan::ThrowTypeError("wrong arguments");
 		return;
 	}
 	HDC hdc = (HDC)args[0]->Int32Value();
 	int ret = StartPage(hdc);
 
-	// TODO nam.tran
-	
-	LPCSTR imagePath = (LPCSTR) * String::Utf8Value (args[1]->ToString());
-	std::cout <<   imagePath;
-
-	HBITMAP g_hbm =  (HBITMAP)LoadImage(NULL, _T(imagePath) ,IMAGE_BITMAP,0,0,LR_CREATEDIBSECTION | LR_DEFAULTSIZE | LR_LOADFROMFILE );
-	if(g_hbm == NULL) {
-		Nan::ThrowTypeError("Could not load image....... ");
+	String::Value imagePath(args[1]);
+	std::wstring path((const wchar_t *)*imagePath, imagePath.length());
+	MappedFile file;
+	PrintImage image;
+	std::string err;
+	Local<Value> opts = args.Length() >= 3 ? args[2] : Local<Value>(Nan::Undefined());
+	if( !file.open(path.c_str(), &err) || !image.open(file.data(), file.size(), opts, -1, &err) ){
+		Nan::ThrowTypeError(("Could not load image: " + err).c_str());
 		return;	
 	}
-	BITMAP bm;
-	PAINTSTRUCT ps;
-	HDC hdcMem = CreateCompatibleDC(hdc);
-
-	SetMapMode(hdc, MM_LOENGLISH);
-
-	int dpix = GetDeviceCaps(hdc, LOGPIXELSX);
-	int dpiy = GetDeviceCaps(hdc, LOGPIXELSY);
-
-	int dpix1 = GetDeviceCaps(hdcMem, LOGPIXELSX);
-	int dpiy1 = GetDeviceCaps(hdcMem, LOGPIXELSY);
-
-	std::cout << static_cast<int>(1) << std::endl;
-
-
-	HBITMAP hbmOld = (HBITMAP)SelectObject(hdcMem, g_hbm);
-	GetObject(g_hbm, sizeof(bm), &bm);
-	BitBlt(hdc, GetDeviceCaps(hdc, HORZRES)/2 - bm.bmWidth/2, 0, bm.bmWidth, bm.bmHeight, hdcMem, 0, 0, SRCCOPY);
-	SelectObject(hdcMem, hbmOld);
-	DeleteDC(hdcMem);
-	// End TODO nam.tran
+	long width = image.width(), height = image.height();
+	PrinterCaps caps = dc_caps(hdc);
+	GdiImageTarget target(hdc);
+	bool ok;
+	if( image.resampled() ){
+		// the same size as with MM_LOENGLISH (a pixel per 0.01 inch), scaled
+		// here to device pixels
+		long destWidth = width * caps.dpix / 100;
+		long destHeight = height * caps.dpiy / 100;
+		SetMapMode(hdc, MM_TEXT);
+		ok = image.draw(&target, caps.printableWidth/2 - destWidth/2, 0,
+			destWidth > 0 ? destWidth : 1, destHeight > 0 ? destHeight : 1, js_band_rows(opts), &err);
+	} else {
+		SetMapMode(hdc, MM_LOENGLISH);
+		ok = image.draw(&target, caps.printableWidth/2 - width/2, 0,
+			width, height, js_band_rows(opts), &err);
+	}
+	if( !ok ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	JobStats *stats = dc_stats(hdc);
+	if( stats ){
+		stats->gdiCalls += 1;
+		stats->imageBytes += file.size();
+	}
+	args.GetReturnValue().Set(true);
 }
 
 
@@ -771,6 +1658,7 @@ void textOut(const Nan::FunctionCallbackInfo<Value>& args){
 	long y = args[2]->Int32Value();
 	String::Value textValue(args[3]);
 	
+	dc_stats_call(hdc, true);
 	BOOL ok = TextOutW(hdc, x, y, (LPWSTR)*textValue, textValue.length());
 	if( !ok ){
 		Nan::ThrowTypeError("TextOutW failed");
@@ -791,6 +1679,7 @@ void selectObject(const Nan::FunctionCallbackInfo<Value>& args){
 	}
 	HDC hdc = (HDC)args[0]->Int32Value();
 	HANDLE obj = (HANDLE)args[1]->Int32Value();
+	dc_stats_call(hdc, false);
 	HANDLE prev = SelectObject(hdc, obj);
 	if( prev == NULL || prev == HGDI_ERROR ){
 		Nan::ThrowTypeError("SelectObject failed");
@@ -813,6 +1702,7 @@ void setTextColor(const Nan::FunctionCallbackInfo<Value>& args){
 	long r = args[1]->Int32Value();
 	long g = args[2]->Int32Value();
 	long b = args[3]->Int32Value();
+	dc_stats_call(hdc, false);
 	COLORREF ret = SetTextColor(hdc, RGB(r, g, b));
 	if( ret == CLR_INVALID ){
 		Nan::ThrowTypeError("SetTextColor failed");
@@ -835,7 +1725,7 @@ void createPen(const Nan::FunctionCallbackInfo<Value>& args){
 	long r = args[1]->Int32Value();
 	long g = args[2]->Int32Value();
 	long b = args[3]->Int32Value();
-	HPEN pen = CreatePen(PS_SOLID, width, RGB(r, g, b));
+	HPEN pen = (HPEN)gdi_object_cache()->acquirePen(PS_SOLID, width, r, g, b);
 	if( pen == NULL ){
 		Nan::ThrowTypeError("CreatePen failed");
 		return;
@@ -863,6 +1753,1427 @@ void setBkMode(const Nan::FunctionCallbackInfo<Value>& args){
 	args.GetReturnValue().Set(prev);
 }
 
+static void add_js_text(PageBuilder &builder, Local<Value> value, TextRef *ref){
+	String::Value text(value->ToString());
+	*ref = builder.addText((const uint16_t *)*text, text.length());
+}
+
+static CoordRef js_coords(PageBuilder &builder, Local<Value> value){
+	if( value->IsArray() ){
+		Local<Array> array = Local<Array>::Cast(value);
+		uint32_t i, n = array->Length();
+		std::vector<double> values(n);
+		for(i=0;i<n;i++){
+			values[i] = array->Get(i)->NumberValue();
+		}
+		return builder.addCoords(n > 0 ? &values[0] : 0, n);
+	} else if( value->IsNumber() || value->IsNumberObject() ){
+		return builder.scalar(value->NumberValue());
+	} else {
+		return builder.scalar(NAN);
+	}
+}
+
+// Adds one op array to builder; unknown ops are skipped.
+static bool add_js_op(PageBuilder &builder, Local<Array> src, std::string *err){
+	int code = op_code_from_name(*String::Utf8Value(src->Get(0)));
+	TextRef name, face, text;
+	switch(code){
+		case OP_MOVE_TO: case OP_LINE_TO: {
+			PageOp &op = builder.addOp(code);
+			op.xs = builder.scalar(src->Get(1)->NumberValue());
+			op.ys = builder.scalar(src->Get(2)->NumberValue());
+			break;
+		}
+		case OP_CREATE_FONT: {
+			add_js_text(builder, src->Get(1), &name);
+			add_js_text(builder, src->Get(2), &face);
+			PageOp &op = builder.addOp(code);
+			op.name = name;
+			op.face = face;
+			op.size = src->Get(3)->NumberValue();
+			op.weight = src->Get(4)->BooleanValue() ? 1 : 0;
+			op.italic = src->Get(5)->BooleanValue() ? 1 : 0;
+			break;
+		}
+		case OP_SET_FONT: case OP_SET_PEN: {
+			add_js_text(builder, src->Get(1), &name);
+			PageOp &op = builder.addOp(code);
+			op.name = name;
+			break;
+		}
+		case OP_SET_TEXT_COLOR: {
+			PageOp &op = builder.addOp(code);
+			op.r = (int)floor(src->Get(1)->NumberValue());
+			op.g = (int)floor(src->Get(2)->NumberValue());
+			op.b = (int)floor(src->Get(3)->NumberValue());
+			break;
+		}
+		case OP_CREATE_PEN: {
+			add_js_text(builder, src->Get(1), &name);
+			PageOp &op = builder.addOp(code);
+			op.name = name;
+			op.r = (int)floor(src->Get(2)->NumberValue());
+			op.g = (int)floor(src->Get(3)->NumberValue());
+			op.b = (int)floor(src->Get(4)->NumberValue());
+			op.size = src->Get(5)->NumberValue();
+			break;
+		}
+		case OP_DRAW_CHARS: {
+			Local<Value> str = src->Get(1);
+			if( !str->IsString() && !str->IsStringObject() ){
+				*err = "invalid str to drawChars";
+				return false;
+			}
+			add_js_text(builder, str, &text);
+			CoordRef xs = js_coords(builder, src->Get(2));
+			CoordRef ys = js_coords(builder, src->Get(3));
+			PageOp &op = builder.addOp(code);
+			op.text = text;
+			op.xs = xs;
+			op.ys = ys;
+			break;
+		}
+		case OP_PUSH: case OP_POP: {
+			builder.addOp(code);
+			break;
+		}
+		case OP_TRANSLATE: case OP_SCALE: {
+			double x = src->Get(1)->NumberValue();
+			Local<Value> y = src->Get(2);
+			PageOp &op = builder.addOp(code);
+			op.xs = builder.scalar(x);
+			// ["scale", s] scales both axes
+			op.ys = builder.scalar(code == OP_SCALE && y->IsUndefined() ? x : y->NumberValue());
+			break;
+		}
+		case OP_ROTATE: {
+			PageOp &op = builder.addOp(code);
+			op.xs = builder.scalar(src->Get(1)->NumberValue());
+			op.ys = builder.scalar(0);
+			break;
+		}
+		case OP_POLYLINE: case OP_POLY_POLYLINE: case OP_GRID: {
+			CoordRef xs = js_coords(builder, src->Get(1));
+			CoordRef ys = js_coords(builder, src->Get(2));
+			CoordRef counts = code == OP_POLY_POLYLINE ? js_coords(builder, src->Get(3)) : builder.scalar(0);
+			PageOp &op = builder.addOp(code);
+			op.xs = xs;
+			op.ys = ys;
+			op.counts = counts;
+			break;
+		}
+		case OP_RECT: case OP_FILL_RECT: {
+			PageOp &op = builder.addOp(code);
+			op.xs = builder.scalar(src->Get(1)->NumberValue());
+			op.ys = builder.scalar(src->Get(2)->NumberValue());
+			op.width = src->Get(3)->NumberValue();
+			op.height = src->Get(4)->NumberValue();
+			if( code == OP_FILL_RECT ){
+				op.r = (int)floor(src->Get(5)->NumberValue());
+				op.g = (int)floor(src->Get(6)->NumberValue());
+				op.b = (int)floor(src->Get(7)->NumberValue());
+			}
+			break;
+		}
+	}
+	return true;
+}
+
+// Converts a JS page (array of ops as used by printer.js) into a native page.
+static bool build_page_from_js(PageBuilder &builder, Local<Value> value, std::string *err){
+	if( !value->IsArray() ){
+		*err = "page is not an array";
+		return false;
+	}
+	Local<Array> ops = Local<Array>::Cast(value);
+	uint32_t i, n = ops->Length();
+	builder.clear();
+	for(i=0;i<n;i++){
+		Local<Value> opValue = ops->Get(i);
+		if( !opValue->IsArray() ){
+			*err = "op is not an array";
+			return false;
+		}
+		if( !add_js_op(builder, Local<Array>::Cast(opValue), err) ){
+			return false;
+		}
+	}
+	builder.finish();
+	return true;
+}
+
+static double js_option_number(Local<Value> opts, const char *key, double defaultValue){
+	if( !opts->IsObject() ){
+		return defaultValue;
+	}
+	Local<Value> value = opts->ToObject()->Get(Nan::New(key).ToLocalChecked());
+	if( value->IsUndefined() ){
+		return defaultValue;
+	}
+	return value->NumberValue();
+}
+
+static bool js_option_bool(Local<Value> opts, const char *key, bool defaultValue){
+	if( !opts->IsObject() ){
+		return defaultValue;
+	}
+	Local<Value> value = opts->ToObject()->Get(Nan::New(key).ToLocalChecked());
+	if( value->IsUndefined() ){
+		return defaultValue;
+	}
+	return value->BooleanValue();
+}
+
+static bool js_job_name(Local<Value> opts, std::wstring *jobName){
+	*jobName = L"drawer";
+	if( opts->IsObject() ){
+		Local<Value> name = opts->ToObject()->Get(Nan::New("jobName").ToLocalChecked());
+		if( name->IsString() ){
+			*jobName = (const wchar_t *)*String::Value(name);
+		}
+	}
+	return true;
+}
+
+void drawPage(const Nan::FunctionCallbackInfo<Value>& args){
+	// drawPage(hdc, ops, opts?) ==> number of ops executed
+	if( args.Length() < 2 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsInt32() || !args[1]->IsArray() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	HDC hdc = (HDC)args[0]->Int32Value();
+	Local<Value> opts = args.Length() >= 3 ? args[2] : Local<Value>(Nan::Undefined());
+	PageBuilder builder;
+	std::string err;
+	if( !build_page_from_js(builder, args[1], &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	JobStats *stats = dc_stats(hdc);
+	GdiDevice device(hdc);
+	StatsDevice statsDevice(&device, stats);
+	PageExecutor executor(stats ? (Device *)&statsDevice : &device);
+	executor.setOffset(js_option_number(opts, "dx", 0), js_option_number(opts, "dy", 0));
+	PageOptimizer optimizer;
+	PageBuilder optimized;
+	bool ok = executor.runPage(js_option_bool(opts, "optimize", true) ?
+		optimizer.optimize(builder.page(), &optimized) : builder.page());
+	if( stats ){
+		stats->ops += executor.opCount();
+	}
+	if( !ok ){
+		Nan::ThrowTypeError(executor.error().c_str());
+		return;
+	}
+	args.GetReturnValue().Set(Nan::New((double)executor.opCount()));
+}
+
+void drawPages(const Nan::FunctionCallbackInfo<Value>& args){
+	// drawPages(hdc, pages, opts?) ==> number of ops executed
+	if( args.Length() < 2 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsInt32() || !args[1]->IsArray() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	HDC hdc = (HDC)args[0]->Int32Value();
+	Local<Array> pages = Local<Array>::Cast(args[1]);
+	Local<Value> opts = args.Length() >= 3 ? args[2] : Local<Value>(Nan::Undefined());
+	uint32_t i, n = pages->Length();
+	std::vector<PageBuilder> builders(n);
+	std::vector<const Page *> pagePtrs(n);
+	std::string err;
+	for(i=0;i<n;i++){
+		if( !build_page_from_js(builders[i], pages->Get(i), &err) ){
+			Nan::ThrowTypeError(err.c_str());
+			return;
+		}
+		pagePtrs[i] = &builders[i].page();
+	}
+	std::wstring jobName;
+	js_job_name(opts, &jobName);
+	JobStats *stats = dc_stats(hdc);
+	GdiDevice device(hdc);
+	StatsDevice statsDevice(&device, stats);
+	PageExecutor executor(stats ? (Device *)&statsDevice : &device);
+	executor.setOffset(js_option_number(opts, "dx", 0), js_option_number(opts, "dy", 0));
+	executor.setCopies((int)js_option_number(opts, "copies", 1), js_option_bool(opts, "collate", true));
+	executor.setOptimize(js_option_bool(opts, "optimize", true));
+	bool ok = executor.runJob(n > 0 ? &pagePtrs[0] : 0, n,
+		(const uint16_t *)jobName.c_str(), (uint32_t)jobName.size());
+	if( stats ){
+		stats->ops += executor.opCount();
+	}
+	if( !ok ){
+		Nan::ThrowTypeError(executor.error().c_str());
+		return;
+	}
+	args.GetReturnValue().Set(Nan::New((double)executor.opCount()));
+}
+
+void drawEncodedPages(const Nan::FunctionCallbackInfo<Value>& args){
+	// drawEncodedPages(hdc, buffer, opts?) ==> number of ops executed
+	if( args.Length() < 2 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsInt32() || !node::Buffer::HasInstance(args[1]) ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	HDC hdc = (HDC)args[0]->Int32Value();
+	Local<Value> opts = args.Length() >= 3 ? args[2] : Local<Value>(Nan::Undefined());
+	EncodedJob job;
+	std::string err;
+	if( !decode_pages(node::Buffer::Data(args[1]), node::Buffer::Length(args[1]), &job, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	size_t i, n = job.pages.size();
+	std::vector<const Page *> pagePtrs(n);
+	for(i=0;i<n;i++){
+		pagePtrs[i] = &job.pages[i];
+	}
+	std::wstring jobName;
+	js_job_name(opts, &jobName);
+	JobStats *stats = dc_stats(hdc);
+	GdiDevice device(hdc);
+	StatsDevice statsDevice(&device, stats);
+	PageExecutor executor(stats ? (Device *)&statsDevice : &device);
+	executor.setOffset(js_option_number(opts, "dx", 0), js_option_number(opts, "dy", 0));
+	executor.setCopies((int)js_option_number(opts, "copies", 1), js_option_bool(opts, "collate", true));
+	executor.setOptimize(js_option_bool(opts, "optimize", true));
+	bool ok = executor.runJob(n > 0 ? &pagePtrs[0] : 0, n,
+		(const uint16_t *)jobName.c_str(), (uint32_t)jobName.size());
+	if( stats ){
+		stats->ops += executor.opCount();
+	}
+	if( !ok ){
+		Nan::ThrowTypeError(executor.error().c_str());
+		return;
+	}
+	args.GetReturnValue().Set(Nan::New((double)executor.opCount()));
+}
+
+// Templates made by compileTemplate, by handle.
+static std::map<int, PageTemplate *> templates;
+static int nextTemplateId = 1;
+
+// Converts a JS template (page ops and field/repeat/if/end, see
+// page-template.h) and compiles it.
+static bool build_template_from_js(PageTemplate &tmpl, Local<Value> value, std::string *err){
+	if( !value->IsArray() ){
+		*err = "template is not an array";
+		return false;
+	}
+	Local<Array> ops = Local<Array>::Cast(value);
+	uint32_t i, n = ops->Length();
+	for(i=0;i<n;i++){
+		Local<Value> opValue = ops->Get(i);
+		if( !opValue->IsArray() ){
+			*err = "op is not an array";
+			return false;
+		}
+		Local<Array> src = Local<Array>::Cast(opValue);
+		std::string code = *String::Utf8Value(src->Get(0));
+		if( code == "field" ){
+			int align = TEMPLATE_ALIGN_LEFT;
+			Local<Value> alignValue = src->Get(5);
+			if( !alignValue->IsUndefined() ){
+				std::string name = *String::Utf8Value(alignValue);
+				if( name == "right" ){
+					align = TEMPLATE_ALIGN_RIGHT;
+				} else if( name == "center" ){
+					align = TEMPLATE_ALIGN_CENTER;
+				} else if( name != "left" ){
+					*err = "invalid align: " + name;
+					return false;
+				}
+			}
+			tmpl.field(*String::Utf8Value(src->Get(1)), src->Get(2)->NumberValue(),
+				src->Get(3)->NumberValue(), src->Get(4)->NumberValue(), align);
+		} else if( code == "repeat" ){
+			tmpl.beginRepeat(*String::Utf8Value(src->Get(1)), src->Get(2)->NumberValue());
+		} else if( code == "if" ){
+			Local<Value> height = src->Get(2);
+			tmpl.beginIf(*String::Utf8Value(src->Get(1)), height->IsUndefined() ? 0 : height->NumberValue());
+		} else if( code == "end" ){
+			tmpl.end();
+		} else if( !add_js_op(tmpl.ops(), src, err) ){
+			return false;
+		}
+	}
+	return tmpl.compile(err);
+}
+
+// Copies the fields and flags of a scope from obj (undefined and null
+// fields stay empty, other values are converted to strings).
+static void js_template_row(Local<Object> obj, const TemplateScope &scope, TemplateValues *values,
+		uint32_t scopeIndex, uint32_t row){
+	size_t i;
+	for(i=0;i<scope.fields.size();i++){
+		Local<Value> value = obj->Get(Nan::New(scope.fields[i]).ToLocalChecked());
+		if( value->IsUndefined() || value->IsNull() ){
+			continue;
+		}
+		String::Value text(value);
+		values->setText(scopeIndex, row, (uint32_t)i, (const uint16_t *)*text, (uint32_t)text.length());
+	}
+	for(i=0;i<scope.flags.size();i++){
+		Local<Value> value = obj->Get(Nan::New(scope.flags[i]).ToLocalChecked());
+		values->setFlag(scopeIndex, row, (uint32_t)i, value->BooleanValue());
+	}
+}
+
+// Reads { field: value, flag: bool, repeat: [{ field: value, ... }] }; only
+// the names the template uses are looked up.
+static bool js_template_values(PageTemplate &tmpl, Local<Value> value, TemplateValues *values,
+		std::string *err){
+	if( !value->IsObject() ){
+		*err = "template values are not an object";
+		return false;
+	}
+	const std::vector<TemplateScope> &scopes = tmpl.scopes();
+	Local<Object> obj = value->ToObject();
+	size_t i;
+	uint32_t j;
+	values->reset(tmpl);
+	js_template_row(obj, scopes[0], values, 0, 0);
+	for(i=1;i<scopes.size();i++){
+		Local<Value> rowsValue = obj->Get(Nan::New(scopes[i].name).ToLocalChecked());
+		if( rowsValue->IsUndefined() || rowsValue->IsNull() ){
+			continue;
+		}
+		if( !rowsValue->IsArray() ){
+			*err = scopes[i].name + " is not an array";
+			return false;
+		}
+		Local<Array> rows = Local<Array>::Cast(rowsValue);
+		for(j=0;j<rows->Length();j++){
+			Local<Value> rowValue = rows->Get(j);
+			if( !rowValue->IsObject() ){
+				*err = "row of " + scopes[i].name + " is not an object";
+				return false;
+			}
+			uint32_t row = values->addRow((uint32_t)i);
+			js_template_row(rowValue->ToObject(), scopes[i], values, (uint32_t)i, row);
+		}
+	}
+	return true;
+}
+
+static PageTemplate *js_template(Local<Value> value){
+	if( !value->IsInt32() ){
+		return 0;
+	}
+	std::map<int, PageTemplate *>::iterator iter = templates.find(value->Int32Value());
+	return iter == templates.end() ? 0 : iter->second;
+}
+
+void compileTemplate(const Nan::FunctionCallbackInfo<Value>& args){
+	// compileTemplate(ops) ==> template
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	PageTemplate *tmpl = new PageTemplate();
+	std::string err;
+	if( !build_template_from_js(*tmpl, args[0], &err) ){
+		delete tmpl;
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	int id = nextTemplateId++;
+	templates[id] = tmpl;
+	args.GetReturnValue().Set(Nan::New(id));
+}
+
+void deleteTemplate(const Nan::FunctionCallbackInfo<Value>& args){
+	// deleteTemplate(template) ==> bool (false if unknown)
+	if( args.Length() < 1 || !args[0]->IsInt32() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	std::map<int, PageTemplate *>::iterator iter = templates.find(args[0]->Int32Value());
+	if( iter == templates.end() ){
+		args.GetReturnValue().Set(false);
+		return;
+	}
+	delete iter->second;
+	templates.erase(iter);
+	args.GetReturnValue().Set(true);
+}
+
+void drawTemplate(const Nan::FunctionCallbackInfo<Value>& args){
+	// drawTemplate(hdc, template, values | [values], opts?) ==> number of ops executed
+	if( args.Length() < 3 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	PageTemplate *tmpl = js_template(args[1]);
+	if( !args[0]->IsInt32() || !tmpl ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	HDC hdc = (HDC)args[0]->Int32Value();
+	Local<Value> opts = args.Length() >= 4 ? args[3] : Local<Value>(Nan::Undefined());
+	std::vector<TemplateValues> values;
+	std::string err;
+	if( args[2]->IsArray() ){
+		Local<Array> pages = Local<Array>::Cast(args[2]);
+		uint32_t i, n = pages->Length();
+		values.resize(n);
+		for(i=0;i<n;i++){
+			if( !js_template_values(*tmpl, pages->Get(i), &values[i], &err) ){
+				Nan::ThrowTypeError(err.c_str());
+				return;
+			}
+		}
+	} else {
+		values.resize(1);
+		if( !js_template_values(*tmpl, args[2], &values[0], &err) ){
+			Nan::ThrowTypeError(err.c_str());
+			return;
+		}
+	}
+	size_t i, n = values.size();
+	std::vector<const TemplateValues *> valuePtrs(n);
+	for(i=0;i<n;i++){
+		valuePtrs[i] = &values[i];
+	}
+	std::wstring jobName;
+	js_job_name(opts, &jobName);
+	JobStats *stats = dc_stats(hdc);
+	GdiDevice device(hdc);
+	StatsDevice statsDevice(&device, stats);
+	TemplateExecutor executor(stats ? (Device *)&statsDevice : &device);
+	executor.setOffset(js_option_number(opts, "dx", 0), js_option_number(opts, "dy", 0));
+	bool ok = executor.runJob(*tmpl, n > 0 ? &valuePtrs[0] : 0, n,
+		(const uint16_t *)jobName.c_str(), (uint32_t)jobName.size());
+	if( stats ){
+		stats->ops += executor.opCount();
+	}
+	if( !ok ){
+		Nan::ThrowTypeError(executor.error().c_str());
+		return;
+	}
+	args.GetReturnValue().Set(Nan::New((double)executor.opCount()));
+}
+
+// Pages of an array of op arrays or of an encoded buffer, for the renderers
+// that run a whole job in one call; pagePtrs points into job or builders.
+static bool js_collect_pages(Local<Value> value, EncodedJob *job, std::vector<PageBuilder> *builders,
+		std::vector<const Page *> *pagePtrs, std::string *err){
+	size_t i, n;
+	if( node::Buffer::HasInstance(value) ){
+		if( !decode_pages(node::Buffer::Data(value), node::Buffer::Length(value), job, err) ){
+			return false;
+		}
+		n = job->pages.size();
+		pagePtrs->resize(n);
+		for(i=0;i<n;i++){
+			(*pagePtrs)[i] = &job->pages[i];
+		}
+		return true;
+	}
+	Local<Array> pages = Local<Array>::Cast(value);
+	n = pages->Length();
+	builders->resize(n);
+	pagePtrs->resize(n);
+	for(i=0;i<n;i++){
+		if( !build_page_from_js((*builders)[i], pages->Get((uint32_t)i), err) ){
+			return false;
+		}
+		(*pagePtrs)[i] = &(*builders)[i].page();
+	}
+	return true;
+}
+
+// Reads { dpi, width, height, dx, dy, bits, format, threads } and the dither
+// options for renderPages.
+static bool js_raster_options(Local<Value> opts, RasterOptions *raster, std::string *err){
+	raster->dpi = (int)js_option_number(opts, "dpi", 300);
+	raster->width = js_option_number(opts, "width", 210);
+	raster->height = js_option_number(opts, "height", 0);
+	raster->dx = js_option_number(opts, "dx", 0);
+	raster->dy = js_option_number(opts, "dy", 0);
+	raster->bits = (int)js_option_number(opts, "bits", 8);
+	unsigned cores = std::thread::hardware_concurrency();
+	raster->threads = (int)js_option_number(opts, "threads", cores > 4 ? 4 : cores > 0 ? cores : 1);
+	if( raster->threads < 1 ){
+		raster->threads = 1;
+	}
+	// dithering stays Bayer unless opts.dither is given
+	bool present;
+	if( !js_mono_options(opts, &raster->mono, &present, err) ){
+		return false;
+	}
+	if( !opts->IsObject() ){
+		return true;
+	}
+	Local<Value> format = opts->ToObject()->Get(Nan::New("format").ToLocalChecked());
+	if( format->IsUndefined() ){
+		return true;
+	}
+	std::string name = *String::Utf8Value(format);
+	if( name == "png" ){
+		raster->format = RASTER_PNG;
+	} else if( name == "pnm" ){
+		raster->format = RASTER_PNM;
+	} else {
+		*err = "unknown format: " + name;
+		return false;
+	}
+	return true;
+}
+
+void renderPages(const Nan::FunctionCallbackInfo<Value>& args){
+	// renderPages(pages, opts?) ==> [Buffer]
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	bool encoded = node::Buffer::HasInstance(args[0]);
+	if( !encoded && !args[0]->IsArray() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	Local<Value> opts = args.Length() >= 2 ? args[1] : Local<Value>(Nan::Undefined());
+	RasterOptions raster;
+	std::string err;
+	if( !js_raster_options(opts, &raster, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	EncodedJob job;
+	std::vector<PageBuilder> builders;
+	std::vector<const Page *> pagePtrs;
+	size_t i;
+	if( !js_collect_pages(args[0], &job, &builders, &pagePtrs, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	size_t n = pagePtrs.size();
+	std::vector<std::vector<uint8_t> > files;
+	if( !render_pages(n > 0 ? &pagePtrs[0] : 0, n, raster, &files, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	Local<Array> result = Nan::New<Array>((int)files.size());
+	for(i=0;i<files.size();i++){
+		result->Set((uint32_t)i, Nan::CopyBuffer((const char *)&files[i][0],
+			(uint32_t)files[i].size()).ToLocalChecked());
+	}
+	args.GetReturnValue().Set(result);
+}
+
+// Reads { dpi, width, height, dx, dy, compress } for renderPdf and writePdf.
+static PdfOptions js_pdf_options(Local<Value> opts){
+	PdfOptions pdf;
+	pdf.dpi = (int)js_option_number(opts, "dpi", 600);
+	pdf.width = js_option_number(opts, "width", 210);
+	pdf.height = js_option_number(opts, "height", 297);
+	pdf.dx = js_option_number(opts, "dx", 0);
+	pdf.dy = js_option_number(opts, "dy", 0);
+	if( opts->IsObject() ){
+		Local<Value> compress = opts->ToObject()->Get(Nan::New("compress").ToLocalChecked());
+		if( !compress->IsUndefined() ){
+			pdf.compress = compress->BooleanValue();
+		}
+	}
+	return pdf;
+}
+
+void renderPdf(const Nan::FunctionCallbackInfo<Value>& args){
+	// renderPdf(pages, opts?) ==> Buffer
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !node::Buffer::HasInstance(args[0]) && !args[0]->IsArray() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	Local<Value> opts = args.Length() >= 2 ? args[1] : Local<Value>(Nan::Undefined());
+	EncodedJob job;
+	std::vector<PageBuilder> builders;
+	std::vector<const Page *> pagePtrs;
+	std::string err;
+	if( !js_collect_pages(args[0], &job, &builders, &pagePtrs, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	std::wstring jobName;
+	js_job_name(opts, &jobName);
+	std::vector<uint8_t> bytes;
+	PdfBufferOutput out(&bytes);
+	if( !render_pdf(pagePtrs.empty() ? 0 : &pagePtrs[0], pagePtrs.size(), js_pdf_options(opts),
+			(const uint16_t *)jobName.c_str(), (uint32_t)jobName.size(), &out, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	args.GetReturnValue().Set(Nan::CopyBuffer((const char *)&bytes[0], (uint32_t)bytes.size()).ToLocalChecked());
+}
+
+void writePdf(const Nan::FunctionCallbackInfo<Value>& args){
+	// writePdf(pages, path, opts?) ==> bytes written
+	if( args.Length() < 2 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( (!node::Buffer::HasInstance(args[0]) && !args[0]->IsArray()) || !args[1]->IsString() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	Local<Value> opts = args.Length() >= 3 ? args[2] : Local<Value>(Nan::Undefined());
+	EncodedJob job;
+	std::vector<PageBuilder> builders;
+	std::vector<const Page *> pagePtrs;
+	std::string err;
+	if( !js_collect_pages(args[0], &job, &builders, &pagePtrs, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	String::Value pdfPath(args[1]);
+	std::wstring path((const wchar_t *)*pdfPath, pdfPath.length());
+	FILE *file = _wfopen(path.c_str(), L"wb");
+	if( file == NULL ){
+		Nan::ThrowTypeError("cannot open pdf file");
+		return;
+	}
+	std::wstring jobName;
+	js_job_name(opts, &jobName);
+	PdfFileOutput out(file);
+	bool ok = render_pdf(pagePtrs.empty() ? 0 : &pagePtrs[0], pagePtrs.size(), js_pdf_options(opts),
+		(const uint16_t *)jobName.c_str(), (uint32_t)jobName.size(), &out, &err);
+	std::string closeErr;
+	if( !out.close(&closeErr) && ok ){
+		ok = false;
+		err = closeErr;
+	}
+	if( !ok ){
+		_wremove(path.c_str());
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	args.GetReturnValue().Set(Nan::New((double)out.bytes()));
+}
+
+// Reads { dpi, width, height, dx, dy, cut, nativeText } and the dither
+// options for escposPages.
+static bool js_escpos_options(Local<Value> opts, EscPosOptions *escpos, std::string *err){
+	escpos->dpi = (int)js_option_number(opts, "dpi", 203);
+	escpos->width = js_option_number(opts, "width", 72);
+	escpos->height = js_option_number(opts, "height", 0);
+	escpos->dx = js_option_number(opts, "dx", 0);
+	escpos->dy = js_option_number(opts, "dy", 0);
+	// dithering stays Bayer unless opts.dither is given
+	bool present;
+	if( !js_mono_options(opts, &escpos->mono, &present, err) ){
+		return false;
+	}
+	if( !opts->IsObject() ){
+		return true;
+	}
+	Local<Value> nativeText = opts->ToObject()->Get(Nan::New("nativeText").ToLocalChecked());
+	if( !nativeText->IsUndefined() ){
+		escpos->nativeText = nativeText->BooleanValue();
+	}
+	Local<Value> cut = opts->ToObject()->Get(Nan::New("cut").ToLocalChecked());
+	if( cut->IsUndefined() ){
+		return true;
+	}
+	std::string name = *String::Utf8Value(cut);
+	if( name == "none" ){
+		escpos->cut = ESCPOS_CUT_NONE;
+	} else if( name == "partial" ){
+		escpos->cut = ESCPOS_CUT_PARTIAL;
+	} else if( name == "full" ){
+		escpos->cut = ESCPOS_CUT_FULL;
+	} else {
+		*err = "unknown cut: " + name;
+		return false;
+	}
+	return true;
+}
+
+void escposPages(const Nan::FunctionCallbackInfo<Value>& args){
+	// escposPages(pages, opts?) ==> Buffer
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !node::Buffer::HasInstance(args[0]) && !args[0]->IsArray() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	Local<Value> opts = args.Length() >= 2 ? args[1] : Local<Value>(Nan::Undefined());
+	EscPosOptions escpos;
+	std::string err;
+	if( !js_escpos_options(opts, &escpos, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	EncodedJob job;
+	std::vector<PageBuilder> builders;
+	std::vector<const Page *> pagePtrs;
+	if( !js_collect_pages(args[0], &job, &builders, &pagePtrs, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	std::vector<uint8_t> bytes;
+	if( !compile_escpos(pagePtrs.empty() ? 0 : &pagePtrs[0], pagePtrs.size(), escpos, &bytes, &err) ){
+		Nan::ThrowTypeError(err.c_str());
+		return;
+	}
+	args.GetReturnValue().Set(Nan::CopyBuffer((const char *)&bytes[0], (uint32_t)bytes.size()).ToLocalChecked());
+}
+
+void writePrinterRaw(const Nan::FunctionCallbackInfo<Value>& args){
+	// writePrinterRaw(printer, buffer, jobName?) ==> bytes written
+	// sends the buffer to the printer as one RAW job, bypassing the driver
+	if( args.Length() < 2 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsString() || !node::Buffer::HasInstance(args[1]) ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	String::Value printerValue(args[0]);
+	std::wstring printer((const wchar_t *)*printerValue, printerValue.length());
+	std::wstring jobName = L"drawer";
+	if( args.Length() >= 3 && args[2]->IsString() ){
+		jobName = (const wchar_t *)*String::Value(args[2]);
+	}
+	HANDLE handle = NULL;
+	if( !OpenPrinterW((LPWSTR)printer.c_str(), &handle, NULL) ){
+		Nan::ThrowTypeError("cannot open printer");
+		return;
+	}
+	DOC_INFO_1W doc;
+	doc.pDocName = (LPWSTR)jobName.c_str();
+	doc.pOutputFile = NULL;
+	doc.pDatatype = (LPWSTR)L"RAW";
+	if( StartDocPrinterW(handle, 1, (LPBYTE)&doc) == 0 ){
+		ClosePrinter(handle);
+		Nan::ThrowTypeError("cannot start raw job");
+		return;
+	}
+	DWORD written = 0;
+	BOOL ok = StartPagePrinter(handle) &&
+		WritePrinter(handle, node::Buffer::Data(args[1]), (DWORD)node::Buffer::Length(args[1]), &written) &&
+		written == (DWORD)node::Buffer::Length(args[1]);
+	EndPagePrinter(handle);
+	EndDocPrinter(handle);
+	ClosePrinter(handle);
+	if( !ok ){
+		Nan::ThrowTypeError("cannot write to printer");
+		return;
+	}
+	args.GetReturnValue().Set(Nan::New((double)written));
+}
+
+// Reads n mm values, or one value to repeat (stride 0), for transform_points.
+static bool js_mm_values(Local<Value> value, uint32_t n, std::vector<double> *out, size_t *stride){
+	uint32_t i;
+	if( value->IsArray() ){
+		Local<Array> array = Local<Array>::Cast(value);
+		if( array->Length() < n ){
+			return false;
+		}
+		out->resize(n + 1);
+		for(i=0;i<n;i++){
+			(*out)[i] = array->Get(i)->NumberValue();
+		}
+		*stride = 1;
+	} else {
+		out->assign(1, value->NumberValue());
+		*stride = 0;
+	}
+	return true;
+}
+
+// [a, b, c, d, e, f] with e and f in 0.1 um units, as printer.js keeps it
+static bool js_transform(Local<Value> value, Transform *t){
+	if( value->IsUndefined() ){
+		*t = transform_identity();
+		return true;
+	}
+	if( !value->IsArray() || Local<Array>::Cast(value)->Length() != 6 ){
+		return false;
+	}
+	Local<Array> array = Local<Array>::Cast(value);
+	t->a = array->Get(0)->NumberValue();
+	t->b = array->Get(1)->NumberValue();
+	t->c = array->Get(2)->NumberValue();
+	t->d = array->Get(3)->NumberValue();
+	t->e = (int64_t)array->Get(4)->NumberValue();
+	t->f = (int64_t)array->Get(5)->NumberValue();
+	return true;
+}
+
+void drawGlyphRun(const Nan::FunctionCallbackInfo<Value>& args){
+	// drawGlyphRun(hdc, text, xs, ys, transform?) ==> number of ExtTextOutW calls
+	// xs, ys: mm, one per character or a single number
+	if( args.Length() < 4 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsInt32() || !args[1]->IsString() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	HDC hdc = (HDC)args[0]->Int32Value();
+	String::Value text(args[1]);
+	uint32_t i, n = text.length();
+	std::vector<double> mmXs, mmYs;
+	size_t xstride, ystride;
+	Transform transform;
+	PrinterCaps caps = dc_caps(hdc);
+	if( !js_mm_values(args[2], n, &mmXs, &xstride) ){
+		Nan::ThrowTypeError("invalid x to drawGlyphRun");
+		return;
+	}
+	if( !js_mm_values(args[3], n, &mmYs, &ystride) ){
+		Nan::ThrowTypeError("invalid y to drawGlyphRun");
+		return;
+	}
+	if( !js_transform(args[4], &transform) ){
+		Nan::ThrowTypeError("invalid transform to drawGlyphRun");
+		return;
+	}
+	std::vector<long> xs(n + 1), ys(n + 1);
+	i = (uint32_t)transform_points(transform, caps.dpix, caps.dpiy, &mmXs[0], xstride,
+		&mmYs[0], ystride, n, &xs[0], &ys[0]);
+	if( i < n ){
+		Nan::ThrowTypeError(isnan(mmXs[i * xstride]) ? "invalid x to drawGlyphRun" : "invalid y to drawGlyphRun");
+		return;
+	}
+	if( n == 0 ){
+		args.GetReturnValue().Set(0);
+		return;
+	}
+	std::vector<int> advances(n);
+	std::vector<GlyphRun> runs;
+	build_glyph_runs(&xs[0], &ys[0], n, &advances[0], &runs);
+	for(i=0;i<runs.size();i++){
+		BOOL ok = ExtTextOutW(hdc, runs[i].x, runs[i].y, 0, NULL,
+			((LPCWSTR)*text) + runs[i].start, runs[i].count, &advances[runs[i].start]);
+		if( !ok ){
+			Nan::ThrowTypeError("ExtTextOutW failed");
+			return;
+		}
+	}
+	args.GetReturnValue().Set((int)runs.size());
+}
+
+// Sets devmode to have the driver make the copies, if DeviceCapabilities
+// says it makes that many (and collates them, if asked to).
+static bool devmode_set_copies(const std::wstring &printer, DEVMODEW *devmode, int copies, bool collate){
+	if( DeviceCapabilitiesW(printer.c_str(), NULL, DC_COPIES, NULL, devmode) < copies ){
+		return false;
+	}
+	if( collate && DeviceCapabilitiesW(printer.c_str(), NULL, DC_COLLATE, NULL, devmode) != 1 ){
+		return false;
+	}
+	devmode->dmCopies = (short)copies;
+	devmode->dmCollate = collate ? DMCOLLATE_TRUE : DMCOLLATE_FALSE;
+	devmode->dmFields |= DM_COPIES | DM_COLLATE;
+	return true;
+}
+
+void devmodeWithCopies(const Nan::FunctionCallbackInfo<Value>& args){
+	// devmodeWithCopies(printer, devmode, copies, collate?) ==> devmode | null
+	if( args.Length() < 3 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsString() || !node::Buffer::HasInstance(args[1]) || !args[2]->IsNumber() ||
+			node::Buffer::Length(args[1]) < sizeof(DEVMODEW) ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	String::Value printerValue(args[0]);
+	std::wstring printer((const wchar_t *)*printerValue, printerValue.length());
+	bool collate = args.Length() < 4 || args[3]->IsUndefined() || args[3]->BooleanValue();
+	std::vector<char> devmode(node::Buffer::Data(args[1]),
+		node::Buffer::Data(args[1]) + node::Buffer::Length(args[1]));
+	if( !devmode_set_copies(printer, (DEVMODEW *)&devmode[0], args[2]->Int32Value(), collate) ){
+		args.GetReturnValue().SetNull();
+		return;
+	}
+	args.GetReturnValue().Set(Nan::CopyBuffer(&devmode[0], (uint32_t)devmode.size()).ToLocalChecked());
+}
+
+// Gets a printer DC for copies of a setting's devmode and devnames from the
+// DC pool (see acquireDc), on the thread that runs the print job. Without
+// devnames the printer is given by name.
+class GdiDeviceSource : public DeviceSource {
+public:
+	GdiDeviceSource(const char *devmode, size_t devmodeLength,
+			const char *devnames, size_t devnamesLength)
+		: devmode_(devmode, devmode + devmodeLength),
+		devnames_(devnames, devnames + devnamesLength) {}
+
+	GdiDeviceSource(const std::wstring &printer, const char *devmode, size_t devmodeLength)
+		: devmode_(devmode, devmode + devmodeLength), printer_(printer) {}
+
+	// The job's devmode is a copy, so the setting's is left alone.
+	bool setCopies(int copies, bool collate){
+		if( devmode_.size() < sizeof(DEVMODEW) ){
+			return false;
+		}
+		return devmode_set_copies(printerName(), (DEVMODEW *)&devmode_[0], copies, collate);
+	}
+
+	Device *open(std::string *err){
+		std::wstring printer = printerName();
+		HDC hdc = (HDC)gdi_dc_pool()->acquire(
+			utf16_to_utf8((const uint16_t *)printer.c_str(), (uint32_t)printer.size()),
+			devmode_.empty() ? NULL : &devmode_[0], devmode_.size(), err);
+		if( hdc == NULL ){
+			return 0;
+		}
+		gdi_caps_cache()->bindDc((DeviceHandle)hdc, utf16_to_utf8((const uint16_t *)printer.c_str(),
+			(uint32_t)printer.size()), devmode_.empty() ? NULL : &devmode_[0], devmode_.size());
+		return new GdiDevice(hdc);
+	}
+
+	// A DC from a failed or canceled job is deleted, not pooled.
+	void close(Device *device, bool failed){
+		GdiDevice *gdi = (GdiDevice *)device;
+		gdi_caps_cache()->unbindDc((DeviceHandle)gdi->hdc());
+		gdi_dc_pool()->release((DeviceHandle)gdi->hdc(), failed);
+		delete gdi;
+	}
+
+private:
+	std::wstring printerName() const {
+		if( devnames_.empty() ){
+			return printer_;
+		}
+		WCHAR *driver, *device, *output;
+		parse_devnames((DEVNAMES *)&devnames_[0], &driver, &device, &output);
+		return device;
+	}
+
+	std::vector<char> devmode_;
+	std::vector<char> devnames_;
+	std::wstring printer_;
+};
+
+static std::map<int, PrintJob *> runningJobs;
+
+// { jobId, status, error?, pages, ops, elapsed }
+static Local<Object> job_result(int jobId, PrintJob *job){
+	Local<Object> result = Nan::New<Object>();
+	result->Set(Nan::New("jobId").ToLocalChecked(), Nan::New(jobId));
+	result->Set(Nan::New("status").ToLocalChecked(),
+		Nan::New(print_job_status_name(job->status())).ToLocalChecked());
+	if( job->status() != JOB_DONE ){
+		result->Set(Nan::New("error").ToLocalChecked(),
+			Nan::New(job->error().c_str()).ToLocalChecked());
+	}
+	result->Set(Nan::New("pages").ToLocalChecked(), Nan::New((double)job->pageCount()));
+	result->Set(Nan::New("ops").ToLocalChecked(), Nan::New((double)job->opCount()));
+	result->Set(Nan::New("elapsed").ToLocalChecked(), Nan::New(job->elapsed()));
+	return result;
+}
+
+// Fills job with pages (an array of pages or an encoded buffer) and opts
+// { jobName, dx, dy, copies, collate }. Throws and returns false on invalid
+// pages.
+static bool js_setup_job(PrintJob *job, Local<Value> pagesValue, Local<Value> opts){
+	std::string err;
+	if( node::Buffer::HasInstance(pagesValue) ){
+		if( !job->setEncodedPages(node::Buffer::Data(pagesValue), node::Buffer::Length(pagesValue), &err) ){
+			Nan::ThrowTypeError(err.c_str());
+			return false;
+		}
+	} else {
+		Local<Array> pages = Local<Array>::Cast(pagesValue);
+		uint32_t i, n = pages->Length();
+		for(i=0;i<n;i++){
+			if( !build_page_from_js(job->addPage(), pages->Get(i), &err) ){
+				Nan::ThrowTypeError(err.c_str());
+				return false;
+			}
+		}
+	}
+	std::wstring jobName;
+	js_job_name(opts, &jobName);
+	job->setJobName((const uint16_t *)jobName.c_str(), (uint32_t)jobName.size());
+	job->setOffset(js_option_number(opts, "dx", 0), js_option_number(opts, "dy", 0));
+	job->setCopies((int)js_option_number(opts, "copies", 1), js_option_bool(opts, "collate", true));
+	job->setOptimize(js_option_bool(opts, "optimize", true));
+	return true;
+}
+
+class PrintWorker : public Nan::AsyncWorker {
+public:
+	PrintWorker(Nan::Callback *callback, PrintJob *job, int jobId)
+		: Nan::AsyncWorker(callback), job_(job), jobId_(jobId) {}
+
+	~PrintWorker(){
+		delete job_;
+	}
+
+	void Execute(){
+		job_->run();
+	}
+
+	void HandleOKCallback(){
+		Nan::HandleScope scope;
+		runningJobs.erase(jobId_);
+		if( job_->stats() ){
+			job_stats_complete(*job_->stats());
+		}
+		Local<Value> argv[] = { job_result(jobId_, job_) };
+		callback->Call(1, argv);
+	}
+
+private:
+	PrintJob *job_;
+	int jobId_;
+};
+
+void printJobAsync(const Nan::FunctionCallbackInfo<Value>& args){
+	// printJobAsync(devmode, devnames, pages, opts, callback) ==> jobId
+	if( args.Length() < 5 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !node::Buffer::HasInstance(args[0]) || !node::Buffer::HasInstance(args[1]) ||
+			!(args[2]->IsArray() || node::Buffer::HasInstance(args[2])) || !args[4]->IsFunction() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	PrintJob *job = new PrintJob(new GdiDeviceSource(
+		node::Buffer::Data(args[0]), node::Buffer::Length(args[0]),
+		node::Buffer::Data(args[1]), node::Buffer::Length(args[1])));
+	if( !js_setup_job(job, args[2], args[3]) ){
+		delete job;
+		return;
+	}
+	int jobId = nextJobId++;
+	if( jobStats.enabled() ){
+		WCHAR *driver, *device, *output;
+		parse_devnames((DEVNAMES *)node::Buffer::Data(args[1]), &driver, &device, &output);
+		job->enableStats(utf16_to_utf8((const uint16_t *)device, (uint32_t)wcslen(device)), jobId);
+	}
+	runningJobs[jobId] = job;
+	Nan::Callback *callback = new Nan::Callback(args[4].As<Function>());
+	Nan::AsyncQueueWorker(new PrintWorker(callback, job, jobId));
+	args.GetReturnValue().Set(Nan::New(jobId));
+}
+
+// Hands jobs finished by the spooler's worker threads to the main thread,
+// where their callbacks are called. The async handle only keeps the event
+// loop alive while spooled jobs are pending.
+class JsSpoolerListener : public SpoolerListener {
+public:
+	JsSpoolerListener(){
+		uv_async_init(uv_default_loop(), &async_, deliver);
+		async_.data = this;
+		uv_unref((uv_handle_t *)&async_);
+	}
+
+	void jobFinished(long jobId, PrintJob *job){
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			finished_.push_back(std::make_pair(jobId, job));
+		}
+		uv_async_send(&async_);
+	}
+
+	void addCallback(long jobId, Nan::Callback *callback){
+		if( callbacks_.empty() ){
+			uv_ref((uv_handle_t *)&async_);
+		}
+		callbacks_[jobId] = callback;
+	}
+
+private:
+	static void deliver(uv_async_t *handle){
+		((JsSpoolerListener *)handle->data)->deliverFinished();
+	}
+
+	void deliverFinished(){
+		Nan::HandleScope scope;
+		std::vector<std::pair<long, PrintJob *> > finished;
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			finished.swap(finished_);
+		}
+		size_t i;
+		for(i=0;i<finished.size();i++){
+			long jobId = finished[i].first;
+			PrintJob *job = finished[i].second;
+			if( job->stats() ){
+				job_stats_complete(*job->stats());
+			}
+			std::map<long, Nan::Callback *>::iterator iter = callbacks_.find(jobId);
+			if( iter != callbacks_.end() ){
+				Nan::Callback *callback = iter->second;
+				callbacks_.erase(iter);
+				Local<Value> argv[] = { job_result((int)jobId, job) };
+				callback->Call(1, argv);
+				delete callback;
+			}
+			delete job;
+		}
+		if( callbacks_.empty() ){
+			uv_unref((uv_handle_t *)&async_);
+		}
+	}
+
+	uv_async_t async_;
+	std::mutex mutex_;
+	std::vector<std::pair<long, PrintJob *> > finished_;
+	// main thread only
+	std::map<long, Nan::Callback *> callbacks_;
+};
+
+static JsSpoolerListener *spoolerListener = NULL;
+static Spooler *spooler = NULL;
+
+// Created on first use and never destroyed: a printer driver that hangs must
+// not keep the process from exiting.
+static Spooler *get_spooler(){
+	if( !spooler ){
+		spoolerListener = new JsSpoolerListener();
+		spooler = new Spooler(spoolerListener, 32);
+	}
+	return spooler;
+}
+
+void spoolJob(const Nan::FunctionCallbackInfo<Value>& args){
+	// spoolJob(printer, devmode?, devnames?, pages, opts, callback) ==> jobId
+	// opts: { priority, jobName, dx, dy }; throws "queue full" if the printer
+	// already has the maximum number of jobs waiting.
+	if( args.Length() < 6 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsString() ||
+			!(node::Buffer::HasInstance(args[1]) || args[1]->IsNull() || args[1]->IsUndefined()) ||
+			!(node::Buffer::HasInstance(args[2]) || args[2]->IsNull() || args[2]->IsUndefined()) ||
+			!(args[3]->IsArray() || node::Buffer::HasInstance(args[3])) || !args[5]->IsFunction() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	String::Value printerValue(args[0]);
+	std::wstring printer((const wchar_t *)*printerValue, printerValue.length());
+	const char *devmode = NULL, *devnames = NULL;
+	size_t devmodeLength = 0, devnamesLength = 0;
+	if( node::Buffer::HasInstance(args[1]) ){
+		devmode = node::Buffer::Data(args[1]);
+		devmodeLength = node::Buffer::Length(args[1]);
+	}
+	if( node::Buffer::HasInstance(args[2]) ){
+		devnames = node::Buffer::Data(args[2]);
+		devnamesLength = node::Buffer::Length(args[2]);
+	}
+	PrintJob *job = new PrintJob(devnames ?
+		new GdiDeviceSource(devmode, devmodeLength, devnames, devnamesLength) :
+		new GdiDeviceSource(printer, devmode, devmodeLength));
+	if( !js_setup_job(job, args[3], args[4]) ){
+		delete job;
+		return;
+	}
+	int priority = (int)js_option_number(args[4], "priority", 0);
+	int jobId = nextJobId++;
+	std::string name = utf16_to_utf8((const uint16_t *)*printerValue, printerValue.length());
+	if( jobStats.enabled() ){
+		job->enableStats(name, jobId);
+	}
+	std::string err;
+	Spooler *s = get_spooler();
+	if( !s->submit(name, jobId, job, priority, &err) ){
+		delete job;
+		Nan::ThrowError(err.c_str());
+		return;
+	}
+	spoolerListener->addCallback(jobId, new Nan::Callback(args[5].As<Function>()));
+	args.GetReturnValue().Set(Nan::New(jobId));
+}
+
+void spoolerStatus(const Nan::FunctionCallbackInfo<Value>& args){
+	// spoolerStatus() ==> [{ printer, queued, busy, runningJob, done, failed, canceled, consecutiveFailures }]
+	std::vector<SpoolerDeviceStatus> status;
+	if( spooler ){
+		status = spooler->status();
+	}
+	Local<Array> result = Nan::New<Array>((int)status.size());
+	size_t i;
+	for(i=0;i<status.size();i++){
+		Local<Object> obj = Nan::New<Object>();
+		obj->Set(Nan::New("printer").ToLocalChecked(), Nan::New(status[i].name.c_str()).ToLocalChecked());
+		obj->Set(Nan::New("queued").ToLocalChecked(), Nan::New((double)status[i].queued));
+		obj->Set(Nan::New("busy").ToLocalChecked(), Nan::New(status[i].busy));
+		obj->Set(Nan::New("runningJob").ToLocalChecked(), Nan::New((double)status[i].runningJob));
+		obj->Set(Nan::New("done").ToLocalChecked(), Nan::New((double)status[i].done));
+		obj->Set(Nan::New("failed").ToLocalChecked(), Nan::New((double)status[i].failed));
+		obj->Set(Nan::New("canceled").ToLocalChecked(), Nan::New((double)status[i].canceled));
+		obj->Set(Nan::New("consecutiveFailures").ToLocalChecked(),
+			Nan::New((double)status[i].consecutiveFailures));
+		result->Set((uint32_t)i, obj);
+	}
+	args.GetReturnValue().Set(result);
+}
+
+void setSpoolerQueueLimit(const Nan::FunctionCallbackInfo<Value>& args){
+	// setSpoolerQueueLimit(n): maximum number of jobs waiting per printer
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsInt32() || args[0]->Int32Value() < 1 ){
+		Nan::ThrowTypeError("wrong argument");
+		return;
+	}
+	get_spooler()->setQueueLimit((size_t)args[0]->Int32Value());
+}
+
+void cancelPrintJob(const Nan::FunctionCallbackInfo<Value>& args){
+	// cancelPrintJob(jobId) ==> bool (false if the job already finished)
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	if( !args[0]->IsInt32() ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	int jobId = args[0]->Int32Value();
+	std::map<int, PrintJob *>::iterator iter = runningJobs.find(jobId);
+	if( iter == runningJobs.end() ){
+		args.GetReturnValue().Set(spooler != NULL && spooler->cancel(jobId));
+		return;
+	}
+	iter->second->cancel();
+	args.GetReturnValue().Set(true);
+}
+
+static Nan::Callback *jobCompleteCallback = NULL;
+
+// { open, startDoc, render, endPage, endDoc, close, total } in microseconds,
+// for the phases the job went through
+static Local<Object> js_job_phases(const JobStats &stats){
+	Local<Object> phases = Nan::New<Object>();
+	int i;
+	for(i=0;i<PHASE_COUNT;i++){
+		if( stats.phases[i] >= 0 ){
+			phases->Set(Nan::New(job_phase_name(i)).ToLocalChecked(), Nan::New((double)stats.phases[i]));
+		}
+	}
+	return phases;
+}
+
+// Adds a finished job to the per printer stats and passes it to the
+// onJobComplete callback. Main thread only.
+static void job_stats_complete(const JobStats &stats){
+	jobStats.add(stats);
+	if( !jobCompleteCallback ){
+		return;
+	}
+	Nan::HandleScope scope;
+	Local<Object> job = Nan::New<Object>();
+	job->Set(Nan::New("printer").ToLocalChecked(), Nan::New(stats.printer.c_str()).ToLocalChecked());
+	job->Set(Nan::New("jobId").ToLocalChecked(), Nan::New((double)stats.jobId));
+	job->Set(Nan::New("status").ToLocalChecked(), Nan::New(stats.status.c_str()).ToLocalChecked());
+	job->Set(Nan::New("pages").ToLocalChecked(), Nan::New((double)stats.pages));
+	job->Set(Nan::New("ops").ToLocalChecked(), Nan::New((double)stats.ops));
+	job->Set(Nan::New("gdiCalls").ToLocalChecked(), Nan::New((double)stats.gdiCalls));
+	job->Set(Nan::New("textRuns").ToLocalChecked(), Nan::New((double)stats.textRuns));
+	job->Set(Nan::New("imageBytes").ToLocalChecked(), Nan::New((double)stats.imageBytes));
+	job->Set(Nan::New("objectsCreated").ToLocalChecked(), Nan::New((double)stats.objectsCreated));
+	job->Set(Nan::New("objectsDeleted").ToLocalChecked(), Nan::New((double)stats.objectsDeleted));
+	job->Set(Nan::New("phases").ToLocalChecked(), js_job_phases(stats));
+	Local<Value> argv[] = { job };
+	jobCompleteCallback->Call(1, argv);
+}
+
+void setStatsEnabled(const Nan::FunctionCallbackInfo<Value>& args){
+	// setStatsEnabled(bool): times and counts the jobs that start from now on
+	if( args.Length() < 1 ){
+		Nan::ThrowTypeError("wrong number of arguments");
+		return;
+	}
+	jobStats.setEnabled(args[0]->BooleanValue());
+}
+
+void getStats(const Nan::FunctionCallbackInfo<Value>& args){
+	// getStats() ==> [{ printer, jobs, failed, pages, gdiCalls, textRuns, imageBytes,
+	//   objectsCreated, objectsDeleted, phases: { open: { count, min, mean, p50, p90, p99, max }, ... } }]
+	std::vector<PrinterStats> printers = jobStats.printers();
+	Local<Array> result = Nan::New<Array>((int)printers.size());
+	size_t i;
+	int j;
+	for(i=0;i<printers.size();i++){
+		const PrinterStats &p = printers[i];
+		Local<Object> obj = Nan::New<Object>();
+		obj->Set(Nan::New("printer").ToLocalChecked(), Nan::New(p.name.c_str()).ToLocalChecked());
+		obj->Set(Nan::New("jobs").ToLocalChecked(), Nan::New((double)p.jobs));
+		obj->Set(Nan::New("failed").ToLocalChecked(), Nan::New((double)p.failed));
+		obj->Set(Nan::New("pages").ToLocalChecked(), Nan::New((double)p.pages));
+		obj->Set(Nan::New("gdiCalls").ToLocalChecked(), Nan::New((double)p.gdiCalls));
+		obj->Set(Nan::New("textRuns").ToLocalChecked(), Nan::New((double)p.textRuns));
+		obj->Set(Nan::New("imageBytes").ToLocalChecked(), Nan::New((double)p.imageBytes));
+		obj->Set(Nan::New("objectsCreated").ToLocalChecked(), Nan::New((double)p.objectsCreated));
+		obj->Set(Nan::New("objectsDeleted").ToLocalChecked(), Nan::New((double)p.objectsDeleted));
+		Local<Object> phases = Nan::New<Object>();
+		for(j=0;j<PHASE_COUNT;j++){
+			const LatencyHistogram &h = p.phases[j];
+			if( h.count() == 0 ){
+				continue;
+			}
+			Local<Object> phase = Nan::New<Object>();
+			phase->Set(Nan::New("count").ToLocalChecked(), Nan::New((double)h.count()));
+			phase->Set(Nan::New("min").ToLocalChecked(), Nan::New((double)h.min()));
+			phase->Set(Nan::New("mean").ToLocalChecked(), Nan::New(h.mean()));
+			phase->Set(Nan::New("p50").ToLocalChecked(), Nan::New((double)h.percentile(50)));
+			phase->Set(Nan::New("p90").ToLocalChecked(), Nan::New((double)h.percentile(90)));
+			phase->Set(Nan::New("p99").ToLocalChecked(), Nan::New((double)h.percentile(99)));
+			phase->Set(Nan::New("max").ToLocalChecked(), Nan::New((double)h.max()));
+			phases->Set(Nan::New(job_phase_name(j)).ToLocalChecked(), phase);
+		}
+		obj->Set(Nan::New("phases").ToLocalChecked(), phases);
+		result->Set((uint32_t)i, obj);
+	}
+	args.GetReturnValue().Set(result);
+}
+
+void onJobComplete(const Nan::FunctionCallbackInfo<Value>& args){
+	// onJobComplete(cb | null): cb gets { printer, jobId, status, pages, ops, gdiCalls,
+	//   textRuns, imageBytes, objectsCreated, objectsDeleted, phases: { open: us, ... } }
+	if( args.Length() < 1 || !(args[0]->IsFunction() || args[0]->IsNull() || args[0]->IsUndefined()) ){
+		Nan::ThrowTypeError("wrong arguments");
+		return;
+	}
+	delete jobCompleteCallback;
+	jobCompleteCallback = args[0]->IsFunction() ? new Nan::Callback(args[0].As<Function>()) : NULL;
+}
+
+void statsTrace(const Nan::FunctionCallbackInfo<Value>& args){
+	// statsTrace() ==> Chrome trace event JSON of the last 64 jobs
+	std::string trace = jobStats.traceJson();
+	args.GetReturnValue().Set(Nan::New(trace.c_str()).ToLocalChecked());
+}
+
+void resetStats(const Nan::FunctionCallbackInfo<Value>& args){
+	// resetStats()
+	jobStats.clear();
+}
+
 void getLastError(const Nan::FunctionCallbackInfo<Value>& args) {
     int ret = GetLastError();
     args.GetReturnValue().Set(ret);
@@ -883,10 +3194,20 @@ void Init(v8::Local<v8::Object> exports){
 			Nan::New<v8::FunctionTemplate>(releaseDc)->GetFunction());
 	exports->Set(Nan::New("measureText").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(measureText)->GetFunction());
+	exports->Set(Nan::New("measureTextBatch").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(measureTextBatch)->GetFunction());
+	exports->Set(Nan::New("layoutText").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(layoutText)->GetFunction());
 	exports->Set(Nan::New("createFont").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(createFont)->GetFunction());
 	exports->Set(Nan::New("deleteObject").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(deleteObject)->GetFunction());
+	exports->Set(Nan::New("objectCacheStats").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(objectCacheStats)->GetFunction());
+	exports->Set(Nan::New("setObjectCacheCapacity").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(setObjectCacheCapacity)->GetFunction());
+	exports->Set(Nan::New("purgeObjectCache").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(purgeObjectCache)->GetFunction());
 	exports->Set(Nan::New("getDpiOfHdc").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(getDpiOfHdc)->GetFunction());
 	exports->Set(Nan::New("printerDialog").ToLocalChecked(),
@@ -895,8 +3216,28 @@ void Init(v8::Local<v8::Object> exports){
 			Nan::New<v8::FunctionTemplate>(parseDevmode)->GetFunction());
 	exports->Set(Nan::New("parseDevnames").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(parseDevnames)->GetFunction());
+	exports->Set(Nan::New("devmodeWithCopies").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(devmodeWithCopies)->GetFunction());
 	exports->Set(Nan::New("createDc").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(createDc)->GetFunction());
+	exports->Set(Nan::New("acquireDc").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(acquireDc)->GetFunction());
+	exports->Set(Nan::New("releasePooledDc").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(releasePooledDc)->GetFunction());
+	exports->Set(Nan::New("dcPoolStats").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(dcPoolStats)->GetFunction());
+	exports->Set(Nan::New("getPrinterCaps").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(getPrinterCaps)->GetFunction());
+	exports->Set(Nan::New("getDcCaps").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(getDcCaps)->GetFunction());
+	exports->Set(Nan::New("invalidatePrinterCaps").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(invalidatePrinterCaps)->GetFunction());
+	exports->Set(Nan::New("printerCapsStats").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(printerCapsStats)->GetFunction());
+	exports->Set(Nan::New("setDcPoolOptions").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(setDcPoolOptions)->GetFunction());
+	exports->Set(Nan::New("purgeDcPool").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(purgeDcPool)->GetFunction());
 	// Nam.Tran
 	exports->Set(Nan::New("createDcWithoutDialog").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(createDcWithoutDialog)->GetFunction());
@@ -917,13 +3258,23 @@ void Init(v8::Local<v8::Object> exports){
 			Nan::New<v8::FunctionTemplate>(moveTo)->GetFunction());
 	exports->Set(Nan::New("lineTo").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(lineTo)->GetFunction());
+	exports->Set(Nan::New("polyPolyline").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(polyPolyline)->GetFunction());
+	exports->Set(Nan::New("fillRect").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(fillRect)->GetFunction());
 	exports->Set(Nan::New("textOut").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(textOut)->GetFunction());
+	exports->Set(Nan::New("drawGlyphRun").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(drawGlyphRun)->GetFunction());
 	// Nam.Tran
 	exports->Set(Nan::New("printImage").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(printImage)->GetFunction());
 	exports->Set(Nan::New("printImageFromBytes").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(printImageFromBytes)->GetFunction());
+	exports->Set(Nan::New("monochromeBmp").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(monochromeBmp)->GetFunction());
+	exports->Set(Nan::New("imageKernels").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(imageKernels)->GetFunction());
 	// End Nam.Tran
 	// cuongnm
 	exports->Set(Nan::New("getLastError").ToLocalChecked(),
@@ -937,6 +3288,48 @@ void Init(v8::Local<v8::Object> exports){
 			Nan::New<v8::FunctionTemplate>(createPen)->GetFunction());
 	exports->Set(Nan::New("setBkMode").ToLocalChecked(),
 			Nan::New<v8::FunctionTemplate>(setBkMode)->GetFunction());
+	exports->Set(Nan::New("drawPage").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(drawPage)->GetFunction());
+	exports->Set(Nan::New("drawPages").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(drawPages)->GetFunction());
+	exports->Set(Nan::New("drawEncodedPages").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(drawEncodedPages)->GetFunction());
+	exports->Set(Nan::New("compileTemplate").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(compileTemplate)->GetFunction());
+	exports->Set(Nan::New("drawTemplate").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(drawTemplate)->GetFunction());
+	exports->Set(Nan::New("deleteTemplate").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(deleteTemplate)->GetFunction());
+	exports->Set(Nan::New("renderPages").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(renderPages)->GetFunction());
+	exports->Set(Nan::New("renderPdf").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(renderPdf)->GetFunction());
+	exports->Set(Nan::New("writePdf").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(writePdf)->GetFunction());
+	exports->Set(Nan::New("escposPages").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(escposPages)->GetFunction());
+	exports->Set(Nan::New("writePrinterRaw").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(writePrinterRaw)->GetFunction());
+	exports->Set(Nan::New("setStatsEnabled").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(setStatsEnabled)->GetFunction());
+	exports->Set(Nan::New("getStats").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(getStats)->GetFunction());
+	exports->Set(Nan::New("onJobComplete").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(onJobComplete)->GetFunction());
+	exports->Set(Nan::New("statsTrace").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(statsTrace)->GetFunction());
+	exports->Set(Nan::New("resetStats").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(resetStats)->GetFunction());
+	exports->Set(Nan::New("printJobAsync").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(printJobAsync)->GetFunction());
+	exports->Set(Nan::New("cancelPrintJob").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(cancelPrintJob)->GetFunction());
+	exports->Set(Nan::New("spoolJob").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(spoolJob)->GetFunction());
+	exports->Set(Nan::New("spoolerStatus").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(spoolerStatus)->GetFunction());
+	exports->Set(Nan::New("setSpoolerQueueLimit").ToLocalChecked(),
+			Nan::New<v8::FunctionTemplate>(setSpoolerQueueLimit)->GetFunction());
 	exports->Set(Nan::New("bkModeOpaque").ToLocalChecked(), Nan::New(OPAQUE));
 	exports->Set(Nan::New("bkModeTransparent").ToLocalChecked(), Nan::New(TRANSPARENT));
 	exports->Set(Nan::New("FW_DONTCARE").ToLocalChecked(), Nan::New(FW_DONTCARE));
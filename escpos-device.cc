@@ -0,0 +1,505 @@
+#include "escpos-device.h"
+#include "page-executor.h"
+#include <algorithm>
+#include <string.h>
+
+// rows of one GS v 0 image
+static const long RASTER_ROWS = 128;
+
+// cell width and height of the printer fonts A and B
+static const int fontWidth[2] = { 12, 9 };
+static const int fontHeight[2] = { 24, 17 };
+
+EscPosDevice::EscPosDevice(const EscPosOptions &opts) : raster_(opts.dpi, opts.dpi) {
+	opts_ = opts;
+	widthDots_ = mm_to_pixel(opts.dpi, opts.width);
+	x_ = 0;
+	y_ = 0;
+	fontSize_ = 0;
+	fontBold_ = false;
+	penWidth_ = 0;
+	position_ = 0;
+	pendingFeed_ = 0;
+	lineOpen_ = false;
+	font_ = 0;
+	scale_ = 1;
+	bold_ = 0;
+	spacing_ = 0;
+	textBands_ = 0;
+	rasterBands_ = 0;
+}
+
+void EscPosDevice::put(const uint8_t *data, size_t length){
+	out_.insert(out_.end(), data, data + length);
+}
+
+bool EscPosDevice::startDoc(const uint16_t *jobName, uint32_t length){
+	// ESC @ resets the printer to font A, no scaling, no bold and no spacing
+	static const uint8_t init[] = { 0x1b, '@' };
+	out_.clear();
+	put(init, sizeof(init));
+	if( opts_.dpi <= 255 ){
+		// GS P: motion units of one dot for ESC $, ESC SP and ESC J
+		uint8_t units[] = { 0x1d, 'P', (uint8_t)opts_.dpi, (uint8_t)opts_.dpi };
+		put(units, sizeof(units));
+	}
+	font_ = 0;
+	scale_ = 1;
+	bold_ = 0;
+	spacing_ = 0;
+	return true;
+}
+
+bool EscPosDevice::abortDoc(){
+	out_.clear();
+	return true;
+}
+
+bool EscPosDevice::startPage(){
+	raster_.startPage();
+	items_.clear();
+	runs_.clear();
+	chars_.clear();
+	x_ = 0;
+	y_ = 0;
+	position_ = 0;
+	pendingFeed_ = 0;
+	lineOpen_ = false;
+	textBands_ = 0;
+	rasterBands_ = 0;
+	return true;
+}
+
+void EscPosDevice::addItem(long top, long bottom, long run){
+	Item item;
+	item.top = top < 0 ? 0 : top;
+	item.bottom = bottom;
+	item.run = run;
+	if( item.bottom > item.top ){
+		items_.push_back(item);
+	}
+}
+
+bool EscPosDevice::moveTo(long x, long y){
+	x_ = x;
+	y_ = y;
+	return raster_.moveTo(x, y);
+}
+
+bool EscPosDevice::lineTo(long x, long y){
+	long radius = penWidth_ / 2 + 1;
+	addItem((y < y_ ? y : y_) - radius, (y > y_ ? y : y_) + radius + 1, -1);
+	x_ = x;
+	y_ = y;
+	return raster_.lineTo(x, y);
+}
+
+bool EscPosDevice::fillRect(long left, long top, long right, long bottom, int r, int g, int b){
+	addItem(top, bottom, -1);
+	return raster_.fillRect(left, top, right, bottom, r, g, b);
+}
+
+// Fills run when the text can be printed in a printer font: ASCII only, a
+// font size within a quarter of a scaled font A or B, and a pitch (-1: the
+// font's own) not narrower than the font.
+bool EscPosDevice::nativeRun(long x, long y, const uint16_t *text, uint32_t length,
+		long pitch, Run *run){
+	uint32_t i;
+	if( !opts_.nativeText || x < 0 || y < 0 || fontSize_ <= 0 ){
+		return false;
+	}
+	for(i=0;i<length;i++){
+		if( text[i] < 0x20 || text[i] > 0x7e ){
+			return false;
+		}
+	}
+	long bestError = fontSize_ / 4 + 1;
+	int font, scale;
+	run->scale = 0;
+	for(font=0;font<2;font++){
+		for(scale=1;scale<=8;scale++){
+			long error = fontSize_ - (long)fontHeight[font] * scale;
+			long spacing = pitch >= 0 ? pitch - (long)fontWidth[font] * scale : 0;
+			if( error < 0 ){
+				error = -error;
+			}
+			if( error < bestError && spacing >= 0 && spacing <= 255 ){
+				bestError = error;
+				run->font = font;
+				run->scale = scale;
+				run->spacing = (int)spacing;
+			}
+		}
+	}
+	if( run->scale == 0 ){
+		return false;
+	}
+	run->x = x;
+	run->y = y;
+	run->bold = fontBold_;
+	run->width = (long)length * fontWidth[run->font] * run->scale +
+		(long)(length - 1) * run->spacing;
+	if( x + run->width > widthDots_ ){
+		return false;
+	}
+	run->offset = (uint32_t)chars_.size();
+	run->length = length;
+	for(i=0;i<length;i++){
+		chars_.push_back((uint8_t)text[i]);
+	}
+	return true;
+}
+
+bool EscPosDevice::textOut(long x, long y, const uint16_t *text, uint32_t length){
+	Run run;
+	if( length == 0 ){
+		return true;
+	}
+	bool native = nativeRun(x, y, text, length, -1, &run);
+	if( native ){
+		runs_.push_back(run);
+	}
+	addItem(y, y + fontSize_, native ? (long)runs_.size() - 1 : -1);
+	return raster_.textOut(x, y, text, length);
+}
+
+// A run is split where the pitch changes (the gap between an item and its
+// price on a receipt line) and again where printing at a whole number of
+// dots per character would drift more than a quarter character from the
+// given positions, so that each part starts where it should.
+bool EscPosDevice::textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances){
+	Run run;
+	uint32_t start, end, part, i;
+	size_t runs = runs_.size(), chars = chars_.size();
+	long offset = 0;
+	bool native = true;
+	if( length == 0 ){
+		return true;
+	}
+	for(start=0;start<length&&native;start=end){
+		long total = 0, pitch = -1;
+		end = start + 1;
+		while( end < length ){
+			long step = advances[end - 1] - advances[start];
+			if( step < -1 || step > 1 ){
+				break;
+			}
+			total += advances[end - 1];
+			end += 1;
+		}
+		if( end - start > 1 ){
+			pitch = (total + (end - start - 1) / 2) / (end - start - 1);
+		}
+		long tolerance = pitch / 4 > 1 ? pitch / 4 : 1;
+		for(part=start;part<end&&native;){
+			long partOffset = offset, drift = 0;
+			for(i=part+1;i<end;i++){
+				drift += advances[i - 1] - pitch;
+				if( drift < -tolerance || drift > tolerance ){
+					break;
+				}
+			}
+			native = nativeRun(x + partOffset, y, text + part, i - part, pitch, &run);
+			if( native ){
+				runs_.push_back(run);
+			}
+			for(;part<i;part++){
+				offset += advances[part];
+			}
+		}
+	}
+	if( native ){
+		for(;runs<runs_.size();runs++){
+			addItem(y, y + fontSize_, (long)runs);
+		}
+	} else {
+		runs_.resize(runs);
+		chars_.resize(chars);
+		addItem(y, y + fontSize_, -1);
+	}
+	return raster_.textRun(x, y, text, length, advances);
+}
+
+bool EscPosDevice::setTextColor(int r, int g, int b){
+	return raster_.setTextColor(r, g, b);
+}
+
+bool EscPosDevice::drawImage(ImageRows *rows, long x, long y, long width, long height,
+		std::string *err){
+	if( !raster_.drawImage(rows, x, y, width, height, err) ){
+		return false;
+	}
+	addItem(y, y + height, -1);
+	return true;
+}
+
+DeviceHandle EscPosDevice::createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic){
+	Object object;
+	object.font = true;
+	object.size = height < 0 ? -height : height;
+	object.bold = weight >= FONT_WEIGHT_BOLD;
+	object.raster = raster_.createFont(face, faceLength, height, weight, italic);
+	object.live = true;
+	objects_.push_back(object);
+	return (DeviceHandle)objects_.size();
+}
+
+DeviceHandle EscPosDevice::createPen(long width, int r, int g, int b){
+	Object object;
+	object.font = false;
+	object.size = width;
+	object.bold = false;
+	object.raster = raster_.createPen(width, r, g, b);
+	object.live = true;
+	objects_.push_back(object);
+	return (DeviceHandle)objects_.size();
+}
+
+bool EscPosDevice::selectObject(DeviceHandle handle){
+	if( handle == 0 || handle > objects_.size() || !objects_[handle - 1].live ){
+		return false;
+	}
+	const Object &object = objects_[handle - 1];
+	if( object.font ){
+		fontSize_ = object.size;
+		fontBold_ = object.bold;
+	} else {
+		penWidth_ = object.size;
+	}
+	return raster_.selectObject(object.raster);
+}
+
+bool EscPosDevice::deleteObject(DeviceHandle handle){
+	if( handle == 0 || handle > objects_.size() || !objects_[handle - 1].live ){
+		return false;
+	}
+	objects_[handle - 1].live = false;
+	return raster_.deleteObject(objects_[handle - 1].raster);
+}
+
+void EscPosDevice::feed(long dots){
+	pendingFeed_ += dots;
+	position_ += dots;
+}
+
+// ESC J prints what is in the buffer and feeds the paper by up to 255 dots.
+void EscPosDevice::flushFeed(){
+	while( pendingFeed_ > 0 || lineOpen_ ){
+		long n = pendingFeed_ > 255 ? 255 : pendingFeed_;
+		uint8_t command[] = { 0x1b, 'J', (uint8_t)n };
+		put(command, sizeof(command));
+		pendingFeed_ -= n;
+		lineOpen_ = false;
+	}
+}
+
+struct RunOrder {
+	const std::vector<EscPosDevice::Item> *items;
+	const std::vector<EscPosDevice::Run> *runs;
+	bool operator()(size_t a, size_t b) const {
+		return (*runs)[(*items)[a].run].x < (*runs)[(*items)[b].run].x;
+	}
+};
+
+// Sorts the items by x and tells whether they are runs in one font and size
+// that start on the same row and do not overlap.
+bool EscPosDevice::textBand(std::vector<size_t> *items) const {
+	size_t i;
+	for(i=0;i<items->size();i++){
+		if( items_[(*items)[i]].run < 0 ){
+			return false;
+		}
+	}
+	RunOrder byX;
+	byX.items = &items_;
+	byX.runs = &runs_;
+	std::sort(items->begin(), items->end(), byX);
+	const Run &first = runs_[items_[(*items)[0]].run];
+	for(i=1;i<items->size();i++){
+		const Run &prev = runs_[items_[(*items)[i - 1]].run];
+		const Run &run = runs_[items_[(*items)[i]].run];
+		if( run.y != first.y || run.font != first.font || run.scale != first.scale ||
+				run.x < prev.x + prev.width ){
+			return false;
+		}
+	}
+	return true;
+}
+
+void EscPosDevice::printText(const std::vector<size_t> &items){
+	size_t i;
+	const Run &first = runs_[items_[items[0]].run];
+	flushFeed();
+	if( first.font != font_ ){
+		uint8_t command[] = { 0x1b, 'M', (uint8_t)first.font };
+		put(command, sizeof(command));
+		font_ = first.font;
+	}
+	if( first.scale != scale_ ){
+		uint8_t command[] = { 0x1d, '!', (uint8_t)(((first.scale - 1) << 4) | (first.scale - 1)) };
+		put(command, sizeof(command));
+		scale_ = first.scale;
+	}
+	for(i=0;i<items.size();i++){
+		const Run &run = runs_[items_[items[i]].run];
+		if( (run.bold ? 1 : 0) != bold_ ){
+			uint8_t command[] = { 0x1b, 'E', (uint8_t)(run.bold ? 1 : 0) };
+			put(command, sizeof(command));
+			bold_ = run.bold ? 1 : 0;
+		}
+		if( run.spacing != spacing_ ){
+			uint8_t command[] = { 0x1b, ' ', (uint8_t)run.spacing };
+			put(command, sizeof(command));
+			spacing_ = run.spacing;
+		}
+		uint8_t position[] = { 0x1b, '$', (uint8_t)(run.x & 0xff), (uint8_t)(run.x >> 8) };
+		put(position, sizeof(position));
+		put(&chars_[run.offset], run.length);
+	}
+	lineOpen_ = true;
+	feed((long)fontHeight[first.font] * first.scale);
+}
+
+static bool blank_row(const uint8_t *bits, size_t length){
+	size_t i;
+	for(i=0;i<length;i++){
+		if( bits[i] ){
+			return false;
+		}
+	}
+	return true;
+}
+
+// Draws rows [top, bottom) and sends them as GS v 0 images of up to
+// RASTER_ROWS rows, cut to the rightmost dot; blank rows become feeds.
+void EscPosDevice::printRaster(long top, long bottom){
+	uint32_t stride = (uint32_t)((widthDots_ + 7) / 8);
+	long y0, y;
+	size_t i;
+	page_.width = (uint32_t)widthDots_;
+	page_.bits = 8;
+	page_.stride = (uint32_t)widthDots_;
+	if( page_.pixels.size() < (size_t)bottom * page_.stride ){
+		page_.pixels.resize((size_t)bottom * page_.stride);
+	}
+	page_.height = (uint32_t)bottom;
+	raster_.drawBand((uint32_t)top, (uint32_t)bottom, &page_);
+	MonoConverter converter(opts_.mono, page_.width);
+	bits_.resize((size_t)stride * RASTER_ROWS);
+	for(y0=top;y0<bottom;y0+=RASTER_ROWS){
+		long y1 = y0 + RASTER_ROWS < bottom ? y0 + RASTER_ROWS : bottom;
+		long first = -1, last = -1;
+		size_t bytes = 0;
+		for(y=y0;y<y1;y++){
+			uint8_t *row = &bits_[(size_t)(y - y0) * stride];
+			converter.convertRow(&page_.pixels[(size_t)y * page_.stride], row);
+			// mono_pack has 1 for white, GS v 0 for a dot
+			for(i=0;i<stride;i++){
+				row[i] = (uint8_t)~row[i];
+			}
+			if( widthDots_ % 8 ){
+				row[stride - 1] &= (uint8_t)(0xff << (8 - widthDots_ % 8));
+			}
+			if( !blank_row(row, stride) ){
+				if( first < 0 ){
+					first = y;
+				}
+				last = y;
+				for(i=stride;i>bytes;i--){
+					if( row[i - 1] ){
+						bytes = i;
+						break;
+					}
+				}
+			}
+		}
+		if( first < 0 ){
+			feed(y1 - y0);
+			continue;
+		}
+		feed(first - y0);
+		flushFeed();
+		long rows = last - first + 1;
+		uint8_t command[] = { 0x1d, 'v', '0', 0, (uint8_t)(bytes & 0xff), (uint8_t)(bytes >> 8),
+			(uint8_t)(rows & 0xff), (uint8_t)(rows >> 8) };
+		put(command, sizeof(command));
+		for(y=first;y<=last;y++){
+			put(&bits_[(size_t)(y - y0) * stride], bytes);
+		}
+		// the printer feeds the paper by the height of the image
+		position_ += rows;
+		feed(y1 - last - 1);
+	}
+}
+
+struct ItemOrder {
+	const std::vector<EscPosDevice::Item> *items;
+	bool operator()(size_t a, size_t b) const {
+		return (*items)[a].top < (*items)[b].top;
+	}
+};
+
+bool EscPosDevice::endPage(){
+	std::vector<size_t> order(items_.size()), band;
+	size_t i, j;
+	for(i=0;i<order.size();i++){
+		order[i] = i;
+	}
+	ItemOrder byTop;
+	byTop.items = &items_;
+	std::stable_sort(order.begin(), order.end(), byTop);
+	for(i=0;i<order.size();i=j){
+		long top = items_[order[i]].top, bottom = items_[order[i]].bottom;
+		band.clear();
+		for(j=i;j<order.size()&&items_[order[j]].top<bottom;j++){
+			band.push_back(order[j]);
+			if( items_[order[j]].bottom > bottom ){
+				bottom = items_[order[j]].bottom;
+			}
+		}
+		if( top > position_ ){
+			feed(top - position_);
+		}
+		if( textBand(&band) ){
+			printText(band);
+			textBands_ += 1;
+		} else {
+			printRaster(top, bottom);
+			rasterBands_ += 1;
+		}
+	}
+	if( opts_.height > 0 ){
+		long height = mm_to_pixel(opts_.dpi, opts_.height);
+		if( height > position_ ){
+			feed(height - position_);
+		}
+	}
+	flushFeed();
+	if( opts_.cut != ESCPOS_CUT_NONE ){
+		// GS V 65/66 0: feed to the cutter, then a full/partial cut
+		uint8_t command[] = { 0x1d, 'V', (uint8_t)(opts_.cut == ESCPOS_CUT_FULL ? 65 : 66), 0 };
+		put(command, sizeof(command));
+	}
+	return true;
+}
+
+bool compile_escpos(const Page *const *pages, size_t count, const EscPosOptions &opts,
+		std::vector<uint8_t> *out, std::string *err){
+	long width = mm_to_pixel(opts.dpi, opts.width);
+	if( opts.dpi <= 0 || opts.dpi > 2400 || width < 8 || width > 4096 ||
+			!(opts.height >= 0 && opts.height <= 10000) ){
+		*err = "invalid escpos options";
+		return false;
+	}
+	EscPosDevice device(opts);
+	PageExecutor executor(&device);
+	executor.setOffset(opts.dx, opts.dy);
+	if( !executor.runJob(pages, count, NULL, 0) ){
+		*err = executor.error();
+		return false;
+	}
+	*out = device.bytes();
+	return true;
+}
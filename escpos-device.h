@@ -0,0 +1,161 @@
+#ifndef DRAWER_ESCPOS_DEVICE_H
+#define DRAWER_ESCPOS_DEVICE_H
+
+#include "device.h"
+#include "raster-device.h"
+#include "page.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+enum EscPosCut {
+	ESCPOS_CUT_NONE,
+	ESCPOS_CUT_PARTIAL,
+	ESCPOS_CUT_FULL
+};
+
+struct EscPosOptions {
+	// printer dots per inch (8 dots per mm on most receipt printers)
+	int dpi;
+	// printable width and page height in mm; height 0 ends each page below
+	// what is drawn
+	double width;
+	double height;
+	double dx, dy;
+	int cut;
+	// print text in the printer's fonts where the layout allows
+	bool nativeText;
+	// conversion of raster bands to 1 bit
+	MonoOptions mono;
+
+	EscPosOptions() : dpi(203), width(72), height(0), dx(0), dy(0),
+		cut(ESCPOS_CUT_PARTIAL), nativeText(true) {
+		mono.dither = MONO_DITHER_BAYER;
+	}
+};
+
+// Device that compiles pages into ESC/POS commands for thermal receipt
+// printers, to be sent to the printer as raw data in one write.
+//
+// A page is collected first and split at endPage into horizontal bands of
+// items that overlap vertically. A band of text runs on one line, in one
+// size and with even character spacing, is printed in the printer's font A
+// or B (scaled with GS !, spaced with ESC SP and placed with ESC $); every
+// other band (lines, images, other characters than ASCII, mixed sizes) is
+// drawn by a RasterDevice and sent as GS v 0 raster images. Bands are
+// separated by ESC J feeds, and the page ends with a cut.
+class EscPosDevice : public Device {
+public:
+	EscPosDevice(const EscPosOptions &opts);
+
+	// The commands of the job so far.
+	const std::vector<uint8_t> &bytes() const { return out_; }
+	// Bands of the last page printed as text and as raster.
+	size_t textBands() const { return textBands_; }
+	size_t rasterBands() const { return rasterBands_; }
+
+	// Scales an image into a raster band.
+	bool drawImage(ImageRows *rows, long x, long y, long width, long height, std::string *err);
+
+	int dpix(){ return opts_.dpi; }
+	int dpiy(){ return opts_.dpi; }
+
+	bool startDoc(const uint16_t *jobName, uint32_t length);
+	bool endDoc(){ return true; }
+	bool abortDoc();
+	bool startPage();
+	bool endPage();
+
+	bool moveTo(long x, long y);
+	bool lineTo(long x, long y);
+	bool fillRect(long left, long top, long right, long bottom, int r, int g, int b);
+	bool textOut(long x, long y, const uint16_t *text, uint32_t length);
+	bool textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances);
+	bool setTextColor(int r, int g, int b);
+	bool setBkTransparent(){ return true; }
+
+	DeviceHandle createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic);
+	DeviceHandle createPen(long width, int r, int g, int b);
+	bool selectObject(DeviceHandle handle);
+	bool deleteObject(DeviceHandle handle);
+
+	struct Object {
+		bool font;
+		long size;
+		bool bold;
+		DeviceHandle raster;
+		bool live;
+	};
+
+	// Rows [top, bottom) a call draws on; run is the index of a text run
+	// that can be printed in a printer font, or -1.
+	struct Item {
+		long top;
+		long bottom;
+		long run;
+	};
+
+	// A text run in a printer font.
+	struct Run {
+		long x, y;
+		// 0: font A (12 x 24 dots), 1: font B (9 x 17 dots)
+		int font;
+		int scale;
+		bool bold;
+		// dots added after each character (ESC SP)
+		int spacing;
+		// dots from x to the end of the run
+		long width;
+		uint32_t offset;
+		uint32_t length;
+	};
+
+private:
+	void addItem(long top, long bottom, long run);
+	bool nativeRun(long x, long y, const uint16_t *text, uint32_t length,
+		long pitch, Run *run);
+	void put(const uint8_t *data, size_t length);
+	void feed(long dots);
+	void flushFeed();
+	bool textBand(std::vector<size_t> *items) const;
+	void printText(const std::vector<size_t> &items);
+	void printRaster(long top, long bottom);
+
+	EscPosOptions opts_;
+	long widthDots_;
+	std::vector<uint8_t> out_;
+	RasterDevice raster_;
+	std::vector<Object> objects_;
+	long x_, y_;
+	long fontSize_;
+	bool fontBold_;
+	long penWidth_;
+
+	std::vector<Item> items_;
+	std::vector<Run> runs_;
+	std::vector<uint8_t> chars_;
+	// paper row at the print head, after the pending feed
+	long position_;
+	long pendingFeed_;
+	// characters are in the print buffer
+	bool lineOpen_;
+	// printer state set by the commands so far
+	int font_;
+	int scale_;
+	int bold_;
+	int spacing_;
+	size_t textBands_;
+	size_t rasterBands_;
+	RasterPage page_;
+	std::vector<uint8_t> bits_;
+};
+
+// Runs pages through a PageExecutor on an EscPosDevice; out gets the
+// commands of the whole job.
+bool compile_escpos(const Page *const *pages, size_t count, const EscPosOptions &opts,
+	std::vector<uint8_t> *out, std::string *err);
+
+#endif
@@ -0,0 +1,289 @@
+#include "gdi-device.h"
+#include "page.h"
+#include <string>
+
+GdiDevice::GdiDevice(HDC hdc){
+	hdc_ = hdc;
+	dpix_ = 0;
+	dpiy_ = 0;
+}
+
+void GdiDevice::loadDpi(){
+	PrinterCaps caps;
+	std::string err;
+	if( gdi_caps_cache()->getForDc((DeviceHandle)hdc_, &caps, &err) ){
+		dpix_ = caps.dpix;
+		dpiy_ = caps.dpiy;
+	} else {
+		dpix_ = GetDeviceCaps(hdc_, LOGPIXELSX);
+		dpiy_ = GetDeviceCaps(hdc_, LOGPIXELSY);
+	}
+}
+
+int GdiDevice::dpix(){
+	if( dpix_ == 0 ){
+		loadDpi();
+	}
+	return dpix_;
+}
+
+int GdiDevice::dpiy(){
+	if( dpiy_ == 0 ){
+		loadDpi();
+	}
+	return dpiy_;
+}
+
+bool GdiDevice::startDoc(const uint16_t *jobName, uint32_t length){
+	std::wstring name((const wchar_t *)jobName, length);
+	DOCINFOW docinfo;
+	ZeroMemory(&docinfo, sizeof(docinfo));
+	docinfo.cbSize = sizeof(docinfo);
+	docinfo.lpszDocName = name.c_str();
+	return StartDocW(hdc_, &docinfo) > 0;
+}
+
+bool GdiDevice::endDoc(){
+	return EndDoc(hdc_) > 0;
+}
+
+bool GdiDevice::abortDoc(){
+	return AbortDoc(hdc_) > 0;
+}
+
+bool GdiDevice::startPage(){
+	return StartPage(hdc_) > 0;
+}
+
+bool GdiDevice::endPage(){
+	return EndPage(hdc_) > 0;
+}
+
+bool GdiDevice::moveTo(long x, long y){
+	return MoveToEx(hdc_, x, y, NULL) != FALSE;
+}
+
+bool GdiDevice::lineTo(long x, long y){
+	return LineTo(hdc_, x, y) != FALSE;
+}
+
+// POINT is two LONGs, which on Windows are the longs of points.
+bool GdiDevice::polyPolyline(const long *points, const uint32_t *counts, uint32_t polylines){
+	return PolyPolyline(hdc_, (const POINT *)points, (const DWORD *)counts, polylines) != FALSE;
+}
+
+bool GdiDevice::fillRect(long left, long top, long right, long bottom, int r, int g, int b){
+	RECT rect = { left, top, right, bottom };
+	if( SetDCBrushColor(hdc_, RGB(r, g, b)) == CLR_INVALID ){
+		return false;
+	}
+	return FillRect(hdc_, &rect, (HBRUSH)GetStockObject(DC_BRUSH)) != 0;
+}
+
+bool GdiDevice::textOut(long x, long y, const uint16_t *text, uint32_t length){
+	return TextOutW(hdc_, x, y, (LPCWSTR)text, length) != FALSE;
+}
+
+bool GdiDevice::textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances){
+	return ExtTextOutW(hdc_, x, y, 0, NULL, (LPCWSTR)text, length, advances) != FALSE;
+}
+
+bool GdiDevice::setTextColor(int r, int g, int b){
+	return SetTextColor(hdc_, RGB(r, g, b)) != CLR_INVALID;
+}
+
+bool GdiDevice::setBkTransparent(){
+	return SetBkMode(hdc_, TRANSPARENT) != 0;
+}
+
+DeviceHandle GdiObjectFactory::createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic){
+	LOGFONTW logfont;
+	ZeroMemory(&logfont, sizeof(logfont));
+	logfont.lfHeight = height;
+	logfont.lfWeight = weight;
+	logfont.lfItalic = static_cast<BYTE>(italic);
+	logfont.lfCharSet = DEFAULT_CHARSET;
+	logfont.lfOutPrecision = OUT_DEFAULT_PRECIS;
+	logfont.lfClipPrecision = CLIP_DEFAULT_PRECIS;
+	logfont.lfQuality = DEFAULT_QUALITY;
+	logfont.lfPitchAndFamily = DEFAULT_PITCH;
+	if( faceLength >= LF_FACESIZE ){
+		return 0;
+	}
+	CopyMemory(logfont.lfFaceName, face, faceLength * sizeof(WCHAR));
+	logfont.lfFaceName[faceLength] = 0;
+	return (DeviceHandle)CreateFontIndirectW(&logfont);
+}
+
+DeviceHandle GdiObjectFactory::createPen(int style, long width, int r, int g, int b){
+	return (DeviceHandle)CreatePen(style, width, RGB(r, g, b));
+}
+
+bool GdiObjectFactory::deleteObject(DeviceHandle handle){
+	return DeleteObject((HGDIOBJ)handle) != FALSE;
+}
+
+ObjectCache *gdi_object_cache(){
+	static GdiObjectFactory factory;
+	static ObjectCache cache(&factory, 64);
+	return &cache;
+}
+
+static std::wstring wide_printer_name(const std::string &printer){
+	int n = MultiByteToWideChar(CP_UTF8, 0, printer.c_str(), -1, NULL, 0);
+	std::wstring name(n > 0 ? n : 1, L'\0');
+	MultiByteToWideChar(CP_UTF8, 0, printer.c_str(), -1, &name[0], n);
+	return name;
+}
+
+DeviceHandle GdiDcFactory::create(const std::string &printer, const char *devmode,
+		size_t devmodeLength, std::string *err){
+	std::wstring name = wide_printer_name(printer);
+	HDC hdc = CreateDCW(NULL, name.c_str(), NULL,
+		devmodeLength > 0 ? (const DEVMODEW *)devmode : NULL);
+	if( hdc == NULL ){
+		*err = "createDC failed with code " + std::to_string(GetLastError()) +
+			", printer: " + printer;
+		return 0;
+	}
+	SaveDC(hdc);
+	return (DeviceHandle)hdc;
+}
+
+bool GdiDcFactory::reset(DeviceHandle dc){
+	HDC hdc = (HDC)dc;
+	// deselect the job's fonts and pens, so that the object cache may delete them
+	SelectObject(hdc, GetStockObject(SYSTEM_FONT));
+	SelectObject(hdc, GetStockObject(BLACK_PEN));
+	return RestoreDC(hdc, -1) != FALSE && SaveDC(hdc) > 0;
+}
+
+bool GdiDcFactory::healthy(DeviceHandle dc){
+	return GetDeviceCaps((HDC)dc, HORZRES) > 0;
+}
+
+void GdiDcFactory::destroy(DeviceHandle dc){
+	DeleteDC((HDC)dc);
+}
+
+DcPool *gdi_dc_pool(){
+	static GdiDcFactory factory;
+	static DcPool pool(&factory, 300, 16);
+	return &pool;
+}
+
+// Names of fixed width (DC_PAPERNAMES: 64, DC_BINNAMES: 24 chars) that are
+// not terminated when they fill their slot.
+static std::string caps_name(const WCHAR *name, size_t width){
+	size_t n = 0;
+	while( n < width && name[n] ){
+		n++;
+	}
+	return utf16_to_utf8((const uint16_t *)name, (uint32_t)n);
+}
+
+static void probe_papers(const WCHAR *name, const DEVMODEW *devmode, PrinterCaps *caps){
+	int n = DeviceCapabilitiesW(name, NULL, DC_PAPERS, NULL, devmode);
+	if( n <= 0 ){
+		return;
+	}
+	std::vector<WORD> ids(n);
+	std::vector<WCHAR> names((size_t)n * 64);
+	std::vector<POINT> sizes(n);
+	DeviceCapabilitiesW(name, NULL, DC_PAPERS, (LPWSTR)&ids[0], devmode);
+	DeviceCapabilitiesW(name, NULL, DC_PAPERNAMES, &names[0], devmode);
+	DeviceCapabilitiesW(name, NULL, DC_PAPERSIZE, (LPWSTR)&sizes[0], devmode);
+	caps->papers.resize(n);
+	int i;
+	for(i=0;i<n;i++){
+		PrinterPaper &paper = caps->papers[i];
+		paper.id = ids[i];
+		paper.name = caps_name(&names[(size_t)i * 64], 64);
+		paper.width = sizes[i].x;
+		paper.height = sizes[i].y;
+	}
+}
+
+static void probe_bins(const WCHAR *name, const DEVMODEW *devmode, PrinterCaps *caps){
+	int n = DeviceCapabilitiesW(name, NULL, DC_BINS, NULL, devmode);
+	if( n <= 0 ){
+		return;
+	}
+	std::vector<WORD> ids(n);
+	std::vector<WCHAR> names((size_t)n * 24);
+	DeviceCapabilitiesW(name, NULL, DC_BINS, (LPWSTR)&ids[0], devmode);
+	DeviceCapabilitiesW(name, NULL, DC_BINNAMES, &names[0], devmode);
+	caps->bins.resize(n);
+	int i;
+	for(i=0;i<n;i++){
+		caps->bins[i].id = ids[i];
+		caps->bins[i].name = caps_name(&names[(size_t)i * 24], 24);
+	}
+}
+
+bool GdiCapsProvider::probe(const std::string &printer, const char *devmode, size_t devmodeLength,
+		DeviceHandle dc, PrinterCaps *caps, std::string *err){
+	std::wstring name = wide_printer_name(printer);
+	const DEVMODEW *dm = devmodeLength > 0 ? (const DEVMODEW *)devmode : NULL;
+	HDC hdc = (HDC)dc;
+	if( hdc == NULL ){
+		hdc = CreateICW(NULL, name.c_str(), NULL, dm);
+		if( hdc == NULL ){
+			*err = "createIC failed with code " + std::to_string(GetLastError()) +
+				", printer: " + printer;
+			return false;
+		}
+	}
+	caps->dpix = GetDeviceCaps(hdc, LOGPIXELSX);
+	caps->dpiy = GetDeviceCaps(hdc, LOGPIXELSY);
+	caps->printableWidth = GetDeviceCaps(hdc, HORZRES);
+	caps->printableHeight = GetDeviceCaps(hdc, VERTRES);
+	caps->printableWidthMm = GetDeviceCaps(hdc, HORZSIZE);
+	caps->printableHeightMm = GetDeviceCaps(hdc, VERTSIZE);
+	caps->physicalWidth = GetDeviceCaps(hdc, PHYSICALWIDTH);
+	caps->physicalHeight = GetDeviceCaps(hdc, PHYSICALHEIGHT);
+	caps->offsetX = GetDeviceCaps(hdc, PHYSICALOFFSETX);
+	caps->offsetY = GetDeviceCaps(hdc, PHYSICALOFFSETY);
+	caps->color = GetDeviceCaps(hdc, NUMCOLORS) > 2;
+	caps->duplex = false;
+	if( hdc != (HDC)dc ){
+		DeleteDC(hdc);
+	}
+	if( printer.empty() ){
+		return true;
+	}
+	caps->color = DeviceCapabilitiesW(name.c_str(), NULL, DC_COLORDEVICE, NULL, dm) == 1;
+	caps->duplex = DeviceCapabilitiesW(name.c_str(), NULL, DC_DUPLEX, NULL, dm) == 1;
+	probe_papers(name.c_str(), dm, caps);
+	probe_bins(name.c_str(), dm, caps);
+	return true;
+}
+
+PrinterCapsCache *gdi_caps_cache(){
+	static GdiCapsProvider provider;
+	static PrinterCapsCache cache(&provider);
+	return &cache;
+}
+
+DeviceHandle GdiDevice::createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic){
+	return gdi_object_cache()->acquireFont(face, faceLength, height, weight, italic);
+}
+
+DeviceHandle GdiDevice::createPen(long width, int r, int g, int b){
+	return gdi_object_cache()->acquirePen(PS_SOLID, width, r, g, b);
+}
+
+bool GdiDevice::selectObject(DeviceHandle handle){
+	HGDIOBJ prev = SelectObject(hdc_, (HGDIOBJ)handle);
+	return prev != NULL && prev != HGDI_ERROR;
+}
+
+bool GdiDevice::deleteObject(DeviceHandle handle){
+	if( gdi_object_cache()->release(handle) ){
+		return true;
+	}
+	return DeleteObject((HGDIOBJ)handle) != FALSE;
+}
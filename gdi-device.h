@@ -0,0 +1,89 @@
+#ifndef DRAWER_GDI_DEVICE_H
+#define DRAWER_GDI_DEVICE_H
+
+#include <windows.h>
+#include "device.h"
+#include "object-cache.h"
+#include "dc-pool.h"
+#include "printer-caps.h"
+
+// Creates fonts and pens with GDI for gdi_object_cache().
+class GdiObjectFactory : public ObjectFactory {
+public:
+	DeviceHandle createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic);
+	DeviceHandle createPen(int style, long width, int r, int g, int b);
+	bool deleteObject(DeviceHandle handle);
+};
+
+// The process-wide font and pen cache.
+ObjectCache *gdi_object_cache();
+
+// Printer DCs for gdi_dc_pool(). The state saved (SaveDC) right after
+// creation is what reset() restores.
+class GdiDcFactory : public DcFactory {
+public:
+	DeviceHandle create(const std::string &printer, const char *devmode,
+		size_t devmodeLength, std::string *err);
+	bool reset(DeviceHandle dc);
+	bool healthy(DeviceHandle dc);
+	void destroy(DeviceHandle dc);
+};
+
+// The process-wide pool of printer DCs.
+DcPool *gdi_dc_pool();
+
+// Probes with GetDeviceCaps (on an information context if no DC is given)
+// and DeviceCapabilitiesW for gdi_caps_cache().
+class GdiCapsProvider : public CapsProvider {
+public:
+	bool probe(const std::string &printer, const char *devmode, size_t devmodeLength,
+		DeviceHandle dc, PrinterCaps *caps, std::string *err);
+};
+
+// The process-wide printer caps cache; DCs of gdi_dc_pool() are bound to it
+// while they are leased.
+PrinterCapsCache *gdi_caps_cache();
+
+// Device that draws on a (printer) HDC. The HDC is owned by the caller.
+// Fonts and pens come from gdi_object_cache() and deleteObject releases them;
+// the resolution comes from gdi_caps_cache().
+class GdiDevice : public Device {
+public:
+	explicit GdiDevice(HDC hdc);
+
+	HDC hdc(){ return hdc_; }
+
+	int dpix();
+	int dpiy();
+
+	bool startDoc(const uint16_t *jobName, uint32_t length);
+	bool endDoc();
+	bool abortDoc();
+	bool startPage();
+	bool endPage();
+
+	bool moveTo(long x, long y);
+	bool lineTo(long x, long y);
+	bool polyPolyline(const long *points, const uint32_t *counts, uint32_t polylines);
+	bool fillRect(long left, long top, long right, long bottom, int r, int g, int b);
+	bool textOut(long x, long y, const uint16_t *text, uint32_t length);
+	bool textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances);
+	bool setTextColor(int r, int g, int b);
+	bool setBkTransparent();
+
+	DeviceHandle createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic);
+	DeviceHandle createPen(long width, int r, int g, int b);
+	bool selectObject(DeviceHandle handle);
+	bool deleteObject(DeviceHandle handle);
+
+private:
+	void loadDpi();
+
+	HDC hdc_;
+	int dpix_, dpiy_;
+};
+
+#endif
@@ -0,0 +1,23 @@
+#include "glyph-run.h"
+
+size_t build_glyph_runs(const long *xs, const long *ys, uint32_t n,
+		int *advances, std::vector<GlyphRun> *runs){
+	uint32_t i, start = 0;
+	runs->clear();
+	for(i=0;i<n;i++){
+		bool last = (i + 1 == n) || (ys[i + 1] != ys[i]);
+		if( !last ){
+			advances[i] = (int)(xs[i + 1] - xs[i]);
+		} else {
+			advances[i] = i > start ? advances[i - 1] : 0;
+			GlyphRun run;
+			run.start = start;
+			run.count = i + 1 - start;
+			run.x = xs[start];
+			run.y = ys[start];
+			runs->push_back(run);
+			start = i + 1;
+		}
+	}
+	return runs->size();
+}
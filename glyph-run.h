@@ -0,0 +1,26 @@
+#ifndef DRAWER_GLYPH_RUN_H
+#define DRAWER_GLYPH_RUN_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Characters [start, start + count) of a draw_chars text that share a
+// baseline and are drawn with one ExtTextOutW call starting at (x, y).
+struct GlyphRun {
+	uint32_t start;
+	uint32_t count;
+	long x;
+	long y;
+};
+
+// Splits per-character device positions into runs, starting a new run
+// whenever y changes, and fills advances[i] with the distance from character
+// i to character i + 1 of the same run (the lpDx array of ExtTextOutW). The
+// last character of a run repeats the previous advance (0 for a run of one
+// character). advances must have room for n values. Returns the number of
+// runs.
+size_t build_glyph_runs(const long *xs, const long *ys, uint32_t n,
+	int *advances, std::vector<GlyphRun> *runs);
+
+#endif
@@ -3,6 +3,8 @@
 var api = require("bindings")("drawer");
 var Printer = require("./printer");
 var DrawerSetting = require("./setting");
+var PageFormat = require("./page-format");
+var SettingStore = require("./setting-store").SettingStore;
 
 exports.api = api;
 
@@ -12,14 +14,29 @@ api.disposeWindow(hwnd) ==> bool (ok)
 api.getDc(hwnd) ==> hdc
 api.releaseDc(hwnd, hdc) ==> bool (ok)
 api.measureText(hdc, string) => { cx:..., cy:... }
+api.measureTextBatch(hdc, font, strings) => Int32Array of widths
+api.layoutText(hdc, font, string, width, opts?) => [{ text, xs, y, width }] (opts: { x, y, lineHeight, align, maxLines, ellipsis, tabStops, tabWidth })
 api.createFont(fontname, size, weight?, italic?) ==> HANDLE
 api.deleteObject(obj) ==> bool (ok)
+api.objectCacheStats() ==> { hits, misses, evictions, size, inUse, capacity }
+api.setObjectCacheCapacity(n)
+api.purgeObjectCache()
 api.getDpiOfHdc(hdc) ==> { dpix:..., dpiy:... }
 api.printerDialog(devmode?, devnames?) ==> { devmode:..., devnames:... }
 api.parseDevmode(devmode) ==> { deviceName:..., ... }
 api.parseDevnames(devnames) ==> { driver:..., ... }
+api.devmodeWithCopies(printer, devmode, copies, collate?) ==> devmode with dmCopies | null (driver can't)
 api.createDc(devmode, devnames) ==> hdc
 api.deleteDc(hdc) ==> bool (ok)
+api.acquireDc(printer, devmode?) ==> hdc (from the DC pool)
+api.releasePooledDc(hdc, discard?) ==> bool (ok)
+api.dcPoolStats() ==> { hits, misses, createFailures, destroyed, unhealthy, idle, leased, createSeconds, maxCreateSeconds }
+api.getPrinterCaps(printer, devmode?) ==> { dpix, dpiy, printableWidth, printableHeight, physicalWidth, physicalHeight, offsetX, offsetY, color, duplex, papers, bins, ... }
+api.getDcCaps(hdc) ==> caps (cached per printer and devmode)
+api.invalidatePrinterCaps(printer?)
+api.printerCapsStats() ==> { hits, misses, failures, entries, boundDcs }
+api.setDcPoolOptions({ idleTimeout, maxIdle })
+api.purgeDcPool(all?)
 api.beginPrint(hdc) ==> (throws exception if it fails)
 api.endPrint(hdc) ==> (throws exception if it fails)
 api.abortPrint(hdc) ==> (throws exception if it fails)
@@ -27,35 +44,284 @@ api.startPage(hdc) ==> (throws exception if it fails)
 api.endPage(hdc) ==> (throws exception if it fails)
 api.moveTo(hdc, x, y) ==> (throws exception if it fails)
 api.lineTo(hdc, x, y) ==> (throws exception if it fails)
+api.polyPolyline(hdc, points, counts) ==> (throws exception if it fails, points: [x0, y0, x1, y1, ...])
+api.fillRect(hdc, left, top, right, bottom, r, g, b) ==> (throws exception if it fails)
 api.textOut(hdc, x, y, text) ==> (throws exception if it fails)
+api.drawGlyphRun(hdc, text, xs, ys, transform?) ==> number of runs (throws exception if it fails)
+api.printImage(hdc, imagePath, opts?) ==> (throws exception if it fails)
+api.printImageFromBytes(hdc, imageBuffer, opts?) ==> (throws exception if it fails)
+api.monochromeBmp(bmpBuffer, opts?) ==> 1 bpp BMP Buffer (throws exception if it fails)
+api.imageKernels() ==> "scalar" | "sse2" | "avx2"
 api.selectObject(hdc, handle) ==> (throws exception if it fails)
 api.setTextColor(hdc, r, g, b) ==> (throws exception if it fails)
 api.createPen(width, r, g, b) ==> (throws exception if it fails)
 api.setBkMode(hdc, mode) ==> (throws exception if it fails)
+api.drawPage(hdc, ops, opts?) ==> number of ops (throws exception if it fails)
+api.drawPages(hdc, pages, opts?) ==> number of ops (throws exception if it fails, opts: { jobName, dx, dy, copies, collate })
+api.drawEncodedPages(hdc, buffer, opts?) ==> number of ops (throws exception if it fails)
+api.compileTemplate(ops) ==> template (throws exception if it fails)
+api.drawTemplate(hdc, template, values | [values], opts?) ==> number of ops (throws exception if it fails)
+api.deleteTemplate(template) ==> bool
+api.renderPages(pages, opts?) ==> [Buffer] (PNG or PNM per page, throws exception if it fails)
+api.renderPdf(pages, opts?) ==> PDF Buffer (throws exception if it fails)
+api.writePdf(pages, path, opts?) ==> bytes written (throws exception if it fails)
+api.escposPages(pages, opts?) ==> ESC/POS Buffer (throws exception if it fails)
+api.writePrinterRaw(printer, buffer, jobName?) ==> bytes written (throws exception if it fails)
+api.setStatsEnabled(bool)
+api.getStats() ==> [{ printer, jobs, failed, pages, gdiCalls, textRuns, imageBytes, objectsCreated, objectsDeleted, phases }]
+api.onJobComplete(cb | null) (cb gets { printer, jobId, status, pages, ops, ..., phases })
+api.statsTrace() ==> Chrome trace event JSON string
+api.resetStats()
+api.printJobAsync(devmode, devnames, pages, opts, cb) ==> jobId (cb gets { jobId, status, ... })
+api.cancelPrintJob(jobId) ==> bool (false if the job already finished)
+api.spoolJob(printer, devmode?, devnames?, pages, opts, cb) ==> jobId (throws "queue full")
+api.spoolerStatus() ==> [{ printer, queued, busy, runningJob, done, failed, canceled, consecutiveFailures }]
+api.setSpoolerQueueLimit(n)
 */
 
-exports.printPages = function(pages, setting){
-	var hdc = api.createDc(setting.devmode, setting.devnames);
+// Settings of a SettingStore carry their printer name; others are parsed.
+function settingPrinter(setting){
+	return setting.printer || api.parseDevnames(setting.devnames).device;
+}
+
+// The DC comes from the DC pool and is kept warm for the next job with the
+// same printer and devmode; after a failure it is deleted. opts: { copies,
+// collate (default true), optimize (default true) }; the driver makes the
+// copies if it can.
+exports.printPages = function(pages, setting, opts){
+	var printerName = settingPrinter(setting);
+	var devmode = setting.devmode, driverDevmode;
+	var copies = (opts && opts.copies) || 1, collate = !(opts && opts.collate === false);
+	if( copies > 1 ){
+		driverDevmode = api.devmodeWithCopies(printerName, devmode, copies, collate);
+		if( driverDevmode ){
+			devmode = driverDevmode;
+			copies = 1;
+		}
+	}
+	var hdc = api.acquireDc(printerName, devmode);
 	if( hdc === 0 ){
 		return "cannot create hdc";
 	}
 	try{
 		var printer = new Printer(hdc);
-		printer.print(pages);
+		printer.print(pages, { copies: copies, collate: collate, optimize: !(opts && opts.optimize === false) });
 		printer.dispose();
-		api.deleteDc(hdc);
+		api.releasePooledDc(hdc);
+		return null;
+	} catch(ex){
+		api.releasePooledDc(hdc, true);
+		console.log(ex);
+		return ex;
+	}
+};
+
+// Templates: ops with field/repeat/if slots (see page-template.h), compiled
+// once; printTemplate only passes the values of each print.
+exports.compileTemplate = function(ops){
+	return api.compileTemplate(ops);
+};
+
+exports.printTemplate = function(template, values, setting){
+	var printerName = settingPrinter(setting);
+	var hdc = api.acquireDc(printerName, setting.devmode);
+	if( hdc === 0 ){
+		return "cannot create hdc";
+	}
+	try{
+		api.drawTemplate(hdc, template, values);
+		api.releasePooledDc(hdc);
 		return null;
 	} catch(ex){
-		api.deleteDc(hdc);
+		api.releasePooledDc(hdc, true);
 		console.log(ex);
 		return ex;
 	}
 };
 
+exports.deleteTemplate = function(template){
+	return api.deleteTemplate(template);
+};
+
+exports.dcPoolStats = function(){
+	return api.dcPoolStats();
+};
+
+// Resolution, printable area and offsets, papers and bins of a printer (a
+// name or a setting), probed once per printer and devmode. Call
+// invalidatePrinterCaps after changing the printer's driver settings.
+exports.getPrinterCaps = function(printer){
+	if( typeof printer === "string" ){
+		return api.getPrinterCaps(printer);
+	}
+	return api.getPrinterCaps(settingPrinter(printer), printer.devmode);
+};
+
+exports.invalidatePrinterCaps = function(printer){
+	api.invalidatePrinterCaps(printer);
+};
+
+// Prints on a worker thread; the event loop is not blocked by the driver or
+// the spooler. cb(err, result) is called with the job result
+// { jobId, status: "done"|"canceled"|"error", error?, pages, ops, elapsed };
+// err is set unless the status is "done". Without cb a Promise is returned.
+// Either way the returned object has jobId and cancel(), which aborts the
+// document (AbortDoc) if it is still printing. opts: { jobName, copies,
+// collate (default true) }; copies are made by the driver when it can,
+// otherwise each page is drawn once and replayed for the other copies.
+exports.printPagesAsync = function(pages, setting, opts, cb){
+	if( typeof opts === "function" ){
+		cb = opts;
+		opts = {};
+	}
+	opts = opts || {};
+	return jobHandle(function(done){
+		return api.printJobAsync(setting.devmode, setting.devnames, pages, opts, done);
+	}, cb);
+};
+
+// Like printPagesAsync, but through the spooler: each printer has its own
+// worker thread and queue, so a slow or offline printer only delays its own
+// jobs. printer is a printer name or a setting ({ devmode, devnames }).
+// opts: { priority (higher first, default 0), jobName, copies, collate }.
+// If the printer already has too many jobs waiting, the job fails with
+// err.code "EQUEUEFULL" (see setSpoolerQueueLimit).
+exports.spoolPages = function(pages, printer, opts, cb){
+	var name, devmode = null, devnames = null;
+	if( typeof opts === "function" ){
+		cb = opts;
+		opts = {};
+	}
+	opts = opts || {};
+	if( typeof printer === "string" ){
+		name = printer;
+	} else {
+		devmode = printer.devmode;
+		devnames = printer.devnames;
+		name = settingPrinter(printer);
+	}
+	return jobHandle(function(done){
+		return api.spoolJob(name, devmode, devnames, pages, opts, done);
+	}, cb);
+};
+
+exports.spoolerStatus = function(){
+	return api.spoolerStatus();
+};
+
+exports.setSpoolerQueueLimit = function(n){
+	api.setSpoolerQueueLimit(n);
+};
+
+// Job timing and counters, off by default (see getStats in drawer.cc):
+// getStats() returns latency histograms per printer and phase, cb of
+// onJobComplete gets every finished job, statsTrace() returns the last
+// jobs as Chrome trace events.
+exports.setStatsEnabled = function(enabled){
+	api.setStatsEnabled(!!enabled);
+};
+
+exports.getStats = function(){
+	return api.getStats();
+};
+
+exports.onJobComplete = function(cb){
+	api.onJobComplete(cb || null);
+};
+
+exports.statsTrace = function(){
+	return api.statsTrace();
+};
+
+// Starts a job with start(done), which returns the job id and calls done
+// with the job result, and returns { jobId, cancel() } (or a Promise with
+// them when there is no cb).
+function jobHandle(start, cb){
+	var jobId, handle, promise;
+	function run(cb){
+		try {
+			jobId = start(function(result){
+				var err;
+				if( result.status === "done" ){
+					cb(null, result);
+				} else {
+					err = new Error(result.error || result.status);
+					err.job = result;
+					cb(err, result);
+				}
+			});
+		} catch(ex){
+			// invalid pages are thrown to the caller, backpressure goes to cb
+			if( ex.message !== "queue full" ){
+				throw ex;
+			}
+			ex.code = "EQUEUEFULL";
+			jobId = 0;
+			process.nextTick(function(){
+				cb(ex);
+			});
+		}
+	}
+	if( cb ){
+		run(cb);
+		handle = {};
+	} else {
+		promise = new Promise(function(resolve, reject){
+			run(function(err, result){
+				if( err ){
+					reject(err);
+				} else {
+					resolve(result);
+				}
+			});
+		});
+		handle = promise;
+	}
+	handle.jobId = jobId;
+	handle.cancel = function(){
+		return api.cancelPrintJob(jobId);
+	};
+	return handle;
+}
+
+exports.cancelPrintJob = function(jobId){
+	return api.cancelPrintJob(jobId);
+};
+
+// pages can also be a buffer made by encodePages
+exports.encodePages = function(pages){
+	return PageFormat.encodePages(pages);
+};
+
+exports.saveEncodedPages = function(path, pages, done){
+	PageFormat.saveEncodedPages(path, pages, done);
+};
+
+exports.readEncodedPages = function(path, cb){
+	PageFormat.readEncodedPages(path, cb);
+};
+
 exports.setSettingDir = function(path){
 	DrawerSetting.setSettingDir(path);
 };
 
+// Settings kept in memory (see setting-store.js): the directory (default the
+// setting dir) is read once, get(name) is a synchronous lookup, and while
+// opts.watch is on (the default) files changed by others are re-read.
+// opts.packed reads a file written by store.writePacked instead.
+exports.openSettingStore = function(dir, opts){
+	var store = new SettingStore(dir || DrawerSetting.getSettingDir());
+	opts = opts || {};
+	if( opts.packed ){
+		return store.loadPacked(opts.packed);
+	}
+	store.load();
+	if( opts.watch !== false ){
+		store.watch();
+	}
+	return store;
+};
+
 exports.printerDialog = function(optDefaultSetting){
 	if( optDefaultSetting ){
 		return api.printerDialog(optDefaultSetting.devmode, optDefaultSetting.devnames);
@@ -0,0 +1,393 @@
+#include "inflate.h"
+#include <string.h>
+
+enum {
+	STATE_HEADER,
+	STATE_BLOCK,
+	STATE_STORED,
+	STATE_HUFFMAN,
+	STATE_END
+};
+
+static const int FAST_BITS = 10;
+static const uint32_t WINDOW_MASK = 32767;
+
+static const uint16_t lengthBase[29] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+static const uint8_t lengthExtra[29] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+static const uint16_t distanceBase[30] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+static const uint8_t distanceExtra[30] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+static const uint8_t codeLengthOrder[19] = {
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+// Canonical Huffman code of the given code lengths (RFC 1951 3.2.2).
+static bool build_huffman(InflateHuffman *h, const uint8_t *lengths, int n){
+	uint16_t offsets[16], nextCode[16];
+	int i, len, left = 1;
+	memset(h->counts, 0, sizeof(h->counts));
+	memset(h->fast, 0, sizeof(h->fast));
+	for(i=0;i<n;i++){
+		h->counts[lengths[i]] += 1;
+	}
+	h->counts[0] = 0;
+	for(len=1;len<16;len++){
+		left = (left << 1) - h->counts[len];
+		if( left < 0 ){
+			return false;
+		}
+	}
+	offsets[1] = 0;
+	nextCode[1] = 0;
+	for(len=1;len<15;len++){
+		offsets[len + 1] = offsets[len] + h->counts[len];
+		nextCode[len + 1] = (uint16_t)((nextCode[len] + h->counts[len]) << 1);
+	}
+	for(i=0;i<n;i++){
+		len = lengths[i];
+		if( len == 0 ){
+			continue;
+		}
+		h->symbols[offsets[len]++] = (uint16_t)i;
+		uint32_t code = nextCode[len]++;
+		if( len <= FAST_BITS ){
+			// codes are stored most significant bit first
+			uint32_t reversed = 0, k;
+			for(k=0;k<(uint32_t)len;k++){
+				reversed |= ((code >> k) & 1) << (len - 1 - k);
+			}
+			for(k=reversed;k<(1u<<FAST_BITS);k+=1u<<len){
+				h->fast[k] = (uint16_t)((i << 4) | len);
+			}
+		}
+	}
+	return true;
+}
+
+Inflater::Inflater(InflateSource *source){
+	source_ = source;
+	in_ = NULL;
+	inLength_ = 0;
+	bitBuffer_ = 0;
+	bitCount_ = 0;
+	paddingBits_ = 0;
+	state_ = STATE_HEADER;
+	lastBlock_ = false;
+	storedLeft_ = 0;
+	copyLength_ = 0;
+	copyDistance_ = 0;
+	windowPos_ = 0;
+	total_ = 0;
+	adlerA_ = 1;
+	adlerB_ = 0;
+}
+
+bool Inflater::fail(const char *message, std::string *err){
+	*err = message;
+	return false;
+}
+
+uint8_t Inflater::nextByte(){
+	while( inLength_ == 0 ){
+		if( !source_->next(&in_, &inLength_) ){
+			inLength_ = 0;
+			paddingBits_ += 8;
+			return 0;
+		}
+	}
+	inLength_ -= 1;
+	return *in_++;
+}
+
+void Inflater::refill(){
+	while( bitCount_ <= 56 ){
+		bitBuffer_ |= (uint64_t)nextByte() << bitCount_;
+		bitCount_ += 8;
+	}
+}
+
+uint32_t Inflater::bits(int n){
+	if( bitCount_ < n ){
+		refill();
+	}
+	uint32_t value = (uint32_t)(bitBuffer_ & ((1u << n) - 1));
+	bitBuffer_ >>= n;
+	bitCount_ -= n;
+	return value;
+}
+
+// Next symbol of a code, or -1 for a bit sequence that is not a code.
+int Inflater::decode(const InflateHuffman &table){
+	if( bitCount_ < 15 ){
+		refill();
+	}
+	uint16_t fast = table.fast[bitBuffer_ & ((1u << FAST_BITS) - 1)];
+	if( fast ){
+		int len = fast & 15;
+		bitBuffer_ >>= len;
+		bitCount_ -= len;
+		return fast >> 4;
+	}
+	uint64_t b = bitBuffer_;
+	int code = 0, first = 0, index = 0, len;
+	for(len=1;len<16;len++){
+		code |= (int)(b & 1);
+		b >>= 1;
+		int count = table.counts[len];
+		if( code - count < first ){
+			bitBuffer_ >>= len;
+			bitCount_ -= len;
+			return table.symbols[index + (code - first)];
+		}
+		index += count;
+		first = (first + count) << 1;
+		code <<= 1;
+	}
+	return -1;
+}
+
+bool Inflater::readHeader(std::string *err){
+	uint32_t cmf = bits(8), flg = bits(8);
+	if( (cmf & 15) != 8 || (cmf >> 4) > 7 || ((cmf << 8) | flg) % 31 != 0 ){
+		return fail("invalid zlib header", err);
+	}
+	if( flg & 0x20 ){
+		return fail("zlib preset dictionary is not supported", err);
+	}
+	state_ = STATE_BLOCK;
+	return true;
+}
+
+bool Inflater::readDynamicTables(std::string *err){
+	uint8_t lengths[286 + 30];
+	InflateHuffman codeLengths;
+	int literalCount = bits(5) + 257;
+	int distanceCount = bits(5) + 1;
+	int codeLengthCount = bits(4) + 4;
+	int i, n = 0;
+	if( literalCount > 286 || distanceCount > 30 ){
+		return fail("invalid deflate table sizes", err);
+	}
+	memset(lengths, 0, sizeof(lengths));
+	for(i=0;i<codeLengthCount;i++){
+		lengths[codeLengthOrder[i]] = (uint8_t)bits(3);
+	}
+	if( !build_huffman(&codeLengths, lengths, 19) ){
+		return fail("invalid deflate code lengths", err);
+	}
+	while( n < literalCount + distanceCount ){
+		int symbol = decode(codeLengths);
+		int repeat;
+		uint8_t value = 0;
+		if( symbol < 0 ){
+			return fail("invalid deflate code lengths", err);
+		}
+		if( symbol < 16 ){
+			lengths[n++] = (uint8_t)symbol;
+			continue;
+		}
+		if( symbol == 16 ){
+			if( n == 0 ){
+				return fail("invalid deflate code lengths", err);
+			}
+			value = lengths[n - 1];
+			repeat = 3 + bits(2);
+		} else if( symbol == 17 ){
+			repeat = 3 + bits(3);
+		} else {
+			repeat = 11 + bits(7);
+		}
+		if( n + repeat > literalCount + distanceCount ){
+			return fail("invalid deflate code lengths", err);
+		}
+		memset(lengths + n, value, repeat);
+		n += repeat;
+	}
+	if( lengths[256] == 0 ){
+		return fail("missing end of block code", err);
+	}
+	if( !build_huffman(&literals_, lengths, literalCount) ||
+			!build_huffman(&distances_, lengths + literalCount, distanceCount) ){
+		return fail("invalid deflate codes", err);
+	}
+	return true;
+}
+
+bool Inflater::readBlockHeader(std::string *err){
+	lastBlock_ = bits(1) != 0;
+	uint32_t type = bits(2);
+	if( type == 0 ){
+		// stored: byte aligned LEN and NLEN
+		bits(bitCount_ & 7);
+		uint32_t length = bits(16), check = bits(16);
+		if( (length ^ 0xffff) != check ){
+			return fail("invalid stored block length", err);
+		}
+		storedLeft_ = length;
+		state_ = length > 0 ? STATE_STORED : lastBlock_ ? STATE_END : STATE_BLOCK;
+		return true;
+	}
+	if( type == 1 ){
+		uint8_t lengths[288 + 30];
+		memset(lengths, 8, 144);
+		memset(lengths + 144, 9, 112);
+		memset(lengths + 256, 7, 24);
+		memset(lengths + 280, 8, 8);
+		memset(lengths + 288, 5, 30);
+		build_huffman(&literals_, lengths, 288);
+		build_huffman(&distances_, lengths + 288, 30);
+	} else if( type == 2 ){
+		if( !readDynamicTables(err) ){
+			return false;
+		}
+	} else {
+		return fail("invalid deflate block type", err);
+	}
+	state_ = STATE_HUFFMAN;
+	return true;
+}
+
+void Inflater::updateAdler(const uint8_t *data, size_t length){
+	uint32_t a = adlerA_, b = adlerB_;
+	while( length > 0 ){
+		// largest run that cannot overflow b
+		size_t n = length < 5552 ? length : 5552, i;
+		for(i=0;i<n;i++){
+			a += data[i];
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+		data += n;
+		length -= n;
+	}
+	adlerA_ = a;
+	adlerB_ = b;
+}
+
+// Produces up to length bytes, stopping early at the end of the stream.
+bool Inflater::produce(uint8_t *out, size_t length, size_t *produced, std::string *err){
+	size_t done = 0;
+	if( state_ == STATE_HEADER && !readHeader(err) ){
+		return false;
+	}
+	while( done < length ){
+		if( copyLength_ > 0 ){
+			uint32_t n = copyLength_;
+			if( n > length - done ){
+				n = (uint32_t)(length - done);
+			}
+			copyLength_ -= n;
+			while( n > 0 ){
+				uint32_t from = (windowPos_ - copyDistance_) & WINDOW_MASK;
+				uint32_t chunk = n;
+				// up to the end of the window on either side
+				if( chunk > WINDOW_MASK + 1 - from ){
+					chunk = WINDOW_MASK + 1 - from;
+				}
+				if( chunk > WINDOW_MASK + 1 - windowPos_ ){
+					chunk = WINDOW_MASK + 1 - windowPos_;
+				}
+				if( copyDistance_ >= chunk ){
+					memmove(window_ + windowPos_, window_ + from, chunk);
+				} else {
+					// overlapping run: repeats the last copyDistance_ bytes
+					uint32_t k;
+					for(k=0;k<chunk;k++){
+						window_[windowPos_ + k] = window_[from + k];
+					}
+				}
+				memcpy(out + done, window_ + windowPos_, chunk);
+				windowPos_ = (windowPos_ + chunk) & WINDOW_MASK;
+				done += chunk;
+				n -= chunk;
+			}
+		} else if( state_ == STATE_HUFFMAN ){
+			int symbol = decode(literals_);
+			if( symbol < 256 ){
+				if( symbol < 0 ){
+					return fail("invalid deflate code", err);
+				}
+				window_[windowPos_] = (uint8_t)symbol;
+				windowPos_ = (windowPos_ + 1) & WINDOW_MASK;
+				out[done++] = (uint8_t)symbol;
+			} else if( symbol == 256 ){
+				state_ = lastBlock_ ? STATE_END : STATE_BLOCK;
+			} else {
+				symbol -= 257;
+				if( symbol >= 29 ){
+					return fail("invalid deflate length code", err);
+				}
+				copyLength_ = lengthBase[symbol] + bits(lengthExtra[symbol]);
+				int d = decode(distances_);
+				if( d < 0 || d >= 30 ){
+					return fail("invalid deflate distance code", err);
+				}
+				copyDistance_ = distanceBase[d] + bits(distanceExtra[d]);
+				if( copyDistance_ > total_ + done ){
+					return fail("deflate distance too far back", err);
+				}
+			}
+		} else if( state_ == STATE_STORED ){
+			uint8_t b = (uint8_t)bits(8);
+			window_[windowPos_] = b;
+			windowPos_ = (windowPos_ + 1) & WINDOW_MASK;
+			out[done++] = b;
+			if( --storedLeft_ == 0 ){
+				state_ = lastBlock_ ? STATE_END : STATE_BLOCK;
+			}
+		} else if( state_ == STATE_BLOCK ){
+			if( !readBlockHeader(err) ){
+				return false;
+			}
+		} else {
+			break;
+		}
+		if( bitCount_ < paddingBits_ ){
+			return fail("truncated deflate data", err);
+		}
+	}
+	updateAdler(out, done);
+	total_ += done;
+	*produced = done;
+	return true;
+}
+
+bool Inflater::read(uint8_t *out, size_t length, std::string *err){
+	size_t produced;
+	if( !produce(out, length, &produced, err) ){
+		return false;
+	}
+	if( produced < length ){
+		return fail("not enough image data", err);
+	}
+	return true;
+}
+
+bool Inflater::finish(std::string *err){
+	uint8_t scratch[256];
+	size_t produced;
+	while( state_ != STATE_END || copyLength_ > 0 ){
+		if( !produce(scratch, sizeof(scratch), &produced, err) ){
+			return false;
+		}
+	}
+	bits(bitCount_ & 7);
+	uint32_t adler = bits(8) << 24;
+	adler |= bits(8) << 16;
+	adler |= bits(8) << 8;
+	adler |= bits(8);
+	if( bitCount_ < paddingBits_ ){
+		return fail("truncated deflate data", err);
+	}
+	if( adler != ((adlerB_ << 16) | adlerA_) ){
+		return fail("zlib checksum mismatch", err);
+	}
+	return true;
+}
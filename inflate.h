@@ -0,0 +1,76 @@
+#ifndef DRAWER_INFLATE_H
+#define DRAWER_INFLATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+// Where an Inflater gets its compressed bytes from: the IDAT chunks of a
+// PNG, which split one zlib stream at arbitrary places.
+class InflateSource {
+public:
+	virtual ~InflateSource(){}
+	// Next span of input; false at the end of the input.
+	virtual bool next(const uint8_t **data, size_t *length) = 0;
+};
+
+struct InflateHuffman {
+	// lookup of the first FAST_BITS bits: (symbol << 4) | code length, or 0
+	// for the longer codes, which are decoded bit by bit
+	uint16_t fast[1 << 10];
+	uint16_t counts[16];
+	uint16_t symbols[288];
+};
+
+// Decompresses a zlib stream (RFC 1950/1951) on demand: read() produces the
+// next bytes of the output, so a caller can take one image row at a time and
+// only the 32 KB window is kept.
+class Inflater {
+public:
+	explicit Inflater(InflateSource *source);
+
+	// Exactly length bytes of output; fails on corrupt or truncated data.
+	bool read(uint8_t *out, size_t length, std::string *err);
+	// Reads to the end of the stream (trailing output is ignored) and checks
+	// the Adler-32 checksum.
+	bool finish(std::string *err);
+
+	// Output bytes produced so far.
+	uint64_t total() const { return total_; }
+
+private:
+	bool fail(const char *message, std::string *err);
+	bool readHeader(std::string *err);
+	bool readBlockHeader(std::string *err);
+	bool readDynamicTables(std::string *err);
+	bool produce(uint8_t *out, size_t length, size_t *produced, std::string *err);
+	int decode(const InflateHuffman &table);
+	void refill();
+	uint32_t bits(int n);
+	uint8_t nextByte();
+	void updateAdler(const uint8_t *data, size_t length);
+
+	InflateSource *source_;
+	const uint8_t *in_;
+	size_t inLength_;
+	uint64_t bitBuffer_;
+	int bitCount_;
+	// zero bytes fed to the bit buffer past the end of the input
+	int paddingBits_;
+
+	int state_;
+	bool lastBlock_;
+	uint32_t storedLeft_;
+	uint32_t copyLength_;
+	uint32_t copyDistance_;
+	InflateHuffman literals_;
+	InflateHuffman distances_;
+
+	uint8_t window_[32768];
+	uint32_t windowPos_;
+	uint64_t total_;
+	uint32_t adlerA_;
+	uint32_t adlerB_;
+};
+
+#endif
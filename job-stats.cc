@@ -0,0 +1,392 @@
+#include "job-stats.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+
+int64_t stats_now(){
+	return std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Exact below 2^7, then 2^6 buckets per power of two: the bucket of v is
+// v >> shift with shift chosen to leave 7 significant bits.
+static const int SUB_BITS = 7;
+static const int64_t SUB_COUNT = (int64_t)1 << SUB_BITS;
+static const int64_t HALF_COUNT = SUB_COUNT / 2;
+static const int64_t MAX_VALUE = ((int64_t)1 << 38) - 1;
+static const size_t BUCKETS = (size_t)(SUB_COUNT + (38 - SUB_BITS) * HALF_COUNT);
+
+static size_t bucket_index(int64_t v){
+	if( v < SUB_COUNT ){
+		return (size_t)v;
+	}
+	int shift = 0;
+	while( (v >> shift) >= SUB_COUNT ){
+		shift += 1;
+	}
+	return (size_t)(SUB_COUNT + (shift - 1) * HALF_COUNT + ((v >> shift) - HALF_COUNT));
+}
+
+static int64_t bucket_highest(size_t index){
+	if( (int64_t)index < SUB_COUNT ){
+		return (int64_t)index;
+	}
+	int shift = (int)(((int64_t)index - SUB_COUNT) / HALF_COUNT) + 1;
+	int64_t sub = ((int64_t)index - SUB_COUNT) % HALF_COUNT + HALF_COUNT;
+	return ((sub + 1) << shift) - 1;
+}
+
+LatencyHistogram::LatencyHistogram() : counts_(BUCKETS, 0) {
+	clear();
+}
+
+void LatencyHistogram::record(int64_t micros){
+	if( micros < 0 ){
+		micros = 0;
+	} else if( micros > MAX_VALUE ){
+		micros = MAX_VALUE;
+	}
+	counts_[bucket_index(micros)] += 1;
+	if( count_ == 0 || micros < min_ ){
+		min_ = micros;
+	}
+	if( count_ == 0 || micros > max_ ){
+		max_ = micros;
+	}
+	count_ += 1;
+	sum_ += (double)micros;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other){
+	size_t i;
+	if( other.count_ == 0 ){
+		return;
+	}
+	for(i=0;i<BUCKETS;i++){
+		counts_[i] += other.counts_[i];
+	}
+	if( count_ == 0 || other.min_ < min_ ){
+		min_ = other.min_;
+	}
+	if( count_ == 0 || other.max_ > max_ ){
+		max_ = other.max_;
+	}
+	count_ += other.count_;
+	sum_ += other.sum_;
+}
+
+void LatencyHistogram::clear(){
+	size_t i;
+	for(i=0;i<BUCKETS;i++){
+		counts_[i] = 0;
+	}
+	count_ = 0;
+	min_ = 0;
+	max_ = 0;
+	sum_ = 0;
+}
+
+int64_t LatencyHistogram::percentile(double p) const {
+	if( count_ == 0 ){
+		return 0;
+	}
+	if( p < 0 ){
+		p = 0;
+	} else if( p > 100 ){
+		p = 100;
+	}
+	uint64_t target = (uint64_t)ceil(p / 100 * (double)count_);
+	uint64_t seen = 0;
+	size_t i;
+	if( target < 1 ){
+		target = 1;
+	}
+	for(i=0;i<BUCKETS;i++){
+		seen += counts_[i];
+		if( seen >= target ){
+			int64_t value = bucket_highest(i);
+			return value < max_ ? value : max_;
+		}
+	}
+	return max_;
+}
+
+const char *job_phase_name(int phase){
+	switch(phase){
+		case PHASE_OPEN: return "open";
+		case PHASE_START_DOC: return "startDoc";
+		case PHASE_RENDER: return "render";
+		case PHASE_END_PAGE: return "endPage";
+		case PHASE_END_DOC: return "endDoc";
+		case PHASE_CLOSE: return "close";
+		case PHASE_TOTAL: return "total";
+		default: return "unknown";
+	}
+}
+
+JobStats::JobStats(){
+	int i;
+	jobId = 0;
+	start = 0;
+	end = 0;
+	for(i=0;i<PHASE_COUNT;i++){
+		phases[i] = -1;
+	}
+	gdiCalls = 0;
+	textRuns = 0;
+	objectsCreated = 0;
+	objectsDeleted = 0;
+	pages = 0;
+	ops = 0;
+	imageBytes = 0;
+	mark_ = 0;
+}
+
+void JobStats::begin(int64_t now){
+	start = now;
+}
+
+int64_t JobStats::enter(){
+	int64_t now = stats_now();
+	if( mark_ > 0 && now > mark_ ){
+		add(PHASE_RENDER, mark_, now);
+	}
+	return now;
+}
+
+void JobStats::leave(int phase, int64_t started){
+	int64_t now = stats_now();
+	add(phase, started, now);
+	mark_ = now;
+}
+
+void JobStats::add(int phase, int64_t from, int64_t to){
+	int64_t duration = to > from ? to - from : 0;
+	phases[phase] = (phases[phase] > 0 ? phases[phase] : 0) + duration;
+	if( events.size() < JOB_STATS_MAX_EVENTS ){
+		JobEvent event;
+		event.phase = phase;
+		event.start = from;
+		event.duration = duration;
+		events.push_back(event);
+	}
+}
+
+void JobStats::finish(const char *finalStatus){
+	end = stats_now();
+	status = finalStatus;
+	phases[PHASE_TOTAL] = end > start ? end - start : 0;
+}
+
+bool StatsDevice::startDoc(const uint16_t *jobName, uint32_t length){
+	int64_t t = stats_->enter();
+	bool ok = device_->startDoc(jobName, length);
+	stats_->leave(PHASE_START_DOC, t);
+	stats_->gdiCalls += 1;
+	return ok;
+}
+
+bool StatsDevice::endDoc(){
+	int64_t t = stats_->enter();
+	bool ok = device_->endDoc();
+	stats_->leave(PHASE_END_DOC, t);
+	stats_->gdiCalls += 1;
+	return ok;
+}
+
+bool StatsDevice::abortDoc(){
+	int64_t t = stats_->enter();
+	bool ok = device_->abortDoc();
+	stats_->leave(PHASE_END_DOC, t);
+	stats_->gdiCalls += 1;
+	return ok;
+}
+
+bool StatsDevice::startPage(){
+	stats_->gdiCalls += 1;
+	return device_->startPage();
+}
+
+bool StatsDevice::endPage(){
+	int64_t t = stats_->enter();
+	bool ok = device_->endPage();
+	stats_->leave(PHASE_END_PAGE, t);
+	stats_->gdiCalls += 1;
+	stats_->pages += 1;
+	return ok;
+}
+
+bool StatsDevice::moveTo(long x, long y){
+	stats_->gdiCalls += 1;
+	return device_->moveTo(x, y);
+}
+
+bool StatsDevice::lineTo(long x, long y){
+	stats_->gdiCalls += 1;
+	return device_->lineTo(x, y);
+}
+
+bool StatsDevice::polyPolyline(const long *points, const uint32_t *counts, uint32_t polylines){
+	stats_->gdiCalls += 1;
+	return device_->polyPolyline(points, counts, polylines);
+}
+
+bool StatsDevice::fillRect(long left, long top, long right, long bottom, int r, int g, int b){
+	stats_->gdiCalls += 1;
+	return device_->fillRect(left, top, right, bottom, r, g, b);
+}
+
+bool StatsDevice::textOut(long x, long y, const uint16_t *text, uint32_t length){
+	stats_->gdiCalls += 1;
+	stats_->textRuns += 1;
+	return device_->textOut(x, y, text, length);
+}
+
+bool StatsDevice::textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances){
+	stats_->gdiCalls += 1;
+	stats_->textRuns += 1;
+	return device_->textRun(x, y, text, length, advances);
+}
+
+bool StatsDevice::setTextColor(int r, int g, int b){
+	stats_->gdiCalls += 1;
+	return device_->setTextColor(r, g, b);
+}
+
+bool StatsDevice::setBkTransparent(){
+	stats_->gdiCalls += 1;
+	return device_->setBkTransparent();
+}
+
+DeviceHandle StatsDevice::createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic){
+	DeviceHandle handle = device_->createFont(face, faceLength, height, weight, italic);
+	stats_->gdiCalls += 1;
+	stats_->objectsCreated += handle != 0;
+	return handle;
+}
+
+DeviceHandle StatsDevice::createPen(long width, int r, int g, int b){
+	DeviceHandle handle = device_->createPen(width, r, g, b);
+	stats_->gdiCalls += 1;
+	stats_->objectsCreated += handle != 0;
+	return handle;
+}
+
+bool StatsDevice::selectObject(DeviceHandle handle){
+	stats_->gdiCalls += 1;
+	return device_->selectObject(handle);
+}
+
+bool StatsDevice::deleteObject(DeviceHandle handle){
+	bool ok = device_->deleteObject(handle);
+	stats_->gdiCalls += 1;
+	stats_->objectsDeleted += ok;
+	return ok;
+}
+
+JobStatsRegistry::JobStatsRegistry(size_t keepJobs){
+	enabled_ = false;
+	keepJobs_ = keepJobs;
+}
+
+void JobStatsRegistry::add(const JobStats &job){
+	std::lock_guard<std::mutex> lock(mutex_);
+	PrinterStats &printer = printers_[job.printer];
+	int i;
+	printer.name = job.printer;
+	printer.jobs += 1;
+	printer.failed += job.status != "done";
+	for(i=0;i<PHASE_COUNT;i++){
+		if( job.phases[i] >= 0 ){
+			printer.phases[i].record(job.phases[i]);
+		}
+	}
+	printer.gdiCalls += job.gdiCalls;
+	printer.textRuns += job.textRuns;
+	printer.objectsCreated += job.objectsCreated;
+	printer.objectsDeleted += job.objectsDeleted;
+	printer.pages += job.pages;
+	printer.imageBytes += job.imageBytes;
+	if( keepJobs_ > 0 ){
+		if( recent_.size() >= keepJobs_ ){
+			recent_.pop_front();
+		}
+		recent_.push_back(job);
+	}
+}
+
+std::vector<PrinterStats> JobStatsRegistry::printers(){
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::vector<PrinterStats> result;
+	std::map<std::string, PrinterStats>::const_iterator iter;
+	for(iter=printers_.begin();iter!=printers_.end();++iter){
+		result.push_back(iter->second);
+	}
+	return result;
+}
+
+static void json_string(std::string *out, const std::string &s){
+	char buf[8];
+	size_t i;
+	*out += '"';
+	for(i=0;i<s.size();i++){
+		unsigned char c = (unsigned char)s[i];
+		if( c == '"' || c == '\\' ){
+			*out += '\\';
+			*out += (char)c;
+		} else if( c < 0x20 ){
+			snprintf(buf, sizeof(buf), "\\u%04x", c);
+			*out += buf;
+		} else {
+			*out += (char)c;
+		}
+	}
+	*out += '"';
+}
+
+std::string JobStatsRegistry::traceJson(){
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	char buf[256];
+	size_t i, j;
+	bool first = true;
+	for(i=0;i<recent_.size();i++){
+		const JobStats &job = recent_[i];
+		char name[64];
+		snprintf(name, sizeof(name), " job %ld", job.jobId);
+		// one thread row per job, named after the printer
+		snprintf(buf, sizeof(buf), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%lu,"
+			"\"args\":{\"name\":", first ? "" : ",", (unsigned long)i + 1);
+		out += buf;
+		json_string(&out, job.printer + name);
+		out += "}}";
+		first = false;
+		snprintf(buf, sizeof(buf), ",{\"name\":\"job\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,"
+			"\"ts\":%lld,\"dur\":%lld,\"args\":{\"status\":", (unsigned long)i + 1,
+			(long long)job.start, (long long)(job.end - job.start));
+		out += buf;
+		json_string(&out, job.status);
+		snprintf(buf, sizeof(buf), ",\"pages\":%ld,\"ops\":%ld,\"gdiCalls\":%ld,\"textRuns\":%ld,"
+			"\"imageBytes\":%llu,\"objectsCreated\":%ld,\"objectsDeleted\":%ld}}",
+			job.pages, job.ops, job.gdiCalls, job.textRuns, (unsigned long long)job.imageBytes,
+			job.objectsCreated, job.objectsDeleted);
+		out += buf;
+		for(j=0;j<job.events.size();j++){
+			const JobEvent &event = job.events[j];
+			snprintf(buf, sizeof(buf), ",{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%lu,"
+				"\"ts\":%lld,\"dur\":%lld}", job_phase_name(event.phase), (unsigned long)i + 1,
+				(long long)event.start, (long long)event.duration);
+			out += buf;
+		}
+	}
+	out += "]}";
+	return out;
+}
+
+void JobStatsRegistry::clear(){
+	std::lock_guard<std::mutex> lock(mutex_);
+	printers_.clear();
+	recent_.clear();
+}
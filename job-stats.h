@@ -0,0 +1,180 @@
+#ifndef DRAWER_JOB_STATS_H
+#define DRAWER_JOB_STATS_H
+
+#include "device.h"
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Microseconds on a monotonic clock.
+int64_t stats_now();
+
+// Histogram of latencies in microseconds in the manner of HdrHistogram:
+// values below 128 are counted exactly and larger ones in 64 buckets per
+// power of two, so percentiles are within 1/64 of the recorded values up
+// to 2^38 us (76 hours; larger values count as that). Recording is an
+// index computation and an increment.
+class LatencyHistogram {
+public:
+	LatencyHistogram();
+
+	void record(int64_t micros);
+	void merge(const LatencyHistogram &other);
+	void clear();
+
+	uint64_t count() const { return count_; }
+	int64_t min() const { return count_ > 0 ? min_ : 0; }
+	int64_t max() const { return count_ > 0 ? max_ : 0; }
+	double mean() const { return count_ > 0 ? sum_ / count_ : 0; }
+	// Highest value of the bucket that holds percentile p (0-100), at most
+	// max().
+	int64_t percentile(double p) const;
+
+private:
+	std::vector<uint64_t> counts_;
+	uint64_t count_;
+	int64_t min_, max_;
+	double sum_;
+};
+
+enum JobPhase {
+	// creating or acquiring the DC
+	PHASE_OPEN,
+	// StartDoc
+	PHASE_START_DOC,
+	// everything between the other phases: drawing, and for jobs driven
+	// call by call from JS the time spent in JS
+	PHASE_RENDER,
+	// EndPage, where the driver renders the page
+	PHASE_END_PAGE,
+	// EndDoc (or AbortDoc), where the job is spooled
+	PHASE_END_DOC,
+	// releasing or deleting the DC
+	PHASE_CLOSE,
+	PHASE_TOTAL,
+	PHASE_COUNT
+};
+
+const char *job_phase_name(int phase);
+
+struct JobEvent {
+	int phase;
+	int64_t start;
+	int64_t duration;
+};
+
+// Events kept per job for the trace; the phase times still add up beyond.
+const size_t JOB_STATS_MAX_EVENTS = 2048;
+
+// Timing and counters of one job. A phase is timed with enter() and
+// leave(); the time since the previous phase left counts as rendering.
+struct JobStats {
+	std::string printer;
+	long jobId;
+	std::string status;
+	int64_t start, end;
+	// microseconds per phase, -1 for phases the job did not go through
+	int64_t phases[PHASE_COUNT];
+	long gdiCalls;
+	long textRuns;
+	long objectsCreated;
+	long objectsDeleted;
+	long pages;
+	long ops;
+	uint64_t imageBytes;
+	std::vector<JobEvent> events;
+
+	JobStats();
+	void begin(int64_t now);
+	int64_t enter();
+	void leave(int phase, int64_t started);
+	void add(int phase, int64_t from, int64_t to);
+	void finish(const char *status);
+
+private:
+	int64_t mark_;
+};
+
+// Device that forwards to another one and counts the calls into a
+// JobStats, timing StartDoc, EndPage and EndDoc. Jobs only go through it
+// while stats are enabled.
+class StatsDevice : public Device {
+public:
+	StatsDevice(Device *device, JobStats *stats) : device_(device), stats_(stats) {}
+
+	int dpix(){ return device_->dpix(); }
+	int dpiy(){ return device_->dpiy(); }
+
+	bool startDoc(const uint16_t *jobName, uint32_t length);
+	bool endDoc();
+	bool abortDoc();
+	bool startPage();
+	bool endPage();
+
+	bool moveTo(long x, long y);
+	bool lineTo(long x, long y);
+	bool polyPolyline(const long *points, const uint32_t *counts, uint32_t polylines);
+	bool fillRect(long left, long top, long right, long bottom, int r, int g, int b);
+	bool textOut(long x, long y, const uint16_t *text, uint32_t length);
+	bool textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances);
+	bool setTextColor(int r, int g, int b);
+	bool setBkTransparent();
+
+	DeviceHandle createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic);
+	DeviceHandle createPen(long width, int r, int g, int b);
+	bool selectObject(DeviceHandle handle);
+	bool deleteObject(DeviceHandle handle);
+
+private:
+	Device *device_;
+	JobStats *stats_;
+};
+
+struct PrinterStats {
+	std::string name;
+	long jobs;
+	long failed;
+	LatencyHistogram phases[PHASE_COUNT];
+	long gdiCalls;
+	long textRuns;
+	long objectsCreated;
+	long objectsDeleted;
+	long pages;
+	uint64_t imageBytes;
+
+	PrinterStats() : jobs(0), failed(0), gdiCalls(0), textRuns(0), objectsCreated(0),
+		objectsDeleted(0), pages(0), imageBytes(0) {}
+};
+
+// Latency histograms and counters per printer of the jobs finished while
+// stats were enabled, and the last jobs for a trace. Disabled by default;
+// callers check enabled() before they time anything. Thread-safe.
+class JobStatsRegistry {
+public:
+	explicit JobStatsRegistry(size_t keepJobs);
+
+	void setEnabled(bool enabled){ enabled_ = enabled; }
+	bool enabled() const { return enabled_; }
+
+	void add(const JobStats &job);
+	std::vector<PrinterStats> printers();
+	// Chrome trace event JSON (chrome://tracing, Perfetto) of the kept jobs:
+	// one row per job with its phases.
+	std::string traceJson();
+	void clear();
+
+private:
+	std::atomic<bool> enabled_;
+	std::mutex mutex_;
+	size_t keepJobs_;
+	std::map<std::string, PrinterStats> printers_;
+	std::deque<JobStats> recent_;
+};
+
+#endif
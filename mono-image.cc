@@ -0,0 +1,429 @@
+#include "mono-image.h"
+#include <atomic>
+#include <math.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define MONO_X86 1
+#include <emmintrin.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+// MSVC compiles AVX2 intrinsics without a target flag.
+#define MONO_TARGET_AVX2
+#else
+#define MONO_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+static uint8_t reverseBits[256];
+
+static void init_reverse_bits(){
+	int i, k;
+	for(i=0;i<256;i++){
+		int r = 0;
+		for(k=0;k<8;k++){
+			if( i & (1 << k) ){
+				r |= 0x80 >> k;
+			}
+		}
+		reverseBits[i] = (uint8_t)r;
+	}
+}
+
+static inline uint32_t load_u32(const uint8_t *p){
+	uint32_t value;
+	memcpy(&value, p, 4);
+	return value;
+}
+
+// Scalar kernels; also used for the tails of the SIMD ones.
+
+static void luma_scalar(const uint8_t *bgr, uint32_t bytesPerPixel, uint32_t n, uint8_t *gray){
+	uint32_t i;
+	for(i=0;i<n;i++){
+		const uint8_t *p = bgr + (size_t)i * bytesPerPixel;
+		gray[i] = (uint8_t)((29 * p[0] + 150 * p[1] + 77 * p[2] + 128) >> 8);
+	}
+}
+
+static void pack_scalar(const uint8_t *gray, uint32_t start, uint32_t n,
+		const uint8_t thresholds[8], uint8_t *bits){
+	uint32_t x;
+	for(x=start;x<n;x++){
+		uint8_t bit = (uint8_t)(0x80 >> (x & 7));
+		if( (x & 7) == 0 ){
+			bits[x >> 3] = 0;
+		}
+		if( gray[x] > thresholds[x & 7] ){
+			bits[x >> 3] |= bit;
+		}
+	}
+}
+
+#ifdef MONO_X86
+
+// Four BGR(x) pixels in the low bytes of 32-bit lanes. For 3 bytes per pixel
+// the fourth byte belongs to the next pixel and is ignored.
+static inline __m128i load4_sse2(const uint8_t *p, uint32_t bytesPerPixel){
+	if( bytesPerPixel == 4 ){
+		return _mm_loadu_si128((const __m128i *)p);
+	}
+	return _mm_setr_epi32((int)load_u32(p), (int)load_u32(p + 3),
+		(int)load_u32(p + 6), (int)load_u32(p + 9));
+}
+
+// 16-bit luma of 8 pixels. The weighted sum stays below 65536, so wrapping
+// 16-bit multiplies and a logical shift give the exact scalar result.
+static inline __m128i luma8_sse2(__m128i a, __m128i b){
+	const __m128i low = _mm_set1_epi32(0xff);
+	__m128i blue = _mm_packs_epi32(_mm_and_si128(a, low), _mm_and_si128(b, low));
+	__m128i green = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(a, 8), low),
+		_mm_and_si128(_mm_srli_epi32(b, 8), low));
+	__m128i red = _mm_packs_epi32(_mm_and_si128(_mm_srli_epi32(a, 16), low),
+		_mm_and_si128(_mm_srli_epi32(b, 16), low));
+	__m128i sum = _mm_add_epi16(_mm_mullo_epi16(blue, _mm_set1_epi16(29)),
+		_mm_mullo_epi16(green, _mm_set1_epi16(150)));
+	sum = _mm_add_epi16(sum, _mm_mullo_epi16(red, _mm_set1_epi16(77)));
+	sum = _mm_add_epi16(sum, _mm_set1_epi16(128));
+	return _mm_srli_epi16(sum, 8);
+}
+
+static void luma_sse2(const uint8_t *bgr, uint32_t bytesPerPixel, uint32_t n, uint8_t *gray){
+	uint32_t i = 0;
+	// with 3 bytes per pixel the last load reads one byte past the block
+	uint32_t extra = bytesPerPixel == 3 ? 1 : 0;
+	for(;i+16+extra<=n;i+=16){
+		const uint8_t *p = bgr + (size_t)i * bytesPerPixel;
+		__m128i lo = luma8_sse2(load4_sse2(p, bytesPerPixel),
+			load4_sse2(p + 4 * bytesPerPixel, bytesPerPixel));
+		__m128i hi = luma8_sse2(load4_sse2(p + 8 * bytesPerPixel, bytesPerPixel),
+			load4_sse2(p + 12 * bytesPerPixel, bytesPerPixel));
+		_mm_storeu_si128((__m128i *)(gray + i), _mm_packus_epi16(lo, hi));
+	}
+	luma_scalar(bgr + (size_t)i * bytesPerPixel, bytesPerPixel, n - i, gray + i);
+}
+
+static void pack_sse2(const uint8_t *gray, uint32_t n, const uint8_t thresholds[8], uint8_t *bits){
+	const __m128i sign = _mm_set1_epi8((char)0x80);
+	uint8_t pattern[16];
+	uint32_t x = 0;
+	memcpy(pattern, thresholds, 8);
+	memcpy(pattern + 8, thresholds, 8);
+	__m128i t = _mm_xor_si128(_mm_loadu_si128((const __m128i *)pattern), sign);
+	for(;x+16<=n;x+=16){
+		__m128i g = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(gray + x)), sign);
+		int mask = _mm_movemask_epi8(_mm_cmpgt_epi8(g, t));
+		bits[x >> 3] = reverseBits[mask & 0xff];
+		bits[(x >> 3) + 1] = reverseBits[(mask >> 8) & 0xff];
+	}
+	pack_scalar(gray, x, n, thresholds, bits);
+}
+
+MONO_TARGET_AVX2
+static inline __m256i luma16_avx2(__m256i a, __m256i b){
+	const __m256i low = _mm256_set1_epi32(0xff);
+	__m256i blue = _mm256_packs_epi32(_mm256_and_si256(a, low), _mm256_and_si256(b, low));
+	__m256i green = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(a, 8), low),
+		_mm256_and_si256(_mm256_srli_epi32(b, 8), low));
+	__m256i red = _mm256_packs_epi32(_mm256_and_si256(_mm256_srli_epi32(a, 16), low),
+		_mm256_and_si256(_mm256_srli_epi32(b, 16), low));
+	__m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(blue, _mm256_set1_epi16(29)),
+		_mm256_mullo_epi16(green, _mm256_set1_epi16(150)));
+	sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(red, _mm256_set1_epi16(77)));
+	sum = _mm256_add_epi16(sum, _mm256_set1_epi16(128));
+	return _mm256_srli_epi16(sum, 8);
+}
+
+MONO_TARGET_AVX2
+static inline __m256i load8_avx2(const uint8_t *p, uint32_t bytesPerPixel){
+	if( bytesPerPixel == 4 ){
+		return _mm256_loadu_si256((const __m256i *)p);
+	}
+	return _mm256_i32gather_epi32((const int *)p,
+		_mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21), 1);
+}
+
+MONO_TARGET_AVX2
+static void luma_avx2(const uint8_t *bgr, uint32_t bytesPerPixel, uint32_t n, uint8_t *gray){
+	uint32_t i = 0;
+	uint32_t extra = bytesPerPixel == 3 ? 1 : 0;
+	// packs work within 128-bit lanes; this puts the 4-pixel groups back in order
+	const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+	for(;i+32+extra<=n;i+=32){
+		const uint8_t *p = bgr + (size_t)i * bytesPerPixel;
+		__m256i lo = luma16_avx2(load8_avx2(p, bytesPerPixel),
+			load8_avx2(p + 8 * bytesPerPixel, bytesPerPixel));
+		__m256i hi = luma16_avx2(load8_avx2(p + 16 * bytesPerPixel, bytesPerPixel),
+			load8_avx2(p + 24 * bytesPerPixel, bytesPerPixel));
+		__m256i packed = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(lo, hi), order);
+		_mm256_storeu_si256((__m256i *)(gray + i), packed);
+	}
+	luma_sse2(bgr + (size_t)i * bytesPerPixel, bytesPerPixel, n - i, gray + i);
+}
+
+MONO_TARGET_AVX2
+static void pack_avx2(const uint8_t *gray, uint32_t n, const uint8_t thresholds[8], uint8_t *bits){
+	const __m256i sign = _mm256_set1_epi8((char)0x80);
+	uint8_t pattern[32];
+	uint32_t x = 0, k;
+	for(k=0;k<4;k++){
+		memcpy(pattern + 8 * k, thresholds, 8);
+	}
+	__m256i t = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)pattern), sign);
+	for(;x+32<=n;x+=32){
+		__m256i g = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(gray + x)), sign);
+		uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(g, t));
+		bits[x >> 3] = reverseBits[mask & 0xff];
+		bits[(x >> 3) + 1] = reverseBits[(mask >> 8) & 0xff];
+		bits[(x >> 3) + 2] = reverseBits[(mask >> 16) & 0xff];
+		bits[(x >> 3) + 3] = reverseBits[mask >> 24];
+	}
+	pack_sse2(gray + x, n - x, thresholds, bits + (x >> 3));
+}
+
+static int detect_level(){
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	int maxLeaf = info[0];
+	__cpuid(info, 1);
+	bool sse2 = (info[3] & (1 << 26)) != 0;
+	bool osxsave = (info[2] & (1 << 27)) != 0;
+	bool avx = (info[2] & (1 << 28)) != 0;
+	if( !sse2 ){
+		return MONO_SCALAR;
+	}
+	if( maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 6) == 6 ){
+		__cpuidex(info, 7, 0);
+		if( info[1] & (1 << 5) ){
+			return MONO_AVX2;
+		}
+	}
+	return MONO_SSE2;
+#else
+	__builtin_cpu_init();
+	if( __builtin_cpu_supports("avx2") ){
+		return MONO_AVX2;
+	}
+	return __builtin_cpu_supports("sse2") ? MONO_SSE2 : MONO_SCALAR;
+#endif
+}
+
+#else
+
+static int detect_level(){
+	return MONO_SCALAR;
+}
+
+#endif
+
+static std::atomic<int> supportedLevel(-1);
+static std::atomic<int> kernelLevel(-1);
+
+static int current_level(){
+	int level = kernelLevel.load(std::memory_order_relaxed);
+	if( level < 0 ){
+		init_reverse_bits();
+		supportedLevel = detect_level();
+		level = supportedLevel;
+		kernelLevel = level;
+	}
+	return level;
+}
+
+int mono_kernel_level(){
+	return current_level();
+}
+
+int mono_set_kernel_level(int level){
+	current_level();
+	if( level > supportedLevel ){
+		level = supportedLevel;
+	}
+	if( level < MONO_SCALAR ){
+		level = MONO_SCALAR;
+	}
+	kernelLevel = level;
+	return level;
+}
+
+const char *mono_kernel_name(int level){
+	switch(level){
+		case MONO_SCALAR: return "scalar";
+		case MONO_SSE2: return "sse2";
+		case MONO_AVX2: return "avx2";
+		default: return "unknown";
+	}
+}
+
+void mono_luma(const uint8_t *bgr, uint32_t bytesPerPixel, uint32_t n, uint8_t *gray){
+	switch(current_level()){
+#ifdef MONO_X86
+		case MONO_AVX2: luma_avx2(bgr, bytesPerPixel, n, gray); break;
+		case MONO_SSE2: luma_sse2(bgr, bytesPerPixel, n, gray); break;
+#endif
+		default: luma_scalar(bgr, bytesPerPixel, n, gray); break;
+	}
+}
+
+void mono_pack(const uint8_t *gray, uint32_t n, const uint8_t thresholds[8], uint8_t *bits){
+	switch(current_level()){
+#ifdef MONO_X86
+		case MONO_AVX2: pack_avx2(gray, n, thresholds, bits); break;
+		case MONO_SSE2: pack_sse2(gray, n, thresholds, bits); break;
+#endif
+		default: pack_scalar(gray, 0, n, thresholds, bits); break;
+	}
+}
+
+void mono_bayer_row(uint32_t y, uint8_t thresholds[8]){
+	static const uint8_t bayer[8][8] = {
+		{  0, 32,  8, 40,  2, 34, 10, 42 },
+		{ 48, 16, 56, 24, 50, 18, 58, 26 },
+		{ 12, 44,  4, 36, 14, 46,  6, 38 },
+		{ 60, 28, 52, 20, 62, 30, 54, 22 },
+		{  3, 35, 11, 43,  1, 33,  9, 41 },
+		{ 51, 19, 59, 27, 49, 17, 57, 25 },
+		{ 15, 47,  7, 39, 13, 45,  5, 37 },
+		{ 63, 31, 55, 23, 61, 29, 53, 21 }
+	};
+	int x;
+	for(x=0;x<8;x++){
+		thresholds[x] = (uint8_t)(bayer[y & 7][x] * 4 + 2);
+	}
+}
+
+void mono_diffuse_row(const uint8_t *gray, uint32_t n, uint32_t y, int threshold,
+		int16_t *errors, uint8_t *bits){
+	// errors of this row at [1, n], of the next one at [n + 3, 2n + 2]
+	int16_t *cur = errors + (y & 1 ? n + 2 : 0) + 1;
+	int16_t *next = errors + (y & 1 ? 0 : n + 2) + 1;
+	int dir = (y & 1) ? -1 : 1;
+	uint32_t i;
+	memset(next - 1, 0, (n + 2) * sizeof(int16_t));
+	memset(bits, 0, (n + 7) / 8);
+	for(i=0;i<n;i++){
+		long x = dir > 0 ? (long)i : (long)(n - 1 - i);
+		int value = gray[x] + cur[x];
+		int quant = value > threshold ? 255 : 0;
+		int e = value - quant;
+		if( quant ){
+			bits[x >> 3] |= (uint8_t)(0x80 >> (x & 7));
+		}
+		int e7 = e * 7 / 16, e3 = e * 3 / 16, e5 = e * 5 / 16;
+		cur[x + dir] += (int16_t)e7;
+		next[x - dir] += (int16_t)e3;
+		next[x] += (int16_t)e5;
+		next[x + dir] += (int16_t)(e - e7 - e3 - e5);
+	}
+}
+
+void mono_levels_table(double contrast, int brightness, uint8_t table[256]){
+	int i;
+	for(i=0;i<256;i++){
+		double value = floor((i - 128) * contrast + 128 + brightness + 0.5);
+		table[i] = (uint8_t)(value < 0 ? 0 : value > 255 ? 255 : value);
+	}
+}
+
+MonoConverter::MonoConverter(const MonoOptions &opts, uint32_t width) :
+		opts_(opts), width_(width), y_(0){
+	useLevels_ = opts.contrast != 1.0 || opts.brightness != 0;
+	if( useLevels_ ){
+		mono_levels_table(opts.contrast, opts.brightness, levels_);
+	}
+	threshold_ = opts.threshold < 0 ? 0 : opts.threshold > 255 ? 255 : opts.threshold;
+	memset(thresholds_, threshold_, 8);
+	if( opts.dither == MONO_DITHER_FLOYD_STEINBERG ){
+		errors_.assign(2 * (width + 2), 0);
+	}
+}
+
+void MonoConverter::convertRow(uint8_t *gray, uint8_t *bits){
+	uint32_t x;
+	if( useLevels_ ){
+		for(x=0;x<width_;x++){
+			gray[x] = levels_[gray[x]];
+		}
+	}
+	if( opts_.dither == MONO_DITHER_FLOYD_STEINBERG ){
+		mono_diffuse_row(gray, width_, y_, threshold_, &errors_[0], bits);
+	} else {
+		if( opts_.dither == MONO_DITHER_BAYER ){
+			mono_bayer_row(y_, thresholds_);
+		}
+		mono_pack(gray, width_, thresholds_, bits);
+	}
+	y_ += 1;
+}
+
+static void put_u32(uint8_t *p, uint32_t value){
+	p[0] = (uint8_t)value;
+	p[1] = (uint8_t)(value >> 8);
+	p[2] = (uint8_t)(value >> 16);
+	p[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t get_u32(const uint8_t *p){
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+bool bmp_to_mono(const BmpImage &image, const MonoOptions &opts,
+		std::vector<uint8_t> *out, std::string *err){
+	uint32_t width = image.width, height = image.height;
+	uint32_t bpp = image.bitsPerPixel;
+	uint32_t headerSize = get_u32(image.info);
+	if( bpp == 16 ){
+		*err = "16 bpp BMP is not supported";
+		return false;
+	}
+	if( image.compression == BMP_BITFIELDS && (get_u32(image.info + 40) != 0xff0000 ||
+			get_u32(image.info + 44) != 0xff00 || get_u32(image.info + 48) != 0xff) ){
+		*err = "unsupported BMP color masks";
+		return false;
+	}
+	// luma of the palette entries (BGRx after the header and masks)
+	uint8_t paletteGray[256];
+	if( bpp <= 8 ){
+		const uint8_t *palette = image.info + headerSize;
+		uint32_t colors = (image.infoLength - headerSize) / 4, i;
+		memset(paletteGray, 0, sizeof(paletteGray));
+		for(i=0;i<colors&&i<256;i++){
+			luma_scalar(palette + 4 * i, 4, 1, &paletteGray[i]);
+		}
+	}
+
+	std::vector<uint8_t> info;
+	make_dib_info(width, (int32_t)height, 1, &info);
+	uint32_t outStride = ((width + 31) / 32) * 4;
+	uint32_t offset = 14 + (uint32_t)info.size();
+	out->assign(offset + (size_t)outStride * height, 0);
+	uint8_t *p = &(*out)[0];
+	p[0] = 'B';
+	p[1] = 'M';
+	put_u32(p + 2, (uint32_t)out->size());
+	put_u32(p + 10, offset);
+	memcpy(p + 14, &info[0], info.size());
+	// resolution of the source
+	memcpy(p + 38, image.info + 24, 8);
+
+	MonoConverter converter(opts, width);
+	std::vector<uint8_t> gray(width);
+	uint32_t x, y;
+	for(y=0;y<height;y++){
+		uint32_t stored = image.bottomUp ? height - 1 - y : y;
+		const uint8_t *row = image.pixels + (size_t)stored * image.stride;
+		if( bpp >= 24 ){
+			mono_luma(row, bpp / 8, width, &gray[0]);
+		} else {
+			uint32_t perByte = 8 / bpp, mask = (1u << bpp) - 1;
+			for(x=0;x<width;x++){
+				uint32_t shift = 8 - bpp * (x % perByte + 1);
+				gray[x] = paletteGray[(row[x / perByte] >> shift) & mask];
+			}
+		}
+		converter.convertRow(&gray[0], p + offset + (size_t)(height - 1 - y) * outStride);
+	}
+	return true;
+}
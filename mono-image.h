@@ -0,0 +1,88 @@
+#ifndef DRAWER_MONO_IMAGE_H
+#define DRAWER_MONO_IMAGE_H
+
+#include "bmp-image.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Kernel sets, best last. mono_kernel_level() is the best one the CPU
+// supports unless lowered with mono_set_kernel_level (for tests and
+// benchmarks).
+enum MonoKernelLevel {
+	MONO_SCALAR = 0,
+	MONO_SSE2 = 1,
+	MONO_AVX2 = 2
+};
+
+int mono_kernel_level();
+// Returns the level actually used (at most what the CPU supports).
+int mono_set_kernel_level(int level);
+const char *mono_kernel_name(int level);
+
+// Luminance (77 R + 150 G + 29 B + 128) >> 8 of n BGR (bytesPerPixel 3) or
+// BGRx (4) pixels. All kernel levels give the same result.
+void mono_luma(const uint8_t *bgr, uint32_t bytesPerPixel, uint32_t n, uint8_t *gray);
+
+// Packs a row of gray values to 1 bit per pixel, most significant bit first:
+// 1 (white) where gray > thresholds[x % 8], 0 (black) elsewhere. The last
+// byte is padded with 0 bits.
+void mono_pack(const uint8_t *gray, uint32_t n, const uint8_t thresholds[8], uint8_t *bits);
+
+// Thresholds of row y of the 8x8 ordered (Bayer) dither matrix.
+void mono_bayer_row(uint32_t y, uint8_t thresholds[8]);
+
+// Floyd-Steinberg error diffusion of one row, left to right on even rows
+// and right to left on odd ones. errors holds 2 * (n + 2) values, the error
+// carried into this row and into the next one; zero them before row 0.
+void mono_diffuse_row(const uint8_t *gray, uint32_t n, uint32_t y, int threshold,
+	int16_t *errors, uint8_t *bits);
+
+// Maps gray values through (g - 128) * contrast + 128 + brightness.
+void mono_levels_table(double contrast, int brightness, uint8_t table[256]);
+
+enum MonoDither {
+	MONO_DITHER_NONE,
+	MONO_DITHER_BAYER,
+	MONO_DITHER_FLOYD_STEINBERG
+};
+
+struct MonoOptions {
+	int dither;
+	// 0-255, for MONO_DITHER_NONE and MONO_DITHER_FLOYD_STEINBERG
+	int threshold;
+	double contrast;
+	int brightness;
+
+	MonoOptions() : dither(MONO_DITHER_FLOYD_STEINBERG), threshold(128),
+		contrast(1.0), brightness(0) {}
+};
+
+// Converts rows of gray values, top row first, to 1 bpp rows with the
+// levels, threshold and dither of the options.
+class MonoConverter {
+public:
+	MonoConverter(const MonoOptions &opts, uint32_t width);
+
+	// gray (width values) is adjusted in place; bits gets (width + 7) / 8
+	// bytes.
+	void convertRow(uint8_t *gray, uint8_t *bits);
+
+private:
+	MonoOptions opts_;
+	uint32_t width_;
+	uint32_t y_;
+	bool useLevels_;
+	uint8_t levels_[256];
+	int threshold_;
+	uint8_t thresholds_[8];
+	std::vector<int16_t> errors_;
+};
+
+// Converts a 1/4/8 (palette), 24 or 32 bpp BMP to a 1 bpp BMP with a black
+// and white palette, one row at a time.
+bool bmp_to_mono(const BmpImage &image, const MonoOptions &opts,
+	std::vector<uint8_t> *out, std::string *err);
+
+#endif
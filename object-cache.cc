@@ -0,0 +1,142 @@
+#include "object-cache.h"
+#include <stdio.h>
+
+std::string font_cache_key(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic){
+	char buf[64];
+	sprintf(buf, "font %ld %ld %ld ", height, weight, italic ? 1L : 0L);
+	return std::string(buf) + std::string((const char *)face, faceLength * sizeof(uint16_t));
+}
+
+std::string pen_cache_key(int style, long width, int r, int g, int b){
+	char buf[64];
+	sprintf(buf, "pen %d %ld %d %d %d", style, width, r, g, b);
+	return std::string(buf);
+}
+
+ObjectCache::ObjectCache(ObjectFactory *factory, size_t capacity){
+	factory_ = factory;
+	capacity_ = capacity;
+	hits_ = 0;
+	misses_ = 0;
+	evictions_ = 0;
+	inUse_ = 0;
+}
+
+ObjectCache::~ObjectCache(){
+	EntryList::iterator iter;
+	for(iter=entries_.begin();iter!=entries_.end();++iter){
+		factory_->deleteObject(iter->handle);
+	}
+}
+
+DeviceHandle ObjectCache::acquireFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic){
+	return acquire(font_cache_key(face, faceLength, height, weight, italic), true,
+		face, faceLength, height, weight, italic, 0, 0, 0, 0);
+}
+
+DeviceHandle ObjectCache::acquirePen(int style, long width, int r, int g, int b){
+	return acquire(pen_cache_key(style, width, r, g, b), false,
+		NULL, 0, width, 0, 0, style, r, g, b);
+}
+
+DeviceHandle ObjectCache::acquire(const std::string &key, bool font, const uint16_t *face,
+		uint32_t faceLength, long height, long weight, long italic,
+		int style, int r, int g, int b){
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::map<std::string, EntryList::iterator>::iterator found = byKey_.find(key);
+	if( found != byKey_.end() ){
+		EntryList::iterator entry = found->second;
+		entries_.splice(entries_.begin(), entries_, entry);
+		if( entry->refs++ == 0 ){
+			inUse_ += 1;
+		}
+		hits_ += 1;
+		return entry->handle;
+	}
+	misses_ += 1;
+	DeviceHandle handle = font ?
+		factory_->createFont(face, faceLength, height, weight, italic) :
+		factory_->createPen(style, height, r, g, b);
+	if( !handle ){
+		return 0;
+	}
+	Entry entry;
+	entry.key = key;
+	entry.handle = handle;
+	entry.refs = 1;
+	entries_.push_front(entry);
+	byKey_[key] = entries_.begin();
+	byHandle_[handle] = entries_.begin();
+	inUse_ += 1;
+	evict(capacity_);
+	return handle;
+}
+
+bool ObjectCache::release(DeviceHandle handle){
+	std::lock_guard<std::mutex> lock(mutex_);
+	std::map<DeviceHandle, EntryList::iterator>::iterator found = byHandle_.find(handle);
+	if( found == byHandle_.end() ){
+		return false;
+	}
+	EntryList::iterator entry = found->second;
+	if( entry->refs > 0 && --entry->refs == 0 ){
+		inUse_ -= 1;
+		evict(capacity_);
+	}
+	return true;
+}
+
+bool ObjectCache::contains(DeviceHandle handle){
+	std::lock_guard<std::mutex> lock(mutex_);
+	return byHandle_.find(handle) != byHandle_.end();
+}
+
+// Deletes unused objects, least recently used first, until at most limit
+// objects are cached. Called with mutex_ held.
+void ObjectCache::evict(size_t limit){
+	EntryList::iterator iter = entries_.end();
+	while( entries_.size() > limit && iter != entries_.begin() ){
+		--iter;
+		if( iter->refs > 0 ){
+			continue;
+		}
+		EntryList::iterator victim = iter++;
+		factory_->deleteObject(victim->handle);
+		byKey_.erase(victim->key);
+		byHandle_.erase(victim->handle);
+		entries_.erase(victim);
+		evictions_ += 1;
+	}
+}
+
+void ObjectCache::setCapacity(size_t capacity){
+	std::lock_guard<std::mutex> lock(mutex_);
+	capacity_ = capacity;
+	evict(capacity_);
+}
+
+void ObjectCache::purge(){
+	std::lock_guard<std::mutex> lock(mutex_);
+	evict(0);
+}
+
+ObjectCacheStats ObjectCache::stats(){
+	std::lock_guard<std::mutex> lock(mutex_);
+	ObjectCacheStats stats;
+	stats.hits = hits_;
+	stats.misses = misses_;
+	stats.evictions = evictions_;
+	stats.size = (long)entries_.size();
+	stats.inUse = inUse_;
+	stats.capacity = (long)capacity_;
+	return stats;
+}
+
+void ObjectCache::resetStats(){
+	std::lock_guard<std::mutex> lock(mutex_);
+	hits_ = 0;
+	misses_ = 0;
+	evictions_ = 0;
+}
@@ -0,0 +1,87 @@
+#ifndef DRAWER_OBJECT_CACHE_H
+#define DRAWER_OBJECT_CACHE_H
+
+#include "device.h"
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+// PS_SOLID
+const int PEN_STYLE_SOLID = 0;
+
+// Creates and deletes the objects kept by an ObjectCache (CreateFontIndirectW,
+// CreatePen and DeleteObject for GDI).
+class ObjectFactory {
+public:
+	virtual ~ObjectFactory(){}
+	virtual DeviceHandle createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic) = 0;
+	virtual DeviceHandle createPen(int style, long width, int r, int g, int b) = 0;
+	virtual bool deleteObject(DeviceHandle handle) = 0;
+};
+
+struct ObjectCacheStats {
+	long hits;
+	long misses;
+	long evictions;
+	long size;
+	long inUse;
+	long capacity;
+};
+
+// Reference counted cache of fonts and pens, shared by all print jobs of the
+// process. Fonts are keyed by (face, height in device units, weight, italic)
+// and pens by (style, width, color). acquire* returns a handle with one more
+// reference (creating the object on a miss) and release() drops it; objects
+// without references stay cached and the least recently used ones are
+// deleted once there are more than capacity objects. Objects in use are
+// never deleted, so the cache may grow past capacity while they are held.
+//
+// All methods may be called from any thread.
+class ObjectCache {
+public:
+	ObjectCache(ObjectFactory *factory, size_t capacity);
+	~ObjectCache();
+
+	DeviceHandle acquireFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic);
+	DeviceHandle acquirePen(int style, long width, int r, int g, int b);
+	// Returns false if handle did not come from this cache.
+	bool release(DeviceHandle handle);
+	bool contains(DeviceHandle handle);
+
+	void setCapacity(size_t capacity);
+	// Deletes all objects that are not in use.
+	void purge();
+	ObjectCacheStats stats();
+	void resetStats();
+
+private:
+	struct Entry {
+		std::string key;
+		DeviceHandle handle;
+		long refs;
+	};
+	typedef std::list<Entry> EntryList;
+
+	DeviceHandle acquire(const std::string &key, bool font, const uint16_t *face,
+		uint32_t faceLength, long height, long weight, long italic,
+		int style, int r, int g, int b);
+	void evict(size_t limit);
+
+	std::mutex mutex_;
+	ObjectFactory *factory_;
+	size_t capacity_;
+	// most recently used first
+	EntryList entries_;
+	std::map<std::string, EntryList::iterator> byKey_;
+	std::map<DeviceHandle, EntryList::iterator> byHandle_;
+	long hits_, misses_, evictions_, inUse_;
+};
+
+std::string font_cache_key(const uint16_t *face, uint32_t faceLength,
+	long height, long weight, long italic);
+std::string pen_cache_key(int style, long width, int r, int g, int b);
+
+#endif
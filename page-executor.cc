@@ -0,0 +1,691 @@
+#include "page-executor.h"
+#include <algorithm>
+#include <math.h>
+
+std::string text_key(const uint16_t *text, uint32_t length){
+	return std::string((const char *)text, length * sizeof(uint16_t));
+}
+
+bool keeps_path(int code){
+	switch(code){
+		case OP_MOVE_TO: case OP_LINE_TO: case OP_POLYLINE: case OP_POLY_POLYLINE:
+		case OP_RECT: case OP_GRID:
+		case OP_PUSH: case OP_POP: case OP_TRANSLATE: case OP_SCALE: case OP_ROTATE:
+			return true;
+	}
+	return false;
+}
+
+// Converts n points of scratch->mmXs/mmYs (or of xs/ys when given) into
+// scratch->xs/ys.
+static bool convert_points(const PageOp &op, const Transform &t, int dpix, int dpiy,
+		const double *xs, size_t xstride, const double *ys, size_t ystride, size_t n,
+		PointScratch *scratch, std::string *err){
+	scratch->xs.resize(n);
+	scratch->ys.resize(n);
+	if( n == 0 ){
+		return true;
+	}
+	if( !xs ){
+		xs = &scratch->mmXs[0];
+		ys = &scratch->mmYs[0];
+		xstride = ystride = 1;
+	}
+	if( transform_points(t, dpix, dpiy, xs, xstride, ys, ystride, n, &scratch->xs[0], &scratch->ys[0]) < n ){
+		*err = std::string("invalid number to ") + op_code_name(op.code);
+		return false;
+	}
+	return true;
+}
+
+bool add_path_shapes(const Page &page, const PageOp &op, const Transform &t, int dpix, int dpiy,
+		PointScratch *scratch, PathBuilder *path, std::string *err){
+	size_t xstride, ystride;
+	uint32_t i, n;
+	switch(op.code){
+		case OP_POLYLINE: {
+			// the longer array, which the other one has to match unless it
+			// is a single value
+			n = op.xs.count > op.ys.count ? op.xs.count : op.ys.count;
+			if( n < 2 || (op.xs.count != 0 && op.xs.count < n) || (op.ys.count != 0 && op.ys.count < n) ){
+				*err = "too few coordinates to polyline";
+				return false;
+			}
+			const double *xs = page.coordArray(op.xs, n, &scratch->mmXs, &xstride);
+			const double *ys = page.coordArray(op.ys, n, &scratch->mmYs, &ystride);
+			if( !convert_points(op, t, dpix, dpiy, xs, xstride, ys, ystride, n, scratch, err) ){
+				return false;
+			}
+			path->addPolyline(&scratch->xs[0], &scratch->ys[0], n);
+			return true;
+		}
+		case OP_POLY_POLYLINE: {
+			uint32_t polylines = op.counts.count == 0 ? 1 : op.counts.count, total = 0, start;
+			for(i=0;i<polylines;i++){
+				double count = page.coordAt(op.counts, i);
+				if( !(count >= 2 && count <= 0x10000000) || count != floor(count) ){
+					*err = "invalid count to poly_polyline";
+					return false;
+				}
+				total += (uint32_t)count;
+				if( total > 0x10000000 ){
+					*err = "invalid count to poly_polyline";
+					return false;
+				}
+			}
+			if( (op.xs.count != 0 && op.xs.count < total) || (op.ys.count != 0 && op.ys.count < total) ){
+				*err = "too few coordinates to poly_polyline";
+				return false;
+			}
+			const double *xs = page.coordArray(op.xs, total, &scratch->mmXs, &xstride);
+			const double *ys = page.coordArray(op.ys, total, &scratch->mmYs, &ystride);
+			if( !convert_points(op, t, dpix, dpiy, xs, xstride, ys, ystride, total, scratch, err) ){
+				return false;
+			}
+			for(i=0,start=0;i<polylines;i++){
+				uint32_t count = (uint32_t)page.coordAt(op.counts, i);
+				path->addPolyline(&scratch->xs[start], &scratch->ys[start], count);
+				start += count;
+			}
+			return true;
+		}
+		case OP_RECT: {
+			double x = page.coordAt(op.xs, 0), y = page.coordAt(op.ys, 0);
+			double xs[] = { x, x + op.width, x + op.width, x, x };
+			double ys[] = { y, y, y + op.height, y + op.height, y };
+			if( !convert_points(op, t, dpix, dpiy, xs, 1, ys, 1, 5, scratch, err) ){
+				return false;
+			}
+			path->addPolyline(&scratch->xs[0], &scratch->ys[0], 5);
+			return true;
+		}
+		case OP_GRID: {
+			uint32_t nx = op.xs.count, ny = op.ys.count;
+			if( nx < 2 || ny < 2 ){
+				*err = "too few coordinates to grid";
+				return false;
+			}
+			double top = page.coordAt(op.ys, 0), bottom = page.coordAt(op.ys, ny - 1);
+			double left = page.coordAt(op.xs, 0), right = page.coordAt(op.xs, nx - 1);
+			// a vertical line per x, then a horizontal one per y
+			scratch->mmXs.resize((nx + ny) * 2);
+			scratch->mmYs.resize((nx + ny) * 2);
+			for(i=0;i<nx;i++){
+				scratch->mmXs[i * 2] = scratch->mmXs[i * 2 + 1] = page.coordAt(op.xs, i);
+				scratch->mmYs[i * 2] = top;
+				scratch->mmYs[i * 2 + 1] = bottom;
+			}
+			for(i=0;i<ny;i++){
+				scratch->mmXs[(nx + i) * 2] = left;
+				scratch->mmXs[(nx + i) * 2 + 1] = right;
+				scratch->mmYs[(nx + i) * 2] = scratch->mmYs[(nx + i) * 2 + 1] = page.coordAt(op.ys, i);
+			}
+			if( !convert_points(op, t, dpix, dpiy, 0, 0, 0, 0, (nx + ny) * 2, scratch, err) ){
+				return false;
+			}
+			for(i=0;i<nx+ny;i++){
+				path->addPolyline(&scratch->xs[i * 2], &scratch->ys[i * 2], 2);
+			}
+			return true;
+		}
+	}
+	return true;
+}
+
+bool fill_rect_pixels(const Page &page, const PageOp &op, const Transform &t, int dpix, int dpiy,
+		long *left, long *top, long *right, long *bottom, std::string *err){
+	double x = page.coordAt(op.xs, 0), y = page.coordAt(op.ys, 0);
+	double xs[] = { x, x + op.width };
+	double ys[] = { y, y + op.height };
+	long px[2], py[2];
+	if( !((t.b == 0 && t.c == 0) || (t.a == 0 && t.d == 0)) ){
+		*err = "fill_rect needs an axis-aligned transform";
+		return false;
+	}
+	if( transform_points(t, dpix, dpiy, xs, 1, ys, 1, 2, px, py) < 2 ){
+		*err = "invalid number to fill_rect";
+		return false;
+	}
+	*left = px[0] < px[1] ? px[0] : px[1];
+	*right = px[0] < px[1] ? px[1] : px[0];
+	*top = py[0] < py[1] ? py[0] : py[1];
+	*bottom = py[0] < py[1] ? py[1] : py[0];
+	return true;
+}
+
+bool apply_transform_op(const Page &page, const PageOp &op, TransformStack *stack, std::string *err){
+	double x = page.coordAt(op.xs, 0), y = page.coordAt(op.ys, 0);
+	switch(op.code){
+		case OP_PUSH: {
+			stack->push();
+			return true;
+		}
+		case OP_POP: {
+			if( !stack->pop() ){
+				*err = "pop without push";
+				return false;
+			}
+			return true;
+		}
+	}
+	if( isnan(x) || isnan(y) ){
+		*err = std::string("invalid number to ") + op_code_name(op.code);
+		return false;
+	}
+	if( op.code == OP_TRANSLATE ){
+		stack->translate(x, y);
+	} else if( op.code == OP_SCALE ){
+		stack->scale(x, y);
+	} else {
+		stack->rotate(x);
+	}
+	return true;
+}
+
+Transform offset_transform(const Transform &t, double dx, double dy){
+	Transform shifted = t;
+	shifted.e += mm_to_fixed(dx);
+	shifted.f += mm_to_fixed(dy);
+	return shifted;
+}
+
+PageExecutor::PageExecutor(Device *device){
+	device_ = device;
+	dpix_ = device->dpix();
+	dpiy_ = device->dpiy();
+	dx_ = 0;
+	dy_ = 0;
+	cancel_ = 0;
+	canceled_ = false;
+	opCount_ = 0;
+	skippedOps_ = 0;
+	copies_ = 1;
+	collate_ = true;
+	replay_ = true;
+	replayedPages_ = 0;
+	mergePaths_ = true;
+	optimize_ = false;
+	device_->setBkTransparent();
+}
+
+PageExecutor::~PageExecutor(){
+	dispose();
+}
+
+void PageExecutor::dispose(){
+	std::map<std::string, DeviceHandle>::iterator iter;
+	for(iter=fonts_.begin();iter!=fonts_.end();++iter){
+		device_->deleteObject(iter->second);
+	}
+	for(iter=pens_.begin();iter!=pens_.end();++iter){
+		device_->deleteObject(iter->second);
+	}
+	fonts_.clear();
+	pens_.clear();
+}
+
+bool PageExecutor::fail(const std::string &message){
+	error_ = message;
+	return false;
+}
+
+Transform PageExecutor::deviceTransform() const {
+	return offset_transform(transforms_.current(), dx_, dy_);
+}
+
+bool PageExecutor::point(const Page &page, const PageOp &op, long *x, long *y){
+	double mmX = page.coordAt(op.xs, 0);
+	double mmY = page.coordAt(op.ys, 0);
+	if( transform_points(deviceTransform(), dpix_, dpiy_, &mmX, 0, &mmY, 0, 1, x, y) == 0 ){
+		return fail(std::string("invalid number to ") + op_code_name(op.code));
+	}
+	return true;
+}
+
+void PageExecutor::registerObject(std::map<std::string, DeviceHandle> &dict,
+		const std::string &name, DeviceHandle handle){
+	std::map<std::string, DeviceHandle>::iterator iter = dict.find(name);
+	if( iter != dict.end() ){
+		device_->deleteObject(iter->second);
+		iter->second = handle;
+	} else {
+		dict[name] = handle;
+	}
+}
+
+bool PageExecutor::createFont(const Page &page, const PageOp &op){
+	long size = mm_to_pixel(dpiy_, transform_length(transforms_.current(), op.size));
+	long weight = op.weight ? FONT_WEIGHT_BOLD : 0;
+	long italic = op.italic ? 1 : 0;
+	DeviceHandle font = device_->createFont(page.textOf(op.face), op.face.length,
+		size, weight, italic);
+	if( !font ){
+		return fail("createFont failed: " + utf16_to_utf8(page.textOf(op.face), op.face.length));
+	}
+	registerObject(fonts_, text_key(page.textOf(op.name), op.name.length), font);
+	return true;
+}
+
+bool PageExecutor::createPen(const Page &page, const PageOp &op){
+	long width = mm_to_pixel(dpiy_, transform_length(transforms_.current(), op.size));
+	if( width < 0 ){
+		width = 1;
+	}
+	DeviceHandle pen = device_->createPen(width, op.r, op.g, op.b);
+	if( !pen ){
+		return fail("createPen failed");
+	}
+	registerObject(pens_, text_key(page.textOf(op.name), op.name.length), pen);
+	return true;
+}
+
+bool PageExecutor::selectKey(const std::string &key, std::map<std::string, DeviceHandle> &dict,
+		const char *what, int code){
+	std::map<std::string, DeviceHandle>::iterator iter = dict.find(key);
+	if( iter == dict.end() ){
+		return fail(std::string("unknown ") + what + ": " +
+			utf16_to_utf8((const uint16_t *)key.data(), (uint32_t)(key.size() / sizeof(uint16_t))));
+	}
+	if( !device_->selectObject(iter->second) ){
+		return fail(std::string(op_code_name(code)) + " failed");
+	}
+	return true;
+}
+
+bool PageExecutor::selectNamed(const Page &page, const PageOp &op,
+		std::map<std::string, DeviceHandle> &dict, const char *what){
+	return selectKey(text_key(page.textOf(op.name), op.name.length), dict, what, op.code);
+}
+
+// One text run per baseline instead of one TextOutW per character.
+bool PageExecutor::drawChars(const Page &page, const PageOp &op){
+	const uint16_t *text = page.textOf(op.text);
+	uint32_t i, n = op.text.length;
+	size_t xstride, ystride;
+	if( (op.xs.count != 0 && op.xs.count < n) || (op.ys.count != 0 && op.ys.count < n) ){
+		return fail("too few coordinates to drawChars");
+	}
+	if( n == 0 ){
+		return true;
+	}
+	xs_.resize(n);
+	ys_.resize(n);
+	advances_.resize(n);
+	const double *mmXs = page.coordArray(op.xs, n, &floatXs_, &xstride);
+	const double *mmYs = page.coordArray(op.ys, n, &floatYs_, &ystride);
+	i = (uint32_t)transform_points(deviceTransform(), dpix_, dpiy_, mmXs, xstride, mmYs, ystride, n,
+		&xs_[0], &ys_[0]);
+	if( i < n ){
+		return fail(isnan(page.coordAt(op.xs, i)) ? "invalid x to drawChars" : "invalid y to drawChars");
+	}
+	build_glyph_runs(&xs_[0], &ys_[0], n, &advances_[0], &runs_);
+	for(i=0;i<runs_.size();i++){
+		const GlyphRun &run = runs_[i];
+		if( !device_->textRun(run.x, run.y, text + run.start, run.count, &advances_[run.start]) ){
+			return fail("drawChars failed");
+		}
+	}
+	return true;
+}
+
+// Draws the lines collected so far.
+bool PageExecutor::flushPath(){
+	if( path_.empty() ){
+		return true;
+	}
+	const std::vector<long> &points = path_.points();
+	const std::vector<uint32_t> &counts = path_.counts();
+	if( !device_->polyPolyline(&points[0], &counts[0], (uint32_t)counts.size()) ){
+		return fail("polyPolyline failed");
+	}
+	path_.clear();
+	return true;
+}
+
+bool PageExecutor::lineTo(long x, long y){
+	if( mergePaths_ && path_.lineTo(x, y) ){
+		return true;
+	}
+	// from the device's current point, with nothing collected to keep under
+	// the line
+	if( !flushPath() ){
+		return false;
+	}
+	if( !device_->lineTo(x, y) ){
+		return fail("lineTo failed");
+	}
+	path_.setCurrent(x, y);
+	return true;
+}
+
+bool PageExecutor::fillRect(const Page &page, const PageOp &op){
+	long left, top, right, bottom;
+	if( !fill_rect_pixels(page, op, deviceTransform(), dpix_, dpiy_, &left, &top, &right, &bottom, &error_) ){
+		return false;
+	}
+	if( !device_->fillRect(left, top, right, bottom, op.r, op.g, op.b) ){
+		return fail("fillRect failed");
+	}
+	return true;
+}
+
+bool PageExecutor::runOps(const Page &page){
+	size_t i, n = page.ops.size();
+	long x, y;
+	for(i=0;i<n;i++){
+		const PageOp &op = page.ops[i];
+		if( cancel_ && cancel_->load() ){
+			canceled_ = true;
+			return fail("canceled");
+		}
+		opCount_ += 1;
+		if( !keeps_path(op.code) && !flushPath() ){
+			return false;
+		}
+		switch(op.code){
+			case OP_MOVE_TO: {
+				if( !point(page, op, &x, &y) ){
+					return false;
+				}
+				if( mergePaths_ ){
+					path_.moveTo(x, y);
+				} else if( !device_->moveTo(x, y) ){
+					return fail("moveTo failed");
+				}
+				break;
+			}
+			case OP_LINE_TO: {
+				if( !point(page, op, &x, &y) || !lineTo(x, y) ){
+					return false;
+				}
+				break;
+			}
+			case OP_POLYLINE: case OP_POLY_POLYLINE: case OP_RECT: case OP_GRID: {
+				if( !add_path_shapes(page, op, deviceTransform(), dpix_, dpiy_, &pathScratch_, &path_, &error_) ){
+					return false;
+				}
+				if( !mergePaths_ && !flushPath() ){
+					return false;
+				}
+				break;
+			}
+			case OP_FILL_RECT: {
+				if( !fillRect(page, op) ){
+					return false;
+				}
+				break;
+			}
+			case OP_CREATE_FONT: {
+				if( !createFont(page, op) ){
+					return false;
+				}
+				break;
+			}
+			case OP_SET_FONT: {
+				if( !selectNamed(page, op, fonts_, "font") ){
+					return false;
+				}
+				break;
+			}
+			case OP_SET_TEXT_COLOR: {
+				if( !device_->setTextColor(op.r, op.g, op.b) ){
+					return fail("setTextColor failed");
+				}
+				break;
+			}
+			case OP_CREATE_PEN: {
+				if( !createPen(page, op) ){
+					return false;
+				}
+				break;
+			}
+			case OP_SET_PEN: {
+				if( !selectNamed(page, op, pens_, "pen") ){
+					return false;
+				}
+				break;
+			}
+			case OP_DRAW_CHARS: {
+				if( !drawChars(page, op) ){
+					return false;
+				}
+				break;
+			}
+			case OP_PUSH: case OP_POP: case OP_TRANSLATE: case OP_SCALE: case OP_ROTATE: {
+				if( !apply_transform_op(page, op, &transforms_, &error_) ){
+					return false;
+				}
+				break;
+			}
+			default: {
+				skippedOps_ += 1;
+				break;
+			}
+		}
+	}
+	if( !flushPath() ){
+		return false;
+	}
+	// a trailing move_to still moves the device, as it did op by op
+	if( path_.takePendingMove(&x, &y) && !device_->moveTo(x, y) ){
+		return fail("moveTo failed");
+	}
+	return true;
+}
+
+bool PageExecutor::runPage(const Page &page){
+	if( !device_->startPage() ){
+		return fail("StartPage failed");
+	}
+	transforms_.reset();
+	path_.reset();
+	if( !runOps(page) ){
+		return false;
+	}
+	if( !device_->endPage() ){
+		return fail("EndPage failed");
+	}
+	return true;
+}
+
+bool PageExecutor::runList(const DisplayList &list){
+	const std::vector<DisplayItem> &items = list.items();
+	size_t i, n = items.size();
+	opCount_ += list.opCount();
+	skippedOps_ += list.skippedOps();
+	for(i=0;i<n;i++){
+		const DisplayItem &item = items[i];
+		if( cancel_ && cancel_->load() ){
+			canceled_ = true;
+			return fail("canceled");
+		}
+		switch(item.kind){
+			case DISPLAY_MOVE_TO: {
+				if( !device_->moveTo(item.x, item.y) ){
+					return fail("moveTo failed");
+				}
+				break;
+			}
+			case DISPLAY_LINE_TO: {
+				if( !device_->lineTo(item.x, item.y) ){
+					return fail("lineTo failed");
+				}
+				break;
+			}
+			case DISPLAY_POLY_POLYLINE: {
+				if( !device_->polyPolyline(list.pointsAt(item.points), list.countsAt(item.counts), item.length) ){
+					return fail("polyPolyline failed");
+				}
+				break;
+			}
+			case DISPLAY_FILL_RECT: {
+				if( !device_->fillRect(item.x, item.y, item.right, item.bottom, item.r, item.g, item.b) ){
+					return fail("fillRect failed");
+				}
+				break;
+			}
+			case DISPLAY_CREATE_FONT: {
+				DeviceHandle font = device_->createFont(list.textAt(item.text), item.length,
+					item.size, item.weight, item.italic);
+				if( !font ){
+					return fail("createFont failed: " + utf16_to_utf8(list.textAt(item.text), item.length));
+				}
+				registerObject(fonts_, list.name(item.name), font);
+				break;
+			}
+			case DISPLAY_SET_FONT: {
+				if( !selectKey(list.name(item.name), fonts_, "font", OP_SET_FONT) ){
+					return false;
+				}
+				break;
+			}
+			case DISPLAY_SET_TEXT_COLOR: {
+				if( !device_->setTextColor(item.r, item.g, item.b) ){
+					return fail("setTextColor failed");
+				}
+				break;
+			}
+			case DISPLAY_CREATE_PEN: {
+				DeviceHandle pen = device_->createPen(item.size, item.r, item.g, item.b);
+				if( !pen ){
+					return fail("createPen failed");
+				}
+				registerObject(pens_, list.name(item.name), pen);
+				break;
+			}
+			case DISPLAY_SET_PEN: {
+				if( !selectKey(list.name(item.name), pens_, "pen", OP_SET_PEN) ){
+					return false;
+				}
+				break;
+			}
+			case DISPLAY_TEXT_RUN: {
+				if( !device_->textRun(item.x, item.y, list.textAt(item.text), item.length,
+						list.advancesAt(item.advances)) ){
+					return fail("drawChars failed");
+				}
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+// slots[i] is the DisplayList of page i, or -1 for pages drawn only once.
+// Equal pages share a list; equality is checked after the hash.
+void PageExecutor::planReplay(const Page *const *pages, size_t count, std::vector<int> *slots){
+	std::vector<std::pair<uint64_t, size_t> > keys(count);
+	std::vector<size_t> group(count), members(count, 0);
+	size_t i, j, start;
+	slots->assign(count, -1);
+	lists_.clear();
+	listState_.clear();
+	if( !replay_ || (count < 2 && copies_ < 2) ){
+		return;
+	}
+	if( copies_ > 1 ){
+		// every page is replayed anyway; recording a duplicate again costs
+		// about what hashing all pages to find it would
+		for(i=0;i<count;i++){
+			(*slots)[i] = (int)i;
+			lists_.push_back(DisplayList());
+			listState_.push_back(0);
+		}
+		return;
+	}
+	for(i=0;i<count;i++){
+		keys[i] = std::make_pair(page_hash(*pages[i]), i);
+	}
+	std::sort(keys.begin(), keys.end());
+	for(start=0;start<count;start=i){
+		for(i=start;i<count && keys[i].first == keys[start].first;i++){
+			size_t page = keys[i].second;
+			group[page] = page;
+			for(j=start;j<i;j++){
+				size_t other = keys[j].second;
+				if( group[other] == other &&
+						(pages[other] == pages[page] || pages_equal(*pages[other], *pages[page])) ){
+					group[page] = other;
+					break;
+				}
+			}
+			members[group[page]] += 1;
+		}
+	}
+	std::vector<int> groupSlot(count, -1);
+	for(i=0;i<count;i++){
+		size_t first = group[i];
+		if( members[first] * copies_ < 2 ){
+			continue;
+		}
+		if( groupSlot[first] < 0 ){
+			groupSlot[first] = (int)lists_.size();
+			lists_.push_back(DisplayList());
+			listState_.push_back(0);
+		}
+		(*slots)[i] = groupSlot[first];
+	}
+}
+
+bool PageExecutor::drawJobPage(const Page &page, int slot){
+	if( slot >= 0 && listState_[slot] == 0 ){
+		std::string err;
+		// an invalid page is drawn op by op, to fail where runOps fails
+		lists_[slot].setMergePaths(mergePaths_);
+		listState_[slot] = lists_[slot].record(page, dpix_, dpiy_, dx_, dy_, &err) ? 1 : -1;
+	}
+	if( slot < 0 || listState_[slot] < 0 ){
+		return runPage(page);
+	}
+	replayedPages_ += 1;
+	if( !device_->startPage() ){
+		return fail("StartPage failed");
+	}
+	if( !runList(lists_[slot]) ){
+		return false;
+	}
+	if( !device_->endPage() ){
+		return fail("EndPage failed");
+	}
+	return true;
+}
+
+bool PageExecutor::runJob(const Page *const *pages, size_t count,
+		const uint16_t *jobName, uint32_t jobNameLength){
+	std::vector<int> slots;
+	std::vector<const Page *> optimizedPages;
+	size_t i, total = count * copies_;
+	replayedPages_ = 0;
+	if( optimize_ && count > 0 ){
+		// each page on its own: they may be drawn in any order with copies
+		optimized_.resize(count);
+		for(i=0;i<count;i++){
+			optimizedPages.push_back(&optimizer_.optimize(*pages[i], &optimized_[i]));
+		}
+		pages = &optimizedPages[0];
+	}
+	planReplay(pages, count, &slots);
+	if( !device_->startDoc(jobName, jobNameLength) ){
+		return fail("StartDoc failed");
+	}
+	for(i=0;i<total;i++){
+		// collated: 1 2 3 1 2 3, not collated: 1 1 2 2 3 3
+		size_t page = collate_ ? i % count : i / copies_;
+		if( cancel_ && cancel_->load() ){
+			canceled_ = true;
+			fail("canceled");
+			device_->abortDoc();
+			return false;
+		}
+		if( !drawJobPage(*pages[page], slots[page]) ){
+			device_->abortDoc();
+			return false;
+		}
+	}
+	if( !device_->endDoc() ){
+		return fail("EndDoc failed");
+	}
+	lists_.clear();
+	listState_.clear();
+	return true;
+}
@@ -0,0 +1,137 @@
+#ifndef DRAWER_PAGE_EXECUTOR_H
+#define DRAWER_PAGE_EXECUTOR_H
+
+#include "page.h"
+#include "device.h"
+#include "glyph-run.h"
+#include "display-list.h"
+#include "transform.h"
+#include "path-builder.h"
+#include "page-optimizer.h"
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+// Interprets page ops against a Device. This is the native counterpart of
+// DrawerPrinter in printer.js: fonts and pens are registered by name and
+// stay alive across pages until dispose() (or destruction), coordinates go
+// through the transform ops of the page, are shifted by (dx, dy) mm and
+// converted with the device dpi. Each page starts with the identity
+// transform and an empty transform stack.
+//
+// Lines (move_to/line_to runs, polyline, poly_polyline, rect and grid) are
+// collected in a PathBuilder and drawn with one polyPolyline when the page
+// draws something else or ends, so a table's rules are one device call.
+//
+// All methods return false on failure and leave a message in error().
+class PageExecutor {
+public:
+	explicit PageExecutor(Device *device);
+	~PageExecutor();
+
+	void setOffset(double dx, double dy){ dx_ = dx; dy_ = dy; }
+	// When *flag becomes true the running page fails with "canceled" and
+	// runJob aborts the document.
+	void setCancelFlag(const std::atomic<bool> *flag){ cancel_ = flag; }
+	bool canceled() const { return canceled_; }
+	// runJob draws the pages copies times, all pages per copy when collated
+	// and each page copies times in a row when not. For printers that make
+	// the copies themselves, leave 1 and set them in the DEVMODE instead.
+	void setCopies(int copies, bool collate){ copies_ = copies < 1 ? 1 : copies; collate_ = collate; }
+	// When on (the default), runJob converts pages it draws more than once,
+	// copies or pages with the same content, into a DisplayList the first
+	// time and replays that.
+	void setReplay(bool replay){ replay_ = replay; }
+	// When off, move_to and line_to go to the device one by one and each
+	// polyline, poly_polyline, rect or grid op is a polyPolyline of its own.
+	void setMergePaths(bool merge){ mergePaths_ = merge; }
+	// When on, runJob draws each page as PageOptimizer rewrites it: the same
+	// pixels with fewer selectObject, setTextColor and textRun calls.
+	void setOptimize(bool optimize){ optimize_ = optimize; }
+
+	bool runOps(const Page &page);
+	bool runPage(const Page &page);
+	// Draws a recorded page with the same device calls as runOps.
+	bool runList(const DisplayList &list);
+	bool runJob(const Page *const *pages, size_t count,
+		const uint16_t *jobName, uint32_t jobNameLength);
+	void dispose();
+
+	const std::string &error() const { return error_; }
+	long opCount() const { return opCount_; }
+	long skippedOps() const { return skippedOps_; }
+	// Pages of the last runJob drawn from a DisplayList.
+	long replayedPages() const { return replayedPages_; }
+	const OptimizerStats &optimizerStats() const { return optimizer_.stats(); }
+
+private:
+	bool fail(const std::string &message);
+	Transform deviceTransform() const;
+	bool point(const Page &page, const PageOp &op, long *x, long *y);
+	bool createFont(const Page &page, const PageOp &op);
+	bool selectNamed(const Page &page, const PageOp &op,
+		std::map<std::string, DeviceHandle> &dict, const char *what);
+	bool selectKey(const std::string &key, std::map<std::string, DeviceHandle> &dict,
+		const char *what, int code);
+	void planReplay(const Page *const *pages, size_t count, std::vector<int> *slots);
+	bool drawJobPage(const Page &page, int slot);
+	bool createPen(const Page &page, const PageOp &op);
+	bool drawChars(const Page &page, const PageOp &op);
+	bool lineTo(long x, long y);
+	bool fillRect(const Page &page, const PageOp &op);
+	bool flushPath();
+	void registerObject(std::map<std::string, DeviceHandle> &dict,
+		const std::string &name, DeviceHandle handle);
+
+	Device *device_;
+	int dpix_, dpiy_;
+	double dx_, dy_;
+	TransformStack transforms_;
+	PathBuilder path_;
+	PointScratch pathScratch_;
+	bool mergePaths_;
+	const std::atomic<bool> *cancel_;
+	bool canceled_;
+	std::vector<long> xs_, ys_;
+	std::vector<double> floatXs_, floatYs_;
+	std::vector<int> advances_;
+	std::vector<GlyphRun> runs_;
+	std::map<std::string, DeviceHandle> fonts_;
+	std::map<std::string, DeviceHandle> pens_;
+	std::string error_;
+	long opCount_;
+	long skippedOps_;
+	int copies_;
+	bool collate_;
+	bool replay_;
+	long replayedPages_;
+	// recorded pages of the running job; -1 in listState_ when recording
+	// failed, 1 when recorded
+	std::vector<DisplayList> lists_;
+	std::vector<int> listState_;
+	bool optimize_;
+	PageOptimizer optimizer_;
+	std::vector<PageBuilder> optimized_;
+};
+
+std::string text_key(const uint16_t *text, uint32_t length);
+// Ops that only add lines to a PathBuilder or change the transform; the
+// lines collected so far need not be drawn before them.
+bool keeps_path(int code);
+// Adds the lines of a polyline, poly_polyline, rect or grid op to path; false
+// with the message runOps fails with for invalid coordinates.
+bool add_path_shapes(const Page &page, const PageOp &op, const Transform &t, int dpix, int dpiy,
+	PointScratch *scratch, PathBuilder *path, std::string *err);
+// The device pixels [left, right) x [top, bottom) of a fill_rect op; false
+// with the message runOps fails with for invalid coordinates or a transform
+// that does not keep the rectangle on the axes.
+bool fill_rect_pixels(const Page &page, const PageOp &op, const Transform &t, int dpix, int dpiy,
+	long *left, long *top, long *right, long *bottom, std::string *err);
+// Applies a push, pop, translate, scale or rotate op to stack; false with
+// the message runOps fails with for NaN arguments or an unmatched pop.
+bool apply_transform_op(const Page &page, const PageOp &op, TransformStack *stack, std::string *err);
+// t followed by the executor offset (dx, dy) mm.
+Transform offset_transform(const Transform &t, double dx, double dy);
+
+#endif
@@ -0,0 +1,308 @@
+#include "page-format.h"
+#include <string.h>
+
+namespace {
+
+struct Reader {
+	const unsigned char *p;
+	const unsigned char *end;
+
+	bool has(size_t n) const {
+		return (size_t)(end - p) >= n;
+	}
+
+	uint8_t u8(){
+		return *p++;
+	}
+
+	uint16_t u16(){
+		uint16_t v = (uint16_t)(p[0] | (p[1] << 8));
+		p += 2;
+		return v;
+	}
+
+	uint32_t u32(){
+		uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) |
+			((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+		p += 4;
+		return v;
+	}
+
+	float f32(){
+		uint32_t bits = u32();
+		float v;
+		memcpy(&v, &bits, sizeof(v));
+		return v;
+	}
+};
+
+struct Header {
+	uint32_t pageCount;
+	uint32_t stringCount;
+	uint32_t fontCount;
+	uint32_t textUnits;
+	uint32_t coordCount;
+	uint32_t opBytes;
+};
+
+struct Sections {
+	const unsigned char *pages;
+	const unsigned char *strings;
+	const unsigned char *fonts;
+	const uint16_t *text;
+	const float *coords;
+	const unsigned char *ops;
+};
+
+}
+
+static bool fail(std::string *err, const char *message){
+	*err = message;
+	return false;
+}
+
+static size_t align4(size_t n){
+	return (n + 3) & ~(size_t)3;
+}
+
+static bool read_string(const Sections &s, const Header &h, uint32_t id, TextRef *ref){
+	if( id >= h.stringCount ){
+		return false;
+	}
+	Reader r = { s.strings + id * 8, s.strings + id * 8 + 8 };
+	ref->offset = r.u32();
+	ref->length = r.u32();
+	return ref->offset <= h.textUnits && ref->length <= h.textUnits - ref->offset;
+}
+
+static bool read_coords(Reader &r, const Header &h, bool isArray, CoordRef *ref){
+	if( isArray ){
+		if( !r.has(8) ){
+			return false;
+		}
+		ref->value = 0;
+		ref->offset = r.u32();
+		ref->count = r.u32();
+		return ref->offset <= h.coordCount && ref->count <= h.coordCount - ref->offset;
+	} else {
+		if( !r.has(4) ){
+			return false;
+		}
+		ref->value = mm_from_float(r.f32());
+		ref->offset = 0;
+		ref->count = 0;
+		return true;
+	}
+}
+
+static bool decode_op(Reader &r, const Sections &s, const Header &h, PageOp *op, std::string *err){
+	memset(op, 0, sizeof(*op));
+	op->code = r.u8();
+	switch(op->code){
+		case OP_MOVE_TO: case OP_LINE_TO: {
+			if( !r.has(8) ){
+				return fail(err, "truncated op");
+			}
+			read_coords(r, h, false, &op->xs);
+			read_coords(r, h, false, &op->ys);
+			return true;
+		}
+		case OP_CREATE_FONT: {
+			if( !r.has(4) ){
+				return fail(err, "truncated op");
+			}
+			uint16_t name = r.u16();
+			uint16_t font = r.u16();
+			if( !read_string(s, h, name, &op->name) || font >= h.fontCount ){
+				return fail(err, "invalid create_font");
+			}
+			Reader f = { s.fonts + font * 8, s.fonts + font * 8 + 8 };
+			uint16_t face = f.u16();
+			uint8_t flags = f.u8();
+			f.u8();
+			op->size = mm_from_float(f.f32());
+			op->weight = (flags & 1) ? 1 : 0;
+			op->italic = (flags & 2) ? 1 : 0;
+			if( !read_string(s, h, face, &op->face) ){
+				return fail(err, "invalid font face");
+			}
+			return true;
+		}
+		case OP_SET_FONT: case OP_SET_PEN: {
+			if( !r.has(2) || !read_string(s, h, r.u16(), &op->name) ){
+				return fail(err, "invalid name");
+			}
+			return true;
+		}
+		case OP_SET_TEXT_COLOR: {
+			if( !r.has(3) ){
+				return fail(err, "truncated op");
+			}
+			op->r = r.u8();
+			op->g = r.u8();
+			op->b = r.u8();
+			return true;
+		}
+		case OP_CREATE_PEN: {
+			if( !r.has(9) ){
+				return fail(err, "truncated op");
+			}
+			if( !read_string(s, h, r.u16(), &op->name) ){
+				return fail(err, "invalid name");
+			}
+			op->r = r.u8();
+			op->g = r.u8();
+			op->b = r.u8();
+			op->size = mm_from_float(r.f32());
+			return true;
+		}
+		case OP_DRAW_CHARS: {
+			if( !r.has(9) ){
+				return fail(err, "truncated op");
+			}
+			uint8_t flags = r.u8();
+			op->text.offset = r.u32();
+			op->text.length = r.u32();
+			if( op->text.offset > h.textUnits || op->text.length > h.textUnits - op->text.offset ){
+				return fail(err, "invalid text");
+			}
+			if( !read_coords(r, h, (flags & 1) != 0, &op->xs) ||
+					!read_coords(r, h, (flags & 2) != 0, &op->ys) ){
+				return fail(err, "invalid coordinates");
+			}
+			return true;
+		}
+		case OP_PUSH: case OP_POP: {
+			return true;
+		}
+		case OP_TRANSLATE: case OP_SCALE: {
+			if( !r.has(8) ){
+				return fail(err, "truncated op");
+			}
+			read_coords(r, h, false, &op->xs);
+			read_coords(r, h, false, &op->ys);
+			return true;
+		}
+		case OP_ROTATE: {
+			if( !r.has(4) ){
+				return fail(err, "truncated op");
+			}
+			read_coords(r, h, false, &op->xs);
+			return true;
+		}
+		case OP_POLYLINE: case OP_POLY_POLYLINE: case OP_GRID: {
+			if( !r.has(1) ){
+				return fail(err, "truncated op");
+			}
+			uint8_t flags = r.u8();
+			if( !read_coords(r, h, (flags & 1) != 0, &op->xs) ||
+					!read_coords(r, h, (flags & 2) != 0, &op->ys) ||
+					(op->code == OP_POLY_POLYLINE && !read_coords(r, h, (flags & 4) != 0, &op->counts)) ){
+				return fail(err, "invalid coordinates");
+			}
+			return true;
+		}
+		case OP_RECT: case OP_FILL_RECT: {
+			if( !r.has(op->code == OP_FILL_RECT ? 19 : 16) ){
+				return fail(err, "truncated op");
+			}
+			if( op->code == OP_FILL_RECT ){
+				op->r = r.u8();
+				op->g = r.u8();
+				op->b = r.u8();
+			}
+			read_coords(r, h, false, &op->xs);
+			read_coords(r, h, false, &op->ys);
+			op->width = mm_from_float(r.f32());
+			op->height = mm_from_float(r.f32());
+			return true;
+		}
+		default:
+			return fail(err, "unknown op code");
+	}
+}
+
+bool decode_pages(const char *data, size_t length, EncodedJob *job, std::string *err){
+	job->pages.clear();
+	job->storage.clear();
+	if( ((uintptr_t)data & 3) != 0 ){
+		job->storage.resize((length + 3) / 4);
+		if( length > 0 ){
+			memcpy(&job->storage[0], data, length);
+		}
+		data = (const char *)(job->storage.empty() ? 0 : &job->storage[0]);
+	}
+	const unsigned char *base = (const unsigned char *)data;
+	Reader r = { base, base + length };
+	if( !r.has(PAGE_FORMAT_HEADER_SIZE) || memcmp(r.p, "DRWP", 4) != 0 ){
+		return fail(err, "not an encoded page buffer");
+	}
+	r.p += 4;
+	uint16_t version = r.u16();
+	r.u16();
+	if( version != PAGE_FORMAT_VERSION ){
+		return fail(err, "unsupported page format version");
+	}
+	Header h;
+	h.pageCount = r.u32();
+	h.stringCount = r.u32();
+	h.fontCount = r.u32();
+	h.textUnits = r.u32();
+	h.coordCount = r.u32();
+	h.opBytes = r.u32();
+
+	size_t sizes[] = {
+		(size_t)h.pageCount * 8,
+		(size_t)h.stringCount * 8,
+		(size_t)h.fontCount * 8,
+		align4((size_t)h.textUnits * 2),
+		(size_t)h.coordCount * 4,
+		(size_t)h.opBytes
+	};
+	const unsigned char *starts[6];
+	size_t offset = PAGE_FORMAT_HEADER_SIZE;
+	int i;
+	for(i=0;i<6;i++){
+		if( sizes[i] > length - offset ){
+			return fail(err, "truncated page buffer");
+		}
+		starts[i] = base + offset;
+		offset += sizes[i];
+	}
+	Sections s;
+	s.pages = starts[0];
+	s.strings = starts[1];
+	s.fonts = starts[2];
+	s.text = (const uint16_t *)starts[3];
+	s.coords = (const float *)starts[4];
+	s.ops = starts[5];
+
+	job->pages.resize(h.pageCount);
+	uint32_t p;
+	for(p=0;p<h.pageCount;p++){
+		Reader pr = { s.pages + p * 8, s.pages + p * 8 + 8 };
+		uint32_t opOffset = pr.u32();
+		uint32_t opCount = pr.u32();
+		if( opOffset > h.opBytes || opCount > h.opBytes - opOffset ){
+			return fail(err, "invalid page entry");
+		}
+		Page &page = job->pages[p];
+		page.text = s.text;
+		page.textSize = h.textUnits;
+		page.coords.doubles = 0;
+		page.coords.floats = s.coords;
+		page.coords.size = h.coordCount;
+		page.ops.resize(opCount);
+		Reader ops = { s.ops + opOffset, s.ops + h.opBytes };
+		uint32_t k;
+		for(k=0;k<opCount;k++){
+			if( !ops.has(1) ){
+				return fail(err, "truncated op stream");
+			}
+			if( !decode_op(ops, s, h, &page.ops[k], err) ){
+				return false;
+			}
+		}
+	}
+	return true;
+}
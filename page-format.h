@@ -0,0 +1,56 @@
+#ifndef DRAWER_PAGE_FORMAT_H
+#define DRAWER_PAGE_FORMAT_H
+
+#include "page.h"
+#include <string>
+#include <vector>
+
+// Binary page format produced by page-format.js (all values little endian).
+//
+//   header     40 bytes, see below
+//   pages      pageCount   x { u32 opOffset, u32 opCount }
+//   strings    stringCount x { u32 textOffset, u32 length }
+//   fonts      fontCount   x { u16 face, u8 flags (1: bold, 2: italic), u8 0, f32 size }
+//   text pool  textUnits   x u16 (UTF-16), padded to 4 bytes
+//   coords     coordCount  x f32 (mm)
+//   op stream  opBytes, one record per op:
+//     move_to, line_to   u8 op, f32 x, f32 y
+//     create_font        u8 op, u16 name, u16 font
+//     set_font, set_pen  u8 op, u16 name
+//     set_text_color     u8 op, u8 r, u8 g, u8 b
+//     create_pen         u8 op, u16 name, u8 r, u8 g, u8 b, f32 width
+//     draw_chars         u8 op, u8 flags, u32 textOffset, u32 length, x, y
+//                        where x (y) is u32 coordOffset, u32 count when flags
+//                        bit 1 (bit 2) is set, and f32 value otherwise
+//     push, pop          u8 op
+//     translate, scale   u8 op, f32 x, f32 y
+//     rotate             u8 op, f32 degrees
+//     polyline, grid     u8 op, u8 flags, x, y as for draw_chars
+//     poly_polyline      u8 op, u8 flags, x, y, counts, counts as x with
+//                        flags bit 3
+//     rect               u8 op, f32 x, f32 y, f32 width, f32 height
+//     fill_rect          u8 op, u8 r, u8 g, u8 b, f32 x, f32 y, f32 width,
+//                        f32 height
+//
+// Header: "DRWP", u16 version, u16 flags (0), u32 pageCount, u32 stringCount,
+// u32 fontCount, u32 textUnits, u32 coordCount, u32 opBytes, u32 0, u32 0.
+//
+// Names and font faces are interned in the string table, texts of draw_chars
+// share the text pool and all sections are 4 byte aligned, so the decoder can
+// point the pages straight into the buffer.
+
+const uint32_t PAGE_FORMAT_VERSION = 1;
+const uint32_t PAGE_FORMAT_HEADER_SIZE = 40;
+
+// Decoded job. Pages reference the text pool and coordinates of the source
+// buffer without copying; the buffer must stay alive (and unchanged) while
+// the pages are used. Only when the buffer is not 4 byte aligned its contents
+// are copied into storage first.
+struct EncodedJob {
+	std::vector<Page> pages;
+	std::vector<uint32_t> storage;
+};
+
+bool decode_pages(const char *data, size_t length, EncodedJob *job, std::string *err);
+
+#endif
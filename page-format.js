@@ -0,0 +1,349 @@
+"use strict";
+
+// Encoder of the binary page format (see page-format.h for the layout).
+// The encoded buffer can be printed directly (printPages accepts it), cached
+// on disk and replayed later.
+
+var fs = require("fs");
+
+var VERSION = 1;
+var HEADER_SIZE = 40;
+
+var OP_MOVE_TO = 1;
+var OP_LINE_TO = 2;
+var OP_CREATE_FONT = 3;
+var OP_SET_FONT = 4;
+var OP_SET_TEXT_COLOR = 5;
+var OP_CREATE_PEN = 6;
+var OP_SET_PEN = 7;
+var OP_DRAW_CHARS = 8;
+var OP_PUSH = 9;
+var OP_POP = 10;
+var OP_TRANSLATE = 11;
+var OP_SCALE = 12;
+var OP_ROTATE = 13;
+var OP_POLYLINE = 14;
+var OP_POLY_POLYLINE = 15;
+var OP_RECT = 16;
+var OP_FILL_RECT = 17;
+var OP_GRID = 18;
+
+function allocBuffer(size){
+	if( Buffer.alloc ){
+		return Buffer.alloc(size);
+	} else {
+		var buf = new Buffer(size);
+		buf.fill(0);
+		return buf;
+	}
+}
+
+function ByteWriter(){
+	this.buf = allocBuffer(1024);
+	this.pos = 0;
+}
+
+ByteWriter.prototype.ensure = function(n){
+	var buf;
+	if( this.pos + n > this.buf.length ){
+		buf = allocBuffer(Math.max(this.buf.length * 2, this.pos + n));
+		this.buf.copy(buf, 0, 0, this.pos);
+		this.buf = buf;
+	}
+};
+
+ByteWriter.prototype.u8 = function(v){
+	this.ensure(1);
+	this.buf.writeUInt8(v & 0xff, this.pos);
+	this.pos += 1;
+};
+
+ByteWriter.prototype.u16 = function(v){
+	this.ensure(2);
+	this.buf.writeUInt16LE(v, this.pos);
+	this.pos += 2;
+};
+
+ByteWriter.prototype.u32 = function(v){
+	this.ensure(4);
+	this.buf.writeUInt32LE(v, this.pos);
+	this.pos += 4;
+};
+
+ByteWriter.prototype.f32 = function(v){
+	this.ensure(4);
+	this.buf.writeFloatLE(v, this.pos, true);
+	this.pos += 4;
+};
+
+function Encoder(){
+	this.ops = new ByteWriter();
+	this.pages = [];
+	this.stringIndex = Object.create(null);
+	this.strings = [];
+	this.fontIndex = Object.create(null);
+	this.fonts = [];
+	this.textIndex = Object.create(null);
+	this.text = [];
+	this.coords = [];
+}
+
+Encoder.prototype.addText = function(str){
+	var offset = this.textIndex[str], i, n = str.length;
+	if( offset === undefined ){
+		offset = this.text.length;
+		for(i=0;i<n;i++){
+			this.text.push(str.charCodeAt(i));
+		}
+		this.textIndex[str] = offset;
+	}
+	return offset;
+};
+
+Encoder.prototype.addString = function(str){
+	var id = this.stringIndex[str];
+	if( id === undefined ){
+		id = this.strings.length;
+		if( id > 0xffff ){
+			throw new Error("too many strings in page buffer");
+		}
+		this.strings.push({ offset: this.addText(str), length: str.length });
+		this.stringIndex[str] = id;
+	}
+	return id;
+};
+
+Encoder.prototype.addFont = function(face, size, flags){
+	var key = face + "\u0000" + size + "\u0000" + flags;
+	var id = this.fontIndex[key];
+	if( id === undefined ){
+		id = this.fonts.length;
+		if( id > 0xffff ){
+			throw new Error("too many fonts in page buffer");
+		}
+		this.fonts.push({ face: this.addString(face), size: size, flags: flags });
+		this.fontIndex[key] = id;
+	}
+	return id;
+};
+
+Encoder.prototype.coord = function(value){
+	var w = this.ops, offset, i, n;
+	if( typeof value === "number" || value instanceof Number ){
+		w.f32(Number(value));
+	} else if( Array.isArray(value) ){
+		offset = this.coords.length;
+		n = value.length;
+		for(i=0;i<n;i++){
+			this.coords.push(Number(value[i]));
+		}
+		w.u32(offset);
+		w.u32(n);
+	} else {
+		w.f32(NaN);
+	}
+};
+
+function isCoordArray(value){
+	return Array.isArray(value);
+}
+
+// Same conversions as DrawerPrinter.prototype.dispatch.
+Encoder.prototype.addOp = function(op){
+	var w = this.ops, str, flags;
+	switch(op[0]){
+		case "move_to":
+		case "line_to":
+			w.u8(op[0] === "move_to" ? OP_MOVE_TO : OP_LINE_TO);
+			w.f32(Number(op[1]));
+			w.f32(Number(op[2]));
+			return true;
+		case "create_font":
+			flags = (op[4] ? 1 : 0) | (op[5] ? 2 : 0);
+			w.u8(OP_CREATE_FONT);
+			w.u16(this.addString("" + op[1]));
+			w.u16(this.addFont("" + op[2], Number(op[3]), flags));
+			return true;
+		case "set_font":
+		case "set_pen":
+			w.u8(op[0] === "set_font" ? OP_SET_FONT : OP_SET_PEN);
+			w.u16(this.addString("" + op[1]));
+			return true;
+		case "set_text_color":
+			w.u8(OP_SET_TEXT_COLOR);
+			w.u8(Math.floor(Number(op[1])));
+			w.u8(Math.floor(Number(op[2])));
+			w.u8(Math.floor(Number(op[3])));
+			return true;
+		case "create_pen":
+			w.u8(OP_CREATE_PEN);
+			w.u16(this.addString("" + op[1]));
+			w.u8(Math.floor(Number(op[2])));
+			w.u8(Math.floor(Number(op[3])));
+			w.u8(Math.floor(Number(op[4])));
+			w.f32(Number(op[5]));
+			return true;
+		case "draw_chars":
+			str = op[1];
+			if( !(typeof str === "string" || str instanceof String) ){
+				throw new Error("invalid str to drawChars");
+			}
+			str = "" + str;
+			w.u8(OP_DRAW_CHARS);
+			w.u8((isCoordArray(op[2]) ? 1 : 0) | (isCoordArray(op[3]) ? 2 : 0));
+			w.u32(this.addText(str));
+			w.u32(str.length);
+			this.coord(op[2]);
+			this.coord(op[3]);
+			return true;
+		case "push":
+		case "pop":
+			w.u8(op[0] === "push" ? OP_PUSH : OP_POP);
+			return true;
+		case "translate":
+			w.u8(OP_TRANSLATE);
+			w.f32(Number(op[1]));
+			w.f32(Number(op[2]));
+			return true;
+		case "scale":
+			w.u8(OP_SCALE);
+			w.f32(Number(op[1]));
+			w.f32(op[2] === undefined ? Number(op[1]) : Number(op[2]));
+			return true;
+		case "rotate":
+			w.u8(OP_ROTATE);
+			w.f32(Number(op[1]));
+			return true;
+		case "polyline":
+		case "grid":
+			w.u8(op[0] === "polyline" ? OP_POLYLINE : OP_GRID);
+			w.u8((isCoordArray(op[1]) ? 1 : 0) | (isCoordArray(op[2]) ? 2 : 0));
+			this.coord(op[1]);
+			this.coord(op[2]);
+			return true;
+		case "poly_polyline":
+			w.u8(OP_POLY_POLYLINE);
+			w.u8((isCoordArray(op[1]) ? 1 : 0) | (isCoordArray(op[2]) ? 2 : 0) |
+				(isCoordArray(op[3]) ? 4 : 0));
+			this.coord(op[1]);
+			this.coord(op[2]);
+			this.coord(op[3]);
+			return true;
+		case "rect":
+			w.u8(OP_RECT);
+			w.f32(Number(op[1]));
+			w.f32(Number(op[2]));
+			w.f32(Number(op[3]));
+			w.f32(Number(op[4]));
+			return true;
+		case "fill_rect":
+			w.u8(OP_FILL_RECT);
+			w.u8(Math.floor(Number(op[5])));
+			w.u8(Math.floor(Number(op[6])));
+			w.u8(Math.floor(Number(op[7])));
+			w.f32(Number(op[1]));
+			w.f32(Number(op[2]));
+			w.f32(Number(op[3]));
+			w.f32(Number(op[4]));
+			return true;
+		default:
+			return false;
+	}
+};
+
+Encoder.prototype.addPage = function(ops){
+	var i, n = ops.length, start = this.ops.pos, count = 0;
+	for(i=0;i<n;i++){
+		if( this.addOp(ops[i]) ){
+			count += 1;
+		}
+	}
+	this.pages.push({ offset: start, count: count });
+};
+
+Encoder.prototype.finish = function(){
+	var textBytes = (this.text.length * 2 + 3) & ~3;
+	var size = HEADER_SIZE + this.pages.length * 8 + this.strings.length * 8 +
+		this.fonts.length * 8 + textBytes + this.coords.length * 4 + this.ops.pos;
+	var buf = allocBuffer(size), pos = 0, i;
+	buf.write("DRWP", 0, "ascii");
+	buf.writeUInt16LE(VERSION, 4);
+	buf.writeUInt16LE(0, 6);
+	buf.writeUInt32LE(this.pages.length, 8);
+	buf.writeUInt32LE(this.strings.length, 12);
+	buf.writeUInt32LE(this.fonts.length, 16);
+	buf.writeUInt32LE(this.text.length, 20);
+	buf.writeUInt32LE(this.coords.length, 24);
+	buf.writeUInt32LE(this.ops.pos, 28);
+	pos = HEADER_SIZE;
+	for(i=0;i<this.pages.length;i++){
+		buf.writeUInt32LE(this.pages[i].offset, pos);
+		buf.writeUInt32LE(this.pages[i].count, pos + 4);
+		pos += 8;
+	}
+	for(i=0;i<this.strings.length;i++){
+		buf.writeUInt32LE(this.strings[i].offset, pos);
+		buf.writeUInt32LE(this.strings[i].length, pos + 4);
+		pos += 8;
+	}
+	for(i=0;i<this.fonts.length;i++){
+		buf.writeUInt16LE(this.fonts[i].face, pos);
+		buf.writeUInt8(this.fonts[i].flags, pos + 2);
+		buf.writeFloatLE(this.fonts[i].size, pos + 4, true);
+		pos += 8;
+	}
+	for(i=0;i<this.text.length;i++){
+		buf.writeUInt16LE(this.text[i], pos + i * 2);
+	}
+	pos += textBytes;
+	for(i=0;i<this.coords.length;i++){
+		buf.writeFloatLE(this.coords[i], pos, true);
+		pos += 4;
+	}
+	this.ops.buf.copy(buf, pos, 0, this.ops.pos);
+	return buf;
+};
+
+function encodePages(pages){
+	var encoder = new Encoder(), i;
+	for(i=0;i<pages.length;i++){
+		encoder.addPage(pages[i]);
+	}
+	return encoder.finish();
+}
+
+function isEncodedPages(value){
+	return Buffer.isBuffer(value) && value.length >= HEADER_SIZE &&
+		value.toString("ascii", 0, 4) === "DRWP";
+}
+
+function saveEncodedPages(path, pages, done){
+	var buf = isEncodedPages(pages) ? pages : encodePages(pages);
+	var tmpPath = path + ".tmp";
+	fs.writeFile(tmpPath, buf, function(err){
+		if( err ){
+			done(err);
+			return;
+		}
+		fs.rename(tmpPath, path, done);
+	});
+}
+
+function readEncodedPages(path, cb){
+	fs.readFile(path, function(err, buf){
+		if( err ){
+			cb(err);
+			return;
+		}
+		if( !isEncodedPages(buf) ){
+			cb(new Error("not an encoded page file: " + path));
+			return;
+		}
+		cb(undefined, buf);
+	});
+}
+
+exports.encodePages = encodePages;
+exports.isEncodedPages = isEncodedPages;
+exports.saveEncodedPages = saveEncodedPages;
+exports.readEncodedPages = readEncodedPages;
@@ -0,0 +1,419 @@
+#include "page-optimizer.h"
+#include "page-executor.h"
+#include <algorithm>
+#include <string.h>
+
+static CoordRef copy_coords(const Page &page, const CoordRef &ref, PageBuilder *out,
+		std::vector<double> *scratch){
+	uint32_t i;
+	if( ref.count == 0 ){
+		return ref;
+	}
+	scratch->resize(ref.count);
+	for(i=0;i<ref.count;i++){
+		(*scratch)[i] = page.coordAt(ref, i);
+	}
+	return out->addCoords(&(*scratch)[0], ref.count);
+}
+
+// values as a single value when they are all the same
+static CoordRef pool_coords(const std::vector<double> &values, PageBuilder *out){
+	size_t i;
+	for(i=1;i<values.size();i++){
+		if( values[i] != values[0] ){
+			return out->addCoords(&values[0], (uint32_t)values.size());
+		}
+	}
+	return out->scalar(values[0]);
+}
+
+static bool same_color(int r1, int g1, int b1, int r2, int g2, int b2){
+	return r1 == r2 && g1 == g2 && b1 == b2;
+}
+
+PageOptimizer::PageOptimizer(){
+	reorder_ = true;
+	page_ = 0;
+	out_ = 0;
+	resetStats();
+}
+
+void PageOptimizer::resetStats(){
+	memset(&stats_, 0, sizeof(stats_));
+}
+
+void PageOptimizer::begin(const Page &page, PageBuilder *out){
+	int kind;
+	page_ = &page;
+	out_ = out;
+	out->clear();
+	transforms_.reset();
+	prologue_.clear();
+	ops_.clear();
+	objects_.clear();
+	classes_.clear();
+	nextClass_ = 0;
+	for(kind=0;kind<2;kind++){
+		names_[kind].clear();
+		wanted_[kind] = -1;
+		shown_[kind] = -1;
+		usedInitial_[kind] = false;
+	}
+	wantedColor_.set = false;
+	shownColor_.set = false;
+	setsIn_ = 0;
+	setsOut_ = 0;
+	texts_.clear();
+	textOpen_ = false;
+	text_.clear();
+	textXs_.clear();
+	textYs_.clear();
+}
+
+Page &PageOptimizer::optimize(const Page &page, PageBuilder *out){
+	size_t i, n = page.ops.size();
+	std::string err;
+	begin(page, out);
+	for(i=0;i<n;i++){
+		const PageOp &op = page.ops[i];
+		switch(op.code){
+			case OP_CREATE_FONT: {
+				create(KIND_FONT, op);
+				break;
+			}
+			case OP_CREATE_PEN: {
+				create(KIND_PEN, op);
+				break;
+			}
+			case OP_SET_FONT: {
+				select(KIND_FONT, op);
+				break;
+			}
+			case OP_SET_PEN: {
+				select(KIND_PEN, op);
+				break;
+			}
+			case OP_SET_TEXT_COLOR: {
+				setsIn_ += 1;
+				wantedColor_.r = op.r;
+				wantedColor_.g = op.g;
+				wantedColor_.b = op.b;
+				wantedColor_.set = true;
+				break;
+			}
+			case OP_DRAW_CHARS: {
+				drawText(i);
+				break;
+			}
+			case OP_MOVE_TO: case OP_FILL_RECT: {
+				flushTexts();
+				emit(copyOp(op));
+				break;
+			}
+			case OP_LINE_TO: case OP_POLYLINE: case OP_POLY_POLYLINE: case OP_RECT: case OP_GRID: {
+				flushTexts();
+				if( wanted_[KIND_PEN] < 0 ){
+					usedInitial_[KIND_PEN] = true;
+				}
+				needObject(KIND_PEN, wanted_[KIND_PEN]);
+				emit(copyOp(op));
+				break;
+			}
+			case OP_PUSH: case OP_POP: case OP_TRANSLATE: case OP_SCALE: case OP_ROTATE: {
+				// runOps fails at an invalid one; what follows does not matter
+				apply_transform_op(page, op, &transforms_, &err);
+				flushTexts();
+				emit(copyOp(op));
+				break;
+			}
+			default: {
+				flushTexts();
+				needColor(wantedColor_);
+				needObject(KIND_FONT, wanted_[KIND_FONT]);
+				needObject(KIND_PEN, wanted_[KIND_PEN]);
+				emit(copyOp(op));
+				break;
+			}
+		}
+	}
+	finishState();
+	for(i=0;i<prologue_.size();i++){
+		out->addOp(prologue_[i].code) = prologue_[i];
+	}
+	for(i=0;i<ops_.size();i++){
+		out->addOp(ops_[i].code) = ops_[i];
+	}
+	stats_.pages += 1;
+	stats_.opsIn += (long)n;
+	stats_.opsOut += (long)(prologue_.size() + ops_.size());
+	stats_.statesDropped += setsIn_ - setsOut_;
+	return out->finish();
+}
+
+// op with its strings and coordinates moved to the output pools
+PageOp PageOptimizer::copyOp(const PageOp &op){
+	PageOp copy = op;
+	copy.name = out_->addText(page_->textOf(op.name), op.name.length);
+	copy.face = out_->addText(page_->textOf(op.face), op.face.length);
+	copy.text = out_->addText(page_->textOf(op.text), op.text.length);
+	copy.xs = copy_coords(*page_, op.xs, out_, &scratch_);
+	copy.ys = copy_coords(*page_, op.ys, out_, &scratch_);
+	copy.counts = copy_coords(*page_, op.counts, out_, &scratch_);
+	return copy;
+}
+
+void PageOptimizer::emit(const PageOp &op){
+	commitText();
+	ops_.push_back(op);
+}
+
+// Objects the executor would create the same device object for share a
+// class: the face, the size after the transform and the style of a font,
+// the color and width after the transform of a pen.
+int PageOptimizer::classOf(const PageOp &op){
+	double size = transform_length(transforms_.current(), op.size);
+	std::string key(1, op.code == OP_CREATE_FONT ? 'f' : 'p');
+	key.append((const char *)&size, sizeof(size));
+	if( op.code == OP_CREATE_FONT ){
+		key += op.weight ? 'b' : '-';
+		key += op.italic ? 'i' : '-';
+		key += text_key(page_->textOf(op.face), op.face.length);
+	} else {
+		int rgb[3] = { op.r, op.g, op.b };
+		key.append((const char *)rgb, sizeof(rgb));
+	}
+	std::map<std::string, int>::iterator iter = classes_.find(key);
+	if( iter != classes_.end() ){
+		return iter->second;
+	}
+	classes_[key] = nextClass_;
+	return nextClass_++;
+}
+
+void PageOptimizer::create(int kind, const PageOp &op){
+	std::string key = text_key(page_->textOf(op.name), op.name.length);
+	int cls = classOf(op);
+	std::map<std::string, int>::iterator iter = names_[kind].find(key);
+	if( iter != names_[kind].end() && objects_[iter->second].cls == cls ){
+		stats_.createsDropped += 1;
+		return;
+	}
+	Object object;
+	object.kind = kind;
+	object.cls = cls;
+	object.alive = true;
+	object.checked = true;
+	object.key = key;
+	int index = (int)objects_.size();
+	// the first create of a name on the page replaces the object the name
+	// had on earlier pages, which only the device's initial selection can
+	// still be using
+	if( iter == names_[kind].end() && !usedInitial_[kind] &&
+			transform_length(transforms_.current(), op.size) == op.size ){
+		objects_.push_back(object);
+		names_[kind][key] = index;
+		prologue_.push_back(copyOp(op));
+		stats_.createsHoisted += 1;
+		return;
+	}
+	flushTexts();
+	if( iter != names_[kind].end() ){
+		// what is drawn after this with the replaced object has to find it
+		// selected
+		if( wanted_[kind] == iter->second ){
+			needObject(kind, iter->second);
+		}
+		objects_[iter->second].alive = false;
+	}
+	objects_.push_back(object);
+	names_[kind][key] = index;
+	emit(copyOp(op));
+}
+
+void PageOptimizer::select(int kind, const PageOp &op){
+	std::string key = text_key(page_->textOf(op.name), op.name.length);
+	std::map<std::string, int>::iterator iter = names_[kind].find(key);
+	int index;
+	setsIn_ += 1;
+	if( iter == names_[kind].end() ){
+		// created on an earlier page, or unknown
+		Object object;
+		object.kind = kind;
+		object.cls = nextClass_++;
+		object.alive = true;
+		object.checked = false;
+		object.key = key;
+		index = (int)objects_.size();
+		objects_.push_back(object);
+		names_[kind][key] = index;
+	} else {
+		index = iter->second;
+	}
+	wanted_[kind] = index;
+	if( !objects_[index].checked ){
+		flushTexts();
+		needObject(kind, index);
+	}
+}
+
+bool PageOptimizer::sameObject(int shown, int wanted) const {
+	if( wanted < 0 || shown == wanted ){
+		return true;
+	}
+	return shown >= 0 && objects_[shown].alive && objects_[shown].cls == objects_[wanted].cls;
+}
+
+void PageOptimizer::emitSelect(int kind, int object){
+	const std::string &key = objects_[object].key;
+	PageOp op;
+	memset(&op, 0, sizeof(op));
+	op.code = kind == KIND_FONT ? OP_SET_FONT : OP_SET_PEN;
+	op.name = out_->addText((const uint16_t *)key.data(), (uint32_t)(key.size() / sizeof(uint16_t)));
+	emit(op);
+	shown_[kind] = object;
+	objects_[object].checked = true;
+	setsOut_ += 1;
+}
+
+void PageOptimizer::needObject(int kind, int object){
+	if( !sameObject(shown_[kind], object) ){
+		emitSelect(kind, object);
+	}
+}
+
+void PageOptimizer::needColor(const Color &color){
+	if( !color.set || (shownColor_.set &&
+			same_color(shownColor_.r, shownColor_.g, shownColor_.b, color.r, color.g, color.b)) ){
+		return;
+	}
+	PageOp op;
+	memset(&op, 0, sizeof(op));
+	op.code = OP_SET_TEXT_COLOR;
+	op.r = color.r;
+	op.g = color.g;
+	op.b = color.b;
+	emit(op);
+	shownColor_ = color;
+	setsOut_ += 1;
+}
+
+void PageOptimizer::drawText(size_t index){
+	const PageOp &op = page_->ops[index];
+	uint32_t n = op.text.length;
+	if( (op.xs.count != 0 && op.xs.count < n) || (op.ys.count != 0 && op.ys.count < n) ){
+		flushTexts();
+		needColor(wantedColor_);
+		needObject(KIND_FONT, wanted_[KIND_FONT]);
+		emit(copyOp(op));
+		return;
+	}
+	if( n == 0 ){
+		return;
+	}
+	if( wanted_[KIND_FONT] < 0 ){
+		usedInitial_[KIND_FONT] = true;
+	}
+	TextItem item;
+	item.op = index;
+	item.font = wanted_[KIND_FONT];
+	item.color = wantedColor_;
+	texts_.push_back(item);
+}
+
+// Appends the text of item to the open draw_chars when it starts on the
+// baseline that one ended on.
+void PageOptimizer::appendText(const TextItem &item){
+	const PageOp &op = page_->ops[item.op];
+	uint32_t i, n = op.text.length;
+	needColor(item.color);
+	needObject(KIND_FONT, item.font);
+	if( textOpen_ && textYs_.back() == page_->coordAt(op.ys, 0) ){
+		stats_.textsMerged += 1;
+	} else {
+		commitText();
+		textOpen_ = true;
+	}
+	const uint16_t *text = page_->textOf(op.text);
+	text_.insert(text_.end(), text, text + n);
+	for(i=0;i<n;i++){
+		textXs_.push_back(page_->coordAt(op.xs, i));
+		textYs_.push_back(page_->coordAt(op.ys, i));
+	}
+}
+
+// Emits the pending draw_chars. Runs of one text color are drawn a font at
+// a time, the font shown when the run starts first, each font's texts in
+// page order.
+void PageOptimizer::flushTexts(){
+	size_t i, j, k, g, n = texts_.size();
+	for(i=0;i<n;i=j){
+		const Color &color = texts_[i].color;
+		for(j=i+1;j<n;j++){
+			const Color &next = texts_[j].color;
+			if( next.set != color.set || (color.set &&
+					!same_color(color.r, color.g, color.b, next.r, next.g, next.b)) ){
+				break;
+			}
+		}
+		order_.clear();
+		groups_.clear();
+		int shown = shown_[KIND_FONT];
+		if( reorder_ && shown >= 0 && objects_[shown].alive ){
+			groups_.push_back(objects_[shown].cls);
+		}
+		for(k=i;k<j && reorder_;k++){
+			int font = texts_[k].font, cls = font < 0 ? -1 : objects_[font].cls;
+			if( std::find(groups_.begin(), groups_.end(), cls) == groups_.end() ){
+				groups_.push_back(cls);
+			}
+		}
+		for(g=0;g<groups_.size();g++){
+			for(k=i;k<j;k++){
+				int font = texts_[k].font;
+				if( (font < 0 ? -1 : objects_[font].cls) == groups_[g] ){
+					order_.push_back(k);
+				}
+			}
+		}
+		for(k=i;k<j;k++){
+			size_t index = reorder_ ? order_[k - i] : k;
+			if( index != k ){
+				stats_.textsReordered += 1;
+			}
+			appendText(texts_[index]);
+		}
+	}
+	texts_.clear();
+}
+
+void PageOptimizer::commitText(){
+	if( !textOpen_ ){
+		return;
+	}
+	PageOp op;
+	memset(&op, 0, sizeof(op));
+	op.code = OP_DRAW_CHARS;
+	op.text = out_->addText(&text_[0], (uint32_t)text_.size());
+	op.xs = pool_coords(textXs_, out_);
+	op.ys = pool_coords(textYs_, out_);
+	ops_.push_back(op);
+	textOpen_ = false;
+	text_.clear();
+	textXs_.clear();
+	textYs_.clear();
+}
+
+// The page ends with the selection and text color the original ends with,
+// for a next page that draws with them.
+void PageOptimizer::finishState(){
+	int kind;
+	flushTexts();
+	for(kind=0;kind<2;kind++){
+		int wanted = wanted_[kind];
+		if( wanted >= 0 && shown_[kind] != wanted && objects_[wanted].alive ){
+			emitSelect(kind, wanted);
+		}
+	}
+	needColor(wantedColor_);
+	commitText();
+}
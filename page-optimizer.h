@@ -0,0 +1,128 @@
+#ifndef DRAWER_PAGE_OPTIMIZER_H
+#define DRAWER_PAGE_OPTIMIZER_H
+
+#include "page.h"
+#include "transform.h"
+#include <map>
+#include <string>
+#include <vector>
+
+// Counts of the optimize() calls since the last resetStats().
+struct OptimizerStats {
+	long pages;
+	long opsIn;
+	long opsOut;
+	long statesDropped;   // set_font, set_pen and set_text_color left out
+	long createsDropped;  // create_font and create_pen of a name's definition
+	long createsHoisted;  // moved to the start of the page
+	long textsMerged;     // draw_chars appended to the one before
+	long textsReordered;  // draw_chars drawn out of order to share a font
+};
+
+// Rewrites a page into one that draws the same pixels with fewer device
+// calls, before PageExecutor runs it:
+//
+// - set_font, set_pen and set_text_color are issued only right before a draw
+//   that needs them, and not at all when the device has that state already.
+//   Fonts (pens) created with the same face, size and style (color and
+//   width) count as the same state.
+// - create_font and create_pen of the definition a name has already are
+//   dropped, and the first definition of a name moves to the start of the
+//   page when the transform there gives it the same size.
+// - draw_chars that continue on the baseline the text before ended on are
+//   appended to it, so they become one text run.
+// - With reordering on (the default), draw_chars in one text color between
+//   two other draws are grouped by font: text in a single color covers the
+//   same pixels whatever order it is drawn in.
+//
+// Nothing is assumed about the device at the start of a page, so a page is
+// optimized the same way in any job, and the state a page leaves behind is
+// the one the original leaves. Unknown ops and draw_chars with too few
+// coordinates stay in place, so runOps fails where it would have, and
+// set_font/set_pen of a name the page did not create are issued where they
+// were the first time, in case the name is unknown.
+class PageOptimizer {
+public:
+	PageOptimizer();
+
+	void setReorder(bool reorder){ reorder_ = reorder; }
+	// Builds the optimized page in out, clearing it first, and returns the
+	// finished page.
+	Page &optimize(const Page &page, PageBuilder *out);
+
+	const OptimizerStats &stats() const { return stats_; }
+	void resetStats();
+
+private:
+	enum { KIND_FONT, KIND_PEN };
+
+	// A font or pen as the executor would hold it: one per create (or per
+	// name selected without being created on the page).
+	struct Object {
+		int kind;
+		int cls;          // objects of one class draw the same
+		bool alive;       // its name was not created again since
+		bool checked;     // selected on the output, so the name exists
+		std::string key;  // name (text_key)
+	};
+
+	struct Color {
+		int r, g, b;
+		bool set;
+	};
+
+	struct TextItem {
+		size_t op;
+		int font;
+		Color color;
+	};
+
+	void begin(const Page &page, PageBuilder *out);
+	PageOp copyOp(const PageOp &op);
+	void emit(const PageOp &op);
+	int classOf(const PageOp &op);
+	void create(int kind, const PageOp &op);
+	void select(int kind, const PageOp &op);
+	bool sameObject(int shown, int wanted) const;
+	void emitSelect(int kind, int object);
+	void needObject(int kind, int object);
+	void needColor(const Color &color);
+	void drawText(size_t index);
+	void appendText(const TextItem &item);
+	void flushTexts();
+	void commitText();
+	void finishState();
+
+	bool reorder_;
+	OptimizerStats stats_;
+
+	// state of the page being optimized
+	const Page *page_;
+	PageBuilder *out_;
+	TransformStack transforms_;
+	std::vector<PageOp> prologue_;
+	std::vector<PageOp> ops_;
+	std::vector<Object> objects_;
+	std::map<std::string, int> names_[2];
+	std::map<std::string, int> classes_;
+	int nextClass_;
+	int wanted_[2];
+	int shown_[2];
+	Color wantedColor_;
+	Color shownColor_;
+	// a draw used the font (pen) the device had at the start of the page, so
+	// creates must not replace it before that draw
+	bool usedInitial_[2];
+	long setsIn_, setsOut_;
+	// draw_chars since the last other draw, not emitted yet
+	std::vector<TextItem> texts_;
+	// the last draw_chars emitted, open for appending
+	bool textOpen_;
+	std::vector<uint16_t> text_;
+	std::vector<double> textXs_, textYs_;
+	std::vector<double> scratch_;
+	std::vector<size_t> order_;
+	std::vector<int> groups_;
+};
+
+#endif
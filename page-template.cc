@@ -0,0 +1,668 @@
+#include "page-template.h"
+#include "page-executor.h"
+#include <map>
+#include <math.h>
+#include <string.h>
+
+int template_char_columns(uint16_t ch){
+	if( ch >= 0xdc00 && ch <= 0xdfff ){
+		return 0;
+	}
+	if( (ch >= 0x1100 && ch <= 0x115f) ||
+			(ch >= 0x2e80 && ch <= 0x303e) ||
+			(ch >= 0x3041 && ch <= 0x33ff) ||
+			(ch >= 0x3400 && ch <= 0x4dbf) ||
+			(ch >= 0x4e00 && ch <= 0xa4cf) ||
+			(ch >= 0xac00 && ch <= 0xd7a3) ||
+			(ch >= 0xd800 && ch <= 0xdbff) ||
+			(ch >= 0xf900 && ch <= 0xfaff) ||
+			(ch >= 0xfe30 && ch <= 0xfe4f) ||
+			(ch >= 0xff00 && ch <= 0xff60) ||
+			(ch >= 0xffe0 && ch <= 0xffe6) ){
+		return 2;
+	}
+	return 1;
+}
+
+static TemplateOp template_op(int code){
+	TemplateOp op;
+	memset(&op, 0, sizeof(op));
+	op.code = code;
+	return op;
+}
+
+static uint32_t template_slot(std::vector<std::string> &names, const std::string &name){
+	size_t i;
+	for(i=0;i<names.size();i++){
+		if( names[i] == name ){
+			return (uint32_t)i;
+		}
+	}
+	names.push_back(name);
+	return (uint32_t)(names.size() - 1);
+}
+
+enum {
+	MARK_FIELD,
+	MARK_REPEAT,
+	MARK_IF,
+	MARK_END
+};
+
+PageTemplate::PageTemplate(){
+}
+
+PageTemplate::~PageTemplate(){
+	clearResolved();
+}
+
+void PageTemplate::clearResolved(){
+	size_t i;
+	for(i=0;i<resolved_.size();i++){
+		delete resolved_[i];
+	}
+	resolved_.clear();
+}
+
+void PageTemplate::field(const std::string &name, double x, double y, double pitch, int align){
+	Mark mark;
+	mark.code = MARK_FIELD;
+	mark.op = source_.page().ops.size();
+	mark.name = name;
+	mark.x = x;
+	mark.y = y;
+	mark.pitch = pitch;
+	mark.step = 0;
+	mark.align = align;
+	marks_.push_back(mark);
+}
+
+void PageTemplate::beginRepeat(const std::string &name, double step){
+	Mark mark;
+	mark.code = MARK_REPEAT;
+	mark.op = source_.page().ops.size();
+	mark.name = name;
+	mark.x = mark.y = mark.pitch = 0;
+	mark.step = step;
+	mark.align = 0;
+	marks_.push_back(mark);
+}
+
+void PageTemplate::beginIf(const std::string &name, double height){
+	Mark mark;
+	mark.code = MARK_IF;
+	mark.op = source_.page().ops.size();
+	mark.name = name;
+	mark.x = mark.y = mark.pitch = 0;
+	mark.step = height;
+	mark.align = 0;
+	marks_.push_back(mark);
+}
+
+void PageTemplate::end(){
+	Mark mark;
+	mark.code = MARK_END;
+	mark.op = source_.page().ops.size();
+	mark.x = mark.y = mark.pitch = mark.step = 0;
+	mark.align = 0;
+	marks_.push_back(mark);
+}
+
+int PageTemplate::findScope(const std::string &name) const {
+	size_t i;
+	for(i=1;i<scopes_.size();i++){
+		if( scopes_[i].name == name ){
+			return (int)i;
+		}
+	}
+	return -1;
+}
+
+bool PageTemplate::compile(std::string *err){
+	const Page &page = source_.finish();
+	std::map<std::string, uint32_t> fonts, pens;
+	std::vector<size_t> blocks;
+	size_t i, mark = 0, n = page.ops.size();
+	uint32_t scope = 0;
+	clearResolved();
+	scopes_.assign(1, TemplateScope());
+	objects_.clear();
+	ops_.clear();
+	for(i=0;i<=n;i++){
+		for(;mark<marks_.size() && marks_[mark].op == i;mark++){
+			const Mark &m = marks_[mark];
+			switch(m.code){
+				case MARK_FIELD: {
+					if( isnan(m.x) || isnan(m.y) || isnan(m.pitch) ){
+						*err = "invalid number to field " + m.name;
+						return false;
+					}
+					TemplateOp op = template_op(TEMPLATE_FIELD);
+					op.xmm = m.x;
+					op.ymm = m.y;
+					op.pitch = m.pitch;
+					op.align = m.align;
+					op.index = template_slot(scopes_[scope].fields, m.name);
+					ops_.push_back(op);
+					break;
+				}
+				case MARK_REPEAT: {
+					if( scope != 0 ){
+						*err = "repeat block inside repeat block: " + m.name;
+						return false;
+					}
+					if( findScope(m.name) >= 0 ){
+						*err = "duplicate repeat block: " + m.name;
+						return false;
+					}
+					if( isnan(m.step) ){
+						*err = "invalid number to repeat " + m.name;
+						return false;
+					}
+					TemplateScope rows;
+					rows.name = m.name;
+					scopes_.push_back(rows);
+					scope = (uint32_t)(scopes_.size() - 1);
+					TemplateOp op = template_op(TEMPLATE_REPEAT);
+					op.index = scope;
+					op.step = m.step;
+					blocks.push_back(ops_.size());
+					ops_.push_back(op);
+					break;
+				}
+				case MARK_IF: {
+					if( isnan(m.step) ){
+						*err = "invalid number to if " + m.name;
+						return false;
+					}
+					TemplateOp op = template_op(TEMPLATE_IF);
+					op.index = template_slot(scopes_[scope].flags, m.name);
+					op.step = m.step;
+					blocks.push_back(ops_.size());
+					ops_.push_back(op);
+					break;
+				}
+				case MARK_END: {
+					if( blocks.empty() ){
+						*err = "end without block";
+						return false;
+					}
+					TemplateOp &op = ops_[blocks.back()];
+					op.end = (uint32_t)ops_.size();
+					if( op.code == TEMPLATE_REPEAT ){
+						scope = 0;
+					}
+					blocks.pop_back();
+					break;
+				}
+			}
+		}
+		if( i == n ){
+			break;
+		}
+		const PageOp &src = page.ops[i];
+		switch(src.code){
+			case OP_MOVE_TO: case OP_LINE_TO: {
+				TemplateOp op = template_op(src.code == OP_MOVE_TO ? TEMPLATE_MOVE_TO : TEMPLATE_LINE_TO);
+				op.xmm = page.coordAt(src.xs, 0);
+				op.ymm = page.coordAt(src.ys, 0);
+				if( isnan(op.xmm) || isnan(op.ymm) ){
+					*err = std::string("invalid number to ") + op_code_name(src.code);
+					return false;
+				}
+				ops_.push_back(op);
+				break;
+			}
+			case OP_CREATE_FONT: case OP_CREATE_PEN: {
+				TemplateObject object;
+				object.font = src.code == OP_CREATE_FONT;
+				object.face = src.face;
+				object.size = src.size;
+				object.weight = src.weight;
+				object.italic = src.italic;
+				object.r = src.r;
+				object.g = src.g;
+				object.b = src.b;
+				objects_.push_back(object);
+				std::map<std::string, uint32_t> &dict = object.font ? fonts : pens;
+				dict[text_key(page.textOf(src.name), src.name.length)] = (uint32_t)(objects_.size() - 1);
+				break;
+			}
+			case OP_SET_FONT: case OP_SET_PEN: {
+				std::map<std::string, uint32_t> &dict = src.code == OP_SET_FONT ? fonts : pens;
+				std::map<std::string, uint32_t>::iterator iter =
+					dict.find(text_key(page.textOf(src.name), src.name.length));
+				if( iter == dict.end() ){
+					*err = std::string(src.code == OP_SET_FONT ? "unknown font: " : "unknown pen: ") +
+						utf16_to_utf8(page.textOf(src.name), src.name.length);
+					return false;
+				}
+				TemplateOp op = template_op(TEMPLATE_SELECT);
+				op.index = iter->second;
+				ops_.push_back(op);
+				break;
+			}
+			case OP_SET_TEXT_COLOR: {
+				TemplateOp op = template_op(TEMPLATE_TEXT_COLOR);
+				op.r = src.r;
+				op.g = src.g;
+				op.b = src.b;
+				ops_.push_back(op);
+				break;
+			}
+			case OP_DRAW_CHARS: {
+				uint32_t j, count = src.text.length;
+				if( (src.xs.count != 0 && src.xs.count < count) || (src.ys.count != 0 && src.ys.count < count) ){
+					*err = "too few coordinates to drawChars";
+					return false;
+				}
+				for(j=0;j<count;j++){
+					if( isnan(page.coordAt(src.xs, j)) || isnan(page.coordAt(src.ys, j)) ){
+						*err = "invalid number to drawChars";
+						return false;
+					}
+				}
+				if( count == 0 ){
+					break;
+				}
+				TemplateOp op = template_op(TEMPLATE_DRAW_CHARS);
+				op.index = (uint32_t)i;
+				ops_.push_back(op);
+				break;
+			}
+			case OP_PUSH: case OP_POP: case OP_TRANSLATE: case OP_SCALE: case OP_ROTATE: {
+				// rows and repeats are laid out in page mm
+				*err = std::string(op_code_name(src.code)) + " is not supported in templates";
+				return false;
+			}
+			case OP_POLYLINE: case OP_POLY_POLYLINE: case OP_RECT: case OP_FILL_RECT: case OP_GRID: {
+				// rows shift single y values; move_to/line_to draw the rules
+				*err = std::string(op_code_name(src.code)) + " is not supported in templates";
+				return false;
+			}
+		}
+	}
+	if( !blocks.empty() ){
+		const TemplateOp &op = ops_[blocks.back()];
+		*err = "block not ended: " + (op.code == TEMPLATE_REPEAT ? scopes_[op.index].name :
+			scopes_[scope].flags[op.index]);
+		return false;
+	}
+	return true;
+}
+
+const ResolvedTemplate &PageTemplate::resolve(int dpix, int dpiy, double dx, double dy){
+	size_t i, j;
+	for(i=0;i<resolved_.size();i++){
+		const ResolvedTemplate &form = *resolved_[i];
+		if( form.dpix == dpix && form.dpiy == dpiy && form.dx == dx && form.dy == dy ){
+			return form;
+		}
+	}
+	const Page &page = source_.page();
+	ResolvedTemplate *form = new ResolvedTemplate();
+	form->dpix = dpix;
+	form->dpiy = dpiy;
+	form->dx = dx;
+	form->dy = dy;
+	// ops_ index -> form index, for the ends of the blocks
+	std::vector<uint32_t> at(ops_.size() + 1);
+	for(i=0;i<ops_.size();i++){
+		const TemplateOp &src = ops_[i];
+		at[i] = (uint32_t)form->ops.size();
+		if( src.code != TEMPLATE_DRAW_CHARS ){
+			TemplateOp op = src;
+			op.x = mm_to_pixel(dpix, op.xmm + dx);
+			op.y = mm_to_pixel(dpiy, op.ymm + dy);
+			form->ops.push_back(op);
+			continue;
+		}
+		const PageOp &chars = page.ops[src.index];
+		uint32_t n = chars.text.length;
+		xs_.resize(n);
+		ys_.resize(n);
+		for(j=0;j<n;j++){
+			xs_[j] = mm_to_pixel(dpix, page.coordAt(chars.xs, (uint32_t)j) + dx);
+			ys_[j] = mm_to_pixel(dpiy, page.coordAt(chars.ys, (uint32_t)j) + dy);
+		}
+		uint32_t advances = (uint32_t)form->advances.size();
+		form->advances.resize(advances + n);
+		build_glyph_runs(&xs_[0], &ys_[0], n, &form->advances[advances], &runs_);
+		for(j=0;j<runs_.size();j++){
+			const GlyphRun &run = runs_[j];
+			TemplateOp op = template_op(TEMPLATE_TEXT_RUN);
+			op.x = run.x;
+			op.y = run.y;
+			op.ymm = page.coordAt(chars.ys, run.start);
+			op.text = chars.text.offset + run.start;
+			op.length = run.count;
+			op.advances = advances + run.start;
+			form->ops.push_back(op);
+		}
+	}
+	at[ops_.size()] = (uint32_t)form->ops.size();
+	for(i=0;i<form->ops.size();i++){
+		TemplateOp &op = form->ops[i];
+		if( op.code == TEMPLATE_REPEAT || op.code == TEMPLATE_IF ){
+			op.end = at[op.end];
+		}
+	}
+	for(i=0;i<objects_.size();i++){
+		long size = mm_to_pixel(dpiy, objects_[i].size);
+		if( !objects_[i].font && size < 0 ){
+			size = 1;
+		}
+		form->sizes.push_back(size);
+	}
+	resolved_.push_back(form);
+	return *form;
+}
+
+TemplateValues::TemplateValues(){
+}
+
+void TemplateValues::reset(const PageTemplate &tmpl){
+	const std::vector<TemplateScope> &scopes = tmpl.scopes();
+	size_t i;
+	TextRef none;
+	none.offset = 0;
+	none.length = 0;
+	text_.clear();
+	scopes_.resize(scopes.size());
+	for(i=0;i<scopes.size();i++){
+		TemplateScopeValues &values = scopes_[i];
+		values.rows = i == 0 ? 1 : 0;
+		values.fieldCount = (uint32_t)scopes[i].fields.size();
+		values.flagCount = (uint32_t)scopes[i].flags.size();
+		values.fields.assign(values.rows * values.fieldCount, none);
+		values.flags.assign(values.rows * values.flagCount, 0);
+	}
+}
+
+uint32_t TemplateValues::addRow(uint32_t scope){
+	TemplateScopeValues &values = scopes_[scope];
+	TextRef none;
+	none.offset = 0;
+	none.length = 0;
+	values.rows += 1;
+	values.fields.resize(values.rows * values.fieldCount, none);
+	values.flags.resize(values.rows * values.flagCount, 0);
+	return values.rows - 1;
+}
+
+void TemplateValues::setText(uint32_t scope, uint32_t row, uint32_t field,
+		const uint16_t *text, uint32_t length){
+	TemplateScopeValues &values = scopes_[scope];
+	TextRef ref;
+	ref.offset = (uint32_t)text_.size();
+	ref.length = length;
+	text_.insert(text_.end(), text, text + length);
+	values.fields[row * values.fieldCount + field] = ref;
+}
+
+void TemplateValues::setFlag(uint32_t scope, uint32_t row, uint32_t flag, bool on){
+	TemplateScopeValues &values = scopes_[scope];
+	values.flags[row * values.flagCount + flag] = on ? 1 : 0;
+}
+
+TextRef TemplateValues::text(uint32_t scope, uint32_t row, uint32_t field) const {
+	const TemplateScopeValues &values = scopes_[scope];
+	return values.fields[row * values.fieldCount + field];
+}
+
+bool TemplateValues::flag(uint32_t scope, uint32_t row, uint32_t flag) const {
+	const TemplateScopeValues &values = scopes_[scope];
+	return values.flags[row * values.flagCount + flag] != 0;
+}
+
+TemplateExecutor::TemplateExecutor(Device *device){
+	device_ = device;
+	dpix_ = device->dpix();
+	dpiy_ = device->dpiy();
+	dx_ = 0;
+	dy_ = 0;
+	objectsOf_ = 0;
+	opCount_ = 0;
+	device_->setBkTransparent();
+}
+
+TemplateExecutor::~TemplateExecutor(){
+	dispose();
+}
+
+void TemplateExecutor::dispose(){
+	size_t i;
+	for(i=0;i<objects_.size();i++){
+		if( objects_[i] ){
+			device_->deleteObject(objects_[i]);
+		}
+	}
+	objects_.clear();
+	objectsOf_ = 0;
+}
+
+bool TemplateExecutor::fail(const std::string &message){
+	error_ = message;
+	return false;
+}
+
+bool TemplateExecutor::createObjects(PageTemplate &tmpl, const ResolvedTemplate &form){
+	const std::vector<TemplateObject> &objects = tmpl.objects();
+	const Page &page = tmpl.page();
+	size_t i;
+	dispose();
+	objectsOf_ = &tmpl;
+	objects_.assign(objects.size(), 0);
+	for(i=0;i<objects.size();i++){
+		const TemplateObject &object = objects[i];
+		if( object.font ){
+			objects_[i] = device_->createFont(page.textOf(object.face), object.face.length,
+				form.sizes[i], object.weight ? FONT_WEIGHT_BOLD : 0, object.italic ? 1 : 0);
+			if( !objects_[i] ){
+				return fail("createFont failed: " + utf16_to_utf8(page.textOf(object.face), object.face.length));
+			}
+		} else {
+			objects_[i] = device_->createPen(form.sizes[i], object.r, object.g, object.b);
+			if( !objects_[i] ){
+				return fail("createPen failed");
+			}
+		}
+	}
+	return true;
+}
+
+// Static y while nothing above changed height, else converted again from mm
+// with the same rounding as a page laid out at the shifted position.
+long TemplateExecutor::rowY(const ResolvedTemplate &form, const TemplateOp &op, double shift){
+	if( shift == 0 ){
+		return op.y;
+	}
+	return mm_to_pixel(form.dpiy, (op.ymm + shift) + form.dy);
+}
+
+bool TemplateExecutor::drawField(const ResolvedTemplate &form, const TemplateOp &op, double shift,
+		const uint16_t *text, uint32_t length){
+	uint32_t i;
+	long columns = 0;
+	if( length == 0 ){
+		return true;
+	}
+	for(i=0;i<length;i++){
+		columns += template_char_columns(text[i]);
+	}
+	double start = op.xmm;
+	if( op.align == TEMPLATE_ALIGN_RIGHT ){
+		start -= columns * op.pitch;
+	} else if( op.align == TEMPLATE_ALIGN_CENTER ){
+		start -= columns * op.pitch / 2;
+	}
+	// one run, advances as build_glyph_runs makes them
+	advances_.resize(length);
+	long x0 = mm_to_pixel(form.dpix, start + form.dx), x = x0, next;
+	columns = 0;
+	for(i=0;i<length;i++){
+		columns += template_char_columns(text[i]);
+		if( i + 1 < length ){
+			next = mm_to_pixel(form.dpix, (start + columns * op.pitch) + form.dx);
+			advances_[i] = (int)(next - x);
+			x = next;
+		} else {
+			advances_[i] = i > 0 ? advances_[i - 1] : 0;
+		}
+	}
+	if( !device_->textRun(x0, rowY(form, op, shift), text, length, &advances_[0]) ){
+		return fail("drawChars failed");
+	}
+	return true;
+}
+
+bool TemplateExecutor::flushPath(){
+	if( path_.empty() ){
+		return true;
+	}
+	if( !device_->polyPolyline(&path_.points()[0], &path_.counts()[0], (uint32_t)path_.counts().size()) ){
+		return fail("polyPolyline failed");
+	}
+	path_.clear();
+	return true;
+}
+
+bool TemplateExecutor::lineTo(long x, long y){
+	if( path_.lineTo(x, y) ){
+		return true;
+	}
+	if( !flushPath() ){
+		return false;
+	}
+	if( !device_->lineTo(x, y) ){
+		return fail("lineTo failed");
+	}
+	path_.setCurrent(x, y);
+	return true;
+}
+
+bool TemplateExecutor::runRange(PageTemplate &tmpl, const ResolvedTemplate &form, uint32_t from, uint32_t to,
+		const TemplateValues &values, uint32_t scope, uint32_t row, double *shift){
+	const Page &page = tmpl.page();
+	uint32_t i, r;
+	for(i=from;i<to;i++){
+		const TemplateOp &op = form.ops[i];
+		opCount_ += 1;
+		if( op.code != TEMPLATE_MOVE_TO && op.code != TEMPLATE_LINE_TO && op.code != TEMPLATE_REPEAT &&
+				op.code != TEMPLATE_IF && !flushPath() ){
+			return false;
+		}
+		switch(op.code){
+			case TEMPLATE_MOVE_TO: {
+				path_.moveTo(op.x, rowY(form, op, *shift));
+				break;
+			}
+			case TEMPLATE_LINE_TO: {
+				if( !lineTo(op.x, rowY(form, op, *shift)) ){
+					return false;
+				}
+				break;
+			}
+			case TEMPLATE_SELECT: {
+				if( !device_->selectObject(objects_[op.index]) ){
+					return fail(tmpl.objects()[op.index].font ? "set_font failed" : "set_pen failed");
+				}
+				break;
+			}
+			case TEMPLATE_TEXT_COLOR: {
+				if( !device_->setTextColor(op.r, op.g, op.b) ){
+					return fail("setTextColor failed");
+				}
+				break;
+			}
+			case TEMPLATE_TEXT_RUN: {
+				if( !device_->textRun(op.x, rowY(form, op, *shift), page.text + op.text,
+						op.length, &form.advances[op.advances]) ){
+					return fail("drawChars failed");
+				}
+				break;
+			}
+			case TEMPLATE_FIELD: {
+				TextRef ref = values.text(scope, row, op.index);
+				if( !drawField(form, op, *shift, values.textOf(ref), ref.length) ){
+					return false;
+				}
+				break;
+			}
+			case TEMPLATE_REPEAT: {
+				// each row starts step below the previous one, which may have
+				// skipped optional blocks
+				double rowShift = *shift;
+				uint32_t rows = values.rows(op.index);
+				for(r=0;r<rows;r++){
+					if( !runRange(tmpl, form, i + 1, op.end, values, op.index, r, &rowShift) ){
+						return false;
+					}
+					rowShift += op.step;
+				}
+				*shift = rowShift - op.step;
+				i = op.end - 1;
+				break;
+			}
+			case TEMPLATE_IF: {
+				if( !values.flag(scope, row, op.index) ){
+					*shift -= op.step;
+					i = op.end - 1;
+				}
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+bool TemplateExecutor::runOps(PageTemplate &tmpl, const TemplateValues &values){
+	if( values.scopeCount() != tmpl.scopes().size() ){
+		return fail("values are not for this template");
+	}
+	const ResolvedTemplate &form = tmpl.resolve(dpix_, dpiy_, dx_, dy_);
+	if( objectsOf_ != &tmpl && !createObjects(tmpl, form) ){
+		return false;
+	}
+	double shift = 0;
+	long x, y;
+	if( !runRange(tmpl, form, 0, (uint32_t)form.ops.size(), values, 0, 0, &shift) || !flushPath() ){
+		return false;
+	}
+	if( path_.takePendingMove(&x, &y) && !device_->moveTo(x, y) ){
+		return fail("moveTo failed");
+	}
+	return true;
+}
+
+bool TemplateExecutor::runPage(PageTemplate &tmpl, const TemplateValues &values){
+	if( !device_->startPage() ){
+		return fail("StartPage failed");
+	}
+	path_.reset();
+	if( !runOps(tmpl, values) ){
+		return false;
+	}
+	if( !device_->endPage() ){
+		return fail("EndPage failed");
+	}
+	return true;
+}
+
+bool TemplateExecutor::runJob(PageTemplate &tmpl, const TemplateValues *const *values, size_t count,
+		const uint16_t *jobName, uint32_t jobNameLength){
+	size_t i;
+	if( !device_->startDoc(jobName, jobNameLength) ){
+		return fail("StartDoc failed");
+	}
+	for(i=0;i<count;i++){
+		if( !runPage(tmpl, *values[i]) ){
+			device_->abortDoc();
+			return false;
+		}
+	}
+	if( !device_->endDoc() ){
+		return fail("EndDoc failed");
+	}
+	return true;
+}
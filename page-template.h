@@ -0,0 +1,228 @@
+#ifndef DRAWER_PAGE_TEMPLATE_H
+#define DRAWER_PAGE_TEMPLATE_H
+
+#include "page.h"
+#include "device.h"
+#include "glyph-run.h"
+#include "path-builder.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// A page layout that is compiled once and printed many times with different
+// values. Besides the page ops (page.h), a template has slots:
+//
+//   ["field", name, x, y, pitch, align?]
+//   ["repeat", name, step]
+//   ["if", name, height?]
+//   ["end"]
+//
+// A field draws its value in the current font from (x, y), one character
+// every pitch mm (two for East Asian wide characters); align "right" ends
+// the text at x and "center" centers it on x. The ops between ["repeat"]
+// and ["end"] are laid out for the first row of a list and drawn once per
+// row, each row step mm below the previous one; fields in them take the
+// values of the row. The ops between ["if"] and ["end"] are drawn only when
+// the flag is set. Ops below a block move up or down with the rows drawn
+// (the layout has one) and with the height of skipped optional blocks.
+// Transform ops (push, pop, translate, scale, rotate) and the shape ops
+// (polyline, poly_polyline, rect, fill_rect, grid) are not supported.
+
+enum TemplateAlign {
+	TEMPLATE_ALIGN_LEFT,
+	TEMPLATE_ALIGN_RIGHT,
+	TEMPLATE_ALIGN_CENTER
+};
+
+// Names of the fields and flags of the page (scope 0) or of the rows of a
+// repeat block (scopes 1...).
+struct TemplateScope {
+	std::string name;
+	std::vector<std::string> fields;
+	std::vector<std::string> flags;
+};
+
+// A font or pen of the template, created once per job.
+struct TemplateObject {
+	bool font;
+	TextRef face;
+	double size;
+	int weight, italic;
+	int r, g, b;
+};
+
+enum TemplateOpCode {
+	TEMPLATE_MOVE_TO,
+	TEMPLATE_LINE_TO,
+	TEMPLATE_SELECT,
+	TEMPLATE_TEXT_COLOR,
+	TEMPLATE_DRAW_CHARS,
+	TEMPLATE_TEXT_RUN,
+	TEMPLATE_FIELD,
+	TEMPLATE_REPEAT,
+	TEMPLATE_IF
+};
+
+struct TemplateOp {
+	int code;
+	// device pixels; y holds while nothing above changed height
+	long x, y;
+	// mm, without the offset
+	double xmm, ymm;
+	// FIELD: mm per character, alignment
+	double pitch;
+	int align;
+	// SELECT: object; FIELD: field of the scope; REPEAT: scope of the rows;
+	// IF: flag of the scope; DRAW_CHARS: op of the source page
+	uint32_t index;
+	// TEXT_RUN: characters in the text pool and advances in the advance pool
+	uint32_t text, length, advances;
+	// REPEAT, IF: the op after the block
+	uint32_t end;
+	// REPEAT: row height; IF: block height (mm)
+	double step;
+	int r, g, b;
+};
+
+// A template resolved for a device resolution and offset: static lines and
+// texts are in pixels, texts already split into runs with their advances.
+struct ResolvedTemplate {
+	int dpix, dpiy;
+	double dx, dy;
+	std::vector<TemplateOp> ops;
+	std::vector<int> advances;
+	// font heights and pen widths in pixels
+	std::vector<long> sizes;
+};
+
+class PageTemplate {
+public:
+	PageTemplate();
+	~PageTemplate();
+
+	// Static ops go to ops(), in order with the slots added in between.
+	PageBuilder &ops(){ return source_; }
+	void field(const std::string &name, double x, double y, double pitch, int align);
+	void beginRepeat(const std::string &name, double step);
+	void beginIf(const std::string &name, double height);
+	void end();
+	// Checks the blocks, numbers and font and pen names, and assigns the
+	// slots. Returns false with a message in err on error.
+	bool compile(std::string *err);
+
+	const std::vector<TemplateScope> &scopes() const { return scopes_; }
+	const std::vector<TemplateObject> &objects() const { return objects_; }
+	const Page &page(){ return source_.page(); }
+	// The scope of a repeat block, or -1.
+	int findScope(const std::string &name) const;
+
+	// The form for a device, made on first use and kept with the template
+	// (a template is printed on a handful of printers).
+	const ResolvedTemplate &resolve(int dpix, int dpiy, double dx, double dy);
+	size_t resolvedCount() const { return resolved_.size(); }
+
+private:
+	PageTemplate(const PageTemplate &);
+	PageTemplate &operator=(const PageTemplate &);
+
+	struct Mark {
+		int code;
+		size_t op;
+		std::string name;
+		double x, y, pitch, step;
+		int align;
+	};
+
+	void clearResolved();
+
+	PageBuilder source_;
+	std::vector<Mark> marks_;
+	std::vector<TemplateScope> scopes_;
+	std::vector<TemplateObject> objects_;
+	std::vector<TemplateOp> ops_;
+	std::vector<ResolvedTemplate *> resolved_;
+	std::vector<long> xs_, ys_;
+	std::vector<GlyphRun> runs_;
+};
+
+// Values of a scope: fields and flags of each row.
+struct TemplateScopeValues {
+	uint32_t rows;
+	uint32_t fieldCount, flagCount;
+	std::vector<TextRef> fields;
+	std::vector<uint8_t> flags;
+};
+
+// Values of one page of a template, copied in so that they can be drawn on
+// another thread. Reused across pages, reset() keeps the memory.
+class TemplateValues {
+public:
+	TemplateValues();
+
+	// Empty values for tmpl: no text, no flags and no rows.
+	void reset(const PageTemplate &tmpl);
+	// Adds a row to a repeat block and returns its index.
+	uint32_t addRow(uint32_t scope);
+	void setText(uint32_t scope, uint32_t row, uint32_t field,
+		const uint16_t *text, uint32_t length);
+	void setFlag(uint32_t scope, uint32_t row, uint32_t flag, bool on);
+
+	size_t scopeCount() const { return scopes_.size(); }
+	uint32_t rows(uint32_t scope) const { return scopes_[scope].rows; }
+	const uint16_t *textOf(const TextRef &ref) const { return text_.empty() ? 0 : &text_[ref.offset]; }
+	TextRef text(uint32_t scope, uint32_t row, uint32_t field) const;
+	bool flag(uint32_t scope, uint32_t row, uint32_t flag) const;
+
+private:
+	std::vector<uint16_t> text_;
+	std::vector<TemplateScopeValues> scopes_;
+};
+
+// Columns of a character in a field: 2 for East Asian wide characters (the
+// high half of a surrogate pair counts for the pair), 1 for others.
+int template_char_columns(uint16_t ch);
+
+// Draws templates on a Device, the counterpart of PageExecutor: the fonts
+// and pens of the template are created when its first page is drawn and
+// deleted by dispose() (or destruction).
+class TemplateExecutor {
+public:
+	explicit TemplateExecutor(Device *device);
+	~TemplateExecutor();
+
+	void setOffset(double dx, double dy){ dx_ = dx; dy_ = dy; }
+
+	bool runOps(PageTemplate &tmpl, const TemplateValues &values);
+	bool runPage(PageTemplate &tmpl, const TemplateValues &values);
+	bool runJob(PageTemplate &tmpl, const TemplateValues *const *values, size_t count,
+		const uint16_t *jobName, uint32_t jobNameLength);
+	void dispose();
+
+	const std::string &error() const { return error_; }
+	long opCount() const { return opCount_; }
+
+private:
+	bool fail(const std::string &message);
+	bool createObjects(PageTemplate &tmpl, const ResolvedTemplate &form);
+	long rowY(const ResolvedTemplate &form, const TemplateOp &op, double shift);
+	bool drawField(const ResolvedTemplate &form, const TemplateOp &op, double shift,
+		const uint16_t *text, uint32_t length);
+	bool runRange(PageTemplate &tmpl, const ResolvedTemplate &form, uint32_t from, uint32_t to,
+		const TemplateValues &values, uint32_t scope, uint32_t row, double *shift);
+	bool lineTo(long x, long y);
+	bool flushPath();
+
+	Device *device_;
+	int dpix_, dpiy_;
+	double dx_, dy_;
+	const PageTemplate *objectsOf_;
+	std::vector<DeviceHandle> objects_;
+	std::vector<int> advances_;
+	// rules are merged like PageExecutor merges them
+	PathBuilder path_;
+	std::string error_;
+	long opCount_;
+};
+
+#endif
@@ -0,0 +1,284 @@
+#include "page.h"
+#include <math.h>
+#include <string.h>
+
+static const char *opCodeNames[] = {
+	0,
+	"move_to",
+	"line_to",
+	"create_font",
+	"set_font",
+	"set_text_color",
+	"create_pen",
+	"set_pen",
+	"draw_chars",
+	"push",
+	"pop",
+	"translate",
+	"scale",
+	"rotate",
+	"polyline",
+	"poly_polyline",
+	"rect",
+	"fill_rect",
+	"grid"
+};
+
+static const int opCodeCount = sizeof(opCodeNames) / sizeof(opCodeNames[0]);
+
+std::string utf16_to_utf8(const uint16_t *text, uint32_t length){
+	std::string out;
+	uint32_t i;
+	for(i=0;i<length;i++){
+		uint32_t c = text[i];
+		if( c >= 0xd800 && c < 0xdc00 && i + 1 < length &&
+				text[i+1] >= 0xdc00 && text[i+1] < 0xe000 ){
+			c = 0x10000 + ((c - 0xd800) << 10) + (text[i+1] - 0xdc00);
+			i += 1;
+		}
+		if( c < 0x80 ){
+			out += (char)c;
+		} else if( c < 0x800 ){
+			out += (char)(0xc0 | (c >> 6));
+			out += (char)(0x80 | (c & 0x3f));
+		} else if( c < 0x10000 ){
+			out += (char)(0xe0 | (c >> 12));
+			out += (char)(0x80 | ((c >> 6) & 0x3f));
+			out += (char)(0x80 | (c & 0x3f));
+		} else {
+			out += (char)(0xf0 | (c >> 18));
+			out += (char)(0x80 | ((c >> 12) & 0x3f));
+			out += (char)(0x80 | ((c >> 6) & 0x3f));
+			out += (char)(0x80 | (c & 0x3f));
+		}
+	}
+	return out;
+}
+
+double mm_from_float(float value){
+	return floor((double)value * 10000 + 0.5) / 10000;
+}
+
+const double *Page::coordArray(const CoordRef &ref, uint32_t n, std::vector<double> *scratch,
+		size_t *stride) const {
+	uint32_t i;
+	if( ref.count == 0 ){
+		*stride = 0;
+		return &ref.value;
+	}
+	*stride = 1;
+	if( coords.doubles ){
+		return coords.doubles + ref.offset;
+	}
+	scratch->resize(n);
+	for(i=0;i<n;i++){
+		(*scratch)[i] = mm_from_float(coords.floats[ref.offset + i]);
+	}
+	return n > 0 ? &(*scratch)[0] : 0;
+}
+
+const char *op_code_name(int code){
+	if( code <= 0 || code >= opCodeCount ){
+		return "unknown";
+	}
+	return opCodeNames[code];
+}
+
+int op_code_from_name(const char *name){
+	int i;
+	for(i=1;i<opCodeCount;i++){
+		if( strcmp(opCodeNames[i], name) == 0 ){
+			return i;
+		}
+	}
+	return 0;
+}
+
+PageBuilder::PageBuilder(){
+}
+
+void PageBuilder::clear(){
+	page_.ops.clear();
+	text_.clear();
+	coords_.clear();
+	page_.text = 0;
+	page_.textSize = 0;
+	page_.coords.doubles = 0;
+	page_.coords.size = 0;
+}
+
+TextRef PageBuilder::addText(const uint16_t *data, uint32_t length){
+	TextRef ref;
+	ref.offset = (uint32_t)text_.size();
+	ref.length = length;
+	text_.insert(text_.end(), data, data + length);
+	return ref;
+}
+
+TextRef PageBuilder::addAscii(const char *str){
+	TextRef ref;
+	ref.offset = (uint32_t)text_.size();
+	ref.length = (uint32_t)strlen(str);
+	while( *str ){
+		text_.push_back((uint16_t)(unsigned char)*str++);
+	}
+	return ref;
+}
+
+CoordRef PageBuilder::scalar(double value){
+	CoordRef ref;
+	ref.value = value;
+	ref.offset = 0;
+	ref.count = 0;
+	return ref;
+}
+
+CoordRef PageBuilder::addCoords(const double *values, uint32_t count){
+	CoordRef ref;
+	ref.value = 0;
+	ref.offset = (uint32_t)coords_.size();
+	ref.count = count;
+	coords_.insert(coords_.end(), values, values + count);
+	return ref;
+}
+
+PageOp &PageBuilder::addOp(int code){
+	PageOp op;
+	memset(&op, 0, sizeof(op));
+	op.code = code;
+	page_.ops.push_back(op);
+	return page_.ops.back();
+}
+
+void PageBuilder::moveTo(double x, double y){
+	PageOp &op = addOp(OP_MOVE_TO);
+	op.xs = scalar(x);
+	op.ys = scalar(y);
+}
+
+void PageBuilder::lineTo(double x, double y){
+	PageOp &op = addOp(OP_LINE_TO);
+	op.xs = scalar(x);
+	op.ys = scalar(y);
+}
+
+void PageBuilder::createFont(const char *name, const char *face, double size, int weight, int italic){
+	TextRef nameRef = addAscii(name);
+	TextRef faceRef = addAscii(face);
+	PageOp &op = addOp(OP_CREATE_FONT);
+	op.name = nameRef;
+	op.face = faceRef;
+	op.size = size;
+	op.weight = weight;
+	op.italic = italic;
+}
+
+void PageBuilder::setFont(const char *name){
+	TextRef nameRef = addAscii(name);
+	PageOp &op = addOp(OP_SET_FONT);
+	op.name = nameRef;
+}
+
+void PageBuilder::setTextColor(int r, int g, int b){
+	PageOp &op = addOp(OP_SET_TEXT_COLOR);
+	op.r = r;
+	op.g = g;
+	op.b = b;
+}
+
+void PageBuilder::createPen(const char *name, int r, int g, int b, double width){
+	TextRef nameRef = addAscii(name);
+	PageOp &op = addOp(OP_CREATE_PEN);
+	op.name = nameRef;
+	op.r = r;
+	op.g = g;
+	op.b = b;
+	op.size = width;
+}
+
+void PageBuilder::setPen(const char *name){
+	TextRef nameRef = addAscii(name);
+	PageOp &op = addOp(OP_SET_PEN);
+	op.name = nameRef;
+}
+
+void PageBuilder::drawChars(const uint16_t *text, uint32_t length, CoordRef xs, CoordRef ys){
+	TextRef textRef = addText(text, length);
+	PageOp &op = addOp(OP_DRAW_CHARS);
+	op.text = textRef;
+	op.xs = xs;
+	op.ys = ys;
+}
+
+void PageBuilder::push(){
+	addOp(OP_PUSH);
+}
+
+void PageBuilder::pop(){
+	addOp(OP_POP);
+}
+
+void PageBuilder::translate(double dx, double dy){
+	PageOp &op = addOp(OP_TRANSLATE);
+	op.xs = scalar(dx);
+	op.ys = scalar(dy);
+}
+
+void PageBuilder::scale(double sx, double sy){
+	PageOp &op = addOp(OP_SCALE);
+	op.xs = scalar(sx);
+	op.ys = scalar(sy);
+}
+
+void PageBuilder::rotate(double degrees){
+	PageOp &op = addOp(OP_ROTATE);
+	op.xs = scalar(degrees);
+	op.ys = scalar(0);
+}
+
+void PageBuilder::polyline(CoordRef xs, CoordRef ys){
+	PageOp &op = addOp(OP_POLYLINE);
+	op.xs = xs;
+	op.ys = ys;
+}
+
+void PageBuilder::polyPolyline(CoordRef xs, CoordRef ys, CoordRef counts){
+	PageOp &op = addOp(OP_POLY_POLYLINE);
+	op.xs = xs;
+	op.ys = ys;
+	op.counts = counts;
+}
+
+void PageBuilder::rect(double x, double y, double width, double height){
+	PageOp &op = addOp(OP_RECT);
+	op.xs = scalar(x);
+	op.ys = scalar(y);
+	op.width = width;
+	op.height = height;
+}
+
+void PageBuilder::fillRect(double x, double y, double width, double height, int r, int g, int b){
+	PageOp &op = addOp(OP_FILL_RECT);
+	op.xs = scalar(x);
+	op.ys = scalar(y);
+	op.width = width;
+	op.height = height;
+	op.r = r;
+	op.g = g;
+	op.b = b;
+}
+
+void PageBuilder::grid(CoordRef xs, CoordRef ys){
+	PageOp &op = addOp(OP_GRID);
+	op.xs = xs;
+	op.ys = ys;
+}
+
+Page &PageBuilder::finish(){
+	page_.text = text_.empty() ? 0 : &text_[0];
+	page_.textSize = (uint32_t)text_.size();
+	page_.coords.doubles = coords_.empty() ? 0 : &coords_[0];
+	page_.coords.floats = 0;
+	page_.coords.size = (uint32_t)coords_.size();
+	return page_;
+}
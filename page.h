@@ -0,0 +1,184 @@
+#ifndef DRAWER_PAGE_H
+#define DRAWER_PAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// Native form of the page ops understood by printer.js:
+//
+//   ["move_to", x, y]
+//   ["line_to", x, y]
+//   ["create_font", name, fontName, size, weight?, italic?]
+//   ["set_font", name]
+//   ["set_text_color", r, g, b]
+//   ["create_pen", name, r, g, b, width]
+//   ["set_pen", name]
+//   ["draw_chars", text, xs, ys]
+//   ["push"]
+//   ["pop"]
+//   ["translate", dx, dy]
+//   ["scale", sx, sy?]
+//   ["rotate", degrees]
+//   ["polyline", xs, ys]
+//   ["poly_polyline", xs, ys, counts]
+//   ["rect", x, y, width, height]
+//   ["fill_rect", x, y, width, height, r, g, b]
+//   ["grid", xs, ys]
+//
+// polyline draws through the points (xs or ys may be a single value),
+// poly_polyline draws counts[i] points per polyline, rect outlines and
+// fill_rect fills a rectangle, and grid draws a line along each x from the
+// first to the last y and along each y from the first to the last x, like
+// the rules of a table. They are drawn with the current pen (fill_rect
+// with its color) and leave the current point alone.
+//
+// Coordinates and sizes stay in mm; the transform ops and the conversion to
+// device pixels are applied by PageExecutor (see transform.h). Strings
+// (names, font faces, texts) live in a shared UTF-16 pool and coordinate
+// arrays in a shared coordinate pool, so a page is a flat list of fixed
+// size records.
+
+enum OpCode {
+	OP_MOVE_TO = 1,
+	OP_LINE_TO = 2,
+	OP_CREATE_FONT = 3,
+	OP_SET_FONT = 4,
+	OP_SET_TEXT_COLOR = 5,
+	OP_CREATE_PEN = 6,
+	OP_SET_PEN = 7,
+	OP_DRAW_CHARS = 8,
+	OP_PUSH = 9,
+	OP_POP = 10,
+	OP_TRANSLATE = 11,
+	OP_SCALE = 12,
+	OP_ROTATE = 13,
+	OP_POLYLINE = 14,
+	OP_POLY_POLYLINE = 15,
+	OP_RECT = 16,
+	OP_FILL_RECT = 17,
+	OP_GRID = 18
+};
+
+const char *op_code_name(int code);
+int op_code_from_name(const char *name);
+std::string utf16_to_utf8(const uint16_t *text, uint32_t length);
+
+struct TextRef {
+	uint32_t offset;
+	uint32_t length;
+};
+
+// A run of mm coordinates: either a single value (count == 0) or count
+// entries of the coordinate pool starting at offset.
+struct CoordRef {
+	double value;
+	uint32_t offset;
+	uint32_t count;
+};
+
+struct PageOp {
+	int code;
+	TextRef name;      // create_font, set_font, create_pen, set_pen
+	TextRef face;      // create_font
+	TextRef text;      // draw_chars
+	CoordRef xs;       // move_to, line_to, draw_chars, translate, scale, polyline,
+	                   // poly_polyline, grid; rotate: degrees; rect, fill_rect: x
+	CoordRef ys;       // move_to, line_to, draw_chars, translate, scale, polyline,
+	                   // poly_polyline, grid; rect, fill_rect: y
+	CoordRef counts;   // poly_polyline: points per polyline
+	double size;       // create_font: height, create_pen: width (mm)
+	double width;      // rect, fill_rect (mm)
+	double height;     // rect, fill_rect (mm)
+	int weight;        // create_font: 0 or bold flag
+	int italic;        // create_font
+	int r, g, b;       // set_text_color, create_pen, fill_rect
+};
+
+// float32 mm values are rounded to 0.1 um, so that decimal values like 25.4
+// convert to the same pixels as the doubles of the JSON ops.
+double mm_from_float(float value);
+
+// Coordinate pool that is either owned (doubles, built from JS values) or
+// borrowed (float32 values living in an external buffer).
+struct CoordPool {
+	const double *doubles;
+	const float *floats;
+	uint32_t size;
+
+	double at(uint32_t i) const {
+		return doubles ? doubles[i] : mm_from_float(floats[i]);
+	}
+};
+
+struct Page {
+	std::vector<PageOp> ops;
+	const uint16_t *text;     // UTF-16 text pool
+	uint32_t textSize;
+	CoordPool coords;
+
+	Page(){
+		text = 0;
+		textSize = 0;
+		coords.doubles = 0;
+		coords.floats = 0;
+		coords.size = 0;
+	}
+
+	const uint16_t *textOf(const TextRef &ref) const {
+		return text + ref.offset;
+	}
+
+	double coordAt(const CoordRef &ref, uint32_t i) const {
+		return ref.count == 0 ? ref.value : coords.at(ref.offset + i);
+	}
+
+	// The first n coordinates of ref as doubles for transform_points: the
+	// value with stride 0, the pool itself or converted float32 values kept
+	// in scratch.
+	const double *coordArray(const CoordRef &ref, uint32_t n, std::vector<double> *scratch,
+		size_t *stride) const;
+};
+
+// Builds a Page that owns its pools. Pointers inside the Page are fixed up by
+// finish(), so the builder must outlive the page it produced.
+class PageBuilder {
+public:
+	PageBuilder();
+	void clear();
+	TextRef addText(const uint16_t *data, uint32_t length);
+	TextRef addAscii(const char *str);
+	CoordRef scalar(double value);
+	CoordRef addCoords(const double *values, uint32_t count);
+	PageOp &addOp(int code);
+
+	void moveTo(double x, double y);
+	void lineTo(double x, double y);
+	void createFont(const char *name, const char *face, double size, int weight, int italic);
+	void setFont(const char *name);
+	void setTextColor(int r, int g, int b);
+	void createPen(const char *name, int r, int g, int b, double width);
+	void setPen(const char *name);
+	void drawChars(const uint16_t *text, uint32_t length, CoordRef xs, CoordRef ys);
+	void push();
+	void pop();
+	void translate(double dx, double dy);
+	void scale(double sx, double sy);
+	void rotate(double degrees);
+	void polyline(CoordRef xs, CoordRef ys);
+	void polyPolyline(CoordRef xs, CoordRef ys, CoordRef counts);
+	void rect(double x, double y, double width, double height);
+	void fillRect(double x, double y, double width, double height, int r, int g, int b);
+	void grid(CoordRef xs, CoordRef ys);
+
+	Page &finish();
+	Page &page(){ return page_; }
+
+private:
+	Page page_;
+	std::vector<uint16_t> text_;
+	std::vector<double> coords_;
+};
+
+#endif
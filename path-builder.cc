@@ -0,0 +1,77 @@
+#include "path-builder.h"
+
+PathBuilder::PathBuilder(){
+	reset();
+}
+
+void PathBuilder::reset(){
+	clear();
+	x_ = 0;
+	y_ = 0;
+	hasCurrent_ = false;
+	moved_ = false;
+}
+
+void PathBuilder::clear(){
+	points_.clear();
+	counts_.clear();
+	open_ = false;
+}
+
+void PathBuilder::moveTo(long x, long y){
+	x_ = x;
+	y_ = y;
+	hasCurrent_ = true;
+	open_ = false;
+	moved_ = true;
+}
+
+bool PathBuilder::lineTo(long x, long y){
+	if( !hasCurrent_ ){
+		return false;
+	}
+	if( !open_ ){
+		points_.push_back(x_);
+		points_.push_back(y_);
+		counts_.push_back(1);
+		open_ = true;
+	}
+	points_.push_back(x);
+	points_.push_back(y);
+	counts_.back() += 1;
+	x_ = x;
+	y_ = y;
+	moved_ = false;
+	return true;
+}
+
+void PathBuilder::setCurrent(long x, long y){
+	x_ = x;
+	y_ = y;
+	hasCurrent_ = true;
+	open_ = false;
+	moved_ = false;
+}
+
+void PathBuilder::addPolyline(const long *xs, const long *ys, size_t n){
+	size_t i;
+	if( n < 2 ){
+		return;
+	}
+	for(i=0;i<n;i++){
+		points_.push_back(xs[i]);
+		points_.push_back(ys[i]);
+	}
+	counts_.push_back((uint32_t)n);
+	open_ = false;
+}
+
+bool PathBuilder::takePendingMove(long *x, long *y){
+	if( !moved_ ){
+		return false;
+	}
+	*x = x_;
+	*y = y_;
+	moved_ = false;
+	return true;
+}
@@ -0,0 +1,62 @@
+#ifndef DRAWER_PATH_BUILDER_H
+#define DRAWER_PATH_BUILDER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Collects the lines of a page in device pixels so that they reach the
+// device as one Device::polyPolyline instead of a moveTo/lineTo call each.
+// A run of line_to ops becomes one polyline starting at the point of the
+// move_to before it; polyline, poly_polyline, rect and grid ops add
+// polylines of their own.
+// The owner submits what was collected (points(), counts()) before anything
+// else is drawn, since the lines have to stay under what follows them.
+//
+// Like GDI, added polylines neither use nor move the current point; only
+// moveTo and lineTo do.
+class PathBuilder {
+public:
+	PathBuilder();
+
+	// Forgets the collected lines and the current point.
+	void reset();
+	// Forgets the collected lines; the current point stays.
+	void clear();
+
+	void moveTo(long x, long y);
+	// false, with nothing added, when there is no current point yet (the
+	// device's own current point is the start of the line then).
+	bool lineTo(long x, long y);
+	// Makes (x, y) the current point, for a lineTo the owner drew itself.
+	void setCurrent(long x, long y);
+	// Polylines of fewer than 2 points are ignored.
+	void addPolyline(const long *xs, const long *ys, size_t n);
+
+	bool empty() const { return counts_.empty(); }
+	// x, y pairs of all polylines, one after another
+	const std::vector<long> &points() const { return points_; }
+	const std::vector<uint32_t> &counts() const { return counts_; }
+
+	// true with the current point when a moveTo came after the last line
+	// drawn from it: the device has to move there itself, for a caller that
+	// relies on its current point. Reported once.
+	bool takePendingMove(long *x, long *y);
+
+private:
+	std::vector<long> points_;
+	std::vector<uint32_t> counts_;
+	long x_, y_;
+	bool hasCurrent_;
+	// the last polyline ends at the current point and lineTo extends it
+	bool open_;
+	bool moved_;
+};
+
+// Scratch arrays for converting the points of one op, mm to device pixels.
+struct PointScratch {
+	std::vector<double> mmXs, mmYs;
+	std::vector<long> xs, ys;
+};
+
+#endif
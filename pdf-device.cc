@@ -0,0 +1,641 @@
+#include "pdf-device.h"
+#include "deflate.h"
+#include "page-executor.h"
+#include <stdio.h>
+#include <string.h>
+
+// The standard 14 fonts used for text, by family * 4 + italic * 2 + bold.
+static const char *const standardFonts[12] = {
+	"Helvetica", "Helvetica-Bold", "Helvetica-Oblique", "Helvetica-BoldOblique",
+	"Times-Roman", "Times-Bold", "Times-Italic", "Times-BoldItalic",
+	"Courier", "Courier-Bold", "Courier-Oblique", "Courier-BoldOblique"
+};
+
+// Em size and ascent of each family in units of the GDI cell height (the
+// font height page ops give), from the metrics of Arial, Times New Roman
+// and Courier New, so that text lands where the printer puts it.
+static const double familyEm[3] = { 0.895, 0.903, 0.883 };
+static const double familyAscent[3] = { 0.810, 0.805, 0.735 };
+
+// WinAnsiEncoding of U+20AC, U+201A, ... for bytes 0x80-0x9f (0: none).
+static const uint16_t winAnsiHigh[32] = {
+	0x20ac, 0, 0x201a, 0x0192, 0x201e, 0x2026, 0x2020, 0x2021,
+	0x02c6, 0x2030, 0x0160, 0x2039, 0x0152, 0, 0x017d, 0,
+	0, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+	0x02dc, 0x2122, 0x0161, 0x203a, 0x0153, 0, 0x017e, 0x0178
+};
+
+// Objects at fixed numbers; pages follow as content stream + page pairs, and
+// the fonts come last.
+static const uint32_t CATALOG_OBJECT = 1;
+static const uint32_t PAGES_OBJECT = 2;
+static const uint32_t RESOURCES_OBJECT = 3;
+static const uint32_t INFO_OBJECT = 4;
+static const uint32_t FIRST_PAGE_OBJECT = 5;
+
+static uint8_t win_ansi(uint16_t c){
+	int i;
+	if( (c >= 0x20 && c < 0x7f) || (c >= 0xa0 && c <= 0xff) ){
+		return (uint8_t)c;
+	}
+	for(i=0;i<32;i++){
+		if( winAnsiHigh[i] == c && c != 0 ){
+			return (uint8_t)(0x80 + i);
+		}
+	}
+	return '?';
+}
+
+static bool face_has(const uint16_t *face, uint32_t length, const char *ascii){
+	uint32_t i, j, n = (uint32_t)strlen(ascii);
+	for(i=0;i+n<=length;i++){
+		for(j=0;j<n;j++){
+			uint16_t c = face[i + j];
+			if( c >= 'A' && c <= 'Z' ){
+				c += 'a' - 'A';
+			}
+			if( c != (unsigned char)ascii[j] ){
+				break;
+			}
+		}
+		if( j == n ){
+			return true;
+		}
+	}
+	return false;
+}
+
+// 0 sans serif, 1 serif, 2 fixed pitch.
+static int font_family(const uint16_t *face, uint32_t length){
+	static const uint16_t mincho[2] = { 0x660e, 0x671d };
+	uint32_t i;
+	if( face_has(face, length, "courier") || face_has(face, length, "mono") ||
+			face_has(face, length, "consol") || face_has(face, length, "console") ){
+		return 2;
+	}
+	if( face_has(face, length, "sans") ){
+		return 0;
+	}
+	if( face_has(face, length, "times") || face_has(face, length, "serif") ||
+			face_has(face, length, "mincho") || face_has(face, length, "century") ||
+			face_has(face, length, "georgia") ){
+		return 1;
+	}
+	for(i=0;i+1<length;i++){
+		if( face[i] == mincho[0] && face[i + 1] == mincho[1] ){
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static void append_number(std::string *out, double value){
+	char buf[32];
+	int n = snprintf(buf, sizeof(buf), "%.4f", value);
+	while( n > 0 && buf[n - 1] == '0' ){
+		n -= 1;
+	}
+	if( n > 0 && buf[n - 1] == '.' ){
+		n -= 1;
+	}
+	if( n == 2 && buf[0] == '-' && buf[1] == '0' ){
+		buf[0] = '0';
+		n = 1;
+	}
+	out->append(buf, n);
+}
+
+static void append_long(std::string *out, long value){
+	char buf[24];
+	int n = snprintf(buf, sizeof(buf), "%ld", value);
+	out->append(buf, n);
+}
+
+static void append_string(std::string *out, const uint16_t *text, uint32_t length){
+	uint32_t i;
+	out->push_back('(');
+	for(i=0;i<length;i++){
+		uint8_t c = win_ansi(text[i]);
+		if( c == '(' || c == ')' || c == '\\' ){
+			out->push_back('\\');
+		}
+		out->push_back((char)c);
+	}
+	out->push_back(')');
+}
+
+PdfFileOutput::~PdfFileOutput(){
+	if( file_ ){
+		fclose(file_);
+	}
+}
+
+bool PdfFileOutput::write(const void *data, size_t length){
+	if( file_ == NULL || fwrite(data, 1, length, file_) != length ){
+		return false;
+	}
+	bytes_ += length;
+	return true;
+}
+
+bool PdfFileOutput::close(std::string *err){
+	bool ok = file_ != NULL && fflush(file_) == 0 && !ferror(file_);
+	if( file_ && fclose(file_) != 0 ){
+		ok = false;
+	}
+	file_ = NULL;
+	if( !ok ){
+		*err = "cannot write pdf file";
+	}
+	return ok;
+}
+
+bool PdfBufferOutput::write(const void *data, size_t length){
+	const uint8_t *bytes = (const uint8_t *)data;
+	out_->insert(out_->end(), bytes, bytes + length);
+	return true;
+}
+
+PdfDevice::PdfDevice(PdfOutput *out, const PdfOptions &opts){
+	out_ = out;
+	opts_ = opts;
+	started_ = false;
+	inPage_ = false;
+	offset_ = 0;
+	pageCount_ = 0;
+	fontsUsed_ = 0;
+	font_ = -1;
+	fontSize_ = 0;
+	penWidth_ = 0;
+	penColor_ = 0;
+	textColor_ = 0;
+	x_ = 0;
+	y_ = 0;
+	pathOpen_ = false;
+	atCurrent_ = false;
+	bottom_ = 0;
+}
+
+bool PdfDevice::fail(const std::string &message){
+	error_ = message;
+	return false;
+}
+
+bool PdfDevice::put(const void *data, size_t length){
+	if( !out_->write(data, length) ){
+		started_ = false;
+		return fail("cannot write pdf output");
+	}
+	offset_ += length;
+	return true;
+}
+
+bool PdfDevice::put(const std::string &data){
+	return put(data.data(), data.size());
+}
+
+bool PdfDevice::beginObject(uint32_t number){
+	char buf[32];
+	if( offsets_.size() < number ){
+		offsets_.resize(number, 0);
+	}
+	offsets_[number - 1] = offset_;
+	int n = snprintf(buf, sizeof(buf), "%u 0 obj\n", number);
+	return put(buf, n);
+}
+
+bool PdfDevice::startDoc(const uint16_t *jobName, uint32_t length){
+	static const char header[] = "%PDF-1.4\n%\xe2\xe3\xcf\xd3\n";
+	uint32_t i;
+	if( started_ ){
+		return fail("pdf document already started");
+	}
+	if( opts_.dpi <= 0 ){
+		return fail("invalid pdf resolution");
+	}
+	error_.clear();
+	offsets_.clear();
+	pageCount_ = 0;
+	fontsUsed_ = 0;
+	title_.clear();
+	for(i=0;i<length;i++){
+		char buf[8];
+		snprintf(buf, sizeof(buf), "%04X", jobName[i]);
+		title_ += buf;
+	}
+	started_ = true;
+	return put(header, sizeof(header) - 1) &&
+		beginObject(CATALOG_OBJECT) &&
+		put("<< /Type /Catalog /Pages 2 0 R >>\nendobj\n");
+}
+
+bool PdfDevice::abortDoc(){
+	// the output is left incomplete; the caller discards it
+	started_ = false;
+	inPage_ = false;
+	return true;
+}
+
+bool PdfDevice::startPage(){
+	if( !started_ || inPage_ ){
+		return fail("startPage outside of a pdf document");
+	}
+	inPage_ = true;
+	content_.clear();
+	pathOpen_ = false;
+	atCurrent_ = false;
+	bottom_ = 0;
+	pageWidth_ = -1;
+	pageStroke_ = -1;
+	pageFill_ = -1;
+	pageFont_ = -1;
+	pageFontSize_ = -1;
+	return true;
+}
+
+void PdfDevice::strokePath(){
+	if( pathOpen_ ){
+		content_ += "S\n";
+		pathOpen_ = false;
+	}
+	atCurrent_ = false;
+}
+
+void PdfDevice::putColor(const char *op, int color){
+	append_number(&content_, ((color >> 16) & 0xff) / 255.0);
+	content_ += ' ';
+	append_number(&content_, ((color >> 8) & 0xff) / 255.0);
+	content_ += ' ';
+	append_number(&content_, (color & 0xff) / 255.0);
+	content_ += ' ';
+	content_ += op;
+	content_ += '\n';
+}
+
+void PdfDevice::note(long y){
+	if( y > bottom_ ){
+		bottom_ = y;
+	}
+}
+
+bool PdfDevice::moveTo(long x, long y){
+	if( x != x_ || y != y_ ){
+		atCurrent_ = false;
+	}
+	x_ = x;
+	y_ = y;
+	return true;
+}
+
+bool PdfDevice::lineTo(long x, long y){
+	if( !inPage_ ){
+		return fail("lineTo outside of a page");
+	}
+	if( !pathOpen_ ){
+		// a path takes the pen at the time it is stroked, so the pen is set
+		// before the path starts
+		long width = penWidth_ > 1 ? penWidth_ : 1;
+		if( width != pageWidth_ ){
+			append_long(&content_, width);
+			content_ += " w\n";
+			pageWidth_ = width;
+		}
+		if( penColor_ != pageStroke_ ){
+			putColor("RG", penColor_);
+			pageStroke_ = penColor_;
+		}
+	}
+	if( !atCurrent_ ){
+		append_long(&content_, x_);
+		content_ += ' ';
+		append_long(&content_, y_);
+		content_ += " m\n";
+	}
+	append_long(&content_, x);
+	content_ += ' ';
+	append_long(&content_, y);
+	content_ += " l\n";
+	pathOpen_ = true;
+	atCurrent_ = true;
+	note((y_ > y ? y_ : y) + (penWidth_ + 1) / 2 + 1);
+	x_ = x;
+	y_ = y;
+	return true;
+}
+
+bool PdfDevice::fillRect(long left, long top, long right, long bottom, int r, int g, int b){
+	if( !inPage_ ){
+		return fail("fillRect outside of a page");
+	}
+	int color = ((r & 0xff) << 16) | ((g & 0xff) << 8) | (b & 0xff);
+	strokePath();
+	if( color != pageFill_ ){
+		putColor("rg", color);
+		pageFill_ = color;
+	}
+	append_long(&content_, left);
+	content_ += ' ';
+	append_long(&content_, top);
+	content_ += ' ';
+	append_long(&content_, right - left);
+	content_ += ' ';
+	append_long(&content_, bottom - top);
+	content_ += " re f\n";
+	note(bottom);
+	return true;
+}
+
+// Starts a text object with the selected font at (x, y), the top of the
+// character cell, and returns false when no font is selected.
+bool PdfDevice::beginText(long x, long y){
+	if( !inPage_ ){
+		return fail("text outside of a page");
+	}
+	if( font_ < 0 ){
+		return fail("no font selected");
+	}
+	int family = font_ / 4;
+	strokePath();
+	if( textColor_ != pageFill_ ){
+		putColor("rg", textColor_);
+		pageFill_ = textColor_;
+	}
+	content_ += "BT\n";
+	if( font_ != pageFont_ || fontSize_ != pageFontSize_ ){
+		content_ += "/F";
+		append_long(&content_, font_);
+		content_ += ' ';
+		append_number(&content_, fontSize_ * familyEm[family]);
+		content_ += " Tf\n";
+		pageFont_ = font_;
+		pageFontSize_ = fontSize_;
+		fontsUsed_ |= 1u << font_;
+	}
+	// the page is flipped to device coordinates; flip the glyphs back
+	content_ += "1 0 0 -1 ";
+	append_long(&content_, x);
+	content_ += ' ';
+	append_number(&content_, y + fontSize_ * familyAscent[family]);
+	content_ += " Tm\n";
+	note(y + fontSize_);
+	return true;
+}
+
+bool PdfDevice::textOut(long x, long y, const uint16_t *text, uint32_t length){
+	if( length == 0 ){
+		return true;
+	}
+	if( !beginText(x, y) ){
+		return false;
+	}
+	append_string(&content_, text, length);
+	content_ += "Tj\nET\n";
+	return true;
+}
+
+// Each character is placed at its advance with Td (relative to the previous
+// one), which does not need the widths of the font.
+bool PdfDevice::textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances){
+	uint32_t i;
+	if( length == 0 ){
+		return true;
+	}
+	if( !beginText(x, y) ){
+		return false;
+	}
+	for(i=0;i<length;i++){
+		if( i > 0 ){
+			append_long(&content_, advances[i - 1]);
+			content_ += " 0 Td";
+		}
+		append_string(&content_, text + i, 1);
+		content_ += "Tj\n";
+	}
+	content_ += "ET\n";
+	return true;
+}
+
+bool PdfDevice::setTextColor(int r, int g, int b){
+	textColor_ = ((r & 0xff) << 16) | ((g & 0xff) << 8) | (b & 0xff);
+	return true;
+}
+
+DeviceHandle PdfDevice::createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic){
+	Object object;
+	object.font = true;
+	object.base = font_family(face, faceLength) * 4 + (italic ? 2 : 0) +
+		(weight >= FONT_WEIGHT_BOLD ? 1 : 0);
+	object.size = height < 0 ? -height : height;
+	object.color = 0;
+	object.live = true;
+	objects_.push_back(object);
+	return (DeviceHandle)objects_.size();
+}
+
+DeviceHandle PdfDevice::createPen(long width, int r, int g, int b){
+	Object object;
+	object.font = false;
+	object.base = 0;
+	object.size = width;
+	object.color = ((r & 0xff) << 16) | ((g & 0xff) << 8) | (b & 0xff);
+	object.live = true;
+	objects_.push_back(object);
+	return (DeviceHandle)objects_.size();
+}
+
+bool PdfDevice::selectObject(DeviceHandle handle){
+	if( handle == 0 || handle > objects_.size() || !objects_[handle - 1].live ){
+		return false;
+	}
+	const Object &object = objects_[handle - 1];
+	if( object.font ){
+		font_ = object.base;
+		fontSize_ = object.size;
+	} else if( object.size != penWidth_ || object.color != penColor_ ){
+		strokePath();
+		penWidth_ = object.size;
+		penColor_ = object.color;
+	}
+	return true;
+}
+
+bool PdfDevice::deleteObject(DeviceHandle handle){
+	if( handle == 0 || handle > objects_.size() || !objects_[handle - 1].live ){
+		return false;
+	}
+	objects_[handle - 1].live = false;
+	return true;
+}
+
+bool PdfDevice::endPage(){
+	if( !inPage_ ){
+		return fail("endPage outside of a page");
+	}
+	inPage_ = false;
+	strokePath();
+	content_ += "Q\n";
+	long height = opts_.height > 0 ? mm_to_pixel(opts_.dpi, opts_.height) : bottom_;
+	if( height < 1 ){
+		height = 1;
+	}
+	double scale = 72.0 / opts_.dpi;
+	double widthPt = opts_.width * 72 / 25.4;
+	double heightPt = height * scale;
+	// device pixels, y down, with round caps and joins like a GDI pen
+	std::string prefix = "q ";
+	append_number(&prefix, scale);
+	prefix += " 0 0 ";
+	append_number(&prefix, -scale);
+	prefix += " 0 ";
+	append_number(&prefix, heightPt);
+	prefix += " cm 1 J 1 j\n";
+
+	uint32_t contents = FIRST_PAGE_OBJECT + (uint32_t)pageCount_ * 2;
+	std::string dict = "<< /Length ";
+	if( opts_.compress ){
+		compressed_.clear();
+		Deflater deflater(&compressed_);
+		deflater.write((const uint8_t *)prefix.data(), prefix.size());
+		deflater.write((const uint8_t *)content_.data(), content_.size());
+		deflater.finish();
+		append_long(&dict, (long)compressed_.size());
+		dict += " /Filter /FlateDecode >>\nstream\n";
+	} else {
+		append_long(&dict, (long)(prefix.size() + content_.size()));
+		dict += " >>\nstream\n";
+	}
+	if( !beginObject(contents) || !put(dict) ){
+		return false;
+	}
+	if( opts_.compress ){
+		if( !put(compressed_.empty() ? NULL : &compressed_[0], compressed_.size()) ){
+			return false;
+		}
+	} else if( !put(prefix) || !put(content_) ){
+		return false;
+	}
+	std::string page = "\nendstream\nendobj\n";
+	if( !put(page) || !beginObject(contents + 1) ){
+		return false;
+	}
+	page = "<< /Type /Page /Parent 2 0 R /MediaBox [0 0 ";
+	append_number(&page, widthPt);
+	page += ' ';
+	append_number(&page, heightPt);
+	page += "] /Resources 3 0 R /Contents ";
+	append_long(&page, (long)contents);
+	page += " 0 R >>\nendobj\n";
+	if( !put(page) ){
+		return false;
+	}
+	pageCount_ += 1;
+	return true;
+}
+
+bool PdfDevice::endDoc(){
+	char buf[64];
+	uint32_t i, number;
+	if( !started_ || inPage_ ){
+		return fail("endDoc outside of a pdf document");
+	}
+	number = FIRST_PAGE_OBJECT + (uint32_t)pageCount_ * 2;
+	std::string text = "<< /Font <<";
+	for(i=0;i<12;i++){
+		if( fontsUsed_ & (1u << i) ){
+			if( !beginObject(number) ){
+				return false;
+			}
+			std::string font = "<< /Type /Font /Subtype /Type1 /BaseFont /";
+			font += standardFonts[i];
+			font += " /Encoding /WinAnsiEncoding >>\nendobj\n";
+			if( !put(font) ){
+				return false;
+			}
+			snprintf(buf, sizeof(buf), " /F%u %u 0 R", i, number);
+			text += buf;
+			number += 1;
+		}
+	}
+	text += " >> /ProcSet [/PDF /Text] >>\nendobj\n";
+	if( !beginObject(RESOURCES_OBJECT) || !put(text) ){
+		return false;
+	}
+
+	// the kids are written in pieces, so a long document does not need them
+	// in memory at once
+	if( !beginObject(PAGES_OBJECT) ){
+		return false;
+	}
+	text = "<< /Type /Pages /Count ";
+	append_long(&text, (long)pageCount_);
+	text += " /Kids [";
+	for(i=0;i<pageCount_;i++){
+		snprintf(buf, sizeof(buf), "%u 0 R ", FIRST_PAGE_OBJECT + i * 2 + 1);
+		text += buf;
+		if( text.size() >= 4096 ){
+			if( !put(text) ){
+				return false;
+			}
+			text.clear();
+		}
+	}
+	text += "] >>\nendobj\n";
+	if( !put(text) || !beginObject(INFO_OBJECT) ){
+		return false;
+	}
+	text = "<< /Producer (myclinic-drawer-printer)";
+	if( !title_.empty() ){
+		text += " /Title <FEFF" + title_ + ">";
+	}
+	text += " >>\nendobj\n";
+	if( !put(text) ){
+		return false;
+	}
+
+	uint64_t xref = offset_;
+	snprintf(buf, sizeof(buf), "xref\n0 %u\n", (uint32_t)offsets_.size() + 1);
+	text = buf;
+	text += "0000000000 65535 f \n";
+	for(i=0;i<offsets_.size();i++){
+		snprintf(buf, sizeof(buf), "%010llu 00000 n \n", (unsigned long long)offsets_[i]);
+		text += buf;
+		if( text.size() >= 4096 ){
+			if( !put(text) ){
+				return false;
+			}
+			text.clear();
+		}
+	}
+	snprintf(buf, sizeof(buf), "trailer\n<< /Size %u /Root 1 0 R /Info 4 0 R >>\n",
+		(uint32_t)offsets_.size() + 1);
+	text += buf;
+	snprintf(buf, sizeof(buf), "startxref\n%llu\n%%%%EOF\n", (unsigned long long)xref);
+	text += buf;
+	if( !put(text) ){
+		return false;
+	}
+	started_ = false;
+	return true;
+}
+
+bool render_pdf(const Page *const *pages, size_t count, const PdfOptions &opts,
+		const uint16_t *title, uint32_t titleLength, PdfOutput *out, std::string *err){
+	if( opts.dpi <= 0 || opts.dpi > 4800 || !(opts.width > 0 && opts.width <= 5000) ||
+			!(opts.height >= 0 && opts.height <= 5000) ){
+		*err = "invalid pdf options";
+		return false;
+	}
+	PdfDevice device(out, opts);
+	PageExecutor executor(&device);
+	executor.setOffset(opts.dx, opts.dy);
+	if( !executor.runJob(pages, count, title, titleLength) ){
+		*err = executor.error();
+		if( !device.error().empty() ){
+			*err += ": " + device.error();
+		}
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,170 @@
+#ifndef DRAWER_PDF_DEVICE_H
+#define DRAWER_PDF_DEVICE_H
+
+#include "device.h"
+#include "page.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+// Where a PdfDevice writes the document, front to back.
+class PdfOutput {
+public:
+	virtual ~PdfOutput(){}
+	virtual bool write(const void *data, size_t length) = 0;
+};
+
+// Writes to a file the caller opened (in binary mode); the output owns it.
+class PdfFileOutput : public PdfOutput {
+public:
+	explicit PdfFileOutput(FILE *file) : file_(file), bytes_(0) {}
+	~PdfFileOutput();
+
+	// Flushes and closes the file; false if it could not be written.
+	bool close(std::string *err);
+	uint64_t bytes() const { return bytes_; }
+
+	bool write(const void *data, size_t length);
+
+private:
+	FILE *file_;
+	uint64_t bytes_;
+};
+
+class PdfBufferOutput : public PdfOutput {
+public:
+	// Bytes are appended to out.
+	explicit PdfBufferOutput(std::vector<uint8_t> *out) : out_(out) {}
+
+	bool write(const void *data, size_t length);
+
+private:
+	std::vector<uint8_t> *out_;
+};
+
+struct PdfOptions {
+	// device pixels per inch the page ops are converted to
+	int dpi;
+	// page size in mm; height 0 ends each page below what is drawn
+	double width;
+	double height;
+	// offset of the page ops in mm
+	double dx, dy;
+	// FlateDecode the content streams
+	bool compress;
+
+	PdfOptions() : dpi(600), width(210), height(297), dx(0), dy(0), compress(true) {}
+};
+
+// Device that writes a PDF instead of printing. Each page's content stream
+// is built in memory and written out at endPage, so memory stays at one page
+// however long the document is; only the file offsets of the objects are
+// kept until the cross-reference table at endDoc.
+//
+// Fonts map to the standard 14 PDF fonts (Helvetica, Times or Courier by
+// face name, with bold and italic variants) and text to WinAnsiEncoding;
+// other characters come out as '?'. Each font used in the document is
+// written once and shared by all pages through one resource dictionary.
+// Pens become line width and stroke color operators, emitted only when they
+// change. Polylines extend the open path like lineTo does, and filled
+// rectangles are re f with the fill color.
+class PdfDevice : public Device {
+public:
+	PdfDevice(PdfOutput *out, const PdfOptions &opts);
+
+	// Why the last call failed.
+	const std::string &error() const { return error_; }
+	size_t pageCount() const { return pageCount_; }
+	uint64_t bytesWritten() const { return offset_; }
+
+	int dpix(){ return opts_.dpi; }
+	int dpiy(){ return opts_.dpi; }
+
+	bool startDoc(const uint16_t *jobName, uint32_t length);
+	bool endDoc();
+	bool abortDoc();
+	bool startPage();
+	bool endPage();
+
+	bool moveTo(long x, long y);
+	bool lineTo(long x, long y);
+	bool fillRect(long left, long top, long right, long bottom, int r, int g, int b);
+	bool textOut(long x, long y, const uint16_t *text, uint32_t length);
+	bool textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances);
+	bool setTextColor(int r, int g, int b);
+	bool setBkTransparent(){ return true; }
+
+	DeviceHandle createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic);
+	DeviceHandle createPen(long width, int r, int g, int b);
+	bool selectObject(DeviceHandle handle);
+	bool deleteObject(DeviceHandle handle);
+
+	struct Object {
+		bool font;
+		// font: index in the standard font table
+		int base;
+		// font height or pen width
+		long size;
+		// pen: 0xRRGGBB
+		int color;
+		bool live;
+	};
+
+private:
+	bool fail(const std::string &message);
+	bool put(const void *data, size_t length);
+	bool put(const std::string &data);
+	bool beginObject(uint32_t number);
+	void strokePath();
+	bool beginText(long x, long y);
+	void putColor(const char *op, int color);
+	// Extends the page below y, for pages that end below what is drawn.
+	void note(long y);
+
+	PdfOutput *out_;
+	PdfOptions opts_;
+	std::string error_;
+	bool started_;
+	bool inPage_;
+	uint64_t offset_;
+	// file offset of object i + 1
+	std::vector<uint64_t> offsets_;
+	// UTF-16BE hex of the job name
+	std::string title_;
+	size_t pageCount_;
+	// bit i: standard font i is used
+	uint32_t fontsUsed_;
+
+	std::vector<Object> objects_;
+	int font_;
+	long fontSize_;
+	long penWidth_;
+	int penColor_;
+	int textColor_;
+
+	// the page being drawn, in device pixels
+	std::string content_;
+	std::vector<uint8_t> compressed_;
+	long x_, y_;
+	// a path is drawn and not yet stroked
+	bool pathOpen_;
+	// the path's current point is (x_, y_)
+	bool atCurrent_;
+	long bottom_;
+	// state already set in content_; -1: not yet on this page
+	long pageWidth_;
+	int pageStroke_;
+	int pageFill_;
+	int pageFont_;
+	long pageFontSize_;
+};
+
+// Runs pages through a PageExecutor on a PdfDevice into out as one document.
+bool render_pdf(const Page *const *pages, size_t count, const PdfOptions &opts,
+	const uint16_t *title, uint32_t titleLength, PdfOutput *out, std::string *err);
+
+#endif
@@ -0,0 +1,436 @@
+#include "png-image.h"
+#include "resample.h"
+#include <string.h>
+
+static const uint8_t pngSignature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+static uint32_t read_be32(const uint8_t *p){
+	return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static bool png_error(std::string *err, const char *message){
+	*err = message;
+	return false;
+}
+
+static uint32_t channel_count(uint32_t colorType){
+	switch(colorType){
+		case PNG_RGB: return 3;
+		case PNG_GRAY_ALPHA: return 2;
+		case PNG_RGBA: return 4;
+		default: return 1;
+	}
+}
+
+static bool valid_depth(uint32_t colorType, uint32_t bitDepth){
+	switch(colorType){
+		case PNG_GRAY:
+			return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8 || bitDepth == 16;
+		case PNG_PALETTE:
+			return bitDepth == 1 || bitDepth == 2 || bitDepth == 4 || bitDepth == 8;
+		case PNG_RGB:
+		case PNG_GRAY_ALPHA:
+		case PNG_RGBA:
+			return bitDepth == 8 || bitDepth == 16;
+		default:
+			return false;
+	}
+}
+
+static inline uint8_t over_white(uint32_t c, uint32_t a){
+	if( a == 255 ){
+		return (uint8_t)c;
+	}
+	return (uint8_t)((c * a + 255 * (255 - a) + 127) / 255);
+}
+
+bool is_png(const uint8_t *data, size_t length){
+	return length >= 8 && memcmp(data, pngSignature, 8) == 0;
+}
+
+// Chunks are length, type, data and CRC; the CRCs are not checked, the zlib
+// checksum of the image data is.
+bool parse_png(const uint8_t *data, size_t length, PngImage *image, std::string *err){
+	if( !is_png(data, length) ){
+		return png_error(err, "not a PNG file");
+	}
+	size_t pos = 8;
+	bool header = false, hasPalette = false;
+	uint32_t paletteSize = 0, i;
+	uint8_t alpha[256];
+	memset(alpha, 255, sizeof(alpha));
+	memset(image->palette, 0, sizeof(image->palette));
+	image->hasKey = false;
+	while( true ){
+		if( length - pos < 12 ){
+			return png_error(err, "truncated PNG");
+		}
+		uint32_t chunkLength = read_be32(data + pos);
+		const uint8_t *type = data + pos + 4;
+		const uint8_t *chunk = data + pos + 8;
+		if( chunkLength > length - pos - 12 ){
+			return png_error(err, "truncated PNG");
+		}
+		if( !header ){
+			if( memcmp(type, "IHDR", 4) != 0 || chunkLength != 13 ){
+				return png_error(err, "invalid PNG header");
+			}
+			image->width = read_be32(chunk);
+			image->height = read_be32(chunk + 4);
+			image->bitDepth = chunk[8];
+			image->colorType = chunk[9];
+			if( image->width == 0 || image->height == 0 ||
+					image->width > 65535 || image->height > 1000000 ){
+				return png_error(err, "invalid PNG size");
+			}
+			if( !valid_depth(image->colorType, image->bitDepth) || chunk[10] != 0 || chunk[11] != 0 ){
+				return png_error(err, "unsupported PNG format");
+			}
+			if( chunk[12] != 0 ){
+				return png_error(err, "interlaced PNG is not supported");
+			}
+			header = true;
+		} else if( memcmp(type, "PLTE", 4) == 0 ){
+			paletteSize = chunkLength / 3;
+			if( chunkLength % 3 != 0 || paletteSize == 0 || paletteSize > 256 ){
+				return png_error(err, "invalid PNG palette");
+			}
+			for(i=0;i<paletteSize;i++){
+				image->palette[3 * i] = chunk[3 * i + 2];
+				image->palette[3 * i + 1] = chunk[3 * i + 1];
+				image->palette[3 * i + 2] = chunk[3 * i];
+			}
+			hasPalette = true;
+		} else if( memcmp(type, "tRNS", 4) == 0 ){
+			if( image->colorType == PNG_PALETTE ){
+				for(i=0;i<chunkLength&&i<256;i++){
+					alpha[i] = chunk[i];
+				}
+			} else if( image->colorType == PNG_GRAY && chunkLength >= 2 ){
+				image->hasKey = true;
+				image->key[0] = (uint16_t)((chunk[0] << 8) | chunk[1]);
+			} else if( image->colorType == PNG_RGB && chunkLength >= 6 ){
+				image->hasKey = true;
+				for(i=0;i<3;i++){
+					image->key[i] = (uint16_t)((chunk[2 * i] << 8) | chunk[2 * i + 1]);
+				}
+			}
+		} else if( memcmp(type, "IDAT", 4) == 0 ){
+			image->idat = pos;
+			break;
+		} else if( memcmp(type, "IEND", 4) == 0 ){
+			return png_error(err, "PNG has no image data");
+		}
+		pos += 12 + (size_t)chunkLength;
+	}
+	if( image->colorType == PNG_PALETTE ){
+		if( !hasPalette ){
+			return png_error(err, "PNG palette is missing");
+		}
+		for(i=0;i<paletteSize;i++){
+			uint8_t *p = image->palette + 3 * i;
+			p[0] = over_white(p[0], alpha[i]);
+			p[1] = over_white(p[1], alpha[i]);
+			p[2] = over_white(p[2], alpha[i]);
+		}
+	}
+	image->data = data;
+	image->length = length;
+	return true;
+}
+
+PngRowReader::PngRowReader(const PngImage &image) : image_(image), inflater_(this){
+	uint32_t bitsPerPixel = channel_count(image.colorType) * image.bitDepth;
+	size_t rowBytes = ((size_t)image.width * bitsPerPixel + 7) / 8;
+	chunk_ = image.idat;
+	row_.assign(rowBytes + 1, 0);
+	previous_.assign(rowBytes + 1, 0);
+	filterUnit_ = bitsPerPixel < 8 ? 1 : bitsPerPixel / 8;
+}
+
+// The consecutive IDAT chunks from the first one.
+bool PngRowReader::next(const uint8_t **data, size_t *length){
+	while( image_.length - chunk_ >= 12 ){
+		uint32_t chunkLength = read_be32(image_.data + chunk_);
+		if( memcmp(image_.data + chunk_ + 4, "IDAT", 4) != 0 ||
+				chunkLength > image_.length - chunk_ - 12 ){
+			return false;
+		}
+		*data = image_.data + chunk_ + 8;
+		*length = chunkLength;
+		chunk_ += 12 + (size_t)chunkLength;
+		if( chunkLength > 0 ){
+			return true;
+		}
+	}
+	return false;
+}
+
+static inline uint8_t paeth(int a, int b, int c){
+	int p = a + b - c;
+	int pa = p > a ? p - a : a - p;
+	int pb = p > b ? p - b : b - p;
+	int pc = p > c ? p - c : c - p;
+	if( pa <= pb && pa <= pc ){
+		return (uint8_t)a;
+	}
+	return (uint8_t)(pb <= pc ? b : c);
+}
+
+static bool unfilter(int filter, uint8_t *x, const uint8_t *prior, size_t n, size_t unit){
+	size_t i;
+	switch(filter){
+		case 0:
+			break;
+		case 1:
+			for(i=unit;i<n;i++){
+				x[i] = (uint8_t)(x[i] + x[i - unit]);
+			}
+			break;
+		case 2:
+			for(i=0;i<n;i++){
+				x[i] = (uint8_t)(x[i] + prior[i]);
+			}
+			break;
+		case 3:
+			for(i=0;i<unit&&i<n;i++){
+				x[i] = (uint8_t)(x[i] + (prior[i] >> 1));
+			}
+			for(;i<n;i++){
+				x[i] = (uint8_t)(x[i] + ((x[i - unit] + prior[i]) >> 1));
+			}
+			break;
+		case 4:
+			for(i=0;i<unit&&i<n;i++){
+				x[i] = (uint8_t)(x[i] + prior[i]);
+			}
+			for(;i<n;i++){
+				x[i] = (uint8_t)(x[i] + paeth(x[i - unit], prior[i], prior[i - unit]));
+			}
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
+static inline void put_gray(uint8_t *bgr, uint8_t gray){
+	bgr[0] = gray;
+	bgr[1] = gray;
+	bgr[2] = gray;
+}
+
+bool PngRowReader::readRow(uint8_t *bgr, std::string *err){
+	const PngImage &image = image_;
+	uint32_t width = image.width, depth = image.bitDepth, x;
+	size_t n = row_.size() - 1;
+	if( !inflater_.read(&row_[0], row_.size(), err) ){
+		return false;
+	}
+	if( !unfilter(row_[0], &row_[1], &previous_[1], n, filterUnit_) ){
+		return png_error(err, "invalid PNG filter");
+	}
+	const uint8_t *p = &row_[1];
+	switch(image.colorType){
+		case PNG_GRAY:
+			if( depth < 8 ){
+				uint32_t mask = (1u << depth) - 1, scale = 255 / mask, perByte = 8 / depth;
+				for(x=0;x<width;x++){
+					uint32_t v = (p[x / perByte] >> (8 - depth * (x % perByte + 1))) & mask;
+					put_gray(bgr + 3 * x, image.hasKey && v == image.key[0] ? 255 : (uint8_t)(v * scale));
+				}
+			} else if( depth == 8 ){
+				for(x=0;x<width;x++){
+					put_gray(bgr + 3 * x, image.hasKey && p[x] == image.key[0] ? 255 : p[x]);
+				}
+			} else {
+				for(x=0;x<width;x++){
+					uint32_t v = ((uint32_t)p[2 * x] << 8) | p[2 * x + 1];
+					put_gray(bgr + 3 * x, image.hasKey && v == image.key[0] ? 255 : p[2 * x]);
+				}
+			}
+			break;
+		case PNG_PALETTE: {
+			uint32_t mask = (1u << depth) - 1, perByte = 8 / depth;
+			for(x=0;x<width;x++){
+				uint32_t index = depth == 8 ? p[x] : (p[x / perByte] >> (8 - depth * (x % perByte + 1))) & mask;
+				memcpy(bgr + 3 * x, image.palette + 3 * index, 3);
+			}
+			break;
+		}
+		case PNG_RGB: {
+			uint32_t size = depth / 8, c;
+			for(x=0;x<width;x++){
+				const uint8_t *s = p + 3 * size * x;
+				bool transparent = image.hasKey;
+				for(c=0;c<3&&transparent;c++){
+					uint32_t v = size == 1 ? s[c] : ((uint32_t)s[2 * c] << 8) | s[2 * c + 1];
+					transparent = v == image.key[c];
+				}
+				if( transparent ){
+					put_gray(bgr + 3 * x, 255);
+				} else {
+					bgr[3 * x] = s[2 * size];
+					bgr[3 * x + 1] = s[size];
+					bgr[3 * x + 2] = s[0];
+				}
+			}
+			break;
+		}
+		case PNG_GRAY_ALPHA: {
+			uint32_t size = depth / 8;
+			for(x=0;x<width;x++){
+				const uint8_t *s = p + 2 * size * x;
+				put_gray(bgr + 3 * x, over_white(s[0], s[size]));
+			}
+			break;
+		}
+		case PNG_RGBA: {
+			uint32_t size = depth / 8;
+			for(x=0;x<width;x++){
+				const uint8_t *s = p + 4 * size * x;
+				uint32_t a = s[3 * size];
+				bgr[3 * x] = over_white(s[2 * size], a);
+				bgr[3 * x + 1] = over_white(s[size], a);
+				bgr[3 * x + 2] = over_white(s[0], a);
+			}
+			break;
+		}
+	}
+	row_.swap(previous_);
+	return true;
+}
+
+bool PngRowReader::finish(std::string *err){
+	return inflater_.finish(err);
+}
+
+static bool draw_png_color(const PngImage &image, PngRowReader &reader, ImageTarget *target,
+		long destX, long destY, long destWidth, long destHeight, uint32_t bandRows,
+		std::string *err){
+	std::vector<ImageBand> bands;
+	std::vector<uint8_t> info;
+	uint32_t stride = ((image.width * 24 + 31) / 32) * 4, y;
+	size_t i;
+	plan_image_bands(image.height, bandRows, destY, destHeight, &bands);
+	std::vector<uint8_t> pixels((size_t)stride * (bands.empty() ? 0 : bands[0].rows), 0);
+	for(i=0;i<bands.size();i++){
+		const ImageBand &band = bands[i];
+		for(y=0;y<band.rows;y++){
+			if( !reader.readRow(&pixels[(size_t)y * stride], err) ){
+				return false;
+			}
+		}
+		if( band.destHeight == 0 ){
+			continue;
+		}
+		make_dib_info(image.width, -(int32_t)band.rows, 24, &info);
+		if( !target->drawBand(destX, band.destY, destWidth, band.destHeight,
+				image.width, band.rows, &pixels[0], &info[0]) ){
+			*err = "StretchDIBits failed";
+			return false;
+		}
+	}
+	return true;
+}
+
+bool draw_png_banded(const PngImage &image, ImageTarget *target, long destX, long destY,
+		long destWidth, long destHeight, uint32_t bandRows, const MonoOptions *mono,
+		std::string *err){
+	PngRowReader reader(image);
+	if( destWidth <= 0 || destHeight <= 0 ){
+		return png_error(err, "invalid image size");
+	}
+	bool ok = mono ?
+		draw_resampled(&reader, target, destX, destY, destWidth, destHeight, RESAMPLE_BOX, bandRows, mono, 1, err) :
+		draw_png_color(image, reader, target, destX, destY, destWidth, destHeight, bandRows, err);
+	return ok && reader.finish(err);
+}
+
+struct CrcTable {
+	uint32_t values[256];
+
+	CrcTable(){
+		uint32_t n, k;
+		for(n=0;n<256;n++){
+			uint32_t c = n;
+			for(k=0;k<8;k++){
+				c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+			}
+			values[n] = c;
+		}
+	}
+};
+
+static uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t length){
+	static const CrcTable crcTable;
+	const uint32_t *table = crcTable.values;
+	size_t i;
+	for(i=0;i<length;i++){
+		crc = table[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+	}
+	return crc;
+}
+
+static void put_be32(std::vector<uint8_t> *out, uint32_t value){
+	out->push_back((uint8_t)(value >> 24));
+	out->push_back((uint8_t)(value >> 16));
+	out->push_back((uint8_t)(value >> 8));
+	out->push_back((uint8_t)value);
+}
+
+// Chunk of out starting at the 4 length bytes reserved at start.
+static void end_chunk(std::vector<uint8_t> *out, size_t start){
+	uint32_t length = (uint32_t)(out->size() - start - 8);
+	uint8_t *p = &(*out)[start];
+	p[0] = (uint8_t)(length >> 24);
+	p[1] = (uint8_t)(length >> 16);
+	p[2] = (uint8_t)(length >> 8);
+	p[3] = (uint8_t)length;
+	put_be32(out, crc32_update(0xffffffffu, &(*out)[start + 4], length + 4) ^ 0xffffffffu);
+}
+
+static size_t begin_chunk(std::vector<uint8_t> *out, const char *type){
+	size_t start = out->size(), i;
+	put_be32(out, 0);
+	for(i=0;i<4;i++){
+		out->push_back((uint8_t)type[i]);
+	}
+	return start;
+}
+
+void encode_png_gray(const uint8_t *pixels, ptrdiff_t stride, uint32_t width, uint32_t height,
+		uint32_t bitDepth, std::vector<uint8_t> *out){
+	size_t rowBytes = bitDepth == 1 ? (width + 7) / 8 : width, i;
+	std::vector<uint8_t> row(rowBytes + 1), zero(rowBytes, 0);
+	uint32_t y;
+	out->assign(pngSignature, pngSignature + 8);
+	size_t start = begin_chunk(out, "IHDR");
+	put_be32(out, width);
+	put_be32(out, height);
+	out->push_back((uint8_t)bitDepth);
+	out->push_back((uint8_t)PNG_GRAY);
+	// compression, filter, interlace
+	out->push_back(0);
+	out->push_back(0);
+	out->push_back(0);
+	end_chunk(out, start);
+
+	start = begin_chunk(out, "IDAT");
+	Deflater deflater(out);
+	const uint8_t *prior = &zero[0];
+	row[0] = 2;
+	for(y=0;y<height;y++){
+		const uint8_t *x = pixels + (ptrdiff_t)y * stride;
+		for(i=0;i<rowBytes;i++){
+			row[i + 1] = (uint8_t)(x[i] - prior[i]);
+		}
+		deflater.write(&row[0], row.size());
+		prior = x;
+	}
+	deflater.finish();
+	end_chunk(out, start);
+
+	start = begin_chunk(out, "IEND");
+	end_chunk(out, start);
+}
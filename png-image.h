@@ -0,0 +1,85 @@
+#ifndef DRAWER_PNG_IMAGE_H
+#define DRAWER_PNG_IMAGE_H
+
+#include "bmp-image.h"
+#include "deflate.h"
+#include "inflate.h"
+#include "mono-image.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// PNG color types
+const uint32_t PNG_GRAY = 0;
+const uint32_t PNG_RGB = 2;
+const uint32_t PNG_PALETTE = 3;
+const uint32_t PNG_GRAY_ALPHA = 4;
+const uint32_t PNG_RGBA = 6;
+
+// A PNG file that is read in place, like BmpImage: parse_png validates the
+// header chunks and the image data is decoded while printing.
+struct PngImage {
+	uint32_t width;
+	uint32_t height;
+	uint32_t bitDepth;
+	uint32_t colorType;
+	// PLTE with the tRNS alpha composited on white, BGR
+	uint8_t palette[256 * 3];
+	// tRNS of gray and RGB images: pixels of this value are transparent
+	bool hasKey;
+	uint16_t key[3];
+	const uint8_t *data;
+	size_t length;
+	// offset of the first IDAT chunk
+	size_t idat;
+};
+
+bool is_png(const uint8_t *data, size_t length);
+
+// Non-interlaced PNGs of all color types and bit depths are supported.
+bool parse_png(const uint8_t *data, size_t length, PngImage *image, std::string *err);
+
+// Decodes a PNG one row at a time, top row first, to BGR with transparency
+// composited on white. Only two rows of raw data and the inflate window are
+// kept, whatever the size of the image.
+class PngRowReader : public ImageRows, private InflateSource {
+public:
+	explicit PngRowReader(const PngImage &image);
+
+	uint32_t width() const { return image_.width; }
+	uint32_t height() const { return image_.height; }
+	// width * 3 bytes of the next row.
+	bool readRow(uint8_t *bgr, std::string *err);
+	// Checks the end of the image data; call after the last row.
+	bool finish(std::string *err);
+
+private:
+	bool next(const uint8_t **data, size_t *length);
+
+	const PngImage &image_;
+	Inflater inflater_;
+	size_t chunk_;
+	// filter byte and raw bytes of the current and previous rows
+	std::vector<uint8_t> row_;
+	std::vector<uint8_t> previous_;
+	uint32_t filterUnit_;
+};
+
+// Draws a PNG into (destX, destY, destWidth, destHeight) like
+// draw_bmp_banded, decoding each band of at most bandRows rows into a 24 bpp
+// DIB. With mono, rows are scaled to the destination size first (box
+// filter) and converted to 1 bpp there (bandRows then counts device rows), so
+// dithering works at device resolution.
+bool draw_png_banded(const PngImage &image, ImageTarget *target, long destX, long destY,
+	long destWidth, long destHeight, uint32_t bandRows, const MonoOptions *mono,
+	std::string *err);
+
+// Encodes rows of gray values (bitDepth 8) or of bits, most significant
+// first with 1 for white (bitDepth 1, as mono_pack), as a gray PNG. Each
+// row is stored with the Up filter, so that repeated rows compress to
+// almost nothing.
+void encode_png_gray(const uint8_t *pixels, ptrdiff_t stride, uint32_t width, uint32_t height,
+	uint32_t bitDepth, std::vector<uint8_t> *out);
+
+#endif
@@ -0,0 +1,130 @@
+#include "print-job.h"
+#include "page-executor.h"
+#include <chrono>
+
+const char *print_job_status_name(int status){
+	switch(status){
+		case JOB_PENDING: return "pending";
+		case JOB_DONE: return "done";
+		case JOB_CANCELED: return "canceled";
+		case JOB_FAILED: return "error";
+		default: return "unknown";
+	}
+}
+
+PrintJob::PrintJob(DeviceSource *source){
+	source_ = source;
+	dx_ = 0;
+	dy_ = 0;
+	copies_ = 1;
+	collate_ = true;
+	optimize_ = true;
+	driverCopies_ = false;
+	replayedPages_ = 0;
+	cancel_ = false;
+	status_ = JOB_PENDING;
+	opCount_ = 0;
+	elapsed_ = 0;
+	stats_ = NULL;
+	static const uint16_t defaultName[] = { 'd', 'r', 'a', 'w', 'e', 'r' };
+	jobName_.assign(defaultName, defaultName + 6);
+}
+
+PrintJob::~PrintJob(){
+	delete source_;
+	delete stats_;
+}
+
+void PrintJob::enableStats(const std::string &printer, long jobId){
+	if( !stats_ ){
+		stats_ = new JobStats();
+	}
+	stats_->printer = printer;
+	stats_->jobId = jobId;
+}
+
+PageBuilder &PrintJob::addPage(){
+	builders_.push_back(PageBuilder());
+	return builders_.back();
+}
+
+bool PrintJob::setEncodedPages(const char *data, size_t length, std::string *err){
+	// Copied, because the JS buffer may be changed or collected while the
+	// job waits for its worker.
+	encoded_.assign(data, data + length);
+	return decode_pages(encoded_.empty() ? 0 : &encoded_[0], encoded_.size(), &encodedJob_, err);
+}
+
+void PrintJob::setJobName(const uint16_t *name, uint32_t length){
+	jobName_.assign(name, name + length);
+}
+
+size_t PrintJob::pageCount() const {
+	return builders_.size() + encodedJob_.pages.size();
+}
+
+void PrintJob::run(){
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::vector<const Page *> pages;
+	size_t i;
+	for(i=0;i<builders_.size();i++){
+		pages.push_back(&builders_[i].page());
+	}
+	for(i=0;i<encodedJob_.pages.size();i++){
+		pages.push_back(&encodedJob_.pages[i]);
+	}
+	if( stats_ ){
+		stats_->begin(stats_now());
+	}
+	if( cancel_ ){
+		status_ = JOB_CANCELED;
+		error_ = "canceled";
+		if( stats_ ){
+			stats_->finish(print_job_status_name(status_));
+		}
+		return;
+	}
+	driverCopies_ = copies_ > 1 && source_->setCopies(copies_, collate_);
+	int64_t t = stats_ ? stats_->enter() : 0;
+	Device *device = source_->open(&error_);
+	if( stats_ ){
+		stats_->leave(PHASE_OPEN, t);
+	}
+	if( !device ){
+		status_ = JOB_FAILED;
+		if( stats_ ){
+			stats_->finish(print_job_status_name(status_));
+		}
+		return;
+	}
+	{
+		StatsDevice statsDevice(device, stats_);
+		PageExecutor executor(stats_ ? &statsDevice : device);
+		executor.setOffset(dx_, dy_);
+		executor.setCancelFlag(&cancel_);
+		if( !driverCopies_ ){
+			executor.setCopies(copies_, collate_);
+		}
+		executor.setOptimize(optimize_);
+		bool ok = executor.runJob(pages.empty() ? 0 : &pages[0], pages.size(),
+			jobName_.empty() ? 0 : &jobName_[0], (uint32_t)jobName_.size());
+		opCount_ = executor.opCount();
+		replayedPages_ = executor.replayedPages();
+		if( ok ){
+			status_ = JOB_DONE;
+		} else {
+			status_ = executor.canceled() ? JOB_CANCELED : JOB_FAILED;
+			error_ = executor.error();
+		}
+	}
+	if( stats_ ){
+		t = stats_->enter();
+	}
+	source_->close(device, status_ != JOB_DONE);
+	elapsed_ = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if( stats_ ){
+		stats_->leave(PHASE_CLOSE, t);
+		stats_->ops = opCount_;
+		stats_->finish(print_job_status_name(status_));
+	}
+}
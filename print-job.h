@@ -0,0 +1,92 @@
+#ifndef DRAWER_PRINT_JOB_H
+#define DRAWER_PRINT_JOB_H
+
+#include "page.h"
+#include "page-format.h"
+#include "device.h"
+#include "job-stats.h"
+#include <atomic>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Opens and closes the device of a PrintJob. Both are called on the thread
+// that runs the job.
+class DeviceSource {
+public:
+	virtual ~DeviceSource(){}
+	virtual Device *open(std::string *err) = 0;
+	// failed when the job did not end with JOB_DONE; the device may be left
+	// in a state that should not be reused.
+	virtual void close(Device *device, bool failed) = 0;
+	// Asks the device to make copies of every page itself (collated or page
+	// by page), before open(). False when it can't; the job then draws the
+	// copies, replaying each page from its display list.
+	virtual bool setCopies(int copies, bool collate){ return false; }
+};
+
+enum PrintJobStatus {
+	JOB_PENDING,
+	JOB_DONE,
+	JOB_CANCELED,
+	JOB_FAILED
+};
+
+const char *print_job_status_name(int status);
+
+// A print job that owns everything it needs, so that run() can be called on a
+// worker thread without touching JS values: the pages are captured up front
+// (either built op by op or as a copy of an encoded page buffer) and the
+// device is opened, drawn and closed inside run(). cancel() may be called
+// from any thread; a running job stops at the next op and aborts the
+// document.
+class PrintJob {
+public:
+	explicit PrintJob(DeviceSource *source);
+	~PrintJob();
+
+	PageBuilder &addPage();
+	bool setEncodedPages(const char *data, size_t length, std::string *err);
+	void setJobName(const uint16_t *name, uint32_t length);
+	void setOffset(double dx, double dy){ dx_ = dx; dy_ = dy; }
+	void setCopies(int copies, bool collate){ copies_ = copies < 1 ? 1 : copies; collate_ = collate; }
+	void setOptimize(bool optimize){ optimize_ = optimize; }
+	// Times the phases of run() and counts its device calls into stats(),
+	// which names the printer and the job.
+	void enableStats(const std::string &printer, long jobId);
+
+	void run();
+	void cancel(){ cancel_ = true; }
+
+	int status() const { return status_; }
+	const std::string &error() const { return error_; }
+	size_t pageCount() const;
+	long opCount() const { return opCount_; }
+	double elapsed() const { return elapsed_; }
+	// Copies made by the device, and pages the job drew from a display list.
+	bool driverCopies() const { return driverCopies_; }
+	long replayedPages() const { return replayedPages_; }
+	// NULL unless enableStats() was called; complete after run().
+	const JobStats *stats() const { return stats_; }
+
+private:
+	DeviceSource *source_;
+	std::deque<PageBuilder> builders_;
+	std::vector<char> encoded_;
+	EncodedJob encodedJob_;
+	std::vector<uint16_t> jobName_;
+	double dx_, dy_;
+	int copies_;
+	bool collate_;
+	bool optimize_;
+	bool driverCopies_;
+	long replayedPages_;
+	std::atomic<bool> cancel_;
+	int status_;
+	std::string error_;
+	long opCount_;
+	double elapsed_;
+	JobStats *stats_;
+};
+
+#endif
@@ -0,0 +1,143 @@
+#include "printer-caps.h"
+#include "dc-pool.h"
+
+PrinterCapsCache::PrinterCapsCache(CapsProvider *provider){
+	provider_ = provider;
+	hits_ = 0;
+	misses_ = 0;
+	failures_ = 0;
+}
+
+bool PrinterCapsCache::probe(const std::string &key, const std::string &printer,
+		const char *devmode, size_t devmodeLength, DeviceHandle dc, PrinterCaps *caps,
+		std::string *err){
+	PrinterCaps probed = PrinterCaps();
+	bool ok = provider_->probe(printer, devmode, devmodeLength, dc, &probed, err);
+	std::lock_guard<std::mutex> lock(mutex_);
+	misses_ += 1;
+	if( !ok ){
+		failures_ += 1;
+		return false;
+	}
+	if( key.empty() ){
+		unbound_[dc] = probed;
+	} else {
+		byKey_[key] = probed;
+		printerOf_[key] = printer;
+	}
+	*caps = probed;
+	return true;
+}
+
+bool PrinterCapsCache::get(const std::string &printer, const char *devmode, size_t devmodeLength,
+		PrinterCaps *caps, std::string *err){
+	std::string key = dc_pool_key(printer, devmode, devmodeLength);
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		std::map<std::string, PrinterCaps>::iterator iter = byKey_.find(key);
+		if( iter != byKey_.end() ){
+			hits_ += 1;
+			*caps = iter->second;
+			return true;
+		}
+	}
+	return probe(key, printer, devmode, devmodeLength, 0, caps, err);
+}
+
+bool PrinterCapsCache::getForDc(DeviceHandle dc, PrinterCaps *caps, std::string *err){
+	Binding binding;
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		std::map<DeviceHandle, Binding>::iterator iter = bound_.find(dc);
+		if( iter == bound_.end() ){
+			std::map<DeviceHandle, PrinterCaps>::iterator found = unbound_.find(dc);
+			if( found != unbound_.end() ){
+				hits_ += 1;
+				*caps = found->second;
+				return true;
+			}
+		} else {
+			std::map<std::string, PrinterCaps>::iterator found = byKey_.find(iter->second.key);
+			if( found != byKey_.end() ){
+				hits_ += 1;
+				*caps = found->second;
+				return true;
+			}
+			binding = iter->second;
+		}
+	}
+	// the DC is at hand, so the provider need not open one
+	return probe(binding.key, binding.printer, binding.devmode.empty() ? 0 : &binding.devmode[0],
+		binding.devmode.size(), dc, caps, err);
+}
+
+void PrinterCapsCache::bindDc(DeviceHandle dc, const std::string &printer, const char *devmode,
+		size_t devmodeLength){
+	std::lock_guard<std::mutex> lock(mutex_);
+	Binding &binding = bound_[dc];
+	binding.key = dc_pool_key(printer, devmode, devmodeLength);
+	binding.printer = printer;
+	binding.devmode.assign(devmode, devmode + devmodeLength);
+	unbound_.erase(dc);
+}
+
+void PrinterCapsCache::unbindDc(DeviceHandle dc){
+	std::lock_guard<std::mutex> lock(mutex_);
+	bound_.erase(dc);
+	unbound_.erase(dc);
+}
+
+void PrinterCapsCache::invalidate(const std::string &printer){
+	std::lock_guard<std::mutex> lock(mutex_);
+	if( printer.empty() ){
+		byKey_.clear();
+		printerOf_.clear();
+		unbound_.clear();
+		return;
+	}
+	std::map<std::string, std::string>::iterator iter = printerOf_.begin();
+	while( iter != printerOf_.end() ){
+		if( iter->second == printer ){
+			byKey_.erase(iter->first);
+			printerOf_.erase(iter++);
+		} else {
+			++iter;
+		}
+	}
+}
+
+PrinterCapsStats PrinterCapsCache::stats(){
+	std::lock_guard<std::mutex> lock(mutex_);
+	PrinterCapsStats stats;
+	stats.hits = hits_;
+	stats.misses = misses_;
+	stats.failures = failures_;
+	stats.entries = (long)(byKey_.size() + unbound_.size());
+	stats.boundDcs = (long)bound_.size();
+	return stats;
+}
+
+ImagePlacement image_placement(const PrinterCaps &caps, long width, long height, bool exact){
+	ImagePlacement place;
+	long horzres = caps.printableWidth;
+	if( caps.printableWidthMm <= 100 ){
+		place.width = width;
+		place.height = height;
+	} else if( exact ){
+		double w = width * caps.dpix / 96.0;
+		double h = height * caps.dpiy / 96.0;
+		if( w > horzres ){
+			h = h * horzres / w;
+			w = horzres;
+		}
+		place.width = w >= 1 ? (long)(w + 0.5) : 1;
+		place.height = h >= 1 ? (long)(h + 0.5) : 1;
+	} else {
+		long scaleX = caps.dpix / 96;
+		long scaleY = caps.dpiy / 96;
+		place.width = width * scaleX >= horzres ? width : width * scaleX;
+		place.height = height * scaleY;
+	}
+	place.x = horzres/2 - place.width/2;
+	return place;
+}
@@ -0,0 +1,115 @@
+#ifndef DRAWER_PRINTER_CAPS_H
+#define DRAWER_PRINTER_CAPS_H
+
+#include "device.h"
+#include <stddef.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct PrinterPaper {
+	int id;            // DMPAPER_*
+	std::string name;  // UTF-8
+	long width, height;  // 0.1 mm
+};
+
+struct PrinterBin {
+	int id;            // DMBIN_*
+	std::string name;
+};
+
+// What a printer does with one DEVMODE. Sizes are in device pixels unless
+// named otherwise; offsetX/Y is where the printable area starts on the
+// paper. papers and bins are empty when only a DC was probed.
+struct PrinterCaps {
+	int dpix, dpiy;
+	long printableWidth, printableHeight;
+	long printableWidthMm, printableHeightMm;
+	long physicalWidth, physicalHeight;
+	long offsetX, offsetY;
+	bool color;
+	bool duplex;
+	std::vector<PrinterPaper> papers;
+	std::vector<PrinterBin> bins;
+};
+
+// Where printImageFromBytes draws an image of width x height pixels (96
+// dpi), centered at the top of the printable area. Printers up to 100 mm
+// wide, receipt printers, get it 1:1. Wider ones get it scaled to the device
+// resolution: by exactly dpi / 96 and shrunk to the printable width when
+// exact (the image is resampled), else by the whole part of dpi / 96, or 1:1
+// if that would not fit (StretchDIBits).
+struct ImagePlacement {
+	long x;
+	long width, height;
+};
+
+ImagePlacement image_placement(const PrinterCaps &caps, long width, long height, bool exact);
+
+// Queries a printer (GetDeviceCaps and DeviceCapabilities for GDI).
+class CapsProvider {
+public:
+	virtual ~CapsProvider(){}
+	// dc is a DC created for printer and devmode, or 0 if the provider has
+	// to open one itself. printer is empty for a DC of an unknown printer,
+	// which is probed for its device caps only.
+	virtual bool probe(const std::string &printer, const char *devmode, size_t devmodeLength,
+		DeviceHandle dc, PrinterCaps *caps, std::string *err) = 0;
+};
+
+struct PrinterCapsStats {
+	long hits;
+	long misses;
+	long failures;
+	long entries;
+	long boundDcs;
+};
+
+// Caps of each printer, probed once per (printer name, hash of the DEVMODE
+// bytes), the key of the DC pool, and kept until invalidate(). A DC that
+// was created for a printer and DEVMODE is bound to them, so the drawing
+// code can ask for the caps of the DC it has; the caps of a DC that was not
+// bound are probed from the DC and kept until it is unbound. Failed probes
+// are not cached.
+//
+// All methods may be called from any thread; probes run outside the lock.
+class PrinterCapsCache {
+public:
+	explicit PrinterCapsCache(CapsProvider *provider);
+
+	bool get(const std::string &printer, const char *devmode, size_t devmodeLength,
+		PrinterCaps *caps, std::string *err);
+	bool getForDc(DeviceHandle dc, PrinterCaps *caps, std::string *err);
+
+	void bindDc(DeviceHandle dc, const std::string &printer, const char *devmode, size_t devmodeLength);
+	// Call before the DC is deleted or returned to the pool; handles are
+	// reused.
+	void unbindDc(DeviceHandle dc);
+
+	// Forgets the caps of every DEVMODE of printer, or of all printers (and
+	// unbound DCs) if printer is empty.
+	void invalidate(const std::string &printer);
+	PrinterCapsStats stats();
+
+private:
+	struct Binding {
+		std::string key;
+		std::string printer;
+		std::vector<char> devmode;
+	};
+
+	bool probe(const std::string &key, const std::string &printer, const char *devmode,
+		size_t devmodeLength, DeviceHandle dc, PrinterCaps *caps, std::string *err);
+
+	CapsProvider *provider_;
+	std::mutex mutex_;
+	std::map<std::string, PrinterCaps> byKey_;
+	// printer of each key, for invalidate()
+	std::map<std::string, std::string> printerOf_;
+	std::map<DeviceHandle, Binding> bound_;
+	std::map<DeviceHandle, PrinterCaps> unbound_;
+	long hits_, misses_, failures_;
+};
+
+#endif
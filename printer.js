@@ -1,12 +1,41 @@
 "use strict";
 
 var drawer = require("bindings")("drawer");
+var PageFormat = require("./page-format");
+
+// 0.1 um fixed point as in transform.cc, so the pixels are those of the
+// native executor: the exact floor of dpi * mm / 25.4.
+function mmToFixed(mm){
+	var fixed = Math.floor(mm * 10000 + 0.5);
+	return Math.max(-1e12, Math.min(1e12, fixed));
+}
+
+function fixedToPixel(dpi, fixed){
+	return Math.floor(fixed * dpi / 254000);
+}
 
 function mmToPixel(dpi, mm){
-	var inch = mm/25.4;
-	return Math.floor(dpi * inch);
+	return fixedToPixel(dpi, mmToFixed(mm));
 };
 
+// { a, b, c, d, e, f } of transform.h, e and f in 0.1 um units
+function identityTransform(){
+	return { a: 1, b: 0, c: 0, d: 1, e: 0, f: 0 };
+}
+
+// One value per point: an array as it is, a single number repeated.
+function coordList(value, n){
+	var list = [], i;
+	for(i=0;i<n;i++){
+		list.push(Array.isArray(value) ? Number(value[i]) : Number(value));
+	}
+	return list;
+}
+
+function coordCount(value){
+	return Array.isArray(value) ? value.length : 0;
+}
+
 function DrawerPrinter(hdc){
 	var dpi;
 	this.hdc = hdc;
@@ -18,11 +47,15 @@ function DrawerPrinter(hdc){
 	this.debug = false;
     this.dx = 0;
     this.dy = 0;
+	this.transform = identityTransform();
+	this.transformStack = [];
 	drawer.setBkMode(hdc, drawer.bkModeTransparent);
 }
 
 module.exports = DrawerPrinter;
 
+// Fonts and pens come from the process-wide cache of drawer.cc, so deleting
+// them only releases them for the next job.
 DrawerPrinter.prototype.dispose = function(){
 	var name, ok;
 	for(name in this.fontDict){
@@ -39,11 +72,27 @@ DrawerPrinter.prototype.dispose = function(){
 	}	
 };
 
-DrawerPrinter.prototype.print = function(pages){
-	var i, n = pages.length, page;
-	drawer.beginPrint(this.hdc);
-	for(i=0;i<n;i++){
-		page = pages[i];
+// opts: { copies, collate (default true), optimize (default true) }; copies
+// after the first are replayed from the display list of each page. With
+// optimize the native side drops redundant state changes and merges text
+// runs (see page-optimizer.h); debug dispatch runs the ops as they are.
+DrawerPrinter.prototype.print = function(pages, opts){
+	var i, j, n = pages.length, page;
+	var copies = (opts && opts.copies) || 1, collate = !(opts && opts.collate === false);
+	var optimize = !(opts && opts.optimize === false);
+	var drawOpts = { dx: this.dx, dy: this.dy, copies: copies, collate: collate, optimize: optimize };
+	if( PageFormat.isEncodedPages(pages) ){
+		drawer.drawEncodedPages(this.hdc, pages, drawOpts);
+		return;
+	}
+	if( !this.debug ){
+		// whole job is interpreted natively (see drawPages in drawer.cc)
+		drawer.drawPages(this.hdc, pages, drawOpts);
+		return;
+	}
+	drawer.beginPrint(this.hdc, "drawer");
+	for(i=0;i<n*copies;i++){
+		page = collate ? pages[i % n] : pages[Math.floor(i / copies)];
 		this.printPage(page);
 	}
 	drawer.endPrint(this.hdc);
@@ -52,6 +101,8 @@ DrawerPrinter.prototype.print = function(pages){
 DrawerPrinter.prototype.printPage = function(ops){
 	var i, n = ops.length, op;
 	drawer.startPage(this.hdc);
+	this.transform = identityTransform();
+	this.transformStack = [];
 	for(i=0;i<n;i++){
 		op = ops[i];
 		this.dispatch(op);
@@ -69,19 +120,97 @@ DrawerPrinter.prototype.dispatch = function(op){
 		case "create_pen": this.createPen(op); break;
 		case "set_pen": this.setPen(op); break;
 		case "draw_chars": this.drawChars(op); break;
+		case "push": this.transformStack.push(this.transform); break;
+		case "pop": this.popTransform(); break;
+		case "translate": this.translate(op); break;
+		case "scale": this.scale(op); break;
+		case "rotate": this.rotate(op); break;
+		case "polyline": this.polyline(op); break;
+		case "poly_polyline": this.polyPolyline(op); break;
+		case "rect": this.rect(op); break;
+		case "fill_rect": this.fillRect(op); break;
+		case "grid": this.grid(op); break;
 		default: console.log("unknonw op code:", op[0]); break;
 	}
 };
 
+// The current transform followed by the offset (dx, dy), in the form
+// drawGlyphRun takes.
+DrawerPrinter.prototype.deviceTransform = function(){
+	var t = this.transform;
+	return [t.a, t.b, t.c, t.d, t.e + mmToFixed(this.dx), t.f + mmToFixed(this.dy)];
+};
+
+// Same arithmetic as transform_points in transform.cc.
+DrawerPrinter.prototype.toDevice = function(mmX, mmY){
+	var t = this.deviceTransform();
+	return [
+		fixedToPixel(this.dpix, mmToFixed(t[0] * mmX + t[2] * mmY) + t[4]),
+		fixedToPixel(this.dpiy, mmToFixed(t[1] * mmX + t[3] * mmY) + t[5])
+	];
+};
+
+DrawerPrinter.prototype.transformLength = function(mm){
+	var t = this.transform;
+	return mm * Math.sqrt(Math.abs(t.a * t.d - t.b * t.c));
+};
+
+DrawerPrinter.prototype.popTransform = function(){
+	if( this.transformStack.length === 0 ){
+		throw new Error("pop without push");
+	}
+	this.transform = this.transformStack.pop();
+};
+
+DrawerPrinter.prototype.translate = function(op){
+	var dx = Number(op[1]), dy = Number(op[2]), t = this.transform;
+	if( isNaN(dx) || isNaN(dy) ){
+		throw new Error("invalid number to translate");
+	}
+	this.transform = { a: t.a, b: t.b, c: t.c, d: t.d,
+		e: t.e + mmToFixed(t.a * dx + t.c * dy), f: t.f + mmToFixed(t.b * dx + t.d * dy) };
+};
+
+DrawerPrinter.prototype.scale = function(op){
+	var sx = Number(op[1]), sy = op[2] === undefined ? sx : Number(op[2]), t = this.transform;
+	if( isNaN(sx) || isNaN(sy) ){
+		throw new Error("invalid number to scale");
+	}
+	this.transform = { a: t.a * sx, b: t.b * sx, c: t.c * sy, d: t.d * sy, e: t.e, f: t.f };
+};
+
+DrawerPrinter.prototype.rotate = function(op){
+	var degrees = Number(op[1]), turn = degrees % 360, sn, cs, t = this.transform;
+	if( isNaN(degrees) ){
+		throw new Error("invalid number to rotate");
+	}
+	if( turn < 0 ){
+		turn += 360;
+	}
+	switch(turn){
+		case 0: sn = 0; cs = 1; break;
+		case 90: sn = 1; cs = 0; break;
+		case 180: sn = 0; cs = -1; break;
+		case 270: sn = -1; cs = 0; break;
+		default:
+			sn = Math.sin(degrees * Math.PI / 180);
+			cs = Math.cos(degrees * Math.PI / 180);
+			break;
+	}
+	this.transform = { a: t.a * cs + t.c * sn, b: t.b * cs + t.d * sn,
+		c: t.c * cs - t.a * sn, d: t.d * cs - t.b * sn, e: t.e, f: t.f };
+};
+
 DrawerPrinter.prototype.moveTo = function(op){
-	var mmX = Number(op[1]) + this.dx;
-	var mmY = Number(op[2]) + this.dy;
+	var mmX = Number(op[1]);
+	var mmY = Number(op[2]);
 	if( isNaN(mmX) || isNaN(mmY) ){
 		console.log("moveTo failed because of bad arg:", op[1], op[2]);
 		throw new Error("invalid number to moveTo");
 	}
-	var x = mmToPixel(this.dpix, mmX);
-	var y = mmToPixel(this.dpiy, mmY);
+	var xy = this.toDevice(mmX, mmY);
+	var x = xy[0];
+	var y = xy[1];
 	var ret;
 	ret = drawer.moveTo(this.hdc, x, y);
 	if( !ret ){
@@ -94,14 +223,15 @@ DrawerPrinter.prototype.moveTo = function(op){
 };
 
 DrawerPrinter.prototype.lineTo = function(op){
-	var mmX = Number(op[1]) + this.dx;
-	var mmY = Number(op[2]) + this.dy;
+	var mmX = Number(op[1]);
+	var mmY = Number(op[2]);
 	if( isNaN(mmX) || isNaN(mmY) ){
 		console.log("lineTo", "failed", "bad arg", op[1], op[2]);
 		throw new Error("lineTo failed");
 	}
-	var x = mmToPixel(this.dpix, mmX);
-	var y = mmToPixel(this.dpiy, mmY);
+	var xy = this.toDevice(mmX, mmY);
+	var x = xy[0];
+	var y = xy[1];
 	var ret;
 	ret = drawer.lineTo(this.hdc, x, y);
 	if( !ret ){
@@ -113,6 +243,89 @@ DrawerPrinter.prototype.lineTo = function(op){
 	}
 };
 
+// Draws polylines of mm points with one PolyPolyline, as PageExecutor does.
+DrawerPrinter.prototype.drawPolylines = function(name, xs, ys, counts){
+	var points = [], i, xy;
+	for(i=0;i<xs.length;i++){
+		if( isNaN(xs[i]) || isNaN(ys[i]) ){
+			console.log(name, "failed", "bad arg", xs[i], ys[i]);
+			throw new Error("invalid number to " + name);
+		}
+		xy = this.toDevice(xs[i], ys[i]);
+		points.push(xy[0], xy[1]);
+	}
+	drawer.polyPolyline(this.hdc, points, counts);
+	if( this.debug ){
+		console.log(name, "ok", counts.length);
+	}
+};
+
+DrawerPrinter.prototype.polyline = function(op){
+	var nx = coordCount(op[1]), ny = coordCount(op[2]), n = Math.max(nx, ny);
+	if( n < 2 || (nx !== 0 && nx < n) || (ny !== 0 && ny < n) ){
+		throw new Error("too few coordinates to polyline");
+	}
+	this.drawPolylines("polyline", coordList(op[1], n), coordList(op[2], n), [n]);
+};
+
+DrawerPrinter.prototype.polyPolyline = function(op){
+	var counts = Array.isArray(op[3]) ? op[3].map(Number) : [Number(op[3])];
+	var nx = coordCount(op[1]), ny = coordCount(op[2]), total = 0, i;
+	for(i=0;i<counts.length;i++){
+		if( !(counts[i] >= 2) || counts[i] !== Math.floor(counts[i]) ){
+			throw new Error("invalid count to poly_polyline");
+		}
+		total += counts[i];
+	}
+	if( (nx !== 0 && nx < total) || (ny !== 0 && ny < total) ){
+		throw new Error("too few coordinates to poly_polyline");
+	}
+	this.drawPolylines("poly_polyline", coordList(op[1], total), coordList(op[2], total), counts);
+};
+
+DrawerPrinter.prototype.rect = function(op){
+	var x = Number(op[1]), y = Number(op[2]), w = Number(op[3]), h = Number(op[4]);
+	this.drawPolylines("rect", [x, x + w, x + w, x, x], [y, y, y + h, y + h, y], [5]);
+};
+
+// A line along each x from the first to the last y, then along each y.
+DrawerPrinter.prototype.grid = function(op){
+	var xs = op[1], ys = op[2], lineXs = [], lineYs = [], counts = [], i;
+	if( coordCount(xs) < 2 || coordCount(ys) < 2 ){
+		throw new Error("too few coordinates to grid");
+	}
+	for(i=0;i<xs.length;i++){
+		lineXs.push(Number(xs[i]), Number(xs[i]));
+		lineYs.push(Number(ys[0]), Number(ys[ys.length - 1]));
+		counts.push(2);
+	}
+	for(i=0;i<ys.length;i++){
+		lineXs.push(Number(xs[0]), Number(xs[xs.length - 1]));
+		lineYs.push(Number(ys[i]), Number(ys[i]));
+		counts.push(2);
+	}
+	this.drawPolylines("grid", lineXs, lineYs, counts);
+};
+
+DrawerPrinter.prototype.fillRect = function(op){
+	var x = Number(op[1]), y = Number(op[2]), w = Number(op[3]), h = Number(op[4]);
+	var t = this.transform, p, q;
+	if( !((t.b === 0 && t.c === 0) || (t.a === 0 && t.d === 0)) ){
+		throw new Error("fill_rect needs an axis-aligned transform");
+	}
+	if( isNaN(x) || isNaN(y) || isNaN(w) || isNaN(h) ){
+		throw new Error("invalid number to fill_rect");
+	}
+	p = this.toDevice(x, y);
+	q = this.toDevice(x + w, y + h);
+	drawer.fillRect(this.hdc, Math.min(p[0], q[0]), Math.min(p[1], q[1]),
+		Math.max(p[0], q[0]), Math.max(p[1], q[1]),
+		Math.floor(Number(op[5])), Math.floor(Number(op[6])), Math.floor(Number(op[7])));
+	if( this.debug ){
+		console.log("fillRect", "ok", x, y, w, h);
+	}
+};
+
 DrawerPrinter.prototype.createFont = function(op){
 	var name = "" + op[1], fontName, fontSize, weight, italic, font;
 	var ok;
@@ -124,7 +337,7 @@ DrawerPrinter.prototype.createFont = function(op){
 		this.fontDict[name] = undefined;
 	}
 	fontName = "" + op[2];
-	fontSize = mmToPixel(this.dpiy, Number(op[3]));
+	fontSize = mmToPixel(this.dpiy, this.transformLength(Number(op[3])));
 	weight = op[4];
 	if( weight === undefined ){
 		weight = 0;
@@ -194,7 +407,7 @@ DrawerPrinter.prototype.createPen = function(op){
 	var r = Math.floor(Number(op[2]));
 	var g = Math.floor(Number(op[3]));
 	var b = Math.floor(Number(op[4]));
-	var width = mmToPixel(this.dpiy, Number(op[5]));
+	var width = mmToPixel(this.dpiy, this.transformLength(Number(op[5])));
 	if( width < 0 ){
 		width = 1;
 	}
@@ -232,9 +445,7 @@ DrawerPrinter.prototype.drawChars = function(op){
 	var str = op[1];
 	var xx = op[2], x, ix;
 	var yy = op[3], y, iy;
-	var i, n, ch;
-	var dpix = this.dpix, dpiy = this.dpiy;
-    var dx = this.dx, dy = this.dy;
+	var i, n, xs = [], ys = [];
 	var ret;
 	if( !(typeof str === "string" || str instanceof String) ){
 		console.log("drawChars", "failed", "invalid string", str);
@@ -242,28 +453,30 @@ DrawerPrinter.prototype.drawChars = function(op){
 	}
     n = str.length;
 	if( typeof xx === "number" || xx instanceof Number ){
-		x = Number(xx) + dx;
+		x = Number(xx);
 		if( isNaN(x) ){
 			console.log("drawChars", "failed", "invalid x", x, op);
 			throw new Error("invalid x to drawChars");
 		}
-		ix = mmToPixel(dpix, x);
+		ix = x;
 	}
 	if( typeof yy === "number" || yy instanceof Number ){
-		y = Number(yy) + dy;
+		y = Number(yy);
 		if( isNaN(y) ){
 			console.log("drawChars", "failed", "invalid y", y);
 			throw new Error("invalid y to drawChars");
 		}
-		iy = mmToPixel(dpiy, y);
+		iy = y;
 	}
 	for(i=0;i<n;i++){
-		ch = str[i];
-		ret = drawer.textOut(this.hdc, getX(i), getY(i), ch);
-		if( !ret ){
-			console.log("drawChars", "failed", ch);
-			throw new Error("drawChars failed");
-		}
+		xs[i] = getX(i);
+		ys[i] = getY(i);
+	}
+	// one ExtTextOutW per baseline, with the positions as advances
+	ret = drawer.drawGlyphRun(this.hdc, "" + str, xs, ys, this.deviceTransform());
+	if( n > 0 && !ret ){
+		console.log("drawChars", "failed", str);
+		throw new Error("drawChars failed");
 	}
 	if( this.debug ){
 		console.log("drawChars", "ok", str, xx, yy);
@@ -272,12 +485,12 @@ DrawerPrinter.prototype.drawChars = function(op){
 	function getX(i){
 		var x;
 		if( ix === undefined ){
-			x = Number(xx[i]) + dx;
+			x = Number(xx[i]);
 			if( isNaN(x) ){
 				console.log("drawChars", "failed", "invalid x", xx[i], i, xx, op);
 				throw new Error("invalid x to drawChars");
 			}
-			return mmToPixel(dpix, x);
+			return x;
 		} else {
 			return ix;
 		}
@@ -286,12 +499,12 @@ DrawerPrinter.prototype.drawChars = function(op){
 	function getY(i){
 		var y;
 		if( iy === undefined ){
-			y = Number(yy[i]) + dy;
+			y = Number(yy[i]);
 			if( isNaN(y) ){
 				console.log("drawChars", "failed", "invalid y", yy[i]);
 				throw new Error("invalid y to drawChars");
 			}
-			return mmToPixel(dpiy, y);
+			return y;
 		} else {
 			return iy;
 		}
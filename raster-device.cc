@@ -0,0 +1,606 @@
+#include "raster-device.h"
+#include "page-executor.h"
+#include "png-image.h"
+#include "resample.h"
+#include <atomic>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+static const uint32_t BAND_ROWS = 64;
+
+// 5x7 font for 0x20-0x7e, one byte per column, bit 0 at the top; bit 7 is
+// the descender row of g, p, q and y.
+static const uint8_t font5x7[95][5] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5f, 0x00, 0x00 },
+	{ 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7f, 0x14, 0x7f, 0x14 },
+	{ 0x24, 0x2a, 0x7f, 0x2a, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 },
+	{ 0x36, 0x49, 0x56, 0x20, 0x50 }, { 0x00, 0x08, 0x07, 0x03, 0x00 },
+	{ 0x00, 0x1c, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1c, 0x00 },
+	{ 0x2a, 0x1c, 0x7f, 0x1c, 0x2a }, { 0x08, 0x08, 0x3e, 0x08, 0x08 },
+	{ 0x00, 0x80, 0x70, 0x30, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 },
+	{ 0x00, 0x00, 0x60, 0x60, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 },
+	{ 0x3e, 0x51, 0x49, 0x45, 0x3e }, { 0x00, 0x42, 0x7f, 0x40, 0x00 },
+	{ 0x72, 0x49, 0x49, 0x49, 0x46 }, { 0x21, 0x41, 0x49, 0x4d, 0x33 },
+	{ 0x18, 0x14, 0x12, 0x7f, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 },
+	{ 0x3c, 0x4a, 0x49, 0x49, 0x31 }, { 0x41, 0x21, 0x11, 0x09, 0x07 },
+	{ 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x46, 0x49, 0x49, 0x29, 0x1e },
+	{ 0x00, 0x00, 0x14, 0x00, 0x00 }, { 0x00, 0x40, 0x34, 0x00, 0x00 },
+	{ 0x00, 0x08, 0x14, 0x22, 0x41 }, { 0x14, 0x14, 0x14, 0x14, 0x14 },
+	{ 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x59, 0x09, 0x06 },
+	{ 0x3e, 0x41, 0x5d, 0x59, 0x4e }, { 0x7c, 0x12, 0x11, 0x12, 0x7c },
+	{ 0x7f, 0x49, 0x49, 0x49, 0x36 }, { 0x3e, 0x41, 0x41, 0x41, 0x22 },
+	{ 0x7f, 0x41, 0x41, 0x41, 0x3e }, { 0x7f, 0x49, 0x49, 0x49, 0x41 },
+	{ 0x7f, 0x09, 0x09, 0x09, 0x01 }, { 0x3e, 0x41, 0x41, 0x51, 0x73 },
+	{ 0x7f, 0x08, 0x08, 0x08, 0x7f }, { 0x00, 0x41, 0x7f, 0x41, 0x00 },
+	{ 0x20, 0x40, 0x41, 0x3f, 0x01 }, { 0x7f, 0x08, 0x14, 0x22, 0x41 },
+	{ 0x7f, 0x40, 0x40, 0x40, 0x40 }, { 0x7f, 0x02, 0x1c, 0x02, 0x7f },
+	{ 0x7f, 0x04, 0x08, 0x10, 0x7f }, { 0x3e, 0x41, 0x41, 0x41, 0x3e },
+	{ 0x7f, 0x09, 0x09, 0x09, 0x06 }, { 0x3e, 0x41, 0x51, 0x21, 0x5e },
+	{ 0x7f, 0x09, 0x19, 0x29, 0x46 }, { 0x26, 0x49, 0x49, 0x49, 0x32 },
+	{ 0x03, 0x01, 0x7f, 0x01, 0x03 }, { 0x3f, 0x40, 0x40, 0x40, 0x3f },
+	{ 0x1f, 0x20, 0x40, 0x20, 0x1f }, { 0x3f, 0x40, 0x38, 0x40, 0x3f },
+	{ 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x03, 0x04, 0x78, 0x04, 0x03 },
+	{ 0x61, 0x59, 0x49, 0x4d, 0x43 }, { 0x00, 0x7f, 0x41, 0x41, 0x41 },
+	{ 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x41, 0x7f },
+	{ 0x04, 0x02, 0x01, 0x02, 0x04 }, { 0x40, 0x40, 0x40, 0x40, 0x40 },
+	{ 0x00, 0x03, 0x07, 0x08, 0x00 }, { 0x20, 0x54, 0x54, 0x78, 0x40 },
+	{ 0x7f, 0x28, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x28 },
+	{ 0x38, 0x44, 0x44, 0x28, 0x7f }, { 0x38, 0x54, 0x54, 0x54, 0x18 },
+	{ 0x00, 0x08, 0x7e, 0x09, 0x02 }, { 0x18, 0xa4, 0xa4, 0x9c, 0x78 },
+	{ 0x7f, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7d, 0x40, 0x00 },
+	{ 0x20, 0x40, 0x40, 0x3d, 0x00 }, { 0x7f, 0x10, 0x28, 0x44, 0x00 },
+	{ 0x00, 0x41, 0x7f, 0x40, 0x00 }, { 0x7c, 0x04, 0x78, 0x04, 0x78 },
+	{ 0x7c, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 },
+	{ 0xfc, 0x18, 0x24, 0x24, 0x18 }, { 0x18, 0x24, 0x24, 0x18, 0xfc },
+	{ 0x7c, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x24 },
+	{ 0x04, 0x04, 0x3f, 0x44, 0x24 }, { 0x3c, 0x40, 0x40, 0x20, 0x7c },
+	{ 0x1c, 0x20, 0x40, 0x20, 0x1c }, { 0x3c, 0x40, 0x30, 0x40, 0x3c },
+	{ 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x4c, 0x90, 0x90, 0x90, 0x7c },
+	{ 0x44, 0x64, 0x54, 0x4c, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 },
+	{ 0x00, 0x00, 0x77, 0x00, 0x00 }, { 0x00, 0x41, 0x36, 0x08, 0x00 },
+	{ 0x02, 0x01, 0x02, 0x04, 0x02 }
+};
+
+// drawn for characters the font does not have
+static const uint8_t missingGlyph[5] = { 0x7f, 0x41, 0x41, 0x41, 0x7f };
+
+static inline uint8_t color_gray(int r, int g, int b){
+	return (uint8_t)((77 * r + 150 * g + 29 * b + 128) >> 8);
+}
+
+RasterDevice::RasterDevice(int dpix, int dpiy){
+	dpix_ = dpix;
+	dpiy_ = dpiy;
+	x_ = 0;
+	y_ = 0;
+	textGray_ = 0;
+	penWidth_ = 0;
+	penGray_ = 0;
+	fontHeight_ = 0;
+	fontWeight_ = 0;
+	fontItalic_ = 0;
+	bottom_ = 0;
+}
+
+void RasterDevice::clear(){
+	items_.clear();
+	lines_.clear();
+	rects_.clear();
+	texts_.clear();
+	chars_.clear();
+	advances_.clear();
+	images_.clear();
+	imagePixels_.clear();
+	bottom_ = 0;
+}
+
+bool RasterDevice::startPage(){
+	clear();
+	x_ = 0;
+	y_ = 0;
+	return true;
+}
+
+void RasterDevice::addItem(int kind, uint8_t gray, long top, long bottom, uint32_t index){
+	Item item;
+	item.kind = kind;
+	item.gray = gray;
+	item.top = top;
+	item.bottom = bottom;
+	item.index = index;
+	items_.push_back(item);
+	if( bottom > bottom_ ){
+		bottom_ = bottom;
+	}
+}
+
+bool RasterDevice::moveTo(long x, long y){
+	x_ = x;
+	y_ = y;
+	return true;
+}
+
+bool RasterDevice::lineTo(long x, long y){
+	Line line;
+	line.x0 = x_ + 0.5;
+	line.y0 = y_ + 0.5;
+	line.x1 = x + 0.5;
+	line.y1 = y + 0.5;
+	line.radius = penWidth_ > 1 ? penWidth_ / 2.0 : 0.5;
+	double top = (line.y0 < line.y1 ? line.y0 : line.y1) - line.radius;
+	double bottom = (line.y0 > line.y1 ? line.y0 : line.y1) + line.radius;
+	addItem(ITEM_LINE, penGray_, (long)floor(top), (long)ceil(bottom) + 1, (uint32_t)lines_.size());
+	lines_.push_back(line);
+	x_ = x;
+	y_ = y;
+	return true;
+}
+
+bool RasterDevice::fillRect(long left, long top, long right, long bottom, int r, int g, int b){
+	if( left >= right || top >= bottom ){
+		return true;
+	}
+	Rect rect;
+	rect.left = left;
+	rect.right = right;
+	addItem(ITEM_RECT, color_gray(r, g, b), top, bottom, (uint32_t)rects_.size());
+	rects_.push_back(rect);
+	return true;
+}
+
+bool RasterDevice::textOut(long x, long y, const uint16_t *text, uint32_t length){
+	std::vector<int> advances(length, (int)((fontHeight_ * 6 + 4) / 8));
+	return textRun(x, y, text, length, length > 0 ? &advances[0] : NULL);
+}
+
+bool RasterDevice::textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances){
+	if( length == 0 || fontHeight_ <= 0 ){
+		return true;
+	}
+	Text run;
+	run.x = x;
+	run.y = y;
+	run.height = fontHeight_;
+	run.bold = fontWeight_ >= FONT_WEIGHT_BOLD;
+	run.italic = fontItalic_ != 0;
+	run.offset = (uint32_t)chars_.size();
+	run.length = length;
+	chars_.insert(chars_.end(), text, text + length);
+	advances_.insert(advances_.end(), advances, advances + length);
+	addItem(ITEM_TEXT, textGray_, y, y + fontHeight_, (uint32_t)texts_.size());
+	texts_.push_back(run);
+	return true;
+}
+
+bool RasterDevice::setTextColor(int r, int g, int b){
+	textGray_ = color_gray(r, g, b);
+	return true;
+}
+
+DeviceHandle RasterDevice::createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic){
+	Object object;
+	object.font = true;
+	object.size = height < 0 ? -height : height;
+	object.weight = weight;
+	object.italic = italic;
+	object.gray = 0;
+	object.live = true;
+	objects_.push_back(object);
+	return (DeviceHandle)objects_.size();
+}
+
+DeviceHandle RasterDevice::createPen(long width, int r, int g, int b){
+	Object object;
+	object.font = false;
+	object.size = width;
+	object.weight = 0;
+	object.italic = 0;
+	object.gray = color_gray(r, g, b);
+	object.live = true;
+	objects_.push_back(object);
+	return (DeviceHandle)objects_.size();
+}
+
+bool RasterDevice::selectObject(DeviceHandle handle){
+	if( handle == 0 || handle > objects_.size() || !objects_[handle - 1].live ){
+		return false;
+	}
+	const Object &object = objects_[handle - 1];
+	if( object.font ){
+		fontHeight_ = object.size;
+		fontWeight_ = object.weight;
+		fontItalic_ = object.italic;
+	} else {
+		penWidth_ = object.size;
+		penGray_ = object.gray;
+	}
+	return true;
+}
+
+bool RasterDevice::deleteObject(DeviceHandle handle){
+	if( handle == 0 || handle > objects_.size() || !objects_[handle - 1].live ){
+		return false;
+	}
+	objects_[handle - 1].live = false;
+	return true;
+}
+
+// Keeps the 24 bpp bands of draw_resampled as gray rows.
+class GrayImageTarget : public ImageTarget {
+public:
+	explicit GrayImageTarget(std::vector<uint8_t> *pixels) : pixels_(pixels) {}
+
+	bool drawBand(long destX, long destY, long destWidth, long destHeight,
+			uint32_t srcWidth, uint32_t srcRows, const uint8_t *pixels, const uint8_t *info){
+		uint32_t stride = ((srcWidth * 24 + 31) / 32) * 4, y;
+		size_t end = pixels_->size();
+		pixels_->resize(end + (size_t)srcWidth * srcRows);
+		for(y=0;y<srcRows;y++){
+			mono_luma(pixels + (size_t)y * stride, 3, srcWidth, &(*pixels_)[end + (size_t)y * srcWidth]);
+		}
+		return true;
+	}
+
+private:
+	std::vector<uint8_t> *pixels_;
+};
+
+bool RasterDevice::drawImage(ImageRows *rows, long x, long y, long width, long height,
+		std::string *err){
+	Image image;
+	image.x = x;
+	image.y = y;
+	image.width = (uint32_t)width;
+	image.height = (uint32_t)height;
+	image.offset = imagePixels_.size();
+	GrayImageTarget target(&imagePixels_);
+	if( !draw_resampled(rows, &target, 0, 0, width, height, RESAMPLE_LANCZOS3, 256, NULL, 1, err) ){
+		imagePixels_.resize(image.offset);
+		return false;
+	}
+	addItem(ITEM_IMAGE, 0, y, y + height, (uint32_t)images_.size());
+	images_.push_back(image);
+	return true;
+}
+
+// Pixels whose centers k * x + c puts in [lo, hi] narrow [*x0, *x1].
+static void clip_linear(double k, double c, double lo, double hi, double *x0, double *x1){
+	if( k == 0 ){
+		if( c < lo || c > hi ){
+			*x0 = 1;
+			*x1 = 0;
+		}
+		return;
+	}
+	double a = (lo - c) / k, b = (hi - c) / k;
+	if( a > b ){
+		double t = a;
+		a = b;
+		b = t;
+	}
+	*x0 = a > *x0 ? a : *x0;
+	*x1 = b < *x1 ? b : *x1;
+}
+
+// The pen is a disk moved along the line; the row at yc crosses it in one
+// interval, the union of the crossings of the two end disks and of the
+// band between them.
+static bool line_span(const RasterDevice::Line &line, double yc, double *xa, double *xb){
+	double r = line.radius, lo = 1, hi = 0;
+	double ends[2][2] = { { line.x0, line.y0 }, { line.x1, line.y1 } };
+	int i;
+	for(i=0;i<2;i++){
+		double dy = yc - ends[i][1];
+		if( dy * dy <= r * r ){
+			double half = sqrt(r * r - dy * dy);
+			double a = ends[i][0] - half, b = ends[i][0] + half;
+			if( lo > hi ){
+				lo = a;
+				hi = b;
+			} else {
+				lo = a < lo ? a : lo;
+				hi = b > hi ? b : hi;
+			}
+		}
+	}
+	double dx = line.x1 - line.x0, dy = line.y1 - line.y0;
+	double length2 = dx * dx + dy * dy;
+	if( length2 > 0 ){
+		double length = sqrt(length2), a = -1e18, b = 1e18;
+		// projection on the line within the segment
+		clip_linear(dx / length2, ((yc - line.y0) * dy - line.x0 * dx) / length2, 0, 1, &a, &b);
+		// distance from the line
+		clip_linear(dy / length, (-line.x0 * dy - (yc - line.y0) * dx) / length, -r, r, &a, &b);
+		if( a <= b ){
+			if( lo > hi ){
+				lo = a;
+				hi = b;
+			} else {
+				lo = a < lo ? a : lo;
+				hi = b > hi ? b : hi;
+			}
+		}
+	}
+	*xa = lo;
+	*xb = hi;
+	return lo <= hi;
+}
+
+static inline void fill_span(RasterPage *page, uint32_t y, long x0, long x1, uint8_t gray){
+	if( x0 < 0 ){
+		x0 = 0;
+	}
+	if( x1 > (long)page->width ){
+		x1 = page->width;
+	}
+	if( x0 < x1 ){
+		memset(&page->pixels[(size_t)y * page->stride + x0], gray, x1 - x0);
+	}
+}
+
+void RasterDevice::drawLine(const Line &line, uint8_t gray, uint32_t y0, uint32_t y1,
+		RasterPage *page) const {
+	uint32_t y;
+	for(y=y0;y<y1;y++){
+		double xa, xb;
+		if( line_span(line, y + 0.5, &xa, &xb) ){
+			fill_span(page, y, (long)ceil(xa - 0.5), (long)floor(xb - 0.5) + 1, gray);
+		}
+	}
+}
+
+// Each cell is 6 x 8 font pixels (5 x 7 glyphs, a column of space and a
+// descender row) scaled to the font height.
+void RasterDevice::drawText(const Text &text, uint8_t gray, uint32_t y0, uint32_t y1,
+		RasterPage *page) const {
+	double scale = text.height / 8.0;
+	long boldShift = text.bold ? (text.height + 15) / 16 : 0;
+	long glyphWidth = (long)ceil(5 * scale) + boldShift;
+	long top = text.y > (long)y0 ? text.y : (long)y0;
+	long bottom = text.y + text.height < (long)y1 ? text.y + text.height : (long)y1;
+	long x = text.x, y, px;
+	uint32_t i;
+	for(i=0;i<text.length;i++){
+		uint16_t c = chars_[text.offset + i];
+		if( c > 0x20 && (long)(x + glyphWidth + text.height / 4) > 0 && x < (long)page->width ){
+			const uint8_t *glyph = c < 0x7f ? font5x7[c - 0x20] : missingGlyph;
+			for(y=top;y<bottom;y++){
+				long row = (long)((y - text.y) / scale);
+				uint8_t mask = (uint8_t)(1 << (row < 7 ? row : 7));
+				// italic leans by a quarter of the height
+				long shift = text.italic ? (text.y + text.height - y) / 4 : 0;
+				uint8_t *out = &page->pixels[(size_t)y * page->stride];
+				for(px=0;px<glyphWidth;px++){
+					long column = (long)(px / scale);
+					bool on = column < 5 && (glyph[column] & mask);
+					if( !on && boldShift > 0 && px >= boldShift ){
+						long left = (long)((px - boldShift) / scale);
+						on = left < 5 && (glyph[left] & mask);
+					}
+					long dx = x + px + shift;
+					if( on && dx >= 0 && dx < (long)page->width ){
+						out[dx] = gray;
+					}
+				}
+			}
+		}
+		x += advances_[text.offset + i];
+	}
+}
+
+void RasterDevice::drawImageBand(const Image &image, uint32_t y0, uint32_t y1,
+		RasterPage *page) const {
+	long top = image.y > (long)y0 ? image.y : (long)y0;
+	long bottom = image.y + (long)image.height < (long)y1 ? image.y + (long)image.height : (long)y1;
+	long left = image.x > 0 ? image.x : 0;
+	long right = image.x + (long)image.width < (long)page->width ? image.x + (long)image.width : (long)page->width;
+	long y;
+	if( left >= right ){
+		return;
+	}
+	for(y=top;y<bottom;y++){
+		const uint8_t *src = &imagePixels_[image.offset + (size_t)(y - image.y) * image.width + (left - image.x)];
+		memcpy(&page->pixels[(size_t)y * page->stride + left], src, right - left);
+	}
+}
+
+void RasterDevice::drawBand(uint32_t y0, uint32_t y1, RasterPage *page) const {
+	size_t i;
+	memset(&page->pixels[(size_t)y0 * page->stride], 255, (size_t)(y1 - y0) * page->stride);
+	for(i=0;i<items_.size();i++){
+		const Item &item = items_[i];
+		if( item.bottom <= (long)y0 || item.top >= (long)y1 ){
+			continue;
+		}
+		long top = item.top > (long)y0 ? item.top : (long)y0;
+		long bottom = item.bottom < (long)y1 ? item.bottom : (long)y1;
+		switch(item.kind){
+			case ITEM_LINE:
+				drawLine(lines_[item.index], item.gray, (uint32_t)top, (uint32_t)bottom, page);
+				break;
+			case ITEM_TEXT:
+				drawText(texts_[item.index], item.gray, (uint32_t)top, (uint32_t)bottom, page);
+				break;
+			case ITEM_IMAGE:
+				drawImageBand(images_[item.index], (uint32_t)top, (uint32_t)bottom, page);
+				break;
+			case ITEM_RECT: {
+				long y;
+				for(y=top;y<bottom;y++){
+					fill_span(page, (uint32_t)y, rects_[item.index].left, rects_[item.index].right, item.gray);
+				}
+				break;
+			}
+		}
+	}
+}
+
+// Work on the rows of a page, split into bands.
+class BandWork {
+public:
+	virtual ~BandWork(){}
+	virtual void run(uint32_t y0, uint32_t y1) = 0;
+};
+
+static void band_worker(BandWork *work, uint32_t height, std::atomic<uint32_t> *next){
+	uint32_t bands = (height + BAND_ROWS - 1) / BAND_ROWS, band;
+	while( (band = next->fetch_add(1)) < bands ){
+		uint32_t y0 = band * BAND_ROWS;
+		work->run(y0, y0 + BAND_ROWS < height ? y0 + BAND_ROWS : height);
+	}
+}
+
+// Bands of BAND_ROWS rows are handed out to up to threads threads as they
+// finish one; the calling thread works too.
+static void run_bands(BandWork *work, uint32_t height, int threads){
+	uint32_t bands = (height + BAND_ROWS - 1) / BAND_ROWS, i;
+	uint32_t n = threads < 1 ? 1 : (uint32_t)threads;
+	std::atomic<uint32_t> next(0);
+	std::vector<std::thread> workers;
+	if( n > bands ){
+		n = bands > 0 ? bands : 1;
+	}
+	for(i=0;i+1<n;i++){
+		workers.push_back(std::thread(band_worker, work, height, &next));
+	}
+	band_worker(work, height, &next);
+	for(i=0;i<workers.size();i++){
+		workers[i].join();
+	}
+}
+
+class RasterizeWork : public BandWork {
+public:
+	RasterizeWork(const RasterDevice *device, RasterPage *page) : device_(device), page_(page) {}
+	void run(uint32_t y0, uint32_t y1){ device_->drawBand(y0, y1, page_); }
+
+private:
+	const RasterDevice *device_;
+	RasterPage *page_;
+};
+
+void RasterDevice::rasterize(uint32_t width, uint32_t height, int threads, RasterPage *page) const {
+	page->width = width;
+	page->height = height;
+	page->bits = 8;
+	page->stride = width;
+	page->pixels.resize((size_t)width * height);
+	RasterizeWork work(this, page);
+	run_bands(&work, height, threads);
+}
+
+class MonoWork : public BandWork {
+public:
+	MonoWork(const RasterPage &page, const MonoOptions &opts, RasterPage *out) :
+		page_(page), opts_(opts), out_(out) {}
+
+	void run(uint32_t y0, uint32_t y1){
+		MonoConverter converter(opts_, page_.width);
+		std::vector<uint8_t> gray(page_.width);
+		uint32_t y;
+		for(y=y0;y<y1;y++){
+			memcpy(&gray[0], &page_.pixels[(size_t)y * page_.stride], page_.width);
+			converter.convertRow(&gray[0], &out_->pixels[(size_t)y * out_->stride]);
+		}
+	}
+
+private:
+	const RasterPage &page_;
+	const MonoOptions &opts_;
+	RasterPage *out_;
+};
+
+void raster_to_mono(const RasterPage &page, const MonoOptions &opts, int threads, RasterPage *out){
+	out->width = page.width;
+	out->height = page.height;
+	out->bits = 1;
+	out->stride = (page.width + 7) / 8;
+	out->pixels.resize((size_t)out->stride * page.height);
+	MonoWork work(page, opts, out);
+	// bands start at multiples of 8 rows, so the ordered dither lines up
+	if( opts.dither == MONO_DITHER_FLOYD_STEINBERG ){
+		work.run(0, page.height);
+	} else {
+		run_bands(&work, page.height, threads);
+	}
+}
+
+void encode_pnm(const RasterPage &page, std::vector<uint8_t> *out){
+	char header[64];
+	int n = snprintf(header, sizeof(header), page.bits == 1 ? "P4\n%u %u\n" : "P5\n%u %u\n255\n",
+		page.width, page.height);
+	size_t rowBytes = page.bits == 1 ? (page.width + 7) / 8 : page.width, i;
+	uint32_t y;
+	out->assign(header, header + n);
+	out->reserve(n + rowBytes * page.height);
+	for(y=0;y<page.height;y++){
+		const uint8_t *row = &page.pixels[(size_t)y * page.stride];
+		if( page.bits == 1 ){
+			// PBM has 1 for black; padding bits stay 0
+			size_t end = out->size();
+			out->insert(out->end(), row, row + rowBytes);
+			for(i=0;i<rowBytes;i++){
+				(*out)[end + i] = (uint8_t)~(*out)[end + i];
+			}
+			if( page.width % 8 ){
+				(*out)[end + rowBytes - 1] &= (uint8_t)(0xff << (8 - page.width % 8));
+			}
+		} else {
+			out->insert(out->end(), row, row + rowBytes);
+		}
+	}
+}
+
+void encode_raster_png(const RasterPage &page, std::vector<uint8_t> *out){
+	encode_png_gray(&page.pixels[0], page.stride, page.width, page.height, page.bits, out);
+}
+
+bool render_pages(const Page *const *pages, size_t count, const RasterOptions &opts,
+		std::vector<std::vector<uint8_t> > *files, std::string *err){
+	if( opts.dpi <= 0 || opts.dpi > 2400 || (opts.bits != 1 && opts.bits != 8) ){
+		*err = "invalid raster options";
+		return false;
+	}
+	long width = mm_to_pixel(opts.dpi, opts.width);
+	long fixedHeight = mm_to_pixel(opts.dpi, opts.height);
+	if( width < 1 || width > 65535 || fixedHeight < 0 || fixedHeight > 100000 ){
+		*err = "invalid page size";
+		return false;
+	}
+	RasterDevice device(opts.dpi, opts.dpi);
+	PageExecutor executor(&device);
+	RasterPage page, mono;
+	size_t i;
+	executor.setOffset(opts.dx, opts.dy);
+	files->assign(count, std::vector<uint8_t>());
+	for(i=0;i<count;i++){
+		if( !executor.runPage(*pages[i]) ){
+			*err = executor.error();
+			return false;
+		}
+		long height = fixedHeight > 0 ? fixedHeight : device.contentBottom();
+		if( height < 1 ){
+			height = 1;
+		}
+		if( height > 100000 ){
+			*err = "invalid page size";
+			return false;
+		}
+		device.rasterize((uint32_t)width, (uint32_t)height, opts.threads, &page);
+		const RasterPage *out = &page;
+		if( opts.bits == 1 ){
+			raster_to_mono(page, opts.mono, opts.threads, &mono);
+			out = &mono;
+		}
+		if( opts.format == RASTER_PNM ){
+			encode_pnm(*out, &(*files)[i]);
+		} else {
+			encode_raster_png(*out, &(*files)[i]);
+		}
+	}
+	return true;
+}
@@ -0,0 +1,194 @@
+#ifndef DRAWER_RASTER_DEVICE_H
+#define DRAWER_RASTER_DEVICE_H
+
+#include "device.h"
+#include "bmp-image.h"
+#include "mono-image.h"
+#include "page.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// A rendered page: rows of gray values (bits 8, 255 is white), or rows of
+// bits as mono_pack makes them (bits 1, 1 is white).
+struct RasterPage {
+	uint32_t width;
+	uint32_t height;
+	uint32_t bits;
+	uint32_t stride;
+	std::vector<uint8_t> pixels;
+};
+
+// Device that renders to memory instead of a printer, for previews and
+// archives. The calls of a page are kept as a list of lines, filled
+// rectangles, text runs and images in device pixels, which rasterize() then
+// draws in horizontal bands on several threads.
+//
+// Lines are drawn like a GDI geometric pen with round caps (width 0 is one
+// pixel), without anti-aliasing. Text uses a built-in 5x7 bitmap font
+// scaled to the font height, with the cell's top left at (x, y) like
+// TA_TOP; faces are ignored and characters outside ASCII are drawn as boxes.
+// Colors become gray with the luminance of mono_luma.
+class RasterDevice : public Device {
+public:
+	RasterDevice(int dpix, int dpiy);
+
+	// Forgets what was drawn (startPage does too); fonts and pens stay.
+	void clear();
+	size_t itemCount() const { return items_.size(); }
+	// Pixel row below everything drawn, 0 for an empty page.
+	long contentBottom() const { return bottom_; }
+
+	// Scales an image to (x, y, width, height) with the resampler and keeps
+	// it in gray.
+	bool drawImage(ImageRows *rows, long x, long y, long width, long height, std::string *err);
+
+	// Renders what was drawn into an 8 bit page of width x height pixels,
+	// in bands of 64 rows shared by up to threads threads.
+	void rasterize(uint32_t width, uint32_t height, int threads, RasterPage *page) const;
+	// Rows [y0, y1) of a page rasterize() has sized.
+	void drawBand(uint32_t y0, uint32_t y1, RasterPage *page) const;
+
+	int dpix(){ return dpix_; }
+	int dpiy(){ return dpiy_; }
+
+	bool startDoc(const uint16_t *jobName, uint32_t length){ return true; }
+	bool endDoc(){ return true; }
+	bool abortDoc(){ return true; }
+	bool startPage();
+	bool endPage(){ return true; }
+
+	bool moveTo(long x, long y);
+	bool lineTo(long x, long y);
+	bool fillRect(long left, long top, long right, long bottom, int r, int g, int b);
+	bool textOut(long x, long y, const uint16_t *text, uint32_t length);
+	bool textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances);
+	bool setTextColor(int r, int g, int b);
+	bool setBkTransparent(){ return true; }
+
+	DeviceHandle createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic);
+	DeviceHandle createPen(long width, int r, int g, int b);
+	bool selectObject(DeviceHandle handle);
+	bool deleteObject(DeviceHandle handle);
+
+	enum ItemKind {
+		ITEM_LINE,
+		ITEM_TEXT,
+		ITEM_IMAGE,
+		ITEM_RECT
+	};
+
+	struct Item {
+		int kind;
+		uint8_t gray;
+		// rows [top, bottom) the item may touch
+		long top;
+		long bottom;
+		uint32_t index;
+	};
+
+	struct Line {
+		// pixel centers of the end points
+		double x0, y0, x1, y1;
+		double radius;
+	};
+
+	// rows are those of the item
+	struct Rect {
+		long left, right;
+	};
+
+	struct Text {
+		long x, y;
+		long height;
+		bool bold;
+		bool italic;
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	struct Image {
+		long x, y;
+		uint32_t width;
+		uint32_t height;
+		size_t offset;
+	};
+
+	struct Object {
+		bool font;
+		long size;
+		long weight;
+		long italic;
+		uint8_t gray;
+		bool live;
+	};
+
+private:
+	void addItem(int kind, uint8_t gray, long top, long bottom, uint32_t index);
+	void drawLine(const Line &line, uint8_t gray, uint32_t y0, uint32_t y1, RasterPage *page) const;
+	void drawText(const Text &text, uint8_t gray, uint32_t y0, uint32_t y1, RasterPage *page) const;
+	void drawImageBand(const Image &image, uint32_t y0, uint32_t y1, RasterPage *page) const;
+
+	int dpix_, dpiy_;
+	long x_, y_;
+	uint8_t textGray_;
+	long penWidth_;
+	uint8_t penGray_;
+	long fontHeight_;
+	long fontWeight_;
+	long fontItalic_;
+	std::vector<Object> objects_;
+
+	std::vector<Item> items_;
+	std::vector<Line> lines_;
+	std::vector<Rect> rects_;
+	std::vector<Text> texts_;
+	// characters and advances of the texts
+	std::vector<uint16_t> chars_;
+	std::vector<int> advances_;
+	std::vector<Image> images_;
+	std::vector<uint8_t> imagePixels_;
+	long bottom_;
+};
+
+// Converts an 8 bit page to 1 bit. Bands are converted on up to threads
+// threads, except with Floyd-Steinberg, whose error runs down the page.
+void raster_to_mono(const RasterPage &page, const MonoOptions &opts, int threads, RasterPage *out);
+
+// Binary PGM (P5) of an 8 bit page or PBM (P4, 1 is black) of a 1 bit page.
+void encode_pnm(const RasterPage &page, std::vector<uint8_t> *out);
+// Gray PNG of either.
+void encode_raster_png(const RasterPage &page, std::vector<uint8_t> *out);
+
+enum RasterFormat {
+	RASTER_PNG,
+	RASTER_PNM
+};
+
+struct RasterOptions {
+	int dpi;
+	// page width in mm; height 0 ends the page below what is drawn
+	double width;
+	double height;
+	double dx, dy;
+	// 8 or 1
+	int bits;
+	int format;
+	int threads;
+	MonoOptions mono;
+
+	RasterOptions() : dpi(300), width(210), height(0), dx(0), dy(0), bits(8),
+		format(RASTER_PNG), threads(1) {
+		mono.dither = MONO_DITHER_BAYER;
+	}
+};
+
+// Renders pages with a PageExecutor on a RasterDevice and encodes each one;
+// files gets one PNG or PNM per page.
+bool render_pages(const Page *const *pages, size_t count, const RasterOptions &opts,
+	std::vector<std::vector<uint8_t> > *files, std::string *err);
+
+#endif
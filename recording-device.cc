@@ -0,0 +1,295 @@
+#include "recording-device.h"
+#include "page.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *callKindNames[CALL_KIND_COUNT] = {
+	"startDoc",
+	"endDoc",
+	"abortDoc",
+	"startPage",
+	"endPage",
+	"moveTo",
+	"lineTo",
+	"textOut",
+	"textRun",
+	"setTextColor",
+	"setBkTransparent",
+	"createFont",
+	"createPen",
+	"selectObject",
+	"deleteObject",
+	"polyPolyline",
+	"fillRect"
+};
+
+RecordingDevice::RecordingDevice(int dpix, int dpiy){
+	dpix_ = dpix;
+	dpiy_ = dpiy;
+	recording_ = true;
+	failKind_ = -1;
+	clear();
+}
+
+void RecordingDevice::clear(){
+	int i;
+	for(i=0;i<CALL_KIND_COUNT;i++){
+		counts_[i] = 0;
+	}
+	created_ = 0;
+	deleted_ = 0;
+	nextHandle_ = 1;
+	calls_.clear();
+}
+
+long RecordingDevice::totalCount() const {
+	long total = 0;
+	int i;
+	for(i=0;i<CALL_KIND_COUNT;i++){
+		total += counts_[i];
+	}
+	return total;
+}
+
+DeviceCall &RecordingDevice::record(int kind){
+	counts_[kind] += 1;
+	DeviceCall *call;
+	if( recording_ ){
+		calls_.push_back(DeviceCall());
+		call = &calls_.back();
+	} else {
+		call = &scratch_;
+		call->text.clear();
+		call->advances.clear();
+		call->points.clear();
+		call->counts.clear();
+	}
+	call->kind = kind;
+	call->x = call->y = 0;
+	call->right = call->bottom = 0;
+	call->size = call->weight = call->italic = 0;
+	call->r = call->g = call->b = 0;
+	call->handle = 0;
+	return *call;
+}
+
+std::string RecordingDevice::describe(const DeviceCall &call) const {
+	char buf[128];
+	std::string text = utf16_to_utf8(call.text.empty() ? 0 : &call.text[0], (uint32_t)call.text.size());
+	switch(call.kind){
+		case CALL_MOVE_TO: case CALL_LINE_TO:
+			sprintf(buf, " %ld %ld", call.x, call.y);
+			break;
+		case CALL_TEXT_OUT:
+			sprintf(buf, " %ld %ld ", call.x, call.y);
+			return std::string(callKindNames[call.kind]) + buf + text;
+		case CALL_TEXT_RUN: {
+			std::string out;
+			size_t i;
+			sprintf(buf, " %ld %ld ", call.x, call.y);
+			out = std::string(callKindNames[call.kind]) + buf + text + " [";
+			for(i=0;i<call.advances.size();i++){
+				sprintf(buf, "%s%d", i ? " " : "", call.advances[i]);
+				out += buf;
+			}
+			return out + "]";
+		}
+		case CALL_POLY_POLYLINE: {
+			std::string out = callKindNames[call.kind];
+			size_t i, j, point = 0;
+			for(i=0;i<call.counts.size();i++){
+				out += " [";
+				for(j=0;j<call.counts[i];j++,point++){
+					sprintf(buf, "%s%ld %ld", j ? " " : "", call.points[point * 2],
+						call.points[point * 2 + 1]);
+					out += buf;
+				}
+				out += "]";
+			}
+			return out;
+		}
+		case CALL_FILL_RECT:
+			sprintf(buf, " %ld %ld %ld %ld %d %d %d", call.x, call.y, call.right, call.bottom,
+				call.r, call.g, call.b);
+			break;
+		case CALL_SET_TEXT_COLOR:
+			sprintf(buf, " %d %d %d", call.r, call.g, call.b);
+			break;
+		case CALL_CREATE_FONT:
+			sprintf(buf, " %ld %ld %ld => %lu", call.size, call.weight, call.italic,
+				(unsigned long)call.handle);
+			return std::string(callKindNames[call.kind]) + " " + text + buf;
+		case CALL_CREATE_PEN:
+			sprintf(buf, " %ld %d %d %d => %lu", call.size, call.r, call.g, call.b,
+				(unsigned long)call.handle);
+			break;
+		case CALL_SELECT_OBJECT: case CALL_DELETE_OBJECT:
+			sprintf(buf, " %lu", (unsigned long)call.handle);
+			break;
+		case CALL_START_DOC:
+			return std::string(callKindNames[call.kind]) + " " + text;
+		default:
+			buf[0] = '\0';
+			break;
+	}
+	return std::string(callKindNames[call.kind]) + buf;
+}
+
+std::string RecordingDevice::dump() const {
+	std::string out;
+	size_t i;
+	for(i=0;i<calls_.size();i++){
+		out += describe(calls_[i]);
+		out += "\n";
+	}
+	return out;
+}
+
+bool RecordingDevice::startDoc(const uint16_t *jobName, uint32_t length){
+	DeviceCall &call = record(CALL_START_DOC);
+	if( recording_ ){
+		call.text.assign(jobName, jobName + length);
+	}
+	return failKind_ != CALL_START_DOC;
+}
+
+bool RecordingDevice::endDoc(){
+	record(CALL_END_DOC);
+	return failKind_ != CALL_END_DOC;
+}
+
+bool RecordingDevice::abortDoc(){
+	record(CALL_ABORT_DOC);
+	return failKind_ != CALL_ABORT_DOC;
+}
+
+bool RecordingDevice::startPage(){
+	record(CALL_START_PAGE);
+	return failKind_ != CALL_START_PAGE;
+}
+
+bool RecordingDevice::endPage(){
+	record(CALL_END_PAGE);
+	return failKind_ != CALL_END_PAGE;
+}
+
+bool RecordingDevice::moveTo(long x, long y){
+	DeviceCall &call = record(CALL_MOVE_TO);
+	call.x = x;
+	call.y = y;
+	return failKind_ != CALL_MOVE_TO;
+}
+
+bool RecordingDevice::lineTo(long x, long y){
+	DeviceCall &call = record(CALL_LINE_TO);
+	call.x = x;
+	call.y = y;
+	return failKind_ != CALL_LINE_TO;
+}
+
+bool RecordingDevice::polyPolyline(const long *points, const uint32_t *counts, uint32_t polylines){
+	DeviceCall &call = record(CALL_POLY_POLYLINE);
+	if( recording_ ){
+		uint32_t i, total = 0;
+		for(i=0;i<polylines;i++){
+			total += counts[i];
+		}
+		call.points.assign(points, points + total * 2);
+		call.counts.assign(counts, counts + polylines);
+	}
+	return failKind_ != CALL_POLY_POLYLINE;
+}
+
+bool RecordingDevice::fillRect(long left, long top, long right, long bottom, int r, int g, int b){
+	DeviceCall &call = record(CALL_FILL_RECT);
+	call.x = left;
+	call.y = top;
+	call.right = right;
+	call.bottom = bottom;
+	call.r = r;
+	call.g = g;
+	call.b = b;
+	return failKind_ != CALL_FILL_RECT;
+}
+
+bool RecordingDevice::textOut(long x, long y, const uint16_t *text, uint32_t length){
+	DeviceCall &call = record(CALL_TEXT_OUT);
+	call.x = x;
+	call.y = y;
+	if( recording_ ){
+		call.text.assign(text, text + length);
+	}
+	return failKind_ != CALL_TEXT_OUT;
+}
+
+bool RecordingDevice::textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances){
+	DeviceCall &call = record(CALL_TEXT_RUN);
+	call.x = x;
+	call.y = y;
+	if( recording_ ){
+		call.text.assign(text, text + length);
+		call.advances.assign(advances, advances + length);
+	}
+	return failKind_ != CALL_TEXT_RUN;
+}
+
+bool RecordingDevice::setTextColor(int r, int g, int b){
+	DeviceCall &call = record(CALL_SET_TEXT_COLOR);
+	call.r = r;
+	call.g = g;
+	call.b = b;
+	return failKind_ != CALL_SET_TEXT_COLOR;
+}
+
+bool RecordingDevice::setBkTransparent(){
+	record(CALL_SET_BK_TRANSPARENT);
+	return failKind_ != CALL_SET_BK_TRANSPARENT;
+}
+
+DeviceHandle RecordingDevice::createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic){
+	DeviceCall &call = record(CALL_CREATE_FONT);
+	if( recording_ ){
+		call.text.assign(face, face + faceLength);
+	}
+	call.size = height;
+	call.weight = weight;
+	call.italic = italic;
+	if( failKind_ == CALL_CREATE_FONT ){
+		return 0;
+	}
+	call.handle = nextHandle_++;
+	created_ += 1;
+	return call.handle;
+}
+
+DeviceHandle RecordingDevice::createPen(long width, int r, int g, int b){
+	DeviceCall &call = record(CALL_CREATE_PEN);
+	call.size = width;
+	call.r = r;
+	call.g = g;
+	call.b = b;
+	if( failKind_ == CALL_CREATE_PEN ){
+		return 0;
+	}
+	call.handle = nextHandle_++;
+	created_ += 1;
+	return call.handle;
+}
+
+bool RecordingDevice::selectObject(DeviceHandle handle){
+	DeviceCall &call = record(CALL_SELECT_OBJECT);
+	call.handle = handle;
+	return failKind_ != CALL_SELECT_OBJECT;
+}
+
+bool RecordingDevice::deleteObject(DeviceHandle handle){
+	DeviceCall &call = record(CALL_DELETE_OBJECT);
+	call.handle = handle;
+	if( failKind_ == CALL_DELETE_OBJECT ){
+		return false;
+	}
+	deleted_ += 1;
+	return true;
+}
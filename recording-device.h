@@ -0,0 +1,99 @@
+#ifndef DRAWER_RECORDING_DEVICE_H
+#define DRAWER_RECORDING_DEVICE_H
+
+#include "device.h"
+#include <string>
+#include <vector>
+
+enum DeviceCallKind {
+	CALL_START_DOC,
+	CALL_END_DOC,
+	CALL_ABORT_DOC,
+	CALL_START_PAGE,
+	CALL_END_PAGE,
+	CALL_MOVE_TO,
+	CALL_LINE_TO,
+	CALL_TEXT_OUT,
+	CALL_TEXT_RUN,
+	CALL_SET_TEXT_COLOR,
+	CALL_SET_BK_TRANSPARENT,
+	CALL_CREATE_FONT,
+	CALL_CREATE_PEN,
+	CALL_SELECT_OBJECT,
+	CALL_DELETE_OBJECT,
+	CALL_POLY_POLYLINE,
+	CALL_FILL_RECT,
+	CALL_KIND_COUNT
+};
+
+struct DeviceCall {
+	int kind;
+	long x, y;               // moveTo, lineTo, textOut; fillRect: left, top
+	long right, bottom;      // fillRect
+	long size;               // createFont: height, createPen: width
+	long weight, italic;     // createFont
+	int r, g, b;             // setTextColor, createPen, fillRect
+	DeviceHandle handle;     // createFont/createPen result, selectObject, deleteObject
+	std::vector<uint16_t> text;  // textOut/textRun text, createFont face, startDoc name
+	std::vector<int> advances;   // textRun
+	std::vector<long> points;    // polyPolyline: x, y pairs
+	std::vector<uint32_t> counts;  // polyPolyline
+};
+
+// Device that logs every call. Handles are small consecutive integers.
+// With setRecording(false) only the per-kind counters are kept, which is what
+// throughput measurements want.
+class RecordingDevice : public Device {
+public:
+	RecordingDevice(int dpix, int dpiy);
+
+	void setRecording(bool recording){ recording_ = recording; }
+	void failOn(int kind){ failKind_ = kind; }
+	void clear();
+
+	const std::vector<DeviceCall> &calls() const { return calls_; }
+	long count(int kind) const { return counts_[kind]; }
+	long totalCount() const;
+	long liveObjects() const { return created_ - deleted_; }
+	std::string describe(const DeviceCall &call) const;
+	std::string dump() const;
+
+	int dpix(){ return dpix_; }
+	int dpiy(){ return dpiy_; }
+
+	bool startDoc(const uint16_t *jobName, uint32_t length);
+	bool endDoc();
+	bool abortDoc();
+	bool startPage();
+	bool endPage();
+
+	bool moveTo(long x, long y);
+	bool lineTo(long x, long y);
+	bool polyPolyline(const long *points, const uint32_t *counts, uint32_t polylines);
+	bool fillRect(long left, long top, long right, long bottom, int r, int g, int b);
+	bool textOut(long x, long y, const uint16_t *text, uint32_t length);
+	bool textRun(long x, long y, const uint16_t *text, uint32_t length,
+		const int *advances);
+	bool setTextColor(int r, int g, int b);
+	bool setBkTransparent();
+
+	DeviceHandle createFont(const uint16_t *face, uint32_t faceLength,
+		long height, long weight, long italic);
+	DeviceHandle createPen(long width, int r, int g, int b);
+	bool selectObject(DeviceHandle handle);
+	bool deleteObject(DeviceHandle handle);
+
+private:
+	DeviceCall &record(int kind);
+
+	int dpix_, dpiy_;
+	bool recording_;
+	int failKind_;
+	long counts_[CALL_KIND_COUNT];
+	long created_, deleted_;
+	DeviceHandle nextHandle_;
+	std::vector<DeviceCall> calls_;
+	DeviceCall scratch_;
+};
+
+#endif
@@ -0,0 +1,463 @@
+#include "resample.h"
+#include <math.h>
+#include <string.h>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RESAMPLE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+static const double PI = 3.14159265358979323846;
+
+static bool useSimd = true;
+
+bool resample_use_simd(bool enable){
+	bool previous = useSimd;
+	useSimd = enable;
+	return previous;
+}
+
+static double filter_support(int filter){
+	switch(filter){
+		case RESAMPLE_BOX: return 0.5;
+		case RESAMPLE_BILINEAR: return 1.0;
+		default: return 3.0;
+	}
+}
+
+static double sinc(double x){
+	if( x == 0 ){
+		return 1;
+	}
+	x *= PI;
+	return sin(x) / x;
+}
+
+static double filter_weight(int filter, double x){
+	switch(filter){
+		case RESAMPLE_BOX:
+			return x > -0.5 && x <= 0.5 ? 1 : 0;
+		case RESAMPLE_BILINEAR:
+			x = fabs(x);
+			return x < 1 ? 1 - x : 0;
+		default:
+			return x > -3 && x < 3 ? sinc(x) * sinc(x / 3) : 0;
+	}
+}
+
+// The filter is stretched by the scale when shrinking, so that every source
+// pixel contributes (area averaging for RESAMPLE_BOX).
+void make_resample_kernel(uint32_t srcSize, uint32_t dstSize, int filter, ResampleKernel *kernel){
+	double scale = (double)srcSize / dstSize;
+	double filterScale = scale > 1 ? scale : 1;
+	double support = filter_support(filter) * filterScale;
+	uint32_t maxCount = (uint32_t)ceil(support) * 2 + 1, i, k;
+	std::vector<double> w(maxCount);
+	std::vector<int> fixed(maxCount);
+	kernel->srcSize = srcSize;
+	kernel->dstSize = dstSize;
+	kernel->taps = (maxCount + 7) & ~7u;
+	kernel->start.assign(dstSize, 0);
+	kernel->count.assign(dstSize, 0);
+	kernel->weights.assign((size_t)dstSize * kernel->taps, 0);
+	for(i=0;i<dstSize;i++){
+		double center = (i + 0.5) * scale, total = 0;
+		long first = (long)(center - support + 0.5);
+		long last = (long)(center + support + 0.5);
+		if( first < 0 ){
+			first = 0;
+		}
+		if( last > (long)srcSize ){
+			last = srcSize;
+		}
+		uint32_t n = (uint32_t)(last - first);
+		if( n > maxCount ){
+			n = maxCount;
+		}
+		for(k=0;k<n;k++){
+			w[k] = filter_weight(filter, (k + first - center + 0.5) / filterScale);
+			total += w[k];
+		}
+		if( total == 0 ){
+			// cannot happen with these filters; nearest pixel
+			first = (long)center < (long)srcSize ? (long)center : (long)srcSize - 1;
+			n = 1;
+			w[0] = total = 1;
+		}
+		// round to 1/16384 and give the rounding error to the largest weight
+		int sum = 0, largest = 0;
+		for(k=0;k<n;k++){
+			fixed[k] = (int)floor(w[k] / total * 16384 + 0.5);
+			sum += fixed[k];
+			if( fixed[k] > fixed[largest] ){
+				largest = k;
+			}
+		}
+		fixed[largest] += 16384 - sum;
+		// drop zero weights at the end; start stays nondecreasing
+		while( n > 1 && fixed[n - 1] == 0 ){
+			n -= 1;
+		}
+		kernel->start[i] = (uint32_t)first;
+		kernel->count[i] = n;
+		for(k=0;k<n;k++){
+			kernel->weights[(size_t)i * kernel->taps + k] = (int16_t)fixed[k];
+		}
+	}
+}
+
+Resampler::Resampler(const ResampleKernel *x, const ResampleKernel *y, uint32_t channels){
+	uint32_t i;
+	x_ = x;
+	y_ = y;
+	channels_ = channels;
+	lanes_ = channels == 1 ? 1 : 4;
+	pushed_ = 0;
+	// the SIMD row pass reads up to 8 pixels past the last weight
+	source_.assign(((size_t)x->srcSize + 8) * lanes_, 0);
+	// rows pushed for earlier destination rows must not overwrite the
+	// first row of a later one
+	uint32_t needed = 0;
+	ringRows_ = 1;
+	for(i=0;i<y->dstSize;i++){
+		if( y->start[i] + y->count[i] > needed ){
+			needed = y->start[i] + y->count[i];
+		}
+		if( needed - y->start[i] > ringRows_ ){
+			ringRows_ = needed - y->start[i];
+		}
+	}
+	ring_.assign((size_t)ringRows_ * x->dstSize * lanes_, 0);
+	wide_.assign((size_t)x->dstSize * lanes_, 0);
+}
+
+uint32_t Resampler::firstRow(uint32_t destY) const {
+	return y_->start[destY];
+}
+
+uint32_t Resampler::rowsNeeded(uint32_t destY) const {
+	return y_->start[destY] + y_->count[destY];
+}
+
+void Resampler::skipRows(uint32_t n){
+	pushed_ = n;
+}
+
+static inline int16_t row_value(int32_t acc){
+	acc = (acc + 128) >> 8;
+	return (int16_t)(acc < -32768 ? -32768 : acc > 32767 ? 32767 : acc);
+}
+
+static void row_pass_scalar(const ResampleKernel &k, const uint8_t *src, uint32_t lanes, int16_t *out){
+	uint32_t x, t, c;
+	for(x=0;x<k.dstSize;x++){
+		const int16_t *w = &k.weights[(size_t)x * k.taps];
+		const uint8_t *s = src + (size_t)k.start[x] * lanes;
+		for(c=0;c<lanes;c++){
+			int32_t acc = 0;
+			for(t=0;t<k.count[x];t++){
+				acc += w[t] * s[t * lanes + c];
+			}
+			out[x * lanes + c] = row_value(acc);
+		}
+	}
+}
+
+static inline uint8_t column_value(int32_t acc){
+	acc = (acc + (1 << 19)) >> 20;
+	return (uint8_t)(acc < 0 ? 0 : acc > 255 ? 255 : acc);
+}
+
+static void column_pass_scalar(const int16_t *const *rows, const int16_t *w, uint32_t count,
+		uint32_t from, uint32_t n, uint8_t *out){
+	uint32_t i, t;
+	for(i=from;i<n;i++){
+		int32_t acc = 0;
+		for(t=0;t<count;t++){
+			acc += w[t] * rows[t][i];
+		}
+		out[i] = column_value(acc);
+	}
+}
+
+#ifdef RESAMPLE_SSE2
+
+static inline __m128i weight_pair(const int16_t *w){
+	return _mm_set1_epi32((int)((uint32_t)(uint16_t)w[0] | ((uint32_t)(uint16_t)w[1] << 16)));
+}
+
+// BGRx: pairs of source pixels interleaved per channel, one madd per pair.
+static void row_pass_sse2_bgrx(const ResampleKernel &k, const uint8_t *src, int16_t *out){
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i round = _mm_set1_epi32(128);
+	uint32_t x, t;
+	for(x=0;x<k.dstSize;x++){
+		const int16_t *w = &k.weights[(size_t)x * k.taps];
+		const uint8_t *s = src + (size_t)k.start[x] * 4;
+		__m128i acc = zero;
+		for(t=0;t<k.count[x];t+=2){
+			__m128i px = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(s + 4 * t)), zero);
+			px = _mm_unpacklo_epi16(px, _mm_srli_si128(px, 8));
+			acc = _mm_add_epi32(acc, _mm_madd_epi16(px, weight_pair(w + t)));
+		}
+		acc = _mm_srai_epi32(_mm_add_epi32(acc, round), 8);
+		_mm_storel_epi64((__m128i *)(out + 4 * x), _mm_packs_epi32(acc, acc));
+	}
+}
+
+// Gray: 8 taps per madd, summed across the lanes at the end.
+static void row_pass_sse2_gray(const ResampleKernel &k, const uint8_t *src, int16_t *out){
+	const __m128i zero = _mm_setzero_si128();
+	uint32_t x, t;
+	for(x=0;x<k.dstSize;x++){
+		const int16_t *w = &k.weights[(size_t)x * k.taps];
+		const uint8_t *s = src + k.start[x];
+		__m128i acc = zero;
+		for(t=0;t<k.count[x];t+=8){
+			__m128i px = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(s + t)), zero);
+			acc = _mm_add_epi32(acc, _mm_madd_epi16(px, _mm_loadu_si128((const __m128i *)(w + t))));
+		}
+		acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 8));
+		acc = _mm_add_epi32(acc, _mm_srli_si128(acc, 4));
+		out[x] = row_value(_mm_cvtsi128_si32(acc));
+	}
+}
+
+// 8 values at a time, two rows per madd.
+static void column_pass_sse2(const int16_t *const *rows, const int16_t *w, uint32_t count,
+		uint32_t n, uint8_t *out){
+	const __m128i round = _mm_set1_epi32(1 << 19);
+	uint32_t i = 0, t;
+	for(;i+8<=n;i+=8){
+		__m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+		for(t=0;t<count;t+=2){
+			__m128i a = _mm_loadu_si128((const __m128i *)(rows[t] + i));
+			__m128i b = t + 1 < count ? _mm_loadu_si128((const __m128i *)(rows[t + 1] + i)) : a;
+			__m128i ww = weight_pair(w + t);
+			lo = _mm_add_epi32(lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), ww));
+			hi = _mm_add_epi32(hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), ww));
+		}
+		lo = _mm_srai_epi32(_mm_add_epi32(lo, round), 20);
+		hi = _mm_srai_epi32(_mm_add_epi32(hi, round), 20);
+		__m128i v = _mm_packs_epi32(lo, hi);
+		_mm_storel_epi64((__m128i *)(out + i), _mm_packus_epi16(v, v));
+	}
+	column_pass_scalar(rows, w, count, i, n, out);
+}
+
+#endif
+
+void Resampler::pushRow(const uint8_t *row){
+	uint32_t width = x_->srcSize, i;
+	int16_t *out = &ring_[(size_t)(pushed_ % ringRows_) * x_->dstSize * lanes_];
+	if( channels_ == 1 ){
+		memcpy(&source_[0], row, width);
+	} else {
+		for(i=0;i<width;i++){
+			memcpy(&source_[4 * i], row + 3 * i, 3);
+		}
+	}
+#ifdef RESAMPLE_SSE2
+	if( useSimd ){
+		if( lanes_ == 4 ){
+			row_pass_sse2_bgrx(*x_, &source_[0], out);
+		} else {
+			row_pass_sse2_gray(*x_, &source_[0], out);
+		}
+		pushed_ += 1;
+		return;
+	}
+#endif
+	row_pass_scalar(*x_, &source_[0], lanes_, out);
+	pushed_ += 1;
+}
+
+void Resampler::destRow(uint32_t destY, uint8_t *out){
+	const int16_t *rows[64];
+	std::vector<const int16_t *> moreRows;
+	const int16_t **r = rows;
+	uint32_t count = y_->count[destY], t, i;
+	uint32_t n = x_->dstSize * lanes_;
+	if( count > 64 ){
+		moreRows.resize(count);
+		r = &moreRows[0];
+	}
+	for(t=0;t<count;t++){
+		r[t] = &ring_[(size_t)((y_->start[destY] + t) % ringRows_) * n];
+	}
+	const int16_t *w = &y_->weights[(size_t)destY * y_->taps];
+	uint8_t *target = lanes_ == channels_ ? out : &wide_[0];
+#ifdef RESAMPLE_SSE2
+	if( useSimd ){
+		column_pass_sse2(r, w, count, n, target);
+	} else
+#endif
+	column_pass_scalar(r, w, count, 0, n, target);
+	if( target != out ){
+		for(i=0;i<x_->dstSize;i++){
+			memcpy(out + 3 * i, target + 4 * i, 3);
+		}
+	}
+}
+
+struct ResampleStrip {
+	const ResampleKernel *x;
+	const ResampleKernel *y;
+	uint32_t channels;
+	// source row r is at rows + (r - firstRow) * rowStride
+	const uint8_t *rows;
+	uint32_t firstRow;
+	ptrdiff_t rowStride;
+	uint32_t y0;
+	uint32_t y1;
+	// destination row y is at out + (y - outRow) * outStride
+	uint8_t *out;
+	uint32_t outRow;
+	ptrdiff_t outStride;
+};
+
+static void resample_strip(const ResampleStrip &strip){
+	Resampler resampler(strip.x, strip.y, strip.channels);
+	uint32_t y;
+	resampler.skipRows(resampler.firstRow(strip.y0));
+	for(y=strip.y0;y<strip.y1;y++){
+		while( resampler.pushed() < resampler.rowsNeeded(y) ){
+			resampler.pushRow(strip.rows + (ptrdiff_t)(resampler.pushed() - strip.firstRow) * strip.rowStride);
+		}
+		resampler.destRow(y, strip.out + (ptrdiff_t)(y - strip.outRow) * strip.outStride);
+	}
+}
+
+// Destination rows [strip.y0, strip.y1) in up to threads strips of at least
+// 32 rows; the last strip runs on the calling thread.
+static void resample_strips(const ResampleStrip &strip, int threads){
+	uint32_t rows = strip.y1 - strip.y0, i;
+	uint32_t n = threads < 1 ? 1 : (uint32_t)threads;
+	if( n > rows / 32 ){
+		n = rows / 32 > 0 ? rows / 32 : 1;
+	}
+	std::vector<std::thread> workers;
+	for(i=0;i<n;i++){
+		ResampleStrip part = strip;
+		part.y0 = strip.y0 + (uint32_t)((uint64_t)rows * i / n);
+		part.y1 = strip.y0 + (uint32_t)((uint64_t)rows * (i + 1) / n);
+		if( i + 1 < n ){
+			workers.push_back(std::thread(resample_strip, part));
+		} else {
+			resample_strip(part);
+		}
+	}
+	for(i=0;i<workers.size();i++){
+		workers[i].join();
+	}
+}
+
+void resample_image(const uint8_t *src, ptrdiff_t srcStride, uint32_t srcWidth, uint32_t srcHeight,
+		uint8_t *dst, ptrdiff_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+		uint32_t channels, int filter, int threads){
+	ResampleKernel x, y;
+	make_resample_kernel(srcWidth, dstWidth, filter, &x);
+	make_resample_kernel(srcHeight, dstHeight, filter, &y);
+	ResampleStrip strip;
+	strip.x = &x;
+	strip.y = &y;
+	strip.channels = channels;
+	strip.rows = src;
+	strip.firstRow = 0;
+	strip.rowStride = srcStride;
+	strip.y0 = 0;
+	strip.y1 = dstHeight;
+	strip.out = dst;
+	strip.outRow = 0;
+	strip.outStride = dstStride;
+	resample_strips(strip, threads);
+}
+
+bool draw_resampled(ImageRows *rows, ImageTarget *target, long destX, long destY,
+		long destWidth, long destHeight, int filter, uint32_t bandRows,
+		const MonoOptions *mono, int threads, std::string *err){
+	if( destWidth <= 0 || destHeight <= 0 || destWidth > 65535 || destHeight > 1000000 ){
+		*err = "invalid image size";
+		return false;
+	}
+	uint32_t srcWidth = rows->width(), srcHeight = rows->height();
+	uint32_t width = (uint32_t)destWidth, height = (uint32_t)destHeight;
+	uint32_t channels = mono ? 1 : 3;
+	size_t rowBytes = (size_t)srcWidth * channels;
+	ResampleKernel kx, ky;
+	make_resample_kernel(srcWidth, width, filter, &kx);
+	make_resample_kernel(srcHeight, height, filter, &ky);
+	if( bandRows == 0 || bandRows > height ){
+		bandRows = height;
+	}
+	// 24 bpp band, or gray band and its 1 bpp conversion
+	uint32_t stride = mono ? ((width + 31) / 32) * 4 : ((width * 24 + 31) / 32) * 4;
+	std::vector<uint8_t> pixels((size_t)stride * bandRows), gray, info, bgr(rowBytes * 3 / channels);
+	MonoConverter converter(mono ? *mono : MonoOptions(), width);
+	if( mono ){
+		gray.resize((size_t)width * bandRows);
+	}
+	// source rows [bufferFirst, read) of the current band
+	std::vector<uint8_t> buffer;
+	uint32_t bufferFirst = 0, read = 0, y0, y;
+	for(y0=0;y0<height;y0+=bandRows){
+		uint32_t y1 = height - y0 < bandRows ? height : y0 + bandRows;
+		uint32_t first = ky.start[y0], need = 0;
+		for(y=y0;y<y1;y++){
+			if( ky.start[y] + ky.count[y] > need ){
+				need = ky.start[y] + ky.count[y];
+			}
+		}
+		uint32_t drop = (first < read ? first : read) - bufferFirst;
+		buffer.erase(buffer.begin(), buffer.begin() + drop * rowBytes);
+		bufferFirst += drop;
+		for(;read<need;read++){
+			if( !rows->readRow(&bgr[0], err) ){
+				return false;
+			}
+			if( read < first ){
+				bufferFirst = read + 1;
+				continue;
+			}
+			if( mono ){
+				buffer.resize(buffer.size() + rowBytes);
+				mono_luma(&bgr[0], 3, srcWidth, &buffer[buffer.size() - rowBytes]);
+			} else {
+				buffer.insert(buffer.end(), bgr.begin(), bgr.end());
+			}
+		}
+
+		ResampleStrip strip;
+		strip.x = &kx;
+		strip.y = &ky;
+		strip.channels = channels;
+		strip.rows = &buffer[0];
+		strip.firstRow = bufferFirst;
+		strip.rowStride = (ptrdiff_t)rowBytes;
+		strip.y0 = y0;
+		strip.y1 = y1;
+		strip.out = mono ? &gray[0] : &pixels[0];
+		strip.outRow = y0;
+		strip.outStride = mono ? width : stride;
+		resample_strips(strip, threads);
+
+		if( mono ){
+			for(y=y0;y<y1;y++){
+				converter.convertRow(&gray[(size_t)(y - y0) * width], &pixels[(size_t)(y - y0) * stride]);
+			}
+		}
+		make_dib_info(width, -(int32_t)(y1 - y0), mono ? 1 : 24, &info);
+		if( !target->drawBand(destX, destY + y0, width, y1 - y0, width, y1 - y0, &pixels[0], &info[0]) ){
+			*err = "StretchDIBits failed";
+			return false;
+		}
+	}
+	// leave rows at the end of the image
+	for(;read<srcHeight;read++){
+		if( !rows->readRow(&bgr[0], err) ){
+			return false;
+		}
+	}
+	return true;
+}
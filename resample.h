@@ -0,0 +1,87 @@
+#ifndef DRAWER_RESAMPLE_H
+#define DRAWER_RESAMPLE_H
+
+#include "bmp-image.h"
+#include "mono-image.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+enum ResampleFilter {
+	// area average when shrinking, nearest neighbour when enlarging
+	RESAMPLE_BOX,
+	RESAMPLE_BILINEAR,
+	RESAMPLE_LANCZOS3
+};
+
+// Fixed-point weights of one dimension: destination i is the sum over
+// k < count[i] of weights[i * taps + k] * source[start[i] + k] / 16384. The
+// weights of each destination sum to exactly 16384; taps is count rounded up
+// for the SIMD kernels and the padding weights are 0. start never decreases.
+struct ResampleKernel {
+	uint32_t srcSize;
+	uint32_t dstSize;
+	uint32_t taps;
+	std::vector<uint32_t> start;
+	std::vector<uint32_t> count;
+	std::vector<int16_t> weights;
+};
+
+void make_resample_kernel(uint32_t srcSize, uint32_t dstSize, int filter, ResampleKernel *kernel);
+
+// SSE2 row and column passes are used where available; false forces the
+// scalar ones (same results), for tests and benchmarks. Returns the previous
+// setting.
+bool resample_use_simd(bool enable);
+
+// Scales an image one row at a time with separable passes: each source row
+// is scaled horizontally as it is pushed and kept in a ring of as many rows
+// as the vertical filter needs, and each destination row is a weighted sum
+// of those. Rows are gray (channels 1) or BGR (3).
+class Resampler {
+public:
+	Resampler(const ResampleKernel *x, const ResampleKernel *y, uint32_t channels);
+
+	// First source row destination row destY uses, and how many source rows
+	// (counting from row 0) must have been pushed before it is produced.
+	uint32_t firstRow(uint32_t destY) const;
+	uint32_t rowsNeeded(uint32_t destY) const;
+	// Source rows pushed (or skipped) so far.
+	uint32_t pushed() const { return pushed_; }
+
+	// Starts at source row n instead of 0, for a strip of the destination.
+	void skipRows(uint32_t n);
+	void pushRow(const uint8_t *row);
+	// destY must be at least the row produced before.
+	void destRow(uint32_t destY, uint8_t *out);
+
+private:
+	const ResampleKernel *x_;
+	const ResampleKernel *y_;
+	uint32_t channels_;
+	// 1 or 4 (BGRx) values per pixel inside
+	uint32_t lanes_;
+	uint32_t pushed_;
+	// source row with padding for the SIMD loads
+	std::vector<uint8_t> source_;
+	// horizontally scaled rows, 64 times the pixel values
+	std::vector<int16_t> ring_;
+	uint32_t ringRows_;
+	std::vector<uint8_t> wide_;
+};
+
+// Scales a whole image in memory, with the destination split into strips of
+// rows resampled on up to threads threads. Strides may be negative.
+void resample_image(const uint8_t *src, ptrdiff_t srcStride, uint32_t srcWidth, uint32_t srcHeight,
+	uint8_t *dst, ptrdiff_t dstStride, uint32_t dstWidth, uint32_t dstHeight,
+	uint32_t channels, int filter, int threads);
+
+// Scales rows of an image to (destWidth, destHeight) and draws them 1:1 in
+// bands of bandRows device rows: 24 bpp, or 1 bpp converted with mono. Only
+// the source rows a band needs are kept; all rows are read.
+bool draw_resampled(ImageRows *rows, ImageTarget *target, long destX, long destY,
+	long destWidth, long destHeight, int filter, uint32_t bandRows,
+	const MonoOptions *mono, int threads, std::string *err);
+
+#endif
@@ -0,0 +1,464 @@
+"use strict";
+
+// In-memory index of a printer-settings directory (the .devmode, .devnames
+// and .json files of setting.js). The directory is read and validated once;
+// get(name) is then a synchronous lookup that returns the DEVMODE and
+// DEVNAMES buffers ready for printPages, with the printer name already
+// parsed out of DEVNAMES. watch() keeps the index up to date when files are
+// changed by other processes, and save() writes each file to a temporary
+// name first and renames it, so a reader never sees half a file.
+//
+// Needs no native code, so it runs (and is tested) on any platform.
+
+var fs = require("fs");
+var path = require("path");
+var util = require("util");
+var EventEmitter = require("events").EventEmitter;
+
+var PACKED_VERSION = 1;
+var PACKED_HEADER_SIZE = 16;
+
+// Offsets in DEVMODEW: dmDeviceName is WCHAR[32].
+var DM_DEVICE_NAME_CHARS = 32;
+var DM_SIZE_OFFSET = 68;
+var DM_DRIVER_EXTRA_OFFSET = 70;
+var DM_MIN_SIZE = 72;
+
+function allocBuffer(size){
+	if( Buffer.alloc ){
+		return Buffer.alloc(size);
+	} else {
+		var buf = new Buffer(size);
+		buf.fill(0);
+		return buf;
+	}
+}
+
+function bufferFrom(value, encoding){
+	return Buffer.from ? Buffer.from(value, encoding) : new Buffer(value, encoding);
+}
+
+// UTF-16LE string at a char offset, up to its NUL or maxChars; null if it
+// starts or (without maxChars) runs past the end.
+function readWideString(buf, charOffset, maxChars){
+	var start = charOffset * 2, limit = buf.length, end;
+	if( start >= buf.length ){
+		return null;
+	}
+	if( maxChars !== undefined ){
+		limit = Math.min(limit, start + maxChars * 2);
+	}
+	for(end=start;end+1<limit;end+=2){
+		if( buf[end] === 0 && buf[end + 1] === 0 ){
+			return buf.toString("utf16le", start, end);
+		}
+	}
+	return maxChars === undefined ? null : buf.toString("utf16le", start, end);
+}
+
+// Checks the sizes a DEVMODEW declares against its buffer; throws if they
+// don't fit. Returns { deviceName }.
+function parseDevmodeBuffer(devmode){
+	if( !Buffer.isBuffer(devmode) || devmode.length < DM_MIN_SIZE ){
+		throw new Error("devmode too short");
+	}
+	var size = devmode.readUInt16LE(DM_SIZE_OFFSET);
+	var driverExtra = devmode.readUInt16LE(DM_DRIVER_EXTRA_OFFSET);
+	if( size < DM_MIN_SIZE || size + driverExtra > devmode.length ){
+		throw new Error("invalid devmode size");
+	}
+	return { deviceName: readWideString(devmode, 0, DM_DEVICE_NAME_CHARS) };
+}
+
+// DEVNAMES: four WORDs (driver, device and output offsets in chars, and
+// flags) followed by the strings. Throws if an offset is out of range.
+// Returns { driver, device, output }.
+function parseDevnamesBuffer(devnames){
+	if( !Buffer.isBuffer(devnames) || devnames.length < 8 ){
+		throw new Error("devnames too short");
+	}
+	var driver = readWideString(devnames, devnames.readUInt16LE(0));
+	var device = readWideString(devnames, devnames.readUInt16LE(2));
+	var output = readWideString(devnames, devnames.readUInt16LE(4));
+	if( driver === null || device === null || output === null ){
+		throw new Error("invalid devnames offset");
+	}
+	return { driver: driver, device: device, output: output };
+}
+
+// The entry get() returns: the setting of setting.js (devmode, devnames,
+// aux) plus printer, driver and output from devnames.
+function makeEntry(name, devmode, devnames, aux){
+	parseDevmodeBuffer(devmode);
+	var names = parseDevnamesBuffer(devnames);
+	return {
+		name: name,
+		devmode: devmode,
+		devnames: devnames,
+		aux: aux,
+		printer: names.device,
+		driver: names.driver,
+		output: names.output
+	};
+}
+
+function readIfExists(filePath){
+	try{
+		return fs.readFileSync(filePath);
+	} catch(ex){
+		if( ex.code === "ENOENT" ){
+			return null;
+		}
+		throw ex;
+	}
+}
+
+function writeFileAtomic(filePath, data, done){
+	var tmpPath = filePath + ".tmp";
+	fs.writeFile(tmpPath, data, function(err){
+		if( err ){
+			done(err);
+			return;
+		}
+		fs.rename(tmpPath, filePath, done);
+	});
+}
+
+function writeFileAtomicSync(filePath, data){
+	var tmpPath = filePath + ".tmp";
+	fs.writeFileSync(tmpPath, data);
+	fs.renameSync(tmpPath, filePath);
+}
+
+function unlinkIfExists(filePath, done){
+	fs.unlink(filePath, function(err){
+		done(err && err.code !== "ENOENT" ? err : undefined);
+	});
+}
+
+// Setting name of a file of the directory, or null for other files
+// (temporary files of save() included).
+function settingNameOf(file){
+	var ext = path.extname(file);
+	if( ext === ".devmode" || ext === ".devnames" || ext === ".json" ){
+		return path.basename(file, ext);
+	}
+	return null;
+}
+
+function SettingStore(dir){
+	EventEmitter.call(this);
+	this.dir = dir;
+	this.settings = Object.create(null);
+	// name ==> message, for settings whose files are invalid
+	this.errors = Object.create(null);
+	this.sortedNames = null;
+	this.watcher = null;
+	this.pending = Object.create(null);
+	this.timer = null;
+}
+
+util.inherits(SettingStore, EventEmitter);
+
+SettingStore.prototype.filePath = function(name, ext){
+	return path.join(this.dir, name + ext);
+};
+
+// Reads every setting of the directory, replacing the index.
+SettingStore.prototype.load = function(){
+	var files = fs.readdirSync(this.dir), i, name, seen = Object.create(null);
+	this.settings = Object.create(null);
+	this.errors = Object.create(null);
+	this.sortedNames = null;
+	for(i=0;i<files.length;i++){
+		name = settingNameOf(files[i]);
+		if( name !== null && !seen[name] ){
+			seen[name] = true;
+			this.loadOne(name);
+		}
+	}
+	return this;
+};
+
+// Re-reads one setting; returns true if the index changed. A setting
+// without its .devmode file is removed; an invalid one keeps its last good
+// entry and gets an entry in errors.
+SettingStore.prototype.loadOne = function(name){
+	var devmode, devnames, json, aux;
+	try{
+		devmode = readIfExists(this.filePath(name, ".devmode"));
+		if( devmode === null ){
+			delete this.errors[name];
+			return this.removeEntry(name);
+		}
+		devnames = readIfExists(this.filePath(name, ".devnames"));
+		if( devnames === null ){
+			throw new Error("missing devnames");
+		}
+		json = readIfExists(this.filePath(name, ".json"));
+		aux = json === null ? undefined : JSON.parse(json.toString("utf-8"));
+		var entry = makeEntry(name, devmode, devnames, aux), old = this.settings[name];
+		delete this.errors[name];
+		if( old && old.devmode.equals(devmode) && old.devnames.equals(devnames) &&
+				JSON.stringify(old.aux) === JSON.stringify(aux) ){
+			// our own save, or a touch
+			return false;
+		}
+		this.setEntry(entry);
+		return true;
+	} catch(ex){
+		this.errors[name] = ex.message;
+		return false;
+	}
+};
+
+SettingStore.prototype.setEntry = function(entry){
+	if( !(entry.name in this.settings) ){
+		this.sortedNames = null;
+	}
+	this.settings[entry.name] = entry;
+};
+
+SettingStore.prototype.removeEntry = function(name){
+	if( !(name in this.settings) ){
+		return false;
+	}
+	delete this.settings[name];
+	this.sortedNames = null;
+	return true;
+};
+
+// { name, devmode, devnames, aux, printer, driver, output } or null.
+SettingStore.prototype.get = function(name){
+	return this.settings[name] || null;
+};
+
+SettingStore.prototype.has = function(name){
+	return name in this.settings;
+};
+
+SettingStore.prototype.names = function(){
+	if( this.sortedNames === null ){
+		this.sortedNames = Object.keys(this.settings).sort();
+	}
+	return this.sortedNames.slice();
+};
+
+// Writes the files of a setting ({ devmode, devnames, aux? }) and updates
+// the index once they are all in place. .devmode is written last, because
+// its presence is what makes a setting.
+SettingStore.prototype.save = function(name, setting, done){
+	var self = this, entry, json;
+	try{
+		entry = makeEntry(name, setting.devmode, setting.devnames, setting.aux);
+	} catch(ex){
+		done(ex);
+		return;
+	}
+	json = JSON.stringify(setting.aux || {});
+	writeFileAtomic(self.filePath(name, ".devnames"), setting.devnames, function(err){
+		if( err ){
+			done(err);
+			return;
+		}
+		writeFileAtomic(self.filePath(name, ".json"), json, function(err){
+			if( err ){
+				done(err);
+				return;
+			}
+			writeFileAtomic(self.filePath(name, ".devmode"), setting.devmode, function(err){
+				if( err ){
+					done(err);
+					return;
+				}
+				entry.aux = JSON.parse(json);
+				self.setEntry(entry);
+				delete self.errors[name];
+				self.emit("change", name);
+				done();
+			});
+		});
+	});
+};
+
+SettingStore.prototype.saveSync = function(name, setting){
+	var entry = makeEntry(name, setting.devmode, setting.devnames, setting.aux);
+	var json = JSON.stringify(setting.aux || {});
+	writeFileAtomicSync(this.filePath(name, ".devnames"), setting.devnames);
+	writeFileAtomicSync(this.filePath(name, ".json"), json);
+	writeFileAtomicSync(this.filePath(name, ".devmode"), setting.devmode);
+	entry.aux = JSON.parse(json);
+	this.setEntry(entry);
+	delete this.errors[name];
+	this.emit("change", name);
+};
+
+// Deletes the files of a setting; .devmode first, so that a watcher never
+// sees a setting without its devnames.
+SettingStore.prototype.remove = function(name, done){
+	var self = this;
+	unlinkIfExists(self.filePath(name, ".devmode"), function(err){
+		if( err ){
+			done(err);
+			return;
+		}
+		if( self.removeEntry(name) ){
+			self.emit("change", name);
+		}
+		unlinkIfExists(self.filePath(name, ".devnames"), function(err){
+			if( err ){
+				done(err);
+				return;
+			}
+			unlinkIfExists(self.filePath(name, ".json"), done);
+		});
+	});
+};
+
+// Watches the directory and re-reads the settings whose files change, a
+// setting at a time, delay ms (default 50) after the last event for it, so
+// the three files of a save are read together. Emits "change" with the
+// name of each setting that was added, updated or removed.
+SettingStore.prototype.watch = function(delay){
+	var self = this;
+	if( self.watcher ){
+		return self;
+	}
+	delay = delay === undefined ? 50 : delay;
+	self.watcher = fs.watch(self.dir, function(event, file){
+		var name = file ? settingNameOf(String(file)) : null;
+		if( file && name === null ){
+			return;
+		}
+		// without a file name (some platforms) everything is re-read
+		self.pending[name === null ? "" : name] = true;
+		if( self.timer ){
+			clearTimeout(self.timer);
+		}
+		self.timer = setTimeout(function(){
+			self.timer = null;
+			self.flushPending();
+		}, delay);
+	});
+	self.watcher.on("error", function(err){
+		self.emit("error", err);
+	});
+	return self;
+};
+
+SettingStore.prototype.flushPending = function(){
+	var names = Object.keys(this.pending), i, before;
+	this.pending = Object.create(null);
+	if( names.indexOf("") >= 0 ){
+		before = this.settings;
+		this.load();
+		names = Object.keys(before).concat(Object.keys(this.settings));
+		for(i=0;i<names.length;i++){
+			if( before[names[i]] !== this.settings[names[i]] ){
+				this.emit("change", names[i]);
+			}
+		}
+		return;
+	}
+	for(i=0;i<names.length;i++){
+		if( this.loadOne(names[i]) ){
+			this.emit("change", names[i]);
+		}
+	}
+};
+
+SettingStore.prototype.close = function(){
+	if( this.watcher ){
+		this.watcher.close();
+		this.watcher = null;
+	}
+	if( this.timer ){
+		clearTimeout(this.timer);
+		this.timer = null;
+	}
+	this.pending = Object.create(null);
+};
+
+// Packed file: "DRWS", u16 version, u16 0, u32 count, u32 0, then per
+// setting u16 name length, u32 devmode, devnames and aux JSON lengths and
+// the name (UTF-8), devmode, devnames and aux bytes. All little endian.
+SettingStore.prototype.packedBuffer = function(){
+	var names = this.names(), parts = [], i, size = PACKED_HEADER_SIZE, pos;
+	for(i=0;i<names.length;i++){
+		var entry = this.settings[names[i]];
+		var part = {
+			name: bufferFrom(entry.name, "utf-8"),
+			devmode: entry.devmode,
+			devnames: entry.devnames,
+			aux: bufferFrom(JSON.stringify(entry.aux || {}), "utf-8")
+		};
+		size += 14 + part.name.length + part.devmode.length + part.devnames.length + part.aux.length;
+		parts.push(part);
+	}
+	var buf = allocBuffer(size);
+	buf.write("DRWS", 0, "ascii");
+	buf.writeUInt16LE(PACKED_VERSION, 4);
+	buf.writeUInt32LE(parts.length, 8);
+	pos = PACKED_HEADER_SIZE;
+	for(i=0;i<parts.length;i++){
+		buf.writeUInt16LE(parts[i].name.length, pos);
+		buf.writeUInt32LE(parts[i].devmode.length, pos + 2);
+		buf.writeUInt32LE(parts[i].devnames.length, pos + 6);
+		buf.writeUInt32LE(parts[i].aux.length, pos + 10);
+		pos += 14;
+		pos += parts[i].name.copy(buf, pos);
+		pos += parts[i].devmode.copy(buf, pos);
+		pos += parts[i].devnames.copy(buf, pos);
+		pos += parts[i].aux.copy(buf, pos);
+	}
+	return buf;
+};
+
+SettingStore.prototype.writePacked = function(filePath, done){
+	writeFileAtomic(filePath, this.packedBuffer(), done);
+};
+
+// Replaces the index with the settings of a packed file, in one read.
+// Throws if the file is not a packed settings file or is truncated.
+SettingStore.prototype.loadPacked = function(filePath){
+	var buf = fs.readFileSync(filePath), count, pos, i, settings = Object.create(null);
+	if( buf.length < PACKED_HEADER_SIZE || buf.toString("ascii", 0, 4) !== "DRWS" ){
+		throw new Error("not a packed settings file: " + filePath);
+	}
+	if( buf.readUInt16LE(4) !== PACKED_VERSION ){
+		throw new Error("unsupported packed settings version: " + buf.readUInt16LE(4));
+	}
+	count = buf.readUInt32LE(8);
+	pos = PACKED_HEADER_SIZE;
+	for(i=0;i<count;i++){
+		if( pos + 14 > buf.length ){
+			throw new Error("truncated packed settings file: " + filePath);
+		}
+		var nameLength = buf.readUInt16LE(pos);
+		var devmodeLength = buf.readUInt32LE(pos + 2);
+		var devnamesLength = buf.readUInt32LE(pos + 6);
+		var auxLength = buf.readUInt32LE(pos + 10);
+		pos += 14;
+		if( pos + nameLength + devmodeLength + devnamesLength + auxLength > buf.length ){
+			throw new Error("truncated packed settings file: " + filePath);
+		}
+		var name = buf.toString("utf-8", pos, pos + nameLength);
+		pos += nameLength;
+		// copies, so one setting does not keep the whole file alive
+		var devmode = bufferFrom(buf.slice(pos, pos + devmodeLength));
+		pos += devmodeLength;
+		var devnames = bufferFrom(buf.slice(pos, pos + devnamesLength));
+		pos += devnamesLength;
+		var aux = JSON.parse(buf.toString("utf-8", pos, pos + auxLength));
+		pos += auxLength;
+		settings[name] = makeEntry(name, devmode, devnames, aux);
+	}
+	this.settings = settings;
+	this.errors = Object.create(null);
+	this.sortedNames = null;
+	return this;
+};
+
+exports.SettingStore = SettingStore;
+exports.parseDevmodeBuffer = parseDevmodeBuffer;
+exports.parseDevnamesBuffer = parseDevnamesBuffer;
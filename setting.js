@@ -204,6 +204,10 @@ exports.setSettingDir = function(path){
 	gSettingDir = path;
 };
 
+exports.getSettingDir = function(){
+	return settingDir();
+};
+
 exports.settingExists = function(name, cb){
 	settingExists(name, cb);
 };
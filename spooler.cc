@@ -0,0 +1,196 @@
+#include "spooler.h"
+
+Spooler::Spooler(SpoolerListener *listener, size_t queueLimit){
+	listener_ = listener;
+	queueLimit_ = queueLimit;
+	stopping_ = false;
+}
+
+Spooler::~Spooler(){
+	shutdown();
+}
+
+bool Spooler::submit(const std::string &device, long jobId, PrintJob *job, int priority,
+		std::string *err){
+	std::unique_lock<std::mutex> lock(mutex_);
+	if( stopping_ ){
+		*err = "spooler stopped";
+		return false;
+	}
+	if( jobs_.find(jobId) != jobs_.end() ){
+		*err = "duplicate job id";
+		return false;
+	}
+	Worker *worker;
+	std::map<std::string, Worker *>::iterator found = workers_.find(device);
+	if( found != workers_.end() ){
+		worker = found->second;
+	} else {
+		worker = new Worker();
+		worker->name = device;
+		worker->busy = false;
+		worker->done = 0;
+		worker->failed = 0;
+		worker->canceled = 0;
+		worker->consecutiveFailures = 0;
+		workers_[device] = worker;
+		worker->thread = std::thread(&Spooler::work, this, worker);
+	}
+	if( worker->queue.size() >= queueLimit_ ){
+		*err = "queue full";
+		return false;
+	}
+	Entry entry;
+	entry.jobId = jobId;
+	entry.priority = priority;
+	entry.job = job;
+	// after the jobs of the same priority
+	std::vector<Entry>::iterator pos = worker->queue.begin();
+	while( pos != worker->queue.end() && pos->priority >= priority ){
+		++pos;
+	}
+	worker->queue.insert(pos, entry);
+	jobs_[jobId] = worker;
+	worker->cond.notify_one();
+	return true;
+}
+
+bool Spooler::cancel(long jobId){
+	std::unique_lock<std::mutex> lock(mutex_);
+	std::map<long, Worker *>::iterator found = jobs_.find(jobId);
+	if( found == jobs_.end() ){
+		return false;
+	}
+	Worker *worker = found->second;
+	if( worker->busy && worker->running.jobId == jobId ){
+		worker->running.job->cancel();
+		return true;
+	}
+	std::vector<Entry>::iterator iter;
+	for(iter=worker->queue.begin();iter!=worker->queue.end();++iter){
+		if( iter->jobId == jobId ){
+			PrintJob *job = iter->job;
+			worker->queue.erase(iter);
+			worker->canceled += 1;
+			jobs_.erase(jobId);
+			lock.unlock();
+			// returns at once with JOB_CANCELED, without opening the device
+			job->cancel();
+			job->run();
+			listener_->jobFinished(jobId, job);
+			return true;
+		}
+	}
+	return false;
+}
+
+void Spooler::work(Worker *worker){
+	std::unique_lock<std::mutex> lock(mutex_);
+	for(;;){
+		while( !stopping_ && worker->queue.empty() ){
+			worker->cond.wait(lock);
+		}
+		if( stopping_ ){
+			break;
+		}
+		worker->running = worker->queue.front();
+		worker->queue.erase(worker->queue.begin());
+		worker->busy = true;
+		PrintJob *job = worker->running.job;
+		long jobId = worker->running.jobId;
+		lock.unlock();
+		job->run();
+		lock.lock();
+		worker->busy = false;
+		jobs_.erase(jobId);
+		if( job->status() == JOB_DONE ){
+			worker->done += 1;
+			worker->consecutiveFailures = 0;
+		} else if( job->status() == JOB_CANCELED ){
+			worker->canceled += 1;
+		} else {
+			worker->failed += 1;
+			worker->consecutiveFailures += 1;
+		}
+		lock.unlock();
+		listener_->jobFinished(jobId, job);
+		lock.lock();
+	}
+}
+
+void Spooler::setQueueLimit(size_t limit){
+	std::unique_lock<std::mutex> lock(mutex_);
+	queueLimit_ = limit;
+}
+
+size_t Spooler::queueLimit(){
+	std::unique_lock<std::mutex> lock(mutex_);
+	return queueLimit_;
+}
+
+std::vector<SpoolerDeviceStatus> Spooler::status(){
+	std::unique_lock<std::mutex> lock(mutex_);
+	std::vector<SpoolerDeviceStatus> result;
+	std::map<std::string, Worker *>::iterator iter;
+	for(iter=workers_.begin();iter!=workers_.end();++iter){
+		Worker *worker = iter->second;
+		SpoolerDeviceStatus status;
+		status.name = worker->name;
+		status.queued = worker->queue.size();
+		status.busy = worker->busy;
+		status.runningJob = worker->busy ? worker->running.jobId : 0;
+		status.done = worker->done;
+		status.failed = worker->failed;
+		status.canceled = worker->canceled;
+		status.consecutiveFailures = worker->consecutiveFailures;
+		result.push_back(status);
+	}
+	return result;
+}
+
+size_t Spooler::pending(){
+	std::unique_lock<std::mutex> lock(mutex_);
+	return jobs_.size();
+}
+
+void Spooler::shutdown(){
+	std::vector<Entry> canceled;
+	std::vector<Worker *> workers;
+	std::map<std::string, Worker *>::iterator iter;
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		if( stopping_ ){
+			return;
+		}
+		stopping_ = true;
+		for(iter=workers_.begin();iter!=workers_.end();++iter){
+			Worker *worker = iter->second;
+			canceled.insert(canceled.end(), worker->queue.begin(), worker->queue.end());
+			worker->canceled += (long)worker->queue.size();
+			worker->queue.clear();
+			if( worker->busy ){
+				worker->running.job->cancel();
+			}
+			worker->cond.notify_one();
+			workers.push_back(worker);
+		}
+	}
+	size_t i;
+	for(i=0;i<canceled.size();i++){
+		canceled[i].job->cancel();
+		canceled[i].job->run();
+		{
+			std::unique_lock<std::mutex> lock(mutex_);
+			jobs_.erase(canceled[i].jobId);
+		}
+		listener_->jobFinished(canceled[i].jobId, canceled[i].job);
+	}
+	for(i=0;i<workers.size();i++){
+		workers[i]->thread.join();
+	}
+	std::unique_lock<std::mutex> lock(mutex_);
+	for(i=0;i<workers.size();i++){
+		delete workers[i];
+	}
+	workers_.clear();
+}
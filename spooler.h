@@ -0,0 +1,94 @@
+#ifndef DRAWER_SPOOLER_H
+#define DRAWER_SPOOLER_H
+
+#include "print-job.h"
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Receives the jobs of a Spooler when they are finished (done, failed or
+// canceled). Called on the worker thread of the device, or on the thread that
+// canceled a queued job or shut the spooler down; the listener owns the job
+// from then on.
+class SpoolerListener {
+public:
+	virtual ~SpoolerListener(){}
+	virtual void jobFinished(long jobId, PrintJob *job) = 0;
+};
+
+struct SpoolerDeviceStatus {
+	std::string name;
+	size_t queued;
+	bool busy;
+	long runningJob;
+	long done;
+	long failed;
+	long canceled;
+	// failed jobs since the last successful one
+	long consecutiveFailures;
+};
+
+// Runs print jobs with one worker thread per device (printer name), so that a
+// slow, jammed or failing printer only delays its own jobs. Each device has
+// a bounded queue ordered by priority (higher first) and then submission
+// order; submit() fails with "queue full" when the device already has
+// queueLimit jobs waiting, which is how callers get backpressure.
+//
+// Workers are started on the first job of a device and run until shutdown().
+class Spooler {
+public:
+	Spooler(SpoolerListener *listener, size_t queueLimit);
+	// Calls shutdown().
+	~Spooler();
+
+	// Takes ownership of job unless it fails.
+	bool submit(const std::string &device, long jobId, PrintJob *job, int priority,
+		std::string *err);
+	// A queued job is removed and reported as canceled right away; a running
+	// job stops at its next op. Returns false if the job is not queued or
+	// running.
+	bool cancel(long jobId);
+
+	void setQueueLimit(size_t limit);
+	size_t queueLimit();
+	std::vector<SpoolerDeviceStatus> status();
+	// Jobs that are queued or running on any device.
+	size_t pending();
+
+	// Cancels all jobs and waits for the workers to stop. Blocks until the
+	// running jobs have noticed the cancellation.
+	void shutdown();
+
+private:
+	struct Entry {
+		long jobId;
+		int priority;
+		PrintJob *job;
+	};
+
+	struct Worker {
+		std::string name;
+		std::thread thread;
+		std::condition_variable cond;
+		// kept sorted: next job first
+		std::vector<Entry> queue;
+		Entry running;
+		bool busy;
+		long done, failed, canceled, consecutiveFailures;
+	};
+
+	void work(Worker *worker);
+
+	SpoolerListener *listener_;
+	std::mutex mutex_;
+	size_t queueLimit_;
+	bool stopping_;
+	std::map<std::string, Worker *> workers_;
+	// device of each queued or running job
+	std::map<long, Worker *> jobs_;
+};
+
+#endif
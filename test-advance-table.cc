@@ -0,0 +1,146 @@
+#include "test-util.h"
+#include "advance-table.h"
+
+// Width of a code unit is (ch % 7) + 10; counts calls.
+class FakeSource : public AdvanceSource {
+public:
+	FakeSource(){ charCalls = 0; textCalls = 0; fail = false; }
+
+	bool charWidths(uint16_t first, uint16_t last, int *widths){
+		unsigned ch;
+		charCalls += 1;
+		if( fail ){
+			return false;
+		}
+		for(ch=first;ch<=last;ch++){
+			widths[ch - first] = (int)(ch % 7) + 10;
+		}
+		return true;
+	}
+
+	bool textWidth(const uint16_t *text, uint32_t length, long *width){
+		textCalls += 1;
+		*width = 1000 + length;
+		return true;
+	}
+
+	int charCalls;
+	int textCalls;
+	bool fail;
+};
+
+static long expected(const std::vector<uint16_t> &text){
+	long sum = 0;
+	size_t i;
+	for(i=0;i<text.size();i++){
+		sum += (text[i] % 7) + 10;
+	}
+	return sum;
+}
+
+static void test_measure(){
+	FakeSource source;
+	AdvanceTable table;
+	std::vector<uint16_t> abc = u16("abc");
+	long width = -1;
+	CHECK(table.measure(&abc[0], 3, &source, &width));
+	CHECK_EQ(width, expected(abc));
+	CHECK_EQ(source.charCalls, 1);
+	CHECK(table.measure(&abc[0], 3, &source, &width));
+	CHECK(table.measure(&abc[1], 1, &source, &width));
+	CHECK_EQ(width, ('b' % 7) + 10);
+	// no more GDI calls for the same characters
+	CHECK_EQ(source.charCalls, 1);
+	CHECK_EQ(table.loadedBlocks(), (size_t)1);
+	CHECK(table.measure(NULL, 0, &source, &width));
+	CHECK_EQ(width, 0);
+}
+
+static void test_blocks(){
+	FakeSource source;
+	AdvanceTable table;
+	static const uint16_t mixed[] = { 'A', 0x3042, 0x3043, 'B', 0x4e16, 0xffff };
+	std::vector<uint16_t> text(mixed, mixed + 6);
+	long width = 0;
+	CHECK(table.measure(&text[0], 6, &source, &width));
+	CHECK_EQ(width, expected(text));
+	CHECK_EQ(table.loadedBlocks(), (size_t)4);
+	CHECK_EQ(source.charCalls, 4);
+}
+
+static void test_surrogates(){
+	FakeSource source;
+	AdvanceTable table;
+	static const uint16_t text[] = { 'a', 0xd842, 0xdfb7, 'b' };
+	long width = 0;
+	CHECK(table.measure(text, 4, &source, &width));
+	CHECK_EQ(width, 1004);
+	CHECK_EQ(source.textCalls, 1);
+}
+
+static void test_advances(){
+	FakeSource source;
+	AdvanceTable table;
+	static const uint16_t text[] = { 'a', 0xd842, 0xdfb7, 0x3042, 0xdc00 };
+	int advances[5] = { -1, -1, -1, -1, -1 };
+	CHECK(table.advances(text, 5, &source, advances));
+	CHECK_EQ(advances[0], ('a' % 7) + 10);
+	// the pair as a whole, then a lone low surrogate
+	CHECK_EQ(advances[1], 1002);
+	CHECK_EQ(advances[2], 0);
+	CHECK_EQ(advances[3], (0x3042 % 7) + 10);
+	CHECK_EQ(advances[4], 1001);
+	CHECK_EQ(source.textCalls, 2);
+	CHECK_EQ(source.charCalls, 2);
+}
+
+static void test_batch(){
+	FakeSource source;
+	AdvanceTable table;
+	std::vector<uint16_t> text = u16("onetwothree");
+	uint32_t lengths[] = { 3, 3, 0, 5 };
+	int32_t widths[4] = { -1, -1, -1, -1 };
+	CHECK(table.measureBatch(&text[0], lengths, 4, &source, widths));
+	CHECK_EQ(widths[0], expected(u16("one")));
+	CHECK_EQ(widths[1], expected(u16("two")));
+	CHECK_EQ(widths[2], 0);
+	CHECK_EQ(widths[3], expected(u16("three")));
+	CHECK_EQ(source.charCalls, 1);
+}
+
+static void test_failure(){
+	FakeSource source;
+	AdvanceTable table;
+	std::vector<uint16_t> abc = u16("abc");
+	long width = 0;
+	source.fail = true;
+	CHECK(!table.measure(&abc[0], 3, &source, &width));
+	CHECK_EQ(table.loadedBlocks(), (size_t)0);
+	// retried on the next call
+	source.fail = false;
+	CHECK(table.measure(&abc[0], 3, &source, &width));
+	CHECK_EQ(width, expected(abc));
+}
+
+static void test_cache(){
+	AdvanceTableCache cache(2);
+	AdvanceTable *a = cache.table("a");
+	CHECK(cache.table("a") == a);
+	CHECK(cache.table("b") != a);
+	CHECK_EQ(cache.size(), (size_t)2);
+	cache.table("c");
+	CHECK_EQ(cache.size(), (size_t)1);
+	cache.clear();
+	CHECK_EQ(cache.size(), (size_t)0);
+}
+
+int main(){
+	test_measure();
+	test_blocks();
+	test_surrogates();
+	test_advances();
+	test_batch();
+	test_failure();
+	test_cache();
+	return test_summary("test-advance-table");
+}
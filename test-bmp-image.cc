@@ -0,0 +1,264 @@
+#include "test-util.h"
+#include "bmp-image.h"
+#include <string.h>
+
+static void put_u16(std::vector<uint8_t> &out, size_t pos, uint32_t value){
+	out[pos] = (uint8_t)value;
+	out[pos + 1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(std::vector<uint8_t> &out, size_t pos, uint32_t value){
+	put_u16(out, pos, value & 0xffff);
+	put_u16(out, pos + 2, value >> 16);
+}
+
+// 8 bpp BMP whose pixel (x, y) (y from the top) has palette index
+// (x + 3 * y) % 256.
+static std::vector<uint8_t> make_bmp(int width, int height, bool topDown){
+	uint32_t stride = (width + 3) & ~3;
+	uint32_t offset = 14 + 40 + 256 * 4;
+	std::vector<uint8_t> out(offset + stride * height, 0);
+	int x, y;
+	out[0] = 'B';
+	out[1] = 'M';
+	put_u32(out, 2, (uint32_t)out.size());
+	put_u32(out, 10, offset);
+	put_u32(out, 14, 40);
+	put_u32(out, 18, width);
+	put_u32(out, 22, (uint32_t)(topDown ? -height : height));
+	put_u16(out, 26, 1);
+	put_u16(out, 28, 8);
+	for(y=0;y<height;y++){
+		int stored = topDown ? y : height - 1 - y;
+		for(x=0;x<width;x++){
+			out[offset + stored * stride + x] = (uint8_t)((x + 3 * y) % 256);
+		}
+	}
+	return out;
+}
+
+static void test_parse(){
+	std::vector<uint8_t> bmp = make_bmp(5, 7, false);
+	BmpImage image;
+	std::string err;
+	CHECK(parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	CHECK_EQ(image.width, 5u);
+	CHECK_EQ(image.height, 7u);
+	CHECK(image.bottomUp);
+	CHECK_EQ(image.bitsPerPixel, 8u);
+	CHECK_EQ(image.stride, 8u);
+	CHECK_EQ(image.infoLength, 40u + 1024u);
+	CHECK(image.pixels == &bmp[14 + 40 + 1024]);
+	bmp = make_bmp(5, 7, true);
+	CHECK(parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	CHECK(!image.bottomUp);
+	CHECK_EQ(image.height, 7u);
+}
+
+static void test_parse_errors(){
+	std::vector<uint8_t> good = make_bmp(5, 7, false), bmp;
+	BmpImage image;
+	std::string err;
+	bmp = good;
+	bmp[0] = 'X';
+	CHECK(!parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	CHECK_STR(err, "not a BMP file");
+	CHECK(!parse_bmp(&good[0], good.size() - 1, &image, &err));
+	CHECK_STR(err, "truncated BMP");
+	CHECK(!parse_bmp(&good[0], 20, &image, &err));
+	bmp = good;
+	put_u16(bmp, 28, 12);
+	CHECK(!parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	CHECK_STR(err, "unsupported BMP bit depth");
+	bmp = good;
+	put_u32(bmp, 30, 1);
+	CHECK(!parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	CHECK_STR(err, "compressed BMP is not supported");
+	bmp = good;
+	put_u32(bmp, 18, 0);
+	CHECK(!parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	CHECK_STR(err, "invalid BMP size");
+	bmp = good;
+	put_u32(bmp, 10, 20);
+	CHECK(!parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	CHECK_STR(err, "invalid BMP pixel offset");
+	bmp = good;
+	put_u32(bmp, 46, 300);
+	CHECK(!parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	CHECK_STR(err, "invalid BMP palette");
+
+	// BITFIELDS with a header too short for the masks: 41 bytes, 1x1 at 16
+	// bpp, the pixel right after the header
+	bmp.assign(14 + 41 + 4, 0);
+	bmp[0] = 'B';
+	bmp[1] = 'M';
+	put_u32(bmp, 10, 14 + 41);
+	put_u32(bmp, 14, 41);
+	put_u32(bmp, 18, 1);
+	put_u32(bmp, 22, 1);
+	put_u16(bmp, 26, 1);
+	put_u16(bmp, 28, 16);
+	put_u32(bmp, 30, BMP_BITFIELDS);
+	CHECK(!parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	CHECK_STR(err, "unsupported BMP header");
+	// the same with the masks after a 40 byte header
+	put_u32(bmp, 14, 40);
+	put_u32(bmp, 10, 14 + 40 + 12);
+	bmp.resize(14 + 40 + 12 + 4, 0);
+	CHECK(parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	CHECK_EQ(image.infoLength, 52u);
+}
+
+static void test_plan(){
+	std::vector<uint8_t> bmp = make_bmp(4, 10, false);
+	BmpImage image;
+	std::string err;
+	std::vector<ImageBand> bands;
+	CHECK(parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	plan_image_bands(image, 4, 100, 25, &bands);
+	CHECK_EQ(bands.size(), (size_t)3);
+	CHECK_EQ(bands[0].srcY, 0u);
+	CHECK_EQ(bands[0].rows, 4u);
+	CHECK_EQ(bands[0].destY, 100);
+	CHECK_EQ(bands[0].destHeight, 10);
+	CHECK_EQ(bands[1].destY, 110);
+	CHECK_EQ(bands[1].destHeight, 10);
+	CHECK_EQ(bands[2].srcY, 8u);
+	CHECK_EQ(bands[2].rows, 2u);
+	CHECK_EQ(bands[2].destY, 120);
+	CHECK_EQ(bands[2].destHeight, 5);
+	plan_image_bands(image, 0, 0, 10, &bands);
+	CHECK_EQ(bands.size(), (size_t)1);
+	// bottom-up: the top band is stored last
+	plan_image_bands(image, 4, 0, 10, &bands);
+	CHECK(band_pixels(image, bands[0]) == image.pixels + 6 * image.stride);
+	CHECK(band_pixels(image, bands[2]) == image.pixels);
+	std::vector<uint8_t> info;
+	band_info(image, bands[2], &info);
+	CHECK_EQ(info.size(), (size_t)image.infoLength);
+	CHECK_EQ(info[8], 2);
+	CHECK_EQ(info[20], 2 * 4);
+}
+
+// Draws bands into a canvas with nearest neighbour scaling, like
+// StretchDIBits in COLORONCOLOR mode.
+class CanvasTarget : public ImageTarget {
+public:
+	CanvasTarget(int width, int height) : width(width), height(height),
+		pixels(width * height, -1), calls(0), maxRows(0) {}
+
+	bool drawBand(long destX, long destY, long destWidth, long destHeight,
+			uint32_t srcWidth, uint32_t srcRows, const uint8_t *bits, const uint8_t *info){
+		int32_t biHeight = (int32_t)(info[8] | (info[9] << 8) | (info[10] << 16) | ((uint32_t)info[11] << 24));
+		uint32_t stride = (srcWidth + 3) & ~3u;
+		long x, y;
+		calls += 1;
+		if( srcRows > maxRows ){
+			maxRows = srcRows;
+		}
+		if( (uint32_t)(biHeight < 0 ? -biHeight : biHeight) != srcRows ){
+			return false;
+		}
+		for(y=0;y<destHeight;y++){
+			uint32_t sy = (uint32_t)(y * srcRows / destHeight);
+			uint32_t stored = biHeight > 0 ? srcRows - 1 - sy : sy;
+			for(x=0;x<destWidth;x++){
+				uint32_t sx = (uint32_t)(x * srcWidth / destWidth);
+				int cx = (int)(destX + x), cy = (int)(destY + y);
+				if( cx >= 0 && cx < width && cy >= 0 && cy < height ){
+					pixels[cy * width + cx] = bits[stored * stride + sx];
+				}
+			}
+		}
+		return true;
+	}
+
+	int width, height;
+	std::vector<int> pixels;
+	int calls;
+	uint32_t maxRows;
+};
+
+static void check_banded(int w, int h, bool topDown, int destW, int destH, uint32_t bandRows){
+	std::vector<uint8_t> bmp = make_bmp(w, h, topDown);
+	BmpImage image;
+	std::string err;
+	CHECK(parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	CanvasTarget whole(destW + 4, destH + 4), banded(destW + 4, destH + 4);
+	CHECK(draw_bmp_banded(image, &whole, 2, 2, destW, destH, 0, &err));
+	CHECK(draw_bmp_banded(image, &banded, 2, 2, destW, destH, bandRows, &err));
+	CHECK(banded.maxRows <= bandRows);
+	int x, y, painted = 0;
+	for(y=0;y<destH+4;y++){
+		for(x=0;x<destW+4;x++){
+			if( banded.pixels[y * (destW + 4) + x] >= 0 ){
+				painted += 1;
+			}
+		}
+	}
+	// every destination pixel is drawn exactly where the whole image would be
+	CHECK_EQ(painted, destW * destH);
+	// integer scales: identical to drawing the whole image at once
+	if( destW % w == 0 && destH % h == 0 ){
+		CHECK(banded.pixels == whole.pixels);
+		CHECK_EQ(banded.pixels[2 * (destW + 4) + 2 + destW / w], 1);
+	}
+}
+
+static void test_banded_draw(){
+	check_banded(13, 100, false, 13, 100, 16);
+	check_banded(13, 100, true, 13, 100, 7);
+	check_banded(13, 100, false, 26, 200, 16);
+	check_banded(13, 100, false, 26, 250, 16);
+	check_banded(13, 100, true, 7, 30, 16);
+	check_banded(13, 100, false, 13, 10, 3);
+}
+
+static void test_row_bgr(){
+	std::vector<uint8_t> bmp = make_bmp(5, 3, false);
+	BmpImage image;
+	std::string err;
+	uint8_t bgr[15];
+	int i;
+	for(i=0;i<256;i++){
+		bmp[54 + 4 * i] = (uint8_t)i;
+		bmp[54 + 4 * i + 1] = (uint8_t)(255 - i);
+		bmp[54 + 4 * i + 2] = 7;
+	}
+	CHECK(parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	bmp_row_bgr(image, 2, bgr);
+	// row 2 holds x + 6
+	CHECK_EQ(bgr[0], 6);
+	CHECK_EQ(bgr[1], 249);
+	CHECK_EQ(bgr[2], 7);
+	CHECK_EQ(bgr[12], 10);
+
+	// 16 bpp 5-5-5, bottom-up, two pixels
+	std::vector<uint8_t> rgb16(54 + 2 * 4, 0);
+	rgb16[0] = 'B';
+	rgb16[1] = 'M';
+	put_u32(rgb16, 10, 54);
+	put_u32(rgb16, 14, 40);
+	put_u32(rgb16, 18, 2);
+	put_u32(rgb16, 22, 2);
+	put_u16(rgb16, 26, 1);
+	put_u16(rgb16, 28, 16);
+	put_u16(rgb16, 54 + 4, 0x7c00);
+	put_u16(rgb16, 54 + 6, 0x0210);
+	CHECK(parse_bmp(&rgb16[0], rgb16.size(), &image, &err));
+	bmp_row_bgr(image, 0, bgr);
+	CHECK_EQ(bgr[0], 0);
+	CHECK_EQ(bgr[2], 255);
+	CHECK_EQ(bgr[3], 132);
+	CHECK_EQ(bgr[4], 132);
+	CHECK_EQ(bgr[5], 0);
+}
+
+int main(){
+	test_parse();
+	test_parse_errors();
+	test_plan();
+	test_banded_draw();
+	test_row_bgr();
+	return test_summary("test-bmp-image");
+}
@@ -0,0 +1,207 @@
+#include "test-util.h"
+#include "dc-pool.h"
+#include <set>
+#include <string.h>
+
+static double fakeNow = 0;
+
+static double fake_clock(){
+	return fakeNow;
+}
+
+// Hands out increasing DC numbers; creation takes createSeconds of fake time.
+class MockDcFactory : public DcFactory {
+public:
+	MockDcFactory() : next(1), created(0), resets(0), failCreate(false),
+		failReset(false), createSeconds(0.1) {}
+
+	DeviceHandle create(const std::string &printer, const char *devmode,
+			size_t devmodeLength, std::string *err){
+		fakeNow += createSeconds;
+		if( failCreate ){
+			*err = "no such printer: " + printer;
+			return 0;
+		}
+		created += 1;
+		live.insert(next);
+		return next++;
+	}
+
+	bool reset(DeviceHandle dc){
+		resets += 1;
+		return !failReset;
+	}
+
+	bool healthy(DeviceHandle dc){
+		return broken.find(dc) == broken.end();
+	}
+
+	void destroy(DeviceHandle dc){
+		live.erase(dc);
+	}
+
+	DeviceHandle next;
+	int created, resets;
+	bool failCreate, failReset;
+	double createSeconds;
+	std::set<DeviceHandle> live, broken;
+};
+
+static const char devmodeA[] = "devmode A";
+static const char devmodeB[] = "devmode B";
+
+static DeviceHandle acquire(DcPool &pool, const char *printer, const char *devmode){
+	std::string err;
+	return pool.acquire(printer, devmode, strlen(devmode), &err);
+}
+
+static void test_reuse(){
+	MockDcFactory factory;
+	DcPool pool(&factory, 60, 8);
+	pool.setClock(fake_clock);
+	DeviceHandle a = acquire(pool, "kitchen", devmodeA);
+	CHECK(a != 0);
+	CHECK(pool.release(a, false));
+	CHECK_EQ(factory.resets, 1);
+	CHECK_EQ(acquire(pool, "kitchen", devmodeA), a);
+	// another devmode or printer gets its own DC
+	DeviceHandle b = acquire(pool, "kitchen", devmodeB);
+	DeviceHandle c = acquire(pool, "bar", devmodeA);
+	CHECK(b != a && c != a && b != c);
+	CHECK(pool.release(a, false));
+	CHECK(pool.release(b, false));
+	CHECK(pool.release(c, false));
+	CHECK(!pool.release(c, false));
+	CHECK(!pool.release(99, false));
+	DcPoolStats stats = pool.stats();
+	CHECK_EQ(stats.hits, 1);
+	CHECK_EQ(stats.misses, 3);
+	CHECK_EQ(stats.idle, 3);
+	CHECK_EQ(stats.leased, 0);
+	CHECK(stats.createSeconds > 0.29 && stats.createSeconds < 0.31);
+	CHECK(stats.maxCreateSeconds > 0.09 && stats.maxCreateSeconds < 0.11);
+}
+
+static void test_keys(){
+	CHECK(dc_pool_key("p", devmodeA, 9) == dc_pool_key("p", devmodeA, 9));
+	CHECK(dc_pool_key("p", devmodeA, 9) != dc_pool_key("p", devmodeB, 9));
+	CHECK(dc_pool_key("p", devmodeA, 9) != dc_pool_key("q", devmodeA, 9));
+	CHECK(dc_pool_key("p", devmodeA, 8) != dc_pool_key("p", devmodeA, 9));
+	CHECK(dc_pool_key("p", NULL, 0) != dc_pool_key("p", devmodeA, 9));
+}
+
+static void test_most_recent_first(){
+	MockDcFactory factory;
+	DcPool pool(&factory, 60, 8);
+	pool.setClock(fake_clock);
+	DeviceHandle a = acquire(pool, "p", devmodeA);
+	DeviceHandle b = acquire(pool, "p", devmodeA);
+	pool.release(a, false);
+	pool.release(b, false);
+	CHECK_EQ(acquire(pool, "p", devmodeA), b);
+	CHECK_EQ(acquire(pool, "p", devmodeA), a);
+	CHECK_EQ(factory.created, 2);
+}
+
+static void test_idle_timeout(){
+	MockDcFactory factory;
+	DcPool pool(&factory, 30, 8);
+	pool.setClock(fake_clock);
+	DeviceHandle a = acquire(pool, "p", devmodeA);
+	pool.release(a, false);
+	fakeNow += 20;
+	CHECK_EQ(acquire(pool, "p", devmodeA), a);
+	pool.release(a, false);
+	fakeNow += 31;
+	pool.expire(false);
+	CHECK_EQ(pool.stats().idle, 0);
+	CHECK(factory.live.empty());
+	DeviceHandle b = acquire(pool, "p", devmodeA);
+	CHECK(b != a);
+	pool.release(b, false);
+	// also expired lazily by the next acquire
+	fakeNow += 31;
+	CHECK(acquire(pool, "p", devmodeA) != b);
+	CHECK_EQ(pool.stats().destroyed, 2);
+}
+
+static void test_max_idle(){
+	MockDcFactory factory;
+	DcPool pool(&factory, 60, 2);
+	pool.setClock(fake_clock);
+	DeviceHandle a = acquire(pool, "a", devmodeA);
+	DeviceHandle b = acquire(pool, "b", devmodeA);
+	DeviceHandle c = acquire(pool, "c", devmodeA);
+	pool.release(a, false);
+	pool.release(b, false);
+	pool.release(c, false);
+	// a was released first
+	CHECK(factory.live.find(a) == factory.live.end());
+	CHECK_EQ(factory.live.size(), (size_t)2);
+	pool.setMaxIdle(0);
+	CHECK(factory.live.empty());
+	DeviceHandle d = acquire(pool, "a", devmodeA);
+	pool.release(d, false);
+	CHECK(factory.live.empty());
+}
+
+static void test_health_and_reset(){
+	MockDcFactory factory;
+	DcPool pool(&factory, 60, 8);
+	pool.setClock(fake_clock);
+	DeviceHandle a = acquire(pool, "p", devmodeA);
+	DeviceHandle b = acquire(pool, "p", devmodeA);
+	pool.release(a, false);
+	pool.release(b, false);
+	factory.broken.insert(b);
+	// b is unhealthy and destroyed, a is used instead
+	CHECK_EQ(acquire(pool, "p", devmodeA), a);
+	CHECK_EQ(pool.stats().unhealthy, 1);
+	CHECK(factory.live.find(b) == factory.live.end());
+	// a DC that cannot be reset is not kept
+	factory.failReset = true;
+	pool.release(a, false);
+	CHECK(factory.live.empty());
+	factory.failReset = false;
+	DeviceHandle c = acquire(pool, "p", devmodeA);
+	// a failed job discards its DC
+	pool.release(c, true);
+	CHECK(factory.live.empty());
+	CHECK_EQ(pool.stats().idle, 0);
+}
+
+static void test_create_failure(){
+	MockDcFactory factory;
+	DcPool pool(&factory, 60, 8);
+	pool.setClock(fake_clock);
+	std::string err;
+	factory.failCreate = true;
+	CHECK_EQ(pool.acquire("gone", devmodeA, 9, &err), (DeviceHandle)0);
+	CHECK_STR(err, "no such printer: gone");
+	CHECK_EQ(pool.stats().createFailures, 1);
+	CHECK_EQ(pool.stats().leased, 0);
+}
+
+static void test_destroy(){
+	MockDcFactory factory;
+	{
+		DcPool pool(&factory, 60, 8);
+		pool.setClock(fake_clock);
+		pool.release(acquire(pool, "p", devmodeA), false);
+		pool.release(acquire(pool, "q", devmodeA), false);
+		CHECK_EQ(factory.live.size(), (size_t)2);
+	}
+	CHECK(factory.live.empty());
+}
+
+int main(){
+	test_reuse();
+	test_keys();
+	test_most_recent_first();
+	test_idle_timeout();
+	test_max_idle();
+	test_health_and_reset();
+	test_create_failure();
+	test_destroy();
+	return test_summary("test-dc-pool");
+}
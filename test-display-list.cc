@@ -0,0 +1,195 @@
+#include "test-util.h"
+#include "test-fixtures.h"
+#include "display-list.h"
+#include "page-executor.h"
+#include "recording-device.h"
+#include <atomic>
+
+// Page that redefines its font half way, like the pages of printer.js do.
+static Page &build_refont(PageBuilder &b, const char *label){
+	b.clear();
+	b.createFont("f", "MS Gothic", 4, 0, 0);
+	b.createPen("p", 0, 0, 0, 0.1);
+	b.setFont("f");
+	b.setPen("p");
+	fixture_text(b, label, 10, 10, 2);
+	b.moveTo(10, 15);
+	b.lineTo(60, 15.5);
+	b.createFont("f", "MS Mincho", 5, 1, 1);
+	b.setFont("f");
+	b.setTextColor(255, 0, 0);
+	fixture_text(b, label, 10, 20, 2.5);
+	return b.finish();
+}
+
+static std::string page_calls(const Page *const *pages, size_t count, bool replay,
+		int copies, bool collate, long *replayed){
+	RecordingDevice device(203, 203);
+	{
+		PageExecutor executor(&device);
+		executor.setReplay(replay);
+		executor.setCopies(copies, collate);
+		executor.setOffset(1.5, 2);
+		CHECK(executor.runJob(pages, count, 0, 0));
+		if( replayed ){
+			*replayed = executor.replayedPages();
+		}
+	}
+	return device.dump();
+}
+
+static void test_hash(){
+	PageBuilder a, b, c;
+	fixture_receipt(a, 10);
+	fixture_receipt(b, 10);
+	fixture_receipt(c, 11);
+	CHECK(page_hash(a.page()) == page_hash(b.page()));
+	CHECK(pages_equal(a.page(), b.page()));
+	CHECK(page_hash(a.page()) != page_hash(c.page()));
+	CHECK(!pages_equal(a.page(), c.page()));
+
+	// one coordinate, one character or one color apart
+	build_refont(a, "ORDER 12");
+	build_refont(b, "ORDER 12");
+	CHECK(page_hash(a.page()) == page_hash(b.page()));
+	build_refont(c, "ORDER 13");
+	CHECK(page_hash(a.page()) != page_hash(c.page()));
+	CHECK(!pages_equal(a.page(), c.page()));
+	b.page().ops[6].ys.value = 15.25;
+	CHECK(page_hash(a.page()) != page_hash(b.page()));
+	CHECK(!pages_equal(a.page(), b.page()));
+	build_refont(b, "ORDER 12");
+	b.page().ops[9].r = 254;
+	CHECK(page_hash(a.page()) != page_hash(b.page()));
+}
+
+// runList makes the same calls as runOps, font redefinitions included.
+static void test_record(){
+	PageBuilder b;
+	build_refont(b, "Table 4");
+	DisplayList list;
+	std::string err;
+	CHECK(list.record(b.page(), 203, 203, 1.5, 2, &err));
+	CHECK_EQ(list.opCount(), (long)b.page().ops.size());
+	CHECK_EQ(list.skippedOps(), 0L);
+
+	RecordingDevice direct(203, 203), replayed(203, 203);
+	{
+		PageExecutor executor(&direct);
+		executor.setOffset(1.5, 2);
+		CHECK(executor.runOps(b.page()));
+		CHECK(executor.runOps(b.page()));
+	}
+	{
+		PageExecutor executor(&replayed);
+		CHECK(executor.runList(list));
+		CHECK(executor.runList(list));
+		CHECK_EQ(executor.opCount(), 2 * list.opCount());
+	}
+	CHECK_STR(replayed.dump(), direct.dump());
+
+	// the list is only as valid as the page
+	b.clear();
+	b.setFont("nope");
+	b.finish();
+	CHECK(list.record(b.page(), 203, 203, 0, 0, &err));
+	PageExecutor executor(&replayed);
+	CHECK(!executor.runList(list));
+	CHECK_STR(executor.error(), "unknown font: nope");
+	double xs[] = { 1 };
+	b.clear();
+	b.drawChars(u16("ab").data(), 2, b.addCoords(xs, 1), b.scalar(1));
+	b.finish();
+	CHECK(!list.record(b.page(), 203, 203, 0, 0, &err));
+	CHECK_STR(err, "too few coordinates to drawChars");
+}
+
+static void test_duplicates(){
+	PageBuilder a1, b, a2, c;
+	build_refont(a1, "Ticket 1");
+	build_refont(b, "Ticket 2");
+	build_refont(a2, "Ticket 1");
+	fixture_receipt(c, 5);
+	const Page *pages[] = { &a1.page(), &b.page(), &a2.page(), &c.page(), &a1.page() };
+	long replayed = -1;
+	std::string withReplay = page_calls(pages, 5, true, 1, true, &replayed);
+	CHECK_EQ(replayed, 3L);
+	CHECK_STR(withReplay, page_calls(pages, 5, false, 1, true, &replayed));
+	CHECK_EQ(replayed, 0L);
+
+	// nothing repeats
+	page_calls(pages, 2, true, 1, true, &replayed);
+	CHECK_EQ(replayed, 0L);
+}
+
+static std::string page_order(const RecordingDevice &device){
+	std::string order;
+	size_t i;
+	for(i=0;i<device.calls().size();i++){
+		const DeviceCall &call = device.calls()[i];
+		if( call.kind == CALL_TEXT_RUN && call.text.size() == 8 ){
+			order += (char)call.text[7];
+		}
+	}
+	return order;
+}
+
+static void test_copies(){
+	PageBuilder p1, p2, p3;
+	build_refont(p1, "Ticket 1");
+	build_refont(p2, "Ticket 2");
+	build_refont(p3, "Ticket 3");
+	const Page *pages[] = { &p1.page(), &p2.page(), &p3.page() };
+	RecordingDevice device(203, 203);
+	{
+		PageExecutor executor(&device);
+		executor.setCopies(2, true);
+		CHECK(executor.runJob(pages, 3, 0, 0));
+		CHECK_EQ(executor.replayedPages(), 6L);
+	}
+	CHECK_EQ(device.count(CALL_START_DOC), 1L);
+	CHECK_EQ(device.count(CALL_END_PAGE), 6L);
+	// two runs per page, the second font
+	CHECK_STR(page_order(device), "112233112233");
+	CHECK_EQ(device.liveObjects(), 0);
+
+	device.clear();
+	{
+		PageExecutor executor(&device);
+		executor.setCopies(3, false);
+		CHECK(executor.runJob(pages, 3, 0, 0));
+	}
+	CHECK_STR(page_order(device), "111111222222333333");
+
+	// copies without replay draw the same
+	long replayed;
+	std::string calls = page_calls(pages, 3, true, 3, false, &replayed);
+	CHECK_EQ(replayed, 9L);
+	CHECK_STR(calls, page_calls(pages, 3, false, 3, false, 0));
+	calls = page_calls(pages, 1, true, 2, true, &replayed);
+	CHECK_EQ(replayed, 2L);
+	CHECK_STR(calls, page_calls(pages, 1, false, 2, true, 0));
+}
+
+static void test_cancel(){
+	PageBuilder p;
+	build_refont(p, "Ticket 1");
+	const Page *pages[] = { &p.page() };
+	std::atomic<bool> cancel(true);
+	RecordingDevice device(203, 203);
+	PageExecutor executor(&device);
+	executor.setCopies(3, true);
+	executor.setCancelFlag(&cancel);
+	CHECK(!executor.runJob(pages, 1, 0, 0));
+	CHECK(executor.canceled());
+	CHECK_EQ(device.count(CALL_ABORT_DOC), 1L);
+}
+
+int main(){
+	test_hash();
+	test_record();
+	test_duplicates();
+	test_copies();
+	test_cancel();
+	return test_summary("test-display-list");
+}
@@ -0,0 +1,182 @@
+#include "test-util.h"
+#include "test-fixtures.h"
+#include "escpos-device.h"
+#include <algorithm>
+#include <string.h>
+
+static std::string hex(const std::vector<uint8_t> &bytes){
+	std::string out;
+	char buf[4];
+	size_t i;
+	for(i=0;i<bytes.size();i++){
+		snprintf(buf, sizeof(buf), i > 0 ? " %02x" : "%02x", bytes[i]);
+		out += buf;
+	}
+	return out;
+}
+
+static bool contains(const std::vector<uint8_t> &bytes, const char *data, size_t length){
+	const uint8_t *begin = (const uint8_t *)data;
+	return std::search(bytes.begin(), bytes.end(), begin, begin + length) != bytes.end();
+}
+
+static void test_golden(){
+	EscPosDevice device((EscPosOptions()));
+	std::vector<uint16_t> text = u16("Hi");
+	CHECK(device.startDoc(NULL, 0));
+	CHECK(device.startPage());
+	CHECK(device.selectObject(device.createFont(NULL, 0, 24, 0, 0)));
+	CHECK(device.textOut(16, 8, &text[0], 2));
+	CHECK(device.moveTo(0, 40));
+	CHECK(device.lineTo(100, 40));
+	CHECK(device.endPage());
+	CHECK(device.endDoc());
+	CHECK_EQ(device.textBands(), (size_t)1);
+	CHECK_EQ(device.rasterBands(), (size_t)1);
+	// ESC @, GS P 203 203; ESC J 8 down to the text, ESC $ 16 "Hi" in font
+	// A; ESC J 32 prints it and feeds to row 40 (24 rows of text, 8 blank);
+	// the line as a 13 x 1 byte GS v 0 image of 101 dots; ESC J 1 past
+	// the band; GS V 66 0 cuts
+	CHECK_STR(hex(device.bytes()),
+		"1b 40 1d 50 cb cb "
+		"1b 4a 08 1b 24 10 00 48 69 "
+		"1b 4a 20 1d 76 30 00 0d 00 01 00 ff ff ff ff ff ff ff ff ff ff ff ff f8 "
+		"1b 4a 01 1d 56 42 00");
+}
+
+static void test_native_text(){
+	EscPosOptions opts;
+	opts.cut = ESCPOS_CUT_NONE;
+	EscPosDevice device(opts);
+	std::vector<uint16_t> abc = u16("abc");
+	static const int even[] = { 26, 26, 26 };
+	static const int rounded[] = { 14, 15, 14 };
+	static const int narrow[] = { 8, 8, 8 };
+	device.startDoc(NULL, 0);
+	device.startPage();
+	DeviceHandle big = device.createFont(NULL, 0, 48, FONT_WEIGHT_BOLD, 0);
+	DeviceHandle small = device.createFont(NULL, 0, 18, 0, 0);
+	DeviceHandle body = device.createFont(NULL, 0, 28, 0, 0);
+	device.selectObject(big);
+	// font A doubled (24 dots wide with the spacing), bold
+	device.textRun(0, 0, &abc[0], 3, even);
+	device.selectObject(small);
+	// font B: 17 dots high
+	device.textOut(0, 100, &abc[0], 3);
+	device.textOut(200, 100, &abc[0], 3);
+	device.endPage();
+	CHECK_EQ(device.textBands(), (size_t)1 + 1);
+	CHECK_EQ(device.rasterBands(), (size_t)0);
+	CHECK_STR(hex(device.bytes()),
+		"1b 40 1d 50 cb cb "
+		"1d 21 11 1b 45 01 1b 20 02 1b 24 00 00 61 62 63 "
+		"1b 4a 64 1b 4d 01 1d 21 00 1b 45 00 1b 20 00 1b 24 00 00 61 62 63 "
+		"1b 24 c8 00 61 62 63 1b 4a 11");
+
+	device.startDoc(NULL, 0);
+	device.startPage();
+	device.selectObject(body);
+	// positions rounded to 14 and 15 dots: font A at a 15 dot pitch (ESC SP
+	// 3), within a quarter character of each position
+	device.textRun(0, 0, &abc[0], 3, rounded);
+	// closer than font B is wide
+	device.textRun(0, 100, &abc[0], 3, narrow);
+	device.endPage();
+	CHECK_EQ(device.textBands(), (size_t)1);
+	CHECK_EQ(device.rasterBands(), (size_t)1);
+	CHECK(contains(device.bytes(), "\x1b\x20\x03\x1b\x24\x00\x00" "abc", 10));
+
+	// characters outside ASCII, and runs of different sizes on one band
+	static const uint16_t kana[] = { 'a', 0x3042 };
+	device.startDoc(NULL, 0);
+	device.startPage();
+	device.selectObject(body);
+	device.textOut(0, 0, kana, 2);
+	device.textOut(0, 100, &abc[0], 3);
+	device.selectObject(big);
+	device.textOut(100, 100, &abc[0], 3);
+	device.endPage();
+	CHECK_EQ(device.textBands(), (size_t)0);
+	CHECK_EQ(device.rasterBands(), (size_t)2);
+
+	opts.nativeText = false;
+	EscPosDevice raster(opts);
+	raster.startDoc(NULL, 0);
+	raster.startPage();
+	raster.selectObject(raster.createFont(NULL, 0, 24, 0, 0));
+	raster.textOut(0, 0, &abc[0], 3);
+	raster.endPage();
+	CHECK_EQ(raster.textBands(), (size_t)0);
+	CHECK_EQ(raster.rasterBands(), (size_t)1);
+}
+
+static void test_receipt(){
+	PageBuilder b;
+	fixture_receipt(b, 20);
+	const Page *pages[] = { &b.page(), &b.page() };
+	EscPosOptions opts;
+	std::vector<uint8_t> bytes, again;
+	std::string err;
+	CHECK(compile_escpos(pages, 2, opts, &bytes, &err));
+	CHECK(compile_escpos(pages, 2, opts, &again, &err));
+	CHECK(bytes == again);
+	// a 14.4 dot pitch is printed at 14 dots, placed again every few words
+	CHECK(contains(bytes, "Item 001", 8));
+	CHECK(contains(bytes, "hicken set", 10));
+	CHECK(contains(bytes, "TOTAL 1234.50", 13));
+	// the rules are raster images and each page ends with a cut
+	CHECK(contains(bytes, "\x1d\x76\x30\x00", 4));
+	size_t cuts = 0, i;
+	for(i=0;i+3<bytes.size();i++){
+		cuts += memcmp(&bytes[i], "\x1d\x56\x42\x00", 4) == 0;
+	}
+	CHECK_EQ(cuts, (size_t)2);
+	CHECK(bytes.size() < 3000);
+
+	opts.nativeText = false;
+	CHECK(compile_escpos(pages, 1, opts, &again, &err));
+	CHECK(!contains(again, "TOTAL", 5));
+	CHECK(again.size() > bytes.size());
+
+	opts.nativeText = true;
+	opts.cut = ESCPOS_CUT_FULL;
+	opts.height = 400;
+	CHECK(compile_escpos(pages, 1, opts, &again, &err));
+	CHECK_EQ(hex(std::vector<uint8_t>(again.end() - 4, again.end())), "1d 56 41 00");
+	// fed to 400 mm (3196 dots) in steps of 255
+	CHECK(contains(again, "\x1b\x4a\xff\x1b\x4a\xff", 6));
+
+	opts.width = 0;
+	CHECK(!compile_escpos(pages, 1, opts, &again, &err));
+	CHECK_STR(err, "invalid escpos options");
+}
+
+// The job goes to the printer (or a file) in one write.
+static void test_file_sink(){
+	PageBuilder b;
+	fixture_receipt(b, 5);
+	const Page *pages[] = { &b.page() };
+	std::vector<uint8_t> bytes, read;
+	std::string err;
+	CHECK(compile_escpos(pages, 1, EscPosOptions(), &bytes, &err));
+	FILE *file = tmpfile();
+	CHECK(file != NULL);
+	if( !file ){
+		return;
+	}
+	CHECK_EQ(fwrite(&bytes[0], 1, bytes.size(), file), bytes.size());
+	rewind(file);
+	read.resize(bytes.size() + 1);
+	CHECK_EQ(fread(&read[0], 1, read.size(), file), bytes.size());
+	read.resize(bytes.size());
+	CHECK(read == bytes);
+	fclose(file);
+}
+
+int main(){
+	test_golden();
+	test_native_text();
+	test_receipt();
+	test_file_sink();
+	return test_summary("test-escpos-device");
+}
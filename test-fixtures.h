@@ -0,0 +1,129 @@
+#ifndef DRAWER_TEST_FIXTURES_H
+#define DRAWER_TEST_FIXTURES_H
+
+// Realistic pages shared by the native tests and benchmarks.
+
+#include "page.h"
+#include <stdio.h>
+#include <string.h>
+
+static inline void fixture_text(PageBuilder &b, const char *ascii, double x, double y, double pitch){
+	uint16_t text[256];
+	double xs[256];
+	uint32_t i, n = (uint32_t)strlen(ascii);
+	if( n > 256 ){
+		n = 256;
+	}
+	for(i=0;i<n;i++){
+		text[i] = (uint16_t)(unsigned char)ascii[i];
+		xs[i] = x + i * pitch;
+	}
+	b.drawChars(text, n, b.addCoords(xs, n), b.scalar(y));
+}
+
+// 80mm receipt: header, `lines` item rows with prices, ruled separators and
+// a total line.
+static inline Page &fixture_receipt(PageBuilder &b, int lines){
+	char buf[64];
+	int i;
+	double y = 5;
+	b.clear();
+	b.createFont("title", "MS Gothic", 6, 1, 0);
+	b.createFont("body", "MS Gothic", 3.5, 0, 0);
+	b.createPen("rule", 0, 0, 0, 0.2);
+	b.setFont("title");
+	fixture_text(b, "RECEIPT", 25, y, 4);
+	y += 10;
+	b.setFont("body");
+	b.setPen("rule");
+	b.moveTo(2, y);
+	b.lineTo(78, y);
+	y += 2;
+	for(i=0;i<lines;i++){
+		sprintf(buf, "Item %03d  Grilled chicken set", i + 1);
+		fixture_text(b, buf, 3, y, 1.8);
+		sprintf(buf, "%d.%02d", 10 + i % 50, i % 100);
+		fixture_text(b, buf, 62, y, 1.8);
+		y += 4.5;
+	}
+	b.moveTo(2, y);
+	b.lineTo(78, y);
+	y += 2;
+	b.setFont("title");
+	b.setTextColor(0, 0, 0);
+	fixture_text(b, "TOTAL 1234.50", 20, y, 3.5);
+	return b.finish();
+}
+
+// A4 report: a table of `rows` rows with ruled grid lines.
+static inline Page &fixture_a4_table(PageBuilder &b, int rows){
+	char buf[96];
+	int i, j;
+	double top = 20, rowHeight = 6;
+	b.clear();
+	b.createFont("head", "MS Mincho", 5, 1, 0);
+	b.createFont("cell", "MS Mincho", 3.5, 0, 0);
+	b.createPen("grid", 0, 0, 0, 0.1);
+	b.setFont("head");
+	fixture_text(b, "Monthly sales report", 20, 10, 3);
+	b.setFont("cell");
+	b.setPen("grid");
+	for(i=0;i<=rows;i++){
+		b.moveTo(15, top + i * rowHeight);
+		b.lineTo(195, top + i * rowHeight);
+	}
+	for(j=0;j<4;j++){
+		b.moveTo(15 + j * 60, top);
+		b.lineTo(15 + j * 60, top + rows * rowHeight);
+	}
+	for(i=0;i<rows;i++){
+		sprintf(buf, "2016-%02d-%02d  branch %d", 1 + i % 12, 1 + i % 28, i % 7);
+		fixture_text(b, buf, 17, top + i * rowHeight + 1.5, 1.9);
+		sprintf(buf, "%8d", 1000 + i * 37);
+		fixture_text(b, buf, 140, top + i * rowHeight + 1.5, 1.9);
+	}
+	return b.finish();
+}
+
+// The receipt as a generic report generator writes it: fonts and the text
+// color are set before every text and created again for every line, and
+// the number, name and price of an item are separate texts on one baseline.
+static inline Page &fixture_generated(PageBuilder &b, int lines){
+	char buf[64];
+	int i;
+	double y = 5;
+	b.clear();
+	b.createFont("title", "MS Gothic", 6, 1, 0);
+	b.setFont("title");
+	b.setTextColor(0, 0, 0);
+	fixture_text(b, "RECEIPT", 25, y, 4);
+	y += 10;
+	for(i=0;i<lines;i++){
+		b.createFont("number", "MS Gothic", 3.5, 1, 0);
+		b.createFont("body", "MS Gothic", 3.5, 0, 0);
+		b.setFont("number");
+		b.setTextColor(0, 0, 0);
+		sprintf(buf, "%03d", i + 1);
+		fixture_text(b, buf, 3, y, 1.8);
+		b.setFont("body");
+		b.setTextColor(0, 0, 0);
+		fixture_text(b, "Grilled chicken set", 10, y, 1.8);
+		b.setFont("body");
+		b.setTextColor(0, 0, 0);
+		sprintf(buf, "%d.%02d", 10 + i % 50, i % 100);
+		fixture_text(b, buf, 62, y, 1.8);
+		if( i % 5 == 4 ){
+			b.createPen("rule", 0, 0, 0, 0.2);
+			b.setPen("rule");
+			b.moveTo(2, y + 3.5);
+			b.lineTo(78, y + 3.5);
+		}
+		y += 4.5;
+	}
+	b.setFont("title");
+	b.setTextColor(0, 0, 0);
+	fixture_text(b, "TOTAL 1234.50", 20, y, 3.5);
+	return b.finish();
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include "test-util.h"
+#include "glyph-run.h"
+#include "page-executor.h"
+#include <stdio.h>
+
+static std::string describe(const long *xs, const long *ys, uint32_t n){
+	std::vector<int> advances(n + 1, -999);
+	std::vector<GlyphRun> runs;
+	char buf[64];
+	std::string out;
+	size_t i;
+	uint32_t k;
+	build_glyph_runs(xs, ys, n, &advances[0], &runs);
+	for(i=0;i<runs.size();i++){
+		sprintf(buf, "%u+%u@%ld,%ld:", runs[i].start, runs[i].count, runs[i].x, runs[i].y);
+		out += buf;
+		for(k=runs[i].start;k<runs[i].start+runs[i].count;k++){
+			sprintf(buf, " %d", advances[k]);
+			out += buf;
+		}
+		out += "\n";
+	}
+	CHECK_EQ(advances[n], -999);
+	return out;
+}
+
+static void test_single_line(){
+	long xs[] = { 100, 130, 160, 200 };
+	long ys[] = { 50, 50, 50, 50 };
+	CHECK_STR(describe(xs, ys, 4), "0+4@100,50: 30 30 40 40\n");
+}
+
+static void test_split_on_y(){
+	long xs[] = { 100, 130, 100, 130, 160, 100 };
+	long ys[] = { 50, 50, 80, 80, 80, 110 };
+	CHECK_STR(describe(xs, ys, 6),
+		"0+2@100,50: 30 30\n"
+		"2+3@100,80: 30 30 30\n"
+		"5+1@100,110: 0\n");
+}
+
+static void test_no_split_on_x(){
+	// backwards and repeated x stay in the run (negative and zero advances)
+	long xs[] = { 100, 80, 80, 120 };
+	long ys[] = { 50, 50, 50, 50 };
+	CHECK_STR(describe(xs, ys, 4), "0+4@100,50: -20 0 40 40\n");
+}
+
+static void test_vertical_text(){
+	long xs[] = { 100, 100, 100 };
+	long ys[] = { 50, 80, 110 };
+	CHECK_STR(describe(xs, ys, 3),
+		"0+1@100,50: 0\n"
+		"1+1@100,80: 0\n"
+		"2+1@100,110: 0\n");
+}
+
+static void test_empty(){
+	long x = 0, y = 0;
+	CHECK_STR(describe(&x, &y, 0), "");
+}
+
+// The advances reproduce the positions of the per character TextOutW calls.
+static void test_matches_positions(){
+	static const double mm[] = { 10, 13.3, 16.6, 19.9, 23.2, 26.5, 29.8, 33.1 };
+	long xs[8], ys[8];
+	int advances[8];
+	std::vector<GlyphRun> runs;
+	int i;
+	for(i=0;i<8;i++){
+		xs[i] = mm_to_pixel(600, mm[i]);
+		ys[i] = mm_to_pixel(600, 12.7);
+	}
+	build_glyph_runs(xs, ys, 8, advances, &runs);
+	CHECK_EQ(runs.size(), (size_t)1);
+	long x = runs[0].x;
+	for(i=0;i<8;i++){
+		CHECK_EQ(x, xs[i]);
+		x += advances[i];
+	}
+}
+
+int main(){
+	test_single_line();
+	test_split_on_y();
+	test_no_split_on_x();
+	test_vertical_text();
+	test_empty();
+	test_matches_positions();
+	return test_summary("test-glyph-run");
+}
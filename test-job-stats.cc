@@ -0,0 +1,202 @@
+#include "test-util.h"
+#include "test-fixtures.h"
+#include "job-stats.h"
+#include "page-executor.h"
+#include "print-job.h"
+#include "recording-device.h"
+#include <chrono>
+#include <thread>
+
+static void test_histogram(){
+	LatencyHistogram h;
+	int64_t i;
+	CHECK_EQ(h.count(), (uint64_t)0);
+	CHECK_EQ(h.percentile(50), (int64_t)0);
+	for(i=0;i<100;i++){
+		h.record(i);
+	}
+	// exact below 128
+	CHECK_EQ(h.percentile(50), (int64_t)49);
+	CHECK_EQ(h.percentile(100), (int64_t)99);
+	CHECK_EQ(h.min(), (int64_t)0);
+	CHECK_EQ(h.max(), (int64_t)99);
+	CHECK(h.mean() == 49.5);
+
+	h.clear();
+	for(i=1;i<=100000;i++){
+		h.record(i);
+	}
+	CHECK_EQ(h.count(), (uint64_t)100000);
+	int64_t p50 = h.percentile(50), p99 = h.percentile(99), p999 = h.percentile(99.9);
+	// within 1/64 above the exact value
+	CHECK(p50 >= 50000 && p50 <= 50000 + 50000 / 64);
+	CHECK(p99 >= 99000 && p99 <= 99000 + 99000 / 64);
+	CHECK(p999 >= 99900 && p999 <= 100000);
+	CHECK_EQ(h.percentile(100), (int64_t)100000);
+
+	LatencyHistogram slow;
+	slow.record(5000000);
+	slow.record(-3);
+	slow.record((int64_t)1 << 50);
+	h.merge(slow);
+	CHECK_EQ(h.count(), (uint64_t)100003);
+	CHECK_EQ(h.min(), (int64_t)0);
+	CHECK_EQ(h.max(), ((int64_t)1 << 38) - 1);
+	CHECK(slow.percentile(50) >= 5000000 && slow.percentile(50) <= 5000000 + 5000000 / 64);
+}
+
+static void test_stats_device(){
+	PageBuilder b;
+	fixture_receipt(b, 10);
+	const Page *pages[] = { &b.page(), &b.page() };
+	RecordingDevice device(600, 600);
+	JobStats stats;
+	{
+		StatsDevice statsDevice(&device, &stats);
+		PageExecutor executor(&statsDevice);
+		CHECK(executor.runJob(pages, 2, NULL, 0));
+	}
+	CHECK_EQ(stats.gdiCalls, device.totalCount());
+	CHECK_EQ(stats.textRuns, device.count(CALL_TEXT_RUN) + device.count(CALL_TEXT_OUT));
+	CHECK_EQ(stats.pages, 2L);
+	CHECK(stats.objectsCreated > 0);
+	CHECK_EQ(stats.objectsCreated, stats.objectsDeleted);
+	CHECK_EQ(stats.phases[PHASE_OPEN], (int64_t)-1);
+	CHECK(stats.phases[PHASE_START_DOC] >= 0);
+	CHECK(stats.phases[PHASE_RENDER] >= 0);
+	CHECK(stats.phases[PHASE_END_PAGE] >= 0);
+	CHECK(stats.phases[PHASE_END_DOC] >= 0);
+	// startDoc, render, endPage, render, endPage, (render,) endDoc
+	size_t i, endPages = 0;
+	for(i=0;i<stats.events.size();i++){
+		endPages += stats.events[i].phase == PHASE_END_PAGE;
+	}
+	CHECK_EQ(endPages, (size_t)2);
+	CHECK_EQ(stats.events.front().phase, (int)PHASE_START_DOC);
+	CHECK_EQ(stats.events[1].phase, (int)PHASE_RENDER);
+	CHECK_EQ(stats.events.back().phase, (int)PHASE_END_DOC);
+	CHECK(stats.events[1].start >= stats.events[0].start + stats.events[0].duration);
+}
+
+// Printer whose driver takes 20 ms per EndPage.
+class SlowDevice : public RecordingDevice {
+public:
+	SlowDevice() : RecordingDevice(600, 600) {}
+	bool endPage(){
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		return RecordingDevice::endPage();
+	}
+};
+
+class SlowSource : public DeviceSource {
+public:
+	explicit SlowSource(SlowDevice *device) : device_(device) {}
+	Device *open(std::string *err){
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		return device_;
+	}
+	void close(Device *device, bool failed){}
+
+private:
+	SlowDevice *device_;
+};
+
+static void test_print_job(){
+	SlowDevice device;
+	PrintJob job(new SlowSource(&device));
+	fixture_receipt(job.addPage(), 3);
+	fixture_receipt(job.addPage(), 3);
+	CHECK(job.stats() == NULL);
+	job.enableStats("TM-T88", 7);
+	job.run();
+	const JobStats *stats = job.stats();
+	CHECK(stats != NULL);
+	if( !stats ){
+		return;
+	}
+	CHECK_STR(stats->printer, "TM-T88");
+	CHECK_EQ(stats->jobId, 7L);
+	CHECK_STR(stats->status, "done");
+	CHECK_EQ(stats->ops, job.opCount());
+	CHECK_EQ(stats->pages, 2L);
+	CHECK(stats->phases[PHASE_OPEN] >= 10000);
+	CHECK(stats->phases[PHASE_END_PAGE] >= 40000);
+	CHECK(stats->phases[PHASE_CLOSE] >= 0);
+	CHECK(stats->phases[PHASE_TOTAL] >= stats->phases[PHASE_OPEN] + stats->phases[PHASE_END_PAGE]);
+	CHECK(stats->phases[PHASE_TOTAL] <= (int64_t)(job.elapsed() * 1e6) + 1000);
+
+	// a job canceled before it starts still reports
+	PrintJob canceled(new SlowSource(&device));
+	canceled.enableStats("TM-T88", 8);
+	canceled.cancel();
+	canceled.run();
+	CHECK_STR(canceled.stats()->status, "canceled");
+	CHECK_EQ(canceled.stats()->phases[PHASE_OPEN], (int64_t)-1);
+}
+
+static JobStats make_job(const char *printer, long jobId, int64_t endPage, const char *status){
+	JobStats job;
+	job.printer = printer;
+	job.jobId = jobId;
+	job.begin(1000);
+	job.add(PHASE_START_DOC, 1000, 1100);
+	job.add(PHASE_END_PAGE, 1100, 1100 + endPage);
+	job.pages = 1;
+	job.gdiCalls = 10;
+	job.imageBytes = 100;
+	job.end = 1100 + endPage;
+	job.status = status;
+	job.phases[PHASE_TOTAL] = job.end - job.start;
+	return job;
+}
+
+static void test_registry(){
+	JobStatsRegistry registry(3);
+	long i;
+	CHECK(!registry.enabled());
+	registry.setEnabled(true);
+	CHECK(registry.enabled());
+	for(i=1;i<=100;i++){
+		registry.add(make_job("kitchen", i, i * 1000, i % 10 ? "done" : "error"));
+	}
+	registry.add(make_job("bar \"2\"", 101, 500, "done"));
+	std::vector<PrinterStats> printers = registry.printers();
+	CHECK_EQ(printers.size(), (size_t)2);
+	if( printers.size() != 2 ){
+		return;
+	}
+	const PrinterStats &bar = printers[0], &kitchen = printers[1];
+	CHECK_STR(kitchen.name, "kitchen");
+	CHECK_EQ(kitchen.jobs, 100L);
+	CHECK_EQ(kitchen.failed, 10L);
+	CHECK_EQ(kitchen.pages, 100L);
+	CHECK_EQ(kitchen.gdiCalls, 1000L);
+	CHECK_EQ(kitchen.imageBytes, (uint64_t)10000);
+	CHECK_EQ(kitchen.phases[PHASE_END_PAGE].count(), (uint64_t)100);
+	CHECK_EQ(kitchen.phases[PHASE_OPEN].count(), (uint64_t)0);
+	int64_t p90 = kitchen.phases[PHASE_END_PAGE].percentile(90);
+	CHECK(p90 >= 90000 && p90 <= 90000 + 90000 / 64);
+	CHECK_EQ(bar.phases[PHASE_END_PAGE].max(), (int64_t)500);
+
+	// the last 3 jobs, one row each, names escaped
+	std::string trace = registry.traceJson();
+	CHECK(trace.find("\"traceEvents\"") != std::string::npos);
+	CHECK(trace.find("kitchen job 98") == std::string::npos);
+	CHECK(trace.find("kitchen job 99") != std::string::npos);
+	CHECK(trace.find("bar \\\"2\\\" job 101") != std::string::npos);
+	CHECK(trace.find("{\"name\":\"endPage\",\"ph\":\"X\",\"pid\":1,\"tid\":3,\"ts\":1100,\"dur\":500}")
+		!= std::string::npos);
+	CHECK(trace.find("\"status\":\"error\"") != std::string::npos);
+
+	registry.clear();
+	CHECK(registry.printers().empty());
+	CHECK_STR(registry.traceJson(), "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[]}");
+}
+
+int main(){
+	test_histogram();
+	test_stats_device();
+	test_print_job();
+	test_registry();
+	return test_summary("test-job-stats");
+}
@@ -0,0 +1,207 @@
+#include "test-util.h"
+#include "mono-image.h"
+#include <string.h>
+
+static uint32_t seed = 12345;
+
+static uint8_t next_byte(){
+	seed = seed * 1103515245 + 12345;
+	return (uint8_t)(seed >> 16);
+}
+
+static void put_u16(std::vector<uint8_t> &out, size_t pos, uint32_t value){
+	out[pos] = (uint8_t)value;
+	out[pos + 1] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(std::vector<uint8_t> &out, size_t pos, uint32_t value){
+	put_u16(out, pos, value & 0xffff);
+	put_u16(out, pos + 2, value >> 16);
+}
+
+// 24 bpp BMP, every pixel of the given color
+static std::vector<uint8_t> make_bmp24(int width, int height, int r, int g, int b){
+	uint32_t stride = (width * 3 + 3) & ~3;
+	uint32_t offset = 14 + 40;
+	std::vector<uint8_t> out(offset + stride * height, 0);
+	int x, y;
+	out[0] = 'B';
+	out[1] = 'M';
+	put_u32(out, 2, (uint32_t)out.size());
+	put_u32(out, 10, offset);
+	put_u32(out, 14, 40);
+	put_u32(out, 18, width);
+	put_u32(out, 22, height);
+	put_u16(out, 26, 1);
+	put_u16(out, 28, 24);
+	put_u32(out, 38, 23622);
+	put_u32(out, 42, 23622);
+	for(y=0;y<height;y++){
+		for(x=0;x<width;x++){
+			uint8_t *p = &out[offset + y * stride + x * 3];
+			p[0] = (uint8_t)b;
+			p[1] = (uint8_t)g;
+			p[2] = (uint8_t)r;
+		}
+	}
+	return out;
+}
+
+static int count_white(const BmpImage &image){
+	uint32_t x, y;
+	int count = 0;
+	for(y=0;y<image.height;y++){
+		const uint8_t *row = image.pixels + y * image.stride;
+		for(x=0;x<image.width;x++){
+			count += (row[x >> 3] >> (7 - (x & 7))) & 1;
+		}
+	}
+	return count;
+}
+
+// Every kernel level the CPU has must match the scalar one, on lengths that
+// leave tails of every size.
+static void test_kernels_match_scalar(){
+	int best = mono_set_kernel_level(MONO_AVX2);
+	int level;
+	uint32_t n, bpp, i;
+	printf("kernels: best %s\n", mono_kernel_name(best));
+	for(n=0;n<100;n++){
+		std::vector<uint8_t> bgr(n * 4 + 1), gray(n + 1), thresholds(8);
+		for(i=0;i<bgr.size();i++){
+			bgr[i] = next_byte();
+		}
+		for(i=0;i<8;i++){
+			thresholds[i] = next_byte();
+		}
+		for(bpp=3;bpp<=4;bpp++){
+			std::vector<uint8_t> expectGray(n + 1), expectBits(n / 8 + 1);
+			mono_set_kernel_level(MONO_SCALAR);
+			mono_luma(&bgr[0], bpp, n, &expectGray[0]);
+			mono_pack(&bgr[0], n, &thresholds[0], &expectBits[0]);
+			for(level=MONO_SSE2;level<=best;level++){
+				std::vector<uint8_t> bits(n / 8 + 1);
+				gray.assign(n + 1, 0);
+				mono_set_kernel_level(level);
+				mono_luma(&bgr[0], bpp, n, &gray[0]);
+				mono_pack(&bgr[0], n, &thresholds[0], &bits[0]);
+				CHECK(memcmp(&gray[0], &expectGray[0], n) == 0);
+				CHECK(memcmp(&bits[0], &expectBits[0], (n + 7) / 8) == 0);
+			}
+		}
+	}
+	mono_set_kernel_level(best);
+}
+
+static void test_luma(){
+	static const uint8_t pixels[] = { 0, 0, 0, 255, 255, 255, 0, 0, 255, 0, 255, 0, 255, 0, 0 };
+	uint8_t gray[5];
+	mono_luma(pixels, 3, 5, gray);
+	CHECK_EQ(gray[0], 0);
+	CHECK_EQ(gray[1], 255);
+	CHECK_EQ(gray[2], 77);
+	CHECK_EQ(gray[3], 149);
+	CHECK_EQ(gray[4], 29);
+}
+
+static void test_pack(){
+	static const uint8_t gray[] = { 200, 0, 200, 0, 129, 128, 255, 255, 255, 0 };
+	uint8_t thresholds[8], bits[2];
+	memset(thresholds, 128, 8);
+	mono_pack(gray, 10, thresholds, bits);
+	CHECK_EQ(bits[0], 0xab);
+	CHECK_EQ(bits[1], 0x80);
+}
+
+static void test_bayer(){
+	uint8_t thresholds[8];
+	int sum = 0, x, y;
+	for(y=0;y<8;y++){
+		mono_bayer_row(y, thresholds);
+		for(x=0;x<8;x++){
+			sum += thresholds[x];
+		}
+	}
+	// 4 * (0 + ... + 63) + 2 * 64
+	CHECK_EQ(sum, 8192);
+	mono_bayer_row(8, thresholds);
+	CHECK_EQ(thresholds[0], 2);
+}
+
+// Error diffusion keeps the average gray level.
+static void test_diffuse(){
+	uint32_t n = 64, y, x;
+	std::vector<uint8_t> gray(n, 64), bits(n / 8);
+	std::vector<int16_t> errors(2 * (n + 2), 0);
+	int white = 0;
+	for(y=0;y<64;y++){
+		mono_diffuse_row(&gray[0], n, y, 128, &errors[0], &bits[0]);
+		for(x=0;x<n;x++){
+			white += (bits[x >> 3] >> (7 - (x & 7))) & 1;
+		}
+	}
+	CHECK(white > 64 * 64 / 4 - 64 && white < 64 * 64 / 4 + 64);
+}
+
+static void test_levels(){
+	uint8_t table[256];
+	mono_levels_table(1.0, 0, table);
+	CHECK_EQ(table[0], 0);
+	CHECK_EQ(table[77], 77);
+	mono_levels_table(2.0, 10, table);
+	CHECK_EQ(table[128], 138);
+	CHECK_EQ(table[0], 0);
+	CHECK_EQ(table[200], 255);
+}
+
+static void test_bmp_to_mono(){
+	std::vector<uint8_t> bmp = make_bmp24(37, 9, 128, 128, 128), out;
+	BmpImage image, mono;
+	MonoOptions opts;
+	std::string err;
+	CHECK(parse_bmp(&bmp[0], bmp.size(), &image, &err));
+	opts.dither = MONO_DITHER_BAYER;
+	CHECK(bmp_to_mono(image, opts, &out, &err));
+	CHECK(parse_bmp(&out[0], out.size(), &mono, &err));
+	CHECK_EQ(mono.width, 37u);
+	CHECK_EQ(mono.height, 9u);
+	CHECK_EQ(mono.bitsPerPixel, 1u);
+	CHECK_EQ(mono.stride, 8u);
+	CHECK_EQ(out[38], bmp[38]);
+	// half the matrix thresholds are below 128
+	int white = count_white(mono);
+	CHECK(white > 37 * 9 / 2 - 20 && white < 37 * 9 / 2 + 20);
+
+	opts.dither = MONO_DITHER_NONE;
+	opts.threshold = 127;
+	CHECK(bmp_to_mono(image, opts, &out, &err));
+	CHECK(parse_bmp(&out[0], out.size(), &mono, &err));
+	CHECK_EQ(count_white(mono), 37 * 9);
+	opts.threshold = 128;
+	CHECK(bmp_to_mono(image, opts, &out, &err));
+	CHECK(parse_bmp(&out[0], out.size(), &mono, &err));
+	CHECK_EQ(count_white(mono), 0);
+	opts.brightness = 1;
+	CHECK(bmp_to_mono(image, opts, &out, &err));
+	CHECK(parse_bmp(&out[0], out.size(), &mono, &err));
+	CHECK_EQ(count_white(mono), 37 * 9);
+
+	// the 1 bpp output converts again (palette input)
+	BmpImage again;
+	std::vector<uint8_t> out2;
+	opts = MonoOptions();
+	CHECK(bmp_to_mono(mono, opts, &out2, &err));
+	CHECK(parse_bmp(&out2[0], out2.size(), &again, &err));
+	CHECK_EQ(count_white(again), 37 * 9);
+}
+
+int main(){
+	test_kernels_match_scalar();
+	test_luma();
+	test_pack();
+	test_bayer();
+	test_diffuse();
+	test_levels();
+	test_bmp_to_mono();
+	return test_summary("test-mono-image");
+}
@@ -0,0 +1,204 @@
+#include "test-util.h"
+#include "object-cache.h"
+#include <thread>
+
+// Hands out increasing handles and logs creations and deletions.
+class FakeFactory : public ObjectFactory {
+public:
+	FakeFactory(){ next_ = 1; live_ = 0; }
+
+	DeviceHandle createFont(const uint16_t *face, uint32_t faceLength,
+			long height, long weight, long italic){
+		char buf[64];
+		sprintf(buf, " %ld %ld %ld => %d\n", height, weight, italic, next_);
+		log_ += "createFont ";
+		log_.append(face, face + faceLength);
+		log_ += buf;
+		live_ += 1;
+		return next_++;
+	}
+
+	DeviceHandle createPen(int style, long width, int r, int g, int b){
+		char buf[64];
+		sprintf(buf, "createPen %d %ld %d %d %d => %d\n", style, width, r, g, b, next_);
+		log_ += buf;
+		live_ += 1;
+		return next_++;
+	}
+
+	bool deleteObject(DeviceHandle handle){
+		char buf[64];
+		sprintf(buf, "deleteObject %d\n", (int)handle);
+		log_ += buf;
+		live_ -= 1;
+		return true;
+	}
+
+	std::string takeLog(){
+		std::string log = log_;
+		log_.clear();
+		return log;
+	}
+
+	int live() const { return live_; }
+
+private:
+	int next_;
+	int live_;
+	std::string log_;
+};
+
+static DeviceHandle font(ObjectCache &cache, const char *face, long height,
+		long weight = 0, long italic = 0){
+	std::vector<uint16_t> name = u16(face);
+	return cache.acquireFont(&name[0], (uint32_t)name.size(), height, weight, italic);
+}
+
+static void test_keying(){
+	FakeFactory factory;
+	ObjectCache cache(&factory, 16);
+	DeviceHandle a = font(cache, "MS Mincho", 141);
+	CHECK_EQ(font(cache, "MS Mincho", 141), a);
+	CHECK(font(cache, "MS Mincho", 142) != a);
+	CHECK(font(cache, "MS Gothic", 141) != a);
+	CHECK(font(cache, "MS Mincho", 141, FONT_WEIGHT_BOLD) != a);
+	CHECK(font(cache, "MS Mincho", 141, 0, 1) != a);
+	DeviceHandle p = cache.acquirePen(PEN_STYLE_SOLID, 23, 0, 0, 255);
+	CHECK_EQ(cache.acquirePen(PEN_STYLE_SOLID, 23, 0, 0, 255), p);
+	CHECK(cache.acquirePen(PEN_STYLE_SOLID, 24, 0, 0, 255) != p);
+	CHECK(cache.acquirePen(PEN_STYLE_SOLID, 23, 0, 1, 255) != p);
+	CHECK(cache.acquirePen(2, 23, 0, 0, 255) != p);
+	CHECK_STR(factory.takeLog(),
+		"createFont MS Mincho 141 0 0 => 1\n"
+		"createFont MS Mincho 142 0 0 => 2\n"
+		"createFont MS Gothic 141 0 0 => 3\n"
+		"createFont MS Mincho 141 700 0 => 4\n"
+		"createFont MS Mincho 141 0 1 => 5\n"
+		"createPen 0 23 0 0 255 => 6\n"
+		"createPen 0 24 0 0 255 => 7\n"
+		"createPen 0 23 0 1 255 => 8\n"
+		"createPen 2 23 0 0 255 => 9\n");
+	ObjectCacheStats stats = cache.stats();
+	CHECK_EQ(stats.hits, 2);
+	CHECK_EQ(stats.misses, 9);
+	CHECK_EQ(stats.size, 9);
+	CHECK_EQ(stats.inUse, 9);
+	// a font and a pen with the same numbers are different objects
+	CHECK(font_cache_key(NULL, 0, 23, 0, 0) != pen_cache_key(0, 23, 0, 0, 0));
+}
+
+static void test_refcount(){
+	FakeFactory factory;
+	ObjectCache cache(&factory, 0);
+	DeviceHandle a = font(cache, "Arial", 10);
+	CHECK_EQ(font(cache, "Arial", 10), a);
+	CHECK(cache.release(a));
+	CHECK(cache.contains(a));
+	CHECK_EQ(cache.stats().inUse, 1);
+	CHECK(cache.release(a));
+	// capacity 0: deleted as soon as nobody uses it
+	CHECK(!cache.contains(a));
+	CHECK(!cache.release(a));
+	CHECK(!cache.release(12345));
+	CHECK_EQ(cache.stats().evictions, 1);
+	CHECK_EQ(factory.live(), 0);
+}
+
+static void test_lru_eviction(){
+	FakeFactory factory;
+	ObjectCache cache(&factory, 2);
+	DeviceHandle a = font(cache, "A", 1);
+	DeviceHandle b = font(cache, "B", 1);
+	DeviceHandle c = font(cache, "C", 1);
+	// all in use: the cache grows past its capacity
+	CHECK_EQ(cache.stats().size, 3);
+	CHECK(cache.release(a));
+	CHECK(cache.release(b));
+	CHECK(cache.release(c));
+	// a was the least recently used
+	CHECK(!cache.contains(a));
+	CHECK(cache.contains(b));
+	CHECK(cache.contains(c));
+	// touching b makes c the oldest
+	CHECK_EQ(font(cache, "B", 1), b);
+	CHECK(cache.release(b));
+	DeviceHandle d = font(cache, "D", 1);
+	CHECK(!cache.contains(c));
+	CHECK(cache.contains(b));
+	CHECK(cache.release(d));
+	factory.takeLog();
+	// a comes back as a new object
+	CHECK(font(cache, "A", 1) != a);
+	CHECK_STR(factory.takeLog(),
+		"createFont A 1 0 0 => 5\n"
+		"deleteObject 2\n");
+	ObjectCacheStats stats = cache.stats();
+	CHECK_EQ(stats.hits, 1);
+	CHECK_EQ(stats.misses, 5);
+	CHECK_EQ(stats.evictions, 3);
+	CHECK_EQ(stats.capacity, 2);
+}
+
+static void test_capacity_and_purge(){
+	FakeFactory factory;
+	ObjectCache cache(&factory, 8);
+	int i;
+	DeviceHandle held = cache.acquirePen(PEN_STYLE_SOLID, 1, 0, 0, 0);
+	for(i=0;i<6;i++){
+		CHECK(cache.release(cache.acquirePen(PEN_STYLE_SOLID, 2 + i, 0, 0, 0)));
+	}
+	CHECK_EQ(cache.stats().size, 7);
+	cache.setCapacity(3);
+	CHECK_EQ(cache.stats().size, 3);
+	CHECK(cache.contains(held));
+	cache.purge();
+	CHECK_EQ(cache.stats().size, 1);
+	CHECK(cache.contains(held));
+	cache.resetStats();
+	CHECK_EQ(cache.stats().evictions, 0);
+	CHECK_EQ(cache.stats().size, 1);
+}
+
+static void test_destroy(){
+	FakeFactory factory;
+	{
+		ObjectCache cache(&factory, 8);
+		font(cache, "A", 1);
+		cache.release(font(cache, "B", 1));
+	}
+	CHECK_EQ(factory.live(), 0);
+}
+
+static void test_threads(){
+	FakeFactory factory;
+	ObjectCache cache(&factory, 4);
+	std::vector<std::thread> threads;
+	int t;
+	for(t=0;t<4;t++){
+		threads.push_back(std::thread([&cache](){
+			int i;
+			for(i=0;i<1000;i++){
+				DeviceHandle h = cache.acquirePen(PEN_STYLE_SOLID, i % 8, 0, 0, 0);
+				cache.release(h);
+			}
+		}));
+	}
+	for(t=0;t<4;t++){
+		threads[t].join();
+	}
+	ObjectCacheStats stats = cache.stats();
+	CHECK_EQ(stats.hits + stats.misses, 4000);
+	CHECK_EQ(stats.inUse, 0);
+	CHECK(stats.size <= 4);
+	CHECK_EQ(factory.live(), stats.size);
+}
+
+int main(){
+	test_keying();
+	test_refcount();
+	test_lru_eviction();
+	test_capacity_and_purge();
+	test_destroy();
+	test_threads();
+	return test_summary("test-object-cache");
+}
@@ -0,0 +1,148 @@
+#include "test-util.h"
+#include "page.h"
+#include "page-executor.h"
+#include "recording-device.h"
+#include <math.h>
+
+// The page of test-print.js.
+static void build_sample(PageBuilder &b){
+	static const uint16_t hello[] = { 0x3053, 0x3093, 0x306b, 0x3061, 0x306f, 0x4e16, 0x754c };
+	static const double xs[] = { 10, 16, 22, 28, 34, 40, 46 };
+	b.moveTo(10, 10);
+	b.lineTo(40, 20);
+	b.createFont("mincho6", "MS Mincho", 6, 0, 0);
+	b.setFont("mincho6");
+	b.drawChars(hello, 7, b.addCoords(xs, 7), b.scalar(30));
+	b.setTextColor(0, 244, 0);
+	b.createPen("blue", 0, 0, 255, 1);
+	b.setPen("blue");
+	b.moveTo(10, 20);
+	b.lineTo(40, 10);
+	b.finish();
+}
+
+static void test_mm_to_pixel(){
+	CHECK_EQ(mm_to_pixel(600, 10), 236);
+	CHECK_EQ(mm_to_pixel(600, 25.4), 600);
+	CHECK_EQ(mm_to_pixel(300, 0), 0);
+	CHECK_EQ(mm_to_pixel(600, -1), -24);
+}
+
+static void test_sample_page(){
+	PageBuilder b;
+	build_sample(b);
+	RecordingDevice device(600, 600);
+	{
+		PageExecutor executor(&device);
+		CHECK(executor.runPage(b.page()));
+		CHECK_EQ(executor.opCount(), 10);
+	}
+	CHECK_STR(device.dump(),
+		"setBkTransparent\n"
+		"startPage\n"
+		"polyPolyline [236 236 944 472]\n"
+		"createFont MS Mincho 141 0 0 => 1\n"
+		"selectObject 1\n"
+		"textRun 236 708 \xe3\x81\x93\xe3\x82\x93\xe3\x81\xab\xe3\x81\xa1"
+			"\xe3\x81\xaf\xe4\xb8\x96\xe7\x95\x8c [141 142 142 142 141 142 142]\n"
+		"setTextColor 0 244 0\n"
+		"createPen 23 0 0 255 => 2\n"
+		"selectObject 2\n"
+		"polyPolyline [236 472 944 236]\n"
+		"endPage\n"
+		"deleteObject 1\n"
+		"deleteObject 2\n");
+	CHECK_EQ(device.liveObjects(), 0);
+}
+
+static void test_offset(){
+	PageBuilder b;
+	b.moveTo(0, 0);
+	b.finish();
+	RecordingDevice device(300, 600);
+	PageExecutor executor(&device);
+	executor.setOffset(25.4, 2.54);
+	CHECK(executor.runOps(b.page()));
+	CHECK_EQ(device.calls().back().x, 300);
+	CHECK_EQ(device.calls().back().y, 60);
+}
+
+static void test_recreate_font(){
+	PageBuilder b;
+	b.createFont("f", "Arial", 3, 1, 1);
+	b.createFont("f", "Arial", 4, 0, 0);
+	b.setFont("f");
+	b.finish();
+	RecordingDevice device(600, 600);
+	PageExecutor executor(&device);
+	CHECK(executor.runOps(b.page()));
+	CHECK_EQ(device.calls()[1].weight, FONT_WEIGHT_BOLD);
+	CHECK_EQ(device.calls()[1].italic, 1);
+	CHECK_EQ(device.calls()[3].kind, CALL_DELETE_OBJECT);
+	CHECK_EQ(device.calls()[3].handle, (DeviceHandle)1);
+	CHECK_EQ(device.calls()[4].handle, (DeviceHandle)2);
+	executor.dispose();
+	CHECK_EQ(device.liveObjects(), 0);
+}
+
+static void test_errors(){
+	PageBuilder b;
+	RecordingDevice device(600, 600);
+	{
+		b.setFont("missing");
+		b.finish();
+		PageExecutor executor(&device);
+		CHECK(!executor.runOps(b.page()));
+		CHECK_STR(executor.error(), "unknown font: missing");
+	}
+	{
+		b.clear();
+		b.moveTo(NAN, 0);
+		b.finish();
+		PageExecutor executor(&device);
+		CHECK(!executor.runOps(b.page()));
+		CHECK_STR(executor.error(), "invalid number to move_to");
+	}
+	{
+		static const double xs[] = { 1, 2 };
+		std::vector<uint16_t> abc = u16("abc");
+		b.clear();
+		b.drawChars(&abc[0], 3, b.addCoords(xs, 2), b.scalar(0));
+		b.finish();
+		PageExecutor executor(&device);
+		CHECK(!executor.runOps(b.page()));
+	}
+	{
+		b.clear();
+		b.addOp(99);
+		b.finish();
+		PageExecutor executor(&device);
+		CHECK(executor.runOps(b.page()));
+		CHECK_EQ(executor.skippedOps(), 1);
+	}
+}
+
+static void test_job_abort(){
+	PageBuilder b;
+	b.lineTo(1, 1);
+	b.finish();
+	const Page *pages[] = { &b.page(), &b.page() };
+	std::vector<uint16_t> name = u16("job");
+	RecordingDevice device(600, 600);
+	device.failOn(CALL_LINE_TO);
+	PageExecutor executor(&device);
+	CHECK(!executor.runJob(pages, 2, &name[0], (uint32_t)name.size()));
+	CHECK_EQ(device.count(CALL_ABORT_DOC), 1);
+	CHECK_EQ(device.count(CALL_END_DOC), 0);
+	CHECK_EQ(device.count(CALL_START_PAGE), 1);
+}
+
+int main(){
+	test_mm_to_pixel();
+	test_sample_page();
+	test_offset();
+	test_recreate_font();
+	test_errors();
+	test_job_abort();
+	return test_summary("test-page-executor");
+}
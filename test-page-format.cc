@@ -0,0 +1,266 @@
+#include "test-util.h"
+#include "page-format.h"
+#include "page-executor.h"
+#include "recording-device.h"
+#include <stdlib.h>
+#include <string.h>
+
+// test-page-format [FILE]
+//
+// Without arguments runs the decoder tests. With FILE decodes it and prints
+// the pages as JSON ops; test-page-format.js uses that for the round trip
+// with the JS encoder.
+
+static void put_u16(std::string &s, uint16_t v){
+	s += (char)(v & 0xff);
+	s += (char)(v >> 8);
+}
+
+static void put_u32(std::string &s, uint32_t v){
+	put_u16(s, (uint16_t)(v & 0xffff));
+	put_u16(s, (uint16_t)(v >> 16));
+}
+
+static void put_f32(std::string &s, float v){
+	uint32_t bits;
+	memcpy(&bits, &v, sizeof(bits));
+	put_u32(s, bits);
+}
+
+// One page: create_font "f" MS Mincho 6mm, set_font "f",
+// draw_chars "ab" [10, 12.5] 30, line_to 25.4 2.54
+static std::string sample_buffer(){
+	std::string s = "DRWP";
+	put_u16(s, 1);
+	put_u16(s, 0);
+	put_u32(s, 1);     // pages
+	put_u32(s, 2);     // strings
+	put_u32(s, 1);     // fonts
+	put_u32(s, 12);    // text units: "f" "MS Mincho" "ab"
+	put_u32(s, 2);     // coords
+	put_u32(s, 39);    // op bytes
+	put_u32(s, 0);
+	put_u32(s, 0);
+	put_u32(s, 0);     // page 0
+	put_u32(s, 4);
+	put_u32(s, 0);     // string 0 "f"
+	put_u32(s, 1);
+	put_u32(s, 1);     // string 1 "MS Mincho"
+	put_u32(s, 9);
+	put_u16(s, 1);     // font 0
+	s += (char)1;
+	s += (char)0;
+	put_f32(s, 6);
+	const char *text = "fMS Minchoab";
+	while( *text ){
+		put_u16(s, (uint16_t)*text++);
+	}
+	put_f32(s, 10);
+	put_f32(s, 12.5f);
+	s += (char)OP_CREATE_FONT;
+	put_u16(s, 0);
+	put_u16(s, 0);
+	s += (char)OP_SET_FONT;
+	put_u16(s, 0);
+	s += (char)OP_DRAW_CHARS;
+	s += (char)1;
+	put_u32(s, 10);
+	put_u32(s, 2);
+	put_u32(s, 0);
+	put_u32(s, 2);
+	put_f32(s, 30);
+	s += (char)OP_LINE_TO;
+	put_f32(s, 25.4f);
+	put_f32(s, 2.54f);
+	return s;
+}
+
+static std::string run(const EncodedJob &job){
+	RecordingDevice device(600, 600);
+	PageExecutor executor(&device);
+	executor.runOps(job.pages[0]);
+	return device.dump();
+}
+
+static void test_decode(){
+	std::string buf = sample_buffer();
+	std::vector<uint32_t> aligned((buf.size() + 3) / 4);
+	memcpy(&aligned[0], buf.data(), buf.size());
+	EncodedJob job;
+	std::string err;
+	CHECK(decode_pages((const char *)&aligned[0], buf.size(), &job, &err));
+	CHECK_EQ(job.pages.size(), (size_t)1);
+	CHECK_EQ(job.pages[0].ops.size(), (size_t)4);
+	CHECK(job.storage.empty());
+	CHECK((const char *)job.pages[0].text > (const char *)&aligned[0]);
+	CHECK_EQ(job.pages[0].ops[0].weight, 1);
+	CHECK_STR(run(job),
+		"setBkTransparent\n"
+		"createFont MS Mincho 141 700 0 => 1\n"
+		"selectObject 1\n"
+		"textRun 236 708 ab [59 59]\n"
+		"lineTo 600 60\n");
+}
+
+static void test_misaligned(){
+	std::string buf = sample_buffer();
+	std::vector<char> shifted(buf.size() + 1);
+	memcpy(&shifted[1], buf.data(), buf.size());
+	EncodedJob job;
+	std::string err;
+	CHECK(decode_pages(&shifted[1], buf.size(), &job, &err));
+	CHECK(!job.storage.empty());
+	CHECK_EQ(job.pages[0].ops.size(), (size_t)4);
+}
+
+static void test_invalid(){
+	std::string buf = sample_buffer();
+	EncodedJob job;
+	std::string err;
+	size_t n;
+	for(n=0;n<buf.size();n++){
+		std::vector<uint32_t> aligned(buf.size() / 4 + 1);
+		memcpy(&aligned[0], buf.data(), n);
+		CHECK(!decode_pages((const char *)&aligned[0], n, &job, &err));
+	}
+	std::string bad = buf;
+	bad[0] = 'X';
+	CHECK(!decode_pages(bad.data(), bad.size(), &job, &err));
+	CHECK_STR(err, "not an encoded page buffer");
+	bad = buf;
+	bad[4] = 2;
+	CHECK(!decode_pages(bad.data(), bad.size(), &job, &err));
+	bad = buf;
+	bad[buf.size() - 39] = 42;
+	CHECK(!decode_pages(bad.data(), bad.size(), &job, &err));
+	CHECK_STR(err, "unknown op code");
+	bad = buf;
+	bad[buf.size() - 39 + 1] = 7;     // create_font with string id 7
+	CHECK(!decode_pages(bad.data(), bad.size(), &job, &err));
+}
+
+static void json_string(const Page &page, const TextRef &ref){
+	std::string s = utf16_to_utf8(page.textOf(ref), ref.length);
+	size_t i;
+	putchar('"');
+	for(i=0;i<s.size();i++){
+		unsigned char c = (unsigned char)s[i];
+		if( c == '"' || c == '\\' ){
+			printf("\\%c", c);
+		} else if( c < 0x20 ){
+			printf("\\u%04x", c);
+		} else {
+			putchar(c);
+		}
+	}
+	putchar('"');
+}
+
+static void json_coords(const Page &page, const CoordRef &ref){
+	uint32_t i;
+	if( ref.count == 0 ){
+		printf("%.10g", ref.value);
+		return;
+	}
+	putchar('[');
+	for(i=0;i<ref.count;i++){
+		printf("%s%.10g", i ? "," : "", page.coordAt(ref, i));
+	}
+	putchar(']');
+}
+
+static int dump(const char *path){
+	FILE *fp = fopen(path, "rb");
+	if( !fp ){
+		perror(path);
+		return 2;
+	}
+	std::string buf;
+	char chunk[4096];
+	size_t n;
+	while( (n = fread(chunk, 1, sizeof(chunk), fp)) > 0 ){
+		buf.append(chunk, n);
+	}
+	fclose(fp);
+	EncodedJob job;
+	std::string err;
+	if( !decode_pages(buf.data(), buf.size(), &job, &err) ){
+		printf("decode failed: %s\n", err.c_str());
+		return 1;
+	}
+	size_t p, i;
+	printf("[");
+	for(p=0;p<job.pages.size();p++){
+		const Page &page = job.pages[p];
+		printf("%s\n[", p ? "," : "");
+		for(i=0;i<page.ops.size();i++){
+			const PageOp &op = page.ops[i];
+			printf("%s\n[\"%s\"", i ? "," : "", op_code_name(op.code));
+			switch(op.code){
+				case OP_MOVE_TO: case OP_LINE_TO: case OP_TRANSLATE: case OP_SCALE:
+					printf(",%.10g,%.10g", op.xs.value, op.ys.value);
+					break;
+				case OP_ROTATE:
+					printf(",%.10g", op.xs.value);
+					break;
+				case OP_CREATE_FONT:
+					putchar(',');
+					json_string(page, op.name);
+					putchar(',');
+					json_string(page, op.face);
+					printf(",%.10g,%d,%d", op.size, op.weight, op.italic);
+					break;
+				case OP_SET_FONT: case OP_SET_PEN:
+					putchar(',');
+					json_string(page, op.name);
+					break;
+				case OP_SET_TEXT_COLOR:
+					printf(",%d,%d,%d", op.r, op.g, op.b);
+					break;
+				case OP_CREATE_PEN:
+					putchar(',');
+					json_string(page, op.name);
+					printf(",%d,%d,%d,%.10g", op.r, op.g, op.b, op.size);
+					break;
+				case OP_DRAW_CHARS:
+					putchar(',');
+					json_string(page, op.text);
+					putchar(',');
+					json_coords(page, op.xs);
+					putchar(',');
+					json_coords(page, op.ys);
+					break;
+				case OP_POLYLINE: case OP_POLY_POLYLINE: case OP_GRID:
+					putchar(',');
+					json_coords(page, op.xs);
+					putchar(',');
+					json_coords(page, op.ys);
+					if( op.code == OP_POLY_POLYLINE ){
+						putchar(',');
+						json_coords(page, op.counts);
+					}
+					break;
+				case OP_RECT: case OP_FILL_RECT:
+					printf(",%.10g,%.10g,%.10g,%.10g", op.xs.value, op.ys.value, op.width, op.height);
+					if( op.code == OP_FILL_RECT ){
+						printf(",%d,%d,%d", op.r, op.g, op.b);
+					}
+					break;
+			}
+			putchar(']');
+		}
+		printf("]");
+	}
+	printf("]\n");
+	return 0;
+}
+
+int main(int argc, char **argv){
+	if( argc > 1 ){
+		return dump(argv[1]);
+	}
+	test_decode();
+	test_misaligned();
+	test_invalid();
+	return test_summary("test-page-format");
+}
@@ -0,0 +1,123 @@
+"use strict";
+
+// Round trip of the binary page format: encodes pages with page-format.js,
+// decodes them with the native decoder (build/Release/test-page-format, see
+// README) and compares the result to the original ops.
+
+var PageFormat = require("./page-format");
+var child_process = require("child_process");
+var path = require("path");
+var os = require("os");
+var fs = require("fs");
+var assert = require("assert");
+
+var decoderPath = path.join(__dirname, "build", "Release", "test-page-format");
+
+var pages = [
+	[
+		["move_to", 10, 10],
+		["line_to", 40, 20],
+		["create_font", "mincho6", "MS Mincho", 6, 0, 0],
+		["set_font", "mincho6"],
+		["draw_chars", "こんにちは世界", [10, 16, 22, 28, 34, 40, 46], 30],
+		["set_text_color", 0, 244, 0],
+		["draw_chars", "こんにちは世界", [10, 16, 22, 28, 34, 40, 46], 50],
+		["create_pen", "blue", 0, 0, 255, 1],
+		["set_pen", "blue"],
+		["move_to", 10, 20],
+		["line_to", 40, 10]
+	],
+	[
+		["create_font", "gothic", "MS Gothic", 3.5, true, 1],
+		["set_font", "gothic"],
+		["draw_chars", "TOTAL \"1,234\"", 12.3, [5, 5.5, 6, 6.5, 7, 7.5, 8, 8.5, 9, 9.5, 10, 10.5, 11]],
+		["draw_chars", "𠮷", [3.33, 5.67], 25.4],
+		["set_text_color", 12.7, 0, 255.9],
+		["no_such_op", 1, 2],
+		["create_pen", "thin", 0, 0, 0, 0.05],
+		["set_pen", "mincho6"],
+		["push"],
+		["translate", 36, 4.2],
+		["rotate", 90],
+		["scale", 0.725],
+		["move_to", 0, 0],
+		["pop"],
+		["polyline", [2, 78, 78.25], 40.5],
+		["poly_polyline", [2, 78, 2, 78], [44, 44, 46.1, 46.1], [2, 2]],
+		["rect", 1, 1, 78, 99.5],
+		["fill_rect", 2, 50, 76, 0.3, 0, 0, 128.5],
+		["grid", [15, 75, 135, 195], [20, 26, 32]]
+	],
+	[]
+];
+
+function mm(value){
+	return Math.round(Math.fround(Number(value)) * 10000) / 10000;
+}
+
+function coords(value){
+	if( Array.isArray(value) ){
+		return value.map(mm);
+	}
+	return mm(value);
+}
+
+function expected(ops){
+	return ops.filter(function(op){
+		return op[0] !== "no_such_op";
+	}).map(function(op){
+		switch(op[0]){
+			case "move_to": case "line_to": return [op[0], mm(op[1]), mm(op[2])];
+			case "create_font": return [op[0], op[1], op[2], mm(op[3]), op[4] ? 1 : 0, op[5] ? 1 : 0];
+			case "set_font": case "set_pen": return op;
+			case "set_text_color": return [op[0], Math.floor(op[1]), Math.floor(op[2]), Math.floor(op[3])];
+			case "create_pen": return [op[0], op[1], op[2], op[3], op[4], mm(op[5])];
+			case "draw_chars": return [op[0], op[1], coords(op[2]), coords(op[3])];
+			case "push": case "pop": return op;
+			case "translate": return [op[0], mm(op[1]), mm(op[2])];
+			case "scale": return [op[0], mm(op[1]), mm(op[2] === undefined ? op[1] : op[2])];
+			case "rotate": return [op[0], mm(op[1])];
+			case "polyline": case "grid": return [op[0], coords(op[1]), coords(op[2])];
+			case "poly_polyline": return [op[0], coords(op[1]), coords(op[2]), coords(op[3])];
+			case "rect": return [op[0], mm(op[1]), mm(op[2]), mm(op[3]), mm(op[4])];
+			case "fill_rect":
+				return [op[0], mm(op[1]), mm(op[2]), mm(op[3]), mm(op[4]),
+					Math.floor(op[5]), Math.floor(op[6]), Math.floor(op[7])];
+		}
+	});
+}
+
+function sameValue(a, b){
+	if( Array.isArray(a) ){
+		return Array.isArray(b) && a.length === b.length && a.every(function(x, i){
+			return sameValue(x, b[i]);
+		});
+	}
+	if( typeof a === "number" ){
+		return typeof b === "number" && Math.abs(a - b) < 1e-9;
+	}
+	return a === b;
+}
+
+var buf = PageFormat.encodePages(pages);
+assert(PageFormat.isEncodedPages(buf));
+var file = path.join(os.tmpdir(), "drawer-test-" + process.pid + ".pages");
+
+PageFormat.saveEncodedPages(file, pages, function(err){
+	assert.ifError(err);
+	PageFormat.readEncodedPages(file, function(err, saved){
+		assert.ifError(err);
+		assert(saved.equals(buf), "saved buffer differs");
+		var out = child_process.execFileSync(decoderPath, [file]).toString("utf-8");
+		fs.unlinkSync(file);
+		var decoded = JSON.parse(out);
+		assert.strictEqual(decoded.length, pages.length);
+		pages.forEach(function(page, i){
+			var want = expected(page);
+			assert(sameValue(want, decoded[i]),
+				"page " + i + " differs:\n" + JSON.stringify(want) + "\n" + JSON.stringify(decoded[i]));
+		});
+		console.log("test-page-format.js: " + pages.length + " pages, " + buf.length +
+			" bytes (JSON " + Buffer.byteLength(JSON.stringify(pages)) + " bytes) ok");
+	});
+});
@@ -0,0 +1,482 @@
+#include "test-util.h"
+#include "test-fixtures.h"
+#include "page-optimizer.h"
+#include "page-executor.h"
+#include "raster-device.h"
+#include "recording-device.h"
+#include <algorithm>
+#include <map>
+#include <math.h>
+
+// op names of a page, one per line
+static std::string op_list(const Page &page){
+	std::string out;
+	size_t i;
+	for(i=0;i<page.ops.size();i++){
+		const PageOp &op = page.ops[i];
+		out += op_code_name(op.code);
+		if( op.name.length ){
+			out += " " + utf16_to_utf8(page.textOf(op.name), op.name.length);
+		}
+		if( op.code == OP_DRAW_CHARS ){
+			out += " " + utf16_to_utf8(page.textOf(op.text), op.text.length);
+		}
+		out += "\n";
+	}
+	return out;
+}
+
+struct Ink {
+	long color;
+	std::string what;
+};
+
+static long rgb(int r, int g, int b){
+	return ((long)r << 16) | ((long)g << 8) | (long)b;
+}
+
+// What the calls put on paper: glyphs, line segments and filled rectangles
+// with the font, pen or color they are drawn with. Marks in one color cover
+// the same pixels in any order, so runs of one color are sorted.
+static std::vector<std::string> ink_of(const RecordingDevice &device){
+	std::map<DeviceHandle, std::string> fonts, pens;
+	std::map<DeviceHandle, long> penColors;
+	std::vector<Ink> marks;
+	std::string font = "?", pen = "?";
+	long textColor = -1, penColor = -1, x = 0, y = 0;
+	char buf[128];
+	size_t i, j, k;
+	for(i=0;i<device.calls().size();i++){
+		const DeviceCall &call = device.calls()[i];
+		switch(call.kind){
+			case CALL_CREATE_FONT: {
+				snprintf(buf, sizeof(buf), "%ld %ld %ld ", call.size, call.weight, call.italic);
+				fonts[call.handle] = buf + utf16_to_utf8(&call.text[0], (uint32_t)call.text.size());
+				break;
+			}
+			case CALL_CREATE_PEN: {
+				snprintf(buf, sizeof(buf), "%ld", call.size);
+				pens[call.handle] = buf;
+				penColors[call.handle] = rgb(call.r, call.g, call.b);
+				break;
+			}
+			case CALL_SELECT_OBJECT: {
+				if( fonts.count(call.handle) ){
+					font = fonts[call.handle];
+				} else {
+					pen = pens[call.handle];
+					penColor = penColors[call.handle];
+				}
+				break;
+			}
+			case CALL_SET_TEXT_COLOR: {
+				textColor = rgb(call.r, call.g, call.b);
+				break;
+			}
+			case CALL_TEXT_RUN: {
+				long gx = call.x;
+				for(j=0;j<call.text.size();j++){
+					Ink mark;
+					snprintf(buf, sizeof(buf), "glyph %ld %ld %u ", gx, call.y, call.text[j]);
+					mark.color = textColor;
+					mark.what = buf + font;
+					marks.push_back(mark);
+					gx += call.advances[j];
+				}
+				break;
+			}
+			case CALL_MOVE_TO: {
+				x = call.x;
+				y = call.y;
+				break;
+			}
+			case CALL_LINE_TO: case CALL_POLY_POLYLINE: {
+				std::vector<long> points;
+				std::vector<uint32_t> counts;
+				if( call.kind == CALL_LINE_TO ){
+					long line[4] = { x, y, call.x, call.y };
+					points.assign(line, line + 4);
+					counts.push_back(2);
+					x = call.x;
+					y = call.y;
+				} else {
+					points = call.points;
+					counts = call.counts;
+				}
+				size_t start = 0;
+				for(j=0;j<counts.size();j++){
+					for(k=start+1;k<start+counts[j];k++){
+						Ink mark;
+						snprintf(buf, sizeof(buf), "line %ld %ld %ld %ld ", points[k * 2 - 2], points[k * 2 - 1],
+							points[k * 2], points[k * 2 + 1]);
+						mark.color = penColor;
+						mark.what = buf + pen;
+						marks.push_back(mark);
+					}
+					start += counts[j];
+				}
+				break;
+			}
+			case CALL_FILL_RECT: {
+				Ink mark;
+				snprintf(buf, sizeof(buf), "fill %ld %ld %ld %ld", call.x, call.y, call.right, call.bottom);
+				mark.color = rgb(call.r, call.g, call.b);
+				mark.what = buf;
+				marks.push_back(mark);
+				break;
+			}
+			case CALL_END_PAGE: {
+				Ink mark;
+				mark.color = -2;
+				mark.what = "end page";
+				marks.push_back(mark);
+				break;
+			}
+		}
+	}
+	std::vector<std::string> out;
+	for(i=0;i<marks.size();i=j){
+		size_t first = out.size();
+		for(j=i;j<marks.size() && marks[j].color == marks[i].color;j++){
+			out.push_back(marks[j].what);
+		}
+		std::sort(out.begin() + first, out.end());
+	}
+	return out;
+}
+
+static std::vector<uint8_t> raster_of(const Page &page, uint32_t width, uint32_t height){
+	RasterDevice device(203, 203);
+	RasterPage raster;
+	PageExecutor executor(&device);
+	CHECK(executor.runPage(page));
+	device.rasterize(width, height, 1, &raster);
+	return raster.pixels;
+}
+
+// Draws page and its optimized form and checks they put the same marks on
+// paper. Returns the device calls saved.
+static long check_same(const Page &page, bool reorder, uint32_t width, uint32_t height){
+	PageOptimizer optimizer;
+	PageBuilder out;
+	optimizer.setReorder(reorder);
+	const Page &optimized = optimizer.optimize(page, &out);
+	RecordingDevice plain(203, 203), fewer(203, 203);
+	{
+		PageExecutor first(&plain), second(&fewer);
+		CHECK(first.runPage(page));
+		CHECK(second.runPage(optimized));
+	}
+	CHECK(ink_of(plain) == ink_of(fewer));
+	CHECK(raster_of(page, width, height) == raster_of(optimized, width, height));
+	CHECK(fewer.totalCount() <= plain.totalCount());
+	return plain.totalCount() - fewer.totalCount();
+}
+
+static void test_states(){
+	PageBuilder b, out;
+	static const uint16_t a[] = { 'a' }, c[] = { 'c' };
+	b.createFont("f", "Arial", 3, 0, 0);
+	b.createPen("p", 0, 0, 0, 0.2);
+	b.setFont("f");
+	b.setFont("f");
+	b.setTextColor(0, 0, 0);
+	b.drawChars(a, 1, b.scalar(1), b.scalar(1));
+	b.setTextColor(0, 0, 0);
+	b.setFont("f");
+	b.drawChars(c, 1, b.scalar(2), b.scalar(5));
+	b.createPen("p", 0, 0, 0, 0.2);
+	b.setPen("p");
+	b.moveTo(0, 10);
+	b.lineTo(10, 10);
+	b.setPen("p");
+	b.setTextColor(255, 0, 0);
+	b.setTextColor(0, 0, 0);
+	b.lineTo(20, 10);
+	b.setFont("f");
+	b.finish();
+	PageOptimizer optimizer;
+	CHECK_STR(op_list(optimizer.optimize(b.page(), &out)),
+		"create_font f\n"
+		"create_pen p\n"
+		"set_text_color\n"
+		"set_font f\n"
+		"draw_chars a\n"
+		"draw_chars c\n"
+		"move_to\n"
+		"set_pen p\n"
+		"line_to\n"
+		"line_to\n");
+	CHECK_EQ(optimizer.stats().opsIn, 18L);
+	CHECK_EQ(optimizer.stats().opsOut, 10L);
+	// ten sets in, three out
+	CHECK_EQ(optimizer.stats().statesDropped, 7L);
+	CHECK_EQ(optimizer.stats().createsDropped, 1L);
+	CHECK_EQ(optimizer.stats().createsHoisted, 2L);
+	check_same(b.page(), true, 200, 100);
+}
+
+// Fonts and pens of one definition are interchangeable, under any name.
+static void test_aliases(){
+	PageBuilder b, out;
+	static const uint16_t a[] = { 'a' };
+	int i;
+	b.createFont("f", "Arial", 3, 0, 0);
+	b.createFont("g", "Arial", 3, 0, 0);
+	b.createFont("h", "Arial", 3, 1, 0);
+	b.createPen("p", 0, 0, 0, 0.2);
+	b.scale(2, 2);
+	b.createPen("q", 0, 0, 0, 0.1);
+	for(i=0;i<4;i++){
+		b.setFont(i % 2 ? "g" : "f");
+		b.drawChars(a, 1, b.scalar(1), b.scalar(i * 5));
+		b.setPen(i % 2 ? "q" : "p");
+		b.moveTo(0, i * 5);
+		b.lineTo(10, i * 5);
+	}
+	b.setFont("h");
+	b.finish();
+	PageOptimizer optimizer;
+	const Page &optimized = optimizer.optimize(b.page(), &out);
+	std::string ops = op_list(optimized);
+	// q is created under the scale, at the size of p
+	CHECK_EQ(optimizer.stats().createsHoisted, 4L);
+	CHECK(ops.find("set_font g") == std::string::npos);
+	CHECK(ops.find("set_pen q") == ops.size() - 10);
+	// the page still ends with h and q selected
+	CHECK(ops.compare(ops.size() - 21, 21, "set_font h\nset_pen q\n") == 0);
+	CHECK(check_same(b.page(), true, 400, 400) > 0);
+}
+
+static void test_merge(){
+	PageBuilder b, out;
+	static const double xs[] = { 1, 2, 3 }, ys[] = { 5, 5, 7 };
+	std::vector<uint16_t> abc = u16("abc"), de = u16("de");
+	b.createFont("f", "Arial", 3, 0, 0);
+	b.setFont("f");
+	b.drawChars(&abc[0], 3, b.addCoords(xs, 3), b.scalar(5));
+	b.drawChars(&de[0], 2, b.addCoords(xs + 1, 2), b.scalar(5));
+	// starts on the baseline "de" ended on, goes on below it
+	b.drawChars(&abc[0], 3, b.addCoords(xs, 3), b.addCoords(ys, 3));
+	b.drawChars(&de[0], 2, b.addCoords(xs, 2), b.scalar(9));
+	b.drawChars(&de[0], 0, b.scalar(0), b.scalar(9));
+	b.finish();
+	PageOptimizer optimizer;
+	const Page &optimized = optimizer.optimize(b.page(), &out);
+	CHECK_STR(op_list(optimized),
+		"create_font f\n"
+		"set_font f\n"
+		"draw_chars abcdeabc\n"
+		"draw_chars de\n");
+	CHECK_EQ(optimizer.stats().textsMerged, 2L);
+	CHECK_EQ(optimized.ops[2].ys.count, (uint32_t)8);
+	CHECK_EQ(optimized.ops[3].ys.count, (uint32_t)0);
+	CHECK_EQ(optimized.ops[3].ys.value, 9.0);
+	RecordingDevice plain(203, 203), merged(203, 203);
+	PageExecutor first(&plain), second(&merged);
+	CHECK(first.runOps(b.page()));
+	CHECK(second.runOps(optimized));
+	CHECK_EQ(plain.count(CALL_TEXT_RUN), 5L);
+	CHECK_EQ(merged.count(CALL_TEXT_RUN), 3L);
+	CHECK(ink_of(plain) == ink_of(merged));
+}
+
+// Texts in one color are drawn a font at a time; a color change keeps its
+// place.
+static void test_reorder(){
+	PageBuilder b, out;
+	static const uint16_t a[] = { 'a' };
+	int i;
+	b.createFont("big", "Arial", 5, 1, 0);
+	b.createFont("small", "Arial", 3, 0, 0);
+	for(i=0;i<6;i++){
+		b.setFont(i % 2 ? "small" : "big");
+		b.drawChars(a, 1, b.scalar(1), b.scalar(i * 6));
+	}
+	b.setTextColor(255, 0, 0);
+	b.setFont("big");
+	b.drawChars(a, 1, b.scalar(1), b.scalar(40));
+	b.setFont("small");
+	b.drawChars(a, 1, b.scalar(1), b.scalar(46));
+	b.setFont("big");
+	b.drawChars(a, 1, b.scalar(1), b.scalar(52));
+	b.finish();
+	PageOptimizer optimizer;
+	CHECK_STR(op_list(optimizer.optimize(b.page(), &out)),
+		"create_font big\n"
+		"create_font small\n"
+		"set_font big\n"
+		"draw_chars a\n"
+		"draw_chars a\n"
+		"draw_chars a\n"
+		"set_font small\n"
+		"draw_chars a\n"
+		"draw_chars a\n"
+		"draw_chars a\n"
+		"set_text_color\n"
+		"draw_chars a\n"
+		"set_font big\n"
+		"draw_chars a\n"
+		"draw_chars a\n");
+	CHECK(optimizer.stats().textsReordered > 0);
+	check_same(b.page(), true, 200, 500);
+
+	optimizer.setReorder(false);
+	std::string ops = op_list(optimizer.optimize(b.page(), &out));
+	size_t pos = 0, selects = 0;
+	while( (pos = ops.find("set_font", pos)) != std::string::npos ){
+		selects += 1;
+		pos += 1;
+	}
+	CHECK_EQ(selects, (size_t)9);
+	check_same(b.page(), false, 200, 500);
+}
+
+// A font created again while selected: texts after it still use the old
+// one until it is selected again, as with GDI. f draws like the old g, so it
+// stays selected.
+static void test_replaced(){
+	PageBuilder b, out;
+	static const uint16_t a[] = { 'a' };
+	b.createFont("f", "Arial", 3, 0, 0);
+	b.createFont("g", "Arial", 3, 0, 0);
+	b.setFont("g");
+	b.setFont("f");
+	b.drawChars(a, 1, b.scalar(1), b.scalar(1));
+	b.setFont("g");
+	b.createFont("g", "Arial", 6, 0, 0);
+	b.drawChars(a, 1, b.scalar(1), b.scalar(5));
+	b.setFont("g");
+	b.drawChars(a, 1, b.scalar(1), b.scalar(10));
+	b.finish();
+	PageOptimizer optimizer;
+	CHECK_STR(op_list(optimizer.optimize(b.page(), &out)),
+		"create_font f\n"
+		"create_font g\n"
+		"set_font f\n"
+		"draw_chars a\n"
+		"create_font g\n"
+		"draw_chars a\n"
+		"set_font g\n"
+		"draw_chars a\n");
+	check_same(b.page(), true, 200, 200);
+
+	// the first create of a name stays after texts drawn with the font the
+	// device had, which may be the one the name had on an earlier page
+	b.clear();
+	b.drawChars(a, 1, b.scalar(1), b.scalar(1));
+	b.createFont("f", "Arial", 3, 0, 0);
+	b.scale(2, 2);
+	b.createPen("p", 0, 0, 0, 0.2);
+	b.finish();
+	CHECK_STR(op_list(optimizer.optimize(b.page(), &out)),
+		"draw_chars a\n"
+		"create_font f\n"
+		"scale\n"
+		"create_pen p\n");
+}
+
+// Pages that fail keep failing the same way.
+static void test_errors(){
+	PageBuilder b, out;
+	static const double xs[] = { 1, 2 };
+	std::vector<uint16_t> abc = u16("abc");
+	PageOptimizer optimizer;
+	RecordingDevice device(203, 203);
+	b.setFont("missing");
+	b.setFont("missing");
+	b.finish();
+	{
+		PageExecutor executor(&device);
+		CHECK(!executor.runOps(optimizer.optimize(b.page(), &out)));
+		CHECK_STR(executor.error(), "unknown font: missing");
+	}
+	b.clear();
+	b.createFont("f", "Arial", 3, 0, 0);
+	b.setFont("f");
+	b.drawChars(&abc[0], 3, b.addCoords(xs, 2), b.scalar(0));
+	b.addOp(99);
+	b.finish();
+	{
+		PageExecutor executor(&device);
+		CHECK_STR(op_list(optimizer.optimize(b.page(), &out)),
+			"create_font f\n"
+			"set_font f\n"
+			"draw_chars abc\n"
+			"unknown\n");
+		CHECK(!executor.runOps(out.page()));
+		CHECK_STR(executor.error(), "too few coordinates to drawChars");
+	}
+}
+
+// The fixture pages and a job of them, with the calls saved.
+static void test_fixtures(){
+	PageBuilder receipt, table, generated, out;
+	fixture_receipt(receipt, 20);
+	fixture_a4_table(table, 30);
+	fixture_generated(generated, 20);
+	CHECK_EQ(check_same(receipt.page(), true, 640, 1000), 20L);
+	CHECK_EQ(check_same(table.page(), true, 1700, 2400), 30L);
+	CHECK_EQ(check_same(generated.page(), true, 640, 1000), 221L);
+	CHECK_EQ(check_same(generated.page(), false, 640, 1000), 186L);
+
+	PageOptimizer optimizer;
+	optimizer.optimize(generated.page(), &out);
+	const OptimizerStats &stats = optimizer.stats();
+	CHECK_EQ(stats.opsIn, 243L);
+	CHECK_EQ(stats.opsOut, 63L);
+	CHECK_EQ(stats.createsDropped, 41L);
+	CHECK_EQ(stats.textsMerged, 20L);
+
+	const Page *pages[] = { &generated.page(), &receipt.page(), &table.page() };
+	RecordingDevice plain(203, 203), fewer(203, 203);
+	{
+		PageExecutor first(&plain), second(&fewer);
+		first.setCopies(2, true);
+		second.setCopies(2, true);
+		second.setOptimize(true);
+		CHECK(first.runJob(pages, 3, 0, 0));
+		CHECK(second.runJob(pages, 3, 0, 0));
+		CHECK_EQ(second.optimizerStats().pages, 3L);
+		CHECK_EQ(second.replayedPages(), 6L);
+	}
+	CHECK(ink_of(plain) == ink_of(fewer));
+	CHECK_EQ(plain.count(CALL_SELECT_OBJECT), 146L);
+	CHECK_EQ(fewer.count(CALL_SELECT_OBJECT), 30L);
+}
+
+// A page drawing with the state the page before left.
+static void test_carried_state(){
+	PageBuilder first, second;
+	static const uint16_t a[] = { 'a' };
+	first.createFont("f", "Arial", 3, 0, 0);
+	first.createFont("g", "Arial", 5, 0, 0);
+	first.setFont("f");
+	first.drawChars(a, 1, first.scalar(1), first.scalar(1));
+	first.setTextColor(0, 0, 255);
+	first.setFont("g");
+	first.finish();
+	second.drawChars(a, 1, second.scalar(1), second.scalar(5));
+	second.finish();
+	const Page *pages[] = { &first.page(), &second.page() };
+	RecordingDevice plain(203, 203), fewer(203, 203);
+	{
+		PageExecutor one(&plain), other(&fewer);
+		other.setOptimize(true);
+		CHECK(one.runJob(pages, 2, 0, 0));
+		CHECK(other.runJob(pages, 2, 0, 0));
+	}
+	CHECK(ink_of(plain) == ink_of(fewer));
+}
+
+int main(){
+	test_states();
+	test_aliases();
+	test_merge();
+	test_reorder();
+	test_replaced();
+	test_errors();
+	test_fixtures();
+	test_carried_state();
+	return test_summary("test-page-optimizer");
+}
@@ -0,0 +1,348 @@
+#include "test-util.h"
+#include "test-fixtures.h"
+#include "page-template.h"
+#include "page-executor.h"
+#include "recording-device.h"
+#include <stdio.h>
+
+// Receipt with a title, a date, one line per item with an optional note
+// line under it, an optional discount line and the total.
+static void build_receipt_template(PageTemplate &t){
+	PageBuilder &b = t.ops();
+	b.createFont("title", "MS Gothic", 6, 1, 0);
+	b.createFont("body", "MS Gothic", 3.5, 0, 0);
+	b.createPen("rule", 0, 0, 0, 0.2);
+	b.setFont("title");
+	fixture_text(b, "RECEIPT", 25, 5, 4);
+	b.setFont("body");
+	t.field("date", 78, 12, 1.75, TEMPLATE_ALIGN_RIGHT);
+	b.setPen("rule");
+	b.moveTo(2, 16);
+	b.lineTo(78, 16);
+	t.beginRepeat("items", 8.5);
+	t.field("name", 3, 18, 1.75, TEMPLATE_ALIGN_LEFT);
+	t.field("price", 78, 18, 1.75, TEMPLATE_ALIGN_RIGHT);
+	t.beginIf("note", 4);
+	t.field("note", 6, 22.5, 1.75, TEMPLATE_ALIGN_LEFT);
+	t.end();
+	t.end();
+	b.moveTo(2, 26.5);
+	b.lineTo(78, 26.5);
+	t.beginIf("discount", 5);
+	fixture_text(b, "DISCOUNT", 3, 28.5, 1.75);
+	t.field("discount", 78, 28.5, 1.75, TEMPLATE_ALIGN_RIGHT);
+	t.end();
+	b.setFont("title");
+	b.setTextColor(0, 0, 0);
+	fixture_text(b, "TOTAL", 3, 33.5, 3.5);
+	t.field("total", 78, 33.5, 3.5, TEMPLATE_ALIGN_RIGHT);
+}
+
+static void set_text(TemplateValues &v, uint32_t scope, uint32_t row, uint32_t field, const char *ascii){
+	std::vector<uint16_t> text = u16(ascii);
+	v.setText(scope, row, field, text.empty() ? 0 : &text[0], (uint32_t)text.size());
+}
+
+static void right_text(PageBuilder &b, const char *ascii, double x, double y, double pitch){
+	fixture_text(b, ascii, x - strlen(ascii) * pitch, y, pitch);
+}
+
+// The calls up to EndPage; objects are deleted in another order.
+static std::string page_calls(const RecordingDevice &device){
+	std::string dump = device.dump();
+	return dump.substr(0, dump.find("endPage\n"));
+}
+
+static std::string run_template(PageTemplate &t, const TemplateValues &v){
+	RecordingDevice device(203, 203);
+	{
+		TemplateExecutor executor(&device);
+		CHECK(executor.runPage(t, v));
+	}
+	CHECK_EQ(device.liveObjects(), 0);
+	return page_calls(device);
+}
+
+static std::string run_page(const Page &page){
+	RecordingDevice device(203, 203);
+	{
+		PageExecutor executor(&device);
+		CHECK(executor.runPage(page));
+	}
+	return page_calls(device);
+}
+
+// The template draws exactly what the page laid out by hand draws: rows
+// step down, the absent note of row 1 and the absent discount move what is
+// below them up.
+static void test_receipt(){
+	PageTemplate t;
+	std::string err;
+	build_receipt_template(t);
+	CHECK(t.compile(&err));
+	CHECK_EQ(t.scopes().size(), (size_t)2);
+	CHECK_EQ(t.findScope("items"), 1);
+	CHECK_EQ(t.findScope("date"), -1);
+	CHECK_EQ(t.scopes()[0].fields.size(), (size_t)3);
+	CHECK_EQ(t.scopes()[1].fields.size(), (size_t)3);
+	CHECK_EQ(t.scopes()[1].flags.size(), (size_t)1);
+
+	TemplateValues v;
+	v.reset(t);
+	set_text(v, 0, 0, 0, "2016-12-01");
+	set_text(v, 0, 0, 2, "12.50");
+	uint32_t row = v.addRow(1);
+	set_text(v, 1, row, 0, "Coffee");
+	set_text(v, 1, row, 1, "3.00");
+	v.setFlag(1, row, 0, true);
+	set_text(v, 1, row, 2, "no sugar");
+	row = v.addRow(1);
+	set_text(v, 1, row, 0, "Sandwich");
+	set_text(v, 1, row, 1, "9.50");
+	CHECK_EQ(v.rows(1), (uint32_t)2);
+
+	PageBuilder b;
+	b.createFont("title", "MS Gothic", 6, 1, 0);
+	b.createFont("body", "MS Gothic", 3.5, 0, 0);
+	b.createPen("rule", 0, 0, 0, 0.2);
+	b.setFont("title");
+	fixture_text(b, "RECEIPT", 25, 5, 4);
+	b.setFont("body");
+	right_text(b, "2016-12-01", 78, 12, 1.75);
+	b.setPen("rule");
+	b.moveTo(2, 16);
+	b.lineTo(78, 16);
+	fixture_text(b, "Coffee", 3, 18, 1.75);
+	right_text(b, "3.00", 78, 18, 1.75);
+	fixture_text(b, "no sugar", 6, 22.5, 1.75);
+	// the second row starts 8.5 below the first and has no note
+	fixture_text(b, "Sandwich", 3, 26.5, 1.75);
+	right_text(b, "9.50", 78, 26.5, 1.75);
+	b.moveTo(2, 31);
+	b.lineTo(78, 31);
+	b.setFont("title");
+	b.setTextColor(0, 0, 0);
+	fixture_text(b, "TOTAL", 3, 33, 3.5);
+	right_text(b, "12.50", 78, 33, 3.5);
+	b.finish();
+
+	CHECK_STR(run_template(t, v), run_page(b.page()));
+}
+
+static void test_rows(){
+	PageTemplate t;
+	std::string err;
+	build_receipt_template(t);
+	CHECK(t.compile(&err));
+	TemplateValues v;
+	RecordingDevice device(203, 203);
+	TemplateExecutor executor(&device);
+	uint32_t i;
+	char buf[32];
+
+	// no rows: the total moves up by one row
+	v.reset(t);
+	set_text(v, 0, 0, 2, "0.00");
+	CHECK(executor.runOps(t, v));
+	const DeviceCall &total = device.calls().back();
+	CHECK_EQ(total.kind, (int)CALL_TEXT_RUN);
+	CHECK_EQ(total.y, mm_to_pixel(203, 33.5 - 8.5 - 5));
+	CHECK_EQ(device.count(CALL_CREATE_FONT), 2L);
+
+	// 40 rows, 4 with notes, and a discount
+	device.clear();
+	v.reset(t);
+	for(i=0;i<40;i++){
+		uint32_t row = v.addRow(1);
+		sprintf(buf, "Item %03u", i + 1);
+		set_text(v, 1, row, 0, buf);
+		set_text(v, 1, row, 1, "1.00");
+		if( i % 13 == 0 ){
+			v.setFlag(1, row, 0, true);
+			set_text(v, 1, row, 2, "extra");
+		}
+	}
+	v.setFlag(0, 0, 0, true);
+	set_text(v, 0, 0, 1, "-1.00");
+	set_text(v, 0, 0, 2, "39.00");
+	CHECK(executor.runOps(t, v));
+	CHECK_EQ(device.count(CALL_TEXT_RUN), 1 + 40L * 2 + 4 + 2 + 2);
+	CHECK_EQ(device.calls().back().y, mm_to_pixel(203, 33.5 + 39 * 8.5 - 36 * 4));
+	// fonts and pens are created once per job
+	CHECK_EQ(device.count(CALL_CREATE_FONT), 0L);
+	CHECK_EQ(t.resolvedCount(), (size_t)1);
+}
+
+static void test_fields(){
+	PageTemplate t;
+	std::string err;
+	static const uint16_t wide[] = { 0x5408, 0x8a08, 0x3a };
+	static const uint16_t pair[] = { 0xd842, 0xdfb7, 0x41 };
+	t.ops().createFont("f", "MS Gothic", 4, 0, 0);
+	t.ops().setFont("f");
+	t.field("a", 50, 10, 2, TEMPLATE_ALIGN_CENTER);
+	t.field("a", 50, 20, 2, TEMPLATE_ALIGN_LEFT);
+	CHECK(t.compile(&err));
+	CHECK_EQ(t.scopes()[0].fields.size(), (size_t)1);
+	CHECK_EQ(template_char_columns(0x41), 1);
+	CHECK_EQ(template_char_columns(0x3042), 2);
+	CHECK_EQ(template_char_columns(0xff21), 2);
+	CHECK_EQ(template_char_columns(0xff71), 1);
+	CHECK_EQ(template_char_columns(0xd842), 2);
+	CHECK_EQ(template_char_columns(0xdfb7), 0);
+
+	TemplateValues v;
+	v.reset(t);
+	v.setText(0, 0, 0, wide, 3);
+	RecordingDevice device(254, 254);
+	TemplateExecutor executor(&device);
+	CHECK(executor.runOps(t, v));
+	// 5 columns of 2 mm centered on 50 mm at 10 px/mm
+	const DeviceCall &centered = device.calls()[device.calls().size() - 2];
+	CHECK_EQ(centered.x, 450L);
+	CHECK_EQ(centered.advances.size(), (size_t)3);
+	CHECK_EQ(centered.advances[0], 40);
+	CHECK_EQ(centered.advances[1], 40);
+
+	device.clear();
+	v.reset(t);
+	v.setText(0, 0, 0, pair, 3);
+	CHECK(executor.runOps(t, v));
+	const DeviceCall &left = device.calls().back();
+	CHECK_EQ(left.x, 500L);
+	CHECK_EQ(left.y, 200L);
+	CHECK_EQ(left.advances[0], 40);
+	CHECK_EQ(left.advances[1], 0);
+
+	// a field without a value draws nothing
+	device.clear();
+	v.reset(t);
+	CHECK(executor.runOps(t, v));
+	CHECK_EQ(device.count(CALL_TEXT_RUN), 0L);
+}
+
+static void test_resolve(){
+	PageTemplate t;
+	std::string err;
+	build_receipt_template(t);
+	CHECK(t.compile(&err));
+	const ResolvedTemplate &a = t.resolve(203, 203, 0, 0);
+	CHECK(&t.resolve(203, 203, 0, 0) == &a);
+	CHECK(&t.resolve(600, 600, 0, 0) != &a);
+	CHECK(&t.resolve(203, 203, 1, 0) != &a);
+	CHECK_EQ(t.resolvedCount(), (size_t)3);
+	// a static text is one run with its advances
+	size_t i, runs = 0;
+	for(i=0;i<a.ops.size();i++){
+		runs += a.ops[i].code == TEMPLATE_TEXT_RUN;
+		CHECK(a.ops[i].code != TEMPLATE_DRAW_CHARS);
+	}
+	CHECK_EQ(runs, (size_t)3);
+
+	// offsets apply to static ops and fields alike
+	TemplateValues v;
+	v.reset(t);
+	set_text(v, 0, 0, 2, "1.00");
+	RecordingDevice device(203, 203);
+	TemplateExecutor executor(&device);
+	executor.setOffset(2, 3);
+	CHECK(executor.runOps(t, v));
+	CHECK_EQ(device.calls().back().y, mm_to_pixel(203, 33.5 - 8.5 - 5 + 3));
+	CHECK_EQ(device.calls().back().x, mm_to_pixel(203, 78 - 4 * 3.5 + 2));
+	CHECK_EQ(t.resolvedCount(), (size_t)4);
+}
+
+static void test_errors(){
+	std::string err;
+	{
+		PageTemplate t;
+		t.ops().setFont("missing");
+		CHECK(!t.compile(&err));
+		CHECK_STR(err, "unknown font: missing");
+	}
+	{
+		PageTemplate t;
+		t.beginRepeat("a", 5);
+		t.beginRepeat("b", 5);
+		t.end();
+		t.end();
+		CHECK(!t.compile(&err));
+		CHECK_STR(err, "repeat block inside repeat block: b");
+	}
+	{
+		PageTemplate t;
+		t.beginIf("x", 0);
+		CHECK(!t.compile(&err));
+		CHECK_STR(err, "block not ended: x");
+	}
+	{
+		PageTemplate t;
+		t.end();
+		CHECK(!t.compile(&err));
+		CHECK_STR(err, "end without block");
+	}
+	{
+		PageTemplate t;
+		t.beginRepeat("a", 5);
+		t.end();
+		t.beginRepeat("a", 5);
+		t.end();
+		CHECK(!t.compile(&err));
+		CHECK_STR(err, "duplicate repeat block: a");
+	}
+	{
+		PageTemplate t, other;
+		build_receipt_template(t);
+		CHECK(t.compile(&err));
+		CHECK(other.compile(&err));
+		TemplateValues v;
+		v.reset(other);
+		RecordingDevice device(203, 203);
+		TemplateExecutor executor(&device);
+		CHECK(!executor.runOps(t, v));
+		CHECK_STR(executor.error(), "values are not for this template");
+	}
+}
+
+static void test_job(){
+	PageTemplate t;
+	std::string err;
+	build_receipt_template(t);
+	CHECK(t.compile(&err));
+	TemplateValues a, b;
+	a.reset(t);
+	b.reset(t);
+	set_text(a, 0, 0, 2, "1.00");
+	set_text(b, 0, 0, 2, "2.00");
+	const TemplateValues *pages[] = { &a, &b };
+	RecordingDevice device(203, 203);
+	{
+		TemplateExecutor executor(&device);
+		CHECK(executor.runJob(t, pages, 2, 0, 0));
+		CHECK(executor.opCount() > 0);
+	}
+	CHECK_EQ(device.count(CALL_START_DOC), 1L);
+	CHECK_EQ(device.count(CALL_END_PAGE), 2L);
+	CHECK_EQ(device.count(CALL_END_DOC), 1L);
+	CHECK_EQ(device.count(CALL_CREATE_FONT), 2L);
+	CHECK_EQ(device.liveObjects(), 0);
+
+	device.clear();
+	device.failOn(CALL_END_PAGE);
+	{
+		TemplateExecutor executor(&device);
+		CHECK(!executor.runJob(t, pages, 2, 0, 0));
+		CHECK_STR(executor.error(), "EndPage failed");
+	}
+	CHECK_EQ(device.count(CALL_ABORT_DOC), 1L);
+}
+
+int main(){
+	test_receipt();
+	test_rows();
+	test_fields();
+	test_resolve();
+	test_errors();
+	test_job();
+	return test_summary("test-page-template");
+}
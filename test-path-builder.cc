@@ -0,0 +1,270 @@
+#include "test-util.h"
+#include "test-fixtures.h"
+#include "path-builder.h"
+#include "page-executor.h"
+#include "display-list.h"
+#include "recording-device.h"
+#include <math.h>
+
+// At 254 dpi one mm is exactly 10 pixels.
+static const int DPI = 254;
+
+static void test_builder(){
+	PathBuilder path;
+	static const long xs[] = { 1, 2, 3 }, ys[] = { 4, 5, 6 };
+	long x, y;
+	CHECK(!path.lineTo(1, 1));
+	CHECK(path.empty());
+	path.moveTo(0, 0);
+	CHECK(path.lineTo(10, 0));
+	CHECK(path.lineTo(10, 10));
+	path.addPolyline(xs, ys, 3);
+	path.addPolyline(xs, ys, 1);
+	// the added polyline closed the run; this one starts anew at (10, 10)
+	CHECK(path.lineTo(0, 10));
+	CHECK_EQ(path.counts().size(), (size_t)3);
+	CHECK_EQ(path.counts()[0], (uint32_t)3);
+	CHECK_EQ(path.counts()[1], (uint32_t)3);
+	CHECK_EQ(path.counts()[2], (uint32_t)2);
+	CHECK_EQ(path.points().size(), (size_t)16);
+	CHECK_EQ(path.points()[12], 10L);
+	CHECK_EQ(path.points()[15], 10L);
+	CHECK(!path.takePendingMove(&x, &y));
+
+	// clear() keeps the current point for the next run
+	path.clear();
+	CHECK(path.empty());
+	CHECK(path.lineTo(5, 10));
+	CHECK_EQ(path.points()[0], 0L);
+	CHECK_EQ(path.points()[1], 10L);
+	path.moveTo(7, 8);
+	CHECK(path.takePendingMove(&x, &y));
+	CHECK_EQ(x, 7L);
+	CHECK_EQ(y, 8L);
+	CHECK(!path.takePendingMove(&x, &y));
+
+	path.reset();
+	CHECK(path.empty());
+	CHECK(!path.lineTo(1, 1));
+	path.setCurrent(3, 3);
+	CHECK(path.lineTo(4, 4));
+	CHECK_EQ(path.points()[0], 3L);
+}
+
+static Page &build_shapes(PageBuilder &b){
+	static const double xs[] = { 1, 2, 4 }, ys[] = { 1, 3, 1 };
+	static const double pxs[] = { 0, 1, 0, 1, 2 }, pys[] = { 5, 5, 6, 6, 7 }, counts[] = { 2, 3 };
+	static const double gxs[] = { 10, 20, 30 }, gys[] = { 10, 15 };
+	b.clear();
+	b.createPen("p", 0, 0, 0, 0.1);
+	b.setPen("p");
+	b.moveTo(0, 0);
+	b.lineTo(5, 0);
+	b.polyline(b.addCoords(xs, 3), b.addCoords(ys, 3));
+	b.polyline(b.addCoords(xs, 2), b.scalar(8));
+	b.polyPolyline(b.addCoords(pxs, 5), b.addCoords(pys, 5), b.addCoords(counts, 2));
+	b.rect(1, 1, 2, 3);
+	b.grid(b.addCoords(gxs, 3), b.addCoords(gys, 2));
+	b.lineTo(5, 5);
+	b.fillRect(1, 2, 3, 0.5, 255, 0, 0);
+	b.moveTo(9, 9);
+	return b.finish();
+}
+
+static void test_shapes(){
+	PageBuilder b;
+	build_shapes(b);
+	RecordingDevice device(DPI, DPI);
+	PageExecutor executor(&device);
+	CHECK(executor.runOps(b.page()));
+	CHECK_STR(device.dump(),
+		"setBkTransparent\n"
+		"createPen 1 0 0 0 => 1\n"
+		"selectObject 1\n"
+		"polyPolyline [0 0 50 0] [10 10 20 30 40 10] [10 80 20 80] [0 50 10 50] [0 60 10 60 20 70]"
+			" [10 10 30 10 30 40 10 40 10 10] [100 100 100 150] [200 100 200 150] [300 100 300 150]"
+			" [100 100 300 100] [100 150 300 150] [50 0 50 50]\n"
+		"fillRect 10 20 40 25 255 0 0\n"
+		"moveTo 90 90\n");
+
+	// without merging the lines reach the device as they come
+	RecordingDevice plain(DPI, DPI);
+	PageExecutor unmerged(&plain);
+	unmerged.setMergePaths(false);
+	CHECK(unmerged.runOps(b.page()));
+	CHECK_EQ(plain.count(CALL_POLY_POLYLINE), 5L);
+	CHECK_EQ(plain.count(CALL_MOVE_TO), 2L);
+	CHECK_EQ(plain.count(CALL_LINE_TO), 2L);
+	CHECK_EQ(plain.count(CALL_FILL_RECT), 1L);
+}
+
+// A recorded page replays the device calls of runOps, merged or not.
+static void test_display_list(){
+	PageBuilder b;
+	build_shapes(b);
+	int merge;
+	for(merge=0;merge<2;merge++){
+		DisplayList list;
+		std::string err;
+		list.setMergePaths(merge != 0);
+		CHECK(list.record(b.page(), DPI, DPI, 1, 2, &err));
+		RecordingDevice direct(DPI, DPI), replayed(DPI, DPI);
+		PageExecutor first(&direct), second(&replayed);
+		first.setMergePaths(merge != 0);
+		first.setOffset(1, 2);
+		CHECK(first.runOps(b.page()));
+		CHECK(second.runList(list));
+		CHECK_STR(replayed.dump(), direct.dump());
+	}
+}
+
+static void test_transformed(){
+	PageBuilder b;
+	b.push();
+	b.translate(10, 0);
+	b.scale(2, 2);
+	b.rect(0, 0, 1, 1);
+	b.fillRect(0, 0, 1, 1, 0, 0, 0);
+	b.rotate(180);
+	b.fillRect(0, 0, 1, 1, 0, 0, 0);
+	b.rotate(30);
+	b.rect(0, 0, 1, 1);
+	b.pop();
+	b.finish();
+	RecordingDevice device(DPI, DPI);
+	PageExecutor executor(&device);
+	CHECK(executor.runOps(b.page()));
+	CHECK_STR(device.dump(),
+		"setBkTransparent\n"
+		"polyPolyline [100 0 120 0 120 20 100 20 100 0]\n"
+		"fillRect 100 0 120 20 0 0 0\n"
+		"fillRect 80 -20 100 0 0 0 0\n"
+		"polyPolyline [100 0 82 -10 92 -28 110 -18 100 0]\n");
+
+	b.clear();
+	b.rotate(45);
+	b.fillRect(0, 0, 1, 1, 0, 0, 0);
+	b.finish();
+	CHECK(!executor.runOps(b.page()));
+	CHECK_STR(executor.error(), "fill_rect needs an axis-aligned transform");
+}
+
+static void test_errors(){
+	static const double one[] = { 1 }, two[] = { 1, 2 }, counts[] = { 2, 2 }, bad[] = { 1.5 };
+	PageBuilder b;
+	RecordingDevice device(DPI, DPI);
+	PageExecutor executor(&device);
+	DisplayList list;
+	std::string err;
+
+	b.polyline(b.addCoords(one, 1), b.addCoords(one, 1));
+	b.finish();
+	CHECK(!executor.runOps(b.page()));
+	CHECK_STR(executor.error(), "too few coordinates to polyline");
+	CHECK(!list.record(b.page(), DPI, DPI, 0, 0, &err));
+	CHECK_STR(err, "too few coordinates to polyline");
+
+	b.clear();
+	b.polyPolyline(b.addCoords(two, 2), b.addCoords(two, 2), b.addCoords(counts, 2));
+	b.finish();
+	CHECK(!executor.runOps(b.page()));
+	CHECK_STR(executor.error(), "too few coordinates to poly_polyline");
+
+	b.clear();
+	b.polyPolyline(b.addCoords(two, 2), b.addCoords(two, 2), b.addCoords(bad, 1));
+	b.finish();
+	CHECK(!executor.runOps(b.page()));
+	CHECK_STR(executor.error(), "invalid count to poly_polyline");
+
+	b.clear();
+	b.grid(b.addCoords(two, 2), b.addCoords(one, 1));
+	b.finish();
+	CHECK(!executor.runOps(b.page()));
+	CHECK_STR(executor.error(), "too few coordinates to grid");
+
+	b.clear();
+	b.rect(0, 0, NAN, 1);
+	b.finish();
+	CHECK(!executor.runOps(b.page()));
+	CHECK_STR(executor.error(), "invalid number to rect");
+
+	// the lines before an op are drawn before the op can fail
+	b.clear();
+	b.moveTo(0, 0);
+	b.lineTo(1, 1);
+	b.fillRect(NAN, 0, 1, 1, 0, 0, 0);
+	b.finish();
+	RecordingDevice fresh(DPI, DPI);
+	PageExecutor second(&fresh);
+	CHECK(!second.runOps(b.page()));
+	CHECK_STR(second.error(), "invalid number to fill_rect");
+	CHECK_EQ(fresh.count(CALL_POLY_POLYLINE), 1L);
+
+	device.failOn(CALL_POLY_POLYLINE);
+	b.clear();
+	b.moveTo(0, 0);
+	b.lineTo(1, 1);
+	b.finish();
+	CHECK(!executor.runOps(b.page()));
+	CHECK_STR(executor.error(), "polyPolyline failed");
+}
+
+// The rules of the fixture pages: one call for all of them where the text is
+// drawn after the rules, instead of a moveTo and a lineTo per rule.
+static void test_fixture_calls(){
+	PageBuilder b;
+	int merge;
+	long calls[2][2], lines[2][2];
+	for(merge=0;merge<2;merge++){
+		RecordingDevice table(DPI, DPI), receipt(DPI, DPI);
+		table.setRecording(false);
+		receipt.setRecording(false);
+		PageExecutor onTable(&table), onReceipt(&receipt);
+		onTable.setMergePaths(merge != 0);
+		onReceipt.setMergePaths(merge != 0);
+		CHECK(onTable.runOps(fixture_a4_table(b, 40)));
+		CHECK(onReceipt.runOps(fixture_receipt(b, 20)));
+		calls[merge][0] = table.totalCount();
+		calls[merge][1] = receipt.totalCount();
+		lines[merge][0] = table.count(CALL_MOVE_TO) + table.count(CALL_LINE_TO) +
+			table.count(CALL_POLY_POLYLINE);
+		lines[merge][1] = receipt.count(CALL_MOVE_TO) + receipt.count(CALL_LINE_TO) +
+			receipt.count(CALL_POLY_POLYLINE);
+	}
+	// 41 rows and 4 columns
+	CHECK_EQ(lines[0][0], 90L);
+	CHECK_EQ(lines[1][0], 1L);
+	CHECK_EQ(calls[0][0] - calls[1][0], 89L);
+	// two separators with text between them
+	CHECK_EQ(lines[0][1], 4L);
+	CHECK_EQ(lines[1][1], 2L);
+	CHECK_EQ(calls[0][1] - calls[1][1], 2L);
+
+	// the same table drawn with one grid op
+	double xs[4], ys[41];
+	int i;
+	for(i=0;i<4;i++){
+		xs[i] = 15 + i * 60;
+	}
+	for(i=0;i<41;i++){
+		ys[i] = 20 + i * 6;
+	}
+	b.clear();
+	b.grid(b.addCoords(xs, 4), b.addCoords(ys, 41));
+	b.finish();
+	RecordingDevice device(DPI, DPI);
+	PageExecutor executor(&device);
+	CHECK(executor.runOps(b.page()));
+	CHECK_EQ(device.totalCount(), 2L);
+	CHECK_EQ(device.calls()[1].counts.size(), (size_t)45);
+}
+
+int main(){
+	test_builder();
+	test_shapes();
+	test_display_list();
+	test_transformed();
+	test_errors();
+	test_fixture_calls();
+	return test_summary("test-path-builder");
+}
@@ -0,0 +1,322 @@
+#include "test-util.h"
+#include "test-fixtures.h"
+#include "pdf-device.h"
+#include "inflate.h"
+#include <stdlib.h>
+#include <string.h>
+
+class BufferSource : public InflateSource {
+public:
+	BufferSource(const uint8_t *data, size_t length) : data_(data), length_(length) {}
+	bool next(const uint8_t **data, size_t *length){
+		if( length_ == 0 ){
+			return false;
+		}
+		*data = data_;
+		*length = length_;
+		length_ = 0;
+		return true;
+	}
+
+private:
+	const uint8_t *data_;
+	size_t length_;
+};
+
+// Fails every write after the first limit bytes.
+class FailingOutput : public PdfOutput {
+public:
+	explicit FailingOutput(size_t limit) : limit_(limit), written_(0) {}
+	bool write(const void *data, size_t length){
+		if( written_ + length > limit_ ){
+			return false;
+		}
+		written_ += length;
+		return true;
+	}
+
+private:
+	size_t limit_;
+	size_t written_;
+};
+
+static size_t count_of(const std::string &text, const std::string &what){
+	size_t n = 0, pos = 0;
+	while( (pos = text.find(what, pos)) != std::string::npos ){
+		n += 1;
+		pos += what.size();
+	}
+	return n;
+}
+
+// Checks the cross-reference table against the objects it points to and
+// returns the number of objects, 0 if the structure is broken.
+static size_t check_xref(const std::string &pdf){
+	size_t end = pdf.rfind("startxref\n");
+	if( pdf.compare(0, 9, "%PDF-1.4\n") != 0 || end == std::string::npos ||
+			pdf.compare(pdf.size() - 6, 6, "%%EOF\n") != 0 ){
+		return 0;
+	}
+	size_t xref = (size_t)strtoull(pdf.c_str() + end + 10, NULL, 10);
+	unsigned first, count;
+	if( pdf.compare(xref, 5, "xref\n") != 0 ||
+			sscanf(pdf.c_str() + xref + 5, "%u %u", &first, &count) != 2 || first != 0 ){
+		return 0;
+	}
+	size_t pos = pdf.find('\n', xref + 5) + 1, i;
+	if( pdf.compare(pos, 20, "0000000000 65535 f \n") != 0 ){
+		return 0;
+	}
+	for(i=1;i<count;i++){
+		const char *entry = pdf.c_str() + pos + i * 20;
+		char expected[32];
+		if( memcmp(entry + 10, " 00000 n \n", 10) != 0 ){
+			return 0;
+		}
+		size_t offset = (size_t)strtoull(entry, NULL, 10);
+		snprintf(expected, sizeof(expected), "%u 0 obj\n", (unsigned)i);
+		if( pdf.compare(offset, strlen(expected), expected) != 0 ){
+			return 0;
+		}
+	}
+	char trailer[64];
+	snprintf(trailer, sizeof(trailer), "trailer\n<< /Size %u /Root 1 0 R", count);
+	if( pdf.find(trailer, pos + count * 20 - 20) == std::string::npos ){
+		return 0;
+	}
+	return count - 1;
+}
+
+// Content streams of the document, inflated when compressed.
+static std::vector<std::string> contents(const std::string &pdf){
+	std::vector<std::string> out;
+	size_t pos = 0;
+	while( (pos = pdf.find("<< /Length ", pos)) != std::string::npos ){
+		size_t length = (size_t)strtoull(pdf.c_str() + pos + 11, NULL, 10);
+		bool flate = pdf.compare(pdf.find(' ', pos + 11), 21, " /Filter /FlateDecode") == 0;
+		size_t start = pdf.find("stream\n", pos) + 7;
+		std::string data = pdf.substr(start, length);
+		if( flate ){
+			BufferSource source((const uint8_t *)data.data(), data.size());
+			Inflater inflater(&source);
+			std::string err;
+			std::vector<uint8_t> plain(1 << 20);
+			size_t n = 0;
+			// read byte by byte until the stream ends
+			while( n < plain.size() && inflater.read(&plain[n], 1, &err) ){
+				n += 1;
+			}
+			data.assign((const char *)&plain[0], n);
+		}
+		out.push_back(data);
+		pos = start + length;
+	}
+	return out;
+}
+
+static void test_content(){
+	static const uint16_t text[] = { 'A', '(', 0x20ac, 0x3042 };
+	static const int advances[] = { 10, 12, 14, 16 };
+	static const uint16_t title[] = { 'j', 'o', 'b' };
+	std::vector<uint8_t> bytes;
+	PdfBufferOutput out(&bytes);
+	PdfOptions opts;
+	opts.dpi = 720;
+	opts.width = 100;
+	opts.height = 0;
+	opts.compress = false;
+	PdfDevice device(&out, opts);
+	CHECK(device.startDoc(title, 3));
+	CHECK(device.startPage());
+	DeviceHandle pen = device.createPen(5, 255, 0, 0);
+	std::vector<uint16_t> face = u16("Arial");
+	DeviceHandle font = device.createFont(&face[0], (uint32_t)face.size(), 100, FONT_WEIGHT_BOLD, 0);
+	CHECK(device.moveTo(10, 20));
+	CHECK(device.lineTo(110, 20));
+	CHECK(device.lineTo(110, 120));
+	CHECK(device.selectObject(pen));
+	CHECK(device.moveTo(0, 200));
+	CHECK(device.lineTo(50, 200));
+	CHECK(device.fillRect(20, 300, 80, 320, 0, 0, 0));
+	CHECK(!device.textOut(0, 0, text, 1));
+	CHECK_STR(device.error(), "no font selected");
+	CHECK(device.selectObject(font));
+	CHECK(device.setTextColor(0, 0, 255));
+	CHECK(device.textRun(300, 400, text, 4, advances));
+	CHECK(device.textOut(300, 600, text, 2));
+	CHECK(device.endPage());
+	CHECK(device.endDoc());
+	CHECK_EQ(device.pageCount(), (size_t)1);
+	CHECK_EQ(device.bytesWritten(), (uint64_t)bytes.size());
+
+	std::string pdf(bytes.begin(), bytes.end());
+	CHECK_EQ(check_xref(pdf), (size_t)7);
+	std::vector<std::string> streams = contents(pdf);
+	CHECK_EQ(streams.size(), (size_t)1);
+	// device pixels at 720 dpi are 0.1 pt; the page ends below the text
+	// (700 pixels), the path is stroked when the pen changes or a rectangle
+	// is filled, and each character of a run is placed at its advance
+	CHECK_STR(streams[0],
+		"q 0.1 0 0 -0.1 0 70 cm 1 J 1 j\n"
+		"1 w\n0 0 0 RG\n10 20 m\n110 20 l\n110 120 l\nS\n"
+		"5 w\n1 0 0 RG\n0 200 m\n50 200 l\nS\n"
+		"0 0 0 rg\n20 300 60 20 re f\n"
+		"0 0 1 rg\nBT\n/F1 89.5 Tf\n1 0 0 -1 300 481 Tm\n"
+		"(A)Tj\n10 0 Td(\\()Tj\n12 0 Td(\x80)Tj\n14 0 Td(?)Tj\nET\n"
+		"BT\n1 0 0 -1 300 681 Tm\n(A\\()Tj\nET\nQ\n");
+	CHECK(pdf.find("/MediaBox [0 0 283.4646 70]") != std::string::npos);
+	CHECK(pdf.find("/BaseFont /Helvetica-Bold /Encoding /WinAnsiEncoding") != std::string::npos);
+	CHECK(pdf.find("/Font << /F1 7 0 R >>") != std::string::npos);
+	CHECK(pdf.find("/Count 1 /Kids [6 0 R ] >>") != std::string::npos);
+	CHECK(pdf.find("/Title <FEFF006A006F0062>") != std::string::npos);
+
+	CHECK(!device.endPage());
+	CHECK(!device.selectObject(99));
+	CHECK(device.deleteObject(font));
+	CHECK(!device.selectObject(font));
+}
+
+static void test_faces(){
+	static const char *const faces[] = { "MS Gothic", "Times New Roman", "MS Mincho",
+		"Courier New", "DejaVu Sans Mono", "Noto Sans" };
+	static const char *const fonts[] = { "Helvetica-Oblique", "Times-Italic", "Times-Italic",
+		"Courier-Oblique", "Courier-Oblique", "Helvetica-Oblique" };
+	size_t i;
+	for(i=0;i<sizeof(faces)/sizeof(faces[0]);i++){
+		std::vector<uint8_t> bytes;
+		PdfBufferOutput out(&bytes);
+		PdfDevice device(&out, PdfOptions());
+		std::vector<uint16_t> face = u16(faces[i]), text = u16("x");
+		device.startDoc(NULL, 0);
+		device.startPage();
+		device.selectObject(device.createFont(&face[0], (uint32_t)face.size(), 50, 0, 1));
+		device.textOut(0, 0, &text[0], 1);
+		device.endPage();
+		CHECK(device.endDoc());
+		std::string pdf(bytes.begin(), bytes.end());
+		CHECK(pdf.find(std::string("/BaseFont /") + fonts[i] + " ") != std::string::npos);
+	}
+	// 明朝
+	static const uint16_t mincho[] = { 0xff2d, 0xff33, ' ', 0x660e, 0x671d };
+	std::vector<uint8_t> bytes;
+	PdfBufferOutput out(&bytes);
+	PdfDevice device(&out, PdfOptions());
+	static const uint16_t x[] = { 'x' };
+	device.startDoc(NULL, 0);
+	device.startPage();
+	device.selectObject(device.createFont(mincho, 5, 50, 0, 0));
+	device.textOut(0, 0, x, 1);
+	device.endPage();
+	device.endDoc();
+	std::string pdf(bytes.begin(), bytes.end());
+	CHECK(pdf.find("/BaseFont /Times-Roman ") != std::string::npos);
+}
+
+// A long job: fonts are shared by all pages, every page has its own
+// compressed content stream, and the document structure holds together.
+static void test_document(){
+	PageBuilder receipt, table;
+	fixture_receipt(receipt, 20);
+	fixture_a4_table(table, 30);
+	std::vector<const Page *> pages;
+	size_t i;
+	for(i=0;i<300;i++){
+		pages.push_back(i % 3 == 2 ? &table.page() : &receipt.page());
+	}
+	std::vector<uint8_t> bytes;
+	PdfBufferOutput out(&bytes);
+	PdfOptions opts;
+	std::string err;
+	CHECK(render_pdf(&pages[0], pages.size(), opts, NULL, 0, &out, &err));
+	std::string pdf(bytes.begin(), bytes.end());
+	// 4 fixed objects, 2 per page and 4 fonts: MS Gothic and MS Mincho, bold
+	// and regular
+	CHECK_EQ(check_xref(pdf), (size_t)(4 + 300 * 2 + 4));
+	CHECK(pdf.find("/Count 300 ") != std::string::npos);
+	CHECK_EQ(count_of(pdf, "/Type /Font "), (size_t)4);
+	CHECK_EQ(count_of(pdf, "/Resources 3 0 R"), (size_t)300);
+	CHECK_EQ(count_of(pdf, "/Filter /FlateDecode"), (size_t)300);
+	std::vector<std::string> streams = contents(pdf);
+	CHECK_EQ(streams.size(), (size_t)300);
+	CHECK(streams[0] == streams[1]);
+	CHECK(streams[0].compare(0, 2, "q ") == 0);
+	CHECK(streams[0].find("(R)Tj") != std::string::npos);
+	CHECK(streams[2].find("Tf\n") != std::string::npos);
+	CHECK_EQ(streams[2].substr(streams[2].size() - 2), "Q\n");
+	// the pen is set once per page for all the rules of a table
+	CHECK_EQ(count_of(streams[2], " w\n"), (size_t)1);
+
+	opts.compress = false;
+	std::vector<uint8_t> plain;
+	PdfBufferOutput plainOut(&plain);
+	CHECK(render_pdf(&pages[0], 3, opts, NULL, 0, &plainOut, &err));
+	std::vector<std::string> plainStreams = contents(std::string(plain.begin(), plain.end()));
+	CHECK_EQ(plainStreams.size(), (size_t)3);
+	CHECK(plainStreams[2] == streams[2]);
+	// receipts with height 0 are as long as their content: 115 mm
+	opts.height = 0;
+	plain.clear();
+	CHECK(render_pdf(&pages[0], 1, opts, NULL, 0, &plainOut, &err));
+	std::string receiptPdf(plain.begin(), plain.end());
+	CHECK(receiptPdf.find("/MediaBox [0 0 595.2756 325.8]") != std::string::npos);
+}
+
+static void test_errors(){
+	PageBuilder receipt;
+	fixture_receipt(receipt, 5);
+	const Page *pages[] = { &receipt.page() };
+	PdfOptions opts;
+	std::string err;
+	size_t limits[] = { 0, 20, 600, 1300 };
+	size_t i;
+	for(i=0;i<sizeof(limits)/sizeof(limits[0]);i++){
+		FailingOutput out(limits[i]);
+		err.clear();
+		CHECK(!render_pdf(pages, 1, opts, NULL, 0, &out, &err));
+		CHECK(err.find("cannot write pdf output") != std::string::npos);
+	}
+	opts.dpi = 0;
+	std::vector<uint8_t> bytes;
+	PdfBufferOutput out(&bytes);
+	CHECK(!render_pdf(pages, 1, opts, NULL, 0, &out, &err));
+	CHECK_STR(err, "invalid pdf options");
+
+	PdfDevice device(&out, PdfOptions());
+	CHECK(!device.startPage());
+	CHECK(!device.endDoc());
+	CHECK(device.startDoc(NULL, 0));
+	CHECK(!device.startDoc(NULL, 0));
+	CHECK(device.abortDoc());
+	CHECK(!device.startPage());
+}
+
+static void test_file(){
+	PageBuilder receipt;
+	fixture_receipt(receipt, 5);
+	const Page *pages[] = { &receipt.page(), &receipt.page() };
+	std::string err;
+	FILE *file = tmpfile();
+	CHECK(file != NULL);
+	if( !file ){
+		return;
+	}
+	PdfFileOutput out(file);
+	CHECK(render_pdf(pages, 2, PdfOptions(), NULL, 0, &out, &err));
+	fflush(file);
+	long size = ftell(file);
+	std::string pdf((size_t)size, '\0');
+	rewind(file);
+	CHECK_EQ(fread(&pdf[0], 1, pdf.size(), file), pdf.size());
+	CHECK_EQ(check_xref(pdf), (size_t)10);
+	CHECK_EQ(out.bytes(), (uint64_t)size);
+	CHECK(out.close(&err));
+}
+
+int main(){
+	test_content();
+	test_faces();
+	test_document();
+	test_errors();
+	test_file();
+	return test_summary("test-pdf-device");
+}
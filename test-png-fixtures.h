@@ -0,0 +1,1175 @@
+#ifndef DRAWER_TEST_PNG_FIXTURES_H
+#define DRAWER_TEST_PNG_FIXTURES_H
+
+// Reference PNGs for test-png-image, written with Python's zlib (stored,
+// fixed, dynamic, Huffman-only and RLE deflate streams; rgba8 is split into
+// 97-byte IDAT chunks). Sample c of pixel (x, y) is png_fixture_sample();
+// row y uses filter (y + color type) % 5. Gray and RGB images with
+// transparency make the value of pixel (1, 0) transparent; palette entry i
+// is (7i + 3, 13i + 5, 29i + 11) with alpha 61i for the first 10 entries.
+
+#include <stddef.h>
+#include <stdint.h>
+
+static inline uint32_t png_fixture_sample(uint32_t x, uint32_t y, uint32_t c, uint32_t depth){
+	uint32_t v = x * 37 + y * 91 + c * 53 + x * y * 7;
+	if( depth == 16 ){
+		return (v * 257 + x * 13) & 0xffff;
+	}
+	return v & ((1u << depth) - 1);
+}
+
+struct PngFixture {
+	const char *name;
+	uint32_t colorType;
+	uint32_t bitDepth;
+	uint32_t width;
+	uint32_t height;
+	bool transparency;
+	const uint8_t *data;
+	size_t length;
+};
+
+static const uint8_t png_gray1[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x07, 0x01, 0x00, 0x00, 0x00, 0x00, 0xfb, 0x0b, 0xfa,
+	0xb7, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+	0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x1e,
+	0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x08, 0x0d, 0x60, 0xfc, 0xff, 0x93, 0x29, 0x2c, 0x82,
+	0xf9, 0x6a, 0x20, 0x4b, 0xd8, 0x6f, 0x86, 0xff, 0x3f, 0x18, 0x43, 0x7f, 0x03, 0x00, 0x57, 0x2d,
+	0x09, 0x15, 0xf2, 0x05, 0x82, 0x41, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42,
+	0x60, 0x82,
+};
+
+static const uint8_t png_gray2[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x07, 0x02, 0x00, 0x00, 0x00, 0x00, 0xbc, 0xab, 0x80,
+	0x67, 0x00, 0x00, 0x00, 0x02, 0x74, 0x52, 0x4e, 0x53, 0x00, 0x01, 0x01, 0x94, 0xfd, 0xae, 0x00,
+	0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 0x00, 0x66,
+	0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x2e, 0x49, 0x44,
+	0x41, 0x54, 0x78, 0xda, 0x01, 0x23, 0x00, 0xdc, 0xff, 0x00, 0x1b, 0x1b, 0x1b, 0x00, 0x01, 0xff,
+	0x00, 0x00, 0xc1, 0x02, 0x94, 0x94, 0x94, 0xc0, 0x03, 0x2e, 0xf2, 0xf2, 0xc5, 0x04, 0xa4, 0x00,
+	0x00, 0xe5, 0x00, 0xff, 0xff, 0xff, 0xc0, 0x01, 0x93, 0x00, 0x00, 0xed, 0xd6, 0xc2, 0x0e, 0x36,
+	0x09, 0x43, 0x6f, 0x61, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_gray4[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x07, 0x04, 0x00, 0x00, 0x00, 0x00, 0x33, 0xeb, 0x75,
+	0xc7, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+	0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x3a,
+	0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x63, 0x60, 0x5d, 0xef, 0xf9, 0xb8, 0x57, 0xfd, 0x00, 0xe3,
+	0xf6, 0x8e, 0x0a, 0x20, 0x2c, 0x64, 0xda, 0x34, 0x21, 0xcf, 0x47, 0x8b, 0xe3, 0x03, 0xf3, 0xf3,
+	0x57, 0x81, 0x1e, 0xf6, 0x7a, 0x82, 0x2c, 0x9b, 0x94, 0x84, 0x94, 0x80, 0x7c, 0x86, 0x7a, 0x30,
+	0x28, 0x60, 0x54, 0x7c, 0x77, 0x0f, 0x08, 0x6e, 0x02, 0x00, 0x7d, 0xe0, 0x18, 0x0a, 0xf2, 0x58,
+	0x9a, 0xa3, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_gray8[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x07, 0x08, 0x00, 0x00, 0x00, 0x00, 0xf6, 0x1b, 0x98,
+	0xc6, 0x00, 0x00, 0x00, 0x02, 0x74, 0x52, 0x4e, 0x53, 0x00, 0x25, 0x3d, 0x97, 0x19, 0x7f, 0x00,
+	0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 0x00, 0x66,
+	0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x6d, 0x49, 0x44,
+	0x41, 0x54, 0x78, 0x01, 0x01, 0x62, 0x00, 0x9d, 0xff, 0x00, 0x00, 0x25, 0x4a, 0x6f, 0x94, 0xb9,
+	0xde, 0x03, 0x28, 0x4d, 0x72, 0x97, 0xbc, 0x01, 0x5b, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x2c,
+	0x2c, 0x2c, 0x2c, 0x2c, 0x2c, 0x02, 0x5b, 0x62, 0x69, 0x70, 0x77, 0x7e, 0x85, 0x8c, 0x93, 0x9a,
+	0xa1, 0xa8, 0xaf, 0x03, 0xb6, 0xce, 0x52, 0x55, 0x59, 0x5c, 0xe0, 0x63, 0x67, 0x6a, 0xee, 0xf1,
+	0x75, 0x04, 0x5b, 0x41, 0x41, 0x41, 0x41, 0x7e, 0x41, 0x41, 0x41, 0x9a, 0x41, 0x41, 0xe9, 0x00,
+	0xc7, 0x0f, 0x57, 0x9f, 0xe7, 0x2f, 0x77, 0xbf, 0x07, 0x4f, 0x97, 0xdf, 0x27, 0x01, 0x22, 0x4f,
+	0x4f, 0x4f, 0x4f, 0x4f, 0x4f, 0x4f, 0x4f, 0x4f, 0x4f, 0x4f, 0x4f, 0xd8, 0x19, 0x24, 0x4c, 0xbd,
+	0x07, 0x95, 0xaf, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_gray16[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x05, 0x10, 0x00, 0x00, 0x00, 0x00, 0xe2, 0xa8, 0x45,
+	0xf4, 0x00, 0x00, 0x00, 0x02, 0x74, 0x52, 0x4e, 0x53, 0x25, 0x32, 0x56, 0xb7, 0x4c, 0x5f, 0x00,
+	0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 0x00, 0x66,
+	0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x61, 0x49, 0x44,
+	0x41, 0x54, 0x78, 0xda, 0x63, 0x60, 0x60, 0x50, 0x35, 0xf2, 0x4a, 0xc9, 0x9f, 0x36, 0xe5, 0xc4,
+	0xce, 0x5f, 0xf7, 0x75, 0x58, 0xe2, 0x34, 0x27, 0x30, 0x46, 0x47, 0xeb, 0x58, 0xea, 0x58, 0xea,
+	0x5a, 0xea, 0x40, 0xa1, 0xae, 0x25, 0x53, 0x74, 0x74, 0x52, 0x52, 0x56, 0x66, 0x41, 0x41, 0x79,
+	0x79, 0x5d, 0x5d, 0x5b, 0x6b, 0x6f, 0xcf, 0xe4, 0xc9, 0xcc, 0xdb, 0xb7, 0x9d, 0xbf, 0x1a, 0x14,
+	0x11, 0x1a, 0x13, 0x15, 0x1f, 0xfb, 0xf8, 0x41, 0x5a, 0x4a, 0x56, 0xfa, 0x5b, 0x96, 0xe8, 0x68,
+	0x47, 0x3f, 0x27, 0x3f, 0x47, 0x3f, 0xc7, 0xf2, 0x3a, 0x10, 0xdd, 0xe3, 0xe8, 0x07, 0x00, 0x3f,
+	0x80, 0x23, 0x2c, 0x2a, 0xce, 0x82, 0xaf, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae,
+	0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_rgb8[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x0b, 0x08, 0x02, 0x00, 0x00, 0x00, 0x16, 0x42, 0xf1,
+	0x50, 0x00, 0x00, 0x00, 0x06, 0x74, 0x52, 0x4e, 0x53, 0x00, 0x25, 0x00, 0x5a, 0x00, 0x8f, 0x7b,
+	0xab, 0x92, 0x32, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65,
+	0x6e, 0x74, 0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00,
+	0x02, 0x24, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x05, 0xc1, 0x5f, 0x48, 0x13, 0x71, 0x1c, 0x00,
+	0x70, 0xe7, 0x64, 0x0f, 0x31, 0x1f, 0x6c, 0xe0, 0x8b, 0xf4, 0x64, 0x45, 0x7f, 0xa0, 0x97, 0x6f,
+	0x82, 0x20, 0x3d, 0x7c, 0x7b, 0x68, 0xd1, 0x95, 0x88, 0xe0, 0x8f, 0xd6, 0x6f, 0xc1, 0xb1, 0x7d,
+	0x61, 0xde, 0x48, 0xbb, 0x49, 0xeb, 0x46, 0xc9, 0xcd, 0x8a, 0x2b, 0x18, 0x27, 0x96, 0x57, 0x14,
+	0x07, 0x16, 0x17, 0x81, 0x17, 0x04, 0x47, 0x90, 0x17, 0x49, 0x63, 0x3d, 0x1c, 0x85, 0x5c, 0xf6,
+	0x20, 0xa9, 0x0d, 0x4c, 0x50, 0x23, 0x99, 0x0f, 0x33, 0xa1, 0xa1, 0xd2, 0x18, 0x7d, 0x3e, 0xcd,
+	0x4d, 0x5d, 0xe9, 0x23, 0x57, 0x26, 0x2e, 0xe4, 0xdf, 0x5d, 0x7f, 0x55, 0x7e, 0x3c, 0xd7, 0xf8,
+	0x50, 0xed, 0x5c, 0x8d, 0x9c, 0x0f, 0x76, 0x0f, 0x1d, 0xbb, 0x3a, 0x79, 0xe9, 0xee, 0xfb, 0x91,
+	0xe9, 0x95, 0xa7, 0x5f, 0x03, 0x1f, 0x77, 0x8e, 0xae, 0xb5, 0x0b, 0xa1, 0x1e, 0xf9, 0xa4, 0xf8,
+	0xa4, 0x4f, 0x9b, 0x0d, 0xf2, 0x9b, 0x0f, 0xa3, 0xd1, 0xa8, 0x20, 0x08, 0xbd, 0xbd, 0xdf, 0xfa,
+	0x17, 0x16, 0x16, 0x17, 0x07, 0xca, 0xb1, 0x58, 0x3c, 0x1e, 0x17, 0x45, 0x31, 0x99, 0xdc, 0x48,
+	0x6d, 0x6e, 0x6e, 0x6d, 0xa5, 0xab, 0xd5, 0xe1, 0x9d, 0x4c, 0x26, 0x9b, 0xad, 0xe5, 0x72, 0x7b,
+	0xa3, 0xf5, 0x7a, 0x0b, 0xe7, 0x1c, 0x00, 0x00, 0x24, 0x90, 0x41, 0x01, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x03, 0x4c, 0xb0, 0x00, 0x00, 0x00, 0x00, 0xd6, 0xd7, 0xdd, 0x4a, 0x05, 0xfe, 0x78,
+	0xe0, 0xc3, 0x6e, 0x53, 0xdb, 0xb9, 0xdb, 0xc2, 0xd8, 0x8c, 0x36, 0xbb, 0x5d, 0xfa, 0x7b, 0x7c,
+	0xff, 0x54, 0x12, 0x06, 0xa7, 0x86, 0x5e, 0x2e, 0x4f, 0xaf, 0xb4, 0xad, 0xb5, 0x0b, 0x1d, 0x7d,
+	0xda, 0x40, 0xa1, 0x34, 0xe1, 0xed, 0xcf, 0x35, 0x20, 0xd8, 0x3d, 0x74, 0x66, 0x64, 0x5a, 0x79,
+	0xb3, 0xf6, 0xf6, 0x77, 0x47, 0xe0, 0x9a, 0xb5, 0x84, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,
+	0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,
+	0xd8, 0xcc, 0x39, 0x4f, 0x24, 0x12, 0x92, 0x24, 0xc9, 0xb2, 0xac, 0x28, 0x8a, 0xaa, 0xaa, 0x9a,
+	0xa6, 0xe9, 0xba, 0x6e, 0x18, 0x86, 0x69, 0x9a, 0x96, 0x65, 0xd9, 0xb6, 0xed, 0x38, 0x8e, 0xeb,
+	0xba, 0xc5, 0x62, 0xd1, 0xf3, 0x3c, 0xdf, 0xf7, 0x83, 0xa5, 0xf2, 0x8d, 0x58, 0x2c, 0x16, 0x8f,
+	0xc7, 0x45, 0x51, 0xdc, 0x48, 0x26, 0x53, 0xa9, 0x54, 0x3a, 0xbd, 0x35, 0x5c, 0x1d, 0xce, 0x64,
+	0x32, 0xd9, 0x6c, 0x2d, 0xb7, 0x97, 0xab, 0x8f, 0x8e, 0xe6, 0xf3, 0xf9, 0x7b, 0xc1, 0x60, 0x28,
+	0x74, 0xff, 0x40, 0xa1, 0x30, 0x3e, 0xde, 0xda, 0xc2, 0x39, 0x67, 0x8c, 0x31, 0x26, 0xc9, 0x32,
+	0x63, 0x8c, 0xb1, 0x79, 0xf5, 0xbb, 0xc6, 0x74, 0xc6, 0xd8, 0xba, 0x51, 0x31, 0x99, 0xc5, 0x18,
+	0xdb, 0xdd, 0x6d, 0x38, 0x8e, 0xcb, 0x18, 0x0b, 0x87, 0x23, 0x11, 0xcf, 0xf7, 0x59, 0xd3, 0x8f,
+	0xd6, 0xb3, 0x5d, 0xe9, 0x17, 0x93, 0x5f, 0xea, 0xdb, 0x87, 0x63, 0x17, 0xef, 0xb8, 0xaf, 0x57,
+	0x23, 0xa1, 0x1e, 0x39, 0xf9, 0x6c, 0xfe, 0x53, 0xed, 0xc4, 0xa1, 0xfe, 0x07, 0xb7, 0x9c, 0x5f,
+	0xcb, 0x61, 0x3c, 0x2d, 0x3d, 0x7f, 0xf4, 0xf9, 0x5f, 0xb5, 0xf3, 0xb2, 0x30, 0x36, 0x63, 0xff,
+	0x3c, 0x18, 0x80, 0xc1, 0x29, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22,
+	0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0xa2, 0x66, 0xce, 0x79,
+	0x22, 0x91, 0x90, 0x24, 0x49, 0x96, 0x65, 0x45, 0x51, 0x54, 0x55, 0xd5, 0x34, 0x4d, 0xd7, 0x75,
+	0xc3, 0x30, 0x4c, 0xd3, 0xb4, 0x2c, 0xcb, 0xb6, 0x6d, 0xc7, 0x71, 0x5c, 0xd7, 0x2d, 0x16, 0x8b,
+	0x9e, 0xe7, 0xf9, 0xbe, 0xff, 0x1f, 0x93, 0x56, 0x07, 0x63, 0x95, 0x61, 0xac, 0x19, 0x00, 0x00,
+	0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_rgb16[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x05, 0x10, 0x02, 0x00, 0x00, 0x00, 0x48, 0xa1, 0x8d,
+	0x7f, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+	0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0xeb,
+	0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x62, 0x60, 0x30, 0x35, 0xcd, 0xca, 0x52, 0x35, 0x8a,
+	0x4a, 0xef, 0x9f, 0xe3, 0x95, 0x52, 0x3f, 0x73, 0xcb, 0xb9, 0xfc, 0x69, 0x4b, 0x4e, 0xdf, 0x62,
+	0x98, 0x72, 0xe2, 0xe4, 0xdf, 0xff, 0x46, 0x3b, 0x7f, 0xbd, 0xd7, 0x57, 0x49, 0xb9, 0xaf, 0x23,
+	0x92, 0xe8, 0x39, 0x8d, 0x25, 0xce, 0x72, 0x72, 0xde, 0x09, 0xcd, 0x09, 0x71, 0x47, 0x27, 0xff,
+	0x62, 0x8e, 0x8e, 0x2e, 0x2b, 0x9b, 0x30, 0xc1, 0xdd, 0x0f, 0x04, 0xbd, 0x03, 0x7d, 0x80, 0xd0,
+	0x3f, 0xd4, 0xff, 0xea, 0xb9, 0xd0, 0xa0, 0x1b, 0x97, 0x6e, 0x5c, 0x8a, 0xb8, 0x76, 0xe7, 0x6a,
+	0x4c, 0x68, 0xcc, 0xcd, 0xf8, 0xc8, 0xf8, 0xa8, 0xf8, 0x98, 0xe4, 0xd8, 0xe4, 0xd8, 0xc7, 0x89,
+	0x69, 0x09, 0xcf, 0x12, 0x9e, 0xb1, 0x44, 0x03, 0x41, 0x4c, 0xb4, 0xb1, 0x83, 0x89, 0x03, 0x18,
+	0x67, 0x66, 0x66, 0x1a, 0x17, 0x14, 0x00, 0xd9, 0xe5, 0x0e, 0x70, 0x31, 0x30, 0x36, 0x6e, 0x05,
+	0xe2, 0x1e, 0x20, 0x9e, 0x6c, 0xec, 0x30, 0xc5, 0x81, 0x41, 0x48, 0xd0, 0xdd, 0xad, 0xa6, 0xda,
+	0x27, 0xa2, 0xb1, 0x77, 0xdb, 0xa1, 0xb6, 0xf9, 0xbb, 0xaf, 0x7c, 0xe4, 0x3c, 0xf0, 0xec, 0x9b,
+	0xb4, 0x76, 0xc0, 0x6f, 0x5d, 0x83, 0xa4, 0xd4, 0xe9, 0xa6, 0x25, 0x59, 0x2b, 0xe7, 0xdf, 0xcb,
+	0xdf, 0xbd, 0xe4, 0xc3, 0x2d, 0xd5, 0x55, 0x4c, 0xf7, 0xcd, 0x45, 0x72, 0x9e, 0x78, 0x4a, 0xd6,
+	0xf9, 0x6d, 0x66, 0xcc, 0xcd, 0x59, 0xb4, 0xf0, 0xfa, 0x35, 0x47, 0x3f, 0x47, 0x3f, 0x27, 0x30,
+	0x74, 0x44, 0x82, 0x4e, 0x48, 0x18, 0x59, 0xd4, 0xc9, 0x0f, 0x00, 0xc1, 0x2d, 0x6e, 0x94, 0xf1,
+	0xe0, 0xbb, 0x37, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_palette1[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x07, 0x01, 0x03, 0x00, 0x00, 0x00, 0xe9, 0xbe, 0x55,
+	0x59, 0x00, 0x00, 0x00, 0x06, 0x50, 0x4c, 0x54, 0x45, 0x03, 0x05, 0x0b, 0x0a, 0x12, 0x28, 0x7c,
+	0xc4, 0x9e, 0xef, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65,
+	0x6e, 0x74, 0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00,
+	0x00, 0x1d, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x0e, 0x55, 0x63, 0x59, 0xf5, 0x93, 0x21,
+	0x34, 0x80, 0xf1, 0xff, 0x4f, 0xa6, 0xb0, 0x08, 0xe6, 0xab, 0x81, 0x2c, 0x61, 0xbf, 0x01, 0x4e,
+	0xb9, 0x07, 0xf2, 0x08, 0x40, 0xd8, 0x1b, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae,
+	0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_palette2[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x07, 0x02, 0x03, 0x00, 0x00, 0x00, 0xae, 0x1e, 0x2f,
+	0x89, 0x00, 0x00, 0x00, 0x0c, 0x50, 0x4c, 0x54, 0x45, 0x03, 0x05, 0x0b, 0x0a, 0x12, 0x28, 0x11,
+	0x1f, 0x45, 0x18, 0x2c, 0x62, 0x92, 0x6a, 0x99, 0x90, 0x00, 0x00, 0x00, 0x04, 0x74, 0x52, 0x4e,
+	0x53, 0x00, 0x3d, 0x7a, 0xb7, 0x1f, 0xf5, 0xa7, 0x0a, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58,
+	0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65,
+	0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x2c, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x96,
+	0xe6, 0xe3, 0xfb, 0xcc, 0xf2, 0x84, 0x81, 0xe1, 0x20, 0xc3, 0xe4, 0xc9, 0x93, 0x1b, 0x18, 0xcb,
+	0x19, 0x18, 0x4e, 0x32, 0x2d, 0x59, 0xb2, 0xe4, 0x00, 0xf3, 0xa7, 0xa2, 0x22, 0x47, 0x96, 0x29,
+	0x0c, 0x0c, 0x6f, 0x01, 0xd0, 0x1a, 0x0c, 0x9e, 0x5c, 0x3d, 0xf8, 0x93, 0x00, 0x00, 0x00, 0x00,
+	0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_palette4[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x0d, 0x00, 0x00, 0x00, 0x07, 0x04, 0x03, 0x00, 0x00, 0x00, 0x21, 0x5e, 0xda,
+	0x29, 0x00, 0x00, 0x00, 0x30, 0x50, 0x4c, 0x54, 0x45, 0x03, 0x05, 0x0b, 0x0a, 0x12, 0x28, 0x11,
+	0x1f, 0x45, 0x18, 0x2c, 0x62, 0x1f, 0x39, 0x7f, 0x26, 0x46, 0x9c, 0x2d, 0x53, 0xb9, 0x34, 0x60,
+	0xd6, 0x3b, 0x6d, 0xf3, 0x42, 0x7a, 0x10, 0x49, 0x87, 0x2d, 0x50, 0x94, 0x4a, 0x57, 0xa1, 0x67,
+	0x5e, 0xae, 0x84, 0x65, 0xbb, 0xa1, 0x6c, 0xc8, 0xbe, 0xce, 0x32, 0x92, 0x89, 0x00, 0x00, 0x00,
+	0x0a, 0x74, 0x52, 0x4e, 0x53, 0x00, 0x3d, 0x7a, 0xb7, 0xf4, 0x31, 0x6e, 0xab, 0xe8, 0x25, 0xb5,
+	0xa9, 0x96, 0xb0, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65,
+	0x6e, 0x74, 0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00,
+	0x00, 0x41, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x63, 0x66, 0x5d, 0xfb, 0x69, 0xbf, 0xcc, 0xc3,
+	0xb5, 0x2c, 0x9b, 0x3a, 0x2a, 0x62, 0x2a, 0x24, 0x3e, 0x30, 0x64, 0x9e, 0x57, 0xed, 0x7e, 0xe8,
+	0xbe, 0x80, 0x51, 0xda, 0xc5, 0xc4, 0xc5, 0xc5, 0xc5, 0x90, 0x69, 0xd3, 0x84, 0x3c, 0x1f, 0x2d,
+	0x8e, 0x0f, 0xcc, 0x92, 0x27, 0xec, 0xf5, 0x64, 0x79, 0x3e, 0xb2, 0x2c, 0x7a, 0x77, 0x0f, 0x08,
+	0x1e, 0x02, 0x00, 0x91, 0xce, 0x18, 0x5c, 0xd5, 0x33, 0x69, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x49,
+	0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_palette8[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x0d, 0x08, 0x03, 0x00, 0x00, 0x00, 0x71, 0x4c, 0xd5,
+	0x52, 0x00, 0x00, 0x03, 0x00, 0x50, 0x4c, 0x54, 0x45, 0x03, 0x05, 0x0b, 0x0a, 0x12, 0x28, 0x11,
+	0x1f, 0x45, 0x18, 0x2c, 0x62, 0x1f, 0x39, 0x7f, 0x26, 0x46, 0x9c, 0x2d, 0x53, 0xb9, 0x34, 0x60,
+	0xd6, 0x3b, 0x6d, 0xf3, 0x42, 0x7a, 0x10, 0x49, 0x87, 0x2d, 0x50, 0x94, 0x4a, 0x57, 0xa1, 0x67,
+	0x5e, 0xae, 0x84, 0x65, 0xbb, 0xa1, 0x6c, 0xc8, 0xbe, 0x73, 0xd5, 0xdb, 0x7a, 0xe2, 0xf8, 0x81,
+	0xef, 0x15, 0x88, 0xfc, 0x32, 0x8f, 0x09, 0x4f, 0x96, 0x16, 0x6c, 0x9d, 0x23, 0x89, 0xa4, 0x30,
+	0xa6, 0xab, 0x3d, 0xc3, 0xb2, 0x4a, 0xe0, 0xb9, 0x57, 0xfd, 0xc0, 0x64, 0x1a, 0xc7, 0x71, 0x37,
+	0xce, 0x7e, 0x54, 0xd5, 0x8b, 0x71, 0xdc, 0x98, 0x8e, 0xe3, 0xa5, 0xab, 0xea, 0xb2, 0xc8, 0xf1,
+	0xbf, 0xe5, 0xf8, 0xcc, 0x02, 0xff, 0xd9, 0x1f, 0x06, 0xe6, 0x3c, 0x0d, 0xf3, 0x59, 0x14, 0x00,
+	0x76, 0x1b, 0x0d, 0x93, 0x22, 0x1a, 0xb0, 0x29, 0x27, 0xcd, 0x30, 0x34, 0xea, 0x37, 0x41, 0x07,
+	0x3e, 0x4e, 0x24, 0x45, 0x5b, 0x41, 0x4c, 0x68, 0x5e, 0x53, 0x75, 0x7b, 0x5a, 0x82, 0x98, 0x61,
+	0x8f, 0xb5, 0x68, 0x9c, 0xd2, 0x6f, 0xa9, 0xef, 0x76, 0xb6, 0x0c, 0x7d, 0xc3, 0x29, 0x84, 0xd0,
+	0x46, 0x8b, 0xdd, 0x63, 0x92, 0xea, 0x80, 0x99, 0xf7, 0x9d, 0xa0, 0x04, 0xba, 0xa7, 0x11, 0xd7,
+	0xae, 0x1e, 0xf4, 0xb5, 0x2b, 0x11, 0xbc, 0x38, 0x2e, 0xc3, 0x45, 0x4b, 0xca, 0x52, 0x68, 0xd1,
+	0x5f, 0x85, 0xd8, 0x6c, 0xa2, 0xdf, 0x79, 0xbf, 0xe6, 0x86, 0xdc, 0xed, 0x93, 0xf9, 0xf4, 0xa0,
+	0x16, 0xfb, 0xad, 0x33, 0x02, 0xba, 0x50, 0x09, 0xc7, 0x6d, 0x10, 0xd4, 0x8a, 0x17, 0xe1, 0xa7,
+	0x1e, 0xee, 0xc4, 0x25, 0xfb, 0xe1, 0x2c, 0x08, 0xfe, 0x33, 0x15, 0x1b, 0x3a, 0x22, 0x38, 0x41,
+	0x2f, 0x55, 0x48, 0x3c, 0x72, 0x4f, 0x49, 0x8f, 0x56, 0x56, 0xac, 0x5d, 0x63, 0xc9, 0x64, 0x70,
+	0xe6, 0x6b, 0x7d, 0x03, 0x72, 0x8a, 0x20, 0x79, 0x97, 0x3d, 0x80, 0xa4, 0x5a, 0x87, 0xb1, 0x77,
+	0x8e, 0xbe, 0x94, 0x95, 0xcb, 0xb1, 0x9c, 0xd8, 0xce, 0xa3, 0xe5, 0xeb, 0xaa, 0xf2, 0x08, 0xb1,
+	0xff, 0x25, 0xb8, 0x0c, 0x42, 0xbf, 0x19, 0x5f, 0xc6, 0x26, 0x7c, 0xcd, 0x33, 0x99, 0xd4, 0x40,
+	0xb6, 0xdb, 0x4d, 0xd3, 0xe2, 0x5a, 0xf0, 0xe9, 0x67, 0x0d, 0xf0, 0x74, 0x2a, 0xf7, 0x81, 0x47,
+	0xfe, 0x8e, 0x64, 0x05, 0x9b, 0x81, 0x0c, 0xa8, 0x9e, 0x13, 0xb5, 0xbb, 0x1a, 0xc2, 0xd8, 0x21,
+	0xcf, 0xf5, 0x28, 0xdc, 0x12, 0x2f, 0xe9, 0x2f, 0x36, 0xf6, 0x4c, 0x3d, 0x03, 0x69, 0x44, 0x10,
+	0x86, 0x4b, 0x1d, 0xa3, 0x52, 0x2a, 0xc0, 0x59, 0x37, 0xdd, 0x60, 0x44, 0xfa, 0x67, 0x51, 0x17,
+	0x6e, 0x5e, 0x34, 0x75, 0x6b, 0x51, 0x7c, 0x78, 0x6e, 0x83, 0x85, 0x8b, 0x8a, 0x92, 0xa8, 0x91,
+	0x9f, 0xc5, 0x98, 0xac, 0xe2, 0x9f, 0xb9, 0xff, 0xa6, 0xc6, 0x1c, 0xad, 0xd3, 0x39, 0xb4, 0xe0,
+	0x56, 0xbb, 0xed, 0x73, 0xc2, 0xfa, 0x90, 0xc9, 0x07, 0xad, 0xd0, 0x14, 0xca, 0xd7, 0x21, 0xe7,
+	0xde, 0x2e, 0x04, 0xe5, 0x3b, 0x21, 0xec, 0x48, 0x3e, 0xf3, 0x55, 0x5b, 0xfa, 0x62, 0x78, 0x01,
+	0x6f, 0x95, 0x08, 0x7c, 0xb2, 0x0f, 0x89, 0xcf, 0x16, 0x96, 0xec, 0x1d, 0xa3, 0x09, 0x24, 0xb0,
+	0x26, 0x2b, 0xbd, 0x43, 0x32, 0xca, 0x60, 0x39, 0xd7, 0x7d, 0x40, 0xe4, 0x9a, 0x47, 0xf1, 0xb7,
+	0x4e, 0xfe, 0xd4, 0x55, 0x0b, 0xf1, 0x5c, 0x18, 0x0e, 0x63, 0x25, 0x2b, 0x6a, 0x32, 0x48, 0x71,
+	0x3f, 0x65, 0x78, 0x4c, 0x82, 0x7f, 0x59, 0x9f, 0x86, 0x66, 0xbc, 0x8d, 0x73, 0xd9, 0x94, 0x80,
+	0xf6, 0x9b, 0x8d, 0x13, 0xa2, 0x9a, 0x30, 0xa9, 0xa7, 0x4d, 0xb0, 0xb4, 0x6a, 0xb7, 0xc1, 0x87,
+	0xbe, 0xce, 0xa4, 0xc5, 0xdb, 0xc1, 0xcc, 0xe8, 0xde, 0xd3, 0xf5, 0xfb, 0xda, 0x02, 0x18, 0xe1,
+	0x0f, 0x35, 0xe8, 0x1c, 0x52, 0xef, 0x29, 0x6f, 0xf6, 0x36, 0x8c, 0xfd, 0x43, 0xa9, 0x04, 0x50,
+	0xc6, 0x0b, 0x5d, 0xe3, 0x12, 0x6a, 0x00, 0x19, 0x77, 0x1d, 0x20, 0x84, 0x3a, 0x27, 0x91, 0x57,
+	0x2e, 0x9e, 0x74, 0x35, 0xab, 0x91, 0x3c, 0xb8, 0xae, 0x43, 0xc5, 0xcb, 0x4a, 0xd2, 0xe8, 0x51,
+	0xdf, 0x05, 0x58, 0xec, 0x22, 0x5f, 0xf9, 0x3f, 0x66, 0x06, 0x5c, 0x6d, 0x13, 0x79, 0x74, 0x20,
+	0x96, 0x7b, 0x2d, 0xb3, 0x82, 0x3a, 0xd0, 0x89, 0x47, 0xed, 0x90, 0x54, 0x0a, 0x97, 0x61, 0x27,
+	0x9e, 0x6e, 0x44, 0xa5, 0x7b, 0x61, 0xac, 0x88, 0x7e, 0xb3, 0x95, 0x9b, 0xba, 0xa2, 0xb8, 0xc1,
+	0xaf, 0xd5, 0xc8, 0xbc, 0xf2, 0xcf, 0xc9, 0x0f, 0xd6, 0xd6, 0x2c, 0xdd, 0xe3, 0x49, 0xe4, 0xf0,
+	0x66, 0xeb, 0xfd, 0x83, 0xf2, 0x0a, 0xa0, 0xf9, 0x17, 0xbd, 0x00, 0x24, 0xda, 0x07, 0x31, 0xf7,
+	0x0e, 0x3e, 0x14, 0x15, 0x4b, 0x31, 0x1c, 0x58, 0x4e, 0x23, 0x65, 0x6b, 0x2a, 0x72, 0x88, 0x31,
+	0x7f, 0xa5, 0x38, 0x8c, 0xc2, 0x3f, 0x99, 0xdf, 0x46, 0xa6, 0xfc, 0x4d, 0xb3, 0x19, 0x54, 0xc0,
+	0x36, 0x5b, 0xcd, 0x53, 0x62, 0xda, 0x70, 0x69, 0xe7, 0x8d, 0x70, 0xf4, 0xaa, 0x77, 0x01, 0xc7,
+	0x7e, 0x0e, 0xe4, 0x85, 0x1b, 0x01, 0x8c, 0x28, 0x1e, 0x93, 0x35, 0x3b, 0x9a, 0x42, 0x58, 0xa1,
+	0x4f, 0x75, 0xa8, 0x5c, 0x92, 0xaf, 0x69, 0xaf, 0xb6, 0x76, 0xcc, 0xbd, 0x83, 0xe9, 0xc4, 0x90,
+	0x06, 0xcb, 0x9d, 0x23, 0xd2, 0xaa, 0x40, 0xd9, 0xb7, 0x5d, 0xe0, 0xc4, 0x7a, 0xe7, 0xd1, 0x97,
+	0xee, 0xde, 0xb4, 0xf5, 0xeb, 0xd1, 0xfc, 0xf8, 0xee, 0xf5, 0xee, 0x28, 0x57, 0x00, 0x00, 0x00,
+	0x0a, 0x74, 0x52, 0x4e, 0x53, 0x00, 0x3d, 0x7a, 0xb7, 0xf4, 0x31, 0x6e, 0xab, 0xe8, 0x25, 0xb5,
+	0xa9, 0x96, 0xb0, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65,
+	0x6e, 0x74, 0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00,
+	0x00, 0xed, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x66, 0x50, 0xb5, 0xf0, 0x8a, 0xcd, 0x6f,
+	0x9a, 0xa2, 0x6e, 0xe9, 0x13, 0x57, 0xd8, 0x3c, 0x4d, 0xc3, 0xda, 0x37, 0xa1, 0xa8, 0x95, 0x25,
+	0x5a, 0x07, 0x0c, 0x7a, 0x20, 0xd4, 0x5e, 0x1d, 0x9d, 0xef, 0xff, 0x58, 0x79, 0x18, 0xb6, 0xbd,
+	0x94, 0xf1, 0x6f, 0xda, 0xfa, 0x42, 0xda, 0xaf, 0x71, 0xcb, 0x73, 0x29, 0xdf, 0x86, 0xcd, 0xcf,
+	0x24, 0x7d, 0xea, 0x37, 0x31, 0x0a, 0x5a, 0x61, 0x01, 0x4c, 0xd1, 0x49, 0x99, 0x05, 0xe5, 0x75,
+	0xad, 0x3d, 0x93, 0x67, 0x2d, 0x5c, 0xb1, 0x7e, 0xdb, 0xde, 0x23, 0xa7, 0x2f, 0xdd, 0x7c, 0xf0,
+	0x9c, 0x79, 0x62, 0xe8, 0xcd, 0x98, 0x84, 0xe4, 0xe7, 0x59, 0x79, 0x1f, 0xbf, 0x56, 0xd4, 0xfc,
+	0x67, 0x6e, 0xeb, 0xe2, 0x15, 0x9c, 0x22, 0xc1, 0x12, 0x9d, 0xe4, 0xef, 0xef, 0x5f, 0xe7, 0xef,
+	0x3f, 0xd9, 0xdf, 0xff, 0xc3, 0x7a, 0x7f, 0x56, 0x9e, 0xd3, 0x52, 0x8a, 0x0f, 0xfc, 0x19, 0x6a,
+	0x2f, 0x6b, 0xd6, 0x5f, 0xd5, 0x6e, 0xbc, 0xae, 0xdb, 0x7c, 0x53, 0xbf, 0xf5, 0xb6, 0x61, 0xfb,
+	0x5d, 0xe3, 0xce, 0xfb, 0xa6, 0x8c, 0x37, 0x62, 0xb1, 0x00, 0x1c, 0xb6, 0x95, 0xa6, 0x67, 0xe5,
+	0x15, 0x96, 0x56, 0xfc, 0xa9, 0x6f, 0x06, 0x5a, 0x34, 0x71, 0xca, 0x8c, 0xd9, 0xf2, 0x8b, 0xd4,
+	0x56, 0x02, 0x6d, 0x2b, 0x2a, 0x28, 0x2f, 0x6a, 0x2d, 0xfa, 0x37, 0xab, 0x68, 0x45, 0x91, 0xe2,
+	0x5e, 0x7d, 0xa0, 0xda, 0xa2, 0xe7, 0x0c, 0x2e, 0x7b, 0xcd, 0xd6, 0x6b, 0x2c, 0x94, 0x9a, 0xcc,
+	0xd3, 0xfa, 0xaf, 0xfc, 0x43, 0xe6, 0xa3, 0xe8, 0x2b, 0xbe, 0xc7, 0xec, 0x77, 0x00, 0x00, 0x2b,
+	0x95, 0x7c, 0xea, 0x92, 0xca, 0xa2, 0x09, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae,
+	0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_gray_alpha8[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x06, 0x08, 0x04, 0x00, 0x00, 0x00, 0xbf, 0x3b, 0xac,
+	0x73, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+	0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x6e,
+	0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x61, 0x30, 0x55, 0xc5, 0x02, 0x18, 0xa2, 0x27, 0xb4,
+	0xef, 0xd9, 0xfc, 0xe2, 0xbe, 0x08, 0xb7, 0x83, 0x79, 0x4e, 0xf2, 0x8c, 0xfe, 0x23, 0xbb, 0x3f,
+	0x3c, 0x97, 0x11, 0xf6, 0x60, 0xdc, 0xf6, 0xda, 0x18, 0x0b, 0x60, 0x8a, 0x8e, 0x4e, 0x4a, 0xca,
+	0xcc, 0x2c, 0x28, 0x28, 0x2f, 0xaf, 0xab, 0x6b, 0x6d, 0xed, 0xe9, 0x99, 0x3c, 0x79, 0xd6, 0xac,
+	0x85, 0x0b, 0x99, 0x53, 0xea, 0x82, 0x82, 0x42, 0x43, 0x23, 0x6f, 0xde, 0x89, 0x49, 0x48, 0x48,
+	0x4e, 0x4e, 0x7f, 0xfe, 0x2a, 0x2b, 0x2f, 0xaf, 0xb0, 0x90, 0x25, 0x3a, 0xda, 0xc3, 0xc3, 0x23,
+	0xb3, 0xc0, 0x03, 0x0c, 0x5a, 0x7b, 0x80, 0xc4, 0xed, 0xdb, 0x8f, 0x16, 0x02, 0x00, 0xf3, 0xa9,
+	0x32, 0x53, 0xdd, 0xa6, 0xaf, 0x7f, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42,
+	0x60, 0x82,
+};
+
+static const uint8_t png_gray_alpha16[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x05, 0x10, 0x04, 0x00, 0x00, 0x00, 0x73, 0x03, 0xe2,
+	0x10, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+	0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x79,
+	0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x61, 0x60, 0x30, 0x35, 0x55, 0x35, 0x42, 0x87, 0x6a,
+	0x40, 0xa8, 0x6a, 0xc4, 0x10, 0x1d, 0x3d, 0x61, 0x42, 0xfb, 0x94, 0x3d, 0x27, 0x37, 0x9f, 0x7d,
+	0xc9, 0xf4, 0x80, 0x4d, 0xd4, 0x9a, 0xc7, 0xde, 0xb1, 0xc4, 0xa2, 0x22, 0x77, 0x6d, 0xca, 0xc6,
+	0x99, 0xcf, 0x18, 0xb7, 0x6d, 0x7b, 0xfd, 0xda, 0xd8, 0xc1, 0x04, 0x08, 0x8d, 0x91, 0x20, 0x84,
+	0xcf, 0x14, 0x13, 0x1d, 0x13, 0x9d, 0x9c, 0x94, 0x94, 0x94, 0x09, 0x04, 0x05, 0x05, 0x85, 0x05,
+	0x15, 0xe5, 0x15, 0xe5, 0xf5, 0x75, 0x75, 0x75, 0xad, 0x40, 0xc0, 0x9c, 0x92, 0x52, 0x5f, 0x17,
+	0x14, 0x11, 0x14, 0x11, 0x16, 0x13, 0x16, 0x13, 0x79, 0xff, 0x66, 0xfc, 0x9d, 0xe4, 0x98, 0xe4,
+	0x84, 0xb4, 0xc4, 0xb4, 0x94, 0xac, 0x94, 0x57, 0x00, 0xeb, 0xb4, 0x33, 0x85, 0xe7, 0x81, 0xc1,
+	0xfc, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_rgba8[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x21, 0x00, 0x00, 0x00, 0x14, 0x08, 0x06, 0x00, 0x00, 0x00, 0x03, 0x53, 0x54,
+	0x71, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+	0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x61,
+	0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0xcd, 0x96, 0x6f, 0x54, 0x53, 0x65, 0x00, 0xc6, 0x41, 0x04,
+	0x15, 0xe1, 0x78, 0x68, 0x58, 0xb4, 0x9d, 0x42, 0x28, 0x17, 0x54, 0x04, 0xe9, 0xd2, 0xce, 0x3b,
+	0x5d, 0x45, 0x51, 0x22, 0x84, 0x1c, 0x88, 0x88, 0x3f, 0x2f, 0xf1, 0x27, 0x02, 0x06, 0x91, 0xcb,
+	0x68, 0xab, 0xc8, 0xdd, 0x9a, 0xc3, 0x22, 0x30, 0x89, 0x65, 0x34, 0xd2, 0x39, 0x6e, 0xd1, 0xa8,
+	0x68, 0x2b, 0x17, 0x54, 0x08, 0x16, 0x42, 0xca, 0x19, 0x19, 0x41, 0x46, 0x62, 0x19, 0xa1, 0x84,
+	0xa0, 0x11, 0x94, 0x04, 0x29, 0x41, 0xcf, 0x7b, 0xc7, 0xb1, 0x4f, 0x9d, 0xfc, 0x86, 0xbf, 0x0f,
+	0xbb, 0xdb, 0xce, 0x73, 0xf6, 0x10, 0xf9, 0xa4, 0xc3, 0x00, 0x00, 0x00, 0x61, 0x49, 0x44, 0x41,
+	0x54, 0xee, 0x3c, 0xe7, 0xb7, 0xe7, 0xce, 0xd5, 0xe5, 0x36, 0xa5, 0x69, 0xe5, 0x3c, 0xb3, 0x20,
+	0x05, 0x64, 0x82, 0x3c, 0xb0, 0x19, 0xa8, 0xc1, 0x56, 0xa0, 0x07, 0x65, 0xa0, 0x12, 0x18, 0x81,
+	0x19, 0x58, 0x80, 0x15, 0x34, 0x80, 0x66, 0xd0, 0x06, 0x1c, 0xa0, 0x1b, 0x1c, 0x03, 0xfd, 0x60,
+	0x08, 0x8c, 0x82, 0x09, 0x30, 0x0d, 0xdc, 0x80, 0x27, 0xf0, 0x01, 0x7e, 0xc0, 0x1f, 0x48, 0x41,
+	0x08, 0x90, 0x01, 0x39, 0x70, 0x7b, 0x89, 0x6f, 0xf9, 0x3e, 0x2a, 0xca, 0x11, 0x15, 0x73, 0x24,
+	0x26, 0xa6, 0x3b, 0x2e, 0x2e, 0x2e, 0x01, 0x24, 0x25, 0x25, 0x1d, 0x4b, 0x4d, 0xfd, 0x21, 0x35,
+	0xbd, 0xbf, 0xba, 0x79, 0x40, 0x62, 0x00, 0x00, 0x00, 0x61, 0x49, 0x44, 0x41, 0x54, 0x3f, 0xfd,
+	0xe4, 0xc9, 0xac, 0xac, 0xa1, 0x9c, 0x9c, 0x1c, 0xa5, 0x52, 0x39, 0x52, 0x58, 0x38, 0x3a, 0xaa,
+	0x1a, 0x1f, 0x57, 0x4d, 0x4c, 0x14, 0x15, 0x4d, 0x4d, 0x69, 0x34, 0xd3, 0xc5, 0xc5, 0xd3, 0x5a,
+	0xed, 0xec, 0xac, 0x0e, 0x07, 0x79, 0x78, 0x78, 0x94, 0x78, 0x7a, 0x96, 0x96, 0x7a, 0x97, 0x97,
+	0x7b, 0xfb, 0x54, 0xf8, 0xf8, 0x18, 0x7c, 0x7d, 0x7d, 0xd9, 0xa1, 0x12, 0x89, 0xa4, 0xda, 0xdf,
+	0xdf, 0xe4, 0x1f, 0x58, 0x13, 0x18, 0xc8, 0x0e, 0x0f, 0x06, 0xec, 0x0b, 0x84, 0x01, 0xf6, 0x25,
+	0xd6, 0x82, 0x85, 0xac, 0x09, 0x92, 0x49, 0x48, 0x1e, 0xb9, 0x88, 0x9a, 0x90, 0xad, 0x84, 0xdb,
+	0x7a, 0x28, 0x06, 0x00, 0x00, 0x00, 0x61, 0x49, 0x44, 0x41, 0x54, 0xe8, 0x09, 0x29, 0xfb, 0xf7,
+	0x3d, 0x23, 0x21, 0x66, 0x72, 0xdc, 0x42, 0x88, 0x95, 0x90, 0x01, 0x42, 0x86, 0x87, 0xc7, 0xc6,
+	0xc6, 0x9a, 0x27, 0x27, 0xdb, 0xc8, 0x8c, 0x83, 0xcc, 0x74, 0x13, 0x77, 0x77, 0xe2, 0xe5, 0xe5,
+	0x25, 0x12, 0x89, 0xfa, 0xc5, 0xe2, 0x21, 0x72, 0x09, 0x4d, 0x90, 0x90, 0x10, 0x12, 0x22, 0x23,
+	0x68, 0x02, 0x1f, 0xee, 0x52, 0x60, 0xfe, 0x6e, 0x69, 0xfd, 0xc0, 0x55, 0xd1, 0xa3, 0xd7, 0x3d,
+	0x54, 0x1e, 0xfa, 0xc8, 0x1b, 0x47, 0x36, 0xbf, 0xdd, 0xb7, 0xec, 0xc3, 0x5f, 0x24, 0xb1, 0xbf,
+	0xdf, 0x90, 0x5a, 0xb1, 0x3a, 0x77, 0x77, 0xf7, 0x93, 0x75, 0x27, 0x44, 0xcc, 0xfd, 0xbd, 0xf6,
+	0x00, 0x00, 0x00, 0x61, 0x49, 0x44, 0x41, 0x54, 0x1f, 0x8f, 0xf8, 0x3f, 0xf0, 0xe7, 0x4d, 0xe9,
+	0xaf, 0xad, 0x45, 0x58, 0x83, 0xf0, 0xa7, 0x08, 0x9f, 0x47, 0x58, 0x8e, 0x70, 0x31, 0xc2, 0xcd,
+	0x08, 0xcf, 0x20, 0x7c, 0x07, 0xc2, 0x1c, 0xc2, 0x5f, 0x20, 0xbc, 0x00, 0xe1, 0xbb, 0x11, 0xde,
+	0x86, 0x70, 0x3b, 0xc2, 0x1e, 0x08, 0xdf, 0x87, 0xf0, 0x8b, 0x08, 0x77, 0x20, 0xec, 0x89, 0x70,
+	0x14, 0xc2, 0x65, 0x08, 0xbb, 0x1e, 0x9a, 0xbe, 0xf5, 0xd1, 0x0d, 0xf3, 0xcc, 0xe5, 0x21, 0x66,
+	0xc1, 0x76, 0xf3, 0xfe, 0x54, 0x90, 0xde, 0x9f, 0x9e, 0x9e, 0x05, 0xe0, 0xe0, 0x90, 0x72, 0x44,
+	0xa9, 0x1c, 0x2d, 0x2c, 0x2c, 0x54, 0xa9, 0x54, 0xe3, 0xcf, 0xdf, 0xff, 0x67, 0x00, 0x00, 0x00,
+	0x61, 0x49, 0x44, 0x41, 0x54, 0x45, 0x4c, 0x42, 0x8d, 0x46, 0x53, 0xcc, 0x24, 0x9c, 0x9d, 0xd5,
+	0xba, 0xe9, 0x74, 0xba, 0x92, 0x92, 0x12, 0x8f, 0x52, 0x58, 0xe8, 0x0d, 0x0b, 0x2b, 0x2a, 0x2a,
+	0x98, 0x84, 0x06, 0x3f, 0xbf, 0xaa, 0x2a, 0x49, 0x75, 0xb5, 0xc4, 0x84, 0x43, 0x02, 0x03, 0x6b,
+	0x6a, 0xa4, 0xb5, 0xb5, 0xd2, 0x3a, 0xa7, 0x84, 0xf5, 0x61, 0x36, 0x5b, 0x98, 0xdd, 0x29, 0x61,
+	0xa3, 0x5c, 0xde, 0x24, 0x6f, 0x51, 0x28, 0x14, 0xe1, 0xe1, 0xe1, 0xad, 0x11, 0x11, 0xed, 0x11,
+	0x1d, 0x91, 0x91, 0x91, 0x82, 0x98, 0x34, 0x33, 0x93, 0xe6, 0x51, 0x81, 0xcd, 0x54, 0xad, 0xa6,
+	0x5b, 0x85, 0xa7, 0xc7, 0xf5, 0x03, 0xcb, 0xc1, 0x25, 0x52, 0x00, 0x00, 0x00, 0x61, 0x49, 0x44,
+	0x41, 0x54, 0x65, 0x65, 0xb4, 0x92, 0xd2, 0x61, 0x4a, 0xc7, 0x8c, 0x93, 0x66, 0x33, 0xb5, 0x50,
+	0x3a, 0x43, 0xdd, 0xdd, 0xad, 0x5e, 0x0d, 0x0d, 0xb4, 0x99, 0x52, 0x11, 0x15, 0x8b, 0xdb, 0x02,
+	0x1c, 0x0e, 0xda, 0x4d, 0x83, 0x82, 0x42, 0x43, 0x43, 0x9d, 0x4d, 0xd0, 0xff, 0x6b, 0x82, 0xfa,
+	0x53, 0x67, 0x13, 0x54, 0x26, 0xa3, 0x32, 0x8a, 0x26, 0x5c, 0x98, 0x7c, 0xaf, 0x77, 0xba, 0xae,
+	0xb9, 0x10, 0x96, 0x6d, 0x7c, 0xd8, 0xd0, 0x31, 0x73, 0x70, 0x2a, 0x24, 0x13, 0x4e, 0x7e, 0xf9,
+	0xf2, 0xe7, 0x13, 0x37, 0xfe, 0x76, 0x7d, 0xd2, 0x8e, 0x78, 0x98, 0xd4, 0x78, 0x36, 0xe0, 0x41,
+	0x49, 0xac, 0xfe, 0xb3, 0x22, 0x57, 0xd1, 0x00, 0x00, 0x00, 0x61, 0x49, 0x44, 0x41, 0x54, 0x33,
+	0xad, 0x7d, 0xf8, 0xda, 0x93, 0x7e, 0xf7, 0xbf, 0xc0, 0x04, 0x7b, 0xaf, 0x7f, 0xf9, 0xc6, 0x65,
+	0xf7, 0x3c, 0xfd, 0xc1, 0x16, 0xcb, 0x8f, 0x57, 0xf4, 0x7a, 0xdd, 0xf5, 0x14, 0x93, 0xd4, 0xf4,
+	0xed, 0x12, 0x85, 0xdb, 0xed, 0x8f, 0xd5, 0xe4, 0xbc, 0xf9, 0x8d, 0x87, 0x03, 0x2b, 0xc8, 0x44,
+	0xaf, 0x3c, 0xfc, 0xf7, 0xaa, 0xc9, 0x9b, 0x33, 0x76, 0xa5, 0xec, 0x6c, 0x3f, 0x7f, 0xe0, 0x5c,
+	0x70, 0x1a, 0xfc, 0x6f, 0xdd, 0xbe, 0x7f, 0x5c, 0x7a, 0x66, 0x45, 0x42, 0xe9, 0x26, 0x58, 0xbb,
+	0xef, 0xf4, 0x35, 0x71, 0xae, 0x3b, 0x70, 0x6a, 0xfe, 0x3c, 0x73, 0x79, 0x88, 0xd9, 0xa5, 0xd4,
+	0x44, 0x0b, 0xb4, 0x81, 0x00, 0x00, 0x00, 0x61, 0x49, 0x44, 0x41, 0x54, 0x9b, 0x0a, 0x99, 0x84,
+	0xe3, 0x2a, 0x55, 0x11, 0xd0, 0x38, 0x25, 0x2c, 0xc6, 0x12, 0x6a, 0x75, 0x4e, 0x09, 0x4b, 0x30,
+	0x84, 0xa5, 0xe5, 0x58, 0x42, 0x48, 0x58, 0x61, 0x30, 0x18, 0x7c, 0xab, 0x20, 0x61, 0xb5, 0x20,
+	0xa1, 0xc9, 0x54, 0x03, 0x6a, 0xa5, 0xd2, 0xda, 0xe0, 0xba, 0xba, 0xba, 0xfa, 0x7a, 0x2c, 0xa1,
+	0xcd, 0x66, 0xb3, 0xdb, 0x99, 0x84, 0x8d, 0x8d, 0x4d, 0x4d, 0x72, 0xb9, 0x42, 0xd1, 0xd2, 0xd2,
+	0xda, 0x1a, 0x1e, 0x1e, 0x01, 0x0b, 0x23, 0x3b, 0x3a, 0x22, 0xa3, 0xa3, 0xa3, 0x3b, 0x63, 0xbb,
+	0xba, 0x62, 0x7b, 0xe2, 0xe3, 0xe3, 0x13, 0x13, 0x7b, 0x13, 0xfb, 0x92, 0x93, 0x9c, 0xe5, 0x5c,
+	0xa5, 0x00, 0x00, 0x00, 0x61, 0x49, 0x44, 0x41, 0x54, 0x93, 0x17, 0x3a, 0x9b, 0xe0, 0x00, 0x6b,
+	0x82, 0x5d, 0x59, 0x13, 0x1c, 0xa7, 0xd7, 0xb3, 0xe7, 0xee, 0xac, 0x09, 0x5c, 0x45, 0x46, 0xb1,
+	0xd9, 0xcc, 0x59, 0xb8, 0x00, 0x4b, 0x90, 0xd5, 0xca, 0x35, 0x70, 0xa1, 0x0d, 0x6b, 0x9a, 0x9b,
+	0xb9, 0x36, 0x6e, 0xfd, 0x7a, 0xa1, 0x09, 0xee, 0x52, 0x9b, 0xe0, 0xe6, 0x9a, 0xe0, 0xa4, 0x9c,
+	0xd0, 0x04, 0x27, 0xe3, 0x98, 0x98, 0x6c, 0xf9, 0x9e, 0x6f, 0x38, 0xb3, 0x62, 0xf1, 0xfa, 0x27,
+	0xde, 0x79, 0xa5, 0xed, 0xaf, 0x5b, 0xae, 0xc4, 0x8c, 0xed, 0xee, 0x5e, 0xb4, 0x0e, 0x4e, 0x1e,
+	0x64, 0xf2, 0xad, 0x82, 0x65, 0x6c, 0x21, 0xef, 0x2c, 0x7a, 0x0f, 0x00, 0x84, 0xc3, 0x00, 0x00,
+	0x00, 0x61, 0x49, 0x44, 0x41, 0x54, 0xf7, 0x27, 0x36, 0x6c, 0x31, 0xba, 0x4f, 0x7e, 0x3d, 0x8a,
+	0xb9, 0x83, 0xbb, 0x17, 0x98, 0xa4, 0x4a, 0xd8, 0x38, 0x2e, 0x4d, 0xd9, 0xc9, 0x96, 0x74, 0x56,
+	0x96, 0xb7, 0xa7, 0xa4, 0x69, 0x6c, 0xa5, 0x77, 0xb8, 0xfa, 0x7d, 0x38, 0xbe, 0x9a, 0xc9, 0x5c,
+	0x03, 0x6b, 0x83, 0xd3, 0x2a, 0x0f, 0xdb, 0x06, 0xc5, 0x9b, 0xd8, 0xe2, 0xb6, 0xfc, 0x11, 0x44,
+	0x23, 0x9e, 0xb1, 0x9e, 0xc2, 0x6f, 0x21, 0x9f, 0x49, 0xdf, 0x07, 0xbb, 0x5d, 0x13, 0x4a, 0x0f,
+	0x9c, 0xdb, 0x31, 0xcf, 0x5c, 0x1e, 0x62, 0xee, 0x3b, 0x92, 0xab, 0xd3, 0x02, 0x9d, 0x9b, 0x73,
+	0x09, 0x9d, 0x12, 0x7a, 0x97, 0xcf, 0x49, 0x89, 0x10, 0x6c, 0x21, 0x00, 0x00, 0x00, 0x61, 0x49,
+	0x44, 0x41, 0x54, 0x68, 0xa8, 0xaa, 0x12, 0x24, 0xac, 0x36, 0x99, 0xe6, 0x24, 0x04, 0x75, 0x82,
+	0x84, 0xf5, 0xf5, 0x36, 0x41, 0x42, 0xbb, 0xbd, 0x11, 0x16, 0x36, 0xc1, 0xc2, 0x8b, 0x12, 0xb6,
+	0xb7, 0xb7, 0x63, 0x09, 0x3b, 0x3a, 0x3b, 0x3b, 0xa3, 0x63, 0x61, 0x61, 0x0f, 0x2c, 0x4c, 0xec,
+	0xed, 0xed, 0x85, 0x84, 0x7d, 0x69, 0x27, 0x4e, 0xa4, 0x65, 0x64, 0x64, 0xfc, 0x3c, 0x38, 0x98,
+	0x9d, 0x9d, 0x9b, 0x7b, 0xfa, 0xf4, 0xd9, 0x82, 0x82, 0x82, 0x39, 0x31, 0x67, 0x78, 0x9e, 0x47,
+	0x13, 0x5e, 0xb8, 0xa8, 0xd5, 0x22, 0x31, 0xcf, 0xa3, 0x89, 0x00, 0xbc, 0x40, 0x13, 0x78, 0xe4,
+	0x8d, 0x46, 0xf6, 0x68, 0x9b, 0x94, 0xd4, 0x83, 0x00, 0x00, 0x00, 0x61, 0x49, 0x44, 0x41, 0x54,
+	0xe6, 0x79, 0xd6, 0x04, 0x1f, 0x15, 0xc7, 0x9a, 0xe0, 0x85, 0x26, 0x78, 0x9e, 0x35, 0xc1, 0x0b,
+	0x4d, 0xf0, 0xbc, 0xd0, 0x04, 0xef, 0x6c, 0x82, 0xff, 0xaf, 0x26, 0x78, 0x67, 0x13, 0xbc, 0xd0,
+	0x04, 0xcf, 0xcb, 0xe5, 0xbd, 0x2e, 0xec, 0xb6, 0x9b, 0xbf, 0xf7, 0xa8, 0xe7, 0xf2, 0x8d, 0x5a,
+	0x3b, 0x5b, 0xb4, 0xbc, 0x3d, 0x3d, 0x8b, 0x45, 0x1b, 0x9e, 0xfb, 0x88, 0xdd, 0x9e, 0xd9, 0xf2,
+	0xf9, 0xdc, 0xfb, 0xac, 0x0d, 0xae, 0x25, 0x67, 0x1b, 0xbf, 0x5e, 0xc8, 0x16, 0x92, 0x49, 0x9a,
+	0x55, 0xf5, 0xd5, 0x02, 0x26, 0x1f, 0x5b, 0xd2, 0x8c, 0x5d, 0x0e, 0x97, 0xa5, 0xb0, 0x96, 0xdd,
+	0xee, 0xb8, 0x92, 0x77, 0x2c, 0x00, 0x00, 0x00, 0x31, 0x49, 0x44, 0x41, 0x54, 0xd9, 0xe2, 0x2e,
+	0x51, 0x6c, 0xb1, 0xb0, 0x15, 0xa4, 0xaf, 0x1e, 0x9a, 0x5e, 0xb4, 0x4e, 0x55, 0xcb, 0xfe, 0x16,
+	0xb0, 0xb5, 0x74, 0x27, 0x8f, 0xbf, 0x65, 0x3d, 0x75, 0x75, 0x0c, 0x7c, 0x9f, 0x62, 0xab, 0xca,
+	0xfe, 0x3e, 0x24, 0xe2, 0x3e, 0x0e, 0x3f, 0xf7, 0xfe, 0x03, 0xc9, 0xf7, 0xc1, 0x89, 0xf0, 0x34,
+	0xf2, 0x35, 0x00, 0x00, 0x00, 0x00, 0x49, 0x44, 0x41, 0x54, 0x35, 0xaf, 0x06, 0x1e, 0x00, 0x00,
+	0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_rgba16[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0x05, 0x10, 0x06, 0x00, 0x00, 0x00, 0xd9, 0x0a, 0x2a,
+	0x9b, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+	0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0xd8,
+	0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x64, 0x60, 0x30, 0x35, 0xcd, 0xca, 0x9a, 0x3f, 0x5f,
+	0xd5, 0x08, 0x19, 0xaa, 0x21, 0x91, 0xd8, 0xc5, 0x98, 0xa2, 0xa1, 0x20, 0x09, 0x0c, 0x92, 0x93,
+	0x32, 0x33, 0xb3, 0x80, 0x30, 0x33, 0xb3, 0xb0, 0xa0, 0xb0, 0x00, 0x04, 0x2a, 0xca, 0x2b, 0xca,
+	0x41, 0xa0, 0xbe, 0x0e, 0x04, 0xea, 0xeb, 0x5a, 0x81, 0xa0, 0x0d, 0x08, 0x99, 0x3b, 0x3b, 0x17,
+	0x2f, 0xde, 0xbf, 0xef, 0xe6, 0x0d, 0xef, 0x40, 0x9f, 0xc0, 0xd3, 0x17, 0xbd, 0x03, 0xfd, 0x43,
+	0xcf, 0x85, 0xfa, 0x01, 0xe1, 0xa5, 0x88, 0x20, 0x20, 0x0c, 0x8e, 0x08, 0x8d, 0x09, 0x8d, 0x09,
+	0x8b, 0x09, 0xbb, 0x13, 0x19, 0x1f, 0x15, 0x1f, 0x79, 0xff, 0x66, 0x7c, 0x6c, 0x72, 0xec, 0xe3,
+	0x3b, 0xc9, 0x31, 0xc9, 0x2c, 0x31, 0xd1, 0x31, 0x60, 0x1b, 0xad, 0xdc, 0x93, 0x92, 0xac, 0xdc,
+	0xad, 0xdc, 0x33, 0x33, 0xad, 0xdc, 0xad, 0x81, 0xd0, 0x0a, 0x8c, 0xad, 0x0a, 0xc0, 0x64, 0x79,
+	0x39, 0x88, 0xac, 0xab, 0x03, 0x89, 0xb5, 0xb6, 0x82, 0x65, 0x18, 0x72, 0x73, 0x16, 0x2d, 0xbc,
+	0x7e, 0x8d, 0x97, 0x7b, 0xdd, 0xae, 0xc7, 0xef, 0x25, 0x55, 0xfc, 0x22, 0x3f, 0x70, 0xa8, 0xda,
+	0x46, 0x15, 0xf5, 0x2f, 0x37, 0x0c, 0x4b, 0xeb, 0x9e, 0x7d, 0xe0, 0xc2, 0xd7, 0xa2, 0x25, 0xcb,
+	0x6f, 0xde, 0xe5, 0x13, 0x72, 0xde, 0xfc, 0xe9, 0xa5, 0xba, 0x5c, 0x4c, 0xf0, 0xc4, 0xaf, 0x0e,
+	0x5a, 0xa5, 0xf1, 0xab, 0xa6, 0xdc, 0x07, 0x00, 0x52, 0xf0, 0x6a, 0xe2, 0x4f, 0x6f, 0x5c, 0x3c,
+	0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_interlaced[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x03, 0x08, 0x02, 0x00, 0x00, 0x01, 0xa3, 0x53, 0x62,
+	0x39, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+	0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x00, 0x36,
+	0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x62, 0x30, 0xcd, 0x52, 0x8d, 0xea, 0xf7, 0xaa, 0xdf,
+	0x92, 0xbf, 0xe4, 0xe6, 0x94, 0x93, 0xff, 0x98, 0xa3, 0xcb, 0x26, 0xb8, 0xbb, 0xbb, 0x7b, 0x7b,
+	0x7b, 0xfb, 0xf9, 0x9d, 0x0b, 0xba, 0x74, 0x89, 0x25, 0x3a, 0x3a, 0xda, 0x18, 0x04, 0x32, 0x8d,
+	0x0b, 0x8c, 0xcb, 0x8d, 0x8d, 0x01, 0xd2, 0x78, 0x12, 0x1e, 0x84, 0x26, 0x53, 0xc4, 0x00, 0x00,
+	0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const PngFixture pngFixtures[] = {
+	{ "gray1", 0, 1, 13, 7, false, png_gray1, sizeof(png_gray1) },
+	{ "gray2", 0, 2, 13, 7, true, png_gray2, sizeof(png_gray2) },
+	{ "gray4", 0, 4, 13, 7, false, png_gray4, sizeof(png_gray4) },
+	{ "gray8", 0, 8, 13, 7, true, png_gray8, sizeof(png_gray8) },
+	{ "gray16", 0, 16, 9, 5, true, png_gray16, sizeof(png_gray16) },
+	{ "rgb8", 2, 8, 17, 11, true, png_rgb8, sizeof(png_rgb8) },
+	{ "rgb16", 2, 16, 9, 5, false, png_rgb16, sizeof(png_rgb16) },
+	{ "palette1", 3, 1, 13, 7, false, png_palette1, sizeof(png_palette1) },
+	{ "palette2", 3, 2, 13, 7, true, png_palette2, sizeof(png_palette2) },
+	{ "palette4", 3, 4, 13, 7, true, png_palette4, sizeof(png_palette4) },
+	{ "palette8", 3, 8, 21, 13, true, png_palette8, sizeof(png_palette8) },
+	{ "gray-alpha8", 4, 8, 11, 6, false, png_gray_alpha8, sizeof(png_gray_alpha8) },
+	{ "gray-alpha16", 4, 16, 7, 5, false, png_gray_alpha16, sizeof(png_gray_alpha16) },
+	{ "rgba8", 6, 8, 33, 20, false, png_rgba8, sizeof(png_rgba8) },
+	{ "rgba16", 6, 16, 7, 5, false, png_rgba16, sizeof(png_rgba16) },
+};
+// Larger images for bench-png-image: a 41x41 module code at 8 pixels per
+// module (1 bit gray) and a 576x240 RGBA receipt logo (Paeth filtered).
+static const uint8_t png_bench_code[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x01, 0x48, 0x00, 0x00, 0x01, 0x48, 0x01, 0x00, 0x00, 0x00, 0x00, 0x1a, 0x6f, 0x5a,
+	0x9e, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+	0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x02, 0x16,
+	0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0xed, 0x9a, 0xd1, 0x56, 0xc3, 0x30, 0x0c, 0x43, 0xf5, 0xff,
+	0x3f, 0x6d, 0xa0, 0x4e, 0x2c, 0x39, 0xb0, 0xc6, 0xbc, 0x8b, 0x71, 0x36, 0x9a, 0xde, 0xf4, 0x21,
+	0x78, 0x8e, 0xa5, 0x18, 0x11, 0xf8, 0x7e, 0xfd, 0xfc, 0xc6, 0xf3, 0x0e, 0x20, 0x47, 0x9e, 0x1b,
+	0xf9, 0x17, 0x0a, 0x32, 0x79, 0x25, 0x7f, 0xae, 0xf2, 0x76, 0x8e, 0x22, 0x07, 0x92, 0x7a, 0xae,
+	0x74, 0x9e, 0xc9, 0x2b, 0x59, 0x2b, 0x9e, 0xe0, 0xfe, 0x17, 0xe4, 0xd0, 0x7e, 0x8e, 0xc9, 0x21,
+	0x99, 0x77, 0xf2, 0x67, 0x63, 0x6b, 0xec, 0x99, 0xcf, 0xe5, 0x37, 0x39, 0x21, 0x63, 0x4d, 0xd8,
+	0xd1, 0x9c, 0x24, 0x6a, 0x52, 0x85, 0xba, 0xc9, 0x19, 0x99, 0xc9, 0x21, 0x76, 0xb4, 0xee, 0x24,
+	0xb1, 0x98, 0x15, 0xd5, 0xd8, 0xe9, 0xd6, 0xe4, 0x85, 0xe4, 0x57, 0x7f, 0x47, 0x2e, 0xd1, 0xca,
+	0xc1, 0xe8, 0x49, 0xc2, 0xe4, 0x67, 0xb2, 0x82, 0x96, 0x51, 0xbb, 0xa6, 0x84, 0x64, 0x62, 0x84,
+	0xc9, 0x19, 0xb9, 0xf6, 0xaf, 0x75, 0x6f, 0x01, 0x55, 0x5e, 0x55, 0x1d, 0xb0, 0xee, 0x99, 0xbc,
+	0x91, 0x21, 0xf9, 0xb5, 0x2a, 0x57, 0xcd, 0xb5, 0x51, 0x0f, 0x30, 0x39, 0x21, 0x2b, 0x88, 0x83,
+	0xf5, 0x68, 0x48, 0x61, 0x15, 0xf8, 0xb5, 0x95, 0x99, 0xfc, 0x4c, 0xa2, 0x3e, 0x64, 0x1a, 0x98,
+	0x6a, 0x83, 0x5b, 0x9b, 0xc9, 0x01, 0x79, 0x48, 0x80, 0xe3, 0x31, 0x21, 0x9a, 0xd4, 0xe4, 0x84,
+	0x64, 0x10, 0xab, 0x50, 0x55, 0x4d, 0x55, 0xc9, 0xd7, 0xe4, 0x8c, 0xac, 0xf2, 0xa9, 0x14, 0x29,
+	0xbd, 0x13, 0x4a, 0x2d, 0x93, 0x23, 0x32, 0xba, 0x8b, 0xc2, 0xcc, 0x1b, 0x22, 0x01, 0x82, 0x9b,
+	0x99, 0xc9, 0x77, 0x72, 0x2f, 0x7b, 0x49, 0x29, 0x16, 0xa9, 0x0c, 0x68, 0xd5, 0xae, 0x26, 0xdf,
+	0x49, 0xae, 0x39, 0x7d, 0x53, 0x02, 0xba, 0x91, 0x99, 0x1c, 0x91, 0xf2, 0xd5, 0x0f, 0x8a, 0x7b,
+	0xd9, 0xb8, 0x10, 0x54, 0x58, 0x26, 0xaf, 0xe4, 0xe1, 0x92, 0x96, 0xef, 0x14, 0x14, 0xa7, 0x62,
+	0xad, 0x98, 0x7c, 0x27, 0xe9, 0xdf, 0x83, 0xb2, 0x0a, 0x34, 0x51, 0x2a, 0xd8, 0x4d, 0x8e, 0xc8,
+	0x32, 0x4a, 0xd4, 0x76, 0x66, 0x8a, 0xd5, 0xd5, 0x37, 0x39, 0x20, 0xeb, 0x0a, 0xad, 0xf8, 0x87,
+	0xec, 0x62, 0x30, 0x39, 0x27, 0x69, 0xe4, 0xa9, 0xdb, 0x47, 0x5b, 0x25, 0x38, 0xc9, 0xe4, 0x80,
+	0x14, 0xdb, 0xae, 0x4a, 0x2c, 0x50, 0xb7, 0x46, 0x95, 0x5d, 0x26, 0x67, 0x24, 0x68, 0x45, 0x95,
+	0x75, 0xcf, 0xc7, 0xb4, 0x93, 0x3b, 0x93, 0x03, 0x52, 0x35, 0x69, 0xc9, 0x27, 0x2d, 0xfc, 0xb9,
+	0xee, 0x26, 0xef, 0xe4, 0x61, 0xf2, 0xc9, 0x09, 0x09, 0xad, 0x80, 0xe6, 0xea, 0x99, 0x7c, 0x25,
+	0xab, 0xfb, 0xe6, 0x38, 0xb0, 0x8b, 0x96, 0x6a, 0x55, 0x25, 0x98, 0x7c, 0x23, 0x75, 0x61, 0x55,
+	0x89, 0x86, 0xb6, 0x3f, 0xd0, 0xa3, 0x36, 0x79, 0x21, 0x75, 0x5b, 0x62, 0x3d, 0x20, 0x87, 0xf8,
+	0x8c, 0x75, 0x93, 0x13, 0xf2, 0x0f, 0xb3, 0x4f, 0x04, 0x56, 0x3b, 0xbc, 0x33, 0x39, 0x20, 0x71,
+	0x9e, 0x74, 0xf2, 0xb0, 0x8e, 0x06, 0x69, 0x94, 0x1a, 0x30, 0x79, 0x23, 0x25, 0xa8, 0x65, 0xa8,
+	0x59, 0xcd, 0x3c, 0x70, 0x36, 0x79, 0x23, 0x8f, 0x58, 0x55, 0x01, 0xa0, 0x07, 0xf9, 0x26, 0x67,
+	0xa4, 0x34, 0xdf, 0xb1, 0x00, 0xe8, 0x8d, 0x4f, 0xad, 0xcd, 0xc9, 0xe4, 0x85, 0x84, 0x76, 0x8b,
+	0x36, 0x95, 0xdf, 0x3a, 0x9a, 0xc3, 0xe4, 0x8c, 0x94, 0xa6, 0x46, 0xd9, 0xf9, 0x8f, 0x4a, 0x0b,
+	0x80, 0xc9, 0x19, 0x89, 0x66, 0xe9, 0x49, 0x64, 0xb3, 0x50, 0xe8, 0xde, 0xb4, 0xc9, 0x37, 0x52,
+	0x9a, 0xec, 0x5a, 0xcb, 0xad, 0xba, 0xa8, 0x26, 0xff, 0x41, 0xa2, 0x09, 0x7d, 0x76, 0xe2, 0xe2,
+	0x90, 0xfe, 0x26, 0x27, 0xe4, 0x17, 0x3a, 0xea, 0x06, 0x76, 0x9b, 0xe6, 0x6d, 0xe7, 0x00, 0x00,
+	0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82,
+};
+
+static const uint8_t png_bench_logo[] = {
+	0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+	0x00, 0x00, 0x02, 0x40, 0x00, 0x00, 0x00, 0xf0, 0x08, 0x06, 0x00, 0x00, 0x00, 0xe8, 0xcf, 0xdb,
+	0x6a, 0x00, 0x00, 0x00, 0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74,
+	0x00, 0x66, 0x69, 0x78, 0x74, 0x75, 0x72, 0x65, 0x97, 0x0f, 0xc6, 0x58, 0x00, 0x00, 0x28, 0xce,
+	0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0xed, 0x9d, 0xc9, 0xb3, 0x24, 0xd7, 0x55, 0xc6, 0x6f, 0x55,
+	0xdc, 0x08, 0x96, 0x2c, 0x90, 0x57, 0x44, 0x78, 0xc1, 0x06, 0x22, 0xf8, 0x0b, 0x58, 0x01, 0x01,
+	0x0b, 0x86, 0x00, 0x63, 0x0c, 0xc2, 0xf3, 0x20, 0x4b, 0x48, 0xb2, 0x5a, 0xd6, 0xd0, 0x52, 0xcb,
+	0x92, 0x2c, 0xa9, 0x25, 0x59, 0x53, 0xab, 0x5b, 0xad, 0xd6, 0x2c, 0x24, 0x6b, 0xb2, 0xac, 0xa1,
+	0x35, 0xda, 0x16, 0xb6, 0x71, 0x30, 0x07, 0x60, 0x19, 0x58, 0xb0, 0xe4, 0x2f, 0x60, 0xe5, 0x15,
+	0xc1, 0x82, 0x20, 0x42, 0x2a, 0xba, 0x5e, 0x77, 0x3d, 0xd7, 0xcb, 0x97, 0x59, 0x79, 0x33, 0xef,
+	0x74, 0xce, 0xb9, 0xbf, 0x2f, 0x42, 0x51, 0xed, 0x7a, 0xcf, 0xf5, 0xf2, 0xab, 0xcc, 0xbc, 0xf7,
+	0xcb, 0xfb, 0x7d, 0xf7, 0x1c, 0xef, 0x7e, 0xe5, 0x8f, 0xdc, 0x39, 0x7c, 0x74, 0xb1, 0x58, 0x7c,
+	0x74, 0xfb, 0x75, 0xfd, 0xdf, 0x72, 0xb9, 0xfc, 0xe8, 0x6a, 0xb5, 0x5a, 0xbf, 0xf7, 0xf3, 0xeb,
+	0x5f, 0x3a, 0xf7, 0xba, 0xf7, 0xdf, 0xb9, 0xf7, 0xdc, 0xb9, 0x9f, 0xed, 0xbf, 0xae, 0xd1, 0x7d,
+	0x6f, 0xfd, 0xba, 0xf9, 0xfd, 0xcd, 0xff, 0xb7, 0xef, 0xbd, 0xee, 0xe7, 0xf6, 0xbd, 0xd7, 0xfd,
+	0xdc, 0x35, 0xba, 0xef, 0x6d, 0x8e, 0x63, 0xfb, 0x6f, 0x75, 0xdf, 0xdb, 0x7e, 0x1d, 0x7a, 0x6f,
+	0xfb, 0xd8, 0x6b, 0x70, 0xee, 0x1e, 0x87, 0x24, 0xce, 0x43, 0xc7, 0xd1, 0xc7, 0x79, 0xe8, 0x38,
+	0x24, 0x70, 0xee, 0xe3, 0x27, 0x85, 0xf3, 0xae, 0xeb, 0xad, 0xfb, 0xb7, 0x86, 0xae, 0x2d, 0x09,
+	0x9c, 0x43, 0xae, 0xb7, 0x5a, 0x9c, 0x6b, 0xde, 0x63, 0x29, 0x39, 0x0f, 0xfd, 0xcd, 0x29, 0x9c,
+	0xa7, 0x1c, 0x47, 0x2e, 0xce, 0x43, 0x3f, 0x93, 0xc0, 0x39, 0xe7, 0x3d, 0x56, 0x92, 0xf3, 0xd0,
+	0x9c, 0x25, 0x81, 0x73, 0x8a, 0x39, 0x6b, 0x07, 0xe7, 0x33, 0x6b, 0x0d, 0xb3, 0xd1, 0x32, 0xeb,
+	0xd7, 0x8d, 0xbe, 0x59, 0x6b, 0x1d, 0xbf, 0x39, 0x98, 0xa1, 0x41, 0x70, 0xe8, 0x4b, 0xde, 0xfc,
+	0x7b, 0xec, 0xbd, 0xae, 0x10, 0xd8, 0xf5, 0x85, 0x77, 0x4f, 0xd0, 0xd0, 0xe7, 0x76, 0x8f, 0x2d,
+	0xe4, 0x38, 0x42, 0xf9, 0xd5, 0xe6, 0xdc, 0x77, 0x1c, 0x92, 0x38, 0x6f, 0xae, 0x95, 0x31, 0xce,
+	0x21, 0xe7, 0xb4, 0x26, 0xe7, 0x29, 0xe7, 0xb4, 0xef, 0x38, 0x72, 0x72, 0xee, 0x8a, 0xa6, 0x29,
+	0xd7, 0x9b, 0x14, 0xce, 0xa1, 0xd7, 0x5b, 0xe8, 0x39, 0x4d, 0xc9, 0x79, 0xf3, 0xb3, 0x5a, 0xe3,
+	0x4a, 0x4a, 0xce, 0xa1, 0xe3, 0xe6, 0xd0, 0x71, 0x84, 0x9c, 0xd3, 0x52, 0x9c, 0x53, 0xcf, 0x15,
+	0x35, 0x38, 0xd7, 0x9e, 0x1f, 0xa5, 0xdc, 0x63, 0x53, 0x38, 0xef, 0x12, 0x83, 0xb9, 0xef, 0x31,
+	0x1f, 0x73, 0xf3, 0x97, 0x12, 0x37, 0x73, 0x06, 0xde, 0x29, 0x93, 0x4d, 0x2b, 0x82, 0xae, 0x06,
+	0xe7, 0xda, 0x82, 0x2e, 0x05, 0x3f, 0x6b, 0x82, 0xae, 0x34, 0x67, 0x09, 0x82, 0x2e, 0x96, 0xb3,
+	0x46, 0x41, 0x97, 0xe3, 0x9c, 0x5a, 0x10, 0x74, 0xa5, 0x38, 0x47, 0xcd, 0x15, 0x2e, 0x2f, 0x67,
+	0x89, 0x0f, 0xff, 0xa9, 0x05, 0x5d, 0x08, 0x67, 0x1f, 0xfb, 0x01, 0x25, 0xc5, 0x4d, 0xee, 0xc9,
+	0x06, 0x41, 0xd7, 0x9e, 0xa0, 0x1b, 0x5b, 0x8e, 0xb6, 0x28, 0xe8, 0x42, 0xcf, 0xa9, 0x25, 0x41,
+	0x97, 0x92, 0xb3, 0xd4, 0x27, 0xe9, 0xd8, 0x07, 0x93, 0x69, 0x9c, 0x1d, 0x82, 0x4e, 0xb9, 0xa0,
+	0x8b, 0x79, 0x30, 0x91, 0xc6, 0x79, 0xee, 0xf5, 0xe6, 0x43, 0xfc, 0xc8, 0x5d, 0x3e, 0xe3, 0xb6,
+	0xf7, 0xd6, 0x7d, 0xaf, 0xcf, 0x23, 0x9c, 0xe3, 0xe5, 0x6d, 0xfb, 0x91, 0x43, 0xef, 0xf5, 0x7d,
+	0xee, 0x1c, 0x4f, 0x3a, 0xe4, 0xd8, 0x42, 0x8e, 0xa3, 0x26, 0xe7, 0xa1, 0xe3, 0x90, 0xc0, 0x39,
+	0xd4, 0xff, 0xde, 0x75, 0x1c, 0x92, 0x38, 0xa7, 0xb8, 0xde, 0x6a, 0x72, 0xae, 0x75, 0x8f, 0x85,
+	0x70, 0xee, 0xf2, 0x0b, 0xe1, 0x5c, 0xfa, 0x1e, 0xcb, 0x31, 0xae, 0x94, 0xe4, 0x1c, 0x7a, 0x4e,
+	0x73, 0xdf, 0x63, 0xb1, 0x9c, 0xa7, 0x5c, 0x6f, 0xa5, 0x39, 0x87, 0x8c, 0x9b, 0x63, 0xf7, 0x93,
+	0x24, 0xce, 0x29, 0xae, 0xb7, 0x9a, 0x9c, 0xb7, 0x7f, 0xe6, 0xb1, 0x46, 0xc8, 0xba, 0xb4, 0x9c,
+	0x75, 0xb1, 0x6c, 0x8d, 0xcc, 0xf1, 0xe1, 0xc9, 0xba, 0xb4, 0x95, 0x75, 0x89, 0x59, 0x3d, 0xb0,
+	0x6c, 0x8d, 0x58, 0xcb, 0xba, 0xa4, 0xe4, 0xac, 0xc1, 0x7e, 0x8c, 0xb6, 0xc0, 0xc8, 0xba, 0xd8,
+	0xcb, 0xba, 0xb4, 0x26, 0xe8, 0x6a, 0x58, 0x23, 0x1a, 0x04, 0x9d, 0x34, 0x9b, 0x00, 0x6b, 0x44,
+	0xc3, 0x64, 0xe3, 0x10, 0x74, 0x25, 0x39, 0x3b, 0x04, 0x5d, 0x09, 0xce, 0xbe, 0x6f, 0xc2, 0xb2,
+	0x9e, 0x75, 0x09, 0xfd, 0x82, 0x2c, 0x66, 0x5d, 0x5a, 0x0a, 0x2f, 0xa7, 0x7c, 0xaa, 0x6c, 0x75,
+	0xd7, 0x08, 0x82, 0x0e, 0x41, 0x47, 0x78, 0x59, 0x7f, 0xd6, 0x85, 0x15, 0xba, 0x7e, 0xce, 0x9e,
+	0xac, 0x4b, 0xde, 0xac, 0xcb, 0x14, 0xce, 0x64, 0x5d, 0xe4, 0xfa, 0xf0, 0x96, 0xb2, 0x2e, 0xb9,
+	0x39, 0x93, 0x75, 0xd1, 0x95, 0x75, 0xe9, 0x8e, 0x65, 0xc3, 0x9c, 0xdd, 0xa4, 0x7a, 0x4a, 0x92,
+	0xb3, 0x2e, 0x21, 0x9c, 0xab, 0x65, 0x5d, 0x5c, 0xfa, 0xac, 0x4b, 0xdf, 0x9c, 0x55, 0x93, 0x73,
+	0xec, 0x3d, 0x96, 0x82, 0xb3, 0x9b, 0x62, 0x81, 0xb1, 0x0d, 0xb8, 0xce, 0x6e, 0x34, 0xb2, 0x2e,
+	0x79, 0xb3, 0x2e, 0x12, 0x9f, 0xa4, 0xad, 0xf8, 0xf0, 0x58, 0x23, 0x96, 0x9e, 0xa4, 0x97, 0x2a,
+	0x56, 0xe8, 0xc8, 0xba, 0xb0, 0x1b, 0x6d, 0xd7, 0x71, 0xb8, 0x58, 0x0b, 0xcc, 0x42, 0xd6, 0x85,
+	0x6d, 0xc0, 0x64, 0x5d, 0x10, 0x74, 0x58, 0x23, 0x08, 0xba, 0x29, 0x9c, 0x1d, 0xe1, 0xe5, 0x12,
+	0xe3, 0x8a, 0xcb, 0xcb, 0xb9, 0x35, 0x41, 0x37, 0xc6, 0x39, 0x68, 0x17, 0x98, 0xc5, 0xac, 0x4b,
+	0xcd, 0xdc, 0x87, 0xd4, 0xc9, 0x86, 0xac, 0x0b, 0x82, 0x8e, 0xac, 0x0b, 0x82, 0x8e, 0x15, 0x3a,
+	0x04, 0x9d, 0x86, 0x15, 0xba, 0x14, 0x82, 0xce, 0x6f, 0xbe, 0x88, 0x96, 0xb2, 0x2e, 0x12, 0x72,
+	0x1f, 0x64, 0x5d, 0xe4, 0x64, 0x5d, 0xe6, 0x66, 0x0f, 0x24, 0x67, 0x5d, 0x4a, 0xf8, 0xf0, 0x76,
+	0xb3, 0x2e, 0x2b, 0xb2, 0x2e, 0x6e, 0x7b, 0x4c, 0x77, 0x6a, 0xea, 0xba, 0xa8, 0xcb, 0xba, 0xb8,
+	0xad, 0xf7, 0x5c, 0x9e, 0xac, 0x4b, 0xc9, 0x0c, 0x9d, 0x94, 0x7c, 0xcf, 0x68, 0x9f, 0xb0, 0x0b,
+	0xbf, 0xef, 0x5b, 0xcc, 0xba, 0x84, 0xf0, 0xd3, 0x5e, 0x15, 0x96, 0xac, 0x0b, 0x4f, 0xd2, 0x3c,
+	0x49, 0xdb, 0x5d, 0xa1, 0xcb, 0xf1, 0x24, 0x2d, 0x7d, 0x5c, 0xd1, 0xda, 0x99, 0x40, 0x4a, 0xe5,
+	0xe5, 0x94, 0x9c, 0xb5, 0xec, 0x46, 0xeb, 0x72, 0x76, 0x9d, 0x9f, 0x79, 0xac, 0x91, 0x36, 0x04,
+	0x1d, 0x59, 0x17, 0x04, 0x1d, 0x82, 0x0e, 0x41, 0xd7, 0x92, 0xa0, 0x23, 0xeb, 0x82, 0xa0, 0x1b,
+	0xb5, 0xc0, 0x42, 0x7e, 0x99, 0xaa, 0xb0, 0x64, 0x5d, 0x18, 0x78, 0xed, 0x08, 0x3a, 0xed, 0xbb,
+	0x46, 0x10, 0x74, 0xb9, 0x39, 0x3b, 0xb2, 0x2e, 0x08, 0xba, 0x26, 0x04, 0x9d, 0x4f, 0xe5, 0xcf,
+	0x6a, 0xcb, 0xba, 0xe4, 0xe4, 0xdc, 0xed, 0x13, 0x44, 0xd6, 0x85, 0xac, 0x0b, 0x59, 0x97, 0x86,
+	0xeb, 0xba, 0x08, 0xce, 0xba, 0x1c, 0xae, 0x01, 0xb6, 0xfd, 0xb3, 0xc5, 0xe4, 0x7b, 0x6c, 0xee,
+	0xb8, 0x52, 0x97, 0x73, 0xe5, 0xac, 0xcb, 0x62, 0xef, 0xab, 0xce, 0x92, 0x75, 0xc9, 0xd1, 0xe3,
+	0x2f, 0x96, 0x73, 0xad, 0xda, 0x82, 0xcb, 0x9e, 0xbf, 0xe5, 0x53, 0xa9, 0x7c, 0xac, 0x11, 0xfb,
+	0x35, 0x27, 0x78, 0x92, 0xae, 0xbb, 0x42, 0x87, 0x35, 0x42, 0xd6, 0x45, 0x83, 0x35, 0x52, 0x7b,
+	0x5c, 0x21, 0xeb, 0xd2, 0xc6, 0x0a, 0xdd, 0x14, 0xce, 0x2e, 0xa5, 0x05, 0x26, 0x3d, 0xbc, 0x8c,
+	0xa0, 0x23, 0xeb, 0x82, 0xa0, 0x23, 0xeb, 0x82, 0xa0, 0x43, 0xd0, 0x89, 0xce, 0xba, 0x2c, 0xcb,
+	0xb7, 0x9a, 0x6a, 0x49, 0xd0, 0x85, 0x70, 0xf6, 0xd6, 0xb2, 0x2e, 0x56, 0x54, 0x3e, 0x59, 0x97,
+	0x72, 0x03, 0x2f, 0x82, 0x0e, 0x41, 0xd7, 0xb2, 0xa0, 0x3b, 0x3c, 0xd9, 0x38, 0xf3, 0x59, 0x97,
+	0xdc, 0x2b, 0x26, 0x41, 0xd7, 0x9b, 0xab, 0xc3, 0xd9, 0x42, 0x78, 0x79, 0xea, 0xb8, 0xb9, 0x1c,
+	0x38, 0x0e, 0x4f, 0xd6, 0x85, 0xac, 0x4b, 0xcb, 0x59, 0x97, 0xd0, 0xec, 0x81, 0xa6, 0xac, 0x4b,
+	0x2a, 0x1f, 0xde, 0x76, 0xd6, 0x25, 0xee, 0x1e, 0x23, 0xeb, 0x22, 0xab, 0xae, 0x0b, 0x59, 0x97,
+	0xfa, 0x19, 0xba, 0x9a, 0x9c, 0xe7, 0x5e, 0x6f, 0xfe, 0x1f, 0xff, 0xeb, 0x6f, 0x1d, 0x00, 0x00,
+	0x80, 0x96, 0x71, 0x91, 0x92, 0xe3, 0x5c, 0x74, 0xfe, 0xbd, 0xba, 0xf0, 0xef, 0x0f, 0x7b, 0x7e,
+	0xeb, 0x67, 0xef, 0xad, 0x3a, 0xaf, 0x7c, 0xcd, 0x13, 0xbe, 0xea, 0x45, 0xe7, 0x8b, 0xdb, 0x7c,
+	0xad, 0x1f, 0xc8, 0x3d, 0xf4, 0xf7, 0x03, 0x7f, 0xcf, 0x73, 0xe3, 0x03, 0x00, 0x00, 0x00, 0xa0,
+	0x35, 0x20, 0x80, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x20, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x40, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x08, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x10, 0x00, 0x00, 0x00, 0x00,
+	0x80, 0x24, 0x01, 0xf4, 0xeb, 0xbf, 0xf8, 0x5b, 0x87, 0xaa, 0x33, 0xae, 0xb1, 0xa9, 0xa4, 0xd8,
+	0x2d, 0x51, 0xdd, 0x7d, 0x2f, 0xa4, 0x7a, 0xe3, 0xe6, 0x73, 0xfb, 0x4a, 0x59, 0x6f, 0x57, 0x76,
+	0xec, 0x96, 0xea, 0xee, 0xfe, 0xcd, 0x6e, 0x69, 0xec, 0xbe, 0x8a, 0x95, 0xdd, 0x0e, 0xd6, 0x63,
+	0x7f, 0x2b, 0x05, 0xe7, 0xa1, 0xe3, 0x90, 0xc0, 0xb9, 0xcb, 0x6f, 0x17, 0xe7, 0xa1, 0xe3, 0x90,
+	0xc0, 0x79, 0xe8, 0xda, 0x8a, 0xe5, 0x5c, 0xfa, 0x3c, 0x0f, 0x1d, 0x87, 0x04, 0xce, 0xa5, 0xef,
+	0xb1, 0x5c, 0x9c, 0x77, 0x5d, 0xc7, 0x1a, 0xc6, 0x95, 0x5d, 0x15, 0x87, 0x53, 0x73, 0x1e, 0xfb,
+	0x5b, 0xa5, 0xee, 0xb1, 0x94, 0x9c, 0x87, 0xfe, 0xe6, 0x94, 0xca, 0xd2, 0x12, 0x38, 0x87, 0x54,
+	0x54, 0xaf, 0xc5, 0x39, 0xe7, 0xf5, 0x56, 0x92, 0xb3, 0xa7, 0x61, 0x9e, 0x8d, 0x1e, 0x46, 0x63,
+	0xbd, 0x6d, 0x2c, 0xf6, 0x46, 0x2b, 0xd5, 0x30, 0x4f, 0x52, 0x6f, 0xb4, 0xdc, 0x9c, 0x63, 0xae,
+	0xb7, 0xe7, 0x8e, 0xbf, 0x56, 0xec, 0xc9, 0xed, 0x9a, 0x53, 0x97, 0x65, 0x69, 0x60, 0x5c, 0xaa,
+	0x87, 0xd1, 0x94, 0xbe, 0x4d, 0x73, 0xaf, 0xb7, 0xdd, 0x9c, 0x97, 0xc1, 0x9f, 0x5b, 0xea, 0x1e,
+	0x93, 0xd4, 0xb4, 0x59, 0x12, 0xe7, 0xd4, 0x73, 0x45, 0xed, 0x71, 0x45, 0x12, 0x67, 0x6f, 0xb1,
+	0x87, 0x51, 0x8a, 0x5e, 0x23, 0xda, 0x7a, 0x18, 0xe5, 0xe0, 0x3c, 0x76, 0x4e, 0xa5, 0x73, 0x9e,
+	0x72, 0x4e, 0x2d, 0xf5, 0x30, 0x8a, 0xe5, 0xdc, 0x7d, 0x22, 0xec, 0xe3, 0x5c, 0x52, 0xec, 0xf4,
+	0xe1, 0xcc, 0xd1, 0x67, 0x0e, 0xbd, 0x77, 0xfd, 0xc3, 0x57, 0xa8, 0xeb, 0x61, 0x14, 0x33, 0xae,
+	0x4c, 0xef, 0xf1, 0xb7, 0xfb, 0x9c, 0x6a, 0xb8, 0xc7, 0x72, 0xf7, 0x35, 0x4c, 0x72, 0x8f, 0xb9,
+	0x2d, 0xce, 0xae, 0x2c, 0xe7, 0xd8, 0x7e, 0x77, 0xb9, 0xc7, 0x95, 0xd0, 0xeb, 0x6d, 0x4e, 0x1f,
+	0xcd, 0xe5, 0x0c, 0xce, 0xbe, 0x44, 0x67, 0x5c, 0xab, 0x4f, 0xd2, 0x29, 0x9e, 0x40, 0x34, 0x74,
+	0x40, 0x2e, 0xb5, 0x5a, 0x95, 0x93, 0xb3, 0xf4, 0x15, 0x3a, 0x69, 0x4f, 0xd2, 0xdb, 0xef, 0xbd,
+	0x78, 0xf7, 0x1b, 0x2a, 0xfc, 0xfc, 0x87, 0xae, 0x7d, 0xea, 0xd0, 0x7b, 0x37, 0x3c, 0xf2, 0x15,
+	0xb3, 0x2b, 0x74, 0x25, 0xaf, 0xe3, 0xdc, 0x5d, 0xc6, 0x25, 0xaf, 0x34, 0xd7, 0x59, 0xa1, 0xab,
+	0x3b, 0x3f, 0x96, 0x58, 0xa1, 0x8b, 0x59, 0xb9, 0x39, 0x60, 0x7d, 0x45, 0x70, 0xf6, 0x58, 0x23,
+	0x08, 0xba, 0x96, 0x05, 0x1d, 0xd6, 0x48, 0x3f, 0xe7, 0x97, 0xbe, 0xf1, 0xa6, 0x89, 0x90, 0xe3,
+	0xc9, 0xaf, 0x3e, 0xb1, 0xff, 0xef, 0x1b, 0x1f, 0xbd, 0x4a, 0x8d, 0xe5, 0x8a, 0x35, 0x52, 0x9f,
+	0x33, 0x82, 0x2e, 0x2f, 0xe7, 0xed, 0x31, 0xaf, 0x96, 0xa0, 0xdb, 0xdf, 0x05, 0xd6, 0x52, 0xd6,
+	0xa5, 0x74, 0xee, 0x83, 0xac, 0x8b, 0xcc, 0x27, 0xe9, 0xd0, 0xcf, 0xb5, 0x28, 0xe8, 0xfa, 0x3e,
+	0xf7, 0xe5, 0x7b, 0xdf, 0x36, 0xbd, 0xe3, 0xe3, 0xc1, 0xab, 0x1f, 0xdf, 0xff, 0xf7, 0xb1, 0xc7,
+	0x8e, 0x90, 0x75, 0x09, 0xbc, 0x8e, 0xad, 0x09, 0xba, 0x9c, 0x9c, 0x37, 0xf6, 0x17, 0x82, 0x4e,
+	0x87, 0xa0, 0xf3, 0x31, 0x9e, 0xf4, 0x94, 0x7c, 0x8f, 0x64, 0x1f, 0x9e, 0xac, 0x4b, 0x9b, 0x59,
+	0x97, 0x39, 0x9c, 0x4b, 0xe5, 0x3e, 0x62, 0x33, 0x5b, 0xa1, 0x3e, 0xbc, 0x75, 0xd1, 0x33, 0x84,
+	0x13, 0x47, 0x1e, 0xdb, 0xff, 0xf7, 0x2d, 0x4f, 0x5d, 0x1b, 0x7c, 0x8f, 0x95, 0x1a, 0x57, 0xd2,
+	0x9e, 0xe7, 0xf1, 0x6b, 0x4b, 0x5b, 0xbe, 0x27, 0x36, 0xeb, 0x92, 0x93, 0xf3, 0xde, 0xeb, 0x22,
+	0x5f, 0xd6, 0xa5, 0x34, 0xe7, 0x14, 0xd9, 0xaa, 0x6c, 0x9c, 0xdd, 0xde, 0x57, 0x3d, 0x3b, 0x7b,
+	0xec, 0x4b, 0xda, 0x41, 0x64, 0x5d, 0xc8, 0xba, 0xa4, 0x5c, 0xa1, 0x2b, 0xb9, 0x6c, 0xab, 0xc9,
+	0x1a, 0x09, 0xe1, 0xdc, 0xaa, 0xf0, 0xe9, 0xc3, 0xbd, 0x57, 0x3c, 0xbc, 0xf7, 0x7a, 0xf3, 0x93,
+	0xd7, 0x88, 0x5e, 0xa1, 0x23, 0xeb, 0xa2, 0x33, 0xeb, 0x92, 0x7b, 0x85, 0xae, 0x14, 0x67, 0x49,
+	0x2b, 0x74, 0xa9, 0x76, 0x6b, 0xfb, 0xbe, 0x9b, 0x1a, 0x6b, 0x84, 0xac, 0x8b, 0x05, 0x41, 0x97,
+	0xea, 0x3a, 0xd6, 0x68, 0x8d, 0xf4, 0xbd, 0xf7, 0xca, 0xfd, 0xef, 0xa2, 0x76, 0x76, 0xe0, 0xbe,
+	0x2b, 0xcf, 0xec, 0xff, 0xfb, 0xd6, 0xa7, 0xaf, 0x23, 0xeb, 0x82, 0xa0, 0x9b, 0xce, 0x79, 0x49,
+	0x78, 0x59, 0x93, 0xa0, 0xf3, 0xb5, 0x56, 0x0f, 0x86, 0x02, 0x50, 0xda, 0x76, 0xca, 0x90, 0x75,
+	0xd1, 0x97, 0x75, 0x99, 0x7a, 0x1d, 0x6b, 0x0a, 0x2f, 0xf7, 0x7d, 0x06, 0xc2, 0x67, 0x3a, 0xee,
+	0xb9, 0xfc, 0xf4, 0xde, 0xeb, 0x6d, 0xcf, 0x1c, 0x35, 0xf2, 0x24, 0xed, 0x4c, 0xd5, 0x3d, 0x8b,
+	0x11, 0x74, 0x59, 0x37, 0xba, 0x38, 0x99, 0x82, 0x2e, 0x25, 0x67, 0x09, 0xe1, 0x65, 0x97, 0x88,
+	0xb3, 0xef, 0xfa, 0x6a, 0x64, 0x5d, 0xc8, 0xba, 0x48, 0xcf, 0xba, 0x48, 0xa8, 0x39, 0x21, 0xa3,
+	0xae, 0xcb, 0xee, 0xcf, 0x7d, 0xf5, 0x81, 0xef, 0xa0, 0x64, 0x22, 0x71, 0xf7, 0x65, 0xa7, 0xf6,
+	0x5e, 0x6f, 0x7f, 0xf6, 0x06, 0xa5, 0x59, 0x17, 0x3b, 0xf7, 0x58, 0xd3, 0x59, 0x97, 0x00, 0xce,
+	0xb5, 0x6a, 0x27, 0xcd, 0xb9, 0x8e, 0xa5, 0xd4, 0x16, 0xdc, 0x69, 0x81, 0xb5, 0x6e, 0x8d, 0x90,
+	0x75, 0xd1, 0x9f, 0x75, 0x69, 0x71, 0x1b, 0x30, 0xc2, 0x27, 0x3d, 0xee, 0xba, 0xf4, 0xe4, 0xde,
+	0xeb, 0x1d, 0xdf, 0xbc, 0x91, 0xac, 0x0b, 0x59, 0x17, 0x75, 0x59, 0x17, 0x69, 0x2b, 0x74, 0x25,
+	0xb3, 0xc7, 0xd1, 0x16, 0x58, 0x8b, 0xd6, 0x08, 0x59, 0x17, 0x1b, 0x82, 0x4e, 0xd3, 0x36, 0xe0,
+	0x14, 0x82, 0x0e, 0xf1, 0x93, 0x17, 0x77, 0x7e, 0xf9, 0x41, 0x77, 0xfc, 0xb9, 0x63, 0x4a, 0xb2,
+	0x2e, 0xce, 0x6c, 0xdd, 0xb3, 0x12, 0x6d, 0x97, 0x10, 0x74, 0x82, 0x38, 0x67, 0xba, 0xc7, 0x7c,
+	0x8b, 0x59, 0x97, 0xd8, 0xdc, 0x47, 0x8b, 0x59, 0x17, 0x8d, 0x82, 0x4e, 0xe3, 0x93, 0xf4, 0x5c,
+	0x41, 0xf7, 0xda, 0x89, 0xef, 0xa2, 0x4e, 0x0a, 0xe1, 0xf8, 0x25, 0x27, 0xce, 0xbf, 0x9e, 0x13,
+	0x42, 0xcd, 0x66, 0x5d, 0x56, 0xf6, 0xb3, 0x2e, 0x93, 0xc6, 0x15, 0x67, 0xa3, 0x8f, 0x66, 0x6b,
+	0x82, 0xce, 0xcf, 0xf5, 0xa4, 0xa7, 0xe4, 0x7b, 0x24, 0x66, 0x5d, 0x4a, 0xe7, 0x3e, 0xc8, 0xba,
+	0xc8, 0xf4, 0xa4, 0xa7, 0x70, 0x2e, 0x95, 0xfb, 0x98, 0xc2, 0xf9, 0xf5, 0x07, 0xbf, 0x87, 0x22,
+	0xa9, 0x2c, 0x84, 0xee, 0x7e, 0xf1, 0x66, 0xa1, 0x59, 0x97, 0x65, 0xb2, 0x1e, 0x7f, 0x96, 0xb2,
+	0x2e, 0x39, 0x39, 0x6b, 0xe8, 0xa3, 0x39, 0x85, 0x73, 0x8a, 0x6c, 0x55, 0x2a, 0xce, 0x2e, 0x43,
+	0xf6, 0xb8, 0x88, 0x05, 0xa6, 0xd1, 0x1a, 0x21, 0xeb, 0x22, 0x7b, 0x85, 0xae, 0x66, 0x55, 0x58,
+	0x29, 0x4f, 0xd2, 0x88, 0x1f, 0x19, 0xb8, 0xed, 0x0b, 0xf7, 0xb9, 0xbb, 0x5e, 0xf8, 0x9a, 0xa0,
+	0x27, 0x69, 0x47, 0xd6, 0xc5, 0x35, 0xbe, 0x1b, 0xcd, 0xd8, 0x0a, 0xdd, 0x72, 0x87, 0x36, 0x89,
+	0x59, 0xf9, 0xf7, 0x58, 0x23, 0x64, 0x5d, 0xac, 0x0a, 0x3a, 0xab, 0x03, 0xef, 0xd9, 0x93, 0xef,
+	0xa1, 0x3a, 0x84, 0xe1, 0xf6, 0x2f, 0xde, 0xbf, 0xf7, 0xfa, 0x8d, 0x97, 0x6e, 0x21, 0xeb, 0xd2,
+	0x52, 0xd6, 0xc5, 0x11, 0x5e, 0x2e, 0x21, 0xe8, 0x5c, 0x26, 0x41, 0xe7, 0x5b, 0xcc, 0xba, 0xa4,
+	0xee, 0x80, 0xac, 0x41, 0xd0, 0x59, 0xc9, 0xba, 0xb4, 0x5e, 0x44, 0x0c, 0xf1, 0x23, 0x1b, 0x5f,
+	0xff, 0xfc, 0xbd, 0x7b, 0x22, 0xc8, 0x6c, 0xd6, 0xc5, 0x88, 0xa0, 0x2b, 0xb9, 0xd1, 0x45, 0x8a,
+	0xa0, 0xab, 0xc1, 0x59, 0x7a, 0x67, 0x02, 0x4f, 0xd6, 0xc5, 0x76, 0xd6, 0xa5, 0x74, 0x6f, 0xb4,
+	0xdc, 0x9c, 0x6b, 0x79, 0xd2, 0xa9, 0x38, 0xc7, 0x64, 0x20, 0xde, 0x38, 0xf5, 0x97, 0x28, 0x0c,
+	0x25, 0x22, 0xe8, 0xde, 0x97, 0xbf, 0x5e, 0x29, 0xeb, 0x72, 0xfe, 0xbf, 0xd2, 0x75, 0xcf, 0x24,
+	0x65, 0x5d, 0x8a, 0xd4, 0x3d, 0x5b, 0x9e, 0x5f, 0xfd, 0x29, 0xc1, 0x39, 0x45, 0xd6, 0x25, 0x55,
+	0xad, 0xb7, 0x39, 0xe7, 0x79, 0xce, 0xf5, 0xb6, 0xda, 0xfe, 0x8c, 0x8c, 0x9c, 0x3d, 0xd6, 0x08,
+	0x59, 0x17, 0x4d, 0x2b, 0x74, 0x7d, 0x55, 0x48, 0xad, 0x3f, 0x49, 0xbf, 0xf9, 0xd0, 0xf7, 0x51,
+	0x15, 0xca, 0x70, 0xcb, 0x67, 0xbf, 0xb1, 0xf7, 0xba, 0x16, 0x42, 0xe5, 0x9e, 0xa4, 0x1d, 0x59,
+	0x97, 0x12, 0x59, 0x17, 0x57, 0x7e, 0x5c, 0xa9, 0x5d, 0x79, 0xb9, 0xf4, 0x6e, 0xb4, 0x52, 0xab,
+	0x55, 0xbe, 0xc5, 0xac, 0x0b, 0xfd, 0x55, 0xda, 0x10, 0x74, 0x9a, 0x06, 0xde, 0x21, 0xce, 0x88,
+	0x1f, 0xfd, 0x42, 0x68, 0x2d, 0x82, 0xb0, 0x46, 0x74, 0x59, 0x23, 0x16, 0x05, 0x5d, 0x8a, 0x8d,
+	0x2e, 0xa5, 0x05, 0x9d, 0xcb, 0x1c, 0xcf, 0xf1, 0xa9, 0x9e, 0xa4, 0xc9, 0xba, 0x20, 0xe8, 0x08,
+	0x2f, 0xa7, 0xe5, 0x8c, 0xe5, 0x65, 0x47, 0x04, 0xdd, 0xf7, 0xed, 0xdb, 0x0a, 0x64, 0x5d, 0x96,
+	0x64, 0x5d, 0x10, 0x74, 0x6a, 0x56, 0xc1, 0x07, 0xff, 0x56, 0x41, 0x41, 0xe7, 0x37, 0x37, 0x52,
+	0x4b, 0x59, 0x97, 0xd2, 0xb9, 0x0f, 0x4d, 0x35, 0x27, 0x24, 0x64, 0x5d, 0x4a, 0x79, 0xd2, 0x29,
+	0x7d, 0xf8, 0xd4, 0x9c, 0x59, 0xf9, 0xb1, 0x85, 0x9b, 0x3f, 0x73, 0xb7, 0xbb, 0xff, 0x95, 0xdb,
+	0x33, 0x64, 0x5d, 0x56, 0x79, 0xb3, 0x2e, 0x42, 0x6b, 0xd9, 0x14, 0xcf, 0xba, 0xb8, 0x3c, 0x59,
+	0x97, 0x52, 0xf9, 0x9e, 0x90, 0xba, 0x67, 0x39, 0xb2, 0x55, 0xb1, 0x9c, 0x97, 0x99, 0xb3, 0xc7,
+	0xbe, 0xc5, 0xac, 0x8b, 0x86, 0x25, 0x4c, 0xcd, 0xfd, 0x55, 0x34, 0x79, 0xd2, 0xd2, 0x56, 0xe8,
+	0x10, 0x3e, 0x76, 0xf1, 0xb5, 0x4f, 0xdf, 0xb5, 0xf7, 0x7a, 0xe2, 0xb5, 0xe3, 0x58, 0x23, 0x95,
+	0xc7, 0x95, 0xdc, 0x9c, 0x25, 0xf7, 0xd1, 0xb4, 0xb0, 0x42, 0xb7, 0x1d, 0x1d, 0x88, 0xd9, 0xad,
+	0xed, 0xb1, 0x46, 0x10, 0x74, 0x84, 0x97, 0x65, 0x08, 0xba, 0xb7, 0x4e, 0xff, 0x00, 0x95, 0xd0,
+	0x00, 0x8e, 0x7d, 0xf2, 0xb8, 0x7b, 0xe0, 0xd5, 0x3b, 0x22, 0xef, 0x31, 0x47, 0xd6, 0xc5, 0x50,
+	0xd6, 0x05, 0x41, 0xd7, 0x5f, 0xf4, 0x30, 0xb7, 0xa0, 0xf3, 0x64, 0x5d, 0x10, 0x74, 0x08, 0xba,
+	0xfa, 0x82, 0xee, 0xed, 0x87, 0x7f, 0x88, 0x32, 0x68, 0x08, 0x37, 0x7d, 0xea, 0xce, 0xbd, 0x95,
+	0x20, 0xb2, 0x2e, 0xe5, 0xc3, 0xcb, 0xa1, 0x73, 0xc5, 0xfe, 0x71, 0x38, 0xfd, 0x82, 0x6e, 0x32,
+	0xe7, 0x8a, 0x82, 0xce, 0x15, 0xea, 0x4c, 0xb0, 0x86, 0x4f, 0xe5, 0xcf, 0x6a, 0xcb, 0xba, 0xa4,
+	0xe2, 0x2c, 0x39, 0xeb, 0x92, 0xa3, 0xe6, 0x44, 0x4d, 0xce, 0xb5, 0x3c, 0xe9, 0xdc, 0x3d, 0x8c,
+	0xb0, 0xbd, 0xda, 0x5d, 0x09, 0x7a, 0xf0, 0xf5, 0x3b, 0x23, 0x72, 0x1f, 0xf1, 0xf7, 0x58, 0xc8,
+	0xdf, 0xd2, 0x94, 0x75, 0xc9, 0x5a, 0xf7, 0x6c, 0x51, 0x9e, 0x73, 0xaa, 0xac, 0xcb, 0x6c, 0xce,
+	0x2e, 0x6d, 0xbd, 0x28, 0x49, 0x9c, 0xd7, 0xaf, 0x9e, 0xac, 0x8b, 0xfe, 0xdd, 0x68, 0x1a, 0xb3,
+	0x2e, 0x2d, 0xd6, 0x9c, 0xe8, 0xfb, 0x7d, 0xc4, 0x4f, 0xdb, 0xb8, 0xf1, 0xcf, 0xee, 0x70, 0x27,
+	0xcf, 0xde, 0x35, 0xe3, 0x7a, 0x5b, 0x8a, 0xb1, 0x46, 0xa4, 0x55, 0x5e, 0x26, 0xeb, 0xa2, 0x7b,
+	0x37, 0x5a, 0x49, 0x37, 0xc7, 0x63, 0x8d, 0x20, 0xe8, 0x34, 0x8a, 0x9b, 0xa9, 0xcb, 0xb6, 0x12,
+	0x05, 0x1d, 0xb6, 0x17, 0x58, 0xe3, 0x86, 0x8b, 0x6f, 0xdf, 0x13, 0x41, 0xd3, 0xae, 0x37, 0x27,
+	0xca, 0x1a, 0x29, 0x35, 0xae, 0x94, 0xb2, 0x46, 0x0e, 0xbc, 0xb7, 0xd4, 0x2f, 0xe8, 0x26, 0x73,
+	0x36, 0x20, 0xe8, 0x82, 0x2c, 0x30, 0xb2, 0x2e, 0x08, 0x3a, 0xc2, 0xcb, 0xe5, 0x05, 0x1d, 0xe2,
+	0x07, 0x74, 0x45, 0xd0, 0xa9, 0x37, 0xee, 0xae, 0x92, 0x75, 0xa9, 0xb1, 0x7a, 0x50, 0x3b, 0xeb,
+	0x32, 0xf6, 0xb9, 0x07, 0xc6, 0x3c, 0x67, 0x43, 0xd0, 0x85, 0x70, 0xae, 0x29, 0xe8, 0x5c, 0x85,
+	0xda, 0x82, 0x9e, 0xac, 0x8b, 0xee, 0x5a, 0x36, 0x9a, 0xb2, 0x2e, 0x12, 0xf2, 0x3d, 0xdd, 0x7a,
+	0x18, 0x29, 0x3d, 0xe9, 0x50, 0xce, 0xec, 0xf6, 0x02, 0x7d, 0x38, 0xfa, 0xa7, 0xb7, 0xb9, 0xd3,
+	0x6f, 0xdd, 0x13, 0x90, 0x75, 0x71, 0x79, 0xb3, 0x2e, 0x4e, 0x76, 0x2d, 0x1b, 0xb2, 0x2e, 0xf3,
+	0xfa, 0x68, 0x4e, 0xe1, 0x5c, 0x2a, 0x4f, 0x16, 0x9b, 0x05, 0x8d, 0xcd, 0x1e, 0xfb, 0x56, 0xb3,
+	0x2e, 0x1a, 0x2a, 0xa4, 0x5a, 0xca, 0xba, 0x58, 0xa8, 0x0a, 0x9b, 0xea, 0x09, 0x04, 0x80, 0x21,
+	0xb4, 0x6a, 0x8d, 0x4c, 0xe5, 0x9c, 0xcd, 0x1a, 0x71, 0x36, 0xb3, 0x2e, 0x53, 0xcf, 0xb3, 0xf4,
+	0x15, 0xba, 0x29, 0x9c, 0x77, 0x5d, 0x6f, 0x9e, 0xac, 0x0b, 0x82, 0x0e, 0x41, 0x57, 0x4e, 0xd0,
+	0x61, 0x7d, 0x81, 0x5d, 0xb8, 0xfe, 0x4f, 0xbe, 0x7e, 0x60, 0x15, 0xe8, 0xf0, 0x75, 0xec, 0x8a,
+	0x37, 0x6d, 0xb6, 0x98, 0x75, 0xc9, 0xcd, 0x59, 0x5a, 0xd6, 0x65, 0x2e, 0xe7, 0x9c, 0xe2, 0xc6,
+	0x09, 0x28, 0xbf, 0xe3, 0xb7, 0x9f, 0x3c, 0x08, 0x2f, 0x13, 0x5e, 0x6e, 0x51, 0xd0, 0x95, 0x2a,
+	0x22, 0x86, 0xf8, 0x01, 0x21, 0xb8, 0xee, 0x13, 0xb7, 0x1e, 0x10, 0x41, 0x12, 0xf2, 0x3d, 0x96,
+	0xb2, 0x2e, 0x21, 0x73, 0x45, 0x5f, 0xd7, 0x77, 0xcd, 0x82, 0x2e, 0x98, 0xb3, 0x21, 0x41, 0x17,
+	0xc2, 0xcf, 0x87, 0xfa, 0xb3, 0x96, 0xb2, 0x2e, 0xa9, 0x38, 0x93, 0x75, 0x29, 0xc7, 0xb9, 0xb6,
+	0x27, 0x1d, 0xcb, 0xf9, 0x9d, 0x33, 0x7f, 0xc5, 0xcc, 0x0e, 0x26, 0x89, 0xa0, 0x33, 0xef, 0xdc,
+	0xd7, 0xdb, 0xf0, 0x34, 0x75, 0xd6, 0x25, 0x45, 0xdd, 0x33, 0x6d, 0x59, 0x97, 0x9d, 0x73, 0xc5,
+	0xc2, 0x5e, 0xd6, 0x25, 0x55, 0x16, 0x34, 0xc5, 0xdc, 0x7d, 0xe0, 0x33, 0x2a, 0xd7, 0x16, 0xf4,
+	0x58, 0x23, 0x36, 0x76, 0xa3, 0x49, 0xcc, 0xba, 0xe4, 0xde, 0x8d, 0xa6, 0x65, 0x1b, 0x30, 0x2b,
+	0x3f, 0x60, 0x0e, 0xae, 0xf9, 0xf8, 0xcd, 0xee, 0x91, 0x77, 0x9d, 0x68, 0x6b, 0x44, 0xda, 0x6e,
+	0xb4, 0x68, 0x6b, 0xc4, 0xd9, 0xcc, 0xba, 0x84, 0x3a, 0x1b, 0x25, 0x57, 0xe8, 0x96, 0x02, 0xdc,
+	0x9c, 0x5e, 0x0b, 0x0c, 0x6b, 0x04, 0x41, 0x67, 0x21, 0xbc, 0x2c, 0x65, 0x1b, 0x30, 0x00, 0x73,
+	0x21, 0xdd, 0x1a, 0x11, 0x13, 0x5e, 0x4e, 0x6c, 0x8d, 0x98, 0x11, 0x74, 0x82, 0x39, 0x3b, 0x01,
+	0xa5, 0x68, 0xbc, 0xf6, 0x6e, 0xc0, 0x56, 0x1a, 0xe6, 0x59, 0xca, 0xba, 0x58, 0xdb, 0x35, 0x12,
+	0xc3, 0x19, 0xeb, 0x0b, 0xc4, 0xae, 0x02, 0x9d, 0x79, 0xa7, 0xfe, 0x4a, 0xb3, 0xa5, 0xac, 0x4b,
+	0xe8, 0x4a, 0xb3, 0x25, 0x41, 0x27, 0xad, 0x8f, 0x66, 0x09, 0x41, 0x17, 0xc2, 0xb9, 0xb7, 0x17,
+	0x98, 0xa6, 0xac, 0x4b, 0xce, 0xfe, 0x2a, 0x64, 0x5d, 0xa6, 0x73, 0xae, 0xd5, 0xcf, 0x67, 0x8a,
+	0x27, 0x9d, 0xc3, 0x87, 0xef, 0x3b, 0x0e, 0xac, 0x2f, 0x90, 0x4a, 0x04, 0x3d, 0xfa, 0x9d, 0xb8,
+	0xbc, 0x45, 0xed, 0x71, 0x45, 0x45, 0xd6, 0x65, 0x99, 0x2f, 0xeb, 0x52, 0xbb, 0x8f, 0xe6, 0x94,
+	0xf3, 0x9c, 0x2b, 0x4f, 0xb6, 0xda, 0xfe, 0x8c, 0x99, 0x9c, 0xe7, 0x5c, 0xc7, 0xbb, 0x38, 0x4f,
+	0xb6, 0xc0, 0x2c, 0x64, 0x5d, 0x4a, 0x97, 0x7f, 0x6f, 0x25, 0xeb, 0xa2, 0x69, 0xd7, 0xc8, 0x94,
+	0xcf, 0x9d, 0x73, 0xbd, 0x21, 0x7e, 0x40, 0x4a, 0x5c, 0xfd, 0xb1, 0x9b, 0xdc, 0x63, 0xdf, 0x3d,
+	0xd1, 0x84, 0x35, 0x52, 0xa5, 0x4a, 0xbf, 0x93, 0xb9, 0x1b, 0xad, 0xa4, 0x1d, 0xa4, 0x6d, 0x85,
+	0x2e, 0xc5, 0xf5, 0xe6, 0xb1, 0x46, 0xda, 0x11, 0x74, 0x35, 0x4b, 0xde, 0x6b, 0x2e, 0x22, 0x36,
+	0xe7, 0x7a, 0x03, 0x20, 0x67, 0x1e, 0x48, 0x63, 0xdd, 0x33, 0x4d, 0xd6, 0x88, 0x7a, 0x41, 0x67,
+	0x24, 0x0b, 0x9a, 0xbb, 0xfc, 0x8e, 0x27, 0xeb, 0x42, 0xd6, 0xa5, 0x65, 0x41, 0x37, 0xb7, 0x42,
+	0xea, 0x2e, 0xce, 0xac, 0xfe, 0x80, 0xdc, 0xab, 0x40, 0x25, 0x27, 0x1b, 0xb2, 0x2e, 0x08, 0xba,
+	0x58, 0x41, 0xe7, 0x84, 0x0a, 0x3a, 0x1f, 0xe2, 0x97, 0xd5, 0xae, 0x65, 0x53, 0xa3, 0xe6, 0x04,
+	0x59, 0x17, 0x39, 0x9c, 0x73, 0x79, 0xd2, 0x39, 0x38, 0x13, 0x7a, 0x06, 0x39, 0x71, 0xe4, 0x0f,
+	0x8f, 0xb9, 0xc7, 0xbf, 0xf7, 0x60, 0xf1, 0x1e, 0x7f, 0x96, 0xb2, 0x2e, 0xfb, 0xfc, 0x56, 0x4e,
+	0x2c, 0xe7, 0xd4, 0x59, 0x97, 0xd0, 0xf9, 0x31, 0x15, 0xe7, 0x83, 0x75, 0x95, 0x7e, 0x76, 0x1c,
+	0x0b, 0x27, 0xab, 0xb6, 0xa0, 0xd7, 0xb0, 0x7a, 0xa0, 0xc1, 0x1a, 0xb1, 0xd2, 0x01, 0x59, 0xcb,
+	0x0a, 0x9d, 0xd4, 0x6d, 0xc0, 0x00, 0x94, 0xb4, 0xc3, 0xb0, 0x46, 0xda, 0xa9, 0x7b, 0x46, 0x67,
+	0x82, 0xf4, 0x9c, 0x3d, 0xd6, 0x08, 0x82, 0xce, 0x6a, 0x78, 0x39, 0xe5, 0x39, 0x0d, 0xe1, 0x8c,
+	0xf5, 0x05, 0x4a, 0xe0, 0xaa, 0x3f, 0xb8, 0xd1, 0x3d, 0xf1, 0xde, 0x49, 0xb2, 0x2e, 0x08, 0x3a,
+	0x04, 0x5d, 0x24, 0x67, 0xdf, 0x37, 0x61, 0x59, 0x0f, 0x2f, 0x4b, 0xe9, 0x80, 0xac, 0x3d, 0xeb,
+	0x42, 0x85, 0xd4, 0xc5, 0xa1, 0x70, 0x2a, 0x00, 0x25, 0xd0, 0x62, 0xa1, 0x3e, 0x04, 0x9d, 0x5e,
+	0x41, 0xe7, 0x84, 0x0a, 0x3a, 0x2f, 0x35, 0xf7, 0x51, 0xbb, 0xe6, 0x04, 0x59, 0x97, 0xe9, 0x9c,
+	0x53, 0xf4, 0xf3, 0xc9, 0xed, 0x49, 0xcf, 0xf5, 0xe1, 0xc7, 0x38, 0x93, 0xfd, 0x01, 0x25, 0x71,
+	0xe5, 0xef, 0x1f, 0x75, 0x4f, 0x7d, 0xff, 0xa1, 0x24, 0xb9, 0x8f, 0x14, 0x35, 0xc0, 0xb4, 0x65,
+	0x5d, 0xd6, 0xdb, 0xde, 0xf7, 0x7e, 0xb6, 0xc8, 0xd3, 0x1b, 0x4d, 0x02, 0xe7, 0xa1, 0x2c, 0xe8,
+	0x94, 0x6c, 0x95, 0x24, 0xce, 0x31, 0x73, 0xc5, 0x10, 0xe7, 0x60, 0x0b, 0xcc, 0x52, 0xd6, 0x25,
+	0x75, 0xee, 0xa3, 0xc5, 0xac, 0x8b, 0xd6, 0x5d, 0x23, 0x73, 0x96, 0x6d, 0xc7, 0x8e, 0x0d, 0xf1,
+	0x03, 0x6a, 0xe0, 0x8a, 0xdf, 0xbb, 0x7e, 0x5f, 0x04, 0x61, 0x8d, 0x90, 0x75, 0x69, 0x65, 0x85,
+	0x2e, 0xe5, 0x6a, 0x55, 0x56, 0x0b, 0x4c, 0x83, 0x35, 0xd2, 0x8a, 0xa0, 0xab, 0x59, 0xf2, 0x5e,
+	0xbb, 0x0f, 0x1f, 0x72, 0x1c, 0x00, 0xd4, 0x04, 0x59, 0x97, 0x09, 0x9c, 0x1d, 0x82, 0xce, 0x42,
+	0x1f, 0xcd, 0x14, 0xe5, 0x77, 0x7c, 0x89, 0xdd, 0x41, 0x92, 0x3d, 0x69, 0x6b, 0x82, 0xae, 0x44,
+	0xd6, 0x45, 0x9b, 0xca, 0xcf, 0x59, 0x09, 0xf7, 0xdd, 0x47, 0x7e, 0xc4, 0xec, 0x0b, 0xaa, 0xae,
+	0x02, 0x3d, 0xfd, 0x83, 0xd3, 0x22, 0xea, 0x9e, 0x91, 0x75, 0x21, 0xbc, 0xbc, 0xab, 0xe1, 0xa9,
+	0x44, 0x41, 0xe7, 0x37, 0x4a, 0x4a, 0x6a, 0x2d, 0x9b, 0x9a, 0x35, 0x27, 0xc8, 0xba, 0xd4, 0xe7,
+	0x2c, 0xd9, 0x93, 0x66, 0x05, 0x08, 0x48, 0x41, 0xee, 0x7c, 0x8f, 0x99, 0xac, 0x8b, 0x6b, 0x33,
+	0xeb, 0x52, 0x92, 0xb3, 0xe4, 0xde, 0xa1, 0xdd, 0xe3, 0xf0, 0xef, 0xfd, 0xe7, 0xbb, 0x8c, 0x1e,
+	0x00, 0xcc, 0xc0, 0xc5, 0x17, 0x5d, 0xca, 0x97, 0x00, 0xaa, 0xe3, 0xf2, 0xdf, 0xbd, 0xce, 0x9d,
+	0xfd, 0xe9, 0xb3, 0x05, 0xfe, 0x52, 0x57, 0xf0, 0xaf, 0x3a, 0xaf, 0xfd, 0xf8, 0xb0, 0xe7, 0xb7,
+	0x36, 0xef, 0x7d, 0x50, 0xe2, 0x0b, 0xba, 0xe8, 0xdc, 0x7f, 0x1f, 0x39, 0xf7, 0xdf, 0x2f, 0x28,
+	0x39, 0xa1, 0xbb, 0xbe, 0xe6, 0x95, 0xdc, 0xc3, 0x7e, 0xff, 0xdc, 0x7f, 0x3f, 0xb9, 0xf0, 0xaa,
+	0x05, 0x9e, 0xe1, 0x03, 0x00, 0x00, 0x00, 0x00, 0xad, 0x01, 0x01, 0x04, 0xc0, 0x0c, 0xb0, 0xfa,
+	0x03, 0xa4, 0x5d, 0x8f, 0x65, 0x56, 0x81, 0x00, 0x40, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x20,
+	0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x40, 0x00, 0x18, 0x05, 0xf6, 0x17, 0x90, 0x7a, 0x5d,
+	0x62, 0x83, 0x01, 0x80, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0x01, 0x90, 0xea, 0x29,
+	0x1b, 0x00, 0xc9, 0xd7, 0x27, 0xab, 0x40, 0x00, 0x20, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfa,
+	0x05, 0xd0, 0xc7, 0x7e, 0xf5, 0x13, 0x07, 0xaa, 0x26, 0x86, 0x56, 0x6f, 0x0c, 0xad, 0xe0, 0xd9,
+	0x7d, 0xed, 0xbe, 0x37, 0xa5, 0x7a, 0xe3, 0xa6, 0xea, 0x63, 0xdf, 0x7b, 0xdd, 0xcf, 0x1d, 0x3a,
+	0x8e, 0xed, 0xcf, 0xad, 0xc5, 0x79, 0xe8, 0x38, 0x24, 0x70, 0x1e, 0x3a, 0x8e, 0xa1, 0xef, 0x63,
+	0x17, 0xbf, 0x9a, 0x9c, 0xb7, 0x8f, 0x77, 0x17, 0xe7, 0x6e, 0xe5, 0xec, 0x31, 0xce, 0x8e, 0xc6,
+	0xa7, 0x40, 0x38, 0xfe, 0xe7, 0x3f, 0xfe, 0x77, 0xf4, 0xda, 0xee, 0xde, 0x4f, 0x39, 0xc7, 0x95,
+	0x90, 0x7b, 0x2c, 0xe4, 0x38, 0xfa, 0xee, 0xe7, 0xa1, 0x31, 0x64, 0x0a, 0xe7, 0xa1, 0xe3, 0xc8,
+	0x3d, 0xae, 0xa4, 0xe6, 0x1c, 0x32, 0x46, 0xd7, 0xe2, 0x3c, 0xe5, 0x7a, 0x0b, 0x99, 0x3f, 0x52,
+	0x71, 0xf6, 0x43, 0xbf, 0xb4, 0x99, 0x80, 0x34, 0x35, 0xa5, 0xd4, 0xd6, 0x5f, 0x65, 0xec, 0xd8,
+	0x6a, 0x76, 0x03, 0xb6, 0xd2, 0x30, 0x2f, 0xe4, 0x7a, 0x0b, 0xed, 0x77, 0x47, 0xd7, 0x77, 0xa0,
+	0x01, 0x97, 0xfc, 0xf6, 0x11, 0xf7, 0xdc, 0x5f, 0x3f, 0x96, 0xac, 0xc7, 0x5f, 0xaa, 0xb1, 0xb4,
+	0x54, 0x9f, 0xb0, 0xdc, 0x9c, 0x53, 0x8f, 0x2b, 0x29, 0x39, 0x97, 0x9c, 0xc7, 0xdc, 0x8c, 0x3e,
+	0x9a, 0xd2, 0x7a, 0x87, 0xfa, 0x3e, 0x85, 0xb5, 0xfd, 0x1a, 0xd2, 0x33, 0xab, 0x56, 0xaf, 0x91,
+	0x50, 0x45, 0x38, 0xb7, 0xd7, 0x48, 0x29, 0xce, 0x63, 0xc7, 0x56, 0xb2, 0xbf, 0xca, 0x1c, 0xce,
+	0x29, 0xfa, 0xf9, 0xe4, 0xe2, 0x1c, 0x72, 0xbd, 0x4d, 0xe9, 0x77, 0x07, 0x80, 0x06, 0xa4, 0xec,
+	0xf1, 0x97, 0xa3, 0x6f, 0x53, 0xcc, 0xb8, 0x99, 0x62, 0x5c, 0x89, 0xe5, 0x9c, 0x7a, 0x5c, 0xd1,
+	0xd2, 0x47, 0x73, 0xff, 0x67, 0x5b, 0xc7, 0xb1, 0xc8, 0xcc, 0x39, 0xe6, 0x7a, 0x1b, 0xe3, 0xec,
+	0x43, 0xd5, 0xdf, 0x94, 0xd5, 0x83, 0x12, 0x8a, 0xd7, 0x42, 0x97, 0x71, 0x6b, 0x1d, 0x90, 0x25,
+	0xaf, 0xd0, 0x85, 0x5c, 0xc7, 0x63, 0xdf, 0x3d, 0x00, 0x5a, 0x50, 0xfa, 0x49, 0x3a, 0x45, 0x97,
+	0xf1, 0x14, 0x2b, 0x37, 0xa5, 0x39, 0x4b, 0x58, 0xad, 0x1a, 0x1b, 0x37, 0x43, 0x3f, 0x57, 0xfa,
+	0x0a, 0x5d, 0x8e, 0xb9, 0xc2, 0xe7, 0x9c, 0x6c, 0xb4, 0x5b, 0x23, 0x08, 0xba, 0x36, 0x04, 0x5d,
+	0xc8, 0x0d, 0xf9, 0xd6, 0xe9, 0x1f, 0x30, 0xab, 0x02, 0x55, 0x36, 0xd8, 0xf3, 0x7f, 0xf3, 0x78,
+	0x15, 0x71, 0x93, 0x6b, 0x82, 0x0d, 0x1a, 0x37, 0x1d, 0x82, 0x0e, 0x41, 0x17, 0x7e, 0x4e, 0x7d,
+	0xab, 0x59, 0x97, 0xcd, 0x2b, 0x59, 0x17, 0xdb, 0x82, 0x2e, 0x25, 0x67, 0x00, 0x34, 0xae, 0x04,
+	0xc5, 0x4c, 0x36, 0x16, 0xb3, 0x2e, 0x52, 0x38, 0x97, 0x14, 0x37, 0x53, 0x39, 0x87, 0x88, 0x1b,
+	0x27, 0x5c, 0xd0, 0x85, 0x9c, 0x53, 0x1f, 0x9a, 0xb7, 0xb0, 0x96, 0x75, 0x99, 0xc3, 0x59, 0x43,
+	0xd6, 0x25, 0xb7, 0x0f, 0x5f, 0x8a, 0xf3, 0x54, 0x4f, 0x3a, 0xa7, 0x0f, 0xbf, 0xf9, 0x5e, 0x01,
+	0xd0, 0x84, 0x29, 0xf7, 0xae, 0xe6, 0xac, 0xcb, 0xfe, 0xff, 0xd7, 0xa5, 0xcf, 0xba, 0x94, 0xe4,
+	0x9c, 0x33, 0xeb, 0x52, 0x82, 0x73, 0x8a, 0xeb, 0x2d, 0x17, 0xe7, 0xa1, 0xe3, 0xf0, 0x7d, 0x9e,
+	0x31, 0xd6, 0x08, 0xbb, 0xd1, 0xa4, 0xac, 0xd0, 0x49, 0xf0, 0xa4, 0xdf, 0x7e, 0xf8, 0x87, 0xcc,
+	0xa6, 0x40, 0x1d, 0xbe, 0xf0, 0x9b, 0x57, 0xba, 0x17, 0xff, 0xee, 0xc9, 0x26, 0xac, 0x91, 0xd4,
+	0x2b, 0xcd, 0xd6, 0xb2, 0x2e, 0xb1, 0x9c, 0x9d, 0xc0, 0x15, 0xba, 0x14, 0x59, 0x50, 0x8f, 0x35,
+	0x42, 0xd6, 0xc5, 0x72, 0x78, 0x39, 0x05, 0x67, 0x00, 0x2c, 0x59, 0x60, 0x29, 0xac, 0x11, 0x71,
+	0x59, 0x17, 0x97, 0xd6, 0x1a, 0xb1, 0x96, 0x75, 0xa9, 0xc9, 0x59, 0xe2, 0xc3, 0x7f, 0xef, 0x2e,
+	0x30, 0xb2, 0x2e, 0x08, 0xba, 0xd6, 0x04, 0x5d, 0xc8, 0x39, 0x05, 0x40, 0x3b, 0x62, 0xee, 0x5d,
+	0x8b, 0x59, 0x97, 0xb1, 0xba, 0x67, 0x9a, 0xc2, 0xcb, 0x29, 0x9d, 0x8d, 0x90, 0x63, 0x73, 0x8a,
+	0x04, 0xdd, 0x18, 0x67, 0x4f, 0xd6, 0x85, 0xac, 0x4b, 0x0c, 0xe7, 0x14, 0xd9, 0x2a, 0x2d, 0x9e,
+	0x34, 0x00, 0x9a, 0x73, 0x40, 0x63, 0xf7, 0xae, 0xda, 0xac, 0x8b, 0x9b, 0x36, 0xae, 0xc4, 0x72,
+	0xd6, 0x98, 0x75, 0xd9, 0xc5, 0x39, 0x74, 0x1e, 0xab, 0xc1, 0x39, 0xe6, 0x7a, 0x0b, 0xe1, 0xec,
+	0xb5, 0x5a, 0x23, 0xb1, 0x59, 0x17, 0x69, 0x15, 0x52, 0xb5, 0xf8, 0xf0, 0x9a, 0x2b, 0xa4, 0xce,
+	0x7d, 0x02, 0x01, 0xc0, 0xc2, 0xea, 0x8f, 0x66, 0x3b, 0xe8, 0xd0, 0x67, 0x38, 0x19, 0x76, 0x90,
+	0x96, 0xac, 0x4b, 0xac, 0xb3, 0xe1, 0x2a, 0xaf, 0xd0, 0xe5, 0x9a, 0x2b, 0x3c, 0xd6, 0x08, 0x82,
+	0xae, 0xe5, 0x92, 0xf7, 0x63, 0xfc, 0xa8, 0xff, 0x03, 0x34, 0xe3, 0xf3, 0xbf, 0x71, 0x85, 0x7b,
+	0xe9, 0xef, 0x9f, 0x2a, 0x62, 0x8d, 0x58, 0xaa, 0x7b, 0x66, 0x2d, 0xeb, 0x92, 0x6a, 0x73, 0x8f,
+	0x15, 0x41, 0x77, 0xa0, 0x10, 0x62, 0x6b, 0x59, 0x97, 0x6d, 0xdf, 0x97, 0xac, 0x8b, 0xdd, 0xf0,
+	0x72, 0x8a, 0xeb, 0x18, 0x00, 0xed, 0x88, 0xed, 0xf1, 0x67, 0x2d, 0xeb, 0x92, 0x93, 0xb3, 0xd4,
+	0xac, 0xcb, 0x1c, 0xce, 0x2d, 0x08, 0x3a, 0x1f, 0x92, 0xb7, 0xb0, 0x96, 0x75, 0x99, 0xc3, 0x59,
+	0x43, 0xd6, 0xa5, 0x94, 0x0f, 0x9f, 0x9b, 0xb3, 0x24, 0x4f, 0x1a, 0x00, 0x0b, 0x39, 0xa0, 0x39,
+	0x79, 0x0b, 0x0d, 0x59, 0x97, 0xb5, 0x13, 0x16, 0x9a, 0xef, 0x99, 0x33, 0x57, 0x58, 0xc9, 0xba,
+	0xc4, 0x70, 0x5e, 0x06, 0xd6, 0x8b, 0xda, 0x75, 0x1c, 0x12, 0x7a, 0x87, 0xf6, 0x1d, 0x87, 0x27,
+	0xeb, 0x62, 0x2b, 0xeb, 0x62, 0x69, 0x85, 0xae, 0xe4, 0x53, 0xe5, 0x2e, 0xce, 0x00, 0x58, 0x5b,
+	0x09, 0x52, 0x6f, 0x8d, 0xb8, 0xfa, 0x75, 0xcf, 0x34, 0x65, 0x5d, 0xe6, 0x72, 0x76, 0x42, 0x57,
+	0xe8, 0x62, 0xe2, 0x39, 0x87, 0x76, 0x81, 0x95, 0xb4, 0x46, 0x24, 0x64, 0x5d, 0x52, 0xd9, 0x41,
+	0x9a, 0x04, 0x9d, 0xe6, 0x92, 0xf7, 0x35, 0x97, 0x6d, 0x01, 0xb0, 0x24, 0x7c, 0x4a, 0xdb, 0x41,
+	0x64, 0x5d, 0x64, 0x64, 0x5d, 0x10, 0x74, 0x03, 0x16, 0x58, 0xad, 0x6e, 0xc0, 0xb5, 0xb3, 0x2e,
+	0x35, 0x1b, 0xe6, 0x49, 0xcc, 0xba, 0x58, 0x15, 0x74, 0x31, 0xe7, 0xf4, 0xcd, 0x87, 0xbe, 0xcf,
+	0xec, 0x09, 0xd4, 0x63, 0x1d, 0x84, 0xfe, 0xd6, 0x3f, 0x3c, 0x4d, 0xd3, 0x66, 0xa7, 0x67, 0xa3,
+	0x8b, 0x94, 0xce, 0x04, 0x4b, 0xc5, 0x82, 0x2e, 0x84, 0xb3, 0xef, 0x7a, 0x68, 0x64, 0x5d, 0xda,
+	0xcc, 0xba, 0xa4, 0xe8, 0x8d, 0x26, 0x89, 0x73, 0x0a, 0x4f, 0x1a, 0x00, 0x2b, 0xe8, 0xde, 0x33,
+	0xaa, 0xb3, 0x2e, 0xcb, 0x7a, 0xf9, 0x1e, 0xad, 0x59, 0x97, 0x29, 0xc7, 0xb6, 0x12, 0xc2, 0x39,
+	0x74, 0xae, 0x88, 0xe1, 0xbc, 0xd3, 0x02, 0xb3, 0x9a, 0x75, 0x91, 0xd6, 0x0d, 0x58, 0x7b, 0x07,
+	0x64, 0x0d, 0xbb, 0x46, 0xe6, 0x2c, 0xdb, 0x02, 0x60, 0x49, 0x00, 0x49, 0xae, 0xbc, 0x2c, 0xcd,
+	0x1a, 0xb1, 0x96, 0x75, 0x61, 0x85, 0xae, 0x9f, 0xb3, 0xc7, 0x1a, 0x69, 0x47, 0xd0, 0xb5, 0x5c,
+	0xf2, 0x7e, 0x6e, 0xe3, 0x47, 0x00, 0xac, 0xe4, 0x80, 0x68, 0xda, 0x9c, 0x9e, 0xb3, 0x96, 0xac,
+	0x4b, 0xca, 0xcd, 0x3d, 0x96, 0x04, 0x9d, 0x6f, 0x31, 0xeb, 0x32, 0x67, 0x22, 0xb4, 0x9c, 0x75,
+	0xb1, 0x18, 0x5e, 0x4e, 0x71, 0x1d, 0x03, 0x60, 0x4d, 0x04, 0xa9, 0x0e, 0x2f, 0x3b, 0xbb, 0x4d,
+	0x9b, 0x11, 0x74, 0x75, 0x04, 0x9d, 0x9f, 0xe3, 0x11, 0x5a, 0xc8, 0xba, 0xa4, 0xe8, 0xaf, 0x22,
+	0x29, 0xeb, 0x52, 0xca, 0x87, 0xcf, 0xcd, 0x39, 0xf4, 0x7a, 0x2b, 0xe5, 0x49, 0x03, 0x60, 0x01,
+	0xb1, 0x75, 0xcf, 0x2c, 0x65, 0x5d, 0xa4, 0x71, 0x2e, 0x91, 0x75, 0x09, 0xe1, 0xec, 0x66, 0x72,
+	0xd6, 0xd0, 0x3b, 0x74, 0xe8, 0x38, 0x7c, 0x49, 0x6b, 0x44, 0x53, 0x7f, 0x15, 0x8d, 0x59, 0x97,
+	0x58, 0x95, 0xdf, 0x62, 0xc9, 0x7b, 0x2c, 0x30, 0x80, 0x05, 0x86, 0x35, 0xc2, 0x6e, 0x34, 0xd9,
+	0xbb, 0xd1, 0x72, 0xad, 0xd0, 0xf9, 0xd2, 0xd6, 0x88, 0x84, 0xac, 0x4b, 0x2c, 0x67, 0x8d, 0x82,
+	0x2e, 0x84, 0x9f, 0x95, 0xf0, 0x72, 0xaa, 0xeb, 0x18, 0x00, 0x6b, 0x50, 0x19, 0x5e, 0x76, 0x64,
+	0x5d, 0x10, 0x74, 0x79, 0x38, 0xfb, 0x16, 0xb3, 0x2e, 0x35, 0x3b, 0x20, 0x4b, 0xbc, 0x28, 0x2c,
+	0x86, 0x97, 0x93, 0x74, 0x40, 0x06, 0xc0, 0x98, 0xf0, 0x21, 0xbc, 0x5c, 0x7e, 0xa3, 0x8b, 0x94,
+	0xf0, 0x72, 0x08, 0x67, 0x67, 0x4c, 0xd0, 0x8d, 0x71, 0xf6, 0x64, 0x5d, 0xc8, 0xba, 0xa4, 0xc8,
+	0x08, 0x48, 0xe2, 0x9c, 0xda, 0x93, 0x06, 0xc0, 0x02, 0x72, 0xd6, 0x3d, 0xcb, 0x96, 0xfb, 0x70,
+	0x79, 0xf2, 0x3d, 0x29, 0xea, 0x9e, 0x69, 0xca, 0xba, 0x8c, 0xd5, 0xd9, 0x73, 0xc2, 0x38, 0x87,
+	0xce, 0x15, 0xb1, 0xb5, 0x05, 0xbd, 0x46, 0x6b, 0x24, 0x36, 0xeb, 0xa2, 0xd5, 0x0e, 0xca, 0xbd,
+	0x84, 0x69, 0xb5, 0xe4, 0xfd, 0xdc, 0x65, 0x5b, 0x00, 0xac, 0x5b, 0x60, 0xa2, 0xad, 0x91, 0x25,
+	0x59, 0x97, 0x56, 0x77, 0xa3, 0x95, 0x5a, 0xa1, 0xf3, 0x2d, 0x66, 0x5d, 0xe8, 0xaf, 0xd2, 0x66,
+	0xc9, 0xfb, 0xa9, 0x82, 0x0e, 0x80, 0x56, 0x2c, 0x30, 0x91, 0x59, 0x17, 0x27, 0xbb, 0x69, 0xb3,
+	0xb6, 0xf0, 0xf2, 0x20, 0x67, 0xc3, 0x82, 0x6e, 0x2c, 0xaa, 0xe2, 0x73, 0xed, 0x0e, 0x92, 0x9c,
+	0x75, 0xb1, 0xd2, 0x30, 0x4f, 0xaa, 0xa0, 0xab, 0x1d, 0x5e, 0x4e, 0x2d, 0xe8, 0x00, 0xd0, 0x0e,
+	0xe9, 0xe3, 0x4a, 0xe9, 0xac, 0xcb, 0xaa, 0xb1, 0xac, 0x4b, 0x4b, 0x82, 0x6e, 0xca, 0xf5, 0xe6,
+	0x37, 0x27, 0xae, 0xa5, 0xac, 0xcb, 0xae, 0xbf, 0xd5, 0x72, 0xd6, 0xa5, 0x36, 0xe7, 0x39, 0xe7,
+	0x34, 0xa7, 0x27, 0x0d, 0x80, 0xa5, 0x15, 0x20, 0xf1, 0x59, 0x17, 0xb7, 0xf5, 0x9e, 0xcb, 0x97,
+	0xfb, 0x68, 0x31, 0xeb, 0xb2, 0x8b, 0xf3, 0x32, 0x82, 0xb3, 0x86, 0xde, 0xa1, 0xbb, 0xce, 0xa9,
+	0x6f, 0x31, 0xeb, 0x12, 0x6b, 0x8d, 0x58, 0xcb, 0xba, 0x50, 0xf2, 0x1e, 0x0b, 0x0c, 0x60, 0x81,
+	0xb5, 0x94, 0x75, 0x91, 0xc4, 0xb9, 0x56, 0xdb, 0x25, 0xd7, 0xc0, 0x0a, 0xdd, 0x18, 0x3f, 0x4f,
+	0xd6, 0x05, 0x41, 0x87, 0xa0, 0xc3, 0x02, 0x03, 0xed, 0x89, 0x20, 0xab, 0xe3, 0x0a, 0x82, 0xae,
+	0x4d, 0x41, 0x37, 0xcb, 0x02, 0x23, 0xeb, 0x82, 0xa0, 0x2b, 0x29, 0x6e, 0x34, 0x0d, 0xbc, 0x00,
+	0x58, 0xcb, 0x00, 0x89, 0x1d, 0x57, 0x5c, 0xb9, 0xd5, 0x83, 0x50, 0x7e, 0x96, 0x04, 0x5d, 0x69,
+	0xce, 0x12, 0x04, 0x5d, 0x08, 0x67, 0x9f, 0xaa, 0x16, 0x41, 0x89, 0xac, 0xcb, 0x94, 0x7c, 0x4f,
+	0x12, 0x4f, 0xba, 0x91, 0xac, 0x4b, 0xaa, 0xde, 0x68, 0x12, 0x38, 0xa7, 0xf6, 0xa4, 0x01, 0xb0,
+	0x80, 0x12, 0x75, 0xcf, 0x92, 0xe5, 0x3e, 0x96, 0x79, 0xf3, 0x3d, 0x73, 0x38, 0x6b, 0xcf, 0xba,
+	0x1c, 0xfa, 0x5b, 0xeb, 0xcf, 0x12, 0xca, 0x39, 0xf4, 0x7a, 0x4b, 0xd1, 0x3b, 0xd4, 0x6b, 0xb2,
+	0x46, 0xe6, 0xac, 0x1e, 0x90, 0x75, 0xb1, 0xb9, 0x42, 0x17, 0xea, 0x49, 0xa7, 0x58, 0xb6, 0x05,
+	0xc0, 0x9a, 0x05, 0x86, 0x35, 0x62, 0x37, 0xeb, 0x32, 0xc6, 0xd9, 0x09, 0xdf, 0x8d, 0x56, 0xd2,
+	0xcd, 0xf1, 0x64, 0x5d, 0xc8, 0xba, 0x20, 0xe8, 0xfa, 0x7f, 0x1f, 0x00, 0xeb, 0x16, 0x98, 0x18,
+	0x6b, 0x64, 0x29, 0xcb, 0x1a, 0xb1, 0x26, 0xe8, 0x42, 0xf9, 0x69, 0x09, 0x2f, 0xa7, 0x8a, 0xaa,
+	0xf8, 0x16, 0xc3, 0xcb, 0x16, 0x1a, 0xe6, 0x21, 0xe8, 0xca, 0x08, 0x3a, 0x00, 0x2c, 0xad, 0xfe,
+	0xe4, 0x9a, 0x6c, 0xa2, 0xc7, 0x15, 0x57, 0x56, 0xdc, 0xa4, 0xe2, 0xac, 0x25, 0xeb, 0x72, 0x60,
+	0xfc, 0x6e, 0x48, 0xd0, 0x8d, 0xee, 0x02, 0x23, 0xeb, 0x42, 0xd6, 0x45, 0x02, 0xe7, 0xb1, 0x73,
+	0x5a, 0xcb, 0x93, 0x06, 0xc0, 0x8a, 0x00, 0x6a, 0x31, 0xeb, 0x22, 0x75, 0x5c, 0x29, 0x9d, 0x75,
+	0xc9, 0xc1, 0x59, 0x43, 0xef, 0xd0, 0xb1, 0xeb, 0xcd, 0x97, 0x78, 0x92, 0xb6, 0xd2, 0x5f, 0xc5,
+	0x7a, 0xd6, 0xc5, 0xe2, 0x6e, 0xb4, 0x18, 0xce, 0x00, 0xb4, 0x6c, 0x81, 0x69, 0xcf, 0xba, 0xc4,
+	0xce, 0x15, 0x96, 0xb2, 0x2e, 0x39, 0x39, 0x6b, 0xee, 0xa3, 0xe9, 0x09, 0x2f, 0x93, 0x75, 0x41,
+	0xd0, 0x61, 0x81, 0x01, 0x2c, 0xb0, 0x05, 0xd6, 0x88, 0x39, 0x41, 0xe7, 0x0a, 0x72, 0xd6, 0x50,
+	0x8a, 0xa6, 0xb7, 0x10, 0x22, 0x59, 0x17, 0xb2, 0x2e, 0x2d, 0x0b, 0x3a, 0x76, 0x81, 0x81, 0xd6,
+	0x56, 0x82, 0xc4, 0x64, 0x5d, 0x5c, 0x9d, 0xd5, 0x83, 0xd6, 0x04, 0x5d, 0x69, 0xce, 0x52, 0x6b,
+	0x0b, 0x76, 0xdf, 0xf3, 0xa1, 0xfe, 0x6c, 0xed, 0xac, 0xcb, 0x94, 0x7c, 0x4f, 0x2a, 0x4f, 0xba,
+	0xa5, 0xac, 0x4b, 0x28, 0xe7, 0xd8, 0x6c, 0x95, 0x26, 0x4f, 0x1a, 0x00, 0x4b, 0xc8, 0x59, 0xf7,
+	0x4c, 0x5b, 0xd6, 0x25, 0x45, 0x16, 0x54, 0x4b, 0xd6, 0xc5, 0x25, 0xcc, 0x82, 0xa6, 0x98, 0xbb,
+	0x25, 0xf5, 0x0e, 0xf5, 0x9a, 0xac, 0x91, 0x29, 0x8a, 0x90, 0xac, 0x0b, 0x25, 0xef, 0x53, 0x2c,
+	0xdb, 0x02, 0x60, 0xd1, 0x02, 0x5b, 0x60, 0x8d, 0x98, 0xcc, 0xba, 0x74, 0xdf, 0x5b, 0x4e, 0x74,
+	0x36, 0xa4, 0x70, 0x2e, 0xe5, 0xe6, 0xf4, 0x5a, 0x60, 0x84, 0x97, 0x09, 0x2f, 0xb7, 0x24, 0xe8,
+	0x86, 0xf8, 0x7d, 0xe6, 0xe6, 0x8f, 0xbb, 0x6f, 0xdf, 0xf7, 0x0e, 0xb3, 0x27, 0x50, 0x8d, 0xd7,
+	0x7f, 0xfc, 0xfc, 0xfa, 0xd9, 0x57, 0x86, 0x35, 0xe2, 0x16, 0x87, 0xb6, 0xbd, 0x4b, 0xb4, 0x46,
+	0xac, 0x08, 0x3a, 0x37, 0x81, 0x5f, 0x8b, 0x8d, 0xd1, 0x7d, 0xea, 0xc9, 0x46, 0x4b, 0xd6, 0x45,
+	0x73, 0xc3, 0xbc, 0x9a, 0x9e, 0xb4, 0x36, 0x41, 0x37, 0x97, 0x33, 0x76, 0x18, 0xb0, 0xb6, 0xfa,
+	0x13, 0x33, 0xd9, 0x58, 0xca, 0xba, 0xa4, 0xe4, 0x5c, 0x62, 0x37, 0x9a, 0xb6, 0x2c, 0x68, 0x89,
+	0xf0, 0x72, 0xaa, 0xb9, 0xa2, 0xb7, 0x17, 0x58, 0x0b, 0x59, 0x97, 0x90, 0x9a, 0x13, 0xad, 0x64,
+	0x5d, 0x6a, 0x73, 0x2e, 0xe5, 0x49, 0xc7, 0x5c, 0xc7, 0x00, 0x68, 0x16, 0x40, 0xa2, 0xb2, 0x2e,
+	0x2e, 0x5f, 0x5d, 0x97, 0x1a, 0x59, 0x97, 0xd8, 0xf9, 0x31, 0x17, 0x67, 0x37, 0x93, 0x73, 0xcc,
+	0x98, 0x2e, 0xa9, 0x77, 0x68, 0x48, 0xb6, 0x6a, 0xa7, 0x05, 0x56, 0xda, 0x0e, 0x22, 0xeb, 0x52,
+	0x2f, 0xeb, 0x62, 0x71, 0x85, 0x2e, 0xc5, 0x75, 0x0c, 0x80, 0x76, 0xc4, 0xae, 0x34, 0x27, 0xbd,
+	0xc7, 0x96, 0x79, 0xb2, 0x2e, 0xa9, 0xad, 0x11, 0x6b, 0x59, 0x97, 0x9c, 0x9c, 0xa5, 0xef, 0xd6,
+	0xde, 0x75, 0x6c, 0x5e, 0x9a, 0x1d, 0xa4, 0xc5, 0x1a, 0xb1, 0x94, 0x75, 0xb1, 0x2c, 0xe8, 0x62,
+	0x39, 0x03, 0xd0, 0xaa, 0x05, 0x96, 0xe5, 0x1e, 0x73, 0x6d, 0x65, 0x41, 0x6b, 0x09, 0x3a, 0x67,
+	0x24, 0x0b, 0x9a, 0xbb, 0xfc, 0x8e, 0x27, 0xeb, 0x42, 0xd6, 0xa5, 0x65, 0x41, 0x37, 0x76, 0x1d,
+	0x7f, 0xf6, 0x96, 0x3f, 0x76, 0x2f, 0xdf, 0xfb, 0x36, 0xb3, 0x28, 0x50, 0x89, 0xb3, 0xef, 0xbf,
+	0xb0, 0xbe, 0xb2, 0x93, 0x3c, 0x49, 0x93, 0x75, 0x91, 0xc1, 0x59, 0x83, 0xa0, 0x93, 0x20, 0x6e,
+	0x42, 0x38, 0xfb, 0x10, 0xbf, 0xcc, 0x62, 0xd6, 0xa5, 0x06, 0x67, 0xc9, 0x9e, 0x74, 0x08, 0xe7,
+	0x14, 0xd9, 0xaa, 0xdc, 0x35, 0x27, 0x72, 0x79, 0xd2, 0x00, 0x68, 0x44, 0xaa, 0x1e, 0x7f, 0xb3,
+	0xb3, 0x2e, 0xab, 0xad, 0xdf, 0x77, 0x32, 0xf2, 0x3d, 0x53, 0x38, 0x6b, 0xc9, 0xba, 0xb8, 0x9e,
+	0xed, 0xef, 0x73, 0xce, 0x69, 0x2a, 0xce, 0xdb, 0x82, 0x43, 0x72, 0xef, 0x50, 0xff, 0xf2, 0xde,
+	0x13, 0x02, 0x00, 0x60, 0x08, 0x2f, 0x5d, 0x74, 0x29, 0x5f, 0x02, 0x50, 0x89, 0x0f, 0x7f, 0xe9,
+	0xff, 0xf6, 0x5e, 0x3f, 0xd8, 0xfc, 0xef, 0x92, 0x7f, 0xfc, 0xa2, 0x73, 0xff, 0x7d, 0xe4, 0xc2,
+	0xab, 0x56, 0xac, 0x3a, 0xaf, 0xc5, 0xbf, 0xc4, 0x71, 0xbc, 0x7f, 0xe1, 0xf5, 0x27, 0xe7, 0xfe,
+	0xfb, 0x31, 0x97, 0xfc, 0x24, 0x78, 0xbe, 0x02, 0x00, 0x00, 0x00, 0x00, 0x20, 0x80, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x10, 0x40, 0x00, 0xb4, 0x8d, 0xb3, 0x3f, 0x7d, 0xd6, 0x5d, 0x8c, 0x0d, 0x06,
+	0x14, 0x5e, 0xb7, 0x00, 0x00, 0x04, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x08, 0x00, 0x00,
+	0x00, 0x00, 0x08, 0x20, 0x00, 0xc0, 0x0e, 0x60, 0x83, 0x01, 0x6d, 0xd7, 0x2b, 0x00, 0x00, 0x01,
+	0x04, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x02, 0x00, 0x00, 0x00, 0x40, 0xe3, 0x02, 0xe8, 0x73,
+	0xbf, 0xf6, 0xa5, 0x43, 0x15, 0x15, 0xb7, 0xab, 0xdf, 0x76, 0xab, 0xfb, 0x6e, 0xde, 0xdb, 0x7e,
+	0x1d, 0x7a, 0x2f, 0xa4, 0x7a, 0xe3, 0xd0, 0xdf, 0xea, 0x56, 0x76, 0xdc, 0xf5, 0xb7, 0x52, 0x74,
+	0x89, 0x95, 0xcc, 0x79, 0xe8, 0x6f, 0x4a, 0xe0, 0x1c, 0x5a, 0x2d, 0x34, 0xb4, 0x82, 0x67, 0x69,
+	0xce, 0xdb, 0xdc, 0xc7, 0xae, 0xb7, 0x2f, 0x9d, 0x7b, 0x7d, 0xfe, 0xce, 0xd7, 0x19, 0x35, 0x80,
+	0x68, 0xbc, 0xf9, 0xaf, 0x2f, 0x9d, 0xbb, 0x66, 0x7f, 0x6e, 0xf4, 0xda, 0xee, 0xb6, 0xb7, 0xc8,
+	0x7d, 0x8f, 0x85, 0x8c, 0x9b, 0xbb, 0x8e, 0x63, 0xf3, 0xb9, 0xbb, 0xc6, 0x95, 0x12, 0x9c, 0x87,
+	0x8e, 0x63, 0xea, 0xb8, 0x52, 0x9b, 0xf3, 0xd0, 0x71, 0x48, 0xe0, 0xbc, 0x5d, 0x45, 0x7a, 0x8c,
+	0xf3, 0xd0, 0x71, 0x84, 0x70, 0xf6, 0xdd, 0x09, 0x50, 0x6a, 0x53, 0xca, 0x39, 0xfd, 0x55, 0x34,
+	0x74, 0x03, 0x96, 0xd4, 0x5f, 0x25, 0xa6, 0x1b, 0xb0, 0x95, 0x86, 0x79, 0x63, 0xe7, 0x14, 0x00,
+	0x2d, 0xa8, 0x76, 0x8f, 0xb9, 0x34, 0x7d, 0x9b, 0x34, 0x77, 0x19, 0xaf, 0xd5, 0x47, 0x73, 0x0a,
+	0xe7, 0xd4, 0xf3, 0x58, 0x8e, 0xc6, 0xe8, 0xb9, 0x7b, 0xa3, 0xf9, 0x54, 0xfd, 0x55, 0x52, 0xf4,
+	0xcc, 0x92, 0xd6, 0x5f, 0x65, 0xac, 0xd7, 0x48, 0x69, 0xce, 0xb1, 0xbd, 0x6d, 0xa4, 0x71, 0x8e,
+	0xb9, 0xde, 0x72, 0x73, 0xde, 0xf5, 0x19, 0x00, 0x48, 0x46, 0x8e, 0x1e, 0x7f, 0xb9, 0xc7, 0x95,
+	0xa9, 0x63, 0x48, 0xcc, 0xb8, 0x92, 0x8a, 0xf3, 0xf6, 0xca, 0xc3, 0x9c, 0x71, 0x25, 0x86, 0xb3,
+	0xcb, 0xc0, 0x79, 0xec, 0xd8, 0x42, 0xbe, 0x7b, 0x6d, 0xbd, 0x43, 0x7d, 0xa8, 0xe2, 0x9d, 0xaa,
+	0x08, 0x25, 0x2a, 0xde, 0xd4, 0x2a, 0xbf, 0x76, 0x37, 0x60, 0xed, 0x1d, 0x90, 0x25, 0x74, 0x03,
+	0x9e, 0xca, 0xf9, 0x92, 0xe3, 0x9f, 0x74, 0xcf, 0x1d, 0x7f, 0x8d, 0x59, 0x16, 0x88, 0xb5, 0xbf,
+	0x56, 0xab, 0x85, 0xba, 0x2e, 0xe3, 0x21, 0xab, 0x07, 0x63, 0x63, 0xde, 0xd8, 0x9c, 0x25, 0x89,
+	0x73, 0xd4, 0xca, 0x8d, 0x10, 0xce, 0xb5, 0xe7, 0xee, 0xb9, 0xda, 0x64, 0xfb, 0x73, 0x3d, 0xd6,
+	0x08, 0x82, 0x4e, 0x8a, 0xa0, 0x93, 0x3a, 0xf0, 0x0e, 0xf9, 0xcd, 0x00, 0x48, 0xb4, 0xbd, 0xac,
+	0x5b, 0x23, 0x96, 0x04, 0xdd, 0x9c, 0x89, 0xde, 0x19, 0x13, 0x74, 0xb9, 0x44, 0xec, 0xe6, 0x75,
+	0xa7, 0x05, 0xd6, 0x62, 0xd6, 0x25, 0x46, 0xf1, 0xb6, 0x92, 0x75, 0xa9, 0xe9, 0x49, 0x4b, 0xf7,
+	0xe1, 0xbf, 0x7c, 0xe7, 0xa7, 0xdc, 0x37, 0xef, 0x78, 0x95, 0xd9, 0x16, 0x88, 0xc2, 0x5b, 0xff,
+	0xf6, 0xad, 0x2c, 0x4f, 0xd2, 0x56, 0xc6, 0x95, 0x14, 0xce, 0x86, 0xd6, 0xac, 0x4b, 0x09, 0xce,
+	0x25, 0xc5, 0x4d, 0x2a, 0xce, 0x9e, 0xac, 0x4b, 0xdb, 0x59, 0x97, 0x10, 0xce, 0x29, 0xb2, 0x55,
+	0xb9, 0x38, 0x97, 0xf2, 0xa4, 0x87, 0x7e, 0x1f, 0x00, 0x89, 0xab, 0x3f, 0x53, 0xb2, 0x2e, 0xdd,
+	0xfb, 0x68, 0xf2, 0xbd, 0xbb, 0x3c, 0x1f, 0x7c, 0xae, 0x91, 0xfb, 0xc8, 0xc5, 0x59, 0x52, 0xd6,
+	0x65, 0xb5, 0xfd, 0x19, 0x33, 0xb3, 0x2e, 0xa5, 0xf2, 0x3d, 0xdd, 0x1d, 0x5c, 0x59, 0xae, 0xb7,
+	0x84, 0x9c, 0x3d, 0x59, 0x17, 0xb2, 0x2e, 0x96, 0x56, 0xe8, 0x4a, 0x3d, 0x55, 0x02, 0x20, 0x0d,
+	0x55, 0xc6, 0x15, 0xa7, 0xcf, 0x1a, 0x69, 0x31, 0xeb, 0x12, 0x7a, 0x4e, 0x2d, 0xad, 0xd0, 0x85,
+	0x70, 0xf6, 0x2d, 0x66, 0x5d, 0x6a, 0x7b, 0xd2, 0xda, 0x7d, 0x78, 0x2d, 0x82, 0x2e, 0xe5, 0xb2,
+	0x6d, 0xf7, 0x38, 0x2e, 0xbd, 0xeb, 0xd3, 0xee, 0xd9, 0xdb, 0x5f, 0x61, 0xd6, 0x05, 0x62, 0xec,
+	0x2f, 0xc9, 0xd6, 0x88, 0xb4, 0xf0, 0x72, 0x8a, 0xcd, 0x3d, 0xa5, 0x05, 0x9d, 0x8b, 0xc8, 0xba,
+	0xa4, 0x7a, 0x10, 0xd6, 0x26, 0xe8, 0xc6, 0x3e, 0xd7, 0x93, 0x75, 0x41, 0xd0, 0xb5, 0x12, 0x5e,
+	0x4e, 0x3d, 0xf0, 0x02, 0x20, 0x69, 0xf5, 0x47, 0x7a, 0xd6, 0xa5, 0xd4, 0xb8, 0x62, 0x29, 0xeb,
+	0xe2, 0x0c, 0x0b, 0xba, 0x95, 0x00, 0x41, 0xe7, 0x43, 0xfd, 0x32, 0x4b, 0x59, 0x97, 0xb9, 0xb9,
+	0x8f, 0x16, 0xb3, 0x2e, 0x53, 0x32, 0x5b, 0x53, 0x38, 0x97, 0xf2, 0xa4, 0xe7, 0xf8, 0xf0, 0xa1,
+	0xe7, 0xf4, 0xb2, 0xbb, 0x3f, 0xe3, 0x9e, 0xb9, 0xed, 0xdb, 0xcc, 0xbe, 0xa0, 0x2a, 0xde, 0xfe,
+	0xf7, 0x97, 0xd7, 0x57, 0xe6, 0xec, 0xac, 0xcb, 0xd8, 0xb8, 0x79, 0xe8, 0x1e, 0x5b, 0x95, 0xc9,
+	0xf7, 0xe4, 0xcc, 0xba, 0x4c, 0xe6, 0x5c, 0x21, 0xeb, 0xe2, 0x3a, 0x9c, 0x97, 0x19, 0x39, 0x97,
+	0xca, 0x56, 0xe5, 0x3a, 0xcf, 0x73, 0xe7, 0x0a, 0xdf, 0x62, 0xd6, 0x25, 0xa7, 0x35, 0xc2, 0x6e,
+	0xb4, 0xb6, 0x76, 0xa3, 0x01, 0x20, 0x29, 0xfb, 0x13, 0xb3, 0x62, 0x22, 0xdd, 0x1a, 0x91, 0xd6,
+	0x99, 0x40, 0x53, 0xd6, 0x25, 0xe4, 0x73, 0x35, 0xed, 0x46, 0x4b, 0x35, 0x57, 0x78, 0xb2, 0x2e,
+	0x08, 0xba, 0x96, 0xc2, 0xcb, 0xa9, 0x97, 0x6d, 0x2f, 0xbf, 0xe7, 0x73, 0xee, 0xe9, 0x5b, 0xbf,
+	0xc5, 0x2c, 0x0c, 0xaa, 0xe0, 0x7c, 0xdf, 0xaf, 0x36, 0xac, 0x11, 0x6b, 0x82, 0xae, 0xa4, 0xb8,
+	0x69, 0x51, 0xd0, 0x05, 0x59, 0x60, 0x64, 0x5d, 0xda, 0x11, 0x74, 0x1a, 0x2a, 0xa4, 0x6a, 0xac,
+	0x39, 0x01, 0x40, 0x6d, 0xe4, 0x2e, 0x64, 0xbb, 0xff, 0x9e, 0xd3, 0x1f, 0x5e, 0x0e, 0x1d, 0x37,
+	0x25, 0x64, 0x5d, 0x5c, 0xe1, 0x9d, 0xcb, 0x96, 0x04, 0x5d, 0x08, 0x67, 0x1f, 0x9a, 0xb7, 0xb0,
+	0x96, 0x75, 0x29, 0xc5, 0xd9, 0x42, 0xd6, 0x25, 0x36, 0x5b, 0x95, 0xbb, 0xe6, 0x44, 0x6e, 0x4f,
+	0x7a, 0x8c, 0xf3, 0x15, 0xf7, 0x7e, 0xde, 0x3d, 0x75, 0xcb, 0x4b, 0xcc, 0xc2, 0xa0, 0x28, 0xd6,
+	0x3b, 0xbf, 0xd6, 0xab, 0x3f, 0x31, 0x59, 0x97, 0xb1, 0xdc, 0xc7, 0xe0, 0xb8, 0xb2, 0x90, 0x59,
+	0xd7, 0x85, 0xac, 0x4b, 0xdd, 0xda, 0x49, 0xa1, 0x59, 0x50, 0x29, 0xbd, 0x43, 0xfd, 0xb6, 0x8f,
+	0x4c, 0xd6, 0x85, 0xac, 0x4b, 0x8b, 0xbb, 0xd1, 0x52, 0x3c, 0xd9, 0x20, 0x82, 0x40, 0x49, 0xac,
+	0x83, 0xcf, 0x9b, 0x05, 0x48, 0xac, 0x91, 0x3c, 0x9c, 0x2d, 0x65, 0x5d, 0x42, 0xce, 0xa9, 0xb6,
+	0x15, 0xba, 0x14, 0x9c, 0x3d, 0xd6, 0x48, 0x3b, 0x82, 0x2e, 0x25, 0x67, 0x2d, 0x82, 0xae, 0xe4,
+	0x36, 0x60, 0x00, 0x4a, 0x61, 0x55, 0xcb, 0x1a, 0x59, 0xea, 0x0f, 0x2f, 0x4f, 0xe5, 0x6c, 0x41,
+	0xd0, 0x85, 0xce, 0x15, 0x96, 0x04, 0x5d, 0x08, 0x67, 0x4f, 0xd6, 0x05, 0x41, 0xd7, 0x62, 0x78,
+	0x39, 0x47, 0x85, 0x54, 0x56, 0x81, 0x40, 0x29, 0xeb, 0xab, 0xe4, 0x93, 0xf4, 0x81, 0xcf, 0x70,
+	0xb2, 0xc3, 0xcb, 0x59, 0x38, 0x57, 0x10, 0x37, 0xae, 0x42, 0x67, 0x02, 0x8b, 0x82, 0x6e, 0xec,
+	0x38, 0x7c, 0x0b, 0x59, 0x97, 0x39, 0x35, 0x27, 0xc8, 0xba, 0x4c, 0xf3, 0xa4, 0xa7, 0x70, 0x96,
+	0xec, 0xc3, 0xc7, 0x5e, 0x6f, 0x00, 0x94, 0x40, 0xe9, 0x1e, 0x7f, 0x96, 0xb2, 0x2e, 0xb1, 0x9c,
+	0x35, 0x66, 0x5d, 0x76, 0x71, 0x4e, 0x91, 0xad, 0xd2, 0xda, 0x3b, 0xd4, 0xb7, 0x60, 0x8d, 0xe4,
+	0x52, 0xf9, 0x54, 0x48, 0x95, 0xbf, 0x42, 0x57, 0xba, 0x2a, 0xec, 0x95, 0xf7, 0x7d, 0xc1, 0x3d,
+	0x79, 0xf3, 0x8b, 0xcc, 0xd0, 0x20, 0x5b, 0xf6, 0x67, 0x9d, 0x40, 0x2e, 0xf2, 0x24, 0xed, 0xda,
+	0xb5, 0x46, 0xac, 0x65, 0x5d, 0x42, 0xa3, 0x03, 0x5a, 0x56, 0xe8, 0x52, 0xcd, 0x15, 0x9e, 0xac,
+	0x0b, 0x59, 0x97, 0x96, 0x05, 0x5d, 0x2a, 0x0b, 0x6c, 0xfb, 0xf7, 0xbf, 0x72, 0xff, 0x17, 0xdd,
+	0x13, 0x5f, 0x7b, 0x81, 0xd9, 0x1a, 0x24, 0xb7, 0xbe, 0xce, 0x77, 0x47, 0xc0, 0x1a, 0x29, 0x51,
+	0x96, 0xa5, 0xa4, 0xa0, 0x73, 0x42, 0x4a, 0xd1, 0x58, 0x12, 0x74, 0x21, 0xd7, 0x5b, 0xef, 0x2e,
+	0x30, 0xb2, 0x2e, 0xf6, 0x04, 0x9d, 0x86, 0x6e, 0xc0, 0xda, 0x8b, 0x88, 0x51, 0x1d, 0x1a, 0xe4,
+	0x46, 0x8d, 0xba, 0x67, 0x7d, 0x5d, 0xdf, 0x25, 0x87, 0x97, 0x53, 0xec, 0xe2, 0xb5, 0x26, 0xe8,
+	0x72, 0x72, 0x96, 0xde, 0x47, 0x73, 0x17, 0x67, 0x3f, 0xc7, 0x9f, 0xd5, 0x9e, 0x75, 0x29, 0xc5,
+	0xd9, 0x72, 0xd6, 0x45, 0x4a, 0xcd, 0x89, 0x52, 0x9e, 0xf4, 0xd4, 0x3c, 0xd9, 0x55, 0x0f, 0x7c,
+	0xc9, 0x3d, 0x7e, 0xd3, 0xf3, 0xcc, 0xd8, 0x20, 0x99, 0xf5, 0xb5, 0xbd, 0xfa, 0x93, 0x32, 0xeb,
+	0xb2, 0xf3, 0xde, 0x5d, 0x94, 0x1b, 0x57, 0x4a, 0x66, 0x5d, 0x52, 0xe4, 0x22, 0x53, 0x73, 0x76,
+	0x19, 0xb3, 0x2e, 0xb9, 0x39, 0x77, 0xb3, 0xa0, 0xb3, 0xaf, 0xb7, 0xc2, 0x9c, 0xbd, 0x64, 0x6b,
+	0xa4, 0xe6, 0x16, 0x45, 0xb2, 0x2e, 0x6d, 0x94, 0xbc, 0xcf, 0x59, 0x21, 0xf5, 0xc8, 0x89, 0x4b,
+	0xdc, 0x63, 0xc7, 0x9e, 0x63, 0xf6, 0x06, 0x51, 0x58, 0xb7, 0xbb, 0x58, 0xad, 0x16, 0xe5, 0x9f,
+	0xa4, 0x9d, 0xdd, 0xac, 0x8b, 0xb8, 0xd5, 0xaa, 0x82, 0xd1, 0x01, 0x0b, 0x2b, 0x74, 0xc9, 0x2c,
+	0xb0, 0xbe, 0x0b, 0xdc, 0x7a, 0x78, 0xb9, 0xb4, 0x1d, 0x64, 0x35, 0xeb, 0xd2, 0x4a, 0x11, 0xb1,
+	0x18, 0xce, 0x88, 0x20, 0x10, 0x2b, 0x7e, 0xb0, 0x46, 0xea, 0x73, 0xce, 0x3d, 0x57, 0x38, 0x63,
+	0x82, 0x6e, 0xa1, 0x44, 0xd0, 0xf9, 0x29, 0x7e, 0x99, 0xa5, 0xac, 0x4b, 0xcd, 0x0a, 0xa9, 0x96,
+	0xb2, 0x2e, 0x16, 0x8a, 0x88, 0xe5, 0x16, 0x74, 0x00, 0xa4, 0xca, 0xfc, 0x68, 0x6e, 0xda, 0x2c,
+	0xb5, 0x4a, 0x7f, 0x0b, 0x82, 0x4e, 0xd3, 0xe6, 0x9e, 0x54, 0xd7, 0x5b, 0x08, 0x67, 0x9f, 0xa2,
+	0x3f, 0x97, 0xe4, 0xac, 0x4b, 0x4c, 0xcd, 0x09, 0xb2, 0x2e, 0x61, 0x9e, 0xf4, 0x14, 0xce, 0xa1,
+	0xd9, 0xaa, 0x1a, 0x3e, 0x7c, 0xae, 0xeb, 0xed, 0xab, 0x27, 0x2f, 0x75, 0x8f, 0xdc, 0xf0, 0x2c,
+	0xb3, 0x39, 0x98, 0xb1, 0xfa, 0x33, 0x9e, 0xad, 0x98, 0x73, 0x6d, 0x8f, 0xde, 0x63, 0x4b, 0x9d,
+	0x75, 0x5d, 0xb4, 0x64, 0x5d, 0x56, 0xdb, 0x9f, 0x51, 0x91, 0x73, 0xd1, 0x3c, 0x59, 0x86, 0xf3,
+	0x1c, 0x7b, 0xbd, 0x25, 0xb3, 0xc0, 0x2c, 0x5a, 0x23, 0x64, 0x5d, 0x74, 0xaf, 0xd0, 0xcd, 0xf5,
+	0xa4, 0x73, 0xac, 0xd0, 0x21, 0x82, 0xc0, 0x14, 0x9c, 0xaf, 0xf6, 0x5c, 0x6e, 0xa7, 0xcc, 0x81,
+	0xdf, 0x77, 0x58, 0x23, 0xd6, 0xb2, 0x2e, 0xac, 0xd0, 0xf5, 0xf3, 0xf3, 0x39, 0xac, 0x11, 0x0b,
+	0xfd, 0x55, 0xc8, 0xba, 0xb4, 0x51, 0xf2, 0x3e, 0xd6, 0x02, 0x9b, 0x72, 0xbd, 0x21, 0x82, 0x40,
+	0xa8, 0xf8, 0xc1, 0x1a, 0xa1, 0x69, 0xb3, 0xd4, 0x56, 0x53, 0x1a, 0x04, 0x5d, 0xe8, 0xf5, 0xe6,
+	0x6b, 0xe7, 0x7b, 0xc8, 0xba, 0xd8, 0xc9, 0xba, 0xb4, 0x5e, 0x15, 0x36, 0xe4, 0xd8, 0xae, 0x39,
+	0x75, 0x99, 0x3b, 0x73, 0xf4, 0x19, 0x66, 0x79, 0xd0, 0x8b, 0x37, 0x7e, 0xf2, 0xe2, 0x81, 0x1d,
+	0x5f, 0x55, 0x9e, 0xa4, 0x97, 0x64, 0x5d, 0x10, 0x74, 0xfa, 0x05, 0xdd, 0xd8, 0x62, 0xcc, 0xde,
+	0x2e, 0xb0, 0x54, 0x1e, 0xa1, 0xb6, 0xac, 0xcb, 0x1c, 0x4f, 0x9a, 0xac, 0x8b, 0x0c, 0xce, 0xa5,
+	0x3d, 0xe9, 0x14, 0xbd, 0xd1, 0xba, 0x9f, 0x01, 0x40, 0x1f, 0x4a, 0x67, 0x5d, 0xf6, 0x3f, 0x77,
+	0x95, 0x27, 0xeb, 0x22, 0x25, 0xdf, 0x33, 0x67, 0xdc, 0xcc, 0xc1, 0xd9, 0x6d, 0x7d, 0xee, 0xa2,
+	0x60, 0xd6, 0x25, 0x27, 0x67, 0xc9, 0x7d, 0x34, 0xc7, 0x38, 0x7b, 0xa9, 0xd6, 0x48, 0xed, 0x2d,
+	0x8a, 0x64, 0x5d, 0xa8, 0x90, 0x9a, 0x8b, 0xf3, 0xb5, 0x0f, 0xfd, 0xb9, 0x7b, 0xf8, 0xfa, 0xbf,
+	0x60, 0xb6, 0x07, 0xbd, 0xd6, 0x17, 0xd6, 0x88, 0x9e, 0xce, 0x04, 0xec, 0x46, 0x9b, 0x36, 0x77,
+	0x4b, 0x5b, 0xa1, 0xf3, 0x58, 0x23, 0x64, 0x5d, 0xac, 0x0a, 0x3a, 0xc9, 0x21, 0xc3, 0xeb, 0x4e,
+	0x5f, 0xee, 0x4e, 0x5f, 0xf7, 0x34, 0xb3, 0x3e, 0xd8, 0xb7, 0xbe, 0xce, 0x3d, 0x9b, 0x4e, 0x9e,
+	0x6c, 0xb0, 0x46, 0x10, 0x74, 0x08, 0xba, 0xf9, 0x9c, 0xbd, 0xb5, 0xf0, 0x72, 0xe9, 0xdc, 0x07,
+	0x59, 0x17, 0xfb, 0x0d, 0xf3, 0x72, 0x71, 0x46, 0x04, 0x81, 0x35, 0xd6, 0xdb, 0xdd, 0x77, 0xed,
+	0xf8, 0x22, 0xeb, 0x62, 0x4b, 0xd0, 0xb9, 0x06, 0x3a, 0x13, 0xd4, 0x9e, 0xbb, 0x43, 0x39, 0xfb,
+	0xd8, 0x7c, 0x0f, 0x59, 0x17, 0xb2, 0x2e, 0x16, 0x6a, 0x4e, 0x94, 0xca, 0x93, 0x75, 0xdf, 0x3b,
+	0x7a, 0xe6, 0x4a, 0x77, 0xea, 0x9a, 0x27, 0x51, 0x01, 0x4d, 0x8b, 0x9f, 0xba, 0x59, 0x97, 0xf5,
+	0xb6, 0xf7, 0xbd, 0xf7, 0x16, 0xfa, 0xeb, 0xba, 0x4c, 0xbd, 0x77, 0xe7, 0x64, 0x5d, 0x52, 0x8e,
+	0x2b, 0x35, 0x39, 0x67, 0xcb, 0x93, 0x15, 0xe2, 0x9c, 0x22, 0x7b, 0x1c, 0x6d, 0x81, 0x59, 0xb5,
+	0x46, 0xc8, 0xba, 0xe8, 0x51, 0xf9, 0xda, 0x97, 0x6d, 0x11, 0x41, 0xed, 0xda, 0x5e, 0xeb, 0xcb,
+	0xab, 0xaa, 0x35, 0xb2, 0xc4, 0x1a, 0xa1, 0xf2, 0xb2, 0x6b, 0x76, 0x85, 0xce, 0x5b, 0x0b, 0x2f,
+	0x5b, 0xb0, 0x46, 0x2c, 0x65, 0x5d, 0x34, 0x8a, 0x9b, 0x1a, 0x82, 0xee, 0x86, 0x47, 0xbe, 0xe2,
+	0x4e, 0x7e, 0xf5, 0x09, 0x54, 0x41, 0x23, 0x38, 0xfb, 0xfe, 0x0b, 0x7b, 0x55, 0x9e, 0xab, 0x4f,
+	0x36, 0x4e, 0x87, 0x35, 0xa2, 0xb9, 0x69, 0xf3, 0xfe, 0xcf, 0x84, 0xf7, 0xd1, 0xb4, 0x28, 0xe8,
+	0xc6, 0x38, 0xfb, 0x50, 0x7f, 0xd6, 0x5a, 0xd6, 0x45, 0x73, 0xf3, 0x38, 0x04, 0x9d, 0x4d, 0x41,
+	0x77, 0xe3, 0xa3, 0x57, 0xb9, 0x07, 0xaf, 0x7e, 0x1c, 0x75, 0xd0, 0xc8, 0xca, 0x0f, 0xe1, 0xe5,
+	0xb6, 0xb2, 0x2e, 0xce, 0x98, 0xa0, 0x5b, 0x18, 0x10, 0x74, 0x7e, 0xf3, 0x8b, 0x2d, 0x65, 0x5d,
+	0x42, 0x3d, 0x69, 0xb2, 0x2e, 0xe9, 0xb2, 0x2e, 0xa9, 0x38, 0x4b, 0xf5, 0xa4, 0x53, 0x65, 0x20,
+	0x8e, 0x3d, 0x76, 0x64, 0xef, 0x7f, 0x9f, 0x38, 0xf2, 0x18, 0x4a, 0xc1, 0xe0, 0xaa, 0xcf, 0xf9,
+	0xf3, 0xec, 0x64, 0x64, 0x5d, 0x1c, 0x59, 0x97, 0x56, 0xb2, 0x2e, 0xb9, 0x38, 0x4b, 0xee, 0xa3,
+	0x19, 0xc2, 0xd9, 0xb7, 0x98, 0x75, 0xd1, 0x9a, 0x68, 0xc7, 0x87, 0xd7, 0xe5, 0x49, 0xc7, 0xac,
+	0xd0, 0xad, 0x85, 0x10, 0x22, 0xc8, 0xde, 0xaa, 0x4f, 0xf5, 0x7b, 0xcc, 0xe5, 0x5d, 0x3d, 0x90,
+	0xbc, 0x0a, 0x9e, 0xba, 0xee, 0x99, 0xb6, 0x15, 0xba, 0xdc, 0x9c, 0x43, 0x2a, 0x2f, 0x4b, 0x6b,
+	0x35, 0xe5, 0xb1, 0x46, 0x10, 0x74, 0x08, 0x3a, 0x99, 0x82, 0xee, 0xa6, 0xc7, 0xaf, 0x76, 0x0f,
+	0x5c, 0xf5, 0x28, 0xea, 0xc1, 0xc0, 0xca, 0xcf, 0xfa, 0x94, 0xb7, 0x92, 0x75, 0x91, 0x6a, 0x8d,
+	0x20, 0xe8, 0x10, 0x74, 0x87, 0x2c, 0x30, 0xc2, 0xcb, 0x08, 0x3a, 0x04, 0x9d, 0xdc, 0x5d, 0x23,
+	0x88, 0x20, 0xdd, 0x78, 0xfd, 0xc7, 0xcf, 0x3b, 0xe7, 0xda, 0xad, 0xeb, 0x82, 0xa0, 0x93, 0xc1,
+	0x39, 0xf4, 0x9c, 0x6a, 0x09, 0x2f, 0xc7, 0x66, 0x8f, 0x37, 0xef, 0xf9, 0x54, 0x35, 0x27, 0xb4,
+	0x65, 0x5d, 0x52, 0xe5, 0x3e, 0x5a, 0xce, 0xba, 0x4c, 0xe1, 0x2c, 0xd9, 0x87, 0x2f, 0x91, 0x27,
+	0x8b, 0xe1, 0x7c, 0xf3, 0x93, 0xd7, 0xec, 0xbd, 0xde, 0x7b, 0xc5, 0xc3, 0x28, 0x0a, 0x45, 0xc2,
+	0xe7, 0xfc, 0xf9, 0x5b, 0xca, 0xcc, 0xba, 0x2c, 0xd3, 0xd7, 0x3d, 0xd3, 0x92, 0x75, 0x99, 0xc3,
+	0x79, 0x28, 0x0b, 0xba, 0x93, 0xb3, 0xa0, 0xac, 0xcb, 0xd8, 0x71, 0x68, 0xcb, 0xf7, 0xa4, 0xaa,
+	0x2d, 0x98, 0xc4, 0x02, 0xc3, 0x1a, 0x69, 0x33, 0xeb, 0x52, 0x73, 0x85, 0xae, 0xc5, 0x27, 0xe9,
+	0x5b, 0x9f, 0xbe, 0xce, 0xdd, 0x73, 0xf9, 0x69, 0xd4, 0x85, 0x70, 0xbc, 0xf6, 0x2f, 0xcf, 0xed,
+	0x0b, 0x1f, 0x71, 0xd6, 0x88, 0xc3, 0x1a, 0x29, 0xc1, 0xd9, 0x09, 0xcb, 0xba, 0x68, 0xb4, 0x1f,
+	0x4b, 0x74, 0x26, 0xf0, 0x29, 0xad, 0x11, 0x2b, 0xfd, 0x55, 0x10, 0x74, 0x84, 0x97, 0xa5, 0x0a,
+	0x3a, 0x44, 0x90, 0xfc, 0x95, 0x9f, 0xa1, 0x2d, 0xee, 0x58, 0x23, 0x32, 0xb2, 0x2e, 0xa5, 0x39,
+	0x6b, 0x68, 0xbb, 0xa4, 0x2d, 0xbc, 0x9c, 0x2a, 0xaa, 0xe2, 0x6b, 0xe5, 0x7b, 0x68, 0x1e, 0x87,
+	0xa0, 0x43, 0xd0, 0xcd, 0xe3, 0x7c, 0xcb, 0x53, 0xd7, 0xee, 0xbd, 0x22, 0x84, 0xe4, 0xe0, 0xd5,
+	0x7f, 0xfe, 0xa6, 0xda, 0xac, 0x4b, 0x8a, 0x27, 0x69, 0x6d, 0x82, 0x2e, 0x37, 0xe7, 0xa5, 0x40,
+	0x41, 0x97, 0x8a, 0xb3, 0x26, 0x41, 0x37, 0xf6, 0xb9, 0x9e, 0xac, 0x0b, 0x59, 0x17, 0x29, 0x59,
+	0x17, 0xc9, 0x9e, 0x74, 0x89, 0x0c, 0xc4, 0x54, 0xce, 0xb7, 0x3d, 0x73, 0xd4, 0xdd, 0x7d, 0xd9,
+	0x29, 0xd4, 0x87, 0x88, 0x55, 0x9f, 0x85, 0xfc, 0xac, 0xcb, 0x32, 0x4f, 0xd6, 0xa5, 0x54, 0xee,
+	0x43, 0x7a, 0xd6, 0x65, 0x25, 0x38, 0xeb, 0x92, 0x83, 0xb3, 0xe4, 0x3e, 0x9a, 0xa1, 0x9c, 0x3d,
+	0xd6, 0x48, 0x7b, 0x59, 0x97, 0x96, 0x56, 0xe8, 0x6a, 0xed, 0x1a, 0x29, 0xb5, 0x42, 0x77, 0xfb,
+	0xb3, 0x37, 0xec, 0xbd, 0x22, 0x84, 0xea, 0x64, 0x7d, 0xce, 0xdf, 0x4f, 0x0b, 0xf9, 0x4f, 0xd2,
+	0x2e, 0xaf, 0x1d, 0x24, 0xdd, 0x1a, 0x99, 0xb3, 0xd2, 0x6c, 0x69, 0x85, 0x2e, 0x27, 0xe7, 0x29,
+	0x95, 0x97, 0xa5, 0xed, 0xd6, 0xf6, 0x58, 0x23, 0x08, 0x3a, 0xc2, 0xcb, 0xfa, 0x05, 0xdd, 0x5a,
+	0x08, 0xad, 0x5f, 0xef, 0xfc, 0xf2, 0x83, 0x28, 0x93, 0xcc, 0x78, 0xe5, 0x9f, 0x9e, 0xbd, 0xf0,
+	0xdd, 0x3b, 0x13, 0x59, 0x97, 0x56, 0xac, 0x91, 0x29, 0x9f, 0x6b, 0x2d, 0xeb, 0x22, 0x91, 0xb3,
+	0x84, 0x56, 0x53, 0x3e, 0xf4, 0x03, 0xc8, 0xba, 0x20, 0xe8, 0xac, 0x86, 0x97, 0x25, 0x15, 0x11,
+	0x8b, 0xbd, 0xde, 0x8e, 0x3f, 0x77, 0xcc, 0x1d, 0xbf, 0xe4, 0x04, 0x2a, 0x25, 0xa3, 0xf8, 0x51,
+	0x99, 0x75, 0x59, 0xb6, 0x13, 0x5e, 0x26, 0xeb, 0x32, 0xef, 0x9c, 0x5a, 0x13, 0x74, 0x21, 0x9c,
+	0x7d, 0xa8, 0x5f, 0x66, 0x29, 0xeb, 0x92, 0x2a, 0xf7, 0xd1, 0x72, 0xd6, 0x65, 0x0a, 0xe7, 0x92,
+	0x3e, 0xfc, 0x54, 0xce, 0x25, 0xf2, 0x64, 0xa5, 0x7d, 0xf8, 0x3b, 0x9f, 0xbf, 0xe9, 0xbc, 0x18,
+	0x42, 0x08, 0x25, 0x0d, 0x39, 0x77, 0xfb, 0x63, 0x59, 0xc9, 0xba, 0xa4, 0xa8, 0x7b, 0xa6, 0x2d,
+	0xeb, 0x92, 0x22, 0x0b, 0xba, 0xff, 0xfb, 0x0a, 0xb2, 0x2e, 0xa9, 0xb2, 0xa0, 0x12, 0xf2, 0x3d,
+	0x29, 0x6b, 0x0b, 0xfa, 0x27, 0x7e, 0xf4, 0x08, 0xa3, 0x1b, 0x00, 0x06, 0x71, 0xf6, 0xc2, 0xeb,
+	0xc5, 0x17, 0x5d, 0xca, 0x97, 0x31, 0xf7, 0x3b, 0xfc, 0xe9, 0x85, 0x15, 0x9f, 0x5f, 0xde, 0x7e,
+	0xf7, 0xc3, 0x0b, 0xaf, 0x1f, 0xb8, 0x45, 0xe7, 0xf7, 0x57, 0x9d, 0xdf, 0xa8, 0x86, 0x8b, 0x14,
+	0x7d, 0xc9, 0x8b, 0xce, 0xeb, 0xea, 0xd0, 0xd7, 0x7c, 0x18, 0x1f, 0xc8, 0x38, 0xf4, 0xf7, 0xb9,
+	0x45, 0x54, 0xc3, 0xf3, 0x15, 0x00, 0xd0, 0xc6, 0x24, 0x8e, 0x10, 0x9a, 0x21, 0x7c, 0x00, 0x00,
+	0x08, 0x20, 0x00, 0x80, 0x9d, 0x49, 0x1d, 0x31, 0x84, 0xe8, 0x01, 0x00, 0x01, 0x04, 0x00, 0x68,
+	0x76, 0xb2, 0x47, 0x08, 0x21, 0x7c, 0x00, 0x40, 0x00, 0x01, 0x00, 0x9a, 0x9e, 0xfc, 0x5b, 0x12,
+	0x43, 0x88, 0x1e, 0x00, 0x00, 0x02, 0x08, 0x00, 0xd0, 0x84, 0x18, 0x42, 0xf4, 0x00, 0x00, 0x10,
+	0x40, 0x00, 0x80, 0x26, 0xc4, 0x10, 0xa2, 0x07, 0x00, 0x80, 0x00, 0x02, 0x00, 0x24, 0x13, 0x11,
+	0x12, 0x45, 0x11, 0x62, 0x07, 0x00, 0x80, 0x00, 0x02, 0x00, 0x98, 0x16, 0x45, 0x88, 0x1d, 0x00,
+	0x40, 0xb4, 0x00, 0x3a, 0xf2, 0x3b, 0xd7, 0xee, 0xfd, 0x63, 0x53, 0x19, 0x71, 0x57, 0xd5, 0xc4,
+	0xbe, 0x2a, 0x8b, 0xdd, 0x2a, 0x99, 0x43, 0x95, 0x1d, 0xbb, 0xd5, 0x40, 0xbb, 0x7f, 0xb3, 0x5b,
+	0xae, 0x3a, 0xa4, 0x22, 0x67, 0xf7, 0x38, 0xb6, 0x3f, 0x77, 0xd7, 0xdf, 0x1a, 0x7a, 0x6f, 0xe8,
+	0x38, 0xb4, 0x71, 0xee, 0x3b, 0x0e, 0x29, 0x9c, 0x77, 0xbd, 0x17, 0x52, 0x2d, 0x34, 0x35, 0xe7,
+	0xb1, 0xbf, 0x95, 0xf3, 0x7a, 0xcb, 0xc5, 0x79, 0xe8, 0x6f, 0xce, 0xa9, 0x7a, 0x3b, 0x85, 0xf3,
+	0xc3, 0x89, 0x39, 0xef, 0xaa, 0x18, 0xfb, 0xdf, 0x95, 0x39, 0xe7, 0xbc, 0xde, 0xc6, 0xaa, 0xe4,
+	0xa6, 0xe4, 0xbc, 0xe1, 0xa7, 0x9d, 0xf3, 0xd0, 0x9c, 0x25, 0x81, 0x73, 0xcc, 0xbd, 0x2e, 0x89,
+	0x73, 0x8a, 0xeb, 0x2d, 0x17, 0xe7, 0x5d, 0x9f, 0xbb, 0xeb, 0x7a, 0xf3, 0x7d, 0xbd, 0x3b, 0x24,
+	0x77, 0x19, 0x6f, 0xb9, 0x1b, 0xf0, 0x54, 0xce, 0x73, 0xce, 0xa9, 0xb8, 0x1e, 0x46, 0x02, 0x1a,
+	0xe6, 0x69, 0xea, 0x61, 0x14, 0x52, 0xe6, 0x3f, 0xb4, 0xf7, 0x9b, 0x14, 0xce, 0x63, 0xd7, 0x5b,
+	0xca, 0x7e, 0x77, 0x25, 0xc6, 0x15, 0x6d, 0x3d, 0xfe, 0xa4, 0xf4, 0x6d, 0x2a, 0xd9, 0xc0, 0x38,
+	0x25, 0x67, 0x0d, 0x7d, 0x34, 0xa7, 0x8c, 0x2b, 0x31, 0xd7, 0x5b, 0x4e, 0xce, 0x73, 0x7a, 0xa3,
+	0xf9, 0x5d, 0x0a, 0xb2, 0x4f, 0x75, 0x75, 0x7f, 0x96, 0xb2, 0x87, 0x91, 0xa4, 0x5e, 0x23, 0x7d,
+	0xbd, 0x5f, 0x76, 0x71, 0x9e, 0xa2, 0xc6, 0x4b, 0x73, 0x1e, 0x3b, 0xb6, 0x90, 0xe3, 0xa8, 0xc9,
+	0x39, 0x67, 0x0f, 0xa3, 0xed, 0xcf, 0x9d, 0xc3, 0x59, 0x72, 0x0f, 0xa3, 0xd8, 0x1e, 0x7f, 0xf3,
+	0x39, 0x6f, 0xff, 0xbe, 0x13, 0xd1, 0xc3, 0x28, 0x3f, 0xe7, 0xb2, 0x3d, 0x8c, 0x7a, 0x8f, 0x6d,
+	0x59, 0xaf, 0xc7, 0x5f, 0x35, 0xce, 0x85, 0x7b, 0xfc, 0xad, 0x3f, 0x65, 0x51, 0x80, 0x73, 0xad,
+	0x3e, 0x9a, 0x31, 0x73, 0xf7, 0x94, 0xeb, 0x4d, 0x0a, 0x67, 0x5f, 0xea, 0x09, 0x44, 0x63, 0x37,
+	0xe0, 0xd8, 0x27, 0x10, 0x6d, 0x4f, 0xd2, 0xda, 0x56, 0xe8, 0x4a, 0x3e, 0x49, 0x87, 0x70, 0x8e,
+	0xe9, 0xce, 0xcc, 0x93, 0x74, 0xf8, 0x93, 0x74, 0x89, 0x95, 0x66, 0x55, 0x4f, 0xd2, 0xae, 0x2e,
+	0xe7, 0x52, 0xab, 0x55, 0x73, 0xce, 0x73, 0xca, 0x7b, 0xcc, 0x09, 0x5d, 0xa1, 0xcb, 0xc9, 0x39,
+	0xe4, 0xbb, 0xaf, 0x31, 0xae, 0xa4, 0xe2, 0xbc, 0xd3, 0x02, 0xab, 0x61, 0x8d, 0x4c, 0x99, 0x6c,
+	0x72, 0x0f, 0xbc, 0x96, 0x04, 0x5d, 0xa8, 0x35, 0x62, 0x49, 0xd0, 0x61, 0x8d, 0xc4, 0x0f, 0xbc,
+	0x08, 0x3a, 0x04, 0x5d, 0x8b, 0xd6, 0x48, 0x0b, 0x82, 0x6e, 0x85, 0xa0, 0x73, 0x7e, 0x6e, 0x06,
+	0x42, 0x7b, 0xd6, 0x25, 0x37, 0x67, 0x89, 0x82, 0x8e, 0xac, 0xcb, 0xbc, 0x73, 0x6a, 0x4d, 0xd0,
+	0xe5, 0xe4, 0xbc, 0xf9, 0x78, 0xb2, 0x2e, 0x3a, 0x04, 0x5d, 0xca, 0xc9, 0x46, 0x8b, 0xa0, 0x0b,
+	0xe1, 0xdc, 0x7b, 0x1c, 0x08, 0x3a, 0x73, 0x82, 0xce, 0x77, 0x7d, 0xb5, 0x16, 0xb2, 0x2e, 0xb1,
+	0xb9, 0x0f, 0xb2, 0x2e, 0xb6, 0xb2, 0x2e, 0x29, 0x3c, 0xe9, 0xd2, 0x9c, 0x25, 0xf8, 0xf0, 0xbb,
+	0xbf, 0xfb, 0x45, 0xf1, 0xdc, 0x47, 0x93, 0x59, 0x97, 0x0b, 0xa1, 0x94, 0xdc, 0xb9, 0x8f, 0xd6,
+	0xb3, 0x2e, 0x4b, 0xe5, 0x59, 0x97, 0x92, 0xf7, 0x58, 0x2e, 0xce, 0x29, 0xb2, 0xc7, 0xdd, 0xf7,
+	0x26, 0x5b, 0x60, 0x1a, 0xac, 0x91, 0x54, 0xcb, 0xb6, 0x64, 0x5d, 0xb0, 0x46, 0xa4, 0xaf, 0x1e,
+	0x60, 0x8d, 0x90, 0x75, 0x69, 0x65, 0x37, 0x5a, 0xb5, 0xd5, 0x03, 0x03, 0x59, 0x97, 0xd2, 0x6e,
+	0x4e, 0x8d, 0x15, 0xba, 0x39, 0x9c, 0xbd, 0x55, 0x6b, 0x24, 0x76, 0x8b, 0x22, 0x59, 0x17, 0xb2,
+	0x2e, 0x08, 0xba, 0x39, 0x9c, 0x97, 0x64, 0x5d, 0x10, 0x74, 0x64, 0x5d, 0x08, 0x2f, 0xab, 0x10,
+	0x74, 0x3e, 0x76, 0x77, 0x90, 0xc6, 0xac, 0x8b, 0xa4, 0xdc, 0x07, 0x59, 0x17, 0x9e, 0xa4, 0x4b,
+	0x0b, 0xba, 0xbc, 0x03, 0xaf, 0x23, 0xeb, 0x52, 0x42, 0xdc, 0xb8, 0xb2, 0x4f, 0xd2, 0x64, 0x5d,
+	0x10, 0x74, 0xd2, 0x05, 0xdd, 0x9c, 0xeb, 0xcd, 0xa7, 0xf2, 0x08, 0xb5, 0x65, 0x5d, 0xe6, 0x54,
+	0x85, 0x25, 0xeb, 0x42, 0xd6, 0x45, 0x42, 0xee, 0x23, 0x17, 0xe7, 0x16, 0xeb, 0xba, 0xb4, 0x9e,
+	0x75, 0x09, 0xad, 0x7b, 0x66, 0x29, 0xeb, 0x12, 0x34, 0x67, 0x19, 0xcb, 0xba, 0x84, 0xd6, 0x7a,
+	0x2b, 0x71, 0xbd, 0xe5, 0xae, 0x2d, 0x38, 0x85, 0xb3, 0xc7, 0x1a, 0x91, 0xbd, 0x1b, 0x8d, 0xac,
+	0x8b, 0x1e, 0x6b, 0xc4, 0x4a, 0x55, 0x58, 0x56, 0xe8, 0x1a, 0xcd, 0xba, 0x18, 0x59, 0xa1, 0x23,
+	0xeb, 0xd2, 0xc6, 0x0a, 0x5d, 0x36, 0x0b, 0x4c, 0x7b, 0x78, 0xb9, 0xee, 0x36, 0x60, 0xb2, 0x2e,
+	0x2d, 0x0f, 0xbc, 0x1a, 0x04, 0x9d, 0x76, 0x6b, 0xa4, 0x49, 0x41, 0xe7, 0x10, 0x74, 0x64, 0x5d,
+	0x10, 0x74, 0xc9, 0x2d, 0x30, 0x6b, 0xe1, 0x65, 0x06, 0x5e, 0xb2, 0x2e, 0x3c, 0x49, 0xd7, 0xc8,
+	0xba, 0x38, 0x04, 0x9d, 0xd2, 0x71, 0x25, 0xe5, 0x64, 0xa3, 0x25, 0xeb, 0x92, 0xc2, 0xd9, 0xd0,
+	0x26, 0xe8, 0x24, 0x71, 0x96, 0x52, 0x5b, 0xd0, 0x93, 0x75, 0x21, 0xeb, 0xd2, 0x72, 0xd6, 0x25,
+	0xf4, 0x9c, 0x4a, 0xac, 0x65, 0x93, 0xdb, 0x87, 0x27, 0xeb, 0x22, 0x2c, 0xeb, 0xe2, 0xe4, 0xf6,
+	0xf8, 0xd3, 0x96, 0x75, 0xd9, 0xc5, 0xd9, 0x5d, 0xf8, 0xd9, 0x42, 0x68, 0xd6, 0x65, 0x56, 0xa6,
+	0xa9, 0xd0, 0x3d, 0xa6, 0xad, 0x77, 0xe8, 0x2c, 0x0b, 0x4c, 0xf2, 0x93, 0xb4, 0xf6, 0xaa, 0xb0,
+	0x64, 0x5d, 0x58, 0xa1, 0x23, 0xeb, 0xc2, 0x0a, 0xdd, 0xa1, 0x63, 0x5b, 0x0e, 0x3f, 0x49, 0xb7,
+	0x64, 0xb9, 0x92, 0x75, 0x89, 0xdb, 0xad, 0xdd, 0xd2, 0x0a, 0x5d, 0x08, 0x67, 0x6f, 0x2d, 0xeb,
+	0x62, 0x65, 0xd9, 0x96, 0xac, 0x4b, 0xb9, 0x81, 0x17, 0x41, 0x17, 0xc3, 0xd9, 0x21, 0xe8, 0x4a,
+	0xdc, 0x63, 0x4e, 0x76, 0xd3, 0x66, 0x2b, 0xd6, 0x88, 0x33, 0x2c, 0xe8, 0x52, 0x64, 0x41, 0xb5,
+	0x09, 0xba, 0x31, 0x7e, 0x9e, 0x22, 0x62, 0x64, 0x5d, 0x10, 0x74, 0xed, 0x85, 0x97, 0x35, 0x04,
+	0x2b, 0x25, 0x67, 0x5d, 0xb4, 0x8c, 0x2b, 0x64, 0x5d, 0xc8, 0xba, 0xb4, 0x20, 0xe8, 0xe6, 0x5e,
+	0x6f, 0x3e, 0xd4, 0x2f, 0xb3, 0x94, 0x75, 0x19, 0xe3, 0x37, 0x85, 0x33, 0x59, 0x17, 0xfd, 0x59,
+	0x97, 0x14, 0x9e, 0xb4, 0xb6, 0xac, 0x4b, 0x7c, 0xee, 0x63, 0xb9, 0xb7, 0xfa, 0xa3, 0xa5, 0xae,
+	0x8b, 0xba, 0xac, 0xcb, 0x6a, 0xeb, 0x38, 0x5c, 0x3e, 0xce, 0x21, 0xfc, 0x2c, 0x66, 0x5d, 0x86,
+	0xf8, 0x2d, 0x8d, 0x66, 0x5d, 0x52, 0x9c, 0xe7, 0x52, 0xf7, 0xd8, 0x1c, 0xce, 0x73, 0x7b, 0xfc,
+	0xf9, 0x16, 0xb3, 0x2e, 0x39, 0x76, 0xca, 0x60, 0x8d, 0xb0, 0x42, 0xd7, 0xce, 0x0a, 0x9d, 0xab,
+	0xf2, 0x24, 0xcd, 0x0a, 0x1d, 0xd6, 0x48, 0x6a, 0x6b, 0xc4, 0x35, 0x92, 0x75, 0x49, 0xb5, 0x62,
+	0x22, 0x65, 0x85, 0x2e, 0xab, 0x05, 0xa6, 0x39, 0xbc, 0x8c, 0x35, 0x42, 0xd6, 0x05, 0x6b, 0xc4,
+	0xa6, 0x35, 0x62, 0x2d, 0xeb, 0x12, 0x34, 0xae, 0x38, 0xac, 0x11, 0x04, 0x5d, 0x39, 0x71, 0xd3,
+	0x9a, 0xa0, 0xf3, 0x84, 0x97, 0xc9, 0xba, 0x58, 0x16, 0x74, 0x64, 0x5d, 0x10, 0x74, 0xea, 0x04,
+	0x9d, 0x93, 0xf7, 0x24, 0x6d, 0x29, 0xeb, 0x12, 0xca, 0xcf, 0x92, 0xa0, 0x93, 0xc2, 0x59, 0x5a,
+	0x6d, 0x41, 0x9f, 0xca, 0x87, 0xd7, 0x96, 0x75, 0x91, 0xc4, 0x99, 0xac, 0x4b, 0x39, 0xce, 0xa2,
+	0xea, 0xba, 0xa8, 0xca, 0xba, 0xc8, 0xcd, 0x7d, 0x4c, 0xc9, 0xba, 0x68, 0x18, 0x57, 0x0e, 0xfc,
+	0x6c, 0x99, 0x37, 0xf7, 0x91, 0xb2, 0xee, 0x99, 0x96, 0xac, 0xcb, 0xa1, 0xbf, 0xb5, 0xfe, 0x2c,
+	0x25, 0x59, 0x97, 0x9c, 0x3d, 0xfe, 0x6a, 0x70, 0x2e, 0x95, 0x3d, 0x1e, 0xfa, 0xdc, 0x60, 0x0b,
+	0x4c, 0x83, 0x35, 0x62, 0xa5, 0x03, 0x32, 0x59, 0x17, 0xac, 0x11, 0x76, 0x8d, 0xc8, 0xe1, 0x8c,
+	0x35, 0x62, 0xd7, 0x1a, 0x71, 0x8d, 0x64, 0x5d, 0x42, 0xce, 0xa9, 0xb6, 0x15, 0xba, 0x14, 0x9c,
+	0x7d, 0xab, 0xe1, 0x65, 0xac, 0x11, 0xac, 0x11, 0x04, 0x1d, 0x82, 0x4e, 0xa4, 0xa0, 0x5b, 0x62,
+	0x8d, 0x48, 0x28, 0x64, 0x6b, 0x29, 0xeb, 0x12, 0x1a, 0x1d, 0xb0, 0x24, 0xe8, 0x42, 0xce, 0xa9,
+	0x27, 0xbc, 0x4c, 0xd6, 0x05, 0x41, 0xd7, 0x56, 0xd6, 0x65, 0x7a, 0xee, 0xc3, 0xa9, 0x17, 0x74,
+	0x29, 0xb3, 0x2e, 0xd9, 0xc7, 0x15, 0x27, 0xeb, 0x49, 0xda, 0x62, 0xd6, 0x65, 0xff, 0x67, 0x0d,
+	0x09, 0xba, 0x39, 0xe7, 0xd9, 0x7a, 0x63, 0x74, 0x4f, 0xd6, 0x85, 0xac, 0x8b, 0xe4, 0x5a, 0x36,
+	0x92, 0x6b, 0x4e, 0x68, 0xcd, 0xba, 0xcc, 0xf7, 0xe1, 0x17, 0xea, 0xea, 0xba, 0x90, 0x75, 0x49,
+	0xd3, 0xe3, 0xcf, 0x52, 0xd6, 0x65, 0xf3, 0xf9, 0x4b, 0x25, 0xe3, 0x4a, 0xee, 0x3e, 0x9a, 0xa9,
+	0xea, 0x45, 0xd5, 0xca, 0xf7, 0xc4, 0xf4, 0xf8, 0xf3, 0x3c, 0x49, 0x63, 0x8d, 0x58, 0x5e, 0xa1,
+	0x23, 0xeb, 0x62, 0x23, 0xeb, 0x52, 0xa2, 0x2a, 0x6c, 0x8b, 0xdb, 0x80, 0xb1, 0x46, 0xda, 0xc8,
+	0xba, 0xa4, 0xe4, 0x2c, 0xb5, 0x8f, 0xe6, 0x9c, 0xf9, 0xd1, 0x53, 0x44, 0x0c, 0x41, 0xd7, 0xb2,
+	0xa0, 0x53, 0x65, 0x8d, 0x54, 0xdb, 0x06, 0xbc, 0x54, 0x2f, 0xe8, 0xc8, 0xba, 0xb4, 0x67, 0x8d,
+	0x1c, 0xfa, 0x5b, 0x13, 0x37, 0x7d, 0x58, 0x13, 0x74, 0x35, 0x39, 0x4b, 0xdd, 0xdc, 0xb3, 0xdf,
+	0x0d, 0x9e, 0xf0, 0x32, 0x59, 0x17, 0x6b, 0x82, 0x4e, 0xf2, 0x4e, 0x19, 0xe9, 0x03, 0xef, 0x41,
+	0x41, 0xe7, 0x9a, 0xd8, 0x35, 0x52, 0x3d, 0xeb, 0xe2, 0x64, 0x3e, 0x49, 0x5b, 0x13, 0x74, 0x21,
+	0xfc, 0xb4, 0xad, 0xd0, 0xa5, 0xd8, 0xb9, 0x6c, 0x4d, 0xd0, 0x85, 0x70, 0xfe, 0x7f, 0xfa, 0xee,
+	0x08, 0x9d, 0xa9, 0x46, 0xa6, 0x8f, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42,
+	0x60, 0x82,
+};
+
+#endif
@@ -0,0 +1,339 @@
+#include "test-util.h"
+#include "test-png-fixtures.h"
+#include "png-image.h"
+#include <string.h>
+
+static uint8_t over_white(uint32_t c, uint32_t a){
+	return (uint8_t)((c * a + 255 * (255 - a) + 127) / 255);
+}
+
+// BGR of pixel (x, y) of a fixture, from the formulas of test-png-fixtures.h.
+static void expected_pixel(const PngFixture &f, uint32_t x, uint32_t y, uint8_t *bgr){
+	uint32_t d = f.bitDepth, c, s[4];
+	for(c=0;c<4;c++){
+		s[c] = png_fixture_sample(x, y, c, d);
+	}
+	// to 8 bits
+	uint32_t e[4];
+	for(c=0;c<4;c++){
+		e[c] = d == 16 ? s[c] >> 8 : d == 8 ? s[c] : s[c] * (255 / ((1u << d) - 1));
+	}
+	switch(f.colorType){
+		case PNG_GRAY:
+			if( f.transparency && s[0] == png_fixture_sample(1, 0, 0, d) ){
+				e[0] = 255;
+			}
+			bgr[0] = bgr[1] = bgr[2] = (uint8_t)e[0];
+			break;
+		case PNG_RGB:
+			if( f.transparency && s[0] == png_fixture_sample(1, 0, 0, d) &&
+					s[1] == png_fixture_sample(1, 0, 1, d) && s[2] == png_fixture_sample(1, 0, 2, d) ){
+				e[0] = e[1] = e[2] = 255;
+			}
+			bgr[0] = (uint8_t)e[2];
+			bgr[1] = (uint8_t)e[1];
+			bgr[2] = (uint8_t)e[0];
+			break;
+		case PNG_PALETTE: {
+			uint32_t i = s[0], a = f.transparency && i < 10 ? (61 * i) & 255 : 255;
+			bgr[0] = over_white((29 * i + 11) & 255, a);
+			bgr[1] = over_white((13 * i + 5) & 255, a);
+			bgr[2] = over_white((7 * i + 3) & 255, a);
+			break;
+		}
+		case PNG_GRAY_ALPHA:
+			bgr[0] = bgr[1] = bgr[2] = over_white(e[0], e[1]);
+			break;
+		case PNG_RGBA:
+			bgr[0] = over_white(e[2], e[3]);
+			bgr[1] = over_white(e[1], e[3]);
+			bgr[2] = over_white(e[0], e[3]);
+			break;
+	}
+}
+
+static void test_fixtures(){
+	size_t i;
+	for(i=0;i<sizeof(pngFixtures)/sizeof(pngFixtures[0]);i++){
+		const PngFixture &f = pngFixtures[i];
+		PngImage image;
+		std::string err;
+		uint32_t x, y;
+		int mismatches = 0;
+		CHECK(parse_png(f.data, f.length, &image, &err));
+		CHECK_EQ(image.width, f.width);
+		CHECK_EQ(image.height, f.height);
+		CHECK_EQ(image.colorType, f.colorType);
+		CHECK_EQ(image.bitDepth, f.bitDepth);
+		PngRowReader reader(image);
+		std::vector<uint8_t> row(f.width * 3);
+		for(y=0;y<f.height;y++){
+			CHECK(reader.readRow(&row[0], &err));
+			for(x=0;x<f.width;x++){
+				uint8_t expected[3];
+				expected_pixel(f, x, y, expected);
+				if( memcmp(expected, &row[3 * x], 3) != 0 ){
+					mismatches += 1;
+				}
+			}
+		}
+		if( mismatches ){
+			printf("%s: %d pixels differ\n", f.name, mismatches);
+		}
+		CHECK_EQ(mismatches, 0);
+		CHECK(reader.finish(&err));
+	}
+}
+
+static const PngFixture &fixture(const char *name){
+	size_t i;
+	for(i=0;strcmp(pngFixtures[i].name, name) != 0;i++){
+	}
+	return pngFixtures[i];
+}
+
+static bool decode_all(const std::vector<uint8_t> &png, std::string *err){
+	PngImage image;
+	if( !parse_png(&png[0], png.size(), &image, err) ){
+		return false;
+	}
+	PngRowReader reader(image);
+	std::vector<uint8_t> row(image.width * 3);
+	uint32_t y;
+	for(y=0;y<image.height;y++){
+		if( !reader.readRow(&row[0], err) ){
+			return false;
+		}
+	}
+	return reader.finish(err);
+}
+
+// Streams longer than the 32 KB window; the zlib checksum covers every byte.
+static void test_long_streams(){
+	std::vector<uint8_t> code(png_bench_code, png_bench_code + sizeof(png_bench_code));
+	std::vector<uint8_t> logo(png_bench_logo, png_bench_logo + sizeof(png_bench_logo));
+	std::string err;
+	CHECK(decode_all(code, &err));
+	CHECK(decode_all(logo, &err));
+}
+
+static size_t find_chunk(const std::vector<uint8_t> &png, const char *type){
+	size_t pos = 8;
+	while( memcmp(&png[pos + 4], type, 4) != 0 ){
+		pos += 12 + ((png[pos] << 24) | (png[pos + 1] << 16) | (png[pos + 2] << 8) | png[pos + 3]);
+	}
+	return pos;
+}
+
+static void test_errors(){
+	const PngFixture &f = fixture("gray8");
+	std::vector<uint8_t> good(f.data, f.data + f.length), png;
+	PngImage image;
+	std::string err;
+	CHECK(decode_all(good, &err));
+	png = good;
+	png[1] = 'X';
+	CHECK(!parse_png(&png[0], png.size(), &image, &err));
+	CHECK_STR(err, "not a PNG file");
+	CHECK(!parse_png(png_interlaced, sizeof(png_interlaced), &image, &err));
+	CHECK_STR(err, "interlaced PNG is not supported");
+	CHECK(!parse_png(&good[0], 30, &image, &err));
+	CHECK_STR(err, "truncated PNG");
+	png = good;
+	// bit depth 3
+	png[24] = 3;
+	CHECK(!parse_png(&png[0], png.size(), &image, &err));
+	CHECK_STR(err, "unsupported PNG format");
+
+	// gray8 is stored: zlib header, block header, LEN, NLEN, then row 0
+	size_t idat = find_chunk(good, "IDAT");
+	png = good;
+	png[idat + 8 + 7] = 5;
+	CHECK(!decode_all(png, &err));
+	CHECK_STR(err, "invalid PNG filter");
+	png = good;
+	png[idat + 8 + 9] ^= 1;
+	CHECK(!decode_all(png, &err));
+	CHECK_STR(err, "zlib checksum mismatch");
+	png = good;
+	png[idat + 8] = 0x79;
+	CHECK(!decode_all(png, &err));
+	CHECK_STR(err, "invalid zlib header");
+
+	// image data cut short
+	const PngFixture &rgb = fixture("rgb8");
+	png.assign(rgb.data, rgb.data + rgb.length);
+	idat = find_chunk(png, "IDAT");
+	uint32_t length = (png[idat + 2] << 8) | png[idat + 3];
+	png[idat + 2] = (uint8_t)((length / 2) >> 8);
+	png[idat + 3] = (uint8_t)(length / 2);
+	CHECK(!decode_all(png, &err));
+	CHECK_STR(err, "truncated deflate data");
+}
+
+// Records the bands drawn.
+class BandTarget : public ImageTarget {
+public:
+	struct Band {
+		long destX, destY, destWidth, destHeight;
+		uint32_t srcWidth, srcRows;
+		int32_t biHeight;
+		uint32_t bitCount;
+		std::vector<uint8_t> pixels;
+	};
+
+	bool drawBand(long destX, long destY, long destWidth, long destHeight,
+			uint32_t srcWidth, uint32_t srcRows, const uint8_t *pixels, const uint8_t *info){
+		Band band;
+		band.destX = destX;
+		band.destY = destY;
+		band.destWidth = destWidth;
+		band.destHeight = destHeight;
+		band.srcWidth = srcWidth;
+		band.srcRows = srcRows;
+		band.biHeight = (int32_t)(info[8] | (info[9] << 8) | (info[10] << 16) | ((uint32_t)info[11] << 24));
+		band.bitCount = info[14];
+		uint32_t stride = ((srcWidth * band.bitCount + 31) / 32) * 4;
+		band.pixels.assign(pixels, pixels + stride * srcRows);
+		bands.push_back(band);
+		return true;
+	}
+
+	std::vector<Band> bands;
+};
+
+static void test_draw_color(){
+	const PngFixture &f = fixture("rgb8");
+	PngImage image;
+	BandTarget target;
+	std::string err;
+	uint32_t x, y, stride = ((f.width * 24 + 31) / 32) * 4;
+	int mismatches = 0;
+	CHECK(parse_png(f.data, f.length, &image, &err));
+	CHECK(draw_png_banded(image, &target, 5, 10, 34, 22, 4, NULL, &err));
+	CHECK_EQ(target.bands.size(), (size_t)3);
+	CHECK_EQ(target.bands[0].destY, 10);
+	CHECK_EQ(target.bands[0].destHeight, 8);
+	CHECK_EQ(target.bands[0].destWidth, 34);
+	CHECK_EQ(target.bands[0].biHeight, -4);
+	CHECK_EQ(target.bands[0].bitCount, 24u);
+	CHECK_EQ(target.bands[2].srcRows, 3u);
+	CHECK_EQ(target.bands[2].destY, 26);
+	for(y=0;y<f.height;y++){
+		const BandTarget::Band &band = target.bands[y / 4];
+		for(x=0;x<f.width;x++){
+			uint8_t expected[3];
+			expected_pixel(f, x, y, expected);
+			if( memcmp(expected, &band.pixels[(y % 4) * stride + 3 * x], 3) != 0 ){
+				mismatches += 1;
+			}
+		}
+	}
+	CHECK_EQ(mismatches, 0);
+}
+
+// Scaled 2x and thresholded at device resolution.
+static void test_draw_mono(){
+	const PngFixture &f = fixture("palette4");
+	PngImage image;
+	BandTarget target;
+	MonoOptions mono;
+	std::string err;
+	uint32_t x, y, width = 2 * f.width, stride = ((width + 31) / 32) * 4;
+	int mismatches = 0;
+	mono.dither = MONO_DITHER_NONE;
+	CHECK(parse_png(f.data, f.length, &image, &err));
+	CHECK(draw_png_banded(image, &target, 0, 0, width, 2 * f.height, 5, &mono, &err));
+	CHECK_EQ(target.bands.size(), (size_t)3);
+	CHECK_EQ(target.bands[0].bitCount, 1u);
+	CHECK_EQ(target.bands[0].destHeight, 5);
+	CHECK_EQ(target.bands[0].srcWidth, width);
+	CHECK_EQ(target.bands[2].destY, 10);
+	CHECK_EQ(target.bands[2].srcRows, 4u);
+	for(y=0;y<2*f.height;y++){
+		const BandTarget::Band &band = target.bands[y / 5];
+		for(x=0;x<width;x++){
+			uint8_t expected[3], gray;
+			expected_pixel(f, x / 2, y / 2, expected);
+			mono_luma(expected, 3, 1, &gray);
+			int bit = (band.pixels[(y % 5) * stride + x / 8] >> (7 - x % 8)) & 1;
+			if( bit != (gray > 128 ? 1 : 0) ){
+				mismatches += 1;
+			}
+		}
+	}
+	CHECK_EQ(mismatches, 0);
+
+	// shrunk: every device pixel is drawn once
+	target.bands.clear();
+	mono.dither = MONO_DITHER_FLOYD_STEINBERG;
+	CHECK(draw_png_banded(image, &target, 0, 0, 5, 3, 0, &mono, &err));
+	CHECK_EQ(target.bands.size(), (size_t)1);
+	CHECK_EQ(target.bands[0].srcRows, 3u);
+}
+
+// Encoded pages decode to the same values: noise (literals), runs and
+// repeated rows (matches), more than one deflate block, and 1 bit rows.
+static void test_encode(){
+	static const uint32_t widths[] = { 1, 13, 700, 2500 };
+	size_t w, kind;
+	for(w=0;w<4;w++){
+		for(kind=0;kind<3;kind++){
+			uint32_t width = widths[w], height = 61, x, y;
+			std::vector<uint8_t> gray((size_t)width * height), png;
+			for(y=0;y<height;y++){
+				for(x=0;x<width;x++){
+					uint32_t i = y * width + x;
+					gray[i] = kind == 0 ? (uint8_t)((i * 2654435761u) >> 24) :
+						kind == 1 ? (x / 17 % 2 ? 0 : 255) : (uint8_t)(x * 7 + y / 9);
+				}
+			}
+			encode_png_gray(&gray[0], width, width, height, 8, &png);
+			PngImage image;
+			std::string err;
+			CHECK(parse_png(&png[0], png.size(), &image, &err));
+			CHECK_EQ(image.colorType, PNG_GRAY);
+			PngRowReader reader(image);
+			std::vector<uint8_t> row(width * 3);
+			bool same = true;
+			for(y=0;y<height;y++){
+				same = same && reader.readRow(&row[0], &err);
+				for(x=0;x<width;x++){
+					same = same && row[3 * x] == gray[y * width + x] && row[3 * x + 2] == gray[y * width + x];
+				}
+			}
+			CHECK(same);
+			CHECK(reader.finish(&err));
+			if( kind == 1 ){
+				CHECK(png.size() < 200 + (size_t)width * height / 50);
+			}
+		}
+	}
+	uint8_t bits[2][2] = { { 0xa5, 0x80 }, { 0xff, 0x00 } };
+	std::vector<uint8_t> png;
+	encode_png_gray(&bits[0][0], 2, 9, 2, 1, &png);
+	PngImage image;
+	std::string err;
+	CHECK(parse_png(&png[0], png.size(), &image, &err));
+	CHECK_EQ(image.bitDepth, 1u);
+	PngRowReader reader(image);
+	uint8_t row[27];
+	CHECK(reader.readRow(row, &err));
+	CHECK_EQ(row[0], 255);
+	CHECK_EQ(row[3], 0);
+	CHECK_EQ(row[24], 255);
+	CHECK(reader.readRow(row, &err));
+	CHECK_EQ(row[21], 255);
+	CHECK_EQ(row[24], 0);
+	CHECK(reader.finish(&err));
+}
+
+int main(){
+	test_fixtures();
+	test_errors();
+	test_long_streams();
+	test_draw_color();
+	test_draw_mono();
+	test_encode();
+	return test_summary("test-png-image");
+}
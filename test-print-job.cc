@@ -0,0 +1,198 @@
+#include "test-util.h"
+#include "test-fixtures.h"
+#include "print-job.h"
+#include "recording-device.h"
+#include <thread>
+
+// Recording device that cancels its job after a number of text runs.
+class CancelingDevice : public RecordingDevice {
+public:
+	CancelingDevice(PrintJob **job, long cancelAfter)
+		: RecordingDevice(600, 600), job_(job), cancelAfter_(cancelAfter) {}
+
+	bool textRun(long x, long y, const uint16_t *text, uint32_t length, const int *advances){
+		if( count(CALL_TEXT_RUN) + 1 == cancelAfter_ ){
+			(*job_)->cancel();
+		}
+		return RecordingDevice::textRun(x, y, text, length, advances);
+	}
+
+private:
+	PrintJob **job_;
+	long cancelAfter_;
+};
+
+class TestSource : public DeviceSource {
+public:
+	TestSource(RecordingDevice *device, long *opened, long *closed, std::string *log,
+			long *failed = 0)
+		: device_(device), opened_(opened), closed_(closed), failed_(failed), log_(log) {}
+
+	Device *open(std::string *err){
+		*opened_ += 1;
+		if( !device_ ){
+			*err = "no such printer";
+			return 0;
+		}
+		return device_;
+	}
+
+	void close(Device *device, bool failed){
+		*closed_ += 1;
+		if( failed && failed_ ){
+			*failed_ += 1;
+		}
+		*log_ = ((RecordingDevice *)device)->dump();
+	}
+
+private:
+	RecordingDevice *device_;
+	long *opened_, *closed_, *failed_;
+	std::string *log_;
+};
+
+// Source whose device makes the copies, as drivers that support DM_COPIES do.
+class CopyingSource : public TestSource {
+public:
+	CopyingSource(RecordingDevice *device, long *opened, long *closed, std::string *log, int *copies)
+		: TestSource(device, opened, closed, log), copies_(copies) {}
+
+	bool setCopies(int copies, bool collate){
+		*copies_ = copies;
+		return true;
+	}
+
+private:
+	int *copies_;
+};
+
+static void test_run_on_worker(){
+	RecordingDevice device(600, 600);
+	long opened = 0, closed = 0, failed = 0;
+	std::string log;
+	PrintJob job(new TestSource(&device, &opened, &closed, &log, &failed));
+	fixture_receipt(job.addPage(), 3);
+	fixture_receipt(job.addPage(), 5);
+	std::thread worker(&PrintJob::run, &job);
+	worker.join();
+	CHECK_EQ(job.status(), JOB_DONE);
+	CHECK_EQ(job.pageCount(), (size_t)2);
+	CHECK_EQ(opened, 1);
+	CHECK_EQ(closed, 1);
+	CHECK_EQ(failed, 0);
+	CHECK_EQ(device.count(CALL_START_DOC), 1);
+	CHECK_EQ(device.count(CALL_START_PAGE), 2);
+	CHECK_EQ(device.count(CALL_END_DOC), 1);
+	CHECK_EQ(device.count(CALL_ABORT_DOC), 0);
+	CHECK_EQ(device.liveObjects(), 0);
+	CHECK(log.find("startDoc drawer\n") != std::string::npos);
+	CHECK(job.elapsed() >= 0);
+}
+
+static void test_cancel_while_printing(){
+	PrintJob *jobPtr = 0;
+	CancelingDevice device(&jobPtr, 10);
+	long opened = 0, closed = 0, failed = 0;
+	std::string log;
+	PrintJob job(new TestSource(&device, &opened, &closed, &log, &failed));
+	jobPtr = &job;
+	fixture_receipt(job.addPage(), 40);
+	fixture_receipt(job.addPage(), 40);
+	std::thread worker(&PrintJob::run, &job);
+	worker.join();
+	CHECK_EQ(job.status(), JOB_CANCELED);
+	CHECK_STR(job.error(), "canceled");
+	// stops before the op after the one that was running
+	CHECK_EQ(device.count(CALL_TEXT_RUN), 10);
+	CHECK_EQ(device.count(CALL_START_PAGE), 1);
+	CHECK_EQ(device.count(CALL_ABORT_DOC), 1);
+	CHECK_EQ(device.count(CALL_END_DOC), 0);
+	CHECK_EQ(device.liveObjects(), 0);
+	CHECK_EQ(closed, 1);
+	// a canceled job's device is not reused
+	CHECK_EQ(failed, 1);
+}
+
+static void test_cancel_before_start(){
+	RecordingDevice device(600, 600);
+	long opened = 0, closed = 0;
+	std::string log;
+	PrintJob job(new TestSource(&device, &opened, &closed, &log));
+	fixture_receipt(job.addPage(), 1);
+	job.cancel();
+	job.run();
+	CHECK_EQ(job.status(), JOB_CANCELED);
+	CHECK_EQ(opened, 0);
+	CHECK_EQ(device.totalCount(), 0);
+}
+
+static void test_copies(){
+	long opened = 0, closed = 0;
+	std::string log;
+	{
+		RecordingDevice device(600, 600);
+		PrintJob job(new TestSource(&device, &opened, &closed, &log));
+		fixture_receipt(job.addPage(), 3);
+		fixture_receipt(job.addPage(), 5);
+		job.setCopies(3, true);
+		job.run();
+		CHECK_EQ(job.status(), JOB_DONE);
+		CHECK(!job.driverCopies());
+		CHECK_EQ(job.replayedPages(), 6L);
+		CHECK_EQ(device.count(CALL_START_DOC), 1);
+		CHECK_EQ(device.count(CALL_START_PAGE), 6);
+		CHECK_EQ(device.liveObjects(), 0);
+	}
+	{
+		RecordingDevice device(600, 600);
+		int copies = 0;
+		PrintJob job(new CopyingSource(&device, &opened, &closed, &log, &copies));
+		fixture_receipt(job.addPage(), 3);
+		job.setCopies(4, false);
+		job.run();
+		CHECK_EQ(job.status(), JOB_DONE);
+		CHECK(job.driverCopies());
+		CHECK_EQ(copies, 4);
+		CHECK_EQ(job.replayedPages(), 0L);
+		CHECK_EQ(device.count(CALL_START_PAGE), 1);
+	}
+}
+
+static void test_failures(){
+	long opened = 0, closed = 0, failed = 0;
+	std::string log;
+	{
+		PrintJob job(new TestSource(0, &opened, &closed, &log));
+		job.run();
+		CHECK_EQ(job.status(), JOB_FAILED);
+		CHECK_STR(job.error(), "no such printer");
+		CHECK_EQ(closed, 0);
+	}
+	{
+		RecordingDevice device(600, 600);
+		device.failOn(CALL_END_PAGE);
+		PrintJob job(new TestSource(&device, &opened, &closed, &log, &failed));
+		fixture_receipt(job.addPage(), 1);
+		job.run();
+		CHECK_EQ(job.status(), JOB_FAILED);
+		CHECK_STR(job.error(), "EndPage failed");
+		CHECK_EQ(device.count(CALL_ABORT_DOC), 1);
+		CHECK_EQ(closed, 1);
+		CHECK_EQ(failed, 1);
+	}
+	{
+		RecordingDevice device(600, 600);
+		PrintJob job(new TestSource(&device, &opened, &closed, &log));
+		std::string err;
+		CHECK(!job.setEncodedPages("DRWP", 4, &err));
+	}
+}
+
+int main(){
+	test_run_on_worker();
+	test_cancel_while_printing();
+	test_cancel_before_start();
+	test_copies();
+	test_failures();
+	return test_summary("test-print-job");
+}
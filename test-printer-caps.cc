@@ -0,0 +1,217 @@
+#include "test-util.h"
+#include "printer-caps.h"
+#include <string.h>
+
+// Printer whose resolution comes from the DEVMODE text ("dpi 203"), with a
+// DC probe that only sees device caps. Counts the probes.
+class FakeCapsProvider : public CapsProvider {
+public:
+	FakeCapsProvider() : probes(0), dcProbes(0), fail(false) {}
+
+	bool probe(const std::string &printer, const char *devmode, size_t devmodeLength,
+			DeviceHandle dc, PrinterCaps *caps, std::string *err){
+		probes += 1;
+		if( fail ){
+			*err = "no such printer: " + printer;
+			return false;
+		}
+		int dpi = 600;
+		if( devmodeLength > 4 && strncmp(devmode, "dpi ", 4) == 0 ){
+			dpi = atoi(std::string(devmode + 4, devmodeLength - 4).c_str());
+		}
+		if( dc ){
+			dcProbes += 1;
+			// a DC answers GetDeviceCaps with its own resolution
+			dpi = (int)dc;
+		}
+		caps->dpix = dpi;
+		caps->dpiy = dpi;
+		caps->printableWidthMm = 72;
+		caps->printableHeightMm = 3000;
+		caps->printableWidth = 72 * dpi * 10 / 254;
+		caps->printableHeight = 3000 * dpi * 10 / 254;
+		caps->physicalWidth = 80 * dpi * 10 / 254;
+		caps->physicalHeight = caps->printableHeight;
+		caps->offsetX = 4 * dpi * 10 / 254;
+		caps->offsetY = 0;
+		caps->color = false;
+		caps->duplex = false;
+		if( !printer.empty() ){
+			PrinterPaper paper = { 256, "Roll Paper 80 x 297 mm", 800, 2970 };
+			caps->papers.push_back(paper);
+			PrinterBin bin = { 15, "Document[Cut]" };
+			caps->bins.push_back(bin);
+		}
+		return true;
+	}
+
+	int probes, dcProbes;
+	bool fail;
+};
+
+static const char dpi203[] = "dpi 203";
+static const char dpi180[] = "dpi 180";
+
+static void test_get(){
+	FakeCapsProvider provider;
+	PrinterCapsCache cache(&provider);
+	PrinterCaps caps;
+	std::string err;
+	CHECK(cache.get("TM-T88V", dpi203, strlen(dpi203), &caps, &err));
+	CHECK_EQ(caps.dpix, 203);
+	CHECK_EQ(caps.printableWidth, 575L);
+	CHECK_EQ(caps.offsetX, 31L);
+	CHECK_EQ(caps.papers.size(), (size_t)1);
+	CHECK_STR(caps.papers[0].name, "Roll Paper 80 x 297 mm");
+	CHECK_EQ(caps.bins[0].id, 15);
+	CHECK(cache.get("TM-T88V", dpi203, strlen(dpi203), &caps, &err));
+	CHECK_EQ(provider.probes, 1);
+
+	// another DEVMODE is another entry
+	CHECK(cache.get("TM-T88V", dpi180, strlen(dpi180), &caps, &err));
+	CHECK_EQ(caps.dpix, 180);
+	CHECK(cache.get("TSP100", 0, 0, &caps, &err));
+	CHECK_EQ(caps.dpix, 600);
+	CHECK_EQ(provider.probes, 3);
+
+	PrinterCapsStats stats = cache.stats();
+	CHECK_EQ(stats.hits, 1L);
+	CHECK_EQ(stats.misses, 3L);
+	CHECK_EQ(stats.entries, 3L);
+}
+
+static void test_invalidate(){
+	FakeCapsProvider provider;
+	PrinterCapsCache cache(&provider);
+	PrinterCaps caps;
+	std::string err;
+	cache.get("TM-T88V", dpi203, strlen(dpi203), &caps, &err);
+	cache.get("TM-T88V", dpi180, strlen(dpi180), &caps, &err);
+	cache.get("TSP100", 0, 0, &caps, &err);
+	cache.invalidate("TM-T88V");
+	CHECK_EQ(cache.stats().entries, 1L);
+	cache.get("TSP100", 0, 0, &caps, &err);
+	CHECK_EQ(provider.probes, 3);
+	cache.get("TM-T88V", dpi180, strlen(dpi180), &caps, &err);
+	CHECK_EQ(provider.probes, 4);
+	cache.invalidate("");
+	CHECK_EQ(cache.stats().entries, 0L);
+	cache.get("TSP100", 0, 0, &caps, &err);
+	CHECK_EQ(provider.probes, 5);
+}
+
+static void test_failure(){
+	FakeCapsProvider provider;
+	PrinterCapsCache cache(&provider);
+	PrinterCaps caps;
+	std::string err;
+	provider.fail = true;
+	CHECK(!cache.get("gone", 0, 0, &caps, &err));
+	CHECK_STR(err, "no such printer: gone");
+	// not cached: the printer may come back
+	provider.fail = false;
+	CHECK(cache.get("gone", 0, 0, &caps, &err));
+	CHECK_EQ(provider.probes, 2);
+	CHECK_EQ(cache.stats().failures, 1L);
+}
+
+static void test_dc(){
+	FakeCapsProvider provider;
+	PrinterCapsCache cache(&provider);
+	PrinterCaps caps;
+	std::string err;
+	DeviceHandle dc = 203, other = 300;
+
+	// a bound DC shares the entry of its printer and DEVMODE, probed from
+	// the DC if there is none yet
+	cache.bindDc(dc, "TM-T88V", dpi203, strlen(dpi203));
+	CHECK(cache.getForDc(dc, &caps, &err));
+	CHECK_EQ(provider.dcProbes, 1);
+	CHECK_EQ(caps.papers.size(), (size_t)1);
+	CHECK(cache.get("TM-T88V", dpi203, strlen(dpi203), &caps, &err));
+	CHECK(cache.getForDc(dc, &caps, &err));
+	CHECK_EQ(provider.probes, 1);
+	cache.unbindDc(dc);
+	CHECK_EQ(cache.stats().boundDcs, 0L);
+	// the entry outlives the DC
+	cache.bindDc(other, "TM-T88V", dpi203, strlen(dpi203));
+	CHECK(cache.getForDc(other, &caps, &err));
+	CHECK_EQ(caps.dpix, 203);
+	CHECK_EQ(provider.probes, 1);
+	cache.unbindDc(other);
+
+	// an unbound DC gets device caps only, until it is unbound
+	CHECK(cache.getForDc(other, &caps, &err));
+	CHECK_EQ(caps.dpix, 300);
+	CHECK(caps.papers.empty());
+	CHECK(cache.getForDc(other, &caps, &err));
+	CHECK_EQ(provider.probes, 2);
+	cache.unbindDc(other);
+	CHECK_EQ(cache.stats().entries, 1L);
+	// binding replaces what was probed from the handle before
+	cache.getForDc(other, &caps, &err);
+	cache.bindDc(other, "TM-T88V", dpi180, strlen(dpi180));
+	CHECK(cache.getForDc(other, &caps, &err));
+	CHECK_EQ(caps.papers.size(), (size_t)1);
+	CHECK_EQ(cache.stats().entries, 2L);
+}
+
+static PrinterCaps caps_of(int dpi, long widthMm){
+	PrinterCaps caps = PrinterCaps();
+	caps.dpix = dpi;
+	caps.dpiy = dpi;
+	caps.printableWidthMm = widthMm;
+	caps.printableWidth = widthMm * dpi * 10 / 254;
+	return caps;
+}
+
+static void test_image_placement(){
+	// a 72 mm receipt printer at 203 dpi (574 pixels) prints 1:1, resampled
+	// or not
+	PrinterCaps receipt = caps_of(203, 72);
+	ImagePlacement place = image_placement(receipt, 384, 100, true);
+	CHECK_EQ(place.width, 384L);
+	CHECK_EQ(place.height, 100L);
+	CHECK_EQ(place.x, 287L - 192L);
+	place = image_placement(receipt, 384, 100, false);
+	CHECK_EQ(place.width, 384L);
+	CHECK_EQ(place.height, 100L);
+	// even wider than the paper
+	place = image_placement(receipt, 640, 10, true);
+	CHECK_EQ(place.width, 640L);
+	CHECK_EQ(place.x, 287L - 320L);
+	CHECK_EQ(image_placement(caps_of(203, 100), 200, 10, true).width, 200L);
+
+	// A4 at 600 dpi (4960 pixels): 6.25 times when resampled, 6 times with
+	// StretchDIBits
+	PrinterCaps a4 = caps_of(600, 210);
+	place = image_placement(a4, 400, 96, true);
+	CHECK_EQ(place.width, 2500L);
+	CHECK_EQ(place.height, 600L);
+	CHECK_EQ(place.x, 2480L - 1250L);
+	place = image_placement(a4, 400, 96, false);
+	CHECK_EQ(place.width, 2400L);
+	CHECK_EQ(place.height, 576L);
+	CHECK_EQ(place.x, 2480L - 1200L);
+	// too wide: shrunk to the printable width, or left 1:1 wide
+	place = image_placement(a4, 960, 96, true);
+	CHECK_EQ(place.width, 4960L);
+	CHECK_EQ(place.height, 496L);
+	CHECK_EQ(place.x, 0L);
+	place = image_placement(a4, 960, 96, false);
+	CHECK_EQ(place.width, 960L);
+	CHECK_EQ(place.height, 576L);
+	// never empty
+	place = image_placement(caps_of(72, 210), 1, 1, true);
+	CHECK_EQ(place.width, 1L);
+	CHECK_EQ(place.height, 1L);
+}
+
+int main(){
+	test_get();
+	test_invalidate();
+	test_failure();
+	test_dc();
+	test_image_placement();
+	return test_summary("test-printer-caps");
+}
@@ -0,0 +1,243 @@
+#include "test-util.h"
+#include "raster-device.h"
+#include "page-executor.h"
+#include "png-image.h"
+#include "resample.h"
+#include <string.h>
+
+static uint8_t at(const RasterPage &page, uint32_t x, uint32_t y){
+	return page.pixels[(size_t)y * page.stride + x];
+}
+
+// Dark pixels of row y, as a string of '#' and '.'.
+static std::string row_of(const RasterPage &page, uint32_t y, uint32_t x0, uint32_t x1){
+	std::string out;
+	uint32_t x;
+	for(x=x0;x<x1;x++){
+		out += at(page, x, y) < 128 ? '#' : '.';
+	}
+	return out;
+}
+
+static void test_lines(){
+	RasterDevice device(300, 300);
+	RasterPage page;
+	device.startPage();
+	device.moveTo(10, 5);
+	device.lineTo(20, 5);
+	DeviceHandle pen = device.createPen(5, 255, 0, 0);
+	CHECK(device.selectObject(pen));
+	device.moveTo(10, 10);
+	device.lineTo(10, 30);
+	device.rasterize(40, 40, 1, &page);
+	CHECK_STR(row_of(page, 5, 8, 23), "..###########..");
+	CHECK_STR(row_of(page, 4, 8, 23), "...............");
+	CHECK_STR(row_of(page, 6, 8, 23), "...............");
+	// round caps of a 5 pixel red pen, gray 77
+	CHECK_STR(row_of(page, 20, 6, 15), "..#####..");
+	CHECK_EQ(at(page, 10, 20), 77);
+	CHECK_STR(row_of(page, 32, 6, 15), "...###...");
+	CHECK_STR(row_of(page, 33, 6, 15), ".........");
+	CHECK_EQ(device.contentBottom(), 34);
+
+	// no gaps in thin lines of any slope
+	static const long ends[][2] = { { 37, 3 }, { 3, 37 }, { 25, 39 }, { 39, 21 }, { 0, 0 } };
+	size_t i;
+	for(i=0;i<sizeof(ends)/sizeof(ends[0]);i++){
+		RasterDevice thin(300, 300);
+		thin.moveTo(20, 20);
+		thin.lineTo(ends[i][0], ends[i][1]);
+		thin.rasterize(40, 40, 1, &page);
+		long y, x, lo = ends[i][1] < 20 ? ends[i][1] : 20, hi = ends[i][1] > 20 ? ends[i][1] : 20;
+		long xlo = ends[i][0] < 20 ? ends[i][0] : 20, xhi = ends[i][0] > 20 ? ends[i][0] : 20;
+		bool rows = true, columns = true;
+		for(y=lo;y<=hi;y++){
+			rows = rows && row_of(page, (uint32_t)y, 0, 40).find('#') != std::string::npos;
+		}
+		for(x=xlo;x<=xhi;x++){
+			bool found = false;
+			for(y=0;y<40;y++){
+				found = found || at(page, (uint32_t)x, (uint32_t)y) == 0;
+			}
+			columns = columns && found;
+		}
+		CHECK(rows);
+		CHECK(columns);
+	}
+
+	// filled rectangles cover [left, right) x [top, bottom)
+	RasterDevice filled(300, 300);
+	CHECK(filled.fillRect(2, 3, 6, 5, 0, 0, 0));
+	filled.rasterize(10, 10, 1, &page);
+	CHECK_STR(row_of(page, 2, 0, 10), "..........");
+	CHECK_STR(row_of(page, 3, 0, 10), "..####....");
+	CHECK_STR(row_of(page, 4, 0, 10), "..####....");
+	CHECK_STR(row_of(page, 5, 0, 10), "..........");
+	CHECK_EQ(filled.contentBottom(), 5);
+}
+
+static void test_text(){
+	static const uint16_t text[] = { 'I', 'i', 0x3042 };
+	static const int advances[] = { 12, 12, 12 };
+	RasterDevice device(300, 300);
+	RasterPage page;
+	DeviceHandle font = device.createFont(NULL, 0, 16, 0, 0);
+	CHECK(device.selectObject(font));
+	device.setTextColor(0, 0, 0);
+	CHECK(device.textRun(2, 3, text, 3, advances));
+	device.rasterize(40, 20, 1, &page);
+	// 'I' is 2 x 2 pixels per font pixel: bars on rows 0 and 6, a stem in
+	// column 2
+	CHECK_STR(row_of(page, 3, 2, 14), "..######....");
+	CHECK_STR(row_of(page, 9, 2, 14), "....##......");
+	CHECK_STR(row_of(page, 16, 2, 14), "..######....");
+	CHECK_STR(row_of(page, 17, 2, 14), "............");
+	// the box drawn for a character the font does not have
+	CHECK_STR(row_of(page, 4, 26, 38), "##########..");
+	CHECK_STR(row_of(page, 9, 26, 38), "##......##..");
+	CHECK_EQ(device.contentBottom(), 19);
+
+	RasterDevice bold(300, 300);
+	bold.selectObject(bold.createFont(NULL, 0, 16, FONT_WEIGHT_BOLD, 0));
+	bold.textOut(2, 3, text, 1);
+	bold.rasterize(40, 20, 1, &page);
+	CHECK_STR(row_of(page, 9, 2, 14), "....###.....");
+
+	CHECK(!device.selectObject(99));
+	CHECK(device.deleteObject(font));
+	CHECK(!device.selectObject(font));
+}
+
+class MemoryRows : public ImageRows {
+public:
+	MemoryRows(const std::vector<uint8_t> &bgr, uint32_t width, uint32_t height) :
+		bgr_(bgr), width_(width), height_(height), y_(0) {}
+	uint32_t width() const { return width_; }
+	uint32_t height() const { return height_; }
+	bool readRow(uint8_t *bgr, std::string *err){
+		memcpy(bgr, &bgr_[(size_t)y_++ * width_ * 3], width_ * 3);
+		return true;
+	}
+
+private:
+	const std::vector<uint8_t> &bgr_;
+	uint32_t width_, height_, y_;
+};
+
+static void test_image(){
+	std::vector<uint8_t> bgr(20 * 10 * 3);
+	size_t i;
+	for(i=0;i<bgr.size();i++){
+		bgr[i] = (uint8_t)(i / 3 % 20 * 12);
+	}
+	RasterDevice device(300, 300);
+	RasterPage page;
+	std::string err;
+	MemoryRows rows(bgr, 20, 10);
+	CHECK(device.drawImage(&rows, -5, 3, 40, 20, &err));
+	device.moveTo(0, 10);
+	device.lineTo(39, 10);
+	device.rasterize(30, 30, 1, &page);
+	std::vector<uint8_t> gray(20 * 10), scaled(40 * 20);
+	for(i=0;i<gray.size();i++){
+		mono_luma(&bgr[3 * i], 3, 1, &gray[i]);
+	}
+	resample_image(&gray[0], 20, 20, 10, &scaled[0], 40, 40, 20, 1, RESAMPLE_LANCZOS3, 1);
+	CHECK_EQ(at(page, 0, 3), scaled[5]);
+	CHECK_EQ(at(page, 29, 22), scaled[19 * 40 + 34]);
+	CHECK_EQ(at(page, 7, 10), 0);
+	CHECK_EQ(at(page, 7, 2), 255);
+	CHECK_EQ(at(page, 7, 23), 255);
+	MemoryRows again(bgr, 20, 10);
+	CHECK(!device.drawImage(&again, 0, 0, 0, 5, &err));
+	CHECK_STR(err, "invalid image size");
+}
+
+// Bands and threads do not change the page.
+static void test_bands(){
+	RasterDevice device(300, 300);
+	RasterPage one, four;
+	static const uint16_t text[] = { 'A', 'b', '1' };
+	uint32_t i;
+	device.selectObject(device.createFont(NULL, 0, 40, 0, 1));
+	device.selectObject(device.createPen(3, 0, 0, 0));
+	for(i=0;i<100;i++){
+		device.moveTo(i * 37 % 500, i * 71 % 900);
+		device.lineTo(i * 53 % 500, i * 29 % 900);
+		device.textOut(i * 13 % 500, i * 61 % 900, text, 3);
+	}
+	device.rasterize(500, 900, 1, &one);
+	device.rasterize(500, 900, 4, &four);
+	CHECK(one.pixels == four.pixels);
+	CHECK_EQ(device.itemCount(), (size_t)200);
+
+	MonoOptions opts;
+	RasterPage monoOne, monoFour;
+	opts.dither = MONO_DITHER_BAYER;
+	raster_to_mono(one, opts, 1, &monoOne);
+	raster_to_mono(one, opts, 4, &monoFour);
+	CHECK(monoOne.pixels == monoFour.pixels);
+	CHECK_EQ(monoOne.stride, 63u);
+}
+
+static void test_render_pages(){
+	PageBuilder b;
+	static const double xs[] = { 10, 13 };
+	std::vector<uint16_t> hi = u16("Hi");
+	b.moveTo(5, 5);
+	b.lineTo(50, 5);
+	b.createFont("f", "Arial", 4, 0, 0);
+	b.setFont("f");
+	b.drawChars(&hi[0], 2, b.addCoords(xs, 2), b.scalar(10));
+	b.finish();
+	const Page *pages[] = { &b.page(), &b.page() };
+	RasterOptions opts;
+	std::vector<std::vector<uint8_t> > files;
+	std::string err;
+	opts.dpi = 254;
+	opts.width = 60;
+	CHECK(render_pages(pages, 2, opts, &files, &err));
+	CHECK_EQ(files.size(), (size_t)2);
+	CHECK(files[0] == files[1]);
+	PngImage image;
+	CHECK(parse_png(&files[0][0], files[0].size(), &image, &err));
+	CHECK_EQ(image.width, 600u);
+	// the page ends below the text: 10 mm + 4 mm at 10 pixels per mm
+	CHECK_EQ(image.height, 140u);
+
+	opts.format = RASTER_PNM;
+	opts.bits = 1;
+	opts.height = 20;
+	CHECK(render_pages(pages, 1, opts, &files, &err));
+	std::string pbm(files[0].begin(), files[0].end());
+	CHECK_STR(pbm.substr(0, 11), "P4\n600 200\n");
+	CHECK_EQ(files[0].size(), (size_t)11 + 75 * 200);
+	// row 50 has the line from 50 to 500: black is 1
+	CHECK_EQ(files[0][11 + 50 * 75 + 6], 0x3f);
+	CHECK_EQ(files[0][11 + 50 * 75 + 20], 0xff);
+	CHECK_EQ(files[0][11 + 49 * 75 + 20], 0);
+
+	opts.bits = 8;
+	CHECK(render_pages(pages, 1, opts, &files, &err));
+	CHECK_STR(std::string(files[0].begin(), files[0].begin() + 15), "P5\n600 200\n255\n");
+
+	opts.width = 0;
+	CHECK(!render_pages(pages, 1, opts, &files, &err));
+	CHECK_STR(err, "invalid page size");
+	PageBuilder bad;
+	bad.setFont("missing");
+	bad.finish();
+	const Page *badPages[] = { &bad.page() };
+	opts.width = 60;
+	CHECK(!render_pages(badPages, 1, opts, &files, &err));
+	CHECK_STR(err, "unknown font: missing");
+}
+
+int main(){
+	test_lines();
+	test_text();
+	test_image();
+	test_bands();
+	test_render_pages();
+	return test_summary("test-raster-device");
+}
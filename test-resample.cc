@@ -0,0 +1,233 @@
+#include "test-util.h"
+#include "resample.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static void test_kernel(){
+	static const int filters[] = { RESAMPLE_BOX, RESAMPLE_BILINEAR, RESAMPLE_LANCZOS3 };
+	static const uint32_t sizes[][2] = { { 100, 100 }, { 100, 37 }, { 37, 100 }, { 5, 1 }, { 1, 9 }, { 640, 203 } };
+	size_t f, s;
+	uint32_t i, k;
+	for(f=0;f<3;f++){
+		for(s=0;s<sizeof(sizes)/sizeof(sizes[0]);s++){
+			ResampleKernel kernel;
+			make_resample_kernel(sizes[s][0], sizes[s][1], filters[f], &kernel);
+			bool ok = true;
+			for(i=0;i<kernel.dstSize;i++){
+				int sum = 0;
+				for(k=0;k<kernel.taps;k++){
+					sum += kernel.weights[i * kernel.taps + k];
+				}
+				ok = ok && sum == 16384 && kernel.count[i] > 0 && kernel.count[i] <= kernel.taps &&
+					kernel.start[i] + kernel.count[i] <= kernel.srcSize;
+			}
+			CHECK(ok);
+			CHECK_EQ(kernel.taps % 8, 0u);
+		}
+	}
+	// same size: every filter is the identity
+	for(f=0;f<3;f++){
+		ResampleKernel kernel;
+		make_resample_kernel(10, 10, filters[f], &kernel);
+		uint32_t tap = 4 - kernel.start[4];
+		CHECK(tap < kernel.count[4]);
+		CHECK_EQ(kernel.weights[4 * kernel.taps + tap], 16384);
+	}
+	// halving with a box averages pairs
+	ResampleKernel box;
+	make_resample_kernel(10, 5, RESAMPLE_BOX, &box);
+	CHECK_EQ(box.start[1], 2u);
+	CHECK_EQ(box.count[1], 2u);
+	CHECK_EQ(box.weights[1 * box.taps], 8192);
+}
+
+static std::vector<uint8_t> random_image(uint32_t width, uint32_t height, uint32_t channels){
+	std::vector<uint8_t> image((size_t)width * height * channels);
+	size_t i;
+	srand(width * 31 + height);
+	for(i=0;i<image.size();i++){
+		image[i] = (uint8_t)(rand() >> 4);
+	}
+	return image;
+}
+
+static std::vector<uint8_t> resample(const std::vector<uint8_t> &src, uint32_t sw, uint32_t sh,
+		uint32_t dw, uint32_t dh, uint32_t channels, int filter, int threads){
+	std::vector<uint8_t> dst((size_t)dw * dh * channels);
+	resample_image(&src[0], sw * channels, sw, sh, &dst[0], dw * channels, dw, dh,
+		channels, filter, threads);
+	return dst;
+}
+
+// SIMD and scalar passes, and any number of threads, give identical output.
+static void test_simd_and_threads(){
+	static const uint32_t sizes[][4] = { { 101, 67, 37, 203 }, { 64, 64, 211, 97 }, { 300, 200, 299, 201 }, { 7, 3, 1, 1 } };
+	size_t s;
+	uint32_t channels;
+	int filter;
+	for(s=0;s<sizeof(sizes)/sizeof(sizes[0]);s++){
+		for(channels=1;channels<=3;channels+=2){
+			uint32_t sw = sizes[s][0], sh = sizes[s][1], dw = sizes[s][2], dh = sizes[s][3];
+			std::vector<uint8_t> src = random_image(sw, sh, channels);
+			for(filter=RESAMPLE_BOX;filter<=RESAMPLE_LANCZOS3;filter++){
+				resample_use_simd(false);
+				std::vector<uint8_t> scalar = resample(src, sw, sh, dw, dh, channels, filter, 1);
+				resample_use_simd(true);
+				std::vector<uint8_t> simd = resample(src, sw, sh, dw, dh, channels, filter, 1);
+				std::vector<uint8_t> threaded = resample(src, sw, sh, dw, dh, channels, filter, 4);
+				CHECK(scalar == simd);
+				CHECK(simd == threaded);
+			}
+		}
+	}
+}
+
+// A constant image stays constant and same-size resampling copies.
+static void test_identity(){
+	std::vector<uint8_t> flat(50 * 40 * 3, 77);
+	std::vector<uint8_t> out = resample(flat, 50, 40, 123, 17, 3, RESAMPLE_LANCZOS3, 2);
+	size_t i;
+	bool same = true;
+	for(i=0;i<out.size();i++){
+		same = same && out[i] == 77;
+	}
+	CHECK(same);
+	std::vector<uint8_t> src = random_image(33, 21, 3);
+	CHECK(resample(src, 33, 21, 33, 21, 3, RESAMPLE_LANCZOS3, 1) == src);
+	CHECK(resample(src, 33, 21, 33, 21, 3, RESAMPLE_BILINEAR, 1) == src);
+}
+
+// Shrinking a one-pixel checkerboard must give even gray (no aliasing),
+// and enlarging a gradient must keep it smooth.
+static void test_quality(){
+	uint32_t w = 300, h = 300, x, y;
+	std::vector<uint8_t> checker(w * h);
+	for(y=0;y<h;y++){
+		for(x=0;x<w;x++){
+			checker[y * w + x] = (x + y) % 2 ? 255 : 0;
+		}
+	}
+	int filter;
+	for(filter=RESAMPLE_BOX;filter<=RESAMPLE_LANCZOS3;filter++){
+		// a box only averages evenly at whole factors
+		uint32_t size = filter == RESAMPLE_BOX ? 150 : 97;
+		std::vector<uint8_t> out = resample(checker, w, h, size, size, 1, filter, 1);
+		int lo = 255, hi = 0;
+		for(x=2;x<size-2;x++){
+			for(y=2;y<size-2;y++){
+				int v = out[y * size + x];
+				lo = v < lo ? v : lo;
+				hi = v > hi ? v : hi;
+			}
+		}
+		CHECK(lo >= 120 && hi <= 135);
+	}
+
+	std::vector<uint8_t> ramp(64);
+	for(x=0;x<64;x++){
+		ramp[x] = (uint8_t)(x * 4);
+	}
+	std::vector<uint8_t> up = resample(ramp, 64, 1, 203, 1, 1, RESAMPLE_LANCZOS3, 1);
+	double worst = 0;
+	for(x=10;x<193;x++){
+		double expected = ((x + 0.5) * 64.0 / 203 - 0.5) * 4;
+		double error = fabs(up[x] - expected);
+		worst = error > worst ? error : worst;
+	}
+	CHECK(worst <= 1.0);
+	std::vector<uint8_t> bilinear = resample(ramp, 64, 1, 203, 1, 1, RESAMPLE_BILINEAR, 1);
+	bool monotonic = true;
+	for(x=1;x<203;x++){
+		monotonic = monotonic && bilinear[x] >= bilinear[x - 1];
+	}
+	CHECK(monotonic);
+}
+
+// Collects the bands of draw_resampled.
+class CollectTarget : public ImageTarget {
+public:
+	bool drawBand(long destX, long destY, long destWidth, long destHeight,
+			uint32_t srcWidth, uint32_t srcRows, const uint8_t *pixels, const uint8_t *info){
+		uint32_t bits = info[14], stride = ((srcWidth * bits + 31) / 32) * 4, y;
+		CHECK_EQ(destWidth, (long)srcWidth);
+		CHECK_EQ(destHeight, (long)srcRows);
+		CHECK_EQ(destY, nextY);
+		for(y=0;y<srcRows;y++){
+			image.insert(image.end(), pixels + y * stride, pixels + y * stride + (srcWidth * bits + 7) / 8);
+		}
+		nextY += destHeight;
+		bands += 1;
+		return true;
+	}
+
+	std::vector<uint8_t> image;
+	long nextY = 5;
+	int bands = 0;
+};
+
+class MemoryRows : public ImageRows {
+public:
+	MemoryRows(const std::vector<uint8_t> &bgr, uint32_t width, uint32_t height) :
+		bgr_(bgr), width_(width), height_(height), y_(0) {}
+	uint32_t width() const { return width_; }
+	uint32_t height() const { return height_; }
+	bool readRow(uint8_t *bgr, std::string *err){
+		memcpy(bgr, &bgr_[(size_t)y_++ * width_ * 3], width_ * 3);
+		return true;
+	}
+	uint32_t rowsRead() const { return y_; }
+
+private:
+	const std::vector<uint8_t> &bgr_;
+	uint32_t width_, height_, y_;
+};
+
+// Banded drawing gives the same pixels as resampling the whole image.
+static void test_draw_resampled(){
+	static const uint32_t sizes[][2] = { { 203, 500 }, { 57, 31 }, { 120, 1000 } };
+	std::vector<uint8_t> src = random_image(120, 90, 3);
+	size_t s;
+	for(s=0;s<sizeof(sizes)/sizeof(sizes[0]);s++){
+		uint32_t dw = sizes[s][0], dh = sizes[s][1];
+		MemoryRows rows(src, 120, 90);
+		CollectTarget target;
+		std::string err;
+		CHECK(draw_resampled(&rows, &target, 3, 5, dw, dh, RESAMPLE_LANCZOS3, 64, NULL, 3, &err));
+		CHECK_EQ(target.bands, (int)((dh + 63) / 64));
+		CHECK(target.image == resample(src, 120, 90, dw, dh, 3, RESAMPLE_LANCZOS3, 1));
+	}
+	// 1 bpp: gray resampled, then thresholded
+	MemoryRows rows(src, 120, 90);
+	CollectTarget target;
+	MonoOptions mono;
+	std::string err;
+	mono.dither = MONO_DITHER_NONE;
+	CHECK(draw_resampled(&rows, &target, 0, 5, 60, 45, RESAMPLE_BOX, 16, &mono, 2, &err));
+	CHECK_EQ(target.image.size(), (size_t)8 * 45);
+	std::vector<uint8_t> gray(120 * 90);
+	uint32_t i, x, y;
+	for(i=0;i<120*90;i++){
+		mono_luma(&src[3 * i], 3, 1, &gray[i]);
+	}
+	std::vector<uint8_t> small = resample(gray, 120, 90, 60, 45, 1, RESAMPLE_BOX, 1);
+	int mismatches = 0;
+	for(y=0;y<45;y++){
+		for(x=0;x<60;x++){
+			int bit = (target.image[y * 8 + x / 8] >> (7 - x % 8)) & 1;
+			mismatches += bit != (small[y * 60 + x] > 128 ? 1 : 0);
+		}
+	}
+	CHECK_EQ(mismatches, 0);
+	CHECK(!draw_resampled(&rows, &target, 0, 0, 0, 10, RESAMPLE_BOX, 16, NULL, 1, &err));
+	CHECK_STR(err, "invalid image size");
+}
+
+int main(){
+	test_kernel();
+	test_simd_and_threads();
+	test_identity();
+	test_quality();
+	test_draw_resampled();
+	return test_summary("test-resample");
+}
@@ -0,0 +1,184 @@
+"use strict";
+
+// Settings store on a temporary directory: loading, validation, atomic
+// saves, the watcher and the packed file. Runs without the native module.
+
+var SettingStoreModule = require("./setting-store");
+var SettingStore = SettingStoreModule.SettingStore;
+var fs = require("fs");
+var os = require("os");
+var path = require("path");
+var assert = require("assert");
+
+function allocBuffer(size){
+	return Buffer.alloc ? Buffer.alloc(size) : new Buffer(size).fill(0);
+}
+
+// DEVMODEW with the device name, dmSize 220 and driverExtra bytes of
+// driver data.
+function fakeDevmode(deviceName, copies, driverExtra){
+	var buf = allocBuffer(220 + driverExtra);
+	buf.write(deviceName.slice(0, 31), 0, "utf16le");
+	buf.writeUInt16LE(220, 68);
+	buf.writeUInt16LE(driverExtra, 70);
+	buf.writeUInt16LE(copies, 86);
+	return buf;
+}
+
+function fakeDevnames(driver, device, output){
+	var chars = 4, parts = [driver, device, output], offsets = [], i;
+	for(i=0;i<3;i++){
+		offsets.push(chars);
+		chars += parts[i].length + 1;
+	}
+	var buf = allocBuffer(chars * 2);
+	for(i=0;i<3;i++){
+		buf.writeUInt16LE(offsets[i], i * 2);
+		buf.write(parts[i], offsets[i] * 2, "utf16le");
+	}
+	return buf;
+}
+
+function writeSetting(dir, name, printer, copies, aux){
+	fs.writeFileSync(path.join(dir, name + ".devmode"), fakeDevmode(printer, copies, 8));
+	fs.writeFileSync(path.join(dir, name + ".devnames"), fakeDevnames("winspool", printer, "USB001"));
+	if( aux ){
+		fs.writeFileSync(path.join(dir, name + ".json"), JSON.stringify(aux));
+	}
+}
+
+var dir = fs.mkdtempSync(path.join(os.tmpdir(), "drawer-settings-"));
+
+function testLoad(){
+	writeSetting(dir, "kitchen", "EPSON TM-T88V", 1, { dx: 2 });
+	writeSetting(dir, "レジ", "Star TSP100", 2);
+	fs.writeFileSync(path.join(dir, "broken.devmode"), "short");
+	fs.writeFileSync(path.join(dir, "broken.devnames"), fakeDevnames("a", "b", "c"));
+	fs.writeFileSync(path.join(dir, "orphan.devnames"), fakeDevnames("a", "b", "c"));
+	fs.writeFileSync(path.join(dir, "notes.txt"), "not a setting");
+
+	var store = new SettingStore(dir).load();
+	assert.deepEqual(store.names(), ["kitchen", "レジ"]);
+	var kitchen = store.get("kitchen");
+	assert.equal(kitchen.printer, "EPSON TM-T88V");
+	assert.equal(kitchen.driver, "winspool");
+	assert.equal(kitchen.output, "USB001");
+	assert.deepEqual(kitchen.aux, { dx: 2 });
+	assert.equal(kitchen.devmode.length, 228);
+	assert.equal(store.get("レジ").aux, undefined);
+	assert.equal(store.get("broken"), null);
+	assert.equal(store.errors.broken, "devmode too short");
+	assert.ok(!store.has("orphan"));
+	assert.equal(SettingStoreModule.parseDevmodeBuffer(kitchen.devmode).deviceName, "EPSON TM-T88V");
+
+	assert.throws(function(){
+		SettingStoreModule.parseDevnamesBuffer(fakeDevnames("a", "b", "c").slice(0, 12));
+	}, /invalid devnames offset/);
+	var badSize = fakeDevmode("x", 1, 0);
+	badSize.writeUInt16LE(64, 70);
+	assert.throws(function(){
+		SettingStoreModule.parseDevmodeBuffer(badSize);
+	}, /invalid devmode size/);
+	fs.unlinkSync(path.join(dir, "broken.devmode"));
+	fs.unlinkSync(path.join(dir, "broken.devnames"));
+	fs.unlinkSync(path.join(dir, "orphan.devnames"));
+	fs.unlinkSync(path.join(dir, "notes.txt"));
+}
+
+function testSave(done){
+	var store = new SettingStore(dir).load(), changes = [];
+	store.on("change", function(name){
+		changes.push(name);
+	});
+	store.save("bar", { devmode: fakeDevmode("Bar printer", 1, 0),
+			devnames: fakeDevnames("winspool", "Bar printer", "LPT1") }, function(err){
+		assert.ifError(err);
+		assert.equal(store.get("bar").printer, "Bar printer");
+		assert.deepEqual(store.get("bar").aux, {});
+		assert.deepEqual(changes, ["bar"]);
+		assert.deepEqual(fs.readdirSync(dir).filter(function(f){ return /\.tmp$/.test(f); }), []);
+		assert.equal(fs.readFileSync(path.join(dir, "bar.json"), "utf-8"), "{}");
+
+		// invalid settings are not written
+		store.save("bad", { devmode: allocBuffer(10), devnames: fakeDevnames("a", "b", "c") }, function(err){
+			assert.ok(err);
+			assert.ok(!fs.existsSync(path.join(dir, "bad.devnames")));
+			store.remove("bar", function(err){
+				assert.ifError(err);
+				assert.ok(!store.has("bar"));
+				assert.ok(!fs.existsSync(path.join(dir, "bar.devnames")));
+				assert.deepEqual(changes, ["bar", "bar"]);
+				done();
+			});
+		});
+	});
+}
+
+function testWatch(done){
+	var store = new SettingStore(dir).load().watch(20), changes = [];
+	var timeout = setTimeout(function(){
+		store.close();
+		assert.fail("no change event for " + JSON.stringify(changes));
+	}, 5000);
+	store.on("change", function(name){
+		changes.push(name);
+		if( name === "kitchen" && store.get("kitchen").aux.dx === 5 ){
+			// a second process saves over the kitchen setting, then deletes レジ
+			fs.unlinkSync(path.join(dir, "レジ.devmode"));
+		} else if( name === "レジ" && !store.has("レジ") ){
+			clearTimeout(timeout);
+			store.close();
+			assert.deepEqual(store.names(), ["kitchen"]);
+			done();
+		}
+	});
+	var other = new SettingStore(dir);
+	other.saveSync("kitchen", { devmode: fakeDevmode("EPSON TM-T88V", 3, 8),
+		devnames: fakeDevnames("winspool", "EPSON TM-T88V", "USB001"), aux: { dx: 5 } });
+}
+
+function testPacked(done){
+	var store = new SettingStore(dir).load();
+	var packedPath = path.join(os.tmpdir(), "drawer-settings-" + process.pid + ".pack");
+	var i;
+	for(i=0;i<200;i++){
+		store.setEntry({ name: "printer " + i, devmode: fakeDevmode("Printer " + i, 1, i % 16),
+			devnames: fakeDevnames("winspool", "Printer " + i, "FILE:"), aux: { n: i },
+			printer: "Printer " + i, driver: "winspool", output: "FILE:" });
+	}
+	store.writePacked(packedPath, function(err){
+		assert.ifError(err);
+		var packed = new SettingStore(dir).loadPacked(packedPath);
+		assert.equal(packed.names().length, 201);
+		assert.deepEqual(packed.names(), store.names());
+		assert.equal(packed.get("printer 77").printer, "Printer 77");
+		assert.deepEqual(packed.get("printer 77").aux, { n: 77 });
+		assert.ok(packed.get("kitchen").devmode.equals(store.get("kitchen").devmode));
+		assert.ok(packed.get("printer 15").devnames.equals(store.get("printer 15").devnames));
+
+		var buf = fs.readFileSync(packedPath);
+		fs.writeFileSync(packedPath, buf.slice(0, buf.length - 3));
+		assert.throws(function(){
+			new SettingStore(dir).loadPacked(packedPath);
+		}, /truncated/);
+		fs.writeFileSync(packedPath, "DRWX0000000000000000");
+		assert.throws(function(){
+			new SettingStore(dir).loadPacked(packedPath);
+		}, /not a packed settings file/);
+		fs.unlinkSync(packedPath);
+		done();
+	});
+}
+
+testLoad();
+testSave(function(){
+	testWatch(function(){
+		testPacked(function(){
+			fs.readdirSync(dir).forEach(function(f){
+				fs.unlinkSync(path.join(dir, f));
+			});
+			fs.rmdirSync(dir);
+			console.log("test-setting-store: ok");
+		});
+	});
+});
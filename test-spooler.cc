@@ -0,0 +1,279 @@
+#include "test-util.h"
+#include "test-fixtures.h"
+#include "spooler.h"
+#include "recording-device.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Simulated printer: each page takes latencyMs, opening fails when broken,
+// and pages wait while the printer is held (a jammed printer).
+class SimPrinter {
+public:
+	SimPrinter(int latencyMs) : latencyMs(latencyMs), broken(false), held(false) {}
+
+	void hold(){
+		std::lock_guard<std::mutex> lock(mutex);
+		held = true;
+	}
+
+	void unhold(){
+		std::lock_guard<std::mutex> lock(mutex);
+		held = false;
+		cond.notify_all();
+	}
+
+	void waitHeld(){
+		std::unique_lock<std::mutex> lock(mutex);
+		while( held ){
+			cond.wait(lock);
+		}
+	}
+
+	int latencyMs;
+	std::atomic<bool> broken;
+	std::mutex mutex;
+	std::condition_variable cond;
+	bool held;
+};
+
+class SimDevice : public RecordingDevice {
+public:
+	explicit SimDevice(SimPrinter *printer) : RecordingDevice(203, 203), printer_(printer) {
+		setRecording(false);
+	}
+
+	bool startPage(){
+		printer_->waitHeld();
+		std::this_thread::sleep_for(std::chrono::milliseconds(printer_->latencyMs));
+		return RecordingDevice::startPage();
+	}
+
+private:
+	SimPrinter *printer_;
+};
+
+class SimSource : public DeviceSource {
+public:
+	explicit SimSource(SimPrinter *printer) : printer_(printer) {}
+
+	Device *open(std::string *err){
+		if( printer_->broken ){
+			*err = "printer offline";
+			return 0;
+		}
+		return new SimDevice(printer_);
+	}
+
+	void close(Device *device, bool failed){
+		delete device;
+	}
+
+private:
+	SimPrinter *printer_;
+};
+
+// Collects finished jobs in completion order.
+class Collector : public SpoolerListener {
+public:
+	void jobFinished(long jobId, PrintJob *job){
+		std::lock_guard<std::mutex> lock(mutex_);
+		char buf[64];
+		sprintf(buf, "%ld:%s ", jobId, print_job_status_name(job->status()));
+		log_ += buf;
+		count_ += 1;
+		delete job;
+		cond_.notify_all();
+	}
+
+	bool waitFor(int count){
+		std::unique_lock<std::mutex> lock(mutex_);
+		return cond_.wait_for(lock, std::chrono::seconds(10),
+			[this, count](){ return count_ >= count; });
+	}
+
+	std::string log(){
+		std::lock_guard<std::mutex> lock(mutex_);
+		return log_;
+	}
+
+	Collector() : count_(0) {}
+
+private:
+	std::mutex mutex_;
+	std::condition_variable cond_;
+	std::string log_;
+	int count_;
+};
+
+static PrintJob *make_job(SimPrinter *printer){
+	PrintJob *job = new PrintJob(new SimSource(printer));
+	fixture_receipt(job->addPage(), 5);
+	return job;
+}
+
+static bool submit(Spooler &spooler, const char *device, long jobId, SimPrinter *printer,
+		int priority){
+	std::string err;
+	PrintJob *job = make_job(printer);
+	if( !spooler.submit(device, jobId, job, priority, &err) ){
+		delete job;
+		return false;
+	}
+	return true;
+}
+
+static void test_priority_order(){
+	Collector collector;
+	SimPrinter kitchen(0);
+	Spooler spooler(&collector, 16);
+	kitchen.hold();
+	CHECK(submit(spooler, "kitchen", 1, &kitchen, 0));
+	// wait until job 1 is running, so the rest queue behind it
+	while( spooler.status()[0].runningJob != 1 ){
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	CHECK(submit(spooler, "kitchen", 2, &kitchen, 0));
+	CHECK(submit(spooler, "kitchen", 3, &kitchen, 5));
+	CHECK(submit(spooler, "kitchen", 4, &kitchen, 0));
+	CHECK(submit(spooler, "kitchen", 5, &kitchen, 5));
+	CHECK(submit(spooler, "kitchen", 6, &kitchen, -1));
+	CHECK_EQ(spooler.pending(), (size_t)6);
+	kitchen.unhold();
+	CHECK(collector.waitFor(6));
+	CHECK_STR(collector.log(), "1:done 3:done 5:done 2:done 4:done 6:done ");
+	CHECK_EQ(spooler.pending(), (size_t)0);
+	CHECK_EQ(spooler.status()[0].done, 6);
+}
+
+static void test_backpressure(){
+	Collector collector;
+	SimPrinter bar(0);
+	Spooler spooler(&collector, 2);
+	std::string err;
+	bar.hold();
+	CHECK(submit(spooler, "bar", 1, &bar, 0));
+	while( spooler.status()[0].runningJob != 1 ){
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	CHECK(submit(spooler, "bar", 2, &bar, 0));
+	CHECK(submit(spooler, "bar", 3, &bar, 0));
+	PrintJob *job = make_job(&bar);
+	CHECK(!spooler.submit("bar", 4, job, 9, &err));
+	CHECK_STR(err, "queue full");
+	// other devices have their own queues
+	CHECK(submit(spooler, "cashier", 5, &bar, 0));
+	spooler.setQueueLimit(3);
+	CHECK(spooler.submit("bar", 4, job, 9, &err));
+	job = make_job(&bar);
+	CHECK(!spooler.submit("bar", 4, job, 0, &err));
+	CHECK_STR(err, "duplicate job id");
+	delete job;
+	bar.unhold();
+	CHECK(collector.waitFor(5));
+}
+
+static void test_isolation(){
+	Collector collector;
+	SimPrinter jammed(0), cashier(1);
+	Spooler spooler(&collector, 16);
+	int i;
+	jammed.hold();
+	CHECK(submit(spooler, "kitchen", 100, &jammed, 0));
+	CHECK(submit(spooler, "kitchen", 101, &jammed, 0));
+	for(i=0;i<5;i++){
+		CHECK(submit(spooler, "cashier", i + 1, &cashier, 0));
+	}
+	CHECK(collector.waitFor(5));
+	CHECK_STR(collector.log(), "1:done 2:done 3:done 4:done 5:done ");
+	std::vector<SpoolerDeviceStatus> status = spooler.status();
+	CHECK_EQ(status.size(), (size_t)2);
+	CHECK_STR(status[1].name, "kitchen");
+	CHECK(status[1].busy);
+	CHECK_EQ(status[1].queued, (size_t)1);
+	jammed.unhold();
+	CHECK(collector.waitFor(7));
+}
+
+static void test_failures(){
+	Collector collector;
+	SimPrinter offline(0), bar(0);
+	Spooler spooler(&collector, 16);
+	offline.broken = true;
+	CHECK(submit(spooler, "kitchen", 1, &offline, 0));
+	CHECK(collector.waitFor(1));
+	CHECK(submit(spooler, "kitchen", 2, &offline, 0));
+	CHECK(submit(spooler, "bar", 3, &bar, 0));
+	CHECK(collector.waitFor(3));
+	std::vector<SpoolerDeviceStatus> status = spooler.status();
+	CHECK_STR(status[1].name, "kitchen");
+	CHECK_EQ(status[1].failed, 2);
+	CHECK_EQ(status[1].consecutiveFailures, 2);
+	CHECK_EQ(status[0].done, 1);
+	offline.broken = false;
+	CHECK(submit(spooler, "kitchen", 4, &offline, 0));
+	CHECK(collector.waitFor(4));
+	CHECK_EQ(spooler.status()[1].consecutiveFailures, 0);
+}
+
+static void test_cancel(){
+	Collector collector;
+	SimPrinter kitchen(0);
+	Spooler spooler(&collector, 16);
+	kitchen.hold();
+	CHECK(submit(spooler, "kitchen", 1, &kitchen, 0));
+	while( spooler.status()[0].runningJob != 1 ){
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	CHECK(submit(spooler, "kitchen", 2, &kitchen, 0));
+	CHECK(submit(spooler, "kitchen", 3, &kitchen, 0));
+	// queued: reported at once
+	CHECK(spooler.cancel(3));
+	CHECK_STR(collector.log(), "3:canceled ");
+	CHECK(!spooler.cancel(3));
+	CHECK(!spooler.cancel(42));
+	// running: stops at the next op
+	CHECK(spooler.cancel(1));
+	kitchen.unhold();
+	CHECK(collector.waitFor(3));
+	CHECK_STR(collector.log(), "3:canceled 1:canceled 2:done ");
+	CHECK_EQ(spooler.status()[0].canceled, 2);
+}
+
+static void test_shutdown(){
+	Collector collector;
+	SimPrinter kitchen(0);
+	std::string err;
+	{
+		Spooler spooler(&collector, 16);
+		kitchen.hold();
+		CHECK(submit(spooler, "kitchen", 1, &kitchen, 0));
+		while( spooler.status()[0].runningJob != 1 ){
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		CHECK(submit(spooler, "kitchen", 2, &kitchen, 0));
+		std::thread release([&kitchen](){
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			kitchen.unhold();
+		});
+		spooler.shutdown();
+		release.join();
+		PrintJob *job = make_job(&kitchen);
+		CHECK(!spooler.submit("kitchen", 3, job, 0, &err));
+		CHECK_STR(err, "spooler stopped");
+		delete job;
+	}
+	CHECK_STR(collector.log(), "2:canceled 1:canceled ");
+}
+
+int main(){
+	test_priority_order();
+	test_backpressure();
+	test_isolation();
+	test_failures();
+	test_cancel();
+	test_shutdown();
+	return test_summary("test-spooler");
+}
@@ -0,0 +1,276 @@
+#include "test-util.h"
+#include "text-layout.h"
+#include "page.h"
+
+// Synthetic widths: a space is 5, other ASCII 10, U+2026 12, the rest 20,
+// and a character outside the BMP 30.
+class FakeSource : public AdvanceSource {
+public:
+	FakeSource(){ charCalls = 0; textCalls = 0; }
+
+	bool charWidths(uint16_t first, uint16_t last, int *widths){
+		unsigned ch;
+		charCalls += 1;
+		for(ch=first;ch<=last;ch++){
+			widths[ch - first] = ch == ' ' ? 5 : ch < 0x80 ? 10 : ch == 0x2026 ? 12 : 20;
+		}
+		return true;
+	}
+
+	bool textWidth(const uint16_t *text, uint32_t length, long *width){
+		textCalls += 1;
+		*width = 30;
+		return true;
+	}
+
+	int charCalls;
+	int textCalls;
+};
+
+static std::vector<uint16_t> utf16(const char *utf8){
+	std::vector<uint16_t> out;
+	const unsigned char *p = (const unsigned char *)utf8;
+	while( *p ){
+		unsigned long cp;
+		if( *p < 0x80 ){
+			cp = *p++;
+		} else if( *p < 0xe0 ){
+			cp = (unsigned long)(p[0] & 0x1f) << 6 | (p[1] & 0x3f);
+			p += 2;
+		} else if( *p < 0xf0 ){
+			cp = (unsigned long)(p[0] & 0x0f) << 12 | (unsigned long)(p[1] & 0x3f) << 6 | (p[2] & 0x3f);
+			p += 3;
+		} else {
+			cp = (unsigned long)(p[0] & 0x07) << 18 | (unsigned long)(p[1] & 0x3f) << 12 |
+				(unsigned long)(p[2] & 0x3f) << 6 | (p[3] & 0x3f);
+			p += 4;
+		}
+		if( cp >= 0x10000 ){
+			out.push_back((uint16_t)(0xd800 + ((cp - 0x10000) >> 10)));
+			out.push_back((uint16_t)(0xdc00 + ((cp - 0x10000) & 0x3ff)));
+		} else {
+			out.push_back((uint16_t)cp);
+		}
+	}
+	return out;
+}
+
+// Lines of the last layout joined with '|'.
+static std::string lines_of(const TextLayout &layout){
+	std::string out;
+	size_t i;
+	for(i=0;i<layout.lines().size();i++){
+		const LayoutLine &line = layout.lines()[i];
+		if( i > 0 ){
+			out += "|";
+		}
+		if( line.count > 0 ){
+			out += utf16_to_utf8(&layout.chars()[line.start], line.count);
+		}
+	}
+	return out;
+}
+
+// x of every character of line i, space separated.
+static std::string xs_of(const TextLayout &layout, size_t i){
+	const LayoutLine &line = layout.lines()[i];
+	std::string out;
+	char buf[32];
+	uint32_t k;
+	for(k=0;k<line.count;k++){
+		snprintf(buf, sizeof(buf), k > 0 ? " %ld" : "%ld", layout.xs()[line.start + k]);
+		out += buf;
+	}
+	return out;
+}
+
+static std::string run(TextLayout &layout, const char *text){
+	static FakeSource source;
+	static AdvanceTable table;
+	std::vector<uint16_t> chars = utf16(text);
+	CHECK(layout.layout(chars.empty() ? NULL : &chars[0], (uint32_t)chars.size(), &table, &source));
+	return lines_of(layout);
+}
+
+static void test_words(){
+	TextLayout layout;
+	layout.setWidth(100);
+	CHECK_STR(run(layout, "The quick brown fox"), "The quick|brown fox");
+	CHECK_STR(xs_of(layout, 0), "0 10 20 30 35 45 55 65 75");
+	CHECK_STR(xs_of(layout, 1), "0 10 20 30 40 50 55 65 75");
+	CHECK_EQ(layout.lines()[0].width, 85L);
+	// spaces at the end hang, a wrap drops them
+	CHECK_STR(run(layout, "The quick      brown"), "The quick|brown");
+	CHECK_STR(run(layout, "abcdefghijkl"), "abcdefghij|kl");
+	CHECK_STR(run(layout, "well-known words"), "well-known|words");
+	CHECK_STR(run(layout, "sugar-coated"), "sugar-|coated");
+	CHECK_STR(run(layout, "1-2-3-4-5-6-7"), "1-2-3-4-5-|6-7");
+	// a long word after a short one moves to its own line and is broken
+	CHECK_STR(run(layout, "a bcdefghijklmn"), "a|bcdefghijk|lmn");
+	// leading spaces stay
+	CHECK_STR(run(layout, "  ab"), "  ab");
+	CHECK_STR(xs_of(layout, 0), "0 5 10 20");
+	CHECK_STR(run(layout, ""), "");
+	CHECK_EQ(layout.lines().size(), (size_t)0);
+
+	layout.setWidth(0);
+	CHECK_STR(run(layout, "The quick brown fox"), "The quick brown fox");
+}
+
+static void test_cjk(){
+	TextLayout layout;
+	layout.setWidth(100);
+	CHECK_STR(run(layout, "あいうえおかきく"), "あいうえお|かきく");
+	// 。 does not start a line, 「 does not end one
+	CHECK_STR(run(layout, "あいうえお。"), "あいうえ|お。");
+	CHECK_STR(run(layout, "あいうえ「お」"), "あいうえ|「お」");
+	CHECK_STR(run(layout, "あいうえおっと"), "あいうえ|おっと");
+	// Latin words inside CJK text
+	CHECK_STR(run(layout, "ab あいうえ"), "ab あいう|え");
+	CHECK_STR(run(layout, "あいうabcdef"), "あいう|abcdef");
+	CHECK_STR(run(layout, "あいう、abcde"), "あいう、|abcde");
+	// a surrogate pair is never split
+	layout.setWidth(40);
+	CHECK_STR(run(layout, "あ\xf0\xa0\xae\xb7い"), "あ|\xf0\xa0\xae\xb7|い");
+	layout.setWidth(50);
+	CHECK_STR(run(layout, "あ\xf0\xa0\xae\xb7い"), "あ\xf0\xa0\xae\xb7|い");
+	CHECK_STR(xs_of(layout, 0), "0 20 50");
+	// wider than the box: one character per line
+	layout.setWidth(15);
+	CHECK_STR(run(layout, "あい"), "あ|い");
+}
+
+static void test_align(){
+	TextLayout layout;
+	layout.setWidth(100);
+	layout.setAlign(ALIGN_RIGHT);
+	CHECK_STR(run(layout, "The quick brown"), "The quick|brown");
+	CHECK_EQ(layout.xs()[0], 15L);
+	CHECK_EQ(layout.lines()[1].width, 50L);
+	CHECK_STR(xs_of(layout, 1), "50 60 70 80 90");
+	layout.setAlign(ALIGN_CENTER);
+	run(layout, "The quick brown");
+	CHECK_EQ(layout.xs()[0], 7L);
+	CHECK_STR(xs_of(layout, 1), "25 35 45 55 65");
+	// without a width, on the widest line
+	layout.setWidth(0);
+	layout.setAlign(ALIGN_RIGHT);
+	CHECK_STR(run(layout, "abc\nabcde"), "abc|abcde");
+	CHECK_STR(xs_of(layout, 0), "20 30 40");
+	CHECK_STR(xs_of(layout, 1), "0 10 20 30 40");
+}
+
+static void test_lines(){
+	TextLayout layout;
+	CHECK_STR(run(layout, "a\r\nb\rc\n\nd\n"), "a|b|c||d");
+	CHECK_STR(run(layout, "\n"), "");
+	CHECK_EQ(layout.lines().size(), (size_t)1);
+	layout.setWidth(30);
+	CHECK_STR(run(layout, "abcd\nef"), "abc|d|ef");
+}
+
+static void test_tabs(){
+	TextLayout layout;
+	TabStop stops[] = { { 100, ALIGN_RIGHT }, { 40, ALIGN_LEFT } };
+	// every eight spaces without stops
+	CHECK_STR(run(layout, "a\tb\tc"), "abc");
+	CHECK_STR(xs_of(layout, 0), "0 40 80");
+	layout.setTabInterval(25);
+	run(layout, "a\tb\tc");
+	CHECK_STR(xs_of(layout, 0), "0 25 50");
+
+	layout.setWidth(100);
+	layout.setTabStops(stops, 2);
+	CHECK_STR(run(layout, "ab\tcd\t4.50"), "abcd4.50");
+	CHECK_STR(xs_of(layout, 0), "0 10 40 50 60 70 80 90");
+	CHECK_EQ(layout.lines()[0].width, 100L);
+	// an item past the left stop: the price goes to the right one
+	CHECK_STR(run(layout, "abcde\t1.5"), "abcde1.5");
+	CHECK_STR(xs_of(layout, 0), "0 10 20 30 40 70 80 90");
+
+	// item/price rows
+	TabStop price = { 100, ALIGN_RIGHT };
+	layout.setTabStops(&price, 1);
+	CHECK_STR(run(layout, "abcdefg\t1.5"), "abcdefg1.5");
+	CHECK_STR(xs_of(layout, 0), "0 10 20 30 40 50 60 70 80 90");
+	// no room left: the price wraps with its tab
+	CHECK_STR(run(layout, "abcdefg\t12.5"), "abcdefg|12.5");
+	CHECK_STR(xs_of(layout, 1), "60 70 80 90");
+	CHECK_STR(run(layout, "Chicken sandwich\t12.00"), "Chicken|sandwich|12.00");
+	CHECK_STR(xs_of(layout, 2), "50 60 70 80 90");
+	layout.setWidth(150);
+	price.x = 150;
+	layout.setTabStops(&price, 1);
+	CHECK_STR(run(layout, "Chicken sandwich\t12.00"), "Chicken|sandwich12.00");
+	CHECK_STR(xs_of(layout, 1), "0 10 20 30 40 50 60 70 100 110 120 130 140");
+	// a stop past the box is taken as its right edge
+	layout.setWidth(90);
+	price.x = 100;
+	layout.setTabStops(&price, 1);
+	CHECK_STR(run(layout, "ab\t1.5"), "ab1.5");
+	CHECK_STR(xs_of(layout, 0), "0 10 60 70 80");
+
+	// centered on a stop
+	TabStop center = { 50, ALIGN_CENTER };
+	layout.setTabStops(&center, 1);
+	run(layout, "a\tbc");
+	CHECK_STR(xs_of(layout, 0), "0 40 50");
+}
+
+static void test_ellipsis(){
+	TextLayout layout;
+	static const uint16_t dots[] = { '.', '.' };
+	layout.setWidth(100);
+	layout.setMaxLines(1);
+	CHECK_STR(run(layout, "The quick brown"), "The quick\xe2\x80\xa6");
+	CHECK(layout.truncated());
+	CHECK_STR(xs_of(layout, 0), "0 10 20 30 35 45 55 65 75 85");
+	CHECK_EQ(layout.lines()[0].width, 97L);
+	// cut in the middle of a word
+	CHECK_STR(run(layout, "abcdefghijkl"), "abcdefgh\xe2\x80\xa6");
+	CHECK_STR(run(layout, "The quick"), "The quick");
+	CHECK(!layout.truncated());
+	CHECK_STR(run(layout, "The quick\n"), "The quick");
+	CHECK(!layout.truncated());
+	CHECK_STR(run(layout, "The\nquick"), "The\xe2\x80\xa6");
+	CHECK(layout.truncated());
+
+	layout.setMaxLines(2);
+	CHECK_STR(run(layout, "あいうえおかきくけこさしすせそ"), "あいうえお|かきくけ\xe2\x80\xa6");
+	layout.setEllipsis(dots, 2);
+	CHECK_STR(run(layout, "The quick brown fox jumps"), "The quick|brown fo..");
+	layout.setEllipsis(NULL, 0);
+	CHECK_STR(run(layout, "The quick brown fox jumps"), "The quick|brown fox");
+	CHECK(layout.truncated());
+
+	layout.setWidth(0);
+	layout.setEllipsis(dots, 2);
+	CHECK_STR(run(layout, "a\nb\nc"), "a|b..");
+}
+
+// Once the blocks are loaded, layouts make no calls to the source.
+static void test_cached(){
+	FakeSource source;
+	AdvanceTable table;
+	TextLayout layout;
+	std::vector<uint16_t> text = utf16("Grilled chicken あいう\t12.00");
+	layout.setWidth(120);
+	CHECK(layout.layout(&text[0], (uint32_t)text.size(), &table, &source));
+	CHECK_EQ(source.charCalls, 3);
+	CHECK(layout.layout(&text[0], (uint32_t)text.size(), &table, &source));
+	CHECK(layout.layout(&text[0], 7, &table, &source));
+	CHECK_EQ(source.charCalls, 3);
+	CHECK_EQ(source.textCalls, 0);
+	CHECK_STR(lines_of(layout), "Grilled");
+}
+
+int main(){
+	test_words();
+	test_cjk();
+	test_align();
+	test_lines();
+	test_tabs();
+	test_ellipsis();
+	test_cached();
+	return test_summary("test-text-layout");
+}
@@ -0,0 +1,261 @@
+#include "test-util.h"
+#include "transform.h"
+#include "page.h"
+#include "page-executor.h"
+#include "page-template.h"
+#include "display-list.h"
+#include "recording-device.h"
+#include <math.h>
+#include <stdlib.h>
+
+// mmToPixel of printer.js before the fixed point conversion.
+static long float_mm_to_pixel(int dpi, double mm){
+	double inch = mm/25.4;
+	return (long)floor(dpi * inch);
+}
+
+// floor(units * dpi / 254000) for whole 0.1 um units, in integers only.
+static long exact_pixel(int dpi, int64_t units){
+	int64_t scaled = units * dpi;
+	return (long)(scaled >= 0 ? scaled / 254000 : -((-scaled + 253999) / 254000));
+}
+
+// Every 0.1 um from -10 mm to 400 mm: mm_to_pixel is exact, and it differs
+// from the float expression only where that one lands a hair below a pixel
+// edge.
+static void test_precision(){
+	static const int dpis[] = { 180, 200, 203, 300, 360, 600, 1200 };
+	size_t d;
+	int64_t units;
+	for(d=0;d<sizeof(dpis)/sizeof(dpis[0]);d++){
+		int dpi = dpis[d];
+		long wrong = 0, differ = 0, offEdge = 0;
+		for(units=-100000;units<=4000000;units++){
+			double mm = units / 10000.0;
+			long pixel = mm_to_pixel(dpi, mm);
+			long old = float_mm_to_pixel(dpi, mm);
+			if( pixel != exact_pixel(dpi, units) ){
+				wrong += 1;
+			}
+			if( pixel != old ){
+				differ += 1;
+				if( (units * dpi) % 254000 != 0 || old != pixel - 1 ){
+					offEdge += 1;
+				}
+			}
+		}
+		CHECK_EQ(wrong, 0L);
+		CHECK_EQ(offEdge, 0L);
+		// none at 203 dpi, up to a few hundred at 1200
+		CHECK(differ < 1000);
+	}
+	CHECK_EQ(mm_to_pixel(600, 2.159), 51L);
+	CHECK_EQ(float_mm_to_pixel(600, 2.159), 50L);
+	CHECK_EQ(mm_to_pixel(600, -1), -24L);
+	// float32 coordinates of encoded pages convert like their decimal value
+	CHECK_EQ(mm_to_pixel(600, mm_from_float(2.159f)), 51L);
+	CHECK_EQ(mm_to_fixed(1e300), (int64_t)1000000000000LL);
+	CHECK_EQ(mm_to_fixed(-1e300), -(int64_t)1000000000000LL);
+
+	// pixel_to_mm goes back to the same pixel, and 0.1 um less does not
+	long pixel, bad = 0;
+	for(d=0;d<sizeof(dpis)/sizeof(dpis[0]);d++){
+		for(pixel=-500;pixel<=20000;pixel++){
+			double mm = pixel_to_mm(dpis[d], pixel);
+			if( mm_to_pixel(dpis[d], mm) != pixel || mm_to_pixel(dpis[d], mm - 0.0001) != pixel - 1 ){
+				bad += 1;
+			}
+		}
+	}
+	CHECK_EQ(bad, 0L);
+	CHECK_EQ(pixel_to_mm(254, 10), 1.0);
+}
+
+// transform_points with a plain offset rounds like mm_to_pixel of the sum,
+// arrays and repeated values alike.
+static void test_batch(){
+	const size_t n = 1000;
+	std::vector<double> xs(n), ys(n);
+	std::vector<long> px(n), py(n);
+	size_t i;
+	srand(7);
+	for(i=0;i<n;i++){
+		xs[i] = (rand() % 800000) / 10000.0 - 2;
+		ys[i] = (rand() % 3000000) / 10000.0;
+	}
+	Transform t = transform_identity();
+	t.e = mm_to_fixed(1.5);
+	t.f = mm_to_fixed(-0.25);
+	CHECK_EQ(transform_points(t, 203, 180, &xs[0], 1, &ys[0], 1, n, &px[0], &py[0]), n);
+	long mismatches = 0;
+	for(i=0;i<n;i++){
+		if( px[i] != mm_to_pixel(203, xs[i] + 1.5) || py[i] != mm_to_pixel(180, ys[i] - 0.25) ){
+			mismatches += 1;
+		}
+	}
+	CHECK_EQ(mismatches, 0L);
+
+	double y = 30;
+	CHECK_EQ(transform_points(t, 600, 600, &xs[0], 1, &y, 0, 3, &px[0], &py[0]), (size_t)3);
+	CHECK_EQ(py[0], mm_to_pixel(600, 29.75));
+	CHECK_EQ(py[2], py[0]);
+
+	xs[5] = NAN;
+	CHECK_EQ(transform_points(t, 600, 600, &xs[0], 1, &ys[0], 1, n, &px[0], &py[0]), (size_t)5);
+}
+
+static void test_stack(){
+	TransformStack stack;
+	double x = 80, y = 10;
+	long px, py;
+
+	// 80 mm paper layout on 58 mm paper
+	stack.scale(58.0 / 80, 58.0 / 80);
+	transform_points(stack.current(), 203, 203, &x, 0, &y, 0, 1, &px, &py);
+	CHECK_EQ(px, mm_to_pixel(203, 58));
+	CHECK(fabs(transform_length(stack.current(), 4) - 2.9) < 1e-12);
+
+	// nested offsets add up exactly
+	stack.reset();
+	int i;
+	for(i=0;i<10;i++){
+		stack.push();
+		stack.translate(0.1, 2.54);
+	}
+	CHECK_EQ(stack.depth(), (size_t)10);
+	CHECK_EQ(stack.current().e, mm_to_fixed(1));
+	CHECK_EQ(stack.current().f, mm_to_fixed(25.4));
+	for(i=0;i<10;i++){
+		CHECK(stack.pop());
+	}
+	CHECK(!stack.pop());
+	CHECK_EQ(stack.current().e, (int64_t)0);
+
+	// a label turned a quarter clockwise: x runs down the page
+	stack.translate(50, 0);
+	stack.rotate(90);
+	x = 10;
+	y = 5;
+	transform_points(stack.current(), 600, 600, &x, 0, &y, 0, 1, &px, &py);
+	CHECK_EQ(px, mm_to_pixel(600, 45));
+	CHECK_EQ(py, mm_to_pixel(600, 10));
+	CHECK_EQ(transform_length(stack.current(), 3), 3.0);
+	stack.rotate(-90);
+	CHECK_EQ(stack.current().a, 1.0);
+	CHECK_EQ(stack.current().c, 0.0);
+	stack.rotate(30);
+	stack.rotate(330);
+	CHECK(fabs(stack.current().a - 1) < 1e-15 && fabs(stack.current().b) < 1e-15);
+}
+
+static Page &build_label(PageBuilder &b){
+	static const double xs[] = { 0, 2.5, 5 };
+	std::vector<uint16_t> abc = u16("ABC");
+	b.clear();
+	b.createFont("f", "Arial", 3, 0, 0);
+	b.setFont("f");
+	b.push();
+	b.translate(40, 5);
+	b.rotate(90);
+	b.drawChars(&abc[0], 3, b.addCoords(xs, 3), b.scalar(0));
+	b.pop();
+	b.push();
+	b.scale(0.5, 0.5);
+	b.createPen("p", 0, 0, 0, 0.4);
+	b.moveTo(10, 10);
+	b.lineTo(20, 10);
+	b.pop();
+	b.lineTo(20, 10);
+	return b.finish();
+}
+
+static void test_executor(){
+	PageBuilder b;
+	build_label(b);
+	RecordingDevice device(600, 600);
+	PageExecutor executor(&device);
+	executor.setOffset(1, 0);
+	CHECK(executor.runPage(b.page()));
+	CHECK_EQ(executor.skippedOps(), 0L);
+	const std::vector<DeviceCall> &calls = device.calls();
+	size_t i, runs = 0;
+	for(i=0;i<calls.size();i++){
+		if( calls[i].kind == CALL_TEXT_RUN ){
+			// upright glyphs, one per line of the turned label
+			CHECK_EQ(calls[i].x, mm_to_pixel(600, 41));
+			CHECK_EQ(calls[i].y, mm_to_pixel(600, 5 + 2.5 * runs));
+			runs += 1;
+		}
+		if( calls[i].kind == CALL_CREATE_PEN ){
+			CHECK_EQ(calls[i].size, mm_to_pixel(600, 0.2));
+		}
+	}
+	CHECK_EQ(runs, (size_t)3);
+	// the scaled line and the one after pop() merge into one polyline
+	const DeviceCall &path = calls[calls.size() - 2];
+	CHECK_EQ(path.kind, CALL_POLY_POLYLINE);
+	CHECK_EQ(path.counts.size(), (size_t)1);
+	CHECK_EQ(path.points.size(), (size_t)6);
+	CHECK_EQ(path.points[2], mm_to_pixel(600, 11));
+	CHECK_EQ(path.points[3], mm_to_pixel(600, 5));
+	CHECK_EQ(path.points[4], mm_to_pixel(600, 21));
+	CHECK_EQ(path.points[5], mm_to_pixel(600, 10));
+
+	// the display list converts the same, and each page starts untransformed
+	DisplayList list;
+	std::string err;
+	CHECK(list.record(b.page(), 600, 600, 1, 0, &err));
+	RecordingDevice direct(600, 600), replayed(600, 600);
+	{
+		PageExecutor first(&direct), second(&replayed);
+		first.setOffset(1, 0);
+		CHECK(first.runOps(b.page()));
+		CHECK(second.runList(list));
+	}
+	CHECK_STR(replayed.dump(), direct.dump());
+
+	b.clear();
+	b.push();
+	b.translate(100, 0);
+	b.finish();
+	PageBuilder line;
+	line.lineTo(1, 1);
+	line.finish();
+	CHECK(executor.runPage(b.page()));
+	CHECK(executor.runPage(line.page()));
+	CHECK_EQ(device.calls()[device.calls().size() - 2].x, mm_to_pixel(600, 2));
+}
+
+static void test_errors(){
+	PageBuilder b;
+	RecordingDevice device(600, 600);
+	PageExecutor executor(&device);
+	DisplayList list;
+	std::string err;
+	b.pop();
+	b.finish();
+	CHECK(!executor.runOps(b.page()));
+	CHECK_STR(executor.error(), "pop without push");
+	CHECK(!list.record(b.page(), 600, 600, 0, 0, &err));
+	CHECK_STR(err, "pop without push");
+
+	b.clear();
+	b.rotate(NAN);
+	b.finish();
+	CHECK(!executor.runOps(b.page()));
+	CHECK_STR(executor.error(), "invalid number to rotate");
+
+	PageTemplate tmpl;
+	tmpl.ops().translate(1, 1);
+	CHECK(!tmpl.compile(&err));
+	CHECK_STR(err, "translate is not supported in templates");
+}
+
+int main(){
+	test_precision();
+	test_batch();
+	test_stack();
+	test_executor();
+	test_errors();
+	return test_summary("test-transform");
+}
@@ -0,0 +1,55 @@
+#ifndef DRAWER_TEST_UTIL_H
+#define DRAWER_TEST_UTIL_H
+
+// Minimal helpers for the native test programs (test-*.cc). Each program
+// runs its checks, prints failures and exits with non-zero status if any
+// check failed.
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+static int testFailures = 0;
+static int testChecks = 0;
+
+#define CHECK(cond) do { \
+	testChecks += 1; \
+	if( !(cond) ){ \
+		testFailures += 1; \
+		printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond); \
+	} \
+} while(0)
+
+#define CHECK_EQ(a, b) do { \
+	testChecks += 1; \
+	if( !((a) == (b)) ){ \
+		testFailures += 1; \
+		printf("%s:%d: CHECK_EQ failed: %s == %s\n", __FILE__, __LINE__, #a, #b); \
+	} \
+} while(0)
+
+#define CHECK_STR(a, b) do { \
+	testChecks += 1; \
+	std::string testA = (a), testB = (b); \
+	if( testA != testB ){ \
+		testFailures += 1; \
+		printf("%s:%d: CHECK_STR failed:\n--- %s\n%s\n--- %s\n%s\n", __FILE__, __LINE__, \
+			#a, testA.c_str(), #b, testB.c_str()); \
+	} \
+} while(0)
+
+static inline std::vector<uint16_t> u16(const char *ascii){
+	std::vector<uint16_t> out;
+	while( *ascii ){
+		out.push_back((uint16_t)(unsigned char)*ascii++);
+	}
+	return out;
+}
+
+static inline int test_summary(const char *name){
+	printf("%s: %d checks, %d failures\n", name, testChecks, testFailures);
+	return testFailures == 0 ? 0 : 1;
+}
+
+#endif
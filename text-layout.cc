@@ -0,0 +1,312 @@
+#include "text-layout.h"
+#include <algorithm>
+
+// U+2026 HORIZONTAL ELLIPSIS
+static const uint16_t ELLIPSIS = 0x2026;
+
+// Not at the start of a line: closing brackets, punctuation, small kana and
+// iteration marks.
+static const uint16_t NO_BREAK_BEFORE[] = {
+	')', ']', '}', ',', '.', ':', ';', '!', '?',
+	0x3001, 0x3002, 0x3005, 0x3009, 0x300b, 0x300d, 0x300f, 0x3011, 0x3015,
+	0x3017, 0x3019, 0x301b, 0x301f, 0x3041, 0x3043, 0x3045, 0x3047, 0x3049,
+	0x3063, 0x3083, 0x3085, 0x3087, 0x308e, 0x3095, 0x3096, 0x309d, 0x309e,
+	0x30a1, 0x30a3, 0x30a5, 0x30a7, 0x30a9, 0x30c3, 0x30e3, 0x30e5, 0x30e7,
+	0x30ee, 0x30f5, 0x30f6, 0x30fb, 0x30fc, 0x30fd, 0x30fe, 0xff01, 0xff09,
+	0xff0c, 0xff0e, 0xff1a, 0xff1b, 0xff1f, 0xff3d, 0xff5d, 0xff61, 0xff63,
+	0xff64, 0xff65, 0xff67, 0xff68, 0xff69, 0xff6a, 0xff6b, 0xff6c, 0xff6d,
+	0xff6e, 0xff6f, 0xff70
+};
+
+// Not at the end of a line: opening brackets.
+static const uint16_t NO_BREAK_AFTER[] = {
+	'(', '[', '{',
+	0x3008, 0x300a, 0x300c, 0x300e, 0x3010, 0x3014, 0x3016, 0x3018, 0x301a,
+	0x301d, 0xff08, 0xff3b, 0xff5b, 0xff62
+};
+
+static bool in_list(const uint16_t *list, size_t count, uint16_t ch){
+	size_t i;
+	for(i=0;i<count;i++){
+		if( list[i] == ch ){
+			return true;
+		}
+	}
+	return false;
+}
+
+// Characters that may be wrapped before and after without a space: Hangul,
+// CJK symbols, kana and ideographs, fullwidth forms, and characters outside
+// the BMP (both halves of a surrogate pair).
+static bool is_cjk(uint16_t ch){
+	return (ch >= 0x1100 && ch <= 0x11ff) || (ch >= 0x2e80 && ch <= 0x9fff) ||
+		(ch >= 0xac00 && ch <= 0xdfff) || (ch >= 0xf900 && ch <= 0xfaff) ||
+		(ch >= 0xfe30 && ch <= 0xfe4f) || (ch >= 0xff00 && ch <= 0xffef);
+}
+
+static bool is_letter(uint16_t ch){
+	return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+}
+
+static bool is_blank(uint16_t ch){
+	return ch == ' ' || ch == '\t';
+}
+
+static bool tab_stop_less(const TabStop &a, const TabStop &b){
+	return a.x < b.x;
+}
+
+TextLayout::TextLayout(){
+	width_ = 0;
+	align_ = ALIGN_LEFT;
+	tabInterval_ = 0;
+	maxLines_ = 0;
+	ellipsis_.push_back(ELLIPSIS);
+	text_ = NULL;
+	interval_ = 0;
+	truncated_ = false;
+}
+
+void TextLayout::setTabStops(const TabStop *stops, size_t count){
+	stops_.assign(stops, stops + count);
+	std::stable_sort(stops_.begin(), stops_.end(), tab_stop_less);
+}
+
+void TextLayout::setEllipsis(const uint16_t *text, uint32_t length){
+	ellipsis_.assign(text, text + length);
+}
+
+// May a line that starts at start be wrapped before character i?
+bool TextLayout::canBreak(uint32_t start, uint32_t i) const {
+	uint16_t prev = text_[i - 1], ch = text_[i];
+	if( ch >= 0xdc00 && ch <= 0xdfff ){
+		return false;
+	}
+	// before a tab, so the text after it keeps its stop on the next line
+	if( ch == '\t' ){
+		return true;
+	}
+	if( is_blank(prev) ){
+		return prev == ' ' && ch != ' ';
+	}
+	if( in_list(NO_BREAK_BEFORE, sizeof(NO_BREAK_BEFORE)/sizeof(NO_BREAK_BEFORE[0]), ch) ||
+			in_list(NO_BREAK_AFTER, sizeof(NO_BREAK_AFTER)/sizeof(NO_BREAK_AFTER[0]), prev) ){
+		return false;
+	}
+	if( is_cjk(ch) || is_cjk(prev) ){
+		return true;
+	}
+	return prev == '-' && i >= start + 2 && is_letter(text_[i - 2]) && is_letter(ch);
+}
+
+// Positions characters [start, end) into positions_ from 0. The text after
+// a right or center tab stop is moved when the next tab or the end is
+// reached, as far as limit allows (limit < 0 for none). With fit, stops at
+// the first glyph that ends past limit and returns its index, leaving the
+// positions incomplete; otherwise returns end and sets *width to the end of
+// the last glyph.
+uint32_t TextLayout::place(uint32_t start, uint32_t end, long limit, bool fit, long *width){
+	long x = 0, segX = 0, segStop = 0, last = 0;
+	int segAlign = ALIGN_LEFT;
+	uint32_t seg = start, i, k;
+	for(i=start;i<=end;i++){
+		uint16_t ch = i < end ? text_[i] : 0;
+		if( i == end || ch == '\t' ){
+			if( segAlign != ALIGN_LEFT ){
+				long w = x - segX, target;
+				if( segAlign == ALIGN_RIGHT ){
+					target = (limit >= 0 && segStop > limit ? limit : segStop) - w;
+				} else {
+					target = segStop - w / 2;
+					if( limit >= 0 && target + w > limit ){
+						target = limit - w;
+					}
+				}
+				if( target > segX ){
+					for(k=seg;k<i;k++){
+						positions_[k - start] += target - segX;
+					}
+					x += target - segX;
+				}
+			}
+			if( i == end ){
+				break;
+			}
+			positions_[i - start] = x;
+			std::vector<TabStop>::const_iterator stop = stops_.begin();
+			while( stop != stops_.end() && stop->x <= x ){
+				++stop;
+			}
+			segAlign = ALIGN_LEFT;
+			if( stop != stops_.end() ){
+				if( stop->align == ALIGN_LEFT ){
+					x = stop->x;
+				} else {
+					segAlign = stop->align;
+					segStop = stop->x;
+				}
+			} else if( interval_ > 0 ){
+				x = (x / interval_ + 1) * interval_;
+			}
+			segX = x;
+			seg = i + 1;
+			continue;
+		}
+		if( fit && ch != ' ' && limit >= 0 && x + advances_[i] > limit ){
+			return i;
+		}
+		positions_[i - start] = x;
+		x += advances_[i];
+	}
+	for(k=end;k>start;k--){
+		if( !is_blank(text_[k - 1]) ){
+			last = positions_[k - 1 - start] + advances_[k - 1];
+			break;
+		}
+	}
+	if( width ){
+		*width = last;
+	}
+	return end;
+}
+
+// Adds characters [start, end) as a line, without the blanks at its end,
+// followed by the ellipsis if asked.
+void TextLayout::addLine(uint32_t start, uint32_t end, long limit, bool ellipsis){
+	LayoutLine line;
+	long width = 0;
+	uint32_t i;
+	while( end > start && is_blank(text_[end - 1]) ){
+		end -= 1;
+	}
+	place(start, end, limit, false, &width);
+	line.start = (uint32_t)chars_.size();
+	for(i=start;i<end;i++){
+		if( text_[i] != '\t' ){
+			chars_.push_back(text_[i]);
+			xs_.push_back(positions_[i - start]);
+		}
+	}
+	if( ellipsis ){
+		for(i=0;i<ellipsis_.size();i++){
+			chars_.push_back(ellipsis_[i]);
+			xs_.push_back(width);
+			width += ellipsisAdvances_[i];
+		}
+	}
+	line.count = (uint32_t)chars_.size() - line.start;
+	line.width = width;
+	lines_.push_back(line);
+}
+
+void TextLayout::align(){
+	long box = width_;
+	size_t i;
+	uint32_t k;
+	if( box <= 0 ){
+		for(i=0;i<lines_.size();i++){
+			box = std::max(box, lines_[i].width);
+		}
+	}
+	if( align_ == ALIGN_LEFT ){
+		return;
+	}
+	for(i=0;i<lines_.size();i++){
+		const LayoutLine &line = lines_[i];
+		long shift = align_ == ALIGN_RIGHT ? box - line.width : (box - line.width) / 2;
+		if( shift <= 0 ){
+			continue;
+		}
+		for(k=0;k<line.count;k++){
+			xs_[line.start + k] += shift;
+		}
+	}
+}
+
+bool TextLayout::layout(const uint16_t *text, uint32_t length, AdvanceTable *table,
+		AdvanceSource *source){
+	chars_.clear();
+	xs_.clear();
+	lines_.clear();
+	truncated_ = false;
+	text_ = text;
+	advances_.resize(length);
+	positions_.resize(length);
+	ellipsisAdvances_.resize(ellipsis_.size());
+	if( length > 0 && !table->advances(text, length, source, &advances_[0]) ){
+		return false;
+	}
+	if( !ellipsis_.empty() && !table->advances(&ellipsis_[0], (uint32_t)ellipsis_.size(), source,
+			&ellipsisAdvances_[0]) ){
+		return false;
+	}
+	interval_ = tabInterval_;
+	if( interval_ <= 0 ){
+		static const uint16_t space = ' ';
+		int spaceWidth;
+		if( !table->advances(&space, 1, source, &spaceWidth) ){
+			return false;
+		}
+		interval_ = 8L * spaceWidth;
+	}
+	long ellipsisWidth = 0, limit = width_ > 0 ? width_ : -1;
+	size_t k;
+	for(k=0;k<ellipsisAdvances_.size();k++){
+		ellipsisWidth += ellipsisAdvances_[k];
+	}
+	uint32_t i = 0;
+	while( i < length ){
+		uint32_t end = i, after;
+		while( end < length && text[end] != '\n' && text[end] != '\r' ){
+			end += 1;
+		}
+		after = end;
+		if( after < length ){
+			after += text[after] == '\r' && after + 1 < length && text[after + 1] == '\n' ? 2 : 1;
+		}
+		do {
+			uint32_t brk = end, next = end;
+			if( limit >= 0 ){
+				uint32_t stop = place(i, end, limit, true, NULL);
+				if( stop < end ){
+					uint32_t first = i;
+					while( first < stop && is_blank(text[first]) ){
+						first += 1;
+					}
+					brk = stop;
+					while( brk > first && !canBreak(i, brk) ){
+						brk -= 1;
+					}
+					if( brk <= first ){
+						// no place to wrap: break before the glyph that does not
+						// fit, or after it if it is the first one
+						brk = stop > first ? stop : first + 1;
+						if( brk < end && text[brk] >= 0xdc00 && text[brk] <= 0xdfff ){
+							brk += 1;
+						}
+					}
+					next = brk;
+					while( next < end && text[next] == ' ' ){
+						next += 1;
+					}
+				}
+			}
+			if( maxLines_ > 0 && (int)lines_.size() + 1 >= maxLines_ && (next < end || after < length) ){
+				truncated_ = true;
+				if( ellipsis_.empty() ){
+					addLine(i, brk, limit, false);
+				} else {
+					long shorter = limit >= 0 ? std::max(limit - ellipsisWidth, 0L) : -1;
+					addLine(i, shorter >= 0 ? place(i, end, shorter, true, NULL) : end, shorter, true);
+				}
+				align();
+				return true;
+			}
+			addLine(i, brk, limit, false);
+			i = next;
+		} while( i < end );
+		i = after;
+	}
+	align();
+	return true;
+}
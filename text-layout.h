@@ -0,0 +1,94 @@
+#ifndef DRAWER_TEXT_LAYOUT_H
+#define DRAWER_TEXT_LAYOUT_H
+
+#include "advance-table.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+enum { ALIGN_LEFT, ALIGN_CENTER, ALIGN_RIGHT };
+
+// Text after a tab starts at x (ALIGN_LEFT), is centered on x or ends at x.
+struct TabStop {
+	long x;
+	int align;
+};
+
+// Characters [start, start + count) of TextLayout::chars() and xs().
+struct LayoutLine {
+	uint32_t start;
+	uint32_t count;
+	long width;  // from the left of the line to the end of its last glyph
+};
+
+// Breaks text into lines that fit a box and positions every character, in
+// the units of an AdvanceTable (device pixels), so a line is ready to be
+// drawn with draw_chars:
+//
+// - '\n' (or '\r', "\r\n") ends a line. Lines are wrapped after spaces and
+//   tabs, after a hyphen inside a word and between CJK characters, except
+//   before closing brackets and punctuation (、。」) and small kana and after
+//   opening brackets. A word wider than the box is broken anywhere.
+// - Spaces at the end of a line hang past the box and are left out;
+//   spaces at a wrap are dropped. A tab is wrapped with the text after it.
+// - A tab moves to the next tab stop, then to every tabInterval after the
+//   last one. The text after a right or center stop, up to the next tab,
+//   ends at or is centered on the stop as far as the line allows, which
+//   puts prices at the right of item/price rows. Tabs are not output.
+// - With maxLines, text left over after the last line is cut there and
+//   the ellipsis (U+2026 by default) is put at the end of what fits.
+// - Lines are aligned in the box, or on the widest line without a width.
+//
+// Only integer arithmetic on the advances is used, so a layout is the same
+// everywhere, and the widths come from the table, so once its blocks are
+// loaded a layout makes no calls to the source.
+class TextLayout {
+public:
+	TextLayout();
+
+	// Box width; 0 for no wrapping.
+	void setWidth(long width){ width_ = width; }
+	void setAlign(int align){ align_ = align; }
+	void setTabStops(const TabStop *stops, size_t count);
+	// 0 for eight spaces.
+	void setTabInterval(long interval){ tabInterval_ = interval; }
+	// 0 for no limit.
+	void setMaxLines(int maxLines){ maxLines_ = maxLines; }
+	void setEllipsis(const uint16_t *text, uint32_t length);
+
+	bool layout(const uint16_t *text, uint32_t length, AdvanceTable *table,
+		AdvanceSource *source);
+
+	const std::vector<uint16_t> &chars() const { return chars_; }
+	const std::vector<long> &xs() const { return xs_; }
+	const std::vector<LayoutLine> &lines() const { return lines_; }
+	// Text was left out for maxLines.
+	bool truncated() const { return truncated_; }
+
+private:
+	uint32_t place(uint32_t start, uint32_t end, long limit, bool fit, long *width);
+	bool canBreak(uint32_t start, uint32_t i) const;
+	void addLine(uint32_t start, uint32_t end, long limit, bool ellipsis);
+	void align();
+
+	long width_;
+	int align_;
+	std::vector<TabStop> stops_;
+	long tabInterval_;
+	int maxLines_;
+	std::vector<uint16_t> ellipsis_;
+
+	// text being laid out
+	const uint16_t *text_;
+	std::vector<int> advances_;
+	std::vector<int> ellipsisAdvances_;
+	long interval_;
+	std::vector<long> positions_;
+
+	std::vector<uint16_t> chars_;
+	std::vector<long> xs_;
+	std::vector<LayoutLine> lines_;
+	bool truncated_;
+};
+
+#endif
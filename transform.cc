@@ -0,0 +1,134 @@
+#include "transform.h"
+#include <math.h>
+
+static const int64_t FIXED_PER_INCH = 254000;
+// 100 km; keeps fixed * dpi inside int64 (and inside the 2^53 of the JS
+// numbers printer.js computes it with).
+static const double FIXED_LIMIT = 1e12;
+// 2^34 pixels, more than FIXED_LIMIT at any dpi: with it added the division
+// is unsigned and rounds down without a branch for negative values.
+static const int64_t PIXEL_BIAS = (int64_t)1 << 34;
+static const double PI = 3.14159265358979323846;
+
+// floor() through the truncating conversion; floor itself is a call without
+// SSE4.1 and took most of the time of a conversion.
+int64_t mm_to_fixed(double mm){
+	double fixed = mm * FIXED_PER_MM + 0.5;
+	if( fixed > FIXED_LIMIT ){
+		fixed = FIXED_LIMIT;
+	} else if( !(fixed >= -FIXED_LIMIT) ){
+		fixed = -FIXED_LIMIT;
+	}
+	int64_t truncated = (int64_t)fixed;
+	return truncated - ((double)truncated > fixed ? 1 : 0);
+}
+
+long fixed_to_pixel(int dpi, int64_t fixed){
+	uint64_t scaled = (uint64_t)(fixed * dpi + PIXEL_BIAS * FIXED_PER_INCH);
+	return (long)((int64_t)(scaled / FIXED_PER_INCH) - PIXEL_BIAS);
+}
+
+long mm_to_pixel(int dpi, double mm){
+	return fixed_to_pixel(dpi, mm_to_fixed(mm));
+}
+
+double pixel_to_mm(int dpi, long pixel){
+	int64_t scaled = (int64_t)pixel * FIXED_PER_INCH;
+	int64_t fixed = scaled / dpi;
+	if( scaled % dpi > 0 ){
+		fixed += 1;
+	}
+	return (double)fixed / FIXED_PER_MM;
+}
+
+Transform transform_identity(){
+	Transform t = { 1, 0, 0, 1, 0, 0 };
+	return t;
+}
+
+double transform_length(const Transform &t, double mm){
+	return mm * sqrt(fabs(t.a * t.d - t.b * t.c));
+}
+
+// For the identity (and any plain offset) a * x + c * y is x exactly, so
+// there is no separate path for untransformed pages to round differently.
+size_t transform_points(const Transform &t, int dpix, int dpiy,
+		const double *xs, size_t xstride, const double *ys, size_t ystride, size_t n,
+		long *outX, long *outY){
+	double a = t.a, b = t.b, c = t.c, d = t.d;
+	int64_t e = t.e, f = t.f;
+	size_t i;
+	for(i=0;i<n;i++){
+		double x = xs[i * xstride];
+		double y = ys[i * ystride];
+		if( isnan(x) || isnan(y) ){
+			return i;
+		}
+		outX[i] = fixed_to_pixel(dpix, mm_to_fixed(a * x + c * y) + e);
+		outY[i] = fixed_to_pixel(dpiy, mm_to_fixed(b * x + d * y) + f);
+	}
+	return n;
+}
+
+TransformStack::TransformStack(){
+	current_ = transform_identity();
+}
+
+void TransformStack::reset(){
+	current_ = transform_identity();
+	saved_.clear();
+}
+
+void TransformStack::push(){
+	saved_.push_back(current_);
+}
+
+bool TransformStack::pop(){
+	if( saved_.empty() ){
+		return false;
+	}
+	current_ = saved_.back();
+	saved_.pop_back();
+	return true;
+}
+
+void TransformStack::translate(double dx, double dy){
+	current_.e += mm_to_fixed(current_.a * dx + current_.c * dy);
+	current_.f += mm_to_fixed(current_.b * dx + current_.d * dy);
+}
+
+void TransformStack::scale(double sx, double sy){
+	current_.a *= sx;
+	current_.b *= sx;
+	current_.c *= sy;
+	current_.d *= sy;
+}
+
+void TransformStack::rotate(double degrees){
+	double turn = fmod(degrees, 360), sn, cs;
+	if( turn < 0 ){
+		turn += 360;
+	}
+	// sin(PI) is not 0 in doubles; quarter turns keep labels on the grid
+	if( turn == 0 ){
+		sn = 0;
+		cs = 1;
+	} else if( turn == 90 ){
+		sn = 1;
+		cs = 0;
+	} else if( turn == 180 ){
+		sn = 0;
+		cs = -1;
+	} else if( turn == 270 ){
+		sn = -1;
+		cs = 0;
+	} else {
+		sn = sin(degrees * PI / 180);
+		cs = cos(degrees * PI / 180);
+	}
+	Transform t = current_;
+	current_.a = t.a * cs + t.c * sn;
+	current_.b = t.b * cs + t.d * sn;
+	current_.c = t.c * cs - t.a * sn;
+	current_.d = t.d * cs - t.b * sn;
+}
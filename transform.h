@@ -0,0 +1,74 @@
+#ifndef DRAWER_TRANSFORM_H
+#define DRAWER_TRANSFORM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Page coordinates reach the device through 0.1 um fixed point: an mm value
+// is rounded to whole 0.1 um units (the resolution of mm_from_float) and q
+// units become floor(q * dpi / 254000) in integer arithmetic. That is the
+// exact floor of dpi * mm / 25.4; the float expression printer.js used
+// before came out a pixel short for some values on a pixel edge (0.127 mm
+// at 200 dpi).
+const int64_t FIXED_PER_MM = 10000;
+
+int64_t mm_to_fixed(double mm);
+long fixed_to_pixel(int dpi, int64_t fixed);
+// Same rounding as mmToPixel in printer.js.
+long mm_to_pixel(int dpi, double mm);
+// The smallest mm value in whole 0.1 um that mm_to_pixel converts to pixel,
+// for positions laid out in device pixels.
+double pixel_to_mm(int dpi, long pixel);
+
+// Affine transform of mm coordinates, applied before the conversion:
+//
+//   x' = a * x + c * y + e
+//   y' = b * x + d * y + f
+//
+// The translation (e, f) is kept in 0.1 um units, so nested offsets add up
+// exactly and a plain offset converts like mm_to_pixel(dpi, x + dx).
+struct Transform {
+	double a, b, c, d;
+	int64_t e, f;
+};
+
+Transform transform_identity();
+// Scales a length (font height, pen width) by sqrt of the area factor of t:
+// by s for scale(s), unchanged by rotations.
+double transform_length(const Transform &t, double mm);
+
+// Converts n points to device pixels with t, in one pass. xs (ys) advances by
+// xstride (ystride) doubles per point; a stride of 0 repeats one value.
+// Returns n, or the index of the first point with a NaN coordinate, where
+// the pass stops. Every conversion of page coordinates goes through here, so
+// single points and arrays round the same.
+size_t transform_points(const Transform &t, int dpix, int dpiy,
+	const double *xs, size_t xstride, const double *ys, size_t ystride, size_t n,
+	long *outX, long *outY);
+
+// The transform stack of a page: push()/pop() save and restore the current
+// transform, translate/scale/rotate apply to coordinates before the current
+// transform does (as on a canvas). Angles are in degrees, clockwise on the
+// page since y grows downwards; multiples of 90 are exact.
+class TransformStack {
+public:
+	TransformStack();
+
+	void reset();
+	void push();
+	// false if there is nothing to pop
+	bool pop();
+	void translate(double dx, double dy);
+	void scale(double sx, double sy);
+	void rotate(double degrees);
+
+	const Transform &current() const { return current_; }
+	size_t depth() const { return saved_.size(); }
+
+private:
+	Transform current_;
+	std::vector<Transform> saved_;
+};
+
+#endif